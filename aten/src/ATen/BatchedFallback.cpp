@@ -7,22 +7,61 @@
 #include <c10/util/llvmMathExtras.h>
 #include <c10/util/irange.h>
 
+#include <mutex>
+#include <unordered_map>
+
 namespace at {
 
-// Given a linear index, return the actual index.
-// Example: Given linear_idx = 3, sizes = [5, 2], we would return [1, 0]
-static SmallVector<indexing::TensorIndex,kVmapStaticDimVecSize>
-computeIndex(int64_t linear_idx, IntArrayRef sizes) {
-  SmallVector<indexing::TensorIndex,kVmapStaticDimVecSize> result;
-  result.reserve(sizes.size());
-  for (auto it = sizes.rbegin(); it != sizes.rend(); it++) {
-    auto remainder = linear_idx % *it;
-    result.push_back(remainder);
-    linear_idx -= remainder;
-    linear_idx /= *it;
+// Note [Chunked vmap fallback]
+// The for-loop fallback pays full boxed dispatch per example; that part is
+// irreducible without a batching rule. What is reducible is the per-example
+// bookkeeping that used to surround each call:
+// - schema analysis (isInplaceOp and the fallback eligibility checks walk
+//   alias info and return types) ran on every fallback hit even though it
+//   only depends on the operator. It is now computed once per operator and
+//   cached, see fallbackPlanFor().
+// - example slices were produced by a computeIndex + Tensor::index() round
+//   trip through the dispatcher per batched argument per example. Slices
+//   are now materialized a chunk of kFallbackChunkSize examples at a time:
+//   with a single batch dim (the common case) one narrow() + unbind()
+//   yields the whole chunk, i.e. two dispatches per argument per chunk
+//   instead of one heavyweight indexing call per argument per example.
+//   Memory for the slice TensorImpls is bounded by the chunk size.
+static constexpr int64_t kFallbackChunkSize = 256;
+
+// Materializes views of examples [chunk_begin, chunk_begin + chunk_size)
+// of a physical tensor whose leading dims are the batch dims. With a
+// single batch dim the whole chunk is produced by one narrow() + unbind();
+// multiple batch dims fall back to a select() chain per example. Only
+// views are created, so writes through the slices land in the original
+// storage (the in-place fallback relies on this).
+static std::vector<Tensor> materializeChunkSlices(
+    const Tensor& physical,
+    IntArrayRef batch_sizes,
+    int64_t chunk_begin,
+    int64_t chunk_size) {
+  if (batch_sizes.size() == 1) {
+    return physical.narrow(0, chunk_begin, chunk_size).unbind(0);
+  }
+  std::vector<Tensor> slices;
+  slices.reserve(chunk_size);
+  for (const auto i : c10::irange(chunk_size)) {
+    auto linear_idx = chunk_begin + i;
+    // Decompose the linear index into a row-major multi-index over the
+    // batch dims, e.g. linear_idx = 3, batch_sizes = [5, 2] -> [1, 0].
+    SmallVector<int64_t, kVmapStaticDimVecSize> index(batch_sizes.size(), 0);
+    for (int64_t dim = static_cast<int64_t>(batch_sizes.size()) - 1; dim >= 0;
+         --dim) {
+      index[dim] = linear_idx % batch_sizes[dim];
+      linear_idx /= batch_sizes[dim];
+    }
+    Tensor slice = physical;
+    for (const auto idx : index) {
+      slice = slice.select(0, idx);
+    }
+    slices.push_back(std::move(slice));
   }
-  std::reverse(std::begin(result), std::end(result));
-  return result;
+  return slices;
 }
 
 static bool areAllReturnsTensors(const FunctionSchema& schema) {
@@ -66,6 +105,39 @@ static bool isInplaceOp(const c10::FunctionSchema& schema) {
   return return_alias_info && return_alias_info->isWrite();
 }
 
+namespace {
+// Schema-derived facts needed by the fallback, cached per operator so
+// repeated hits (e.g. per-sample-gradient jobs invoking the same
+// un-batched op once per layer per step) skip re-parsing alias and return
+// info. See Note [Chunked vmap fallback].
+struct FallbackPlan {
+  bool is_inplace;
+  bool all_returns_tensors;
+  bool any_tensorlist_args;
+  bool mutable_or_aliasing;
+};
+
+const FallbackPlan& fallbackPlanFor(const c10::OperatorHandle& op) {
+  static std::mutex mutex;
+  // Keyed by the full operator name (including overload); references into
+  // the map stay valid across inserts.
+  static std::unordered_map<std::string, FallbackPlan> plans;
+  std::lock_guard<std::mutex> guard(mutex);
+  auto key = c10::toString(op.operator_name());
+  auto it = plans.find(key);
+  if (it == plans.end()) {
+    const auto& schema = op.schema();
+    FallbackPlan plan;
+    plan.is_inplace = isInplaceOp(schema);
+    plan.all_returns_tensors = areAllReturnsTensors(schema);
+    plan.any_tensorlist_args = areAnyArgumentsTensorList(schema);
+    plan.mutable_or_aliasing = schema.is_mutable() || schema.hasAnyAliasInfo();
+    it = plans.emplace(std::move(key), plan).first;
+  }
+  return it->second;
+}
+} // namespace
+
 static void warnFallback(const c10::FunctionSchema& schema) {
   if (!globalContext().areVmapFallbackWarningsEnabled()) {
     return;
@@ -174,32 +246,45 @@ void batchedTensorInplaceForLoopFallback(const c10::OperatorHandle& op, torch::j
       "Batching rule not implemented for ", schema.operator_name(), ". ",
       "The fallback path does not support vmap over dims of size 0.");
 
-  // Strategy: For each batch, we are going to push slices (where applicable)
-  // of the arguments onto `stack`, and call `op`.
-  for (const auto linear_idx : c10::irange(num_batches)) {
-    auto index = computeIndex(linear_idx, batch_sizes);
-    auto batched_tensor_inputs_pos_iter = batched_tensor_inputs_position.begin();
-    auto input_physical_views_iter = input_physical_views.begin();
-    for (const auto arg_idx : c10::irange(num_arguments)) {
-      // We assume that torch::jit::Stack is backed by vector<IValue> for
-      // simplicity. When that is not the case, this code should be updated.
-      const auto& argument = (*stack)[arguments_begin + arg_idx];
-      if (batched_tensor_inputs_pos_iter == batched_tensor_inputs_position.end()
-          || arg_idx != *batched_tensor_inputs_pos_iter) {
-        // argument isn't a BatchedTensor
-        torch::jit::push(stack, argument);
-        continue;
-      }
-      // argument is a BatchedTensor
-      TORCH_INTERNAL_ASSERT(input_physical_views_iter != input_physical_views.end());
-      const auto& physical_view_for_argument = *input_physical_views_iter;
-      torch::jit::push(stack, physical_view_for_argument.tensor().index(index));
-      batched_tensor_inputs_pos_iter++;
-      input_physical_views_iter++;
+  // Strategy: For each chunk of examples, materialize the slices of every
+  // batched argument, then push slices (where applicable) of the arguments
+  // onto `stack` and call `op` once per example.
+  // See Note [Chunked vmap fallback].
+  std::vector<std::vector<Tensor>> chunk_slices(input_physical_views.size());
+  for (int64_t chunk_begin = 0; chunk_begin < num_batches;
+       chunk_begin += kFallbackChunkSize) {
+    const auto chunk_size =
+        std::min(kFallbackChunkSize, num_batches - chunk_begin);
+    for (const auto input_idx : c10::irange(input_physical_views.size())) {
+      chunk_slices[input_idx] = materializeChunkSlices(
+          input_physical_views[input_idx].tensor(),
+          batch_sizes,
+          chunk_begin,
+          chunk_size);
     }
+    for (const auto chunk_idx : c10::irange(chunk_size)) {
+      auto batched_tensor_inputs_pos_iter = batched_tensor_inputs_position.begin();
+      size_t input_idx = 0;
+      for (const auto arg_idx : c10::irange(num_arguments)) {
+        // We assume that torch::jit::Stack is backed by vector<IValue> for
+        // simplicity. When that is not the case, this code should be updated.
+        const auto& argument = (*stack)[arguments_begin + arg_idx];
+        if (batched_tensor_inputs_pos_iter == batched_tensor_inputs_position.end()
+            || arg_idx != *batched_tensor_inputs_pos_iter) {
+          // argument isn't a BatchedTensor
+          torch::jit::push(stack, argument);
+          continue;
+        }
+        // argument is a BatchedTensor
+        TORCH_INTERNAL_ASSERT(input_idx < chunk_slices.size());
+        torch::jit::push(stack, chunk_slices[input_idx][chunk_idx]);
+        batched_tensor_inputs_pos_iter++;
+        input_idx++;
+      }
 
-    op.callBoxed(stack);
-    torch::jit::drop(stack, 1);
+      op.callBoxed(stack);
+      torch::jit::drop(stack, 1);
+    }
   }
 
   // Return the tensor that was written to in-place
@@ -250,14 +335,16 @@ void batchedTensorForLoopFallback(const c10::OperatorHandle& op, torch::jit::Sta
   const auto& schema = op.schema();
   const auto num_returns = schema.returns().size();
 
-  if (isInplaceOp(schema)) {
+  // See Note [Chunked vmap fallback] for why the schema analysis is cached.
+  const auto& plan = fallbackPlanFor(op);
+  if (plan.is_inplace) {
     batchedTensorInplaceForLoopFallback(op, stack);
     return;
   }
-  TORCH_CHECK(!schema.is_mutable() && !schema.hasAnyAliasInfo(),
+  TORCH_CHECK(!plan.mutable_or_aliasing,
               "Batching rule not implemented for ", schema.operator_name(), "; ",
               "the fallback path doesn't work on out= or view ops.");
-  TORCH_CHECK(areAllReturnsTensors(schema) && !areAnyArgumentsTensorList(schema),
+  TORCH_CHECK(plan.all_returns_tensors && !plan.any_tensorlist_args,
               "Batching rule not implemented for ", schema.operator_name(), ". ",
               "We could not generate a fallback.");
   TORCH_CHECK(num_returns >= 1,
@@ -307,9 +394,10 @@ void batchedTensorForLoopFallback(const c10::OperatorHandle& op, torch::jit::Sta
       "Batching rule not implemented for ", schema.operator_name(), ". ",
       "The fallback path does not support vmap over dims of size 0.");
 
-  // Strategy: For each batch, we are going to push slices (where applicable)
-  // of the arguments onto `stack`, call `op`, and store the result in
-  // `output_shards`.
+  // Strategy: For each chunk of examples, materialize the slices of every
+  // batched argument (see Note [Chunked vmap fallback]), then push slices
+  // (where applicable) of the arguments onto `stack`, call `op`, and store
+  // the result in `output_shards`.
   //
   // NOTE: [Output shards layout]
   // Assume that the operator has three outputs: a, b, c.
@@ -319,37 +407,49 @@ void batchedTensorForLoopFallback(const c10::OperatorHandle& op, torch::jit::Sta
   // more easily in the next step.
   std::vector<Tensor> output_shards(num_batches * num_returns);
 
-  for (const auto linear_idx : c10::irange(num_batches)) {
-    auto index = computeIndex(linear_idx, batch_sizes);
-    auto batched_tensor_inputs_pos_iter = batched_tensor_inputs_position.begin();
-    auto input_physical_views_iter = input_physical_views.begin();
-    for (const auto arg_idx : c10::irange(num_arguments)) {
-      // We assume that torch::jit::Stack is backed by vector<IValue> for
-      // simplicity. When that is not the case, this code should be updated.
-      const auto& argument = (*stack)[arguments_begin + arg_idx];
-      if (batched_tensor_inputs_pos_iter == batched_tensor_inputs_position.end()
-          || arg_idx != *batched_tensor_inputs_pos_iter) {
-        // argument isn't a BatchedTensor
-        torch::jit::push(stack, argument);
-        continue;
-      }
-      // argument is a BatchedTensor
-      TORCH_INTERNAL_ASSERT(input_physical_views_iter != input_physical_views.end());
-      const auto& physical_view_for_argument = *input_physical_views_iter;
-      torch::jit::push(stack, physical_view_for_argument.tensor().index(index));
-      batched_tensor_inputs_pos_iter++;
-      input_physical_views_iter++;
+  std::vector<std::vector<Tensor>> chunk_slices(input_physical_views.size());
+  for (int64_t chunk_begin = 0; chunk_begin < num_batches;
+       chunk_begin += kFallbackChunkSize) {
+    const auto chunk_size =
+        std::min(kFallbackChunkSize, num_batches - chunk_begin);
+    for (const auto input_idx : c10::irange(input_physical_views.size())) {
+      chunk_slices[input_idx] = materializeChunkSlices(
+          input_physical_views[input_idx].tensor(),
+          batch_sizes,
+          chunk_begin,
+          chunk_size);
     }
+    for (const auto chunk_idx : c10::irange(chunk_size)) {
+      const auto linear_idx = chunk_begin + chunk_idx;
+      auto batched_tensor_inputs_pos_iter = batched_tensor_inputs_position.begin();
+      size_t input_idx = 0;
+      for (const auto arg_idx : c10::irange(num_arguments)) {
+        // We assume that torch::jit::Stack is backed by vector<IValue> for
+        // simplicity. When that is not the case, this code should be updated.
+        const auto& argument = (*stack)[arguments_begin + arg_idx];
+        if (batched_tensor_inputs_pos_iter == batched_tensor_inputs_position.end()
+            || arg_idx != *batched_tensor_inputs_pos_iter) {
+          // argument isn't a BatchedTensor
+          torch::jit::push(stack, argument);
+          continue;
+        }
+        // argument is a BatchedTensor
+        TORCH_INTERNAL_ASSERT(input_idx < chunk_slices.size());
+        torch::jit::push(stack, chunk_slices[input_idx][chunk_idx]);
+        batched_tensor_inputs_pos_iter++;
+        input_idx++;
+      }
 
-    op.callBoxed(stack);
+      op.callBoxed(stack);
 
-    // Store the result into `output_shards`. See NOTE: [Output shards layout]
-    // to learn about the details of how we store the shards.
-    const auto returns = torch::jit::last(stack, num_returns);
-    for (const auto return_idx : c10::irange(returns.size())) {
-      output_shards[num_batches * return_idx + linear_idx] = returns[return_idx].toTensor();
+      // Store the result into `output_shards`. See NOTE: [Output shards layout]
+      // to learn about the details of how we store the shards.
+      const auto returns = torch::jit::last(stack, num_returns);
+      for (const auto return_idx : c10::irange(returns.size())) {
+        output_shards[num_batches * return_idx + linear_idx] = returns[return_idx].toTensor();
+      }
+      torch::jit::drop(stack, num_returns);
     }
-    torch::jit::drop(stack, num_returns);
   }
 
   // For each output Tensor, stack the shards of the tensor together to form a return
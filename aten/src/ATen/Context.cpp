@@ -63,6 +63,14 @@ void Context::setDeterministicCuDNN(bool b) {
   deterministic_cudnn = b;
 }
 
+bool Context::pinnedCuDNNAlgorithms() const {
+  return pinned_cudnn_algorithms;
+}
+
+void Context::setPinnedCuDNNAlgorithms(bool b) {
+  pinned_cudnn_algorithms = b;
+}
+
 bool Context::deterministicAlgorithms() const {
   return _deterministic_algorithms;
 }
@@ -220,6 +228,14 @@ void Context::setAllowFP16ReductionCuBLAS(bool b) {
   allow_fp16_reduction_cublas = b;
 }
 
+size_t Context::chunkedPageableCopyThreshold() const {
+  return chunked_pageable_copy_threshold;
+}
+
+void Context::setChunkedPageableCopyThreshold(size_t nbytes) {
+  chunked_pageable_copy_threshold = nbytes;
+}
+
 bool Context::hasMKL() {
 #if AT_MKL_ENABLED()
   return true;
@@ -125,6 +125,15 @@ class TORCH_API Context {
   void setBenchmarkLimitCuDNN(int);
   bool deterministicCuDNN() const;
   void setDeterministicCuDNN(bool);
+  // When pinned, cuDNN algorithm choices already recorded in the benchmark
+  // cache (typically captured during a calibration run with benchmarkCuDNN()
+  // enabled and persisted via TORCH_CUDNN_BENCHMARK_CACHE_PATH) are replayed
+  // verbatim, and cache misses fall back to the default algorithm instead of
+  // re-running the benchmark or the heuristics. This trades peak throughput
+  // for a flat, reproducible kernel choice per convolution signature. See
+  // Note [Pinned cuDNN algorithms] in aten/src/ATen/native/cudnn/Conv_v7.cpp.
+  bool pinnedCuDNNAlgorithms() const;
+  void setPinnedCuDNNAlgorithms(bool);
 
   at::LinalgBackend linalgPreferredBackend() const;
   void setLinalgPreferredBackend(at::LinalgBackend);
@@ -219,6 +228,12 @@ class TORCH_API Context {
   void setFloat32MatmulPrecision(Float32MatmulPrecision p);
   bool allowFP16ReductionCuBLAS() const;
   void setAllowFP16ReductionCuBLAS(bool);
+  // Size in bytes at which blocking copies between pageable CPU memory and
+  // CUDA devices are split into chunks pipelined through pinned staging
+  // buffers. Setting the threshold to 0 disables chunking. See
+  // Note [Chunked pageable copy] in aten/src/ATen/native/cuda/Copy.cu.
+  size_t chunkedPageableCopyThreshold() const;
+  void setChunkedPageableCopyThreshold(size_t nbytes);
   at::QEngine qEngine() const;
   void setQEngine(at::QEngine e);
   static const std::vector<at::QEngine>& supportedQEngines();
@@ -251,6 +266,7 @@ class TORCH_API Context {
   c10::once_flag thh_init;
   bool enabled_cudnn = true;
   bool deterministic_cudnn = false;
+  bool pinned_cudnn_algorithms = false;
   bool _deterministic_algorithms = false;
   bool _deterministic_algorithms_warn_only = false;
   bool benchmark_cudnn = false;
@@ -259,6 +275,7 @@ class TORCH_API Context {
   int benchmark_limit_cudnn = 10;
   bool allow_tf32_cudnn = true;
   bool allow_fp16_reduction_cublas = true;
+  size_t chunked_pageable_copy_threshold = 64 * 1024 * 1024;
   bool enabled_mkldnn = true;
   at::LinalgBackend linalg_preferred_backend = at::LinalgBackend::Default;
 #ifdef C10_MOBILE
@@ -1,5 +1,7 @@
 #include <ATen/DLConvertor.h>
 #include <ATen/Functions.h>
+#include <c10/core/Event.h>
+#include <c10/core/impl/VirtualGuardImpl.h>
 
 #include <iostream>
 #include <sstream>
@@ -202,6 +204,28 @@ ScalarType toScalarType(const DLDataType& dtype) {
   return stype;
 }
 
+// Makes `consumer` wait for work queued on `producer` via an event, so
+// DLPack hand-offs between frameworks stay asynchronous (no device
+// sync). Uses the backend-agnostic c10::Event since this file builds
+// into CPU-only ATen; for CUDA it lowers to record/wait on the streams.
+static void joinStreams(const c10::Stream& producer, const c10::Stream& consumer) {
+  if (producer == consumer) {
+    return;
+  }
+  c10::Event event(producer.device_type());
+  event.record(producer);
+  event.block(consumer);
+}
+
+static void checkExchangeStream(const c10::Stream& stream, const Device& device) {
+  TORCH_CHECK(
+      stream.device() == device,
+      "DLPack exchange stream is on ",
+      stream.device(),
+      " but the tensor is on ",
+      device);
+}
+
 // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init)
 struct ATenDLMTensor {
   Tensor handle;
@@ -214,7 +238,14 @@ void deleter(DLManagedTensor* arg) {
 
 // This function returns a shared_ptr to memory managed DLpack tensor
 // constructed out of ATen tensor
-DLManagedTensor* toDLPack(const Tensor& src) {
+DLManagedTensor* toDLPack(
+    const Tensor& src,
+    c10::optional<c10::Stream> consumer_stream) {
+  if (consumer_stream.has_value() && src.device().type() != DeviceType::CPU) {
+    checkExchangeStream(*consumer_stream, src.device());
+    c10::impl::VirtualGuardImpl impl(src.device().type());
+    joinStreams(impl.getStream(src.device()), *consumer_stream);
+  }
   ATenDLMTensor* atDLMTensor(new ATenDLMTensor);
   atDLMTensor->handle = src;
   atDLMTensor->tensor.manager_ctx = atDLMTensor;
@@ -237,9 +268,16 @@ DLManagedTensor* toDLPack(const Tensor& src) {
   return &(atDLMTensor->tensor);
 }
 
-Tensor fromDLPack(const DLManagedTensor* src) {
+Tensor fromDLPack(
+    const DLManagedTensor* src,
+    c10::optional<c10::Stream> producer_stream) {
   Device device = getATenDevice(src->dl_tensor.device);
   ScalarType stype = toScalarType(src->dl_tensor.dtype);
+  if (producer_stream.has_value() && device.type() != DeviceType::CPU) {
+    checkExchangeStream(*producer_stream, device);
+    c10::impl::VirtualGuardImpl impl(device.type());
+    joinStreams(*producer_stream, impl.getStream(device));
+  }
   auto deleter = [src](void* self) {
     // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
     src->deleter(const_cast<DLManagedTensor*>(src));
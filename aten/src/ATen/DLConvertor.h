@@ -3,6 +3,8 @@
 #include <ATen/ATen.h>
 #include <ATen/Tensor.h>
 #include <ATen/dlpack.h>
+#include <c10/core/Stream.h>
+#include <c10/util/Optional.h>
 
 // this convertor will:
 // 1) take a Tensor object and wrap it in the DLPack tensor
@@ -11,8 +13,27 @@
 namespace at {
 
 TORCH_API ScalarType toScalarType(const DLDataType& dtype);
-TORCH_API DLManagedTensor* toDLPack(const Tensor& src);
-TORCH_API Tensor fromDLPack(const DLManagedTensor* src);
+
+// Wraps `src` in a DLPack tensor without copying. If `consumer_stream`
+// is given (the stream the consumer will read the data on, per the
+// DLPack exchange protocol), an event is recorded on the current stream
+// of src's device and the consumer stream is made to wait on it, so the
+// hand-off needs no device synchronization. External streams (e.g. a
+// TensorRT execution stream) can be wrapped with
+// at::cuda::getStreamFromExternal. Ignored for CPU tensors.
+TORCH_API DLManagedTensor* toDLPack(
+    const Tensor& src,
+    c10::optional<c10::Stream> consumer_stream = c10::nullopt);
+
+// Converts a DLPack tensor to an ATen tensor without copying. If
+// `producer_stream` is given (the stream the producer wrote the data
+// on), the current stream of the tensor's device waits on an event
+// recorded there instead of the caller having to synchronize the
+// device. Ignored for CPU tensors.
+TORCH_API Tensor fromDLPack(
+    const DLManagedTensor* src,
+    c10::optional<c10::Stream> producer_stream = c10::nullopt);
+
 TORCH_API DLDataType getDLDataType(const Tensor& t);
 TORCH_API DLDevice getDLContext(const Tensor& tensor, const int64_t& device_id);
 
@@ -28,6 +28,29 @@ inline constexpr bool should_include_kernel_dtype(
 } // namespace at
 #endif
 
+/**
+ * The build-wide dtype allowlist, the server-build counterpart of the
+ * per-kernel-tag selectivity above. When TORCH_DTYPE_SELECTIVE_BUILD is
+ * defined (cmake -DSELECTED_DTYPE_LIST=Float,BFloat16,Long,...), the
+ * generated header restricts dtype_in_build_allowlist() to the listed
+ * dtypes and the AT_DISPATCH_* macros prune the kernel bodies of every
+ * other dtype: the excluded cases reduce to an unconditional throw, so
+ * their instantiations are dead code and drop out of the binary. As with
+ * the mobile allowlist, dispatching an excluded dtype becomes a runtime
+ * error.
+ */
+#ifdef TORCH_DTYPE_SELECTIVE_BUILD
+#include <ATen/selected_dtypes.h>
+#else
+namespace at {
+inline constexpr bool dtype_in_build_allowlist(
+    at::ScalarType /*scalar_type*/
+) {
+  return true;
+}
+} // namespace at
+#endif
+
 /**
  * In the Facebook internal build (using BUCK), this macro is enabled by
  * passing in -c pt.enable_record_kernel_dtype=1 when building the tracer
@@ -49,26 +72,30 @@ TORCH_API void record_kernel_function_dtype(std::string name);
 
 // Avoid if_constexpr if possble, as it's more expensive to compile
 #if defined __cpp_if_constexpr
-#define AT_PRIVATE_CHECK_SELECTIVE_BUILD(enum_type)   \
-  do {                                                \
-    if constexpr (!at::should_include_kernel_dtype(   \
-                      at_dispatch_name, enum_type)) { \
-      AT_ERROR(                                       \
-          "dtype '",                                  \
-          toString(enum_type),                        \
-          "' not selected for kernel tag ",           \
-          at_dispatch_name);                          \
-    }                                                 \
+#define AT_PRIVATE_CHECK_SELECTIVE_BUILD(enum_type)  \
+  do {                                               \
+    if constexpr (                                   \
+        !at::should_include_kernel_dtype(            \
+            at_dispatch_name, enum_type) ||          \
+        !at::dtype_in_build_allowlist(enum_type)) {  \
+      AT_ERROR(                                      \
+          "dtype '",                                 \
+          toString(enum_type),                       \
+          "' not selected for kernel tag ",          \
+          at_dispatch_name);                         \
+    }                                                \
   } while (0)
 #else // defined __cpp_if_constexpr
-#define AT_PRIVATE_CHECK_SELECTIVE_BUILD(enum_type)        \
-  at::guts::if_constexpr<!at::should_include_kernel_dtype( \
-      at_dispatch_name, enum_type)>([&] {                  \
-    AT_ERROR(                                              \
-        "dtype '",                                         \
-        toString(enum_type),                               \
-        "' not selected for kernel tag ",                  \
-        at_dispatch_name);                                 \
+#define AT_PRIVATE_CHECK_SELECTIVE_BUILD(enum_type)               \
+  at::guts::if_constexpr<                                         \
+      !at::should_include_kernel_dtype(                           \
+          at_dispatch_name, enum_type) ||                         \
+      !at::dtype_in_build_allowlist(enum_type)>([&] {             \
+    AT_ERROR(                                                     \
+        "dtype '",                                                \
+        toString(enum_type),                                      \
+        "' not selected for kernel tag ",                         \
+        at_dispatch_name);                                        \
   })
 #endif
 
@@ -610,4 +610,53 @@ MapAllocator::~MapAllocator() {
   c10::reportMemoryUsageToProfiler(base_ptr_, -size_, 0, 0, c10::Device(c10::DeviceType::CPU));
 }
 
+// Note [Allocate-shared CPU storage]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// `share_memory_()` moves an already-allocated storage into shared memory
+// with a full copy. For pipelines that create large tensors only to hand
+// them to another process, that copy dominates the hand-off cost. When a
+// nonzero threshold is set, the allocator below makes every CPU allocation
+// of at least that size shared-memory backed from birth: an unlinked shm
+// file with the fd kept open (memfd semantics). `_share_fd_cpu_` then finds
+// the MapAllocator context already in place and passes the fd with no
+// memcpy. Smaller allocations fall through to the default CPU allocator.
+// The allocator stays installed once enabled; setting the threshold back to
+// zero routes everything through the default allocator again.
+
+static std::atomic<size_t> shareable_cpu_threshold{0};
+
+struct ShareableCPUAllocator final : public at::Allocator {
+  at::DataPtr allocate(size_t nbytes) const override {
+#ifndef _WIN32
+    size_t threshold = shareable_cpu_threshold.load(std::memory_order_relaxed);
+    if (threshold != 0 && nbytes >= threshold) {
+      int flags = ALLOCATOR_MAPPED_SHAREDMEM | ALLOCATOR_MAPPED_EXCLUSIVE |
+          ALLOCATOR_MAPPED_KEEPFD | ALLOCATOR_MAPPED_UNLINK;
+      return MapAllocator::makeDataPtr(
+          NewProcessWideShmHandle(), flags, nbytes, nullptr);
+    }
+#endif
+    return c10::GetDefaultCPUAllocator()->allocate(nbytes);
+  }
+};
+
+static ShareableCPUAllocator shareable_cpu_allocator;
+
+void SetShareableCPUAllocatorThreshold(size_t nbytes) {
+#ifdef _WIN32
+  TORCH_CHECK(
+      nbytes == 0,
+      "Allocate-shared CPU storage requires fd-based sharing, which is "
+      "unsupported on Windows");
+#endif
+  size_t prev = shareable_cpu_threshold.exchange(nbytes);
+  if (nbytes != 0 && prev == 0) {
+    c10::SetCPUAllocator(&shareable_cpu_allocator);
+  }
+}
+
+size_t GetShareableCPUAllocatorThreshold() {
+  return shareable_cpu_threshold.load(std::memory_order_relaxed);
+}
+
 }  // namespace at
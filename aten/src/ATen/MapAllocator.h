@@ -20,6 +20,14 @@ enum WithFd { WITH_FD };
 
 TORCH_API std::string NewProcessWideShmHandle();
 
+// See Note [Allocate-shared CPU storage] in MapAllocator.cpp. A threshold of
+// zero (the default) disables the mode; any other value installs a CPU
+// allocator that makes allocations of at least that many bytes shared-memory
+// backed from birth, so cross-process hand-off is a pure fd pass with no
+// copy. Unsupported on Windows.
+TORCH_API void SetShareableCPUAllocatorThreshold(size_t nbytes);
+TORCH_API size_t GetShareableCPUAllocatorThreshold();
+
 class TORCH_API MapAllocator {
  public:
   MapAllocator(std::string filename, int flags, size_t size);
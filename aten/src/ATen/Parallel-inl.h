@@ -19,6 +19,22 @@ inline void parallel_for(
 #ifdef INTRA_OP_PARALLEL
   at::internal::lazy_init_num_threads();
   const auto numiter = end - begin;
+  if (C10_UNLIKELY(internal::parallel_tuner_active())) {
+    // See Note [Adaptive intra-op tuning] in ParallelCommon.cpp. The tuner
+    // may inflate the grain size to cap the thread budget for this region's
+    // signature; the scope records the elapsed time on destruction.
+    internal::ParallelTunerScope tuner(numiter, grain_size);
+    const bool use_parallel =
+        (numiter > tuner.grain_size() && numiter > 1 &&
+         !at::in_parallel_region() && at::get_num_threads() > 1);
+    if (!use_parallel) {
+      internal::ThreadIdGuard tid_guard(0);
+      f(begin, end);
+      return;
+    }
+    internal::invoke_parallel(begin, end, tuner.grain_size(), f);
+    return;
+  }
   const bool use_parallel =
       (numiter > grain_size && numiter > 1 && !at::in_parallel_region() &&
        at::get_num_threads() > 1);
@@ -1,7 +1,9 @@
 #pragma once
 #include <ATen/Config.h>
 #include <c10/macros/Macros.h>
+#include <cstdint>
 #include <functional>
+#include <vector>
 
 namespace at {
 
@@ -25,8 +27,44 @@ TORCH_API int get_thread_num();
 // Checks whether the code runs in parallel region
 TORCH_API bool in_parallel_region();
 
+// One logical CPU and its place in the cache/package hierarchy. See
+// Note [Thread affinity] in ParallelCommon.cpp.
+struct CoreInfo {
+  // OS processor id, usable in set_thread_affinity().
+  int32_t cpu;
+  // Physical core index; two SMT siblings share one core index.
+  int32_t core;
+  // Index of the L3 cache this CPU sits under (a CCX/CCD on chiplet
+  // parts), or -1 when unknown.
+  int32_t l3_group;
+  // Package (socket) index, or -1 when unknown.
+  int32_t numa_node;
+};
+
+// Enumerates the logical CPUs of the machine with their core, shared-L3
+// group and package assignment, discovered through cpuinfo. Returns an
+// empty vector when topology discovery is unavailable.
+TORCH_API std::vector<CoreInfo> cpu_topology();
+
+// Restricts this thread and, transitively, every ATen worker thread to
+// the given OS processor ids (as reported by cpu_topology()). An empty
+// list lifts the restriction. See Note [Thread affinity] in
+// ParallelCommon.cpp for how the mask propagates to existing pools.
+TORCH_API void set_thread_affinity(const std::vector<int>& cpus);
+
+// The core set declared via set_thread_affinity(); empty when
+// unrestricted.
+TORCH_API std::vector<int> get_thread_affinity();
+
 namespace internal {
 
+// The published affinity generation; bumped by at::set_thread_affinity.
+// See Note [Thread affinity] in ParallelCommon.cpp.
+TORCH_API uint64_t thread_affinity_generation();
+
+// Applies the currently declared affinity mask to the calling thread.
+TORCH_API void apply_thread_affinity();
+
 // Initialise num_threads lazily at first parallel call
 inline TORCH_API void lazy_init_num_threads() {
   thread_local bool init = false;
@@ -34,10 +72,45 @@ inline TORCH_API void lazy_init_num_threads() {
     at::init_num_threads();
     init = true;
   }
+  // Pick up affinity masks published after this thread last checked.
+  // See Note [Thread affinity] in ParallelCommon.cpp.
+  thread_local uint64_t affinity_generation = 0;
+  const auto generation = thread_affinity_generation();
+  if (C10_UNLIKELY(affinity_generation != generation)) {
+    affinity_generation = generation;
+    apply_thread_affinity();
+  }
 }
 
 TORCH_API void set_thread_num(int);
 
+// Returns true when adaptive intra-op tuning was requested via the
+// TORCH_ADAPTIVE_PARALLEL environment variable. See
+// Note [Adaptive intra-op tuning] in ParallelCommon.cpp.
+TORCH_API bool parallel_tuner_active();
+
+// RAII scope measuring one parallel_for region for the adaptive tuner.
+// The constructor looks up the per-signature policy and may inflate the
+// grain size to cap the thread budget; the destructor records the elapsed
+// wall time for the chosen configuration.
+class TORCH_API ParallelTunerScope {
+ public:
+  ParallelTunerScope(int64_t numiter, int64_t grain_size);
+  ~ParallelTunerScope();
+  ParallelTunerScope(const ParallelTunerScope&) = delete;
+  ParallelTunerScope& operator=(const ParallelTunerScope&) = delete;
+
+  int64_t grain_size() const {
+    return grain_size_;
+  }
+
+ private:
+  uint64_t signature_;
+  int arm_;
+  uint64_t start_ns_;
+  int64_t grain_size_;
+};
+
 class TORCH_API ThreadIdGuard {
  public:
   ThreadIdGuard(int new_id) : old_id_(at::get_thread_num()) {
@@ -140,6 +213,21 @@ namespace internal {
 void launch_no_thread_state(std::function<void()> fn);
 } // namespace internal
 
+// Sets whether inter-op tasks may be scheduled NUMA-affine. When enabled,
+// launch_with_numa_hint routes tasks to a worker group bound to the hinted
+// NUMA node instead of the shared inter-op pool, keeping forked subgraphs
+// next to the socket that holds their operands. Also settable via the
+// TORCH_NUMA_INTEROP environment variable. No-op when NUMA is unavailable.
+TORCH_API void set_numa_interop_enabled(bool enabled);
+
+// Returns whether NUMA-affine inter-op scheduling is enabled
+TORCH_API bool numa_interop_enabled();
+
+// Launches inter-op parallel task on the worker group bound to `numa_node`;
+// falls back to launch() when the hint is -1, NUMA-affine scheduling is
+// disabled, or NUMA is unavailable
+TORCH_API void launch_with_numa_hint(int numa_node, std::function<void()> func);
+
 // Launches intra-op parallel task
 TORCH_API void intraop_launch(std::function<void()> func);
 
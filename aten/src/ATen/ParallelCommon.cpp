@@ -4,8 +4,25 @@
 #include <ATen/PTThreadPool.h>
 #include <ATen/Version.h>
 
+#include <c10/core/MemoryWatermark.h>
+#include <c10/util/env.h>
+
+#include <cpuinfo.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <mutex>
 #include <sstream>
+#include <string>
 #include <thread>
+#include <unordered_map>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
 
 #if AT_MKL_ENABLED()
 #include <mkl.h>
@@ -40,8 +57,332 @@ size_t get_env_num_threads(const char* var_name, size_t def_value = 0) {
   return def_value;
 }
 
+// Note [Adaptive intra-op tuning]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The intra-op thread count is fixed at init time from OMP_NUM_THREADS-style
+// settings, but mixed workloads want different splits per region: a large
+// GEMM scales to every core while a small pointwise op spends more time in
+// pool dispatch than in its lambda. When TORCH_ADAPTIVE_PARALLEL=1 is set,
+// parallel_for consults a per-signature controller instead of using the
+// static grain size unconditionally.
+//
+// A signature is (current dispatcher op name, declared grain size, log2
+// bucket of the iteration count) - the triple that determines how a region
+// scales. For each signature the controller runs a small multi-armed bandit
+// over thread budgets 1, 2, 4, ..., up to at::get_num_threads(). A budget is
+// realized by inflating the grain size to divup(numiter, budget), which caps
+// the task count in calc_num_tasks_and_chunk_size without touching the
+// backends. Each arm is measured kTunerWarmupSamples times (wall time of the
+// whole region, including pool dispatch and the wait); afterwards the
+// fastest arm is exploited, with a rotating re-exploration every
+// kTunerExploreInterval calls so the policy adapts when core contention
+// changes. Arm timings are tracked as an EWMA so stale measurements age out.
+//
+// The policy state - per signature: the winning budget, call count and the
+// achieved parallel efficiency versus the single-thread arm - is appended to
+// at::get_parallel_info(). The default path through parallel_for is
+// untouched when the environment variable is not set.
+
+constexpr int kMaxTunerArms = 7; // thread budgets 1, 2, 4, ..., 64
+constexpr int64_t kTunerWarmupSamples = 3;
+constexpr int64_t kTunerExploreInterval = 16;
+constexpr size_t kMaxTunerSignatures = 1024;
+
+struct TunerArm {
+  int64_t samples = 0;
+  double avg_ns = 0.0;
+};
+
+struct TunerEntry {
+  std::string desc;
+  std::array<TunerArm, kMaxTunerArms> arms;
+  int64_t calls = 0;
+};
+
+struct TunerState {
+  std::mutex mutex;
+  std::unordered_map<uint64_t, TunerEntry> entries;
+};
+
+TunerState& tuner_state() {
+  static TunerState state;
+  return state;
+}
+
+uint64_t tuner_now_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+int log2_bucket(int64_t n) {
+  int bucket = 0;
+  while (n > 1) {
+    n >>= 1;
+    bucket++;
+  }
+  return bucket;
+}
+
+uint64_t tuner_signature(
+    const char* op_name, int64_t grain_size, int size_bucket) {
+  // FNV-1a over the op name, then mix in the grain size and size bucket.
+  uint64_t h = 0xcbf29ce484222325ULL;
+  for (const char* p = op_name; *p != '\0'; ++p) {
+    h = (h ^ (uint64_t)(unsigned char)*p) * 0x100000001b3ULL;
+  }
+  h = (h ^ (uint64_t)grain_size) * 0x100000001b3ULL;
+  h = (h ^ (uint64_t)size_bucket) * 0x100000001b3ULL;
+  return h;
+}
+
+// Number of candidate budgets given the current thread count: budgets
+// 1 << arm, with the last arm clamped to nthreads.
+int num_tuner_arms(int nthreads) {
+  int narms = 1;
+  while (narms < kMaxTunerArms && (1 << (narms - 1)) < nthreads) {
+    narms++;
+  }
+  return narms;
+}
+
+int tuner_arm_budget(int arm, int nthreads) {
+  return std::min(1 << arm, nthreads);
+}
+
+// Note [Thread affinity]
+// ~~~~~~~~~~~~~~~~~~~~~~
+// Under co-location the OS is free to migrate ATen worker threads across
+// cores, and on multi-CCD parts a migration across an L3 boundary throws
+// away the cache footprint a worker just built up. The thread-count knobs
+// say nothing about placement, so co-located services also end up
+// fighting over the same cores.
+//
+// at::set_thread_affinity() declares one process-wide core set for ATen
+// threads. The mask reaches every thread through three routes:
+//
+//  - it is applied to the calling thread immediately;
+//  - threads created afterwards inherit it from their creator, which
+//    covers intra-op and inter-op pool threads spun up lazily after the
+//    call;
+//  - threads that already exist re-apply it lazily: the mask is published
+//    under a generation counter, and lazy_init_num_threads() — which
+//    already runs on entry to every parallel region, on the caller and on
+//    pool workers alike — compares a thread-local generation against the
+//    published one and calls apply_thread_affinity() when it changed.
+//
+// The same rules give inter-op pools their inheritance behavior: at::launch
+// tasks run lazy_init_num_threads() through the parallel primitives they
+// call, so they converge onto the declared set the first time they do
+// tensor work after a change. Placement decisions (which cores share an
+// L3, which SMT siblings to avoid) are left to the caller, who can read
+// the layout from at::cpu_topology().
+
+struct AffinityState {
+  std::mutex mutex;
+  // Declared OS processor ids; empty means unrestricted.
+  std::vector<int> cpus;
+};
+
+AffinityState& affinity_state() {
+  static AffinityState state;
+  return state;
+}
+
+std::atomic<uint64_t> affinity_generation{0};
+
+int choose_tuner_arm(const TunerEntry& entry, int narms) {
+  // Warmup: measure the least-sampled arm until every arm has a baseline.
+  int least_sampled = 0;
+  for (int arm = 1; arm < narms; ++arm) {
+    if (entry.arms[arm].samples < entry.arms[least_sampled].samples) {
+      least_sampled = arm;
+    }
+  }
+  if (entry.arms[least_sampled].samples < kTunerWarmupSamples) {
+    return least_sampled;
+  }
+  // Periodically re-explore a rotating arm so the policy can follow
+  // contention changes; otherwise exploit the fastest arm.
+  if (entry.calls % kTunerExploreInterval == 0) {
+    return (int)((entry.calls / kTunerExploreInterval) % narms);
+  }
+  int best = 0;
+  for (int arm = 1; arm < narms; ++arm) {
+    if (entry.arms[arm].avg_ns < entry.arms[best].avg_ns) {
+      best = arm;
+    }
+  }
+  return best;
+}
+
 } // namespace
 
+namespace internal {
+
+uint64_t thread_affinity_generation() {
+  return affinity_generation.load(std::memory_order_acquire);
+}
+
+void apply_thread_affinity() {
+#if defined(__linux__)
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  {
+    auto& state = affinity_state();
+    std::lock_guard<std::mutex> guard(state.mutex);
+    if (state.cpus.empty()) {
+      // Unrestricted: allow every CPU the machine reports.
+      const auto num_cpus = std::max(1u, std::thread::hardware_concurrency());
+      for (unsigned cpu = 0; cpu < num_cpus && cpu < CPU_SETSIZE; cpu++) {
+        CPU_SET(cpu, &mask);
+      }
+    } else {
+      for (auto cpu : state.cpus) {
+        CPU_SET(cpu, &mask);
+      }
+    }
+  }
+  sched_setaffinity(0, sizeof(cpu_set_t), &mask);
+#endif
+}
+
+bool parallel_tuner_active() {
+  static bool enabled =
+      c10::utils::check_env("TORCH_ADAPTIVE_PARALLEL") == true;
+  return enabled;
+}
+
+ParallelTunerScope::ParallelTunerScope(int64_t numiter, int64_t grain_size)
+    : signature_(0), arm_(-1), start_ns_(0), grain_size_(grain_size) {
+  if (numiter <= 1 || at::in_parallel_region()) {
+    return;
+  }
+  const char* op_name = c10::memory_watermark::currentOpName();
+  if (op_name == nullptr) {
+    op_name = "[unattributed]";
+  }
+  const int size_bucket = log2_bucket(numiter);
+  signature_ = tuner_signature(op_name, grain_size, size_bucket);
+  const int nthreads = at::get_num_threads();
+  const int narms = num_tuner_arms(nthreads);
+  int budget = 1;
+  {
+    auto& state = tuner_state();
+    std::lock_guard<std::mutex> guard(state.mutex);
+    auto it = state.entries.find(signature_);
+    if (it == state.entries.end()) {
+      if (state.entries.size() >= kMaxTunerSignatures) {
+        // Table is full; leave this region on its declared grain size.
+        return;
+      }
+      it = state.entries.emplace(signature_, TunerEntry()).first;
+      std::ostringstream desc;
+      desc << op_name << " (n~2^" << size_bucket << ", grain "
+           << grain_size << ")";
+      it->second.desc = desc.str();
+    }
+    TunerEntry& entry = it->second;
+    entry.calls++;
+    arm_ = choose_tuner_arm(entry, narms);
+    budget = tuner_arm_budget(arm_, nthreads);
+  }
+  grain_size_ = std::max(grain_size, divup(numiter, budget));
+  start_ns_ = tuner_now_ns();
+}
+
+ParallelTunerScope::~ParallelTunerScope() {
+  if (arm_ < 0) {
+    return;
+  }
+  const auto elapsed_ns = (double)(tuner_now_ns() - start_ns_);
+  auto& state = tuner_state();
+  std::lock_guard<std::mutex> guard(state.mutex);
+  auto it = state.entries.find(signature_);
+  if (it == state.entries.end()) {
+    return;
+  }
+  TunerArm& arm = it->second.arms[arm_];
+  if (arm.samples == 0) {
+    arm.avg_ns = elapsed_ns;
+  } else {
+    arm.avg_ns = 0.75 * arm.avg_ns + 0.25 * elapsed_ns;
+  }
+  arm.samples++;
+}
+
+} // namespace internal
+
+std::vector<CoreInfo> cpu_topology() {
+  std::vector<CoreInfo> topology;
+#if !defined(__powerpc__) && !defined(__s390x__)
+  if (!cpuinfo_initialize()) {
+    return topology;
+  }
+  const auto* cores = cpuinfo_get_cores();
+  const auto* l3_caches = cpuinfo_get_l3_caches();
+  const auto* packages = cpuinfo_get_packages();
+  const uint32_t num_processors = cpuinfo_get_processors_count();
+  topology.reserve(num_processors);
+  for (uint32_t i = 0; i < num_processors; i++) {
+    const auto* processor = cpuinfo_get_processor(i);
+    CoreInfo info;
+#if defined(__linux__)
+    info.cpu = processor->linux_id;
+#else
+    info.cpu = static_cast<int32_t>(i);
+#endif
+    info.core = processor->core
+        ? static_cast<int32_t>(processor->core - cores)
+        : -1;
+    info.l3_group = processor->cache.l3
+        ? static_cast<int32_t>(processor->cache.l3 - l3_caches)
+        : -1;
+    info.numa_node = processor->package
+        ? static_cast<int32_t>(processor->package - packages)
+        : -1;
+    topology.push_back(info);
+  }
+#endif
+  return topology;
+}
+
+void set_thread_affinity(const std::vector<int>& cpus) {
+  const auto num_cpus = std::thread::hardware_concurrency();
+  for (auto cpu : cpus) {
+    TORCH_CHECK(
+        cpu >= 0 && (num_cpus == 0 || cpu < static_cast<int>(num_cpus)),
+        "set_thread_affinity: invalid cpu id ",
+        cpu,
+        "; the machine reports ",
+        num_cpus,
+        " logical CPUs");
+  }
+#if !defined(__linux__)
+  TORCH_WARN_ONCE(
+      "set_thread_affinity: thread placement is only supported on Linux; "
+      "the declared core set is recorded but not applied");
+#endif
+  {
+    auto& state = affinity_state();
+    std::lock_guard<std::mutex> guard(state.mutex);
+    state.cpus = cpus;
+    std::sort(state.cpus.begin(), state.cpus.end());
+    state.cpus.erase(
+        std::unique(state.cpus.begin(), state.cpus.end()), state.cpus.end());
+  }
+  affinity_generation.fetch_add(1, std::memory_order_release);
+  // The calling thread takes the new mask immediately; workers pick it up
+  // through lazy_init_num_threads. See Note [Thread affinity].
+  internal::apply_thread_affinity();
+}
+
+std::vector<int> get_thread_affinity() {
+  auto& state = affinity_state();
+  std::lock_guard<std::mutex> guard(state.mutex);
+  return state.cpus;
+}
+
 std::string get_parallel_info() {
   std::ostringstream ss;
 
@@ -65,6 +406,17 @@ std::string get_parallel_info() {
   ss << "std::thread::hardware_concurrency() : "
      << std::thread::hardware_concurrency() << std::endl;
 
+  {
+    const auto affinity = at::get_thread_affinity();
+    if (!affinity.empty()) {
+      ss << "at::get_thread_affinity() : ";
+      for (size_t i = 0; i < affinity.size(); i++) {
+        ss << (i == 0 ? "" : " ") << affinity[i];
+      }
+      ss << std::endl;
+    }
+  }
+
   ss << "Environment variables:" << std::endl;
   ss << "\tOMP_NUM_THREADS : "
      << get_env_var("OMP_NUM_THREADS", "[not set]") << std::endl;
@@ -88,6 +440,37 @@ std::string get_parallel_info() {
   ss << "Experimental: single thread pool" << std::endl;
   #endif
 
+  if (internal::parallel_tuner_active()) {
+    // See Note [Adaptive intra-op tuning]
+    ss << "Adaptive intra-op tuning (TORCH_ADAPTIVE_PARALLEL):" << std::endl;
+    const int nthreads = at::get_num_threads();
+    const int narms = num_tuner_arms(nthreads);
+    auto& state = tuner_state();
+    std::lock_guard<std::mutex> guard(state.mutex);
+    for (const auto& kv : state.entries) {
+      const TunerEntry& entry = kv.second;
+      int best = 0;
+      for (int arm = 1; arm < narms; ++arm) {
+        if (entry.arms[arm].samples > 0 &&
+            (entry.arms[best].samples == 0 ||
+             entry.arms[arm].avg_ns < entry.arms[best].avg_ns)) {
+          best = arm;
+        }
+      }
+      ss << "\t" << entry.desc << " : " << entry.calls << " calls, budget "
+         << tuner_arm_budget(best, nthreads) << ", avg "
+         << entry.arms[best].avg_ns / 1e3 << " us";
+      // Parallel efficiency of the winning arm versus the serial arm.
+      if (best > 0 && entry.arms[0].samples > 0 &&
+          entry.arms[best].avg_ns > 0) {
+        double efficiency = entry.arms[0].avg_ns /
+            (entry.arms[best].avg_ns * tuner_arm_budget(best, nthreads));
+        ss << ", efficiency " << efficiency;
+      }
+      ss << std::endl;
+    }
+  }
+
   return ss.str();
 }
 
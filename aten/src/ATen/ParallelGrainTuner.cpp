@@ -0,0 +1,232 @@
+#include <ATen/ParallelGrainTuner.h>
+
+#include <c10/util/flat_hash_map.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace at {
+namespace internal {
+
+// Note [Adaptive grain size tuning]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// GRAIN_SIZE is one constant for every parallel_for in ATen, but the
+// right chunk size depends on the kernel's arithmetic intensity and the
+// machine: bandwidth-bound loops on wide-SIMD cores want smaller grains
+// (more threads), while cheap loops on small inputs want larger ones.
+// parallel_for_tuned call sites instead consult a runtime table keyed
+// by (site id, log2 work-size bucket). A fresh entry explores a fixed
+// candidate ladder around the call site's default grain, timing a few
+// runs of each candidate and keeping the minimum (the minimum is robust
+// against interference); once every candidate has enough trials the
+// entry settles on the fastest grain and lookups become a single map
+// probe. The grain also bounds how many threads the partitioner uses,
+// so tuning it tunes the effective thread count per bucket.
+//
+// Tuning is off by default. PYTORCH_ADAPTIVE_GRAIN=1 turns it on for
+// the process; PYTORCH_ADAPTIVE_GRAIN_TABLE=<path> additionally loads
+// settled entries from <path> at startup and writes them back at exit,
+// so a service pays the exploration cost once per machine type.
+
+namespace {
+
+// Candidate multipliers applied to the call site's default grain.
+constexpr int kNumCandidates = 5;
+constexpr int64_t kCandidateNum[kNumCandidates] = {1, 1, 1, 2, 4};
+constexpr int64_t kCandidateDen[kNumCandidates] = {4, 2, 1, 1, 1};
+// Timed runs per candidate before an entry settles.
+constexpr int kTrialsPerCandidate = 3;
+
+struct TuningEntry {
+  std::string site;
+  int bucket = 0;
+  int64_t candidates[kNumCandidates] = {};
+  double best_seconds[kNumCandidates] = {};
+  int trials[kNumCandidates] = {};
+  int64_t chosen_grain = 0;
+  bool settled = false;
+
+  void settle() {
+    // Index 2 is the 1x candidate; prefer the call site's default unless
+    // another candidate measured strictly faster.
+    int best = 2;
+    for (int i = 0; i < kNumCandidates; ++i) {
+      if (best_seconds[i] < best_seconds[best]) {
+        best = i;
+      }
+    }
+    chosen_grain = candidates[best];
+    settled = true;
+  }
+};
+
+uint64_t hash_site(const char* site) {
+  // FNV-1a; site ids are short literals, collisions across the handful
+  // of tuned call sites are not a practical concern.
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (; *site != '\0'; ++site) {
+    hash = (hash ^ static_cast<uint8_t>(*site)) * 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+int size_bucket(int64_t work_size) {
+  int bucket = 0;
+  while (work_size > 1) {
+    work_size >>= 1;
+    ++bucket;
+  }
+  return bucket;
+}
+
+uint64_t entry_key(uint64_t site_hash, int bucket) {
+  return site_hash * 64 + static_cast<uint64_t>(bucket);
+}
+
+struct TuningTable {
+  std::mutex mutex;
+  ska::flat_hash_map<uint64_t, TuningEntry> entries;
+  const char* table_path = nullptr;
+
+  void load() {
+    std::ifstream in(table_path);
+    if (!in) {
+      return;
+    }
+    std::string site;
+    int bucket = 0;
+    int64_t grain = 0;
+    while (in >> site >> bucket >> grain) {
+      if (grain <= 0 || bucket < 0 || bucket >= 64) {
+        continue;
+      }
+      auto& entry = entries[entry_key(hash_site(site.c_str()), bucket)];
+      entry.site = site;
+      entry.bucket = bucket;
+      entry.chosen_grain = grain;
+      entry.settled = true;
+    }
+  }
+
+  void save() {
+    std::ofstream out(table_path, std::ios::trunc);
+    if (!out) {
+      return;
+    }
+    std::lock_guard<std::mutex> guard(mutex);
+    for (const auto& kv : entries) {
+      const auto& entry = kv.second;
+      if (entry.settled && !entry.site.empty()) {
+        out << entry.site << ' ' << entry.bucket << ' ' << entry.chosen_grain
+            << '\n';
+      }
+    }
+  }
+};
+
+// Leaked so the atexit save below can run no matter how late.
+TuningTable& tuning_table() {
+  static TuningTable* table = new TuningTable();
+  return *table;
+}
+
+bool init_adaptive_grain() {
+  const char* enabled = std::getenv("PYTORCH_ADAPTIVE_GRAIN");
+  const char* path = std::getenv("PYTORCH_ADAPTIVE_GRAIN_TABLE");
+  if (path != nullptr && *path != '\0') {
+    auto& table = tuning_table();
+    table.table_path = path;
+    table.load();
+    std::atexit([]() { tuning_table().save(); });
+    return true;
+  }
+  return enabled != nullptr && enabled[0] == '1';
+}
+
+} // namespace
+
+bool adaptive_grain_enabled() {
+  static const bool enabled = init_adaptive_grain();
+  return enabled;
+}
+
+GrainDecision pick_grain_size(
+    const char* site,
+    int64_t work_size,
+    int64_t default_grain) {
+  auto& table = tuning_table();
+  std::lock_guard<std::mutex> guard(table.mutex);
+  auto& entry =
+      table.entries[entry_key(hash_site(site), size_bucket(work_size))];
+  if (entry.settled) {
+    return {entry.chosen_grain, false};
+  }
+  if (entry.site.empty()) {
+    entry.site = site;
+    entry.bucket = size_bucket(work_size);
+    for (int i = 0; i < kNumCandidates; ++i) {
+      entry.candidates[i] = std::max<int64_t>(
+          1, default_grain * kCandidateNum[i] / kCandidateDen[i]);
+      entry.best_seconds[i] = std::numeric_limits<double>::infinity();
+      // Small defaults collapse neighboring candidates into the same
+      // grain; mark duplicates as already tried so they are skipped.
+      for (int j = 0; j < i; ++j) {
+        if (entry.candidates[j] == entry.candidates[i]) {
+          entry.trials[i] = kTrialsPerCandidate;
+          break;
+        }
+      }
+    }
+  }
+  // Pick the candidate with the fewest completed trials.
+  int candidate = -1;
+  for (int i = 0; i < kNumCandidates; ++i) {
+    if (entry.trials[i] < kTrialsPerCandidate &&
+        (candidate == -1 || entry.trials[i] < entry.trials[candidate])) {
+      candidate = i;
+    }
+  }
+  if (candidate == -1) {
+    entry.settle();
+    return {entry.chosen_grain, false};
+  }
+  return {entry.candidates[candidate], true};
+}
+
+void record_grain_timing(
+    const char* site,
+    int64_t work_size,
+    int64_t grain,
+    double seconds) {
+  auto& table = tuning_table();
+  std::lock_guard<std::mutex> guard(table.mutex);
+  const auto it =
+      table.entries.find(entry_key(hash_site(site), size_bucket(work_size)));
+  if (it == table.entries.end() || it->second.settled) {
+    return;
+  }
+  auto& entry = it->second;
+  for (int i = 0; i < kNumCandidates; ++i) {
+    if (entry.candidates[i] == grain) {
+      entry.best_seconds[i] = std::min(entry.best_seconds[i], seconds);
+      if (++entry.trials[i] >= kTrialsPerCandidate) {
+        bool done = true;
+        for (int j = 0; j < kNumCandidates; ++j) {
+          done = done && entry.trials[j] >= kTrialsPerCandidate;
+        }
+        if (done) {
+          entry.settle();
+        }
+      }
+      return;
+    }
+  }
+}
+
+} // namespace internal
+} // namespace at
@@ -0,0 +1,69 @@
+#pragma once
+#include <ATen/Parallel.h>
+#include <c10/macros/Macros.h>
+
+#include <chrono>
+#include <cstdint>
+
+namespace at {
+
+namespace internal {
+
+// See Note [Adaptive grain size tuning] in ParallelGrainTuner.cpp.
+struct GrainDecision {
+  int64_t grain;
+  // True while the (site, size-bucket) entry is still exploring
+  // candidate grains; the caller should time the parallel region and
+  // report it through record_grain_timing.
+  bool measure;
+};
+
+// Whether tuning is turned on (PYTORCH_ADAPTIVE_GRAIN=1 or a table file
+// is configured via PYTORCH_ADAPTIVE_GRAIN_TABLE). Read once.
+TORCH_API bool adaptive_grain_enabled();
+
+TORCH_API GrainDecision pick_grain_size(
+    const char* site,
+    int64_t work_size,
+    int64_t default_grain);
+
+TORCH_API void record_grain_timing(
+    const char* site,
+    int64_t work_size,
+    int64_t grain,
+    double seconds);
+
+} // namespace internal
+
+// Drop-in variant of parallel_for for call sites that want a measured
+// grain size instead of the global GRAIN_SIZE constant. site must be a
+// string literal uniquely naming the call site; it keys the tuning
+// table (and its persisted form) together with the log2 bucket of the
+// work size. When tuning is disabled (the default) this is exactly
+// parallel_for with default_grain.
+template <class F>
+inline void parallel_for_tuned(
+    const char* site,
+    const int64_t begin,
+    const int64_t end,
+    const int64_t default_grain,
+    const F& f) {
+  if (!internal::adaptive_grain_enabled()) {
+    parallel_for(begin, end, default_grain, f);
+    return;
+  }
+  const auto decision =
+      internal::pick_grain_size(site, end - begin, default_grain);
+  if (!decision.measure) {
+    parallel_for(begin, end, decision.grain, f);
+    return;
+  }
+  const auto start = std::chrono::steady_clock::now();
+  parallel_for(begin, end, decision.grain, f);
+  const double seconds =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start)
+          .count();
+  internal::record_grain_timing(site, end - begin, decision.grain, seconds);
+}
+
+} // namespace at
@@ -6,12 +6,15 @@
 
 #ifndef C10_MOBILE
 #include <c10/core/thread_pool.h>
+#include <c10/util/Logging.h>
+#include <c10/util/env.h>
 #include <c10/util/irange.h>
 #else
 #include <caffe2/utils/threadpool/pthreadpool-cpp.h>
 #endif // C10_MOBILE
 
 #include <atomic>
+#include <deque>
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -72,28 +75,226 @@ int _num_pool_threads(int nthreads) {
   return nthreads - 1;
 }
 
+// Work-stealing variant of the intra-op pool, enabled with
+// AT_PARALLEL_WORK_STEALING=1.  Each worker owns a deque protected by its
+// own mutex; submitters distribute tasks round-robin (or push to the local
+// deque when called from a pool thread), and idle workers steal half of a
+// victim's deque at a time.  This avoids serializing fine-grained and nested
+// parallel_for regions on a single central queue lock.
+class WorkStealingTaskPool : public TaskThreadPoolBase {
+ public:
+  explicit WorkStealingTaskPool(int pool_size) {
+    TORCH_INTERNAL_ASSERT(pool_size >= 0);
+    deques_.reserve(pool_size);
+    for (const auto i : c10::irange(pool_size)) {
+      (void)i;
+      deques_.emplace_back(std::make_unique<TaskDeque>());
+    }
+    threads_.reserve(pool_size);
+    for (const auto i : c10::irange(pool_size)) {
+      threads_.emplace_back([this, i]() {
+        c10::setThreadName("PTWorkStealing");
+        worker_loop(i);
+      });
+    }
+  }
+
+  ~WorkStealingTaskPool() override {
+    {
+      std::lock_guard<std::mutex> lk(wakeup_mutex_);
+      running_ = false;
+    }
+    wakeup_.notify_all();
+    for (auto& thread : threads_) {
+      thread.join();
+    }
+  }
+
+  void run(std::function<void()> func) override {
+    if (threads_.empty()) {
+      // Degenerate single-thread configuration - run inline.
+      func();
+      return;
+    }
+    // Keep nested submissions local to the submitting worker; thieves will
+    // redistribute them if the worker falls behind.
+    size_t queue_idx = ws_pool_ == this
+        ? ws_worker_id_
+        : next_queue_++ % deques_.size();
+    {
+      std::lock_guard<std::mutex> lk(deques_[queue_idx]->mutex);
+      deques_[queue_idx]->tasks.emplace_back(std::move(func));
+    }
+    unclaimed_++;
+    wakeup_.notify_one();
+  }
+
+  size_t size() const override {
+    return threads_.size();
+  }
+
+  size_t numAvailable() const override {
+    return available_;
+  }
+
+  bool inThreadPool() const override {
+    return ws_pool_ == this;
+  }
+
+ private:
+  struct TaskDeque {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  // Pop the most recently pushed local task (LIFO keeps nested regions hot
+  // in cache); thieves take from the opposite end.
+  bool pop_local(size_t index, std::function<void()>& task) {
+    std::lock_guard<std::mutex> lk(deques_[index]->mutex);
+    if (deques_[index]->tasks.empty()) {
+      return false;
+    }
+    task = std::move(deques_[index]->tasks.back());
+    deques_[index]->tasks.pop_back();
+    return true;
+  }
+
+  // Steal half (rounded up) of a victim's deque into the thief's deque and
+  // claim one of the stolen tasks for immediate execution.
+  bool try_steal(size_t thief, std::function<void()>& task) {
+    for (const auto offset : c10::irange((size_t)1, deques_.size())) {
+      size_t victim = (thief + offset) % deques_.size();
+      std::lock_guard<std::mutex> victim_lk(deques_[victim]->mutex);
+      auto& victim_tasks = deques_[victim]->tasks;
+      if (victim_tasks.empty()) {
+        continue;
+      }
+      size_t num_to_steal = (victim_tasks.size() + 1) / 2;
+      task = std::move(victim_tasks.front());
+      victim_tasks.pop_front();
+      if (num_to_steal > 1) {
+        std::lock_guard<std::mutex> thief_lk(deques_[thief]->mutex);
+        for (const auto i : c10::irange(num_to_steal - 1)) {
+          (void)i;
+          deques_[thief]->tasks.emplace_back(std::move(victim_tasks.front()));
+          victim_tasks.pop_front();
+        }
+      }
+      return true;
+    }
+    return false;
+  }
+
+  void worker_loop(size_t index) {
+    ws_pool_ = this;
+    ws_worker_id_ = index;
+    while (running_) {
+      std::function<void()> task;
+      if (pop_local(index, task) || try_steal(index, task)) {
+        unclaimed_--;
+        try {
+          task();
+        } catch (const std::exception& e) {
+          LOG(ERROR) << "Exception in work-stealing pool task: " << e.what();
+        } catch (...) {
+          LOG(ERROR) << "Exception in work-stealing pool task: unknown";
+        }
+      } else {
+        std::unique_lock<std::mutex> lk(wakeup_mutex_);
+        available_++;
+        wakeup_.wait(lk, [this]() {
+          return unclaimed_.load() > 0 || !running_;
+        });
+        available_--;
+      }
+    }
+  }
+
+  static thread_local WorkStealingTaskPool* ws_pool_;
+  static thread_local size_t ws_worker_id_;
+
+  std::vector<std::unique_ptr<TaskDeque>> deques_;
+  std::vector<std::thread> threads_;
+  std::mutex wakeup_mutex_;
+  std::condition_variable wakeup_;
+  std::atomic_bool running_{true};
+  // Tasks pushed but not yet dequeued for execution (including tasks moved
+  // between deques by stealing).
+  std::atomic<size_t> unclaimed_{0};
+  std::atomic<size_t> available_{0};
+  std::atomic<size_t> next_queue_{0};
+};
+
+thread_local WorkStealingTaskPool* WorkStealingTaskPool::ws_pool_ = nullptr;
+thread_local size_t WorkStealingTaskPool::ws_worker_id_ = 0;
+
+bool _use_work_stealing_pool() {
+  static bool enabled =
+      c10::utils::check_env("AT_PARALLEL_WORK_STEALING") == true;
+  return enabled;
+}
+
 TaskThreadPoolBase& _get_intraop_pool() {
   static std::shared_ptr<TaskThreadPoolBase> pool =
-      ThreadPoolRegistry()->Create(
-          "C10",
-          /* device_id */ 0,
-          /* pool_size */ _num_pool_threads(num_intraop_threads.exchange(CONSUMED)),
-          /* create_new */ true); // create a separate thread pool for intra-op
+      _use_work_stealing_pool()
+      ? std::static_pointer_cast<TaskThreadPoolBase>(
+            std::make_shared<WorkStealingTaskPool>(
+                _num_pool_threads(num_intraop_threads.exchange(CONSUMED))))
+      : ThreadPoolRegistry()->Create(
+            "C10",
+            /* device_id */ 0,
+            /* pool_size */ _num_pool_threads(num_intraop_threads.exchange(CONSUMED)),
+            /* create_new */ true); // create a separate thread pool for intra-op
   return *pool;
 }
 
+// Note [Intra-op core budget]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Concurrent parallel regions - typically launched from different inter-op
+// pool threads - each size themselves to the full intra-op thread count, so
+// eight concurrent regions on a 32-core host ask for 8 * 32 lanes at once
+// and spend the parallelism win on context switches. Instead, every region
+// draws its helper lanes from a single token bucket sized to the intra-op
+// thread count: a region that cannot get its full complement of tokens
+// degrades to fewer, larger chunks rather than oversubscribing, and returns
+// its tokens once the wait completes. The calling thread's own lane is never
+// charged - its core is already accounted for by whoever scheduled it - so
+// progress does not depend on the bucket and an empty bucket simply means
+// the region runs serially.
+
+std::atomic<int>& _lane_token_bucket() {
+  static std::atomic<int> tokens{at::get_num_threads()};
+  return tokens;
+}
+
+// Grab up to `requested` helper-lane tokens without blocking; returns the
+// number granted, possibly zero.
+int _acquire_lane_tokens(int requested) {
+  auto& tokens = _lane_token_bucket();
+  int available = tokens.load(std::memory_order_relaxed);
+  while (available > 0) {
+    int granted = std::min(available, requested);
+    if (tokens.compare_exchange_weak(available, available - granted)) {
+      return granted;
+    }
+  }
+  return 0;
+}
+
+void _release_lane_tokens(int granted) {
+  if (granted > 0) {
+    _lane_token_bucket().fetch_add(granted);
+  }
+}
+
 #endif // C10_MOBILE
 
+#ifdef C10_MOBILE
 // Run lambda function `fn` over `task_id` in [0, `range`) with threadpool.
 // `fn` will be called with params: (thread_pool_task_id, task_id).
+// The non-mobile pool schedules chunks dynamically in invoke_parallel
+// instead of going through this helper.
 void _run_with_pool(const std::function<void(int, size_t)>& fn, size_t range) {
-#ifndef C10_MOBILE
-  for (const auto i : c10::irange(1, range)) {
-    _get_intraop_pool().run([fn, i]() { fn((int)i, i); });
-  }
-  // Run the first task on the current thread directly.
-  fn(0, 0);
-#else
   caffe2::PThreadPool* const pool = caffe2::pthreadpool();
   TORCH_INTERNAL_ASSERT(pool, "Invalid thread pool!");
 
@@ -103,8 +304,8 @@ void _run_with_pool(const std::function<void(int, size_t)>& fn, size_t range) {
     [&fn](const size_t task_id) {
       fn(0 /* unused */, task_id);
     }, range);
-#endif // C10_MOBILE
 }
+#endif // C10_MOBILE
 
 // RAII guard helps to support in_parallel_region() and get_thread_num() API.
 struct ParallelRegionGuard {
@@ -148,6 +349,20 @@ void invoke_parallel(
   std::tie(num_tasks, chunk_size) =
       internal::calc_num_tasks_and_chunk_size(begin, end, grain_size);
 
+#ifndef C10_MOBILE
+  // See Note [Intra-op core budget]: helper lanes beyond the calling
+  // thread's own are granted from the shared token bucket; if concurrent
+  // regions have drained it, degrade to fewer, larger chunks.
+  int granted_lanes = 0;
+  if (num_tasks > 1) {
+    granted_lanes = _acquire_lane_tokens((int)num_tasks - 1);
+    if ((size_t)granted_lanes + 1 < num_tasks) {
+      num_tasks = granted_lanes + 1;
+      chunk_size = divup((end - begin), num_tasks);
+    }
+  }
+#endif // C10_MOBILE
+
   // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init)
   struct {
     std::atomic_flag err_flag = ATOMIC_FLAG_INIT;
@@ -155,10 +370,16 @@ void invoke_parallel(
     std::mutex mutex;
     volatile size_t remaining;
     std::condition_variable cv;
+#ifndef C10_MOBILE
+    // Chunk-claiming state, see below: outstanding claim tickets, the next
+    // chunk for pool workers (front) and for the caller (back).
+    std::atomic<int64_t> tickets{0};
+    std::atomic<size_t> next_front{0};
+    std::atomic<size_t> next_back{0};
+#endif // C10_MOBILE
   } state;
 
-  auto task = [f, &state, begin, end, chunk_size]
-      (int /* unused */, size_t task_id) {
+  auto run_chunk = [&f, &state, begin, end, chunk_size](size_t task_id) {
     int64_t local_start = begin + task_id * chunk_size;
     if (local_start < end) {
       int64_t local_end = std::min(end, (int64_t)(chunk_size + local_start));
@@ -171,6 +392,51 @@ void invoke_parallel(
         }
       }
     }
+  };
+
+#ifndef C10_MOBILE
+  // Chunks beyond the first are claimed dynamically instead of being
+  // preassigned: pool workers claim from the front, while the caller - which
+  // used to sleep after its own chunk - runs the first chunk and then claims
+  // from the back. The caller therefore keeps stealing pending chunks
+  // instead of blocking, and both boundary chunks typically finish on the
+  // consumer's thread, where a chained op is most likely to touch their
+  // output next. The ticket counter caps total claims at the chunk count,
+  // so the front and back ranges can never overlap.
+  state.tickets = (int64_t)num_tasks - 1;
+  state.next_front = 1;
+  state.next_back = num_tasks - 1;
+  state.remaining = (size_t)granted_lanes;
+  for (const auto i : c10::irange((size_t)granted_lanes)) {
+    (void)i;
+    _get_intraop_pool().run([run_chunk, &state]() {
+      // Applies affinity masks published after this worker started.
+      // See Note [Thread affinity] in ParallelCommon.cpp.
+      at::internal::lazy_init_num_threads();
+      while (state.tickets.fetch_sub(1) > 0) {
+        run_chunk(state.next_front.fetch_add(1));
+      }
+      std::unique_lock<std::mutex> lk(state.mutex);
+      if (--state.remaining == 0) {
+        state.cv.notify_one();
+      }
+    });
+  }
+  run_chunk(0);
+  while (state.tickets.fetch_sub(1) > 0) {
+    run_chunk(state.next_back.fetch_sub(1));
+  }
+  // Wait for the pool workers to drain their claimed chunks.
+  {
+    std::unique_lock<std::mutex> lk(state.mutex);
+    while (state.remaining != 0) {
+      state.cv.wait(lk);
+    }
+  }
+  _release_lane_tokens(granted_lanes);
+#else
+  auto task = [&run_chunk, &state](int /* unused */, size_t task_id) {
+    run_chunk(task_id);
     {
       std::unique_lock<std::mutex> lk(state.mutex);
       if (--state.remaining == 0) {
@@ -188,6 +454,7 @@ void invoke_parallel(
       state.cv.wait(lk);
     }
   }
+#endif // C10_MOBILE
   if (state.eptr) {
     std::rethrow_exception(state.eptr);
   }
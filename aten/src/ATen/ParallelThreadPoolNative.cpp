@@ -4,7 +4,12 @@
 #include <ATen/PTThreadPool.h>
 #include <ATen/ThreadLocalState.h>
 
+#include <c10/util/env.h>
+#include <c10/util/numa.h>
+
 #include <atomic>
+#include <mutex>
+#include <vector>
 
 namespace at {
 
@@ -31,6 +36,30 @@ TaskThreadPoolBase& get_pool() {
   return *pool;
 }
 
+std::atomic<bool>& numa_interop_flag() {
+  static std::atomic<bool> flag{
+      c10::utils::check_env("TORCH_NUMA_INTEROP") == true};
+  return flag;
+}
+
+// Worker groups pinned per NUMA node, created lazily; the available
+// inter-op threads are split evenly across the nodes. Only used when
+// NUMA-affine scheduling is enabled, the shared pool from get_pool()
+// stays untouched otherwise.
+TaskThreadPoolBase& get_numa_pool(int numa_node_id) {
+  static std::mutex mutex;
+  static std::vector<std::shared_ptr<TaskThreadPoolBase>> pools(
+      c10::GetNumNUMANodes());
+  std::lock_guard<std::mutex> guard(mutex);
+  auto& pool = pools[numa_node_id];
+  if (!pool) {
+    auto threads_per_node = std::max<size_t>(
+        1, get_num_interop_threads() / pools.size());
+    pool = std::make_shared<PTThreadPool>(threads_per_node, numa_node_id);
+  }
+  return *pool;
+}
+
 // Factory function for ThreadPoolRegistry
 std::shared_ptr<TaskThreadPoolBase> create_c10_threadpool(
     int device_id,
@@ -92,5 +121,33 @@ void launch(std::function<void()> func) {
   ));
 }
 
+void set_numa_interop_enabled(bool enabled) {
+  numa_interop_flag() = enabled;
+}
+
+bool numa_interop_enabled() {
+  return numa_interop_flag();
+}
+
+void launch_with_numa_hint(int numa_node, std::function<void()> func) {
+#if !AT_EXPERIMENTAL_SINGLE_THREAD_POOL
+  if (numa_interop_enabled() && c10::IsNUMAEnabled() && numa_node >= 0 &&
+      numa_node < c10::GetNumNUMANodes()) {
+    // NOLINTNEXTLINE(modernize-avoid-bind)
+    get_numa_pool(numa_node).run(std::bind([](
+      std::function<void()> f, ThreadLocalState thread_locals) {
+        // NOLINTNEXTLINE(performance-move-const-arg)
+        ThreadLocalStateGuard guard(std::move(thread_locals));
+        f();
+      },
+      std::move(func),
+      ThreadLocalState()
+    ));
+    return;
+  }
+#endif
+  launch(std::move(func));
+}
+
 } // namespace at
 #endif
@@ -21,12 +21,16 @@
 #include <ATen/ops/empty_strided.h>
 #endif
 
+#include <c10/core/impl/LeanEagerMode.h>
+#include <c10/util/env.h>
+#include <c10/util/hash.h>
 #include <c10/util/irange.h>
 #include <c10/util/SmallBuffer.h>
 
 #include <array>
 #include <algorithm>
 #include <cmath>
+#include <unordered_map>
 
 namespace at {
 
@@ -64,6 +68,48 @@ static OptionalTensorRef make_otr(const TensorBase &tensor) {
   }
 }
 
+// Memoization of the layout computed by the slow-path setup in build()
+// (compute_strides / reorder_dimensions / coalesce_dimensions), opt-in via
+// TORCH_TENSORITERATOR_PLAN_CACHE=1.  Serving workloads tend to replay a
+// small set of shape/stride/dtype signatures millions of times, and the
+// layout computation is a pure function of those signatures plus a few
+// config bits.  See [Note: iterator plan cache] in build() for the
+// eligibility conditions.
+struct IteratorPlanEntry {
+  DimVector shape;
+  SmallVector<StrideVector, 4> stride_bytes;
+};
+
+using IteratorPlanKey = SmallVector<int64_t, 32>;
+
+struct IteratorPlanKeyHash {
+  size_t operator()(const IteratorPlanKey& key) const {
+    size_t seed = key.size();
+    for (auto v : key) {
+      seed = c10::hash_combine(seed, c10::get_hash(v));
+    }
+    return seed;
+  }
+};
+
+using IteratorPlanCache =
+    std::unordered_map<IteratorPlanKey, IteratorPlanEntry, IteratorPlanKeyHash>;
+
+IteratorPlanCache& iterator_plan_cache() {
+  static thread_local IteratorPlanCache cache;
+  return cache;
+}
+
+// Simple bound on memory use; signature churn past this point means the
+// workload is not cache friendly anyway.
+constexpr size_t kIteratorPlanCacheMaxEntries = 4096;
+
+bool iterator_plan_cache_enabled() {
+  static bool enabled =
+      c10::utils::check_env("TORCH_TENSORITERATOR_PLAN_CACHE") == true;
+  return enabled;
+}
+
 }
 
 namespace internal {
@@ -590,6 +636,11 @@ void TensorIteratorBase::allocate_or_resize_outputs() {
 }
 
 void TensorIteratorBase::compute_names(const TensorIteratorConfig& config) {
+  // Lean eager deployments guarantee no named tensors exist, so skip
+  // probing every operand; see Note [Lean eager mode].
+  if (c10::impl::lean_eager_mode_enabled()) {
+    return;
+  }
   bool should_infer_names = std::any_of(
       operands_.begin(),
       operands_.end(),
@@ -1477,8 +1528,55 @@ void TensorIteratorBase::build(TensorIteratorConfig& config) {
   mark_resize_outputs(config);
   // compute the result dtype and device
   compute_types(config);
-  // try fast setup output tensor, if failed, fallback to normal setup
-  if (!fast_set_up(config)) {
+
+  // [Note: iterator plan cache]
+  // The layout produced by the slow-path setup below (compute_strides,
+  // reorder_dimensions, coalesce_dimensions) is a pure function of each
+  // operand's sizes, strides and dtype plus a few config bits, so when the
+  // cache is enabled we memoize it and skip straight to the result for
+  // recurring signatures.  Restricted to the common inference case: every
+  // operand already materialized (no output allocation or resizing), no
+  // named tensors, not a meta iterator.  set_output is still invoked for
+  // each output on a hit so structured kernels observe the same calls as on
+  // a miss.  Fast-setup layouts are cheap to recompute and are deliberately
+  // not cached.
+  IteratorPlanKey plan_key;
+  bool use_plan_cache = iterator_plan_cache_enabled() && !is_meta_ &&
+      names_.empty() &&
+      std::all_of(
+          operands_.begin(), operands_.end(), [](const OperandInfo& op) {
+            return op.tensor_base().defined() && !op.will_resize;
+          });
+  if (use_plan_cache) {
+    plan_key.push_back(
+        (is_reduction_ ? 1 : 0) | (enforce_linear_iteration_ ? 2 : 0) |
+        (static_cast<int64_t>(num_outputs_) << 2));
+    for (auto& op : operands_) {
+      const auto& tensor = op.tensor_base();
+      plan_key.push_back(static_cast<int64_t>(op.target_dtype));
+      plan_key.push_back(tensor.dim());
+      plan_key.append(tensor.sizes().begin(), tensor.sizes().end());
+      plan_key.append(tensor.strides().begin(), tensor.strides().end());
+    }
+  }
+  auto& plan_cache = iterator_plan_cache();
+  auto plan_it = use_plan_cache ? plan_cache.find(plan_key) : plan_cache.end();
+  if (plan_it != plan_cache.end()) {
+    const auto& plan = plan_it->second;
+    shape_ = plan.shape;
+    for (const auto i : c10::irange(ntensors())) {
+      operands_[i].stride_bytes = plan.stride_bytes[i];
+    }
+    has_coalesced_dimensions_ = true;
+    // Propagate guards and names to outputs exactly as
+    // allocate_or_resize_outputs does for defined, non-resized outputs.
+    for (const auto i : c10::irange(num_outputs_)) {
+      auto& op = operands_[i];
+      set_output_raw_strided(
+          i, op.tensor_base().sizes(), {}, original_options(op), names_);
+    }
+  } else if (!fast_set_up(config)) {
+    // fast setup of the output tensor failed, fallback to normal setup
     // compute each tensor's stride after broadcasting
     compute_strides(config);
     // re-order dimensions to improve coalescing
@@ -1486,7 +1584,20 @@ void TensorIteratorBase::build(TensorIteratorConfig& config) {
     // allocate the output tensor if it's not provided
     allocate_or_resize_outputs();
     // coalesce adjacent dimensions when possible
-    if (!is_meta_) coalesce_dimensions();
+    if (!is_meta_) {
+      coalesce_dimensions();
+      if (use_plan_cache) {
+        if (plan_cache.size() >= kIteratorPlanCacheMaxEntries) {
+          plan_cache.clear();
+        }
+        IteratorPlanEntry entry;
+        entry.shape = shape_;
+        for (auto& op : operands_) {
+          entry.stride_bytes.push_back(op.stride_bytes);
+        }
+        plan_cache.emplace(std::move(plan_key), std::move(entry));
+      }
+    }
   }
 
   if (is_meta_) return;
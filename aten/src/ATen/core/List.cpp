@@ -2,6 +2,59 @@
 
 namespace c10 {
 namespace detail {
+
+namespace {
+
+// ListImpl is final, so every allocation through these operators has the
+// same size and all cached blocks are interchangeable. A block freed on one
+// thread simply lands in that thread's cache; the memory itself carries no
+// thread affinity.
+constexpr size_t kMaxCachedListImpls = 128;
+
+struct ListImplCache {
+  struct Node {
+    Node* next;
+  };
+
+  ~ListImplCache() {
+    while (head != nullptr) {
+      Node* next = head->next;
+      ::operator delete(head);
+      head = next;
+    }
+  }
+
+  Node* head = nullptr;
+  size_t count = 0;
+};
+
+thread_local ListImplCache list_impl_cache_;
+
+} // namespace
+
+void* ListImpl::operator new(std::size_t size) {
+  auto& cache = list_impl_cache_;
+  if (size == sizeof(ListImpl) && cache.head != nullptr) {
+    auto* node = cache.head;
+    cache.head = node->next;
+    --cache.count;
+    return node;
+  }
+  return ::operator new(size);
+}
+
+void ListImpl::operator delete(void* ptr, std::size_t size) {
+  auto& cache = list_impl_cache_;
+  if (size == sizeof(ListImpl) && cache.count < kMaxCachedListImpls) {
+    auto* node = static_cast<ListImplCache::Node*>(ptr);
+    node->next = cache.head;
+    cache.head = node;
+    ++cache.count;
+    return;
+  }
+  ::operator delete(ptr);
+}
+
 bool operator==(const ListImpl& lhs, const ListImpl& rhs) {
   return *lhs.elementType == *rhs.elementType &&
       lhs.list.size() == rhs.list.size() &&
@@ -35,6 +35,14 @@ struct ListImpl final : public c10::intrusive_ptr_target {
   intrusive_ptr<ListImpl> copy() const {
     return make_intrusive<ListImpl>(list, elementType);
   }
+
+  // Every boxed int[]/double[] schema argument (conv strides, padding, ...)
+  // materializes one of these, so eager loops allocate and free short-lived
+  // ListImpls at a very high rate. Serve them from a per-thread cache of
+  // fixed-size blocks instead of the global allocator; see List.cpp.
+  TORCH_API static void* operator new(std::size_t size);
+  TORCH_API static void operator delete(void* ptr, std::size_t size);
+
   friend TORCH_API bool operator==(const ListImpl& lhs, const ListImpl& rhs);
 };
 }
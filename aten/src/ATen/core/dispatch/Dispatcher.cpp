@@ -54,6 +54,20 @@ C10_EXPORT Dispatcher& Dispatcher::realSingleton() {
 }
 
 c10::optional<OperatorHandle> Dispatcher::findOp(const OperatorName& overload_name) {
+#if !defined(C10_MOBILE)
+  // Fast path: look up in an immutable snapshot of the table so that
+  // steady-state lookups perform no shared writes. See
+  // [Note: operator lookup snapshot] in Dispatcher.h.
+  const auto* snapshot = operatorLookupSnapshot_.load(std::memory_order_acquire);
+  if (C10_UNLIKELY(snapshot == nullptr)) {
+    snapshot = refreshLookupSnapshot_();
+  }
+  auto found = snapshot->find(overload_name);
+  if (found == snapshot->end()) {
+    return c10::nullopt;
+  }
+  return found->second;
+#else
   return operatorLookupTable_.read([&] (const ska::flat_hash_map<OperatorName, OperatorHandle>& operatorLookupTable) -> c10::optional<OperatorHandle> {
     auto found = operatorLookupTable.find(overload_name);
     if (found == operatorLookupTable.end()) {
@@ -61,7 +75,40 @@ c10::optional<OperatorHandle> Dispatcher::findOp(const OperatorName& overload_na
     }
     return found->second;
   });
+#endif
+}
+
+#if !defined(C10_MOBILE)
+const ska::flat_hash_map<OperatorName, OperatorHandle>* Dispatcher::refreshLookupSnapshot_() {
+  std::lock_guard<std::mutex> lock(snapshotMutex_);
+  const auto* existing = operatorLookupSnapshot_.load(std::memory_order_acquire);
+  if (existing != nullptr) {
+    // Another thread rebuilt the snapshot while we waited for the lock.
+    return existing;
+  }
+  const uint64_t generation = lookupTableGeneration_.load(std::memory_order_acquire);
+  auto copy = std::make_unique<const ska::flat_hash_map<OperatorName, OperatorHandle>>(
+      operatorLookupTable_.read([] (const ska::flat_hash_map<OperatorName, OperatorHandle>& operatorLookupTable) {
+        return operatorLookupTable;
+      }));
+  const auto* raw = copy.get();
+  lookupSnapshots_.push_back(std::move(copy));
+  operatorLookupSnapshot_.store(raw, std::memory_order_release);
+  if (lookupTableGeneration_.load(std::memory_order_acquire) != generation) {
+    // A mutation raced with the rebuild; un-publish so the next lookup
+    // rebuilds from the current table. Our copy stays valid for this call.
+    operatorLookupSnapshot_.store(nullptr, std::memory_order_release);
+  }
+  return raw;
+}
+
+void Dispatcher::invalidateLookupSnapshot_() {
+  // Bump the generation before clearing the pointer so that an in-flight
+  // rebuild that started from the old table cannot stay published.
+  lookupTableGeneration_.fetch_add(1, std::memory_order_acq_rel);
+  operatorLookupSnapshot_.store(nullptr, std::memory_order_release);
 }
+#endif
 
 c10::optional<OperatorHandle> Dispatcher::findSchema(const OperatorName& overload_name) {
   auto it = findOp(overload_name);
@@ -115,6 +162,9 @@ OperatorHandle Dispatcher::findOrRegisterName_(const OperatorName& op_name) {
   operatorLookupTable_.write([&] (ska::flat_hash_map<OperatorName, OperatorHandle>& operatorLookupTable) {
     operatorLookupTable.emplace(op_name, handle);
   });
+#if !defined(C10_MOBILE)
+  invalidateLookupSnapshot_();
+#endif
 
   return handle;
 }
@@ -266,6 +316,9 @@ void Dispatcher::cleanup(const OperatorHandle& op, const OperatorName& op_name)
     operatorLookupTable_.write([&] (ska::flat_hash_map<OperatorName, OperatorHandle>& operatorLookupTable) {
       operatorLookupTable.erase(op_name);
     });
+#if !defined(C10_MOBILE)
+    invalidateLookupSnapshot_();
+#endif
   }
 }
 
@@ -7,8 +7,10 @@
 #include <ATen/core/dispatch/CppSignature.h>
 #include <ATen/core/dispatch/RegistrationHandleRAII.h>
 #include <ATen/record_function.h>
+#include <c10/core/MemoryWatermark.h>
 #include <c10/util/Exception.h>
 #include <c10/util/LeftRight.h>
+#include <atomic>
 #include <list>
 #include <mutex>
 #include <type_traits>
@@ -283,6 +285,32 @@ private:
   std::list<OperatorDef> operators_;
 #if !defined(C10_MOBILE)
   LeftRight<ska::flat_hash_map<OperatorName, OperatorHandle>> operatorLookupTable_;
+
+  // [Note: operator lookup snapshot]
+  // Read-mostly snapshot of operatorLookupTable_ for the findOp fast path.
+  // LeftRight reads bump shared reader counters, which ping-pongs cache
+  // lines across sockets under many-thread serving; steady-state name
+  // lookups instead read an immutable table through a single acquire load
+  // and perform no shared writes. Mutations bump the generation counter and
+  // clear the published pointer; the next lookup rebuilds the snapshot under
+  // snapshotMutex_ (deliberately NOT mutex_ -- findOrRegisterName_ calls
+  // findOp with mutex_ held). Old snapshots are parked in lookupSnapshots_
+  // until shutdown rather than reclaimed: registration events are rare and
+  // bounded, and this makes a concurrently loaded snapshot always safe to
+  // read without any reader registration protocol.
+  std::atomic<const ska::flat_hash_map<OperatorName, OperatorHandle>*>
+      operatorLookupSnapshot_{nullptr};
+  std::atomic<uint64_t> lookupTableGeneration_{0};
+  std::mutex snapshotMutex_;
+  std::vector<
+      std::unique_ptr<const ska::flat_hash_map<OperatorName, OperatorHandle>>>
+      lookupSnapshots_;
+
+  // Rebuilds the snapshot from operatorLookupTable_ (takes snapshotMutex_).
+  const ska::flat_hash_map<OperatorName, OperatorHandle>*
+  refreshLookupSnapshot_();
+  // Must be called after any mutation of operatorLookupTable_.
+  void invalidateLookupSnapshot_();
 #else
   RWSafeLeftRightWrapper<ska::flat_hash_map<OperatorName, OperatorHandle>> operatorLookupTable_;
 #endif
@@ -439,6 +467,27 @@ private:
 namespace detail {
 template <class... Args> inline void unused_arg_(const Args&...) {}
 
+// [Note: Monomorphic dispatch inline cache]
+// Eager loops call the same operator with the same dispatch key set millions
+// of times, and the fixed cost of computing the dispatch table index on every
+// call dominates small-tensor work. Dispatcher::call keeps a thread-local
+// cache of the last (operator, key set) -> dispatch table slot per template
+// instantiation (operators sharing a signature share an instantiation, which
+// is why the operator is part of the key). Hits skip the table index
+// computation; anything else - a different operator, a different key set, or
+// a slot whose kernel has been deregistered in the meantime - falls back to
+// the full lookup. Caching the table slot rather than the kernel value is
+// what keeps registration changes safe: slots live inside the OperatorEntry
+// (whose address is stable) and are updated in place, so a hit always calls
+// the currently registered kernel, and the isValidUnboxed() check catches
+// slots that have gone missing. All members constant-initialize so the
+// thread_local needs no initialization guard.
+struct DispatchInlineCache {
+  const void* op = nullptr;
+  uint64_t key_bits = 0;
+  const KernelFunction* kernel = nullptr;
+};
+
 // CaptureKernelCall is intended to capture return values from Dispatcher
 // unboxed kernel calls. A record function may request to get outputs from the
 // kernel calls. For boxed kernels, it's straightforward, the returned values
@@ -564,7 +613,26 @@ C10_ALWAYS_INLINE_UNLESS_MOBILE Return Dispatcher::call(const TypedOperatorHandl
       std::cout << "[call] op=[" << op.operator_name() << "], key=[" << toString(dispatchKeySet.highestPriorityTypeId()) << "]" << std::endl;
   }
 #endif
-  const KernelFunction& kernel = op.operatorDef_->op.lookup(dispatchKeySet);
+  // See [Note: Monomorphic dispatch inline cache]
+  static thread_local detail::DispatchInlineCache cache;
+  const KernelFunction* kernel_ptr;
+  if (C10_LIKELY(
+          cache.op == op.operatorDef_ &&
+          cache.key_bits == dispatchKeySet.raw_repr() &&
+          cache.kernel->isValidUnboxed())) {
+    kernel_ptr = cache.kernel;
+  } else {
+    kernel_ptr = &op.operatorDef_->op.lookup(dispatchKeySet);
+    cache.op = op.operatorDef_;
+    cache.key_bits = dispatchKeySet.raw_repr();
+    cache.kernel = kernel_ptr;
+  }
+  const KernelFunction& kernel = *kernel_ptr;
+  // Attribute allocations made while the kernel runs; see
+  // Note [Memory watermark ring buffer] in c10/core/MemoryWatermark.cpp.
+  // The interned operator name outlives the kernel invocation.
+  memory_watermark::ThreadOpNameGuard op_name_guard(
+      op.operatorDef_->op.operator_name().name.c_str());
 #ifndef PYTORCH_DISABLE_PER_OP_PROFILING
   auto step_callbacks = at::getStepCallbacksUnlessEmpty(at::RecordScope::FUNCTION);
   if (C10_UNLIKELY(step_callbacks.has_value() && op.operatorDef_->op.isObserved())) {
@@ -598,6 +666,9 @@ inline void Dispatcher::callBoxed(const OperatorHandle& op, Stack* stack) const
   }
 #endif
   const auto& kernel = entry.lookup(dispatchKeySet);
+  // See the matching guard in Dispatcher::call.
+  memory_watermark::ThreadOpNameGuard op_name_guard(
+      entry.operator_name().name.c_str());
 #ifndef PYTORCH_DISABLE_PER_OP_PROFILING
   auto step_callbacks = at::getStepCallbacksUnlessEmpty(at::RecordScope::FUNCTION);
   if (C10_UNLIKELY(step_callbacks.has_value() && entry.isObserved())) {
@@ -220,6 +220,8 @@ namespace c10 {
   _(cuda, set_stream)                \
   _(cuda, _current_device)           \
   _(cuda, synchronize)               \
+  _(cuda, _side_stream_begin)        \
+  _(cuda, _side_stream_end)          \
   _(aten, has_torch_function)        \
   FORALL_ATEN_BASE_SYMBOLS(_)        \
   _(onnx, Add)                       \
@@ -21,6 +21,7 @@
 #include <c10/core/UndefinedTensorImpl.h>
 #include <c10/core/impl/DeviceGuardImplInterface.h>
 #include <c10/util/FunctionRef.h>
+#include <c10/util/SpinWait.h>
 #include <c10/util/hash.h>
 #include <c10/util/intrusive_ptr.h>
 #include <c10/util/irange.h>
@@ -801,6 +802,10 @@ struct C10_EXPORT ivalue::Future final : c10::intrusive_ptr_target {
    * Wait on the future until it completes.
    */
   void wait() {
+    // Spin briefly before parking: short-lived futures typically complete
+    // within microseconds, faster than the futex round trip of blocking on
+    // the condition variable, and the lock below is then uncontended.
+    c10::spin_wait([this] { return completed_.load(); });
     std::unique_lock<std::mutex> lock(mutex_);
     finished_cv_.wait(lock, [&]() -> bool { return completed_; });
     synchronizeWithCurrentStreams();
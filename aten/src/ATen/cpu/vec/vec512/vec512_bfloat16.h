@@ -800,6 +800,38 @@ inline void convert(const BFloat16* src, BFloat16* dst, int64_t n) {
   }
 }
 
+template <>
+inline void convert(const BFloat16* src, float* dst, int64_t n) {
+  int64_t i;
+#pragma unroll
+  for (i = 0; i <= (n - Vectorized<BFloat16>::size()); i += Vectorized<BFloat16>::size()) {
+    auto vsrc = _mm512_loadu_si512(reinterpret_cast<__m512i*>((void*)(src + i)));
+    __m512 o1, o2;
+    cvtbf16_fp32(vsrc, o1, o2);
+    _mm512_storeu_ps(dst + i, o1);
+    _mm512_storeu_ps(dst + i + Vectorized<float>::size(), o2);
+  }
+#pragma unroll
+  for (; i < n; i++) {
+    dst[i] = src[i];
+  }
+}
+
+template <>
+inline void convert(const float* src, BFloat16* dst, int64_t n) {
+  int64_t i;
+#pragma unroll
+  for (i = 0; i <= (n - Vectorized<BFloat16>::size()); i += Vectorized<BFloat16>::size()) {
+    __m512 a = _mm512_loadu_ps(src + i);
+    __m512 b = _mm512_loadu_ps(src + i + Vectorized<float>::size());
+    _mm512_storeu_si512(reinterpret_cast<__m512i*>((void*)(dst + i)), cvtfp32_bf16(a, b));
+  }
+#pragma unroll
+  for (; i < n; i++) {
+    dst[i] = src[i];
+  }
+}
+
 template <>
 Vectorized<BFloat16> inline fmadd(const Vectorized<BFloat16>& a,
     const Vectorized<BFloat16>& b, const Vectorized<BFloat16>& c) {
@@ -72,6 +72,10 @@ TORCH_CUDA_CPP_API Allocator* getCUDADeviceAllocator();
 TORCH_CUDA_CPP_API cusparseHandle_t getCurrentCUDASparseHandle();
 TORCH_CUDA_CPP_API cublasHandle_t getCurrentCUDABlasHandle();
 
+/* Releases the cached cuBLAS workspaces back to the caching allocator.
+   Called when the allocator frees its cached blocks (empty_cache). */
+TORCH_CUDA_CPP_API void clearCublasWorkspaces();
+
 #ifdef CUDART_VERSION
 TORCH_CUDA_CPP_API cusolverDnHandle_t getCurrentCUDASolverDnHandle();
 #endif
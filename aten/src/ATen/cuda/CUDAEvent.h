@@ -2,6 +2,7 @@
 
 #include <ATen/cuda/ATenCUDAGeneral.h>
 #include <ATen/cuda/CUDAContext.h>
+#include <c10/cuda/CUDAEventPool.h>
 #include <c10/cuda/CUDAStream.h>
 #include <c10/cuda/CUDAGuard.h>
 #include <ATen/cuda/Exceptions.h>
@@ -40,12 +41,21 @@ struct TORCH_CUDA_CPP_API CUDAEvent {
   }
 
   // Note: event destruction done on creating device to avoid creating a
-  // CUDA context on other devices.
+  // CUDA context on other devices. Pooled events are recycled instead of
+  // destroyed, which needs no device switch.
   ~CUDAEvent() {
     try {
       if (is_created_) {
-        CUDAGuard guard(device_index_);
-        cudaEventDestroy(event_);
+        // Only recycle idle events; an in-flight record would make the next
+        // user of the pooled event wait on work it never enqueued.
+        if (from_pool_ && cudaEventQuery(event_) == cudaSuccess) {
+          c10::cuda::CUDAEventPool::instance().release(device_index_, event_);
+        } else {
+          // clears a potential cudaErrorNotReady from the query above
+          cudaGetLastError();
+          CUDAGuard guard(device_index_);
+          cudaEventDestroy(event_);
+        }
       }
     } catch (...) { /* No throw */ }
   }
@@ -157,13 +167,22 @@ private:
   unsigned int flags_ = cudaEventDisableTiming;
   bool is_created_ = false;
   bool was_recorded_ = false;
+  bool from_pool_ = false;
   DeviceIndex device_index_ = -1;
   cudaEvent_t event_{};
 
   void createEvent(DeviceIndex device_index) {
     device_index_ = device_index;
-    CUDAGuard guard(device_index_);
-    AT_CUDA_CHECK(cudaEventCreateWithFlags(&event_, flags_));
+    if (flags_ == cudaEventDisableTiming) {
+      // The common case (stream syncs, collective tracking) recycles events
+      // through the shared per-device pool rather than paying for
+      // cudaEventCreate/cudaEventDestroy on every use.
+      event_ = c10::cuda::CUDAEventPool::instance().acquire(device_index_);
+      from_pool_ = true;
+    } else {
+      CUDAGuard guard(device_index_);
+      AT_CUDA_CHECK(cudaEventCreateWithFlags(&event_, flags_));
+    }
     is_created_ = true;
   }
 
@@ -171,6 +190,7 @@ private:
     std::swap(flags_, other.flags_);
     std::swap(is_created_, other.is_created_);
     std::swap(was_recorded_, other.was_recorded_);
+    std::swap(from_pool_, other.from_pool_);
     std::swap(device_index_, other.device_index_);
     std::swap(event_, other.event_);
   }
@@ -5,8 +5,11 @@
 #include <ATen/cuda/detail/CUDAHooks.h>
 #include <ATen/detail/CUDAHooksInterface.h>
 
+#include <c10/util/irange.h>
+
 #include <cuda_runtime_api.h>
 #include <stdint.h>
+#include <algorithm>
 #include <deque>
 #include <memory>
 #include <mutex>
@@ -112,6 +115,12 @@ struct BlockComparator {
   }
 };
 
+// See Note [Per-thread pinned block cache].
+constexpr size_t kMaxThreadCacheBytes = 1 << 26; // 64 MiB per thread
+// Number of events moved out of the event queue per sweep in
+// process_events().
+constexpr size_t kEventQuerySweepSize = 16;
+
 /**
  * Note [CUDAHostAllocator design]
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -140,6 +149,24 @@ struct BlockComparator {
  * we do not enforce that free(Block* block) => block->event_count == 0. This is
  * for compatibility reasons, and we can explore enforcing these in subsequent
  * versions.
+ *
+ * Note [Per-thread pinned block cache]
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * With many dataloader threads feeding several devices, free_list_mutex_
+ * becomes the hottest lock in this allocator. Each thread therefore keeps
+ * its own small cache of ready-to-reuse blocks, capped at
+ * kMaxThreadCacheBytes, which both allocate and free consult before the
+ * global free list. A thread cache has its own mutex, but it is only ever
+ * contended by the sweeps below, so the owning thread's lock acquisitions
+ * stay uncontended.
+ *
+ * Blocks rebalance between threads in three ways: frees that would push a
+ * cache over its byte cap spill to the global free list, allocations that
+ * miss both their own cache and the global list try to steal a block from
+ * another thread's cache before paying for a fresh cudaHostAlloc, and
+ * empty_cache() sweeps every thread cache back into the global list so
+ * the blocks can actually be released. A cache also spills its contents
+ * when its thread exits.
  */
 class CUDAHostAllocator {
  public:
@@ -150,7 +177,22 @@ class CUDAHostAllocator {
 
     process_events();
 
-    // First, try to allocate from the free list
+    // First, try the calling thread's block cache. See
+    // Note [Per-thread pinned block cache].
+    auto* cache = thread_cache();
+    {
+      std::lock_guard<std::mutex> g(cache->mutex_);
+      auto it = cache->free_list_.lower_bound(BlockSize{size, nullptr});
+      if (it != cache->free_list_.end()) {
+        auto* block = *it;
+        block->allocated_ = true;
+        cache->free_list_.erase(it);
+        cache->bytes_ -= block->size_;
+        return {block->ptr_, reinterpret_cast<void*>(block)};
+      }
+    }
+
+    // Second, try to allocate from the global free list
     {
       std::lock_guard<std::mutex> g(free_list_mutex_);
       auto it = free_list_.lower_bound(BlockSize{size, nullptr});
@@ -161,6 +203,13 @@ class CUDAHostAllocator {
         return {block->ptr_, reinterpret_cast<void*>(block)};
       }
     }
+
+    // Third, try to steal a block parked in another thread's cache;
+    // cudaHostAlloc is far more expensive than this sweep.
+    if (auto* block = steal_from_thread_caches(size)) {
+      return {block->ptr_, reinterpret_cast<void*>(block)};
+    }
+
     // Then, create a new block.
     // Pinned memory pointers allocated by any device can be directly used by
     // any other device, regardless of the current device at the time of
@@ -220,6 +269,18 @@ class CUDAHostAllocator {
     }
 
     if (!events) {
+      // Park the block in the calling thread's cache when it has room;
+      // overflow spills to the global list so memory rebalances across
+      // threads. See Note [Per-thread pinned block cache].
+      auto* cache = thread_cache();
+      {
+        std::lock_guard<std::mutex> g(cache->mutex_);
+        if (cache->bytes_ + block->size_ <= kMaxThreadCacheBytes) {
+          cache->free_list_.insert(block);
+          cache->bytes_ += block->size_;
+          return;
+        }
+      }
       std::lock_guard<std::mutex> g(free_list_mutex_);
       free_list_.insert(block);
     } else {
@@ -264,6 +325,22 @@ class CUDAHostAllocator {
     // Flush any available blocks into the free_list.
     process_events();
 
+    // Sweep every thread cache into the global free list so the blocks
+    // below are visible for freeing. See
+    // Note [Per-thread pinned block cache].
+    {
+      std::lock_guard<std::mutex> g(thread_caches_mutex_);
+      for (auto* cache : thread_caches_) {
+        std::lock_guard<std::mutex> gc(cache->mutex_);
+        std::lock_guard<std::mutex> gf(free_list_mutex_);
+        for (auto* block : cache->free_list_) {
+          free_list_.insert(block);
+        }
+        cache->free_list_.clear();
+        cache->bytes_ = 0;
+      }
+    }
+
     // Release cached events from the event pool.
     event_pool_.empty_cache();
 
@@ -288,64 +365,140 @@ class CUDAHostAllocator {
  private:
   void process_events() {
     while (true) {
-      // Avoid calling cudaEventDestroy while holding a mutex, so move
-      // intermediate events out of the lock into this object.
-      c10::optional<std::pair<EventPool::Event, Block*>> processed;
-
+      // Sweep events in batches so event-heavy workloads pay one queue
+      // mutex round trip per sweep rather than one per event. Avoid
+      // calling cudaEventDestroy while holding a mutex, so events are
+      // moved out of the lock into this batch.
+      std::vector<std::pair<EventPool::Event, Block*>> batch;
       {
         std::lock_guard<std::mutex> g(cuda_events_mutex_);
-        if (!cuda_events_.empty()) {
-          processed = std::move(cuda_events_.back());
+        while (!cuda_events_.empty() && batch.size() < kEventQuerySweepSize) {
+          batch.emplace_back(std::move(cuda_events_.back()));
           cuda_events_.pop_back();
         }
       }
 
-      if (!processed) {
+      if (batch.empty()) {
         return;
       }
 
-      // otherwise, query the event
-      {
-        // now, see if we can handle this element
-        auto& event = processed->first;
+      // Index of the first event that was not ready, if any. Events are
+      // queried oldest first, so once one is pending the rest of the
+      // batch is almost certainly pending too and goes back to the queue
+      // unqueried.
+      // TODO: do we need some debouncing logic to avoid allocating
+      // threads repeatedly spinning on an event?
+      size_t first_pending = batch.size();
+      for (const auto i : c10::irange(batch.size())) {
+        auto& event = batch[i].first;
         cudaError_t err = cudaEventQuery(*event);
         if (err == cudaErrorNotReady) {
           cudaGetLastError();
-          // push the event onto the back of the queue if it's not
-          // ready. TODO: do we need some debouncing logic to avoid allocating
-          // threads repeatedly spinning on an event?
-          {
-            std::lock_guard<std::mutex> g(cuda_events_mutex_);
-            cuda_events_.push_back(std::move(*processed));
-          }
-          return;
+          first_pending = i;
+          break;
         } else if (err != cudaSuccess) {
           C10_CUDA_CHECK(err);
         }
+
+        // Process the event.
+        auto* block = batch[i].second;
+        bool available = false;
+        {
+          std::lock_guard<std::mutex> g(block->mutex_);
+          TORCH_INTERNAL_ASSERT(!block->allocated_)
+          block->event_count_--;
+          if (block->event_count_ == 0) {
+            available = true;
+          }
+        }
+
+        if (available) {
+          std::lock_guard<std::mutex> g(free_list_mutex_);
+          free_list_.insert(block);
+        }
+      }
+
+      if (first_pending < batch.size()) {
+        // Put the pending events back, oldest at the back of the queue so
+        // they are popped first on the next sweep.
+        std::lock_guard<std::mutex> g(cuda_events_mutex_);
+        for (size_t i = batch.size(); i > first_pending; --i) {
+          cuda_events_.push_back(std::move(batch[i - 1]));
+        }
+        return;
       }
+    }
+  }
+
+  // See Note [Per-thread pinned block cache].
+  struct ThreadCache {
+    alignas(64) std::mutex mutex_;
+    std::set<Block*, BlockComparator> free_list_;
+    size_t bytes_{0};
+  };
 
-      // Process the events.
-      TORCH_INTERNAL_ASSERT(processed);
-      auto* block = processed->second;
-      bool available = false;
+  // Registers the calling thread's cache on construction and spills its
+  // contents back to the global free list when the thread exits.
+  struct ThreadCacheHolder {
+    explicit ThreadCacheHolder(CUDAHostAllocator& allocator)
+        : allocator_(allocator), cache_(new ThreadCache()) {
+      std::lock_guard<std::mutex> g(allocator_.thread_caches_mutex_);
+      allocator_.thread_caches_.push_back(cache_);
+    }
+
+    ~ThreadCacheHolder() {
       {
-        std::lock_guard<std::mutex> g(block->mutex_);
-        TORCH_INTERNAL_ASSERT(!block->allocated_)
-        block->event_count_--;
-        if (block->event_count_ == 0) {
-          available = true;
+        std::lock_guard<std::mutex> g(allocator_.thread_caches_mutex_);
+        allocator_.thread_caches_.erase(std::find(
+            allocator_.thread_caches_.begin(),
+            allocator_.thread_caches_.end(),
+            cache_));
+      }
+      {
+        std::lock(cache_->mutex_, allocator_.free_list_mutex_);
+        std::lock_guard<std::mutex> gc(cache_->mutex_, std::adopt_lock);
+        std::lock_guard<std::mutex> gf(
+            allocator_.free_list_mutex_, std::adopt_lock);
+        for (auto* block : cache_->free_list_) {
+          allocator_.free_list_.insert(block);
         }
       }
+      delete cache_;
+    }
 
-      if (available) {
-        std::lock_guard<std::mutex> g(free_list_mutex_);
-        free_list_.insert(block);
+    CUDAHostAllocator& allocator_;
+    ThreadCache* cache_;
+  };
+
+  ThreadCache* thread_cache() {
+    static thread_local ThreadCacheHolder holder(*this);
+    return holder.cache_;
+  }
+
+  Block* steal_from_thread_caches(size_t size) {
+    std::lock_guard<std::mutex> g(thread_caches_mutex_);
+    for (auto* cache : thread_caches_) {
+      std::unique_lock<std::mutex> gc(cache->mutex_, std::try_to_lock);
+      if (!gc.owns_lock()) {
+        continue;
+      }
+      auto it = cache->free_list_.lower_bound(BlockSize{size, nullptr});
+      if (it != cache->free_list_.end()) {
+        auto* block = *it;
+        block->allocated_ = true;
+        cache->free_list_.erase(it);
+        cache->bytes_ -= block->size_;
+        return block;
       }
     }
+    return nullptr;
   }
 
   EventPool event_pool_;
 
+  alignas(64) std::mutex thread_caches_mutex_;
+  std::vector<ThreadCache*> thread_caches_;
+
   alignas(64) std::mutex blocks_mutex_;
   std::unordered_set<Block*> blocks_;
   std::unordered_map<void*, Block*> ptr_to_block_;
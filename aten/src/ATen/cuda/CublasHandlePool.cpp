@@ -1,6 +1,22 @@
 #include <ATen/cuda/CUDAContext.h>
 #include <ATen/cuda/detail/DeviceThreadHandles.h>
 
+#include <c10/cuda/CUDACachingAllocator.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <unordered_map>
+
+// cublasSetWorkspace is only available on CUDA 11+.
+#if !defined(USE_ROCM) && defined(CUDA_VERSION) && CUDA_VERSION >= 11000
+#define AT_CUBLAS_PER_STREAM_WORKSPACES() 1
+#else
+#define AT_CUBLAS_PER_STREAM_WORKSPACES() 0
+#endif
+
 namespace at { namespace cuda {
 namespace {
 
@@ -23,8 +39,134 @@ void destroyCublasHandle(cublasHandle_t handle) {
 
 using CuBlasPoolType = DeviceThreadHandlePool<cublasHandle_t, createCublasHandle, destroyCublasHandle>;
 
+// The state a reserved handle is currently bound to, tracked per thread
+// so that back-to-back GEMMs on the same stream issue with zero
+// cublasSet* calls. Handles are effectively thread-local (a PoolWindow
+// reserves them for the lifetime of its thread), so thread-local
+// tracking is exact; a handle recycled to another thread starts there
+// as uninitialized and is rebound on first use.
+struct CublasHandleState {
+  bool initialized = false;
+  cudaStream_t stream = nullptr;
+#if defined(CUDA_VERSION) && CUDA_VERSION >= 11000
+  cublasMath_t math_mode = CUBLAS_DEFAULT_MATH;
+#endif
+#if defined(USE_ROCM) && ROCM_VERSION >= 30800
+  rocblas_atomics_mode atomics_mode = rocblas_atomics_allowed;
+#endif
+#if AT_CUBLAS_PER_STREAM_WORKSPACES()
+  uint64_t workspace_generation = 0;
+#endif
+};
+
+#if AT_CUBLAS_PER_STREAM_WORKSPACES()
+
+// Without an explicit workspace, cuBLAS allocates one from its own
+// pool whenever a handle is bound to a new stream, which CUPTI shows
+// as alloc/free churn between GEMMs under multi-stream serving.
+// Instead, keep one workspace per (handle, stream) pair alive in the
+// caching allocator and rebind it whenever the stream binding changes.
+
+size_t parseChosenWorkspaceSize() {
+  const char* val = std::getenv("CUBLAS_WORKSPACE_CONFIG");
+  // Default to :4096:2:16:8 (two 4 MiB plus eight 16 KiB pages), the
+  // same shape cuBLAS uses for its internal pool.
+  size_t workspace_size = 4096 * 2 + 16 * 8; // in KiB
+  if (val != nullptr) {
+    // Format: a sequence of :SIZE:COUNT pairs, sizes in KiB.
+    size_t total = 0;
+    bool parsed = false;
+    const char* p = val;
+    while (*p == ':') {
+      char* end = nullptr;
+      const long size = std::strtol(p + 1, &end, 10);
+      if (end == p + 1 || *end != ':') {
+        parsed = false;
+        break;
+      }
+      p = end + 1;
+      const long count = std::strtol(p, &end, 10);
+      if (end == p || size < 0 || count < 0) {
+        parsed = false;
+        break;
+      }
+      p = end;
+      total += static_cast<size_t>(size) * static_cast<size_t>(count);
+      parsed = true;
+    }
+    if (parsed && *p == '\0') {
+      workspace_size = total;
+    } else {
+      TORCH_WARN(
+          "Could not parse CUBLAS_WORKSPACE_CONFIG ('",
+          val,
+          "'), using default workspace size of ",
+          workspace_size,
+          " KiB.");
+    }
+  }
+  return workspace_size * 1024;
+}
+
+size_t getChosenWorkspaceSize() {
+  static size_t size = parseChosenWorkspaceSize();
+  return size;
+}
+
+std::mutex& cublasWorkspaceMutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+// Leaky singleton (see the handle pool below) keyed on the (handle,
+// stream) pair. The DataPtrs come from the caching allocator, so
+// clearing an entry returns its block to the cache instead of hitting
+// cudaFree.
+std::map<std::tuple<void*, void*>, at::DataPtr>&
+cublasHandleStreamToWorkspace() {
+  static auto& instance = *new std::map<std::tuple<void*, void*>, at::DataPtr>;
+  return instance;
+}
+
+// Bumped by clearCublasWorkspaces() so threads whose handles still
+// point at a discarded workspace rebind on their next use.
+std::atomic<uint64_t>& cublasWorkspaceGeneration() {
+  static std::atomic<uint64_t> generation{1};
+  return generation;
+}
+
+void setWorkspaceForHandle(cublasHandle_t handle, cudaStream_t stream) {
+  const auto key = std::make_tuple(
+      static_cast<void*>(handle), static_cast<void*>(stream));
+  const size_t workspace_size = getChosenWorkspaceSize();
+  void* workspace = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(cublasWorkspaceMutex());
+    auto& workspaces = cublasHandleStreamToWorkspace();
+    auto it = workspaces.find(key);
+    if (it == workspaces.end()) {
+      it = workspaces.emplace_hint(
+          it,
+          key,
+          c10::cuda::CUDACachingAllocator::get()->allocate(workspace_size));
+    }
+    workspace = it->second.get();
+  }
+  TORCH_CUDABLAS_CHECK(cublasSetWorkspace(handle, workspace, workspace_size));
+}
+
+#endif // AT_CUBLAS_PER_STREAM_WORKSPACES()
+
 } // namespace
 
+void clearCublasWorkspaces() {
+#if AT_CUBLAS_PER_STREAM_WORKSPACES()
+  std::lock_guard<std::mutex> lock(cublasWorkspaceMutex());
+  ++cublasWorkspaceGeneration();
+  cublasHandleStreamToWorkspace().clear();
+#endif
+}
+
 cublasHandle_t getCurrentCUDABlasHandle() {
   int device;
   AT_CUDA_CHECK(cudaGetDevice(&device));
@@ -45,16 +187,39 @@ cublasHandle_t getCurrentCUDABlasHandle() {
       pool->newPoolWindow());
 
   auto handle = myPoolWindow->reserve(device);
-  auto stream = c10::cuda::getCurrentCUDAStream();
-  TORCH_CUDABLAS_CHECK(cublasSetStream(handle, stream));
+  cudaStream_t stream = c10::cuda::getCurrentCUDAStream();
+
+  thread_local std::unordered_map<cublasHandle_t, CublasHandleState>
+      handle_states;
+  auto& state = handle_states[handle];
+
+  const bool stream_changed = !state.initialized || state.stream != stream;
+  if (stream_changed) {
+    TORCH_CUDABLAS_CHECK(cublasSetStream(handle, stream));
+    state.stream = stream;
+  }
+#if AT_CUBLAS_PER_STREAM_WORKSPACES()
+  // Binding a stream reverts the handle to cuBLAS' internal workspace
+  // pool, so the cached workspace has to be rebound alongside it (and
+  // after clearCublasWorkspaces() discards the old one).
+  const uint64_t generation =
+      cublasWorkspaceGeneration().load(std::memory_order_acquire);
+  if (stream_changed || state.workspace_generation != generation) {
+    setWorkspaceForHandle(handle, stream);
+    state.workspace_generation = generation;
+  }
+#endif
 #if defined(CUDA_VERSION) && CUDA_VERSION >= 11000
   // On CUDA >= 11, and architecture >= Ampere, cuBLAS can use TF32 to speedup
   // FP32 data type calculations based on the value of the allow_tf32 flag.
   // To enable TF32, set the math mode of the handle to CUBLAS_TF32_TENSOR_OP_MATH.
+  cublasMath_t math_mode = CUBLAS_DEFAULT_MATH;
   if (!NoTF32Guard::should_disable_tf32() && at::globalContext().allowTF32CuBLAS()) {
-    TORCH_CUDABLAS_CHECK(cublasSetMathMode(handle, CUBLAS_TF32_TENSOR_OP_MATH));
-  } else {
-    TORCH_CUDABLAS_CHECK(cublasSetMathMode(handle, CUBLAS_DEFAULT_MATH));
+    math_mode = CUBLAS_TF32_TENSOR_OP_MATH;
+  }
+  if (!state.initialized || state.math_mode != math_mode) {
+    TORCH_CUDABLAS_CHECK(cublasSetMathMode(handle, math_mode));
+    state.math_mode = math_mode;
   }
 #endif
 #if defined(USE_ROCM) && ROCM_VERSION >= 30800
@@ -64,8 +229,12 @@ cublasHandle_t getCurrentCUDABlasHandle() {
   } else {
     rocblas_mode = rocblas_atomics_allowed;
   }
-  TORCH_CUDABLAS_CHECK(rocblas_set_atomics_mode(handle, rocblas_mode));
+  if (!state.initialized || state.atomics_mode != rocblas_mode) {
+    TORCH_CUDABLAS_CHECK(rocblas_set_atomics_mode(handle, rocblas_mode));
+    state.atomics_mode = rocblas_mode;
+  }
 #endif
+  state.initialized = true;
   return handle;
 }
 
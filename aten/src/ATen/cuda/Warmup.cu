@@ -0,0 +1,104 @@
+#include <ATen/cuda/Warmup.h>
+
+#include <ATen/Context.h>
+#include <ATen/cuda/CUDABlas.h>
+#include <ATen/cuda/CUDAConfig.h>
+#include <ATen/cuda/CUDAContext.h>
+#include <ATen/cuda/Exceptions.h>
+#include <ATen/cuda/Sleep.h>
+#include <c10/cuda/CUDACachingAllocator.h>
+#include <c10/cuda/CUDAFunctions.h>
+#include <c10/cuda/CUDAGuard.h>
+#include <c10/cuda/CUDAStream.h>
+
+#if AT_CUDNN_ENABLED()
+#include <ATen/cudnn/Handle.h>
+#endif
+
+namespace at {
+namespace cuda {
+
+namespace {
+
+// Runs a minimal GEMM so cuBLAS picks its algorithms and loads its kernel
+// modules now instead of inside the first real matmul.
+void prime_cublas() {
+  auto* allocator = c10::cuda::CUDACachingAllocator::get();
+  constexpr int64_t kDim = 2;
+  constexpr size_t kBytes = kDim * kDim * sizeof(float);
+  auto a = allocator->allocate(kBytes);
+  auto b = allocator->allocate(kBytes);
+  auto c = allocator->allocate(kBytes);
+  auto stream = getCurrentCUDAStream();
+  AT_CUDA_CHECK(cudaMemsetAsync(a.get(), 0, kBytes, stream));
+  AT_CUDA_CHECK(cudaMemsetAsync(b.get(), 0, kBytes, stream));
+  AT_CUDA_CHECK(cudaMemsetAsync(c.get(), 0, kBytes, stream));
+  at::cuda::blas::gemm<float>(
+      'n',
+      'n',
+      kDim,
+      kDim,
+      kDim,
+      1.0f,
+      static_cast<const float*>(a.get()),
+      kDim,
+      static_cast<const float*>(b.get()),
+      kDim,
+      0.0f,
+      static_cast<float*>(c.get()),
+      kDim);
+}
+
+} // namespace
+
+void warmup(DeviceIndex device, bool prime_streams) {
+  if (device == -1) {
+    const auto num_devices = c10::cuda::device_count();
+    for (DeviceIndex i = 0; i < num_devices; ++i) {
+      warmup(i, prime_streams);
+    }
+    return;
+  }
+  at::globalContext().lazyInitCUDA();
+  c10::cuda::CUDAGuard device_guard(device);
+  // Force context creation and cache the device properties.
+  AT_CUDA_CHECK(cudaFree(nullptr));
+  getDeviceProperties(device);
+  // The first allocation maps the caching allocator's initial segment.
+  {
+    auto buffer =
+        c10::cuda::CUDACachingAllocator::get()->allocate(1 << 20);
+    (void)buffer;
+  }
+  // Handle pools initialize lazily per device; reserve one of each now.
+  getCurrentCUDABlasHandle();
+  getCurrentCUDASparseHandle();
+#ifdef CUDART_VERSION
+  getCurrentCUDASolverDnHandle();
+#endif
+#if AT_CUDNN_ENABLED()
+  at::native::getCudnnHandle();
+#endif
+  prime_cublas();
+  if (prime_streams) {
+    // Launch the spin kernel once on the current (default) stream and once
+    // per pooled stream. getStreamFromPool hands out streams round-robin,
+    // so stopping when the first stream comes around again covers the whole
+    // pool; the first launch on each stream both creates it and loads the
+    // kernel's module.
+    sleep(1);
+    for (const bool high_priority : {false, true}) {
+      const auto first = getStreamFromPool(high_priority, device);
+      auto stream = first;
+      do {
+        c10::cuda::CUDAStreamGuard stream_guard(stream);
+        sleep(1);
+        stream = getStreamFromPool(high_priority, device);
+      } while (stream != first);
+    }
+  }
+  c10::cuda::device_synchronize();
+}
+
+} // namespace cuda
+} // namespace at
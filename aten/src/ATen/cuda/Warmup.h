@@ -0,0 +1,19 @@
+#pragma once
+#include <c10/core/Device.h>
+#include <c10/macros/Export.h>
+
+namespace at {
+namespace cuda {
+
+// Eagerly pays the CUDA cold-start costs that are otherwise hidden in the
+// first user request: context creation, the caching allocator's first
+// segment, cuBLAS/cuSparse/cuSolver/cuDNN handle initialization and the
+// kernel module loads of the libraries involved. When prime_streams is set,
+// a tiny kernel is additionally launched on every stream in the pool so the
+// streams themselves are created up front. Warms up every visible device
+// when device is -1 (the default). Synchronizes the device(s) before
+// returning.
+TORCH_CUDA_CU_API void warmup(DeviceIndex device = -1, bool prime_streams = true);
+
+} // namespace cuda
+} // namespace at
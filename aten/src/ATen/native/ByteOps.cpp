@@ -0,0 +1,75 @@
+#include <ATen/ATen.h>
+#include <ATen/native/ByteOps.h>
+
+namespace at {
+namespace native {
+
+DEFINE_DISPATCH(byte_translate_stub);
+DEFINE_DISPATCH(byte_find_stub);
+DEFINE_DISPATCH(byte_run_lengths_stub);
+
+namespace {
+
+Tensor contiguous_byte_input(
+    const Tensor& t,
+    const char* fn_name,
+    const char* arg_name) {
+  TORCH_CHECK(
+      t.scalar_type() == kByte,
+      fn_name,
+      ": expected a Byte tensor for ",
+      arg_name,
+      " but got ",
+      t.scalar_type());
+  return t.contiguous();
+}
+
+} // namespace
+
+// out[i] = table[self[i]], i.e. remap every byte through a 256-entry
+// lookup table (case folding, whitespace normalization, byte-class
+// tagging, ...).
+Tensor byte_translate_cpu(const Tensor& self, const Tensor& table) {
+  auto self_ = contiguous_byte_input(self, "_byte_translate", "self");
+  auto table_ = contiguous_byte_input(table, "_byte_translate", "table");
+  TORCH_CHECK(
+      table_.numel() == 256,
+      "_byte_translate: the translation table must have 256 entries but got ",
+      table_.numel());
+  auto result = at::empty(self_.sizes(), self_.options());
+  if (self_.numel() > 0) {
+    byte_translate_stub(kCPU, result, self_, table_);
+  }
+  return result;
+}
+
+// Returns the (flattened) indices of every element of `self` that
+// equals any byte in `needles`, in ascending order, as an int64
+// tensor. This is the delimiter-scan step of a tokenizer.
+Tensor byte_find_cpu(const Tensor& self, const Tensor& needles) {
+  auto self_ = contiguous_byte_input(self, "_byte_find", "self");
+  auto needles_ = contiguous_byte_input(needles, "_byte_find", "needles");
+  auto result = at::empty({0}, self_.options().dtype(kLong));
+  if (self_.numel() > 0 && needles_.numel() > 0) {
+    byte_find_stub(kCPU, result, self_, needles_);
+  }
+  return result;
+}
+
+// Run-length encodes the flattened input: returns (values, lengths)
+// where values[i] is the byte of the i-th maximal run of equal bytes
+// and lengths[i] its length. Equivalent to
+// unique_consecutive(return_counts=True) restricted to 1-d Byte input,
+// but vectorized.
+std::tuple<Tensor, Tensor> byte_run_lengths_cpu(const Tensor& self) {
+  auto self_ = contiguous_byte_input(self, "_byte_run_lengths", "self");
+  auto values = at::empty({0}, self_.options());
+  auto lengths = at::empty({0}, self_.options().dtype(kLong));
+  if (self_.numel() > 0) {
+    byte_run_lengths_stub(kCPU, values, lengths, self_);
+  }
+  return std::make_tuple(values, lengths);
+}
+
+} // namespace native
+} // namespace at
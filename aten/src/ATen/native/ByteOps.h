@@ -0,0 +1,27 @@
+#pragma once
+
+#include <ATen/native/DispatchStub.h>
+
+namespace at {
+class Tensor;
+
+namespace native {
+
+// Byte (uint8) tensor kernels for text/tokenization preprocessing.
+// See the notes in cpu/ByteOpsKernel.cpp. The inputs handed to the
+// stubs are contiguous Byte tensors; the find/run-length kernels
+// resize their dynamically shaped outputs themselves.
+
+using byte_translate_fn =
+    void (*)(Tensor& result, const Tensor& self, const Tensor& table);
+using byte_find_fn =
+    void (*)(Tensor& result, const Tensor& self, const Tensor& needles);
+using byte_run_lengths_fn =
+    void (*)(Tensor& values, Tensor& lengths, const Tensor& self);
+
+DECLARE_DISPATCH(byte_translate_fn, byte_translate_stub);
+DECLARE_DISPATCH(byte_find_fn, byte_find_stub);
+DECLARE_DISPATCH(byte_run_lengths_fn, byte_run_lengths_stub);
+
+} // namespace native
+} // namespace at
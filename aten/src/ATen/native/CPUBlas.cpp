@@ -88,6 +88,137 @@ bool use_blas_gemm(
       (ldc >= std::max(int64_t{1}, m)));
 }
 
+// Note [Small gemm fast path]
+// For matrices of at most kSmallGemmMaxSize in every dimension, the overhead
+// of a BLAS library call (argument validation, threading decisions, packing)
+// exceeds the arithmetic itself. The micro kernels below compute a kM x kN
+// block of C with the accumulators held in registers: the tile shape is a
+// template parameter so the loops fully unroll, and the drivers pick the
+// widest tile that fits at runtime. K stays a runtime parameter to keep the
+// number of instantiations in check. Only float and double take this path;
+// the other dtypes either have no library backend to skip or are rare at
+// these sizes.
+constexpr int64_t kSmallGemmMaxSize = 64;
+
+bool use_small_gemm(
+    TransposeType transa, TransposeType transb,
+    int64_t m, int64_t n, int64_t k,
+    int64_t lda, int64_t ldb, int64_t ldc) {
+  const bool transa_ = transa != TransposeType::NoTranspose;
+  const bool transb_ = transb != TransposeType::NoTranspose;
+  return (
+      (m >= 1) && (m <= kSmallGemmMaxSize) &&
+      (n >= 1) && (n <= kSmallGemmMaxSize) &&
+      (k >= 1) && (k <= kSmallGemmMaxSize) &&
+      (lda >= std::max(int64_t{1}, (transa_ ? k : m))) &&
+      (ldb >= std::max(int64_t{1}, (transb_ ? n : k))) &&
+      (ldc >= std::max(int64_t{1}, m)));
+}
+
+template <typename scalar_t, bool transa, bool transb, int64_t kM, int64_t kN>
+void small_gemm_tile(
+    int64_t k,
+    scalar_t alpha,
+    const scalar_t* a, int64_t lda,
+    const scalar_t* b, int64_t ldb,
+    scalar_t beta,
+    scalar_t* c, int64_t ldc) {
+  scalar_t acc[kN][kM] = {};
+  for (const auto p : c10::irange(k)) {
+    for (const auto j : c10::irange(kN)) {
+      const scalar_t b_pj = transb ? b[j + p * ldb] : b[p + j * ldb];
+      for (const auto i : c10::irange(kM)) {
+        const scalar_t a_ip = transa ? a[p + i * lda] : a[i + p * lda];
+        acc[j][i] += a_ip * b_pj;
+      }
+    }
+  }
+  for (const auto j : c10::irange(kN)) {
+    for (const auto i : c10::irange(kM)) {
+      scalar_t* cij = c + i + j * ldc;
+      // Match BLAS semantics: C is not read when beta == 0.
+      *cij = beta == scalar_t(0)
+          ? alpha * acc[j][i]
+          : alpha * acc[j][i] + beta * *cij;
+    }
+  }
+}
+
+template <typename scalar_t, bool transa, bool transb, int64_t kN>
+void small_gemm_cols(
+    int64_t m, int64_t k,
+    scalar_t alpha,
+    const scalar_t* a, int64_t lda,
+    const scalar_t* b, int64_t ldb,
+    scalar_t beta,
+    scalar_t* c, int64_t ldc) {
+  int64_t i = 0;
+  for (; i + 8 <= m; i += 8) {
+    small_gemm_tile<scalar_t, transa, transb, 8, kN>(
+        k, alpha, a + (transa ? i * lda : i), lda, b, ldb, beta, c + i, ldc);
+  }
+  for (; i + 4 <= m; i += 4) {
+    small_gemm_tile<scalar_t, transa, transb, 4, kN>(
+        k, alpha, a + (transa ? i * lda : i), lda, b, ldb, beta, c + i, ldc);
+  }
+  for (; i < m; ++i) {
+    small_gemm_tile<scalar_t, transa, transb, 1, kN>(
+        k, alpha, a + (transa ? i * lda : i), lda, b, ldb, beta, c + i, ldc);
+  }
+}
+
+template <typename scalar_t, bool transa, bool transb>
+void small_gemm_impl(
+    int64_t m, int64_t n, int64_t k,
+    scalar_t alpha,
+    const scalar_t* a, int64_t lda,
+    const scalar_t* b, int64_t ldb,
+    scalar_t beta,
+    scalar_t* c, int64_t ldc) {
+  int64_t j = 0;
+  for (; j + 4 <= n; j += 4) {
+    small_gemm_cols<scalar_t, transa, transb, 4>(
+        m, k, alpha, a, lda, b + (transb ? j : j * ldb), ldb,
+        beta, c + j * ldc, ldc);
+  }
+  for (; j < n; ++j) {
+    small_gemm_cols<scalar_t, transa, transb, 1>(
+        m, k, alpha, a, lda, b + (transb ? j : j * ldb), ldb,
+        beta, c + j * ldc, ldc);
+  }
+}
+
+template <typename scalar_t>
+void small_gemm(
+    TransposeType transa, TransposeType transb,
+    int64_t m, int64_t n, int64_t k,
+    scalar_t alpha,
+    const scalar_t* a, int64_t lda,
+    const scalar_t* b, int64_t ldb,
+    scalar_t beta,
+    scalar_t* c, int64_t ldc) {
+  // ConjTranspose is numerically identical to Transpose for real types.
+  const bool transa_ = transa != TransposeType::NoTranspose;
+  const bool transb_ = transb != TransposeType::NoTranspose;
+  if (transa_) {
+    if (transb_) {
+      small_gemm_impl<scalar_t, true, true>(
+          m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+    } else {
+      small_gemm_impl<scalar_t, true, false>(
+          m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+    }
+  } else {
+    if (transb_) {
+      small_gemm_impl<scalar_t, false, true>(
+          m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+    } else {
+      small_gemm_impl<scalar_t, false, false>(
+          m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+    }
+  }
+}
+
 #ifdef USE_FBGEMM
 fbgemm::matrix_op_t to_fbgemm(TransposeType trans) {
   switch (trans) {
@@ -123,6 +254,11 @@ void gemm(
     const double beta,
     double *c, int64_t ldc) {
   internal::normalize_last_dims(transa, transb, m, n, k, &lda, &ldb, &ldc);
+  if (use_small_gemm(transa, transb, m, n, k, lda, ldb, ldc)) {
+    // See Note [Small gemm fast path]
+    small_gemm(transa, transb, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+    return;
+  }
 #if AT_BUILD_WITH_BLAS()
   if (use_blas_gemm(transa, transb, m, n, k, lda, ldb, ldc)) {
     int m_ = m, n_ = n, k_ = k, lda_ = lda, ldb_ = ldb, ldc_ = ldc;
@@ -166,6 +302,11 @@ void gemm(
     const float beta,
     float *c, int64_t ldc) {
   internal::normalize_last_dims(transa, transb, m, n, k, &lda, &ldb, &ldc);
+  if (use_small_gemm(transa, transb, m, n, k, lda, ldb, ldc)) {
+    // See Note [Small gemm fast path]
+    small_gemm(transa, transb, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+    return;
+  }
 #if AT_BUILD_WITH_BLAS()
   if (use_blas_gemm(transa, transb, m, n, k, lda, ldb, ldc)) {
     int m_ = m, n_ = n, k_ = k, lda_ = lda, ldb_ = ldb, ldc_ = ldc;
@@ -102,6 +102,7 @@ struct ConvParams {
   bool is_stride_nonpos() const;
   void view1d_as_2d();
   bool use_cpu_depthwise3x3_winograd(const at::Tensor& input, const at::Tensor& weight) const;
+  bool use_cpu_depthwise2d_direct(const at::Tensor& input, const at::Tensor& weight) const;
   bool needs_64bit_indexing_no_split(const at::Tensor& input, const at::Tensor& weight) const;
   bool use_cudnn(const at::Tensor& input, const at::Tensor& weight) const;
   bool use_cudnn_depthwise(const at::Tensor& input, const at::Tensor& weight) const;
@@ -119,6 +120,7 @@ enum class ConvBackend {
   CudaDepthwise3d,
   Cudnn,
   CudnnTranspose,
+  DepthwiseDirect2d,
   Empty,
   Miopen,
   MiopenDepthwise,
@@ -33,6 +33,7 @@ DEFINE_DISPATCH(cudnn_convolution_backward_stub);
 DEFINE_DISPATCH(cudnn_convolution_transpose_backward_stub);
 DEFINE_DISPATCH(slow_conv_transpose3d_backward_stub);
 DEFINE_DISPATCH(convolution_depthwise3x3_winograd_stub);
+DEFINE_DISPATCH(convolution_depthwise2d_direct_stub);
 DEFINE_DISPATCH(miopen_convolution_backward_stub);
 DEFINE_DISPATCH(miopen_convolution_transpose_backward_stub);
 DEFINE_DISPATCH(miopen_depthwise_convolution_backward_stub);
@@ -155,6 +156,30 @@ auto ConvParams::use_cpu_depthwise3x3_winograd(
 #endif
 }
 
+auto ConvParams::use_cpu_depthwise2d_direct(
+    const at::Tensor& input,
+    const at::Tensor& weight) const -> bool {
+  // Direct single-plane kernels for the 2d depthwise cases the winograd path
+  // does not take (arbitrary kernel size, stride and padding); anything that
+  // would otherwise fall through to im2col. Inference only, contiguous NCHW
+  // float or bfloat16, no dilation.
+  return (input.ndimension() == 4) &&
+         (input.size(1) == groups) &&
+         (groups > 1) &&
+         (weight.ndimension() == 4) &&
+         (weight.size(0) % input.size(1) == 0) &&
+         (weight.size(1) == 1) &&
+         (input.device().is_cpu()) &&
+         (input.scalar_type() == at::kFloat ||
+          input.scalar_type() == at::kBFloat16) &&
+         input.is_contiguous() &&
+         (weight.device().is_cpu()) &&
+         (weight.scalar_type() == input.scalar_type()) &&
+         weight.is_contiguous() &&
+         !is_dilated() &&
+         !transposed;
+}
+
 auto ConvParams::needs_64bit_indexing_no_split(const at::Tensor& input, const at::Tensor& weight) const -> bool {
   constexpr int64_t int_max = std::numeric_limits<int>::max();
   int64_t numel_input = input.numel();
@@ -1130,6 +1155,9 @@ ConvBackend select_conv_backend(
   // 3x3 depthwith convolutions implementation is inference only
   } else if (!need_backward && params.use_cpu_depthwise3x3_winograd(input, weight)) {
     return ConvBackend::Winograd3x3Depthwise;
+  // as is the direct kernel that covers the remaining 2d depthwise shapes
+  } else if (!need_backward && params.use_cpu_depthwise2d_direct(input, weight)) {
+    return ConvBackend::DepthwiseDirect2d;
   } else if (
       !params.transposed && (input.ndimension() == 5) &&
       (input.device().is_cpu()) &&
@@ -1417,6 +1445,10 @@ at::Tensor _convolution(
       output = convolution_depthwise3x3_winograd_stub(
           input.device().type(), input, weight, bias, params.stride, params.padding, params.groups);
       break;
+    case ConvBackend::DepthwiseDirect2d:
+      output = convolution_depthwise2d_direct_stub(
+          input.device().type(), input, weight, bias, params.stride, params.padding, params.groups);
+      break;
     case ConvBackend::Xnnpack2d:
       output = xnnpack::convolution2d(
           input, weight, bias, params.padding, params.stride, params.dilation, params.groups);
@@ -2023,6 +2055,9 @@ std::tuple<Tensor, Tensor, Tensor> convolution_backward(
     case ConvBackend::Winograd3x3Depthwise:
       TORCH_CHECK(false, "Backward is not supported for depthwise 3x3 winograd");
       break;
+    case ConvBackend::DepthwiseDirect2d:
+      TORCH_CHECK(false, "Backward is not supported for direct depthwise");
+      break;
     case ConvBackend::Xnnpack2d:
       TORCH_CHECK(false, "Backward is not supported for xnnpack");
       break;
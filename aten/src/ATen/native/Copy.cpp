@@ -37,64 +37,6 @@ bool copy_transpose_valid(const Tensor& self, const Tensor& src) {
       self.numel() >= MIN_SZ;
 }
 
-// special case copy where tensor is contiguous and src is a transposed matrix
-// This can be generalized to most copies, but it's trickier
-void copy_same_type_transpose_(Tensor& self, const Tensor& src) {
-  // NOLINTNEXTLINE(cppcoreguidelines-init-variables)
-  int64_t BLOCK_SZ;
-  if (self.scalar_type() == kByte) {
-    // NOLINTNEXTLINE(cppcoreguidelines-avoid-magic-numbers)
-    BLOCK_SZ = 120;
-  } else {
-    // NOLINTNEXTLINE(cppcoreguidelines-avoid-magic-numbers)
-    BLOCK_SZ = 60;
-  }
-  Tensor buf = empty({BLOCK_SZ, BLOCK_SZ}, self.options());
-
-  // The code below is implemented with the assumption that sizes are equal
-  TORCH_INTERNAL_ASSERT_DEBUG_ONLY(self.sizes().equals(src.sizes()));
-
-  AT_DISPATCH_ALL_TYPES_AND_COMPLEX_AND4(kHalf, kBool, kBFloat16, kComplexHalf, self.scalar_type(), "copy_", [&] {
-    scalar_t* sp = src.data_ptr<scalar_t>();
-    scalar_t* rp = self.data_ptr<scalar_t>();
-    scalar_t* bp = buf.data_ptr<scalar_t>();
-
-    int64_t NR = src.size(0);
-    int64_t NC = src.size(1);
-    for (int64_t R = 0; R < NR; R += BLOCK_SZ) {
-      for (int64_t C = 0; C < NC; C += BLOCK_SZ) {
-        scalar_t* spo = sp + R + C * NR;
-        scalar_t* rpo = rp + C + R * NC;
-
-        int nr = std::min(NR - R, BLOCK_SZ);
-        int nc = std::min(NC - C, BLOCK_SZ);
-
-        // 1. copy columns from src to buf
-        for (const auto c : c10::irange(nc)) {
-          memcpy(bp + c * BLOCK_SZ, spo + c * NR, nr * sizeof(scalar_t));
-        }
-
-        // 2. transpose buf in place
-        int rc_max = std::max(nr, nc);
-        int rc_min = std::min(nr, nc);
-        for (const auto r : c10::irange(rc_max)) {
-          int end = std::min(r, rc_min);
-          for (const auto c : c10::irange(end)) {
-            scalar_t tmp = bp[r + BLOCK_SZ * c];
-            bp[r + BLOCK_SZ * c] = bp[r * BLOCK_SZ + c];
-            bp[r * BLOCK_SZ + c] = tmp;
-          }
-        }
-
-        // 3. copy rows from buf to dst
-        for (const auto r : c10::irange(nr)) {
-          memcpy(rpo + r * NC, bp + r * BLOCK_SZ, nc * sizeof(scalar_t));
-        }
-      }
-    }
-  });
-}
-
 // Devices directly supported by this copy implementation. Other device types
 // (e.g. XLA) may be supported by overriding copy_ and _copy_from.
 bool is_supported_device(Device device) {
@@ -236,7 +178,7 @@ static Tensor & copy_impl(Tensor & self, const Tensor & src, bool non_blocking)
 
   // TODO: if we need to, we can also enable this path for quantized tensor
   if (device_type == kCPU && copy_transpose_valid(self, src) && !self.is_quantized()) {
-    copy_same_type_transpose_(self, src);
+    transpose_copy_stub(kCPU, self, src);
     return self;
   }
 
@@ -304,6 +246,7 @@ void copy_ignoring_overlaps(const TensorBase &dst, const TensorBase &src) {
 }
 
 DEFINE_DISPATCH(copy_stub);
+DEFINE_DISPATCH(transpose_copy_stub);
 
 } // namespace native
 } // namespace at
@@ -14,6 +14,12 @@ using copy_fn = void (*)(TensorIterator&, bool non_blocking);
 
 DECLARE_DISPATCH(copy_fn, copy_stub);
 
+// Fast path for copying a 2-d transposed (column-major) matrix into a
+// contiguous tensor of the same dtype. See Note [Blocked transpose copy].
+using transpose_copy_fn = void (*)(const TensorBase&, const TensorBase&);
+
+DECLARE_DISPATCH(transpose_copy_fn, transpose_copy_stub);
+
 TORCH_API void copy_ignoring_overlaps(const TensorBase &dst, const TensorBase &src);
 
 } // namespace native
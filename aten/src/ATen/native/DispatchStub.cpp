@@ -1,38 +1,57 @@
 #include <ATen/native/DispatchStub.h>
 
 #include <c10/util/Exception.h>
+#include <c10/util/flat_hash_map.h>
 
 #include <cpuinfo.h>
 #include <cstdlib>
 #include <cstring>
+#include <mutex>
+#include <string>
 
 namespace at { namespace native {
 
-static CPUCapability compute_cpu_capability() {
-  auto envar = std::getenv("ATEN_CPU_CAPABILITY");
-  if (envar) {
+// Maps the capability names accepted by ATEN_CPU_CAPABILITY and
+// ATEN_CPU_CAPABILITY_OVERRIDES to the enum. Returns false for names
+// that are unknown or were not compiled into this build.
+static bool parse_cpu_capability(const char* str, CPUCapability* out) {
 #if defined(HAVE_VSX_CPU_DEFINITION)
-    if (strcmp(envar, "vsx") == 0) {
-      return CPUCapability::VSX;
-    }
+  if (strcmp(str, "vsx") == 0) {
+    *out = CPUCapability::VSX;
+    return true;
+  }
 #elif defined(HAVE_ZVECTOR_CPU_DEFINITION)
-    if (strcmp(envar, "zvector") == 0) {
-      return CPUCapability::ZVECTOR;
-    }
+  if (strcmp(str, "zvector") == 0) {
+    *out = CPUCapability::ZVECTOR;
+    return true;
+  }
 #else
 #ifdef HAVE_AVX512_CPU_DEFINITION
-    if (strcmp(envar, "avx512") == 0) {
-      return CPUCapability::AVX512;
-    }
+  if (strcmp(str, "avx512") == 0) {
+    *out = CPUCapability::AVX512;
+    return true;
+  }
 #endif
 #ifdef HAVE_AVX2_CPU_DEFINITION
-    if (strcmp(envar, "avx2") == 0) {
-      return CPUCapability::AVX2;
-    }
+  if (strcmp(str, "avx2") == 0) {
+    *out = CPUCapability::AVX2;
+    return true;
+  }
 #endif
 #endif
-    if (strcmp(envar, "default") == 0) {
-      return CPUCapability::DEFAULT;
+  if (strcmp(str, "default") == 0) {
+    *out = CPUCapability::DEFAULT;
+    return true;
+  }
+  return false;
+}
+
+static CPUCapability compute_cpu_capability() {
+  auto envar = std::getenv("ATEN_CPU_CAPABILITY");
+  if (envar) {
+    CPUCapability capability;
+    if (parse_cpu_capability(envar, &capability)) {
+      return capability;
     }
     TORCH_WARN("ignoring invalid value for ATEN_CPU_CAPABILITY: ", envar);
   }
@@ -72,6 +91,88 @@ CPUCapability get_cpu_capability() {
   return capability;
 }
 
+namespace {
+
+// Stubs defined via DEFINE_DISPATCH, by name, so a per-stub capability
+// can be set after the fact (set_cpu_capability_override below).
+// Function-local and leaked: registration happens during static
+// initialization of every translation unit with a DEFINE_DISPATCH.
+struct StubRegistry {
+  std::mutex mutex;
+  ska::flat_hash_map<std::string, DispatchStubImpl*> stubs;
+  // Parsed ATEN_CPU_CAPABILITY_OVERRIDES entries not yet matched to a
+  // registered stub.
+  ska::flat_hash_map<std::string, CPUCapability> pending_overrides;
+};
+
+StubRegistry& stub_registry() {
+  static StubRegistry* registry = []() {
+    auto* r = new StubRegistry();
+    // Comma-separated "stub_name=capability" pairs, e.g.
+    // "sum_stub=avx512,abs_stub=avx2".
+    const char* envar = std::getenv("ATEN_CPU_CAPABILITY_OVERRIDES");
+    if (envar) {
+      std::string overrides(envar);
+      size_t pos = 0;
+      while (pos < overrides.size()) {
+        size_t comma = overrides.find(',', pos);
+        if (comma == std::string::npos) {
+          comma = overrides.size();
+        }
+        const std::string item = overrides.substr(pos, comma - pos);
+        pos = comma + 1;
+        const size_t eq = item.find('=');
+        CPUCapability capability;
+        if (eq == std::string::npos || eq == 0 ||
+            !parse_cpu_capability(item.c_str() + eq + 1, &capability)) {
+          TORCH_WARN(
+              "ignoring invalid entry in ATEN_CPU_CAPABILITY_OVERRIDES: ",
+              item);
+          continue;
+        }
+        r->pending_overrides[item.substr(0, eq)] = capability;
+      }
+    }
+    return r;
+  }();
+  return *registry;
+}
+
+} // anonymous namespace
+
+void register_cpu_dispatch_stub(const char* stub_name, DispatchStubImpl* impl) {
+  auto& registry = stub_registry();
+  std::lock_guard<std::mutex> guard(registry.mutex);
+  registry.stubs[stub_name] = impl;
+  const auto it = registry.pending_overrides.find(stub_name);
+  if (it != registry.pending_overrides.end()) {
+    impl->set_cpu_capability_override(it->second);
+    registry.pending_overrides.erase(it);
+  }
+}
+
+bool set_cpu_capability_override(
+    const char* stub_name,
+    CPUCapability capability) {
+  auto& registry = stub_registry();
+  std::lock_guard<std::mutex> guard(registry.mutex);
+  const auto it = registry.stubs.find(stub_name);
+  if (it == registry.stubs.end()) {
+    return false;
+  }
+  it->second->set_cpu_capability_override(capability);
+  return true;
+}
+
+void DispatchStubImpl::set_cpu_capability_override(CPUCapability capability) {
+  cpu_capability_override.store(
+      static_cast<int>(capability) + 1, std::memory_order_relaxed);
+  // Drop the cached pointer so the next call re-chooses. A thread
+  // racing with the store may run one more call on the old choice;
+  // both choices are correct kernels, so that is benign.
+  cpu_dispatch_ptr.store(nullptr, std::memory_order_relaxed);
+}
+
 void* DispatchStubImpl::get_call_ptr(
   DeviceType device_type
   , void *DEFAULT
@@ -142,7 +243,10 @@ void* DispatchStubImpl::choose_cpu_impl(
   , void *ZVECTOR
 #endif
 ) {
-  auto capability = static_cast<int>(get_cpu_capability());
+  auto capability = cpu_capability_override.load(std::memory_order_relaxed) - 1;
+  if (capability < 0) {
+    capability = static_cast<int>(get_cpu_capability());
+  }
   (void)capability;
 #ifdef HAVE_AVX512_CPU_DEFINITION
   if (capability >= static_cast<int>(CPUCapability::AVX512)) {
@@ -34,6 +34,16 @@
 // To call:
 //   stub(kCPU, tensor);
 //
+// The capability is normally chosen once per process (see
+// get_cpu_capability()), but individual stubs can be pinned to a
+// different one, either programmatically or by name:
+//
+//   set_cpu_capability_override("sum_stub", CPUCapability::AVX512);
+//
+// or via ATEN_CPU_CAPABILITY_OVERRIDES="sum_stub=avx512,abs_stub=avx2".
+// This lets kernel families that measurably benefit from AVX-512 opt in
+// without forcing the downclock-prone default on everything else.
+//
 // TODO: CPU instruction set selection should be folded into whatever
 // the main dispatch mechanism is.
 
@@ -60,6 +70,23 @@ enum class CPUCapability {
 
 CPUCapability get_cpu_capability();
 
+struct DispatchStubImpl;
+
+// Pins the named stub (the name passed to DECLARE_DISPATCH) to
+// `capability` for the rest of the process, overriding the global
+// choice for that stub only. Returns false if no stub with that name
+// has been defined. The capability is trusted, like ATEN_CPU_CAPABILITY:
+// forcing an ISA the machine lacks will crash.
+TORCH_API bool set_cpu_capability_override(
+    const char* stub_name,
+    CPUCapability capability);
+
+// Called by DEFINE_DISPATCH; applies any pending override from the
+// ATEN_CPU_CAPABILITY_OVERRIDES environment variable.
+TORCH_API void register_cpu_dispatch_stub(
+    const char* stub_name,
+    DispatchStubImpl* impl);
+
 template <typename FnPtr, typename T>
 struct DispatchStub;
 
@@ -108,16 +135,25 @@ struct TORCH_API DispatchStubImpl {
 #endif
   );
 
+  // Pins this stub to `capability` and drops the cached function
+  // pointer so the next call re-chooses.
+  void set_cpu_capability_override(CPUCapability capability);
+
   // Fixing dispatch error in Windows debug builds.
   // See https://github.com/pytorch/pytorch/issues/22681 for more details.
   #if defined(_MSC_VER) && defined(_DEBUG)
     std::atomic<void*> cpu_dispatch_ptr;
     void* cuda_dispatch_ptr;
     void* hip_dispatch_ptr;
+    std::atomic<int> cpu_capability_override;
   #else
     std::atomic<void*> cpu_dispatch_ptr{nullptr};
     void* cuda_dispatch_ptr = nullptr;
     void* hip_dispatch_ptr = nullptr;
+    // 0 means no override; otherwise the stored value is the forced
+    // capability plus one. The offset keeps zero-initialization (which
+    // the MSVC debug branch above relies on) meaning "no override".
+    std::atomic<int> cpu_capability_override{0};
   #endif
 };
 
@@ -165,6 +201,14 @@ public:
     impl.hip_dispatch_ptr = reinterpret_cast<void*>(fn_ptr);
   }
 
+  void set_cpu_capability(CPUCapability capability) {
+    impl.set_cpu_capability_override(capability);
+  }
+
+  void register_stub_name(const char* name) {
+    register_cpu_dispatch_stub(name, &impl);
+  }
+
   static TORCH_API FnPtr DEFAULT;
 #ifdef HAVE_AVX512_CPU_DEFINITION
   static TORCH_API FnPtr AVX512;
@@ -198,6 +242,13 @@ struct RegisterHIPDispatch {
   }
 };
 
+template <typename DispatchStub>
+struct RegisterDispatchStubName {
+  RegisterDispatchStubName(const char* name, DispatchStub& stub) {
+    stub.register_stub_name(name);
+  }
+};
+
 } // anonymous namespace
 // Compiler will complain if you put things like std::tuple<Tensor, Tensor> in
 // the `fn` argument of DECLARE_DISPATCH. Some possible workarounds, e.g.,
@@ -212,7 +263,9 @@ struct RegisterHIPDispatch {
   };                                       \
   extern TORCH_API struct name name
 
-#define DEFINE_DISPATCH(name) struct name name
+#define DEFINE_DISPATCH(name)  \
+  struct name name;            \
+  static RegisterDispatchStubName<struct name> name ## __name_register(#name, name)
 
 #define REGISTER_ARCH_DISPATCH(name, arch, fn) \
   template <> name::FnPtr TORCH_API DispatchStub<name::FnPtr, struct name>::arch = fn;
@@ -106,44 +106,60 @@ Tensor embedding_dense_backward_cpu(
   const auto gW_stride = grad_weight.strides()[0] * grad_weight.element_size();
   const auto gO_stride = grad.strides()[0] * grad.element_size();
 
+  // Sort the lookup positions by index so each destination row's
+  // contributions form one contiguous segment, then reduce the segments
+  // independently in parallel. Each row is only touched by the task that
+  // owns its segment, so no synchronization is needed, and the work is
+  // proportional to numel rather than to num_weights * numel like the
+  // previous scan-per-thread scheme, which thrashed caches for large
+  // vocabularies. The stable sort keeps a row's contributions in their
+  // original order, so results stay bitwise identical run to run.
+  Tensor sorted_indices, sorted_positions;
+  std::tie(sorted_indices, sorted_positions) = at::sort(
+      indices_contig.reshape({numel}), /*stable=*/true, /*dim=*/0);
+
   AT_DISPATCH_INDEX_TYPES(indices.scalar_type(), "embedding_dense_backward_cpu", [&] () {
-    auto indices_data = indices_contig.data_ptr<index_t>();
-
-    // NOLINTNEXTLINE(modernize-avoid-c-arrays,cppcoreguidelines-avoid-c-arrays)
-    std::unique_ptr<index_t[]> counts;
-    if (scale_grad_by_freq) {
-      counts.reset(new index_t[num_weights]);
-      for (const auto i : c10::irange(numel)) {
-        counts[indices_data[i]] = 0;
-      }
-      for (const auto i : c10::irange(numel)) {
-        counts[indices_data[i]]++;
+    const auto* sorted_data = sorted_indices.data_ptr<index_t>();
+    const auto* positions_data = sorted_positions.data_ptr<int64_t>();
+
+    // One linear pass to find where each row's segment starts.
+    std::vector<int64_t> segment_offsets;
+    for (const auto i : c10::irange(numel)) {
+      if (i == 0 || sorted_data[i] != sorted_data[i - 1]) {
+        segment_offsets.push_back(i);
       }
     }
+    segment_offsets.push_back(numel);
+    const int64_t num_segments =
+        static_cast<int64_t>(segment_offsets.size()) - 1;
 
-    auto parallel_section = [&](index_t start, index_t end) {
+    auto parallel_section = [&](int64_t seg_begin, int64_t seg_end) {
       TensorIterator iter(add_iter);
-      for (const auto i : c10::irange(numel)) {
-        if (indices_data[i] != padding_idx) {
-          index_t k = indices_data[i];
-          if (k >= start && k < end) {
-            double scale = 1.0;
-            if (scale_grad_by_freq) {
-              // NOLINTNEXTLINE(modernize-avoid-c-arrays,cppcoreguidelines-avoid-c-arrays)
-              scale /= counts[k];
-            }
-
-            // grad_weight[k].add_(grad[i], scale);
-            iter.unsafe_replace_operand(0, gW_data + k * gW_stride);
-            iter.unsafe_replace_operand(1, gW_data + k * gW_stride);
-            iter.unsafe_replace_operand(2, gO_data + i * gO_stride);
-            add_stub(kCPU, iter, scale);
-          }
+      for (const auto seg : c10::irange(seg_begin, seg_end)) {
+        const int64_t segment_start = segment_offsets[seg];
+        const int64_t segment_end = segment_offsets[seg + 1];
+        const index_t k = sorted_data[segment_start];
+        if (k == padding_idx) {
+          continue;
+        }
+        double scale = 1.0;
+        if (scale_grad_by_freq) {
+          // The segment length is exactly the frequency of this index.
+          scale /= (segment_end - segment_start);
+        }
+
+        for (const auto j : c10::irange(segment_start, segment_end)) {
+          const int64_t i = positions_data[j];
+          // grad_weight[k].add_(grad[i], scale);
+          iter.unsafe_replace_operand(0, gW_data + k * gW_stride);
+          iter.unsafe_replace_operand(1, gW_data + k * gW_stride);
+          iter.unsafe_replace_operand(2, gO_data + i * gO_stride);
+          add_stub(kCPU, iter, scale);
         }
       }
     };
 
-    at::parallel_for(0, num_weights, 1000, parallel_section);
+    at::parallel_for(0, num_segments, 16, parallel_section);
 
   });
 
@@ -43,6 +43,11 @@ void make_offset2bag_out(
     const c10::optional<Tensor>& per_sample_weights,
     const int64_t padding_idx = -1);
 
+// How many rows ahead the embedding gather kernels software-prefetch,
+// configurable via TORCH_EMBEDDING_BAG_PREFETCH (0 disables prefetching).
+// See [Note: embedding bag prefetch] in EmbeddingBag.cpp.
+TORCH_API int embedding_bag_prefetch_distance();
+
 #ifdef USE_FBGEMM
 
 template<bool has_weight, typename TIndex, typename TData>
@@ -57,7 +62,7 @@ struct _CallbackAndBlockSize {
                 block_size,
                 has_weight,
                 /* normalize_by_lengths */false,
-                /* prefetch */16,
+                /* prefetch */embedding_bag_prefetch_distance(),
                 /* is_weight_positional */false,
                 /* use_offsets */true);
     }
@@ -0,0 +1,227 @@
+#define TORCH_ASSERT_ONLY_METHOD_OPERATORS
+#include <ATen/native/FusedOptimizerOps.h>
+
+#include <ATen/Parallel.h>
+#include <ATen/core/Tensor.h>
+#include <ATen/native/ForeachUtils.h>
+#include <c10/util/irange.h>
+
+namespace at {
+namespace native {
+
+namespace {
+
+// Unlike the `_foreach_*` fast path we require the fused layout up front
+// rather than silently falling back: the whole point of these ops is the
+// single vectorized pass, and optimizer state is contiguous in practice.
+void check_fused_optimizer_tensor(
+    const Tensor& t,
+    const Tensor& param,
+    const char* list_name) {
+  TORCH_CHECK(
+      t.device().is_cpu(),
+      "Fused optimizer kernels: expected all tensors to be on CPU, but ",
+      list_name,
+      " has a tensor on ",
+      t.device());
+  TORCH_CHECK(
+      t.layout() == at::kStrided && t.is_contiguous(),
+      "Fused optimizer kernels: expected all tensors to be contiguous and "
+      "strided, but ",
+      list_name,
+      " has a tensor that is not");
+  TORCH_CHECK(
+      t.scalar_type() == param.scalar_type(),
+      "Fused optimizer kernels: expected all state tensors to match their "
+      "parameter's dtype, but got ",
+      t.scalar_type(),
+      " in ",
+      list_name,
+      " for a ",
+      param.scalar_type(),
+      " parameter");
+  TORCH_CHECK(
+      t.numel() == param.numel(),
+      "Fused optimizer kernels: expected all state tensors to match their "
+      "parameter's number of elements, but got ",
+      t.numel(),
+      " in ",
+      list_name,
+      " for a parameter with ",
+      param.numel());
+}
+
+void fused_adam_impl(
+    at::TensorList params,
+    at::TensorList grads,
+    at::TensorList exp_avgs,
+    at::TensorList exp_avg_sqs,
+    at::TensorList max_exp_avg_sqs,
+    at::TensorList state_steps,
+    const double lr,
+    const double beta1,
+    const double beta2,
+    const double weight_decay,
+    const double eps,
+    const bool amsgrad,
+    const bool maximize,
+    const ADAM_MODE mode) {
+  check_foreach_api_restrictions(params, grads, exp_avgs);
+  check_foreach_api_restrictions(params, exp_avg_sqs, state_steps);
+  if (amsgrad) {
+    check_foreach_api_restrictions(params, max_exp_avg_sqs);
+  }
+  for (const auto i : c10::irange(params.size())) {
+    TORCH_CHECK(
+        at::isFloatingType(params[i].scalar_type()),
+        "Fused Adam only supports floating point parameters, got ",
+        params[i].scalar_type());
+    check_fused_optimizer_tensor(params[i], params[i], "params");
+    check_fused_optimizer_tensor(grads[i], params[i], "grads");
+    check_fused_optimizer_tensor(exp_avgs[i], params[i], "exp_avgs");
+    check_fused_optimizer_tensor(exp_avg_sqs[i], params[i], "exp_avg_sqs");
+    if (amsgrad) {
+      check_fused_optimizer_tensor(
+          max_exp_avg_sqs[i], params[i], "max_exp_avg_sqs");
+    }
+  }
+
+  // Small parameter tensors dominate the target workload, so parallelize
+  // across tensors rather than within them.
+  at::parallel_for(0, params.size(), 1, [&](int64_t begin, int64_t end) {
+    for (const auto i : c10::irange(begin, end)) {
+      fused_adam_stub(
+          kCPU,
+          params[i],
+          grads[i],
+          exp_avgs[i],
+          exp_avg_sqs[i],
+          amsgrad ? max_exp_avg_sqs[i] : Tensor(),
+          state_steps[i].item<double>(),
+          lr,
+          beta1,
+          beta2,
+          weight_decay,
+          eps,
+          amsgrad,
+          maximize,
+          mode);
+    }
+  });
+}
+
+} // namespace
+
+void _fused_adam_kernel_cpu_(
+    at::TensorList params,
+    at::TensorList grads,
+    at::TensorList exp_avgs,
+    at::TensorList exp_avg_sqs,
+    at::TensorList max_exp_avg_sqs,
+    at::TensorList state_steps,
+    const double lr,
+    const double beta1,
+    const double beta2,
+    const double weight_decay,
+    const double eps,
+    const bool amsgrad,
+    const bool maximize) {
+  fused_adam_impl(
+      params,
+      grads,
+      exp_avgs,
+      exp_avg_sqs,
+      max_exp_avg_sqs,
+      state_steps,
+      lr,
+      beta1,
+      beta2,
+      weight_decay,
+      eps,
+      amsgrad,
+      maximize,
+      ADAM_MODE::ORIGINAL);
+}
+
+void _fused_adamw_kernel_cpu_(
+    at::TensorList params,
+    at::TensorList grads,
+    at::TensorList exp_avgs,
+    at::TensorList exp_avg_sqs,
+    at::TensorList max_exp_avg_sqs,
+    at::TensorList state_steps,
+    const double lr,
+    const double beta1,
+    const double beta2,
+    const double weight_decay,
+    const double eps,
+    const bool amsgrad,
+    const bool maximize) {
+  fused_adam_impl(
+      params,
+      grads,
+      exp_avgs,
+      exp_avg_sqs,
+      max_exp_avg_sqs,
+      state_steps,
+      lr,
+      beta1,
+      beta2,
+      weight_decay,
+      eps,
+      amsgrad,
+      maximize,
+      ADAM_MODE::ADAMW);
+}
+
+void _fused_sgd_kernel_cpu_(
+    at::TensorList params,
+    at::TensorList grads,
+    at::TensorList momentum_buffer_list,
+    const double weight_decay,
+    const double momentum,
+    const double lr,
+    const double dampening,
+    const bool nesterov,
+    const bool maximize,
+    const bool is_first_step) {
+  check_foreach_api_restrictions(params, grads);
+  if (momentum != 0) {
+    check_foreach_api_restrictions(params, momentum_buffer_list);
+  }
+  for (const auto i : c10::irange(params.size())) {
+    TORCH_CHECK(
+        at::isFloatingType(params[i].scalar_type()),
+        "Fused SGD only supports floating point parameters, got ",
+        params[i].scalar_type());
+    check_fused_optimizer_tensor(params[i], params[i], "params");
+    check_fused_optimizer_tensor(grads[i], params[i], "grads");
+    if (momentum != 0) {
+      check_fused_optimizer_tensor(
+          momentum_buffer_list[i], params[i], "momentum_buffer_list");
+    }
+  }
+
+  at::parallel_for(0, params.size(), 1, [&](int64_t begin, int64_t end) {
+    for (const auto i : c10::irange(begin, end)) {
+      fused_sgd_stub(
+          kCPU,
+          params[i],
+          grads[i],
+          momentum != 0 ? momentum_buffer_list[i] : Tensor(),
+          weight_decay,
+          momentum,
+          lr,
+          dampening,
+          nesterov,
+          maximize,
+          is_first_step);
+    }
+  });
+}
+
+DEFINE_DISPATCH(fused_adam_stub);
+DEFINE_DISPATCH(fused_sgd_stub);
+
+} // namespace native
+} // namespace at
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <ATen/core/Tensor.h>
+#include <ATen/native/DispatchStub.h>
+
+namespace at {
+namespace native {
+
+enum class ADAM_MODE : uint8_t { ORIGINAL = 0, ADAMW = 1 };
+
+// Single-tensor fused Adam/AdamW step. `max_exp_avg_sq` is undefined unless
+// `amsgrad` is set. All tensors must be contiguous, on CPU, and share a
+// floating point dtype; the wrappers in FusedOptimizerOps.cpp enforce this.
+using fused_adam_fn = void (*)(
+    const Tensor& param,
+    const Tensor& grad,
+    const Tensor& exp_avg,
+    const Tensor& exp_avg_sq,
+    const Tensor& max_exp_avg_sq,
+    double step,
+    double lr,
+    double beta1,
+    double beta2,
+    double weight_decay,
+    double eps,
+    bool amsgrad,
+    bool maximize,
+    ADAM_MODE mode);
+DECLARE_DISPATCH(fused_adam_fn, fused_adam_stub);
+
+// Single-tensor fused SGD step. `momentum_buf` is undefined when momentum is
+// zero; `is_first_step` initializes the buffer from the gradient.
+using fused_sgd_fn = void (*)(
+    const Tensor& param,
+    const Tensor& grad,
+    const Tensor& momentum_buf,
+    double weight_decay,
+    double momentum,
+    double lr,
+    double dampening,
+    bool nesterov,
+    bool maximize,
+    bool is_first_step);
+DECLARE_DISPATCH(fused_sgd_fn, fused_sgd_stub);
+
+} // namespace native
+} // namespace at
@@ -1,4 +1,5 @@
 #include <ATen/ATen.h>
+#include <ATen/core/grad_mode.h>
 #include <ATen/native/Resize.h>
 #include <ATen/NativeFunctions.h>
 #include <ATen/native/xnnpack/Engine.h>
@@ -75,6 +76,18 @@ Tensor& linear_out(const Tensor& input, const Tensor& weight, const c10::optiona
   return output;
 }
 
+Tensor _linear_gelu(const Tensor& input, const Tensor& weight, const c10::optional<Tensor>& bias_opt, c10::string_view approximate) {
+  auto output = at::linear(input, weight, bias_opt);
+  // Applying the activation in place spares materializing a second
+  // activation-sized buffer between the GEMM and the gelu. The in-place
+  // variant would clobber the input gelu_backward needs, so only take it
+  // when no gradient will flow through this op.
+  if (GradMode::is_enabled() && output.requires_grad()) {
+    return at::gelu(output, approximate);
+  }
+  return at::gelu_(output, approximate);
+}
+
 // sumproduct_pair computes `(left*right).sum(sumdims)` by means of permutation and
 // batch matrix multiplication
 // its main purpose is to provide a pairwise reduction for einsum
@@ -13,6 +13,7 @@
 #include <ATen/native/ReduceOpsUtils.h>
 #include <ATen/native/Resize.h>
 #include <ATen/native/TensorIterator.h>
+#include <ATen/native/cpu/int_mm_kernel.h>
 #include <ATen/NativeFunctions.h>
 #include <ATen/Parallel.h>
 #include <ATen/TensorUtils.h>
@@ -1428,6 +1429,96 @@ TORCH_IMPL_FUNC(mm_out_cpu)(const Tensor & self, const Tensor & mat2, const Tens
   }
 }
 
+DEFINE_DISPATCH(weight_to_int4pack_stub);
+DEFINE_DISPATCH(int4pack_mm_stub);
+DEFINE_DISPATCH(int8pack_mm_stub);
+
+// Weight-only quantized matmuls: activations stay in floating point while
+// the weight matrix is stored as int8 (per-channel scales) or packed int4
+// (group-wise scale and zero point) and dequantized in-register inside the
+// kernel. Decode-time inference of large language models is bound on the
+// bytes of weight streamed per token, so this halves (int8) or quarters
+// (int4) that traffic versus fp16 weights while keeping fp32/bf16 compute.
+
+Tensor _convert_weight_to_int4pack_cpu(const Tensor& in) {
+  TORCH_CHECK(in.dim() == 2,
+      "_convert_weight_to_int4pack: expected weight to be 2D, got ", in.dim(), "D");
+  TORCH_CHECK(in.dtype() == at::kInt,
+      "_convert_weight_to_int4pack: expected weight to be kInt, got ", in.dtype());
+
+  auto weight = in.contiguous();
+  const int64_t N = weight.size(0);
+  const int64_t K = weight.size(1);
+  TORCH_CHECK(K % 2 == 0,
+      "_convert_weight_to_int4pack: expected K to be even, got ", K);
+
+  auto weight_packed = at::empty({N, K / 2}, weight.options().dtype(at::kByte));
+  weight_to_int4pack_stub(kCPU, weight_packed, weight);
+  return weight_packed;
+}
+
+Tensor _weight_int4pack_mm_cpu(
+    const Tensor& self,
+    const Tensor& mat2,
+    int64_t qGroupSize,
+    const Tensor& qScaleAndZeros) {
+  constexpr char name[] = "_weight_int4pack_mm";
+  TORCH_CHECK(self.dim() == 2, name, ": expected self to be 2D, got ", self.dim(), "D");
+  TORCH_CHECK(self.is_contiguous(), name, ": expected self to be contiguous");
+  TORCH_CHECK(self.dtype() == at::kFloat || self.dtype() == at::kBFloat16 ||
+      self.dtype() == at::kHalf,
+      name, ": expected self to be kFloat, kBFloat16 or kHalf, got ", self.dtype());
+  TORCH_CHECK(mat2.dim() == 2, name, ": expected mat2 to be 2D, got ", mat2.dim(), "D");
+  TORCH_CHECK(mat2.dtype() == at::kByte,
+      name, ": expected mat2 to be kByte (int4-packed), got ", mat2.dtype());
+
+  const int64_t M = self.size(0);
+  const int64_t K = self.size(1);
+  const int64_t N = mat2.size(0);
+  TORCH_CHECK(mat2.size(1) == K / 2,
+      name, ": expected mat2 to have ", K / 2, " packed columns, got ", mat2.size(1));
+  TORCH_CHECK(qGroupSize == 32 || qGroupSize == 64 || qGroupSize == 128 ||
+      qGroupSize == 256,
+      name, ": expected qGroupSize to be 32, 64, 128 or 256, got ", qGroupSize);
+  TORCH_CHECK(K % qGroupSize == 0,
+      name, ": expected K to be a multiple of qGroupSize, got ", K);
+  TORCH_CHECK(qScaleAndZeros.dtype() == at::kFloat &&
+      qScaleAndZeros.sizes() == IntArrayRef({K / qGroupSize, N, 2}),
+      name, ": expected qScaleAndZeros to be kFloat of shape [", K / qGroupSize,
+      ", ", N, ", 2]");
+
+  auto C = at::empty({M, N}, self.options());
+  int4pack_mm_stub(
+      kCPU, C, self, mat2.contiguous(), qGroupSize, qScaleAndZeros.contiguous());
+  return C;
+}
+
+Tensor _weight_int8pack_mm_cpu(
+    const Tensor& self,
+    const Tensor& mat2,
+    const Tensor& scales) {
+  constexpr char name[] = "_weight_int8pack_mm";
+  TORCH_CHECK(self.dim() == 2, name, ": expected self to be 2D, got ", self.dim(), "D");
+  TORCH_CHECK(self.is_contiguous(), name, ": expected self to be contiguous");
+  TORCH_CHECK(self.dtype() == at::kFloat || self.dtype() == at::kBFloat16 ||
+      self.dtype() == at::kHalf,
+      name, ": expected self to be kFloat, kBFloat16 or kHalf, got ", self.dtype());
+  TORCH_CHECK(mat2.dim() == 2, name, ": expected mat2 to be 2D, got ", mat2.dim(), "D");
+  TORCH_CHECK(mat2.dtype() == at::kChar,
+      name, ": expected mat2 to be kChar, got ", mat2.dtype());
+  TORCH_CHECK(mat2.size(1) == self.size(1),
+      name, ": self and mat2 shapes cannot be multiplied (", self.size(0), "x",
+      self.size(1), " and ", mat2.size(0), "x", mat2.size(1), ")");
+  TORCH_CHECK(scales.dim() == 1 && scales.size(0) == mat2.size(0),
+      name, ": expected scales to be 1D of size ", mat2.size(0));
+  TORCH_CHECK(scales.dtype() == self.dtype(),
+      name, ": expected scales to have the same dtype as self, got ", scales.dtype());
+
+  auto C = at::empty({self.size(0), mat2.size(0)}, self.options());
+  int8pack_mm_stub(kCPU, C, self, mat2.contiguous(), scales.contiguous());
+  return C;
+}
+
 template <typename scalar_t, bool is_bmm>
 inline void baddbmm_cpu_kernel(const Tensor& result, const Tensor& self, const Tensor& mat2, const Scalar& beta_, const Scalar& alpha_) {
   int64_t bs = result.size(0);
@@ -1512,9 +1603,82 @@ void baddbmm_with_gemm_(const Tensor &result, const Tensor &mat1, const Tensor &
   });
 }
 
+// Attention-shaped batches (many small matrices, e.g. 512 heads of
+// 64x64x64) sit in a gap between the paths below: each matrix is too big
+// for the naive kernel but small enough that per-call BLAS threading
+// overhead dominates the actual GEMM. For those, threads each take a
+// contiguous span of batch indices and run their matrices with
+// single-threaded GEMM calls (BLAS libraries do not spawn nested threads
+// inside a parallel region). The upper work bound keeps each matrix in
+// the regime where one core runs the GEMM at full speed; the batch bound
+// asks for enough items to hand every thread several.
+static bool use_batch_parallel_gemm(int64_t bs, int64_t m, int64_t n, int64_t k) {
+  constexpr int64_t kMaxPerMatrixWork = 128 * 128 * 128;
+  const int64_t per_matrix_work = m * n * k;
+  return bs >= 2 * at::get_num_threads() && per_matrix_work >= 400 &&
+      per_matrix_work <= kMaxPerMatrixWork;
+}
+
+static void baddbmm_batch_parallel_(const Tensor &result, const Tensor &mat1, const Tensor &mat2, const Scalar &beta_, const Scalar &alpha_) {
+  // Same Fortran-order setup as baddbmm_with_gemm_ above, but the batch
+  // dimension is split across threads instead of handed to one batched
+  // BLAS call.
+  TORCH_INTERNAL_ASSERT(result.is_contiguous());
+
+  const auto result_sizes = result.sizes();
+  const auto result_strides = result.strides();
+  const auto mat1_strides = mat1.strides();
+  const auto mat2_strides = mat2.strides();
+  const auto mat2_sizes = mat2.sizes();
+
+  auto is_transposed = [](const c10::IntArrayRef& strides, const c10::IntArrayRef& sizes) {
+    return strides[1] == 1 && strides[2] >= sizes[1];
+  };
+
+  // gemm expects fortran order matrices, so we swap argument order to transpose everything
+  const auto transpose_a = is_transposed(mat2_strides, mat2_sizes);
+  const auto transpose_b = is_transposed(mat1_strides, mat1.sizes());
+
+  const int64_t batch_size = mat1.sizes()[0];
+  const int64_t m = result_sizes[2];
+  const int64_t n = result_sizes[1];
+  const int64_t k = mat2_sizes[1];
+
+  const int64_t lda = mat2_strides[transpose_a ? 2 : 1];
+  const int64_t ldb = mat1_strides[transpose_b ? 2 : 1];
+  const int64_t ldc = result_strides[1];
+
+  AT_DISPATCH_FLOATING_AND_COMPLEX_TYPES(result.scalar_type(), "baddbmm_batch_parallel", [&] {
+    using opmath_t = at::opmath_type<scalar_t>;
+    const auto alpha = alpha_.to<opmath_t>();
+    const auto beta = beta_.to<opmath_t>();
+    const scalar_t* a = mat2.data_ptr<scalar_t>();
+    const scalar_t* b = mat1.data_ptr<scalar_t>();
+    scalar_t* c = result.data_ptr<scalar_t>();
+    const int64_t a_batch_stride = mat2_strides[0];
+    const int64_t b_batch_stride = mat1_strides[0];
+    const int64_t c_batch_stride = result_strides[0];
+    at::parallel_for(0, batch_size, 1, [&](int64_t begin, int64_t end) {
+      for (const auto batch : c10::irange(begin, end)) {
+        at::native::cpublas::gemm(
+            transpose_a ? TransposeType::Transpose : TransposeType::NoTranspose,
+            transpose_b ? TransposeType::Transpose : TransposeType::NoTranspose,
+            m, n, k, alpha,
+            a + batch * a_batch_stride, lda,
+            b + batch * b_batch_stride, ldb,
+            beta,
+            c + batch * c_batch_stride, ldc);
+      }
+    });
+  });
+}
+
 // This tries to apply some optimizations to bmm/baddbmm:
 // - When the operand size is small, computation are parallelized over the batch
 //   dimension using OMP and naive matrix multiplication is applied.
+// - For large batches of small-but-not-tiny matrices (attention heads),
+//   threads each run a contiguous span of batch indices with
+//   single-threaded GEMMs (see use_batch_parallel_gemm above).
 // - When the operand size is larger than the threshold, if compiled with MKL, MKL's batch gemm is used.
 // - Otherwise, we use a series of matrix multiplications.
 // The threshold of 400 for the first has not been thoroughly benchmarked yet and may have room for further
@@ -1569,6 +1733,15 @@ static inline void bmm_out_or_baddbmm_(const Tensor& self_or_result_, const Tens
           baddbmm_cpu_kernel<scalar_t, false>(self_or_result, batch1, batch2, beta, alpha);
         });
     }
+  } else if (((
+            self_or_result.scalar_type() != kBFloat16 &&
+            at::native::is_floating_point(self_or_result)) ||
+            at::native::is_complex(self_or_result))
+            && batch_items_contiguous_or_transposed(batch1)
+            && batch_items_contiguous_or_transposed(batch2)
+            && self_or_result.is_contiguous()
+            && use_batch_parallel_gemm(bs, res_cols, res_rows, contraction_size)) {
+    baddbmm_batch_parallel_(self_or_result, batch1, batch2, beta, alpha);
   } else if (at::hasMKL() && ((
             self_or_result.scalar_type() != kBFloat16 &&
             at::native::is_floating_point(self_or_result)) ||
@@ -0,0 +1,128 @@
+#include <ATen/ATen.h>
+#include <ATen/native/MaskPacking.h>
+
+namespace at {
+namespace native {
+
+DEFINE_DISPATCH(pack_bool_bits_stub);
+DEFINE_DISPATCH(unpack_bool_bits_stub);
+DEFINE_DISPATCH(packed_bool_not_stub);
+DEFINE_DISPATCH(packed_bool_any_stub);
+DEFINE_DISPATCH(packed_bool_all_stub);
+DEFINE_DISPATCH(packed_masked_select_stub);
+
+namespace {
+
+constexpr int64_t packed_bytes(int64_t numel) {
+  return (numel + 7) / 8;
+}
+
+Tensor contiguous_packed_input(
+    const Tensor& t,
+    int64_t numel,
+    const char* fn_name) {
+  TORCH_CHECK(
+      t.scalar_type() == kByte,
+      fn_name,
+      ": expected a Byte tensor for the packed mask but got ",
+      t.scalar_type());
+  TORCH_CHECK(numel >= 0, fn_name, ": numel must be non-negative");
+  TORCH_CHECK(
+      t.numel() == packed_bytes(numel),
+      fn_name,
+      ": a packed mask of ",
+      numel,
+      " elements holds ",
+      packed_bytes(numel),
+      " bytes, but got ",
+      t.numel());
+  return t.contiguous();
+}
+
+} // namespace
+
+// Packs a boolean tensor into a flat uint8 bitmap of ceil(numel / 8)
+// bytes, bit i of byte j holding element 8 * j + i of the flattened
+// input and the padding bits of the last byte zero. Elementwise
+// and/or/xor of two packed masks are plain bitwise_and/or/xor on the
+// bitmaps (the padding stays zero); negation and reductions need the
+// element count and go through the _packed_bool_* ops below.
+Tensor _pack_bool_bits(const Tensor& self) {
+  TORCH_CHECK(
+      self.scalar_type() == kBool,
+      "_pack_bool_bits: expected a Bool tensor but got ",
+      self.scalar_type());
+  auto self_ = self.contiguous();
+  auto result =
+      at::empty({packed_bytes(self_.numel())}, self_.options().dtype(kByte));
+  if (self_.numel() > 0) {
+    pack_bool_bits_stub(kCPU, result, self_);
+  }
+  return result;
+}
+
+// Inverse of _pack_bool_bits: expands a packed mask back into a flat
+// boolean tensor of `numel` elements.
+Tensor _unpack_bool_bits(const Tensor& self, int64_t numel) {
+  auto self_ = contiguous_packed_input(self, numel, "_unpack_bool_bits");
+  auto result = at::empty({numel}, self_.options().dtype(kBool));
+  if (numel > 0) {
+    unpack_bool_bits_stub(kCPU, result, self_, numel);
+  }
+  return result;
+}
+
+// Logical NOT of a packed mask. A plain bitwise_not would also flip
+// the padding bits of the last byte, so this clears them again to keep
+// the packed-mask invariant.
+Tensor _packed_bool_not(const Tensor& self, int64_t numel) {
+  auto self_ = contiguous_packed_input(self, numel, "_packed_bool_not");
+  auto result = at::empty_like(self_);
+  if (numel > 0) {
+    packed_bool_not_stub(kCPU, result, self_, numel);
+  }
+  return result;
+}
+
+// any() over a packed mask, without unpacking: true iff any bit is set.
+Tensor _packed_bool_any(const Tensor& self, int64_t numel) {
+  auto self_ = contiguous_packed_input(self, numel, "_packed_bool_any");
+  const bool any = numel > 0 && packed_bool_any_stub(kCPU, self_, numel);
+  return at::scalar_tensor(any, self_.options().dtype(kBool));
+}
+
+// all() over a packed mask; like Tensor::all, an empty mask is true.
+Tensor _packed_bool_all(const Tensor& self, int64_t numel) {
+  auto self_ = contiguous_packed_input(self, numel, "_packed_bool_all");
+  const bool all = numel == 0 || packed_bool_all_stub(kCPU, self_, numel);
+  return at::scalar_tensor(all, self_.options().dtype(kBool));
+}
+
+// masked_select with a packed mask: returns the elements of `self`
+// whose mask bit is set, in order, without materializing the unpacked
+// mask. `self` is flattened, matching masked_select with a same-shaped
+// mask.
+Tensor _packed_masked_select(
+    const Tensor& self,
+    const Tensor& mask,
+    int64_t numel) {
+  auto mask_ = contiguous_packed_input(mask, numel, "_packed_masked_select");
+  TORCH_CHECK(
+      self.numel() == numel,
+      "_packed_masked_select: the mask covers ",
+      numel,
+      " elements but self has ",
+      self.numel());
+  TORCH_CHECK(
+      self.layout() == kStrided,
+      "_packed_masked_select: expected a strided tensor");
+  auto self_ = self.contiguous();
+  auto result = at::empty({0}, self_.options());
+  if (numel > 0) {
+    packed_masked_select_stub(kCPU, result, self_, mask_);
+  }
+  return result;
+}
+
+} // namespace native
+} // namespace at
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <ATen/native/DispatchStub.h>
+
+#include <cstdint>
+
+namespace at {
+class Tensor;
+
+namespace native {
+
+// Bitpacked boolean mask kernels; see the notes in
+// cpu/MaskPackingKernel.cpp. A packed mask is a flat uint8 tensor of
+// ceil(numel / 8) bytes, bit i of byte j holding element 8 * j + i
+// (LSB-first), with the padding bits of the last byte always zero. The
+// inputs handed to the stubs are contiguous and already shape-checked.
+
+using pack_bool_bits_fn = void (*)(Tensor& result, const Tensor& self);
+using unpack_bool_bits_fn =
+    void (*)(Tensor& result, const Tensor& self, int64_t numel);
+using packed_bool_not_fn =
+    void (*)(Tensor& result, const Tensor& self, int64_t numel);
+using packed_bool_any_all_fn = bool (*)(const Tensor& self, int64_t numel);
+using packed_masked_select_fn =
+    void (*)(Tensor& result, const Tensor& self, const Tensor& mask);
+
+DECLARE_DISPATCH(pack_bool_bits_fn, pack_bool_bits_stub);
+DECLARE_DISPATCH(unpack_bool_bits_fn, unpack_bool_bits_stub);
+DECLARE_DISPATCH(packed_bool_not_fn, packed_bool_not_stub);
+DECLARE_DISPATCH(packed_bool_any_all_fn, packed_bool_any_stub);
+DECLARE_DISPATCH(packed_bool_any_all_fn, packed_bool_all_stub);
+DECLARE_DISPATCH(packed_masked_select_fn, packed_masked_select_stub);
+
+} // namespace native
+} // namespace at
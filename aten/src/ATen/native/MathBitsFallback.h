@@ -14,6 +14,19 @@ namespace native {
 // Currently there are two tensor bits that trigger this fallback: conjugate bit and negative bit.
 // Conjugate bit is set on a tensor when `.conj()` is called and neg bit is set on a tensor when `.conj().imag` is called.
 
+// Note [Math bits cost nothing when unused]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// These boxed fallbacks are expensive, but a workload that never sets a math
+// bit never reaches them and pays no per-dispatch key test for their
+// existence either. Conjugate/Negative live in each tensor's DispatchKeySet,
+// so dispatch only sees them through the OR of the argument keysets it
+// computes anyway, followed by the same single AND against the operator's
+// fallthrough mask that every call performs (see
+// DispatchKeyExtractor::getDispatchKeySetUnboxed). There is no conj/neg
+// specific branch on the hot path, and therefore nothing for a global
+// "feature unused" counter to short-circuit. If dispatch shows up in a
+// profile, the cost is in the generic keyset plumbing, not here.
+
 // NOTE: To use this fallback, `clone` and `copy_` should fully understand and be able to correctly handle the semantic of your math bit.
 struct MathOpFallback {
   MathOpFallback(DispatchKey key_, string op_name_) : key(key_), op_name(op_name_) {}
@@ -36,6 +36,7 @@ TORCH_META_FUNC(renorm)(const Tensor& self, const Scalar& p, int64_t dim, const
 namespace native {
 
 DEFINE_DISPATCH(batch_norm_cpu_stub);
+DEFINE_DISPATCH(batch_norm_cpu_relu_stub);
 DEFINE_DISPATCH(batch_norm_cpu_collect_stats_stub);
 DEFINE_DISPATCH(batch_norm_cpu_backward_stub);
 DEFINE_DISPATCH(renorm_scale_factor_stub);
@@ -689,6 +690,56 @@ std::tuple<Tensor, Tensor, Tensor> batch_norm_cpu(const Tensor& self, const c10:
   });
 }
 
+std::tuple<Tensor, Tensor, Tensor> batch_norm_relu_cpu(const Tensor& self, const c10::optional<Tensor>& weight_opt, const c10::optional<Tensor>& bias_opt, const c10::optional<Tensor>& running_mean_opt, const c10::optional<Tensor>& running_var_opt,
+                                                       bool train, double momentum, double eps) {
+  // See [Note: hacky wrapper removal for optional tensor]
+  c10::MaybeOwned<Tensor> weight_maybe_owned = at::borrow_from_optional_tensor(weight_opt);
+  const Tensor& weight = *weight_maybe_owned;
+  const Tensor& bias = c10::value_or_else(bias_opt, [] {return Tensor();});
+  const Tensor& running_mean = c10::value_or_else(running_mean_opt, [] {return Tensor();});
+  const Tensor& running_var = c10::value_or_else(running_var_opt, [] {return Tensor();});
+
+  checkBackend("batch_norm_relu_cpu", {self, weight, bias, running_mean, running_var}, Backend::CPU);
+
+  // The fused kernel only covers channels last inputs with contiguous
+  // parameters; everything else runs batch_norm followed by an in-place relu.
+  const bool fuse = self.is_contiguous(at::MemoryFormat::ChannelsLast)
+      && (!weight.defined() || weight.is_contiguous())
+      && (!bias.defined() || bias.is_contiguous())
+      && (!running_mean.defined() || running_mean.is_contiguous())
+      && (!running_var.defined() || running_var.is_contiguous());
+  if (!fuse) {
+    auto result = batch_norm_cpu(self, weight_opt, bias_opt, running_mean_opt, running_var_opt, train, momentum, eps);
+    std::get<0>(result).relu_();
+    return result;
+  }
+
+  const bool mixed_type = is_mixed_type(self, weight, bias, running_mean, running_var);
+  return AT_DISPATCH_FLOATING_TYPES_AND(ScalarType::BFloat16, self.scalar_type(), "batch_norm_relu", [&] {
+    Tensor save_mean, save_invstd;
+    if (mixed_type) {
+      check_mixed_data_type(self, weight, bias, running_mean, running_var);
+      if (train) {
+        std::tie(save_mean, save_invstd) = batch_norm_cpu_update_stats_template<BFloat16, float, InvStd>(self, running_mean, running_var, momentum, eps);
+      } else {
+        save_mean = at::empty({0}, self.options().dtype(kFloat));
+        save_invstd = at::empty({0}, self.options().dtype(kFloat));
+      }
+    } else {
+      if (train) {
+        std::tie(save_mean, save_invstd) = batch_norm_cpu_update_stats_template<scalar_t, scalar_t, InvStd>(self, running_mean, running_var, momentum, eps);
+      } else {
+        save_mean = at::empty({0}, self.options());
+        save_invstd = at::empty({0}, self.options());
+      }
+    }
+    Tensor output = at::empty_like(self, suggest_memory_format_contig(self));
+    batch_norm_cpu_relu_stub(kCPU, output, self, weight, bias,
+        save_mean, save_invstd, running_mean, running_var, train, eps);
+    return std::make_tuple(output, save_mean, save_invstd);
+  });
+}
+
 std::tuple<Tensor, Tensor, Tensor> batch_norm_backward_cpu(const Tensor& grad_out, const Tensor& self, const c10::optional<Tensor>& weight_opt, const c10::optional<Tensor>& running_mean_opt, const c10::optional<Tensor>& running_var_opt, const c10::optional<Tensor>& save_mean_opt, const c10::optional<Tensor>& save_invstd_opt,
                                                            bool train, double eps, std::array<bool,3> grad_input_mask) {
   // See [Note: hacky wrapper removal for optional tensor]
@@ -185,6 +185,107 @@ std::tuple<Tensor, Tensor> _pad_packed_sequence(const Tensor& data, const Tensor
   return std::make_tuple(output, lengths_t);
 }
 
+// Packs a batch stored in the concatenated varlen layout -- sequences laid
+// out back to back in a `[sum(lengths), *features]` tensor -- directly into
+// the `(data, batch_sizes)` layout consumed by the packed RNN entry points
+// in RNN.cpp. Unlike padding followed by _pack_padded_sequence, this is a
+// single gather that never materializes the padded intermediate, which
+// matters for batches with large length skew. `lengths` follows the same
+// decreasing-order contract as _pack_padded_sequence.
+std::tuple<Tensor, Tensor> _pack_sequence_concat(const Tensor& data, const Tensor& _lengths) {
+  auto lengths_t = _lengths.contiguous();
+  checkLongTensor(lengths_t);
+
+  int64_t batch_size = lengths_t.size(0);
+  TORCH_CHECK(batch_size > 0, "Cannot pack an empty batch of sequences.");
+  int64_t* lengths = lengths_t.data_ptr<int64_t>();
+  TORCH_CHECK(lengths[batch_size - 1] > 0,
+           "Length of all samples has to be greater than 0, but found an element "
+           "in 'lengths' that is <= 0");
+
+  int64_t total_length = 0;
+  for (const auto i : c10::irange(batch_size)) {
+    TORCH_CHECK(i == 0 || lengths[i] <= lengths[i - 1],
+             "`lengths` array must be sorted in decreasing order");
+    total_length += lengths[i];
+  }
+  TORCH_CHECK(data.dim() >= 1 && data.size(0) == total_length,
+           "Expected `data` to hold sum(lengths)=", total_length,
+           " steps along dimension 0, but got ", data.size(0));
+
+  // Offset of each sequence within the concatenated data.
+  std::vector<int64_t> offsets(batch_size);
+  int64_t offset = 0;
+  for (const auto i : c10::irange(batch_size)) {
+    offsets[i] = offset;
+    offset += lengths[i];
+  }
+
+  at::Tensor batch_sizes_t = at::empty(lengths[0], _lengths.options());
+  int64_t* batch_sizes = batch_sizes_t.data_ptr<int64_t>();
+  at::Tensor index_t = at::empty(total_length, _lengths.options());
+  int64_t* index = index_t.data_ptr<int64_t>();
+  for (const auto t : c10::irange(lengths[0])) {
+    int64_t current_batch_size = 0;
+    while (current_batch_size < batch_size && lengths[current_batch_size] > t) {
+      *index++ = offsets[current_batch_size] + t;
+      ++current_batch_size;
+    }
+    batch_sizes[t] = current_batch_size;
+  }
+
+  return std::make_tuple(
+      data.index_select(0, index_t.to(data.device())), batch_sizes_t);
+}
+
+// Inverse of _pack_sequence_concat: scatters the time-major packed `data`
+// back into the concatenated varlen layout, again as a single gather.
+// Returns `(data, lengths)`.
+std::tuple<Tensor, Tensor> _unpack_sequence_concat(const Tensor& data, const Tensor& _batch_sizes) {
+  auto batch_sizes_t = _batch_sizes.contiguous();
+  checkLongTensor(batch_sizes_t);
+
+  int64_t max_seq_length = batch_sizes_t.size(0);
+  TORCH_CHECK(max_seq_length > 0, "Cannot unpack an empty batch of sequences.");
+  int64_t* batch_sizes = batch_sizes_t.data_ptr<int64_t>();
+  int64_t max_batch_size = batch_sizes[0];
+
+  // Offset of each time step within the packed data, plus the total size.
+  std::vector<int64_t> row_offsets(max_seq_length);
+  int64_t total_length = 0;
+  for (const auto t : c10::irange(max_seq_length)) {
+    row_offsets[t] = total_length;
+    total_length += batch_sizes[t];
+  }
+  TORCH_CHECK(data.dim() >= 1 && data.size(0) == total_length,
+           "Expected `data` to hold sum(batch_sizes)=", total_length,
+           " steps along dimension 0, but got ", data.size(0));
+
+  at::Tensor lengths_t = at::empty(max_batch_size, batch_sizes_t.options());
+  int64_t* lengths = lengths_t.data_ptr<int64_t>();
+  int64_t prev_batch_size = max_batch_size;
+  for (int64_t t = 0; t <= max_seq_length; ++t) {
+    int64_t current_batch_size = t != max_seq_length ? batch_sizes[t] : 0;
+    TORCH_CHECK(current_batch_size <= prev_batch_size,
+             "'batch_sizes' must be non-increasing");
+    for (int64_t b = current_batch_size; b < prev_batch_size; ++b) {
+      lengths[b] = t;
+    }
+    prev_batch_size = current_batch_size;
+  }
+
+  at::Tensor index_t = at::empty(total_length, batch_sizes_t.options());
+  int64_t* index = index_t.data_ptr<int64_t>();
+  for (const auto b : c10::irange(max_batch_size)) {
+    for (const auto t : c10::irange(lengths[b])) {
+      *index++ = row_offsets[t] + b;
+    }
+  }
+
+  return std::make_tuple(
+      data.index_select(0, index_t.to(data.device())), lengths_t);
+}
+
 Tensor pad_sequence(TensorList sequences, bool batch_first, double padding_value) {
   const int64_t sequences_size = sequences.size();
   TORCH_CHECK(sequences_size > 0, "received an empty list of sequences");
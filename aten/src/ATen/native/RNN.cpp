@@ -6,6 +6,7 @@
 #include <ATen/native/quantized/PackedParams.h>
 #include <ATen/native/quantized/cpu/fbgemm_utils.h>
 #include <ATen/native/quantized/cpu/QnnpackUtils.h>
+#include <ATen/native/quantized/cpu/qrnn_cell.h>
 #include <c10/util/irange.h>
 #include <torch/custom_class.h>
 #include <torch/library.h>
@@ -740,6 +741,62 @@ struct GRUCell : Cell<Tensor, cell_params> {
   }
 };
 
+// The quantized cells run their gate GEMMs through prepacked int8 dynamic
+// linear, which leaves the pointwise epilogue as the remaining per-timestep
+// cost; route it through the fused kernels from qrnn_cell.cpp (see
+// Note [Fused quantized RNN cell pointwise]). The generic composition below
+// the fused call covers inputs the kernel declines. Quantized cells are
+// CPU-only, so the fused-CUDA branch of the primary template is omitted.
+template <>
+LSTMCell<QRNNCellParamsWrapper>::hidden_type
+LSTMCell<QRNNCellParamsWrapper>::operator()(
+    const Tensor& input,
+    const hidden_type& hidden,
+    const QRNNCellParamsWrapper& params,
+    bool pre_compute_input) const {
+  const auto& hx = std::get<0>(hidden);
+  const auto& cx = std::get<1>(hidden);
+  const auto gates = params.linear_hh(hx).add_(
+      pre_compute_input ? input : params.linear_ih(input));
+  if (auto fused = fused_quantized_lstm_cell_pointwise(gates, cx)) {
+    auto hy = params.matmul_hr(std::get<0>(*fused));
+    return std::make_tuple(std::move(hy), std::move(std::get<1>(*fused)));
+  }
+  auto chunked_gates = gates.unsafe_chunk(4, 1);
+  auto ingate = chunked_gates[0].sigmoid_();
+  auto forgetgate = chunked_gates[1].sigmoid_();
+  auto cellgate = chunked_gates[2].tanh_();
+  auto outgate = chunked_gates[3].sigmoid_();
+  auto cy = (forgetgate * cx).add_(ingate * cellgate);
+  auto hy = outgate * cy.tanh();
+  hy = params.matmul_hr(hy);
+  return std::make_tuple(std::move(hy), std::move(cy));
+}
+
+template <>
+GRUCell<QRNNCellParamsWrapper>::hidden_type
+GRUCell<QRNNCellParamsWrapper>::operator()(
+    const Tensor& input,
+    const hidden_type& hidden,
+    const QRNNCellParamsWrapper& params,
+    bool pre_compute_input) const {
+  const auto igates =
+      pre_compute_input ? input : params.linear_ih(input);
+  auto hgates = params.linear_hh(hidden);
+  if (auto fused = fused_quantized_gru_cell_pointwise(igates, hgates, hidden)) {
+    return std::move(*fused);
+  }
+  const auto chunked_igates = igates.unsafe_chunk(3, 1);
+  auto chunked_hgates = hgates.unsafe_chunk(3, 1);
+  const auto reset_gate =
+      chunked_hgates[0].add_(chunked_igates[0]).sigmoid_();
+  const auto input_gate =
+      chunked_hgates[1].add_(chunked_igates[1]).sigmoid_();
+  const auto new_gate =
+      chunked_igates[2].add(chunked_hgates[2].mul_(reset_gate)).tanh_();
+  return (hidden - new_gate).mul_(input_gate).add_(new_gate);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // LAYER IMPLEMENTATIONS
 //
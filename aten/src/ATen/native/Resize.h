@@ -175,7 +175,12 @@ inline void setStrided(
   if (self_->sizes() == size && self_->strides() == stride) {
     return;
   }
-  self_->set_sizes_and_strides(size, stride);
+  // Strides were checked non-negative above, so we can skip the stride
+  // fixup in set_sizes_and_strides and go through the interning fast
+  // path, which makes repeated views of the same out-of-line geometry
+  // allocation-free. See Note [Geometry interning] in
+  // c10/core/impl/SizesAndStrides.cpp.
+  self_->set_sizes_and_strides_interned(size, stride);
 }
 
 }}
@@ -2,6 +2,7 @@
 
 #include <ATen/ATen.h>
 #include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
 #include <c10/util/irange.h>
 
 #include <tuple>
@@ -11,6 +12,48 @@ namespace at { namespace native {
 ///////////////// bincount /////////////////
 namespace {
 
+/* Caps the number of bins for which the parallel path privatizes a bin
+ * array per thread. Beyond this, zeroing and merging the per-thread
+ * copies costs more than the scatter increments they deduplicate, and
+ * the memory overhead scales with the thread count.
+ */
+constexpr int64_t BINCOUNT_MAX_PRIVATIZED_BINS = 1 << 16;
+
+/* Accumulates weights (or unit counts) into `output`'s bins. For large
+ * inputs with a modest number of bins, each thread scatters into a
+ * private copy of the bins and the copies are merged with a single
+ * vectorized sum, so the shared bins are never contended. Mirrors the
+ * privatization scheme in cpu/HistogramKernel.cpp.
+ */
+template <typename input_t, typename acc_t, typename weight_fn_t>
+void _bincount_cpu_kernel(
+    Tensor& output,
+    const input_t* self_p,
+    int64_t self_size,
+    int64_t nbins,
+    const weight_fn_t& weight_of) {
+  acc_t* output_p = output.data_ptr<acc_t>();
+  if (self_size < at::internal::GRAIN_SIZE ||
+      nbins > BINCOUNT_MAX_PRIVATIZED_BINS || at::get_num_threads() == 1) {
+    for (const auto i : c10::irange(self_size)) {
+      output_p[self_p[i]] += weight_of(i);
+    }
+    return;
+  }
+
+  const auto num_threads = at::get_num_threads();
+  Tensor thread_bins = at::zeros({num_threads, nbins}, output.options());
+  acc_t* thread_bins_p = thread_bins.data_ptr<acc_t>();
+  at::parallel_for(
+      0, self_size, at::internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+        acc_t* bins_local = thread_bins_p + at::get_thread_num() * nbins;
+        for (const auto i : c10::irange(begin, end)) {
+          bins_local[self_p[i]] += weight_of(i);
+        }
+      });
+  at::sum_out(output, thread_bins, /*dim=*/{0});
+}
+
 template <typename input_t, typename weights_t>
 Tensor _bincount_cpu_template(
     const Tensor& self,
@@ -44,17 +87,17 @@ Tensor _bincount_cpu_template(
         weights.options().layout_opt(),
         weights.options().device_opt(),
         weights.options().pinned_memory_opt());
-    weights_t* output_p = output.data_ptr<weights_t>();
     const weights_t* weights_p = weights.data_ptr<weights_t>();
-    for (const auto i : c10::irange(self_size)) {
-      output_p[self_p[i]] += weights_p[i];
-    }
+    _bincount_cpu_kernel<input_t, weights_t>(
+        output, self_p, self_size, nbins, [weights_p](int64_t i) {
+          return weights_p[i];
+        });
   } else {
     output = native::zeros({nbins}, kLong);
-    int64_t* output_p = output.data_ptr<int64_t>();
-    for (const auto i : c10::irange(self_size)) {
-      output_p[self_p[i]] += 1L;
-    }
+    _bincount_cpu_kernel<input_t, int64_t>(
+        output, self_p, self_size, nbins, [](int64_t /*i*/) {
+          return static_cast<int64_t>(1);
+        });
   }
   return output;
 }
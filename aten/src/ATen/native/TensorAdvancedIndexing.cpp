@@ -68,6 +68,7 @@
 #include <ATen/TensorSubclassLikeUtils.h>
 
 #include <c10/util/irange.h>
+#include <c10/util/llvmMathExtras.h>
 #include <c10/util/Unroll.h>
 
 #include <algorithm>
@@ -1629,6 +1630,30 @@ Tensor masked_fill(const Tensor & self, const Tensor & mask, const Tensor & sour
   return result;
 }
 
+// Counts the nonzero bytes in data[0, n) a word at a time. The OR-folds
+// collapse each byte onto its own low bit (shifts never mix bits across
+// byte lanes there), so a single popcount per word counts eight elements.
+// This is the counting pass shared by masked_select and nonzero for
+// one-byte element types (notably bool masks).
+static int64_t count_nonzero_bytes(const uint8_t* data, int64_t n) {
+  constexpr uint64_t kLowBits = 0x0101010101010101ULL;
+  int64_t count = 0;
+  int64_t i = 0;
+  for (; i + static_cast<int64_t>(sizeof(uint64_t)) <= n;
+       i += sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, data + i, sizeof(word));
+    word |= word >> 4;
+    word |= word >> 2;
+    word |= word >> 1;
+    count += c10::llvm::countPopulation(word & kLowBits);
+  }
+  for (; i < n; ++i) {
+    count += data[i] != 0;
+  }
+  return count;
+}
+
 static Tensor & masked_select_out_impl_cpu(Tensor & result, const Tensor & self, const Tensor & mask) {
   NoNamesGuard guard;
 
@@ -1650,6 +1675,65 @@ static Tensor & masked_select_out_impl_cpu(Tensor & result, const Tensor & self,
   std::tie(_mask, _self) = expand_outplace(mask, self);
 
   auto shape = _self->sizes();
+
+  // Parallel two-pass compaction for contiguous inputs too large for the
+  // serial kernel below: per-chunk popcount of the mask bytes, an exclusive
+  // scan of the chunk totals, then parallel compress-store writes at the
+  // scanned offsets. This replaces both the full mask reduction used to
+  // size the output and the serial prefix sum over two temporary int64
+  // tensors in the TensorIterator fallback, which on large masks costs more
+  // than the selection itself. nonzero_out_cpu uses the same structure with
+  // per-thread instead of per-chunk counts.
+  const bool use_two_pass_kernel =
+      (self.numel() >= at::internal::GRAIN_SIZE && at::get_num_threads() > 1) &&
+      _self->is_contiguous() && _mask->is_contiguous();
+  if (use_two_pass_kernel) {
+    const int64_t mask_numel = _mask->numel();
+    const uint8_t* mask_data = static_cast<const uint8_t*>(_mask->data_ptr());
+    // Chunks are fixed-size (rather than one range per thread) so the write
+    // pass can reuse the counting pass's offsets under any work partition.
+    constexpr int64_t kCompactionChunk = 16384;
+    const int64_t num_chunks = (mask_numel + kCompactionChunk - 1) / kCompactionChunk;
+    std::vector<int64_t> chunk_offsets(num_chunks + 1, 0);
+    at::parallel_for(0, num_chunks, 1, [&](int64_t begin, int64_t end) {
+      for (const auto chunk : c10::irange(begin, end)) {
+        const int64_t chunk_begin = chunk * kCompactionChunk;
+        chunk_offsets[chunk + 1] = count_nonzero_bytes(
+            mask_data + chunk_begin,
+            std::min(kCompactionChunk, mask_numel - chunk_begin));
+      }
+    });
+    for (const auto chunk : c10::irange(num_chunks)) {
+      chunk_offsets[chunk + 1] += chunk_offsets[chunk];
+    }
+
+    at::native::resize_output(result, {chunk_offsets[num_chunks]});
+    if (chunk_offsets[num_chunks] == 0) {
+      return result;
+    }
+    const auto result_stride = result.strides()[0];
+    AT_DISPATCH_ALL_TYPES_AND_COMPLEX_AND3(ScalarType::Bool, ScalarType::BFloat16, ScalarType::Half,
+      _self->scalar_type(), "masked_select", [&] {
+      const scalar_t* self_data = _self->data_ptr<scalar_t>();
+      scalar_t* result_data = result.data_ptr<scalar_t>();
+      at::parallel_for(0, num_chunks, 1, [&](int64_t begin, int64_t end) {
+        for (const auto chunk : c10::irange(begin, end)) {
+          const int64_t chunk_begin = chunk * kCompactionChunk;
+          const int64_t chunk_end =
+              std::min(chunk_begin + kCompactionChunk, mask_numel);
+          scalar_t* out = result_data + chunk_offsets[chunk] * result_stride;
+          for (const auto i : c10::irange(chunk_begin, chunk_end)) {
+            if (mask_data[i]) {
+              *out = self_data[i];
+              out += result_stride;
+            }
+          }
+        }
+      });
+    });
+    return result;
+  }
+
   int64_t numel = _mask->sum().item().toLong();
   at::native::resize_output(result, {numel});
   if (numel == 0) {
@@ -1843,6 +1927,15 @@ int64_t count_nonzero_impl(TensorIteratorBase& iter, Range range) {
     constexpr int ilp_factor = 4;
     const char* ptr = data[0];
     const auto stride = strides[0];
+
+    // One-byte types traversed contiguously (e.g. bool masks) are counted
+    // eight elements per popcount instead of one per compare.
+    if (sizeof(scalar_t) == 1 && stride == 1) {
+      num_nonzero +=
+          count_nonzero_bytes(reinterpret_cast<const uint8_t*>(ptr), n);
+      return;
+    }
+
     int64_t nonzero[ilp_factor] = {0};
 
     int64_t i = 0;
@@ -13,6 +13,8 @@
 #include <ATen/TensorIndexing.h>
 #include <ATen/native/TypeProperties.h>
 #include <c10/core/QScheme.h>
+#include <c10/util/hash.h>
+#include <c10/util/irange.h>
 #include <ATen/TensorSubclassLikeUtils.h>
 
 namespace at {
@@ -224,6 +226,62 @@ bool allclose(const Tensor& self, const Tensor& other, double rtol, double atol,
   return at::isclose(self, other, rtol, atol, equal_nan).all().item<uint8_t>();
 }
 
+// Note [Tensor fast_hash]
+// ~~~~~~~~~~~~~~~~~~~~~~~
+// `fast_hash` produces a structural hash suitable for keying compilation and
+// plan caches without reading full tensor contents the way `equal` does. The
+// hash folds together:
+//   (1) metadata: dtype, device, sizes, strides, storage offset, and the
+//       conjugate/negative bits that change how the same bytes are read;
+//   (2) storage identity: the address of the underlying allocation; and
+//   (3) the version counter, which is bumped on every in-place mutation.
+// An unmodified weight therefore hashes to the same value on every call in
+// O(1) regardless of its size, and any tracked mutation changes the hash.
+// Inference tensors do not carry a version counter; for those we instead fold
+// in a bounded sample of leading and trailing storage bytes on CPU, trading a
+// small fixed read for mutation sensitivity. Equal hashes are a strong but
+// not certain signal: callers that need an exact answer must confirm with
+// `equal`.
+int64_t fast_hash(const Tensor& self) {
+  TORCH_CHECK(
+      self.layout() == Layout::Strided,
+      "fast_hash only supports strided tensors, got layout ", self.layout());
+  TORCH_CHECK(
+      !self.is_quantized(), "fast_hash is not supported for quantized tensors");
+
+  size_t seed = c10::get_hash(
+      self.scalar_type(),
+      self.device().type(),
+      self.device().index(),
+      self.sizes(),
+      self.strides(),
+      self.storage_offset(),
+      self.is_conj(),
+      self.is_neg());
+
+  const auto& storage = self.storage();
+  seed = c10::hash_combine(
+      seed, reinterpret_cast<uintptr_t>(storage.data()));
+
+  auto* impl = self.unsafeGetTensorImpl();
+  if (!impl->is_inference()) {
+    seed = c10::hash_combine(seed, impl->version_counter().current_version());
+  } else if (self.device().is_cpu() && storage.nbytes() > 0) {
+    // No version counter to observe mutations through, so sample a bounded
+    // number of bytes from both ends of the allocation.
+    constexpr size_t kSampleBytes = 64;
+    const auto* bytes = static_cast<const uint8_t*>(storage.data());
+    const auto nbytes = storage.nbytes();
+    for (const auto i : c10::irange(std::min(nbytes, kSampleBytes))) {
+      seed = c10::hash_combine(seed, bytes[i]);
+    }
+    for (const auto i : c10::irange(std::min(nbytes - 1, kSampleBytes))) {
+      seed = c10::hash_combine(seed, bytes[nbytes - 1 - i]);
+    }
+  }
+  return static_cast<int64_t>(seed);
+}
+
 // Note [closeness]
 // A number A is close to B when either:
 //
@@ -7,6 +7,7 @@
 #include <ATen/NativeFunctions.h>
 #include <ATen/TracerMode.h>
 #include <c10/core/ScalarType.h>
+#include <c10/core/impl/cow_cpu.h>
 #include <c10/util/Deprecated.h>
 #include <ATen/native/Math.h>
 #include <ATen/native/Resize.h>
@@ -1474,6 +1475,36 @@ Tensor clone(const Tensor& src, c10::optional<c10::MemoryFormat> optional_memory
   return self;
 }
 
+Tensor cow_clone_cpu(const Tensor& self) {
+  // See Note [Memfd-backed CPU allocations and CoW snapshots]. The whole
+  // storage is snapshotted, so views stay views of the snapshot; if the
+  // storage is not memfd-backed (allocator flag unset, small allocation,
+  // non-Linux, external data) this degrades to a regular deep copy.
+  const auto& src_storage = self.storage();
+  if (src_storage.data() != nullptr && !self._is_zerotensor()) {
+    void* snapshot = c10::impl::memfd_cow_snapshot(src_storage.data());
+    if (snapshot != nullptr) {
+      Storage storage(
+          Storage::use_byte_size_t(),
+          src_storage.nbytes(),
+          DataPtr(
+              snapshot,
+              snapshot,
+              &c10::impl::delete_memfd_cow_snapshot,
+              DeviceType::CPU),
+          /*allocator=*/nullptr,
+          /*resizable=*/false);
+      Tensor result = at::empty({0}, self.options());
+      result.unsafeGetTensorImpl()->set_storage_keep_dtype(std::move(storage));
+      result.unsafeGetTensorImpl()->set_storage_offset(self.storage_offset());
+      result.unsafeGetTensorImpl()->set_sizes_and_strides(
+          self.sizes(), self.strides());
+      return result;
+    }
+  }
+  return self.clone(MemoryFormat::Preserve);
+}
+
 // ~~~~~~~~~~~~~~~~~~~~~~~~~ named tensor overloads ~~~~~~~~~~~~~~~~~~~~~~~~~~~
 // In the short term, these exist.
 // In the long term, we should move DimnameList into TensorOptions to avoid
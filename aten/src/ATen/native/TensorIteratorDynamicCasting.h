@@ -13,7 +13,9 @@
 // dynamic_casting handles when the types expected by the iterator do not match the types of the arguments
 // to the function that is being called.
 // On CUDA, the cast is currently pushed down into the kernel (for performance reasons).
-// On CPU, there is currently an internal assert that a dynamic_cast is not needed.
+// On CPU, cpu_kernel and cpu_kernel_vec likewise cast on load and store (vectorized for
+// contiguous data, see [Note: dynamic casting on CPU] in Loops.h); the serial kernels
+// still assert that a dynamic_cast is not needed.
 
 namespace at { namespace native {
 
@@ -165,6 +165,7 @@ TORCH_PRECOMPUTE_META_FUNC(cat)(ITensorListRef tensors, int64_t dim) {
 namespace native {
 
 DEFINE_DISPATCH(cat_serial_stub);
+DEFINE_DISPATCH(cat_contig_stub);
 DEFINE_DISPATCH(stack_serial_stub);
 
 Tensor _reshape_from_tensor(const Tensor& self, const Tensor& shape_tensor) {
@@ -349,6 +350,18 @@ TORCH_IMPL_FUNC(cat_out_cpu)
     return;
   }
 
+  // Many small inputs: the per-input TensorIterator setup in the loops below
+  // costs more than the copies themselves, so hand the whole list to a single
+  // parallel chunk-copy kernel instead (see cat_contig_kernel). Few large
+  // inputs are better served below, where each copy parallelizes internally.
+  constexpr int64_t kManyInputsThreshold = 64;
+  int64_t ninputs = static_cast<int64_t>(materialized.size());
+  if (all_contiguous && all_same_dtype && ninputs >= kManyInputsThreshold &&
+      result.numel() / ninputs < at::internal::GRAIN_SIZE) {
+    cat_contig_stub(kCPU, result, materialized, dim);
+    return;
+  }
+
   int64_t offset = 0;
   if (all_same_sizes_and_stride && result.is_contiguous(memory_format) &&
       all_same_dtype) {
@@ -1,6 +1,10 @@
 #pragma once
 #include <ATen/core/TensorAccessor.h>
 #include <ATen/NumericUtils.h>
+#include <ATen/Parallel.h>
+#include <c10/util/irange.h>
+
+#include <cstring>
 
 namespace at {
 namespace native {
@@ -90,6 +94,229 @@ void topk_impl_loop(
   }
 }
 
+// Note [CPU radix selection]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+// topk_impl_loop and the comparison sorts in SortingKernel.cpp only
+// parallelize across rows, so a single huge row (e.g. ranking scores for a
+// 500M candidate pool) runs on one core. The radix paths below instead order
+// elements by an unsigned key whose ascending unsigned order matches the
+// comparison order used above, with NaNs (of either sign) mapped above +inf
+// to match the "NaN sorts as largest" convention. The keys only encode
+// ordering: output values are always copied out of the original data, so NaN
+// payloads and the sign of zero survive untouched.
+template <typename scalar_t>
+struct RadixSortKey {
+  static constexpr bool supported = false;
+};
+
+template <typename scalar_t, typename unsigned_t>
+struct SignedIntRadixKey {
+  static constexpr bool supported = true;
+  // Radix key order coincides exactly with the comparison order, including
+  // its equivalence classes, so the radix paths may serve stable sorts.
+  static constexpr bool exact_order = true;
+  using key_t = unsigned_t;
+  static key_t transform(scalar_t v) {
+    return static_cast<key_t>(v) ^ (key_t(1) << (8 * sizeof(key_t) - 1));
+  }
+};
+
+template <> struct RadixSortKey<int8_t> : SignedIntRadixKey<int8_t, uint8_t> {};
+template <> struct RadixSortKey<int16_t> : SignedIntRadixKey<int16_t, uint16_t> {};
+template <> struct RadixSortKey<int32_t> : SignedIntRadixKey<int32_t, uint32_t> {};
+template <> struct RadixSortKey<int64_t> : SignedIntRadixKey<int64_t, uint64_t> {};
+
+template <>
+struct RadixSortKey<uint8_t> {
+  static constexpr bool supported = true;
+  static constexpr bool exact_order = true;
+  using key_t = uint8_t;
+  static key_t transform(uint8_t v) {
+    return v;
+  }
+};
+
+template <typename scalar_t, typename unsigned_t>
+struct FloatRadixKey {
+  static constexpr bool supported = true;
+  // -0.0 and +0.0 compare equal but get distinct keys, so radix order is not
+  // a refinement of the comparison order and cannot serve stable sorts.
+  static constexpr bool exact_order = false;
+  using key_t = unsigned_t;
+  static key_t transform(scalar_t v) {
+    if (_isnan<scalar_t>(v)) {
+      return ~key_t(0);
+    }
+    key_t bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    const key_t sign = key_t(1) << (8 * sizeof(key_t) - 1);
+    return bits ^ ((bits & sign) ? ~key_t(0) : sign);
+  }
+};
+
+template <> struct RadixSortKey<float> : FloatRadixKey<float, uint32_t> {};
+template <> struct RadixSortKey<double> : FloatRadixKey<double, uint64_t> {};
+
+// Heap-free parallel topk for a contiguous 1-D input: an MSD radix selection
+// narrows down the key of the k-th element one byte at a time, then a single
+// partition pass collects every element on the winning side of that key,
+// breaking ties at the threshold by lowest index. All O(n) phases scale with
+// cores; the caller is expected to gate on a size threshold.
+template <
+    typename scalar_t,
+    typename std::enable_if<RadixSortKey<scalar_t>::supported, int>::type = 0>
+bool topk_radix_select_impl(
+    scalar_t* mode_values,
+    int64_t* mode_indices,
+    const scalar_t* self_data,
+    int64_t k,
+    int64_t n,
+    bool largest,
+    bool sorted) {
+  using traits = RadixSortKey<scalar_t>;
+  using key_t = typename traits::key_t;
+  constexpr int kKeyBits = 8 * sizeof(key_t);
+  constexpr int64_t kNumBuckets = 256;
+
+  // `largest` flips the key order so that selection always looks for the k
+  // smallest keys.
+  const auto make_key = [largest](scalar_t v) -> key_t {
+    const key_t key = traits::transform(v);
+    return largest ? static_cast<key_t>(~key) : key;
+  };
+
+  const int64_t num_chunks = std::max<int64_t>(
+      1,
+      std::min<int64_t>(at::get_num_threads(), divup(n, internal::GRAIN_SIZE)));
+  const auto chunk_begin = [n, num_chunks](int64_t c) {
+    return n * c / num_chunks;
+  };
+
+  // Fix the key one byte at a time, from most to least significant.
+  // Invariant: k_remaining is the rank we are after among the elements whose
+  // key starts with `prefix` (on `prefix_mask`), and there are at least
+  // k_remaining of them.
+  std::vector<int64_t> counts(num_chunks * kNumBuckets);
+  key_t prefix = 0;
+  key_t prefix_mask = 0;
+  int64_t k_remaining = k;
+  for (int shift = kKeyBits - 8; shift >= 0; shift -= 8) {
+    std::fill(counts.begin(), counts.end(), int64_t{0});
+    at::parallel_for(0, num_chunks, 1, [&](int64_t cbegin, int64_t cend) {
+      for (const auto c : c10::irange(cbegin, cend)) {
+        int64_t* my_counts = counts.data() + c * kNumBuckets;
+        for (const auto i : c10::irange(chunk_begin(c), chunk_begin(c + 1))) {
+          const key_t key = make_key(self_data[i]);
+          if ((key & prefix_mask) == prefix) {
+            my_counts[(key >> shift) & 0xFF]++;
+          }
+        }
+      }
+    });
+    int64_t bucket = 0;
+    int64_t below = 0; // candidates in buckets before the chosen one
+    for (const auto b : c10::irange(kNumBuckets)) {
+      int64_t total = 0;
+      for (const auto c : c10::irange(num_chunks)) {
+        total += counts[c * kNumBuckets + b];
+      }
+      if (below + total >= k_remaining) {
+        bucket = b;
+        break;
+      }
+      below += total;
+    }
+    k_remaining -= below;
+    prefix |= static_cast<key_t>(static_cast<key_t>(bucket) << shift);
+    prefix_mask |= static_cast<key_t>(static_cast<key_t>(0xFF) << shift);
+  }
+
+  // Everything below `threshold` is in the topk; k_remaining elements equal
+  // to it (the ones with the lowest indices) fill the remaining slots.
+  const key_t threshold = prefix;
+  const int64_t num_equal_take = k_remaining;
+  std::vector<int64_t> less_counts(num_chunks, 0);
+  std::vector<int64_t> equal_counts(num_chunks, 0);
+  at::parallel_for(0, num_chunks, 1, [&](int64_t cbegin, int64_t cend) {
+    for (const auto c : c10::irange(cbegin, cend)) {
+      int64_t num_less = 0;
+      int64_t num_equal = 0;
+      for (const auto i : c10::irange(chunk_begin(c), chunk_begin(c + 1))) {
+        const key_t key = make_key(self_data[i]);
+        num_less += key < threshold;
+        num_equal += key == threshold;
+      }
+      less_counts[c] = num_less;
+      equal_counts[c] = num_equal;
+    }
+  });
+  std::vector<int64_t> less_offsets(num_chunks);
+  std::vector<int64_t> equal_offsets(num_chunks);
+  int64_t less_total = 0;
+  int64_t equal_running = 0;
+  for (const auto c : c10::irange(num_chunks)) {
+    less_offsets[c] = less_total;
+    less_total += less_counts[c];
+    equal_offsets[c] = equal_running;
+    equal_running += equal_counts[c];
+  }
+  at::parallel_for(0, num_chunks, 1, [&](int64_t cbegin, int64_t cend) {
+    for (const auto c : c10::irange(cbegin, cend)) {
+      int64_t less_pos = less_offsets[c];
+      int64_t equal_rank = equal_offsets[c];
+      for (const auto i : c10::irange(chunk_begin(c), chunk_begin(c + 1))) {
+        const key_t key = make_key(self_data[i]);
+        if (key < threshold) {
+          mode_values[less_pos] = self_data[i];
+          mode_indices[less_pos] = i;
+          less_pos++;
+        } else if (key == threshold) {
+          if (equal_rank < num_equal_take) {
+            mode_values[less_total + equal_rank] = self_data[i];
+            mode_indices[less_total + equal_rank] = i;
+          }
+          equal_rank++;
+        }
+      }
+    }
+  });
+
+  if (sorted && k > 1) {
+    struct Entry {
+      key_t key;
+      scalar_t value;
+      int64_t index;
+    };
+    std::vector<Entry> entries(k);
+    for (const auto j : c10::irange(k)) {
+      entries[j] = Entry{make_key(mode_values[j]), mode_values[j], mode_indices[j]};
+    }
+    std::sort(
+        entries.begin(), entries.end(), [](const Entry& x, const Entry& y) {
+          return x.key < y.key || (x.key == y.key && x.index < y.index);
+        });
+    for (const auto j : c10::irange(k)) {
+      mode_values[j] = entries[j].value;
+      mode_indices[j] = entries[j].index;
+    }
+  }
+  return true;
+}
+
+template <
+    typename scalar_t,
+    typename std::enable_if<!RadixSortKey<scalar_t>::supported, int>::type = 0>
+bool topk_radix_select_impl(
+    scalar_t* /*mode_values*/,
+    int64_t* /*mode_indices*/,
+    const scalar_t* /*self_data*/,
+    int64_t /*k*/,
+    int64_t /*n*/,
+    bool /*largest*/,
+    bool /*sorted*/) {
+  return false;
+}
+
 } // namespace CPU_CAPABILITY
 } // namespace native
 } // namespace at
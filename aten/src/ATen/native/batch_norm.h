@@ -14,6 +14,7 @@ using batch_norm_backward_fn = void(*)(Tensor&, Tensor&, Tensor&, const Tensor&,
         const Tensor&, const Tensor&, const Tensor&, const Tensor&, const Tensor&, const Tensor&, bool, double);
 
 DECLARE_DISPATCH(batch_norm_fn, batch_norm_cpu_stub);
+DECLARE_DISPATCH(batch_norm_fn, batch_norm_cpu_relu_stub);
 DECLARE_DISPATCH(batch_norm_collect_stats_fn, batch_norm_cpu_collect_stats_stub);
 DECLARE_DISPATCH(batch_norm_backward_fn, batch_norm_cpu_backward_stub);
 
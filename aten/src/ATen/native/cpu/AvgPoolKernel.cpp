@@ -432,54 +432,71 @@ void cpu_avg_pool_backward_channels_last(
   int64_t output_width = grad_output.size(3);
 
   using Vec = vec::Vectorized<scalar_t>;
-  // parallel on dim N
-  at::parallel_for(0, nbatch, 0, [&](int64_t begin, int64_t end) {
-    for (const auto n : c10::irange(begin, end)) {
+  // Walk grad_input instead of grad_output: each input row is written by
+  // exactly one iteration, so tiles of {N, H_in} are independent even when
+  // the pooling windows overlap and we can parallelize beyond the batch
+  // dimension. For every input pixel, accumulate over the output windows
+  // that cover it.
+  at::parallel_for(0, nbatch * input_height, 0, [&](int64_t begin, int64_t end) {
+    int64_t n = 0;
+    int64_t ih = 0;
+    data_index_init(begin, n, nbatch, ih, input_height);
+
+    for (const auto i : c10::irange(begin, end)) {
       scalar_t* grad_input_ptr = grad_input_data + n * input_height * input_width * channels;
       scalar_t* grad_output_ptr = grad_output_data + n * output_height * output_width * channels;
 
-      for (const auto oh : c10::irange(output_height)) {
-        for (const auto ow : c10::irange(output_width)) {
-          int64_t ih0 = oh * dH - padH;
-          int64_t iw0 = ow * dW - padW;
-          int64_t ih1 = std::min(ih0 + kH, input_height + padH);
-          int64_t iw1 = std::min(iw0 + kW, input_width + padW);
-          int64_t pool_size = (ih1 - ih0) * (iw1 - iw0);
-          ih0 = std::max(ih0, (int64_t) 0);
-          iw0 = std::max(iw0, (int64_t) 0);
-          ih1 = std::min(ih1, input_height);
-          iw1 = std::min(iw1, input_width);
-
-          int64_t divide_factor;
-          if (divisor_override.has_value()) {
-            divide_factor = divisor_override.value();
-          } else {
-            if(count_include_pad) {
-              divide_factor = pool_size;
+      // Output rows whose (possibly padded) window covers input row ih:
+      // oh * dH - padH <= ih < oh * dH - padH + kH
+      int64_t oh0 = std::max(divup(ih + padH - kH + 1, dH), (int64_t) 0);
+      int64_t oh1 = std::min((ih + padH) / dH + 1, output_height);
+
+      for (const auto iw : c10::irange(input_width)) {
+        scalar_t* gin = grad_input_ptr + ih * input_width * channels + iw * channels;
+
+        int64_t ow0 = std::max(divup(iw + padW - kW + 1, dW), (int64_t) 0);
+        int64_t ow1 = std::min((iw + padW) / dW + 1, output_width);
+
+        int64_t size = channels;
+        int64_t len = size - (size % Vec::size());
+        for (const auto oh : c10::irange(oh0, oh1)) {
+          for (const auto ow : c10::irange(ow0, ow1)) {
+            int64_t ih0 = oh * dH - padH;
+            int64_t iw0 = ow * dW - padW;
+            int64_t ih1 = std::min(ih0 + kH, input_height + padH);
+            int64_t iw1 = std::min(iw0 + kW, input_width + padW);
+            int64_t pool_size = (ih1 - ih0) * (iw1 - iw0);
+            ih0 = std::max(ih0, (int64_t) 0);
+            iw0 = std::max(iw0, (int64_t) 0);
+            ih1 = std::min(ih1, input_height);
+            iw1 = std::min(iw1, input_width);
+
+            int64_t divide_factor;
+            if (divisor_override.has_value()) {
+              divide_factor = divisor_override.value();
             } else {
-               divide_factor = (ih1 - ih0) * (iw1 - iw0);
+              if(count_include_pad) {
+                divide_factor = pool_size;
+              } else {
+                 divide_factor = (ih1 - ih0) * (iw1 - iw0);
+              }
             }
-          }
 
-          scalar_t* gout = grad_output_ptr + oh * output_width * channels + ow * channels;
-          int64_t size = channels;
-          int64_t len = size - (size % Vec::size());
-          for (const auto ih : c10::irange(ih0, ih1)) {
-            for (const auto iw : c10::irange(iw0, iw1)) {
-              scalar_t* gin = grad_input_ptr + ih * input_width * channels + iw * channels;
+            scalar_t* gout = grad_output_ptr + oh * output_width * channels + ow * channels;
 
-              int64_t d = 0;
-              for (; d < len; d += Vec::size()) {
-                Vec gin_vec = Vec::loadu(gin + d) + Vec::loadu(gout + d) / Vec(scalar_t(divide_factor));
-                gin_vec.store(gin + d);
-              }
-              for (; d < size; d++) {
-                gin[d] += gout[d] / divide_factor;
-              }
+            int64_t d = 0;
+            for (; d < len; d += Vec::size()) {
+              Vec gin_vec = Vec::loadu(gin + d) + Vec::loadu(gout + d) / Vec(scalar_t(divide_factor));
+              gin_vec.store(gin + d);
+            }
+            for (; d < size; d++) {
+              gin[d] += gout[d] / divide_factor;
             }
           }
         }
       }
+
+      data_index_step(n, nbatch, ih, input_height);
     }
   });
 
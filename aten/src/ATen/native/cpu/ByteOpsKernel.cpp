@@ -0,0 +1,222 @@
+#include <ATen/ATen.h>
+#include <ATen/Parallel.h>
+#include <ATen/native/ByteOps.h>
+#include <ATen/native/cpu/Intrinsics.h>
+#include <c10/util/irange.h>
+#include <c10/util/llvmMathExtras.h>
+
+#include <vector>
+
+namespace at {
+namespace native {
+namespace {
+
+// Note [Byte kernels for tokenization]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// These kernels back _byte_translate/_byte_find/_byte_run_lengths so
+// that the byte-level stages of a tokenizer (normalization, delimiter
+// scan, run segmentation) stay inside tensor land instead of per-byte
+// loops in user code. The find and run-length kernels carry AVX2 paths
+// built on cmpeq/movemask: a 32-byte block is compared at once and the
+// resulting bit mask is counted or walked with ctz. Translation is an
+// arbitrary 256-entry gather, which does not map onto pre-VBMI
+// shuffles, so it relies on the table staying L1-resident and an
+// unrolled loop to keep several loads in flight; it is memory-bound
+// either way.
+
+constexpr int64_t kByteFindChunk = 32768;
+
+#ifdef CPU_CAPABILITY_AVX2
+// Bit i of the result is set iff p[i] matches any of the needle
+// broadcasts.
+inline uint32_t match_mask_32(const uint8_t* p, const __m256i* needles, int num_needles) {
+  const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+  __m256i mask = _mm256_cmpeq_epi8(v, needles[0]);
+  for (int i = 1; i < num_needles; ++i) {
+    mask = _mm256_or_si256(mask, _mm256_cmpeq_epi8(v, needles[i]));
+  }
+  return static_cast<uint32_t>(_mm256_movemask_epi8(mask));
+}
+#endif
+
+struct NeedleSet {
+  // Membership table for the scalar path and the tails.
+  bool member[256] = {};
+#ifdef CPU_CAPABILITY_AVX2
+  // Broadcast needles for the SIMD path; only filled for small sets,
+  // where the compare chain beats the per-byte table probe.
+  static constexpr int kMaxSimdNeedles = 8;
+  __m256i broadcasts[kMaxSimdNeedles];
+  int num_simd_needles = 0;
+#endif
+
+  explicit NeedleSet(const Tensor& needles) {
+    const uint8_t* data = needles.data_ptr<uint8_t>();
+    const int64_t numel = needles.numel();
+    for (const auto i : c10::irange(numel)) {
+      member[data[i]] = true;
+    }
+#ifdef CPU_CAPABILITY_AVX2
+    int unique_needles = 0;
+    for (const auto b : c10::irange(256)) {
+      unique_needles += member[b] ? 1 : 0;
+    }
+    if (unique_needles <= kMaxSimdNeedles) {
+      for (const auto b : c10::irange(256)) {
+        if (member[b]) {
+          broadcasts[num_simd_needles++] = _mm256_set1_epi8(static_cast<char>(b));
+        }
+      }
+    }
+#endif
+  }
+
+  int64_t count(const uint8_t* p, int64_t len) const {
+    int64_t n = 0;
+    int64_t i = 0;
+#ifdef CPU_CAPABILITY_AVX2
+    if (num_simd_needles > 0) {
+      for (; i + 32 <= len; i += 32) {
+        n += c10::llvm::countPopulation(
+            match_mask_32(p + i, broadcasts, num_simd_needles));
+      }
+    }
+#endif
+    for (; i < len; ++i) {
+      n += member[p[i]] ? 1 : 0;
+    }
+    return n;
+  }
+
+  // Writes the indices (relative to `base`) of all matches in p[0, len)
+  // to `out`; returns one past the last index written.
+  int64_t* collect(const uint8_t* p, int64_t len, int64_t base, int64_t* out) const {
+    int64_t i = 0;
+#ifdef CPU_CAPABILITY_AVX2
+    if (num_simd_needles > 0) {
+      for (; i + 32 <= len; i += 32) {
+        uint32_t mask = match_mask_32(p + i, broadcasts, num_simd_needles);
+        while (mask != 0) {
+          *out++ = base + i + c10::llvm::countTrailingZeros(mask);
+          mask &= mask - 1;
+        }
+      }
+    }
+#endif
+    for (; i < len; ++i) {
+      if (member[p[i]]) {
+        *out++ = base + i;
+      }
+    }
+    return out;
+  }
+};
+
+void byte_translate_kernel(Tensor& result, const Tensor& self, const Tensor& table) {
+  const uint8_t* src = self.data_ptr<uint8_t>();
+  const uint8_t* lut = table.data_ptr<uint8_t>();
+  uint8_t* dst = result.data_ptr<uint8_t>();
+  parallel_for(
+      0, self.numel(), internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+        // Unrolled so several table loads are in flight at once.
+        int64_t i = begin;
+        for (; i + 4 <= end; i += 4) {
+          dst[i] = lut[src[i]];
+          dst[i + 1] = lut[src[i + 1]];
+          dst[i + 2] = lut[src[i + 2]];
+          dst[i + 3] = lut[src[i + 3]];
+        }
+        for (; i < end; ++i) {
+          dst[i] = lut[src[i]];
+        }
+      });
+}
+
+void byte_find_kernel(Tensor& result, const Tensor& self, const Tensor& needles) {
+  const uint8_t* src = self.data_ptr<uint8_t>();
+  const int64_t numel = self.numel();
+  const NeedleSet needle_set(needles);
+
+  // Two passes so the output can be written in parallel: per-chunk
+  // match counts, an exclusive scan into output offsets, then a second
+  // sweep that fills each chunk's slice.
+  const int64_t num_chunks = divup(numel, kByteFindChunk);
+  std::vector<int64_t> offsets(num_chunks + 1, 0);
+  parallel_for(0, num_chunks, 1, [&](int64_t begin, int64_t end) {
+    for (const auto chunk : c10::irange(begin, end)) {
+      const int64_t start = chunk * kByteFindChunk;
+      const int64_t len = std::min(kByteFindChunk, numel - start);
+      offsets[chunk + 1] = needle_set.count(src + start, len);
+    }
+  });
+  for (const auto chunk : c10::irange(num_chunks)) {
+    offsets[chunk + 1] += offsets[chunk];
+  }
+
+  result.resize_({offsets[num_chunks]});
+  int64_t* out = result.data_ptr<int64_t>();
+  parallel_for(0, num_chunks, 1, [&](int64_t begin, int64_t end) {
+    for (const auto chunk : c10::irange(begin, end)) {
+      const int64_t start = chunk * kByteFindChunk;
+      const int64_t len = std::min(kByteFindChunk, numel - start);
+      needle_set.collect(src + start, len, start, out + offsets[chunk]);
+    }
+  });
+}
+
+// Returns the index one past the end of the run of src[i] starting at
+// i. The AVX2 path skips 32 equal bytes per compare, so long runs
+// (padding, whitespace) cost ~1/32 of a scalar walk.
+int64_t run_end(const uint8_t* src, int64_t i, int64_t numel) {
+  const uint8_t value = src[i];
+  ++i;
+#ifdef CPU_CAPABILITY_AVX2
+  const __m256i broadcast = _mm256_set1_epi8(static_cast<char>(value));
+  while (i + 32 <= numel) {
+    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+    const uint32_t eq = static_cast<uint32_t>(
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(v, broadcast)));
+    if (eq != 0xffffffffu) {
+      return i + c10::llvm::countTrailingZeros(~eq);
+    }
+    i += 32;
+  }
+#endif
+  while (i < numel && src[i] == value) {
+    ++i;
+  }
+  return i;
+}
+
+void byte_run_lengths_kernel(Tensor& values, Tensor& lengths, const Tensor& self) {
+  const uint8_t* src = self.data_ptr<uint8_t>();
+  const int64_t numel = self.numel();
+
+  // Runs can span any chunk boundary, so this is serial like
+  // unique_consecutive: one pass to count runs, one to fill.
+  int64_t num_runs = 0;
+  for (int64_t i = 0; i < numel; i = run_end(src, i, numel)) {
+    ++num_runs;
+  }
+
+  values.resize_({num_runs});
+  lengths.resize_({num_runs});
+  uint8_t* values_out = values.data_ptr<uint8_t>();
+  int64_t* lengths_out = lengths.data_ptr<int64_t>();
+  int64_t i = 0;
+  for (const auto run : c10::irange(num_runs)) {
+    const int64_t end = run_end(src, i, numel);
+    values_out[run] = src[i];
+    lengths_out[run] = end - i;
+    i = end;
+  }
+}
+
+} // anonymous namespace
+
+REGISTER_DISPATCH(byte_translate_stub, &byte_translate_kernel);
+REGISTER_DISPATCH(byte_find_stub, &byte_find_kernel);
+REGISTER_DISPATCH(byte_run_lengths_stub, &byte_run_lengths_kernel);
+
+} // namespace native
+} // namespace at
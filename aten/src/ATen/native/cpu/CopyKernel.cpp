@@ -1,9 +1,14 @@
 #define TORCH_ASSERT_NO_OPERATORS
 #include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/ParallelGrainTuner.h>
+#include <ATen/core/TensorBase.h>
+#include <ATen/cpu/vec/vec.h>
 #include <ATen/native/Copy.h>
 #include <ATen/native/TensorIterator.h>
 #include <ATen/native/cpu/Loops.h>
 #include <c10/util/TypeCast.h>
+#include <c10/util/irange.h>
 #include <ATen/native/cpu/zmath.h>
 
 namespace at {
@@ -112,9 +117,116 @@ void copy_kernel(TensorIterator& iter, bool /*non_blocking*/) {
   }
 }
 
+// Note [Blocked transpose copy]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// copy_ lowers "contiguous <- 2-d transposed" copies (see copy_transpose_valid
+// in Copy.cpp) to this kernel instead of the generic TensorIterator loop,
+// which degenerates into a strided scalar walk for that pattern. The matrix is
+// processed as a parallel grid of cache-sized blocks; inside a block, square
+// Vec::size() tiles are transposed entirely in registers with a log2(N)
+// interleave network (compiling down to unpack/shuffle sequences where the
+// ISA provides them), and the ragged edges fall back to scalar loops. Complex
+// types and lane counts that are not a power of two always take the scalar
+// path.
+
+constexpr int64_t kTransposeBlockSize = 64;
+
+template <typename scalar_t>
+inline void transpose_tile_vec(
+    const scalar_t* src, int64_t ld_src, scalar_t* dst, int64_t ld_dst) {
+  using Vec = Vectorized<scalar_t>;
+  constexpr int N = Vec::size();
+  Vec buf1[N];
+  Vec buf2[N];
+  Vec* cur = buf1;
+  Vec* next = buf2;
+  for (const auto i : c10::irange(N)) {
+    cur[i] = Vec::loadu(src + i * ld_src);
+  }
+  // Each round zips rows i and i + N/2; after log2(N) rounds row r holds
+  // lane r of every input row, i.e. the transposed tile.
+  for (int round = 1; round < N; round <<= 1) {
+    for (const auto i : c10::irange(N / 2)) {
+      auto zipped = interleave2(cur[i], cur[i + N / 2]);
+      next[2 * i] = std::get<0>(zipped);
+      next[2 * i + 1] = std::get<1>(zipped);
+    }
+    std::swap(cur, next);
+  }
+  for (const auto i : c10::irange(N)) {
+    cur[i].store(dst + i * ld_dst);
+  }
+}
+
+template <typename scalar_t>
+inline void transpose_tile_scalar(
+    const scalar_t* src, int64_t ld_src, scalar_t* dst, int64_t ld_dst,
+    int64_t nr, int64_t nc) {
+  for (const auto c : c10::irange(nc)) {
+    for (const auto r : c10::irange(nr)) {
+      dst[r * ld_dst + c] = src[r + c * ld_src];
+    }
+  }
+}
+
+template <typename scalar_t>
+inline void transpose_block(
+    const scalar_t* src, int64_t ld_src, scalar_t* dst, int64_t ld_dst,
+    int64_t nr, int64_t nc) {
+  constexpr int N = Vectorized<scalar_t>::size();
+  constexpr bool use_vec =
+      !c10::is_complex<scalar_t>::value && (N & (N - 1)) == 0;
+  const int64_t r_full = use_vec ? nr - nr % N : 0;
+  const int64_t c_full = use_vec ? nc - nc % N : 0;
+  for (int64_t r = 0; r < r_full; r += N) {
+    for (int64_t c = 0; c < c_full; c += N) {
+      transpose_tile_vec(
+          src + r + c * ld_src, ld_src, dst + r * ld_dst + c, ld_dst);
+    }
+  }
+  if (c_full < nc) {
+    transpose_tile_scalar(
+        src + c_full * ld_src, ld_src, dst + c_full, ld_dst, r_full,
+        nc - c_full);
+  }
+  if (r_full < nr) {
+    transpose_tile_scalar(
+        src + r_full, ld_src, dst + r_full * ld_dst, ld_dst, nr - r_full, nc);
+  }
+}
+
+void transpose_copy_kernel(const TensorBase& self, const TensorBase& src) {
+  AT_DISPATCH_ALL_TYPES_AND_COMPLEX_AND4(
+      kHalf, kBool, kBFloat16, kComplexHalf, self.scalar_type(), "copy_", [&] {
+    const scalar_t* sp = src.data_ptr<scalar_t>();
+    scalar_t* rp = self.data_ptr<scalar_t>();
+
+    const int64_t NR = src.size(0);
+    const int64_t NC = src.size(1);
+    const int64_t blocks_per_row = divup(NC, kTransposeBlockSize);
+    const int64_t num_blocks = divup(NR, kTransposeBlockSize) * blocks_per_row;
+    const int64_t grain_size = std::max<int64_t>(
+        1,
+        internal::GRAIN_SIZE / (kTransposeBlockSize * kTransposeBlockSize));
+    parallel_for_tuned(
+        "copy_transpose_2d", 0, num_blocks, grain_size,
+        [&](int64_t begin, int64_t end) {
+      for (const auto blk : c10::irange(begin, end)) {
+        const int64_t R = blk / blocks_per_row * kTransposeBlockSize;
+        const int64_t C = blk % blocks_per_row * kTransposeBlockSize;
+        transpose_block(
+            sp + R + C * NR, NR, rp + R * NC + C, NC,
+            std::min(NR - R, kTransposeBlockSize),
+            std::min(NC - C, kTransposeBlockSize));
+      }
+    });
+  });
+}
+
 } // anonymous namespace
 
 REGISTER_DISPATCH(copy_stub, &copy_kernel);
+REGISTER_DISPATCH(transpose_copy_stub, &transpose_copy_kernel);
 
 } // namespace native
 } // namespace at
@@ -1,7 +1,10 @@
 #define TORCH_ASSERT_ONLY_METHOD_OPERATORS
 #include <ATen/native/cpu/DepthwiseConvKernel.h>
 #include <ATen/core/Tensor.h>
+#include <ATen/Dispatch.h>
+#include <ATen/OpMathType.h>
 #include <ATen/Parallel.h>
+#include <ATen/cpu/vec/vec.h>
 #include <c10/util/irange.h>
 
 #ifndef AT_PER_OPERATOR_HEADERS
@@ -309,9 +312,193 @@ Tensor _convolution_depthwise3x3_winograd(
   return output;
 }
 
+// Direct depthwise convolution for the 2d cases the winograd kernel above
+// does not cover: arbitrary kernel size, stride and padding (no dilation).
+// One output channel plane is computed per task; accumulation is in
+// opmath_type, so the bfloat16 instantiation accumulates in float and
+// rounds once per output element.
+
+struct DirectArgs final {
+  // Input plane dimensions
+  int64_t in_rows;
+  int64_t in_cols;
+
+  // Kernel dimensions and convolution parameters
+  int64_t k_rows;
+  int64_t k_cols;
+  int64_t stride_rows;
+  int64_t stride_cols;
+  int64_t pad_rows;
+  int64_t pad_cols;
+
+  // Output plane dimensions
+  int64_t out_rows;
+  int64_t out_cols;
+};
+
+// Single output element with the kernel window clipped to the input plane.
+// Taps that fall into the padding contribute zero and are simply skipped.
+template <typename scalar_t>
+inline at::opmath_type<scalar_t> depthwise2d_direct_one(
+    const DirectArgs& args,
+    const scalar_t* const input,
+    const scalar_t* const weight,
+    const int64_t oh,
+    const int64_t ow) {
+  using opmath_t = at::opmath_type<scalar_t>;
+  const int64_t ih0 = oh * args.stride_rows - args.pad_rows;
+  const int64_t iw0 = ow * args.stride_cols - args.pad_cols;
+  const int64_t kh_begin = std::max<int64_t>(0, -ih0);
+  const int64_t kh_end = std::min(args.k_rows, args.in_rows - ih0);
+  const int64_t kw_begin = std::max<int64_t>(0, -iw0);
+  const int64_t kw_end = std::min(args.k_cols, args.in_cols - iw0);
+
+  opmath_t acc = opmath_t(0);
+  for (int64_t kh = kh_begin; kh < kh_end; ++kh) {
+    const scalar_t* const in_row = input + (ih0 + kh) * args.in_cols + iw0;
+    const scalar_t* const w_row = weight + kh * args.k_cols;
+    for (int64_t kw = kw_begin; kw < kw_end; ++kw) {
+      acc += static_cast<opmath_t>(in_row[kw]) * static_cast<opmath_t>(w_row[kw]);
+    }
+  }
+  return acc;
+}
+
+template <typename scalar_t>
+void convolution_depthwise2d_direct_impl(
+    const DirectArgs& args,
+    const scalar_t* const input,
+    const scalar_t* const weight,
+    const at::opmath_type<scalar_t> bias,
+    scalar_t* const output) {
+  for (const auto oh : c10::irange(args.out_rows)) {
+    scalar_t* const out_row = output + oh * args.out_cols;
+    for (const auto ow : c10::irange(args.out_cols)) {
+      out_row[ow] = static_cast<scalar_t>(
+          bias + depthwise2d_direct_one(args, input, weight, oh, ow));
+    }
+  }
+}
+
+// Float overload: for unit column stride, consecutive outputs read
+// consecutive input columns, so the fully in-bounds middle of each output
+// row vectorizes across output columns with one unaligned load per kernel
+// tap. Borders and the vector tail fall back to the clipped scalar path.
+void convolution_depthwise2d_direct_impl(
+    const DirectArgs& args,
+    const float* const input,
+    const float* const weight,
+    const float bias,
+    float* const output) {
+  using Vec = vec::Vectorized<float>;
+  // [ow_begin, ow_end): output columns whose every tap is in bounds.
+  int64_t ow_begin = 0;
+  int64_t ow_end = 0;
+  if (args.stride_cols == 1) {
+    ow_begin = std::min(args.pad_cols, args.out_cols);
+    ow_end = std::max(
+        ow_begin,
+        std::min(args.out_cols, args.in_cols + args.pad_cols - args.k_cols + 1));
+  }
+
+  for (const auto oh : c10::irange(args.out_rows)) {
+    float* const out_row = output + oh * args.out_cols;
+    const int64_t ih0 = oh * args.stride_rows - args.pad_rows;
+    const int64_t kh_begin = std::max<int64_t>(0, -ih0);
+    const int64_t kh_end = std::min(args.k_rows, args.in_rows - ih0);
+
+    for (const auto ow : c10::irange(ow_begin)) {
+      out_row[ow] = bias + depthwise2d_direct_one(args, input, weight, oh, ow);
+    }
+
+    int64_t ow = ow_begin;
+    const float* const in_base = input - args.pad_cols;
+    for (; ow + Vec::size() <= ow_end; ow += Vec::size()) {
+      Vec acc(bias);
+      for (int64_t kh = kh_begin; kh < kh_end; ++kh) {
+        const float* const in_row = in_base + (ih0 + kh) * args.in_cols + ow;
+        const float* const w_row = weight + kh * args.k_cols;
+        for (const auto kw : c10::irange(args.k_cols)) {
+          acc = vec::fmadd(Vec::loadu(in_row + kw), Vec(w_row[kw]), acc);
+        }
+      }
+      acc.store(out_row + ow);
+    }
+
+    for (; ow < args.out_cols; ++ow) {
+      out_row[ow] = bias + depthwise2d_direct_one(args, input, weight, oh, ow);
+    }
+  }
+}
+
+Tensor _convolution_depthwise2d_direct(
+    const Tensor & input,
+    const Tensor & kernel,
+    const Tensor & bias_potentially_undefined,
+    const IntArrayRef stride,
+    const IntArrayRef padding,
+    const int64_t groups)
+{
+  const IntArrayRef input_sizes = input.sizes();
+  const IntArrayRef kernel_sizes = kernel.sizes();
+
+  Tensor output = at::empty(
+    calculate_conv_output_size(input_sizes, kernel_sizes, stride, padding),
+    input.options());
+
+  const IntArrayRef output_sizes = output.sizes();
+
+  const DirectArgs args {
+      input_sizes[2],     // Input H
+      input_sizes[3],     // Input W
+      kernel_sizes[2],    // Kernel H
+      kernel_sizes[3],    // Kernel W
+      stride[0],          // Stride Rows
+      stride[1],          // Stride Columns
+      padding[0],         // Padding Rows
+      padding[1],         // Padding Columns
+      output_sizes[2],    // Output H
+      output_sizes[3],    // Output W
+  };
+
+  const int64_t batch = input_sizes[0];
+  const int64_t out_channels = output_sizes[1];
+  const int64_t input_hxw = args.in_rows * args.in_cols;
+  const int64_t output_hxw = args.out_rows * args.out_cols;
+  const int64_t kernel_hxw = args.k_rows * args.k_cols;
+
+  const Tensor bias = bias_potentially_undefined.defined() ?
+                      bias_potentially_undefined :
+                      at::zeros({kernel_sizes[0]}, input.options());
+
+  AT_DISPATCH_FLOATING_TYPES_AND(at::ScalarType::BFloat16,
+      input.scalar_type(), "convolution_depthwise2d_direct", [&] {
+    const scalar_t* const input_ptr = input.data_ptr<scalar_t>();
+    const scalar_t* const kernel_ptr = kernel.data_ptr<scalar_t>();
+    const scalar_t* const bias_ptr = bias.data_ptr<scalar_t>();
+    scalar_t* const output_ptr = output.data_ptr<scalar_t>();
+
+    at::parallel_for(0, batch * out_channels, 0, [&](int64_t start, int64_t end) {
+      for (const auto k : c10::irange(start, end)) {
+        const int64_t g = k % out_channels;
+        const int64_t i = k / (out_channels / groups);
+        convolution_depthwise2d_direct_impl(
+            args,
+            input_ptr + i * input_hxw,
+            kernel_ptr + g * kernel_hxw,
+            static_cast<at::opmath_type<scalar_t>>(bias_ptr[g]),
+            output_ptr + k * output_hxw);
+      }
+    });
+  });
+
+  return output;
+}
+
 }  // namespace
 
 REGISTER_DISPATCH(convolution_depthwise3x3_winograd_stub, &_convolution_depthwise3x3_winograd);
+REGISTER_DISPATCH(convolution_depthwise2d_direct_stub, &_convolution_depthwise2d_direct);
 
 }  // namespace native
 }  // namespace at
@@ -3,7 +3,9 @@
 #include <ATen/native/DispatchStub.h>
 
 /*
-  Depthwise 3x3 Winograd convolution operator
+  Depthwise convolution operators: 3x3 Winograd, and a direct kernel
+  for the remaining 2d depthwise shapes (arbitrary kernel size, stride
+  and padding)
 */
 
 namespace at {
@@ -16,5 +18,10 @@ using convolution_depthwise3x3_winograd_fn =
 
 DECLARE_DISPATCH(convolution_depthwise3x3_winograd_fn, convolution_depthwise3x3_winograd_stub);
 
+using convolution_depthwise2d_direct_fn =
+    Tensor (*)(const Tensor &, const Tensor &, const Tensor &,IntArrayRef, IntArrayRef, int64_t);
+
+DECLARE_DISPATCH(convolution_depthwise2d_direct_fn, convolution_depthwise2d_direct_stub);
+
 }  // namespace native
 }  // namespace at
@@ -2,11 +2,14 @@
 #include <ATen/CPUGeneratorImpl.h>
 #include <ATen/Dispatch.h>
 #include <ATen/Generator.h>
+#include <ATen/Parallel.h>
 #include <ATen/core/DistributionsHelper.h>
+#include <ATen/core/PhiloxRNGEngine.h>
 #include <ATen/native/Distributions.h>
 #include <ATen/native/cpu/DistributionTemplates.h>
 
 #include <ATen/native/UnaryOps.h>
+#include <c10/util/irange.h>
 
 #ifndef AT_PER_OPERATOR_HEADERS
 #include <ATen/Functions.h>
@@ -26,6 +29,68 @@
 namespace at { namespace native {
 namespace {
 
+// Note [Philox batch fills]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+// The default fill path draws from the generator's mt19937 engine one value
+// at a time on a single thread, which makes large uniform/normal/bernoulli
+// fills generator-bound. For big contiguous float/double outputs we instead
+// take the generator lock exactly once to draw a 64-bit seed, then fill in
+// parallel from a counter-based Philox stream: element i reads from its own
+// 128-bit counter block (every distribution below consumes at most four
+// 32-bit outputs per element), so the result is deterministic for a given
+// seed regardless of how parallel_for splits the range. Seeding from the
+// generator keeps consecutive fills on distinct streams and advances the
+// generator state, but the values produced for a given torch seed differ
+// from the old serial mt19937 path.
+
+// Member-function adapter so the at:: distribution helpers can sample from a
+// philox_engine positioned at a fixed counter.
+struct PhiloxCpuEngine {
+  PhiloxCpuEngine(uint64_t seed, uint64_t offset)
+      : engine_(seed, 0, offset) {}
+
+  uint32_t random() {
+    return engine_();
+  }
+
+  uint64_t random64() {
+    const uint64_t lo = engine_();
+    return lo | (static_cast<uint64_t>(engine_()) << 32);
+  }
+
+ private:
+  at::Philox4_32_10 engine_;
+};
+
+bool philox_fill_applicable(const TensorBase& self) {
+  return self.numel() >= at::internal::GRAIN_SIZE && self.is_contiguous() &&
+      (self.scalar_type() == kFloat || self.scalar_type() == kDouble);
+}
+
+bool philox_fill_applicable(TensorIteratorBase& iter) {
+  return iter.numel() >= at::internal::GRAIN_SIZE && iter.ntensors() == 1 &&
+      iter.is_contiguous() &&
+      (iter.dtype() == kFloat || iter.dtype() == kDouble);
+}
+
+uint64_t philox_fill_seed(CPUGeneratorImpl* generator) {
+  // See Note [Acquire lock when using random generators]
+  std::lock_guard<std::mutex> lock(generator->mutex_);
+  return generator->random64();
+}
+
+template <typename scalar_t, typename dist_t>
+void philox_fill(scalar_t* data, int64_t numel, uint64_t seed, dist_t dist) {
+  at::parallel_for(
+      0, numel, at::internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+        auto chunk_dist = dist;
+        for (const auto i : c10::irange(begin, end)) {
+          PhiloxCpuEngine engine(seed, static_cast<uint64_t>(i));
+          data[i] = static_cast<scalar_t>(chunk_dist(&engine));
+        }
+      });
+}
+
 static void cauchy_kernel(TensorIteratorBase& iter, double median, double sigma, c10::optional<Generator> gen) {
   CPUGeneratorImpl* generator = get_generator_or_default<CPUGeneratorImpl>(gen, detail::getDefaultCPUGenerator());
   templates::cpu::cauchy_kernel(iter, median, sigma, generator);
@@ -38,6 +103,14 @@ void bernoulli_tensor_kernel(const TensorBase &self, const TensorBase &p_, c10::
 
 void bernoulli_scalar_kernel_default(const TensorBase &self, double p, c10::optional<Generator> gen) {
   CPUGeneratorImpl* generator = get_generator_or_default<CPUGeneratorImpl>(gen, detail::getDefaultCPUGenerator());
+  if (philox_fill_applicable(self)) {
+    const uint64_t seed = philox_fill_seed(generator);
+    AT_DISPATCH_FLOATING_TYPES(self.scalar_type(), "bernoulli_philox_cpu", [&]() {
+      at::bernoulli_distribution<double> bernoulli(p);
+      philox_fill(self.data_ptr<scalar_t>(), self.numel(), seed, bernoulli);
+    });
+    return;
+  }
   templates::cpu::bernoulli_kernel(self, p, generator);
 }
 
@@ -120,11 +193,33 @@ static void log_normal_kernel(TensorIteratorBase& iter, double mean, double std,
 
 void uniform_kernel(TensorIteratorBase& iter, double from, double to, c10::optional<Generator> gen) {
   CPUGeneratorImpl* generator = get_generator_or_default<CPUGeneratorImpl>(gen, detail::getDefaultCPUGenerator());
+  if (philox_fill_applicable(iter)) {
+    const uint64_t seed = philox_fill_seed(generator);
+    AT_DISPATCH_FLOATING_TYPES(iter.dtype(), "uniform_philox_cpu", [&]() {
+      at::uniform_real_distribution<scalar_t> uniform(from, to);
+      philox_fill(
+          static_cast<scalar_t*>(iter.data_ptr(0)),
+          iter.numel(),
+          seed,
+          uniform);
+    });
+    return;
+  }
   templates::cpu::uniform_kernel(iter, from, to, generator);
 }
 
 void normal_kernel(const TensorBase &self, double mean, double std, c10::optional<Generator> gen) {
   CPUGeneratorImpl* generator = get_generator_or_default<CPUGeneratorImpl>(gen, detail::getDefaultCPUGenerator());
+  if (philox_fill_applicable(self)) {
+    const uint64_t seed = philox_fill_seed(generator);
+    AT_DISPATCH_FLOATING_TYPES(self.scalar_type(), "normal_philox_cpu", [&]() {
+      // PhiloxCpuEngine has no Box-Muller cache, so each element draws its
+      // own pair of uniforms and stays within one counter block.
+      at::normal_distribution<scalar_t> normal(mean, std);
+      philox_fill(self.data_ptr<scalar_t>(), self.numel(), seed, normal);
+    });
+    return;
+  }
   templates::cpu::normal_kernel(self, mean, std, generator);
 }
 
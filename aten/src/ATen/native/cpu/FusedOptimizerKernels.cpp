@@ -0,0 +1,190 @@
+#define TORCH_ASSERT_ONLY_METHOD_OPERATORS
+#include <ATen/native/FusedOptimizerOps.h>
+
+#include <ATen/Dispatch.h>
+#include <ATen/core/Tensor.h>
+#include <ATen/cpu/vec/vec.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace at {
+namespace native {
+namespace {
+
+// The tail of each tensor is handled with partial loads/stores
+// (`loadu(ptr, count)`), so the whole update stays in the vector loop.
+
+template <typename scalar_t>
+void adam_math(
+    scalar_t* param,
+    const scalar_t* grad,
+    scalar_t* exp_avg,
+    scalar_t* exp_avg_sq,
+    scalar_t* max_exp_avg_sq,
+    int64_t n,
+    double step,
+    double lr,
+    double beta1,
+    double beta2,
+    double weight_decay,
+    double eps,
+    bool amsgrad,
+    bool maximize,
+    ADAM_MODE mode) {
+  using Vec = vec::Vectorized<scalar_t>;
+  const Vec beta1_vec(static_cast<scalar_t>(beta1));
+  const Vec beta1_complement_vec(static_cast<scalar_t>(1 - beta1));
+  const Vec beta2_vec(static_cast<scalar_t>(beta2));
+  const Vec beta2_complement_vec(static_cast<scalar_t>(1 - beta2));
+  const Vec weight_decay_vec(static_cast<scalar_t>(weight_decay));
+  const Vec eps_vec(static_cast<scalar_t>(eps));
+  const Vec bias_correction2_sqrt_vec(
+      static_cast<scalar_t>(std::sqrt(1 - std::pow(beta2, step))));
+  const Vec step_size_vec(
+      static_cast<scalar_t>(lr / (1 - std::pow(beta1, step))));
+  // AdamW decouples weight decay from the gradient; see Loshchilov & Hutter.
+  const Vec adamw_decay_vec(static_cast<scalar_t>(1 - lr * weight_decay));
+
+  for (int64_t d = 0; d < n; d += Vec::size()) {
+    const auto count = std::min<int64_t>(Vec::size(), n - d);
+    Vec p = Vec::loadu(param + d, count);
+    Vec g = Vec::loadu(grad + d, count);
+    if (maximize) {
+      g = g.neg();
+    }
+    if (weight_decay != 0) {
+      if (mode == ADAM_MODE::ADAMW) {
+        p = p * adamw_decay_vec;
+      } else {
+        g = g + p * weight_decay_vec;
+      }
+    }
+    Vec m =
+        Vec::loadu(exp_avg + d, count) * beta1_vec + g * beta1_complement_vec;
+    Vec v = Vec::loadu(exp_avg_sq + d, count) * beta2_vec +
+        g * g * beta2_complement_vec;
+    m.store(exp_avg + d, count);
+    v.store(exp_avg_sq + d, count);
+    Vec denom_src = v;
+    if (amsgrad) {
+      denom_src = vec::maximum(Vec::loadu(max_exp_avg_sq + d, count), v);
+      denom_src.store(max_exp_avg_sq + d, count);
+    }
+    Vec denom = denom_src.sqrt() / bias_correction2_sqrt_vec + eps_vec;
+    p = p - step_size_vec * m / denom;
+    p.store(param + d, count);
+  }
+}
+
+void fused_adam_kernel(
+    const Tensor& param,
+    const Tensor& grad,
+    const Tensor& exp_avg,
+    const Tensor& exp_avg_sq,
+    const Tensor& max_exp_avg_sq,
+    double step,
+    double lr,
+    double beta1,
+    double beta2,
+    double weight_decay,
+    double eps,
+    bool amsgrad,
+    bool maximize,
+    ADAM_MODE mode) {
+  AT_DISPATCH_FLOATING_TYPES(param.scalar_type(), "fused_adam_kernel", [&] {
+    adam_math<scalar_t>(
+        param.data_ptr<scalar_t>(),
+        grad.data_ptr<scalar_t>(),
+        exp_avg.data_ptr<scalar_t>(),
+        exp_avg_sq.data_ptr<scalar_t>(),
+        amsgrad ? max_exp_avg_sq.data_ptr<scalar_t>() : nullptr,
+        param.numel(),
+        step,
+        lr,
+        beta1,
+        beta2,
+        weight_decay,
+        eps,
+        amsgrad,
+        maximize,
+        mode);
+  });
+}
+
+template <typename scalar_t>
+void sgd_math(
+    scalar_t* param,
+    const scalar_t* grad,
+    scalar_t* momentum_buf,
+    int64_t n,
+    double weight_decay,
+    double momentum,
+    double lr,
+    double dampening,
+    bool nesterov,
+    bool maximize,
+    bool is_first_step) {
+  using Vec = vec::Vectorized<scalar_t>;
+  const Vec weight_decay_vec(static_cast<scalar_t>(weight_decay));
+  const Vec momentum_vec(static_cast<scalar_t>(momentum));
+  const Vec dampening_complement_vec(static_cast<scalar_t>(1 - dampening));
+  const Vec lr_vec(static_cast<scalar_t>(lr));
+
+  for (int64_t d = 0; d < n; d += Vec::size()) {
+    const auto count = std::min<int64_t>(Vec::size(), n - d);
+    Vec p = Vec::loadu(param + d, count);
+    Vec g = Vec::loadu(grad + d, count);
+    if (maximize) {
+      g = g.neg();
+    }
+    if (weight_decay != 0) {
+      g = g + p * weight_decay_vec;
+    }
+    if (momentum != 0) {
+      Vec buf = is_first_step
+          ? g
+          : Vec::loadu(momentum_buf + d, count) * momentum_vec +
+              g * dampening_complement_vec;
+      buf.store(momentum_buf + d, count);
+      g = nesterov ? g + buf * momentum_vec : buf;
+    }
+    p = p - lr_vec * g;
+    p.store(param + d, count);
+  }
+}
+
+void fused_sgd_kernel(
+    const Tensor& param,
+    const Tensor& grad,
+    const Tensor& momentum_buf,
+    double weight_decay,
+    double momentum,
+    double lr,
+    double dampening,
+    bool nesterov,
+    bool maximize,
+    bool is_first_step) {
+  AT_DISPATCH_FLOATING_TYPES(param.scalar_type(), "fused_sgd_kernel", [&] {
+    sgd_math<scalar_t>(
+        param.data_ptr<scalar_t>(),
+        grad.data_ptr<scalar_t>(),
+        momentum != 0 ? momentum_buf.data_ptr<scalar_t>() : nullptr,
+        param.numel(),
+        weight_decay,
+        momentum,
+        lr,
+        dampening,
+        nesterov,
+        maximize,
+        is_first_step);
+  });
+}
+
+} // namespace
+
+REGISTER_DISPATCH(fused_adam_stub, &fused_adam_kernel);
+REGISTER_DISPATCH(fused_sgd_stub, &fused_sgd_kernel);
+
+} // namespace native
+} // namespace at
@@ -4,6 +4,7 @@
 #include <ATen/core/TensorBase.h>
 #include <ATen/Dispatch.h>
 #include <ATen/Parallel.h>
+#include <ATen/ParallelGrainTuner.h>
 #include <ATen/TensorGeometry.h>
 #include <ATen/TensorIterator.h>
 #include <ATen/cpu/vec/vec.h>
@@ -12,6 +13,9 @@
 
 #include <algorithm>
 #include <cstring>
+#include <list>
+#include <memory>
+#include <mutex>
 #include <type_traits>
 
 namespace at { namespace native { namespace {
@@ -1143,6 +1147,210 @@ static inline void grid_sample_2d_grid_slice_iterator(
   }
 }
 
+// ~~~~~~~~~~~~~~~~~~~~~~~~ Compiled grid fast path ~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// NOTE [ Compiled grid sampling ]
+//
+// Warping workloads (e.g. optical flow) call grid_sampler with the very same
+// grid for every frame pair, yet the kernel above redoes the per-pixel
+// coordinate math (unnormalize, clip/reflect, weight computation) on every
+// call. For the bilinear 2-d forward case we can instead precompute, per
+// output pixel, the four source offsets and bilinear weights once, after
+// which each call is a pure gather+FMA sweep over the input planes.
+//
+// A grid is considered "the same" when its storage address, version counter
+// (bumped on every in-place mutation), geometry and sampling flags all match;
+// a small sample of grid values is folded into the key as well so that a
+// freshly allocated grid reusing a dead grid's storage does not sneak in with
+// a matching version. The table is only built the *second* time a grid is
+// seen, so one-shot grids do not pay for compilation. Out-of-bound neighbors
+// are baked into the table as weight zero (offset zero), which makes the
+// sampling sweep branch-free and padding-mode agnostic.
+//
+// The coordinate math below mirrors the scalar implementation in
+// GridSampler.cpp, so compiled results may differ from the vectorized kernel
+// by the usual ulp-level discrepancies that already exist between those two
+// paths.
+
+constexpr size_t kCompiledGridProbeSize = 8;
+// An entry costs ~32 bytes per output pixel; cap the table size so the cache
+// cannot grow past a couple hundred MB even for large batched grids.
+constexpr int64_t kCompiledGridMaxNumel = int64_t(1) << 22;
+
+template <typename scalar_t>
+struct CompiledGrid2d {
+  // Key.
+  const void* grid_data;
+  uint32_t grid_version;
+  bool grid_tracks_version;
+  std::array<scalar_t, kCompiledGridProbeSize> grid_probe;
+  int64_t N, inp_H, inp_W, inp_sH, inp_sW;
+  int64_t out_H, out_W;
+  std::array<int64_t, 4> grid_strides;
+  GridSamplerPadding padding;
+  bool align_corners;
+
+  // Table, interleaved per pixel: [n][h * out_W + w][4]. Built lazily once
+  // the grid has been seen twice. Out-of-bound taps have weight 0.
+  std::vector<int32_t> offsets;
+  std::vector<scalar_t> weights;
+
+  bool compiled() const {
+    return !weights.empty();
+  }
+
+  void compile(const TensorAccessor<scalar_t, 4>& grid_acc) {
+    auto table_size = N * out_H * out_W;
+    offsets.resize(table_size * 4);
+    weights.resize(table_size * 4);
+    int64_t p = 0;
+    for (const auto n : c10::irange(N)) {
+      auto grid_slice = grid_acc[n];
+      for (const auto h : c10::irange(out_H)) {
+        for (const auto w : c10::irange(out_W)) {
+          scalar_t ix = grid_sampler_compute_source_index(
+              grid_slice[h][w][0], inp_W, padding, align_corners);
+          scalar_t iy = grid_sampler_compute_source_index(
+              grid_slice[h][w][1], inp_H, padding, align_corners);
+
+          int64_t ix_nw = static_cast<int64_t>(std::floor(ix));
+          int64_t iy_nw = static_cast<int64_t>(std::floor(iy));
+          scalar_t dx = ix - ix_nw;
+          scalar_t dy = iy - iy_nw;
+
+          const int64_t xs[4] = {ix_nw, ix_nw + 1, ix_nw, ix_nw + 1};
+          const int64_t ys[4] = {iy_nw, iy_nw, iy_nw + 1, iy_nw + 1};
+          const scalar_t ws[4] = {
+              (1 - dx) * (1 - dy), dx * (1 - dy), (1 - dx) * dy, dx * dy};
+          for (const auto k : c10::irange(4)) {
+            if (within_bounds_2d(ys[k], xs[k], inp_H, inp_W)) {
+              offsets[p] = static_cast<int32_t>(ys[k] * inp_sH + xs[k] * inp_sW);
+              weights[p] = ws[k];
+            } else {
+              offsets[p] = 0;
+              weights[p] = 0;
+            }
+            p++;
+          }
+        }
+      }
+    }
+  }
+};
+
+template <typename scalar_t>
+bool compiled_grid_key_matches(
+    const CompiledGrid2d<scalar_t>& entry,
+    const CompiledGrid2d<scalar_t>& key) {
+  return entry.grid_data == key.grid_data &&
+      entry.grid_version == key.grid_version &&
+      entry.grid_tracks_version == key.grid_tracks_version &&
+      entry.grid_probe == key.grid_probe && entry.N == key.N &&
+      entry.inp_H == key.inp_H && entry.inp_W == key.inp_W &&
+      entry.inp_sH == key.inp_sH && entry.inp_sW == key.inp_sW &&
+      entry.out_H == key.out_H && entry.out_W == key.out_W &&
+      entry.grid_strides == key.grid_strides &&
+      entry.padding == key.padding &&
+      entry.align_corners == key.align_corners;
+}
+
+// Returns a compiled table for `grid`, or nullptr when the fast path does not
+// apply (first sighting, unsupported geometry, or table too large).
+template <typename scalar_t>
+std::shared_ptr<const CompiledGrid2d<scalar_t>> try_compile_grid_2d(
+    const TensorBase& input,
+    const TensorBase& grid,
+    const TensorAccessor<scalar_t, 4>& grid_acc,
+    GridSamplerPadding padding,
+    bool align_corners) {
+  CompiledGrid2d<scalar_t> key;
+  key.N = grid.size(0);
+  key.inp_H = input.size(2);
+  key.inp_W = input.size(3);
+  key.inp_sH = input.stride(2);
+  key.inp_sW = input.stride(3);
+  key.out_H = grid.size(1);
+  key.out_W = grid.size(2);
+  if (key.N * key.out_H * key.out_W > kCompiledGridMaxNumel) {
+    return nullptr;
+  }
+  // Offsets are stored as int32 for table compactness.
+  if ((key.inp_H - 1) * key.inp_sH + (key.inp_W - 1) * key.inp_sW >
+      std::numeric_limits<int32_t>::max()) {
+    return nullptr;
+  }
+  auto* grid_impl = grid.unsafeGetTensorImpl();
+  key.grid_data = grid_impl->data();
+  key.grid_tracks_version = !grid_impl->is_inference();
+  key.grid_version =
+      key.grid_tracks_version ? grid_impl->version_counter().current_version() : 0;
+  // Probe the four corners of the first grid slice.
+  size_t probe_idx = 0;
+  for (int64_t h : {int64_t(0), key.out_H - 1}) {
+    for (int64_t w : {int64_t(0), key.out_W - 1}) {
+      key.grid_probe[probe_idx++] = grid_acc[0][h][w][0];
+      key.grid_probe[probe_idx++] = grid_acc[0][h][w][1];
+    }
+  }
+  key.grid_strides = {grid.stride(0), grid.stride(1), grid.stride(2), grid.stride(3)};
+  key.padding = padding;
+  key.align_corners = align_corners;
+
+  using Entry = std::shared_ptr<CompiledGrid2d<scalar_t>>;
+  static std::mutex mutex;
+  static std::list<Entry> cache;  // most recently used first
+  constexpr size_t kCacheCapacity = 2;
+
+  std::lock_guard<std::mutex> guard(mutex);
+  for (auto it = cache.begin(); it != cache.end(); ++it) {
+    if (compiled_grid_key_matches(**it, key)) {
+      auto entry = *it;
+      cache.splice(cache.begin(), cache, it);
+      if (!entry->compiled()) {
+        // Second sighting: the grid is being reused, build the table.
+        entry->compile(grid_acc);
+      }
+      return entry;
+    }
+  }
+  cache.emplace_front(std::make_shared<CompiledGrid2d<scalar_t>>(std::move(key)));
+  while (cache.size() > kCacheCapacity) {
+    cache.pop_back();
+  }
+  return nullptr;
+}
+
+template <typename scalar_t>
+void compiled_grid_sampler_2d(
+    const TensorBase& output,
+    const TensorBase& input,
+    const CompiledGrid2d<scalar_t>& cg) {
+  auto out_acc = output.accessor<scalar_t, 4>();
+  auto inp_acc = input.accessor<scalar_t, 4>();
+  int64_t C = input.size(1);
+  int64_t spatial_size = cg.out_H * cg.out_W;
+  auto grain_size = at::divup(at::internal::GRAIN_SIZE, spatial_size * 4);
+  parallel_for_tuned(
+      "grid_sampler_2d_compiled", 0, cg.N * C, grain_size,
+      [&](int64_t begin, int64_t end) {
+    for (const auto nc : c10::irange(begin, end)) {
+      auto n = nc / C;
+      auto c = nc % C;
+      const scalar_t* inp_plane = inp_acc[n][c].data();
+      scalar_t* out_plane = out_acc[n][c].data();
+      const int32_t* off = cg.offsets.data() + n * spatial_size * 4;
+      const scalar_t* wgt = cg.weights.data() + n * spatial_size * 4;
+      for (const auto p : c10::irange(spatial_size)) {
+        auto t = p * 4;
+        out_plane[p] = wgt[t] * inp_plane[off[t]] +
+            wgt[t + 1] * inp_plane[off[t + 1]] +
+            wgt[t + 2] * inp_plane[off[t + 2]] +
+            wgt[t + 3] * inp_plane[off[t + 3]];
+      }
+    }
+  });
+}
+
 // ~~~~~~~~~~~~~~~~~~~~~~~~~ Grid Sample Kernels ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 // Use the structs & functions defined above to calculate grid sample forward
 // and backward.
@@ -1192,6 +1400,18 @@ void grid_sampler_2d_cpu_kernel_impl(
     auto out_acc = output.accessor<scalar_t, 4>();
     auto inp_acc = input.accessor<scalar_t, 4>();
     auto grid_acc = grid.accessor<scalar_t, 4>();
+    if (static_cast<GridSamplerInterpolation>(interpolation_mode) ==
+            GridSamplerInterpolation::Bilinear &&
+        spatial_size > 0) {
+      // See NOTE [ Compiled grid sampling ].
+      auto compiled = try_compile_grid_2d<scalar_t>(
+          input, grid, grid_acc,
+          static_cast<GridSamplerPadding>(padding_mode), align_corners);
+      if (compiled) {
+        compiled_grid_sampler_2d<scalar_t>(output, input, *compiled);
+        return;
+      }
+    }
     if (align_corners) {
       switch (static_cast<GridSamplerInterpolation>(interpolation_mode)) {
         HANDLE_INTERP(GridSamplerInterpolation::Bilinear, true);
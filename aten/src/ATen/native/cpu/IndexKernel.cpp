@@ -1,8 +1,10 @@
 #define TORCH_ASSERT_NO_OPERATORS
 #include <ATen/native/IndexKernel.h>
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <vector>
 
 #include <ATen/Context.h>
 #include <ATen/Dispatch.h>
@@ -150,6 +152,64 @@ void take_kernel(
     });
 }
 
+// Deterministic parallel accumulation for index_put_: materialize the
+// destination address of every update, split the destination address range
+// into per-thread bins, and let each thread apply, in global element order,
+// only the updates that land in its bin. Bins are conflict-free by
+// construction, and every destination sees its updates in the same order as
+// the serial kernel, so the result is bitwise identical to serial execution
+// regardless of the number of threads. Each thread re-scans the (sequential,
+// cache-friendly) address array, but the random-access accumulations - the
+// dominant cost - are split across cores.
+template <typename scalar_t, typename func_t>
+void cpu_index_kernel_accumulate_binned(
+    TensorIterator& iter,
+    IntArrayRef index_size,
+    IntArrayRef index_stride,
+    const func_t& f) {
+  const int ntensor = iter.ntensors();
+  const int64_t numel = iter.numel();
+  if (numel == 0) {
+    return;
+  }
+  std::vector<intptr_t> addrs(numel);
+  at::parallel_for(0, numel, internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+    int64_t cursor = begin;
+    auto loop = [&](char** data, const int64_t* strides, int64_t n) {
+      auto indexer = Indexer(ntensor - 2, &data[2], &strides[2], index_size, index_stride);
+      char* dst = data[0];
+      for (const auto i : c10::irange(n)) {
+        addrs[cursor++] =
+            reinterpret_cast<intptr_t>(dst + strides[0] * i) + indexer.get(i);
+      }
+    };
+    iter.serial_for_each(loop, {begin, end});
+  });
+
+  const auto minmax = std::minmax_element(addrs.begin(), addrs.end());
+  const intptr_t min_addr = *minmax.first;
+  const int64_t span = *minmax.second - min_addr + 1;
+  const int64_t num_bins = std::min<int64_t>(at::get_num_threads(), span);
+  const int64_t bin_size = divup(span, num_bins);
+  at::parallel_for(0, num_bins, 1, [&](int64_t bin_begin, int64_t bin_end) {
+    const intptr_t lo = min_addr + bin_begin * bin_size;
+    const intptr_t hi = min_addr + bin_end * bin_size;
+    int64_t cursor = 0;
+    auto loop = [&](char** data, const int64_t* strides, int64_t n) {
+      char* dst = data[0];
+      char* src = data[1];
+      for (const auto i : c10::irange(n)) {
+        const intptr_t addr = addrs[cursor++];
+        if (addr >= lo && addr < hi) {
+          char* dst_i = dst + strides[0] * i;
+          f(dst_i, src + strides[1] * i, addr - reinterpret_cast<intptr_t>(dst_i));
+        }
+      }
+    };
+    iter.serial_for_each(loop, {0, numel});
+  });
+}
+
 void index_put_kernel(TensorIterator& iter, IntArrayRef index_size, IntArrayRef index_stride, bool accumulate) {
   // NOTE: duplicate indices are only supported if accumulate is true.
   AT_DISPATCH_ALL_TYPES_AND_COMPLEX_AND4(kComplexHalf, kHalf, kBool, kBFloat16,
@@ -159,15 +219,25 @@ void index_put_kernel(TensorIterator& iter, IntArrayRef index_size, IntArrayRef
     // must enable serial execution if deterministic algorithms are enabled.
     const bool is_deterministic = at::globalContext().deterministicAlgorithms();
     if (accumulate) {
-      bool use_parallel_for = (!is_deterministic) && (
-        (iter.numel() >= internal::GRAIN_SIZE) && (at::get_num_threads() > 1));
+      bool parallel_worthwhile =
+        (iter.numel() >= internal::GRAIN_SIZE) && (at::get_num_threads() > 1);
+      bool use_parallel_for = (!is_deterministic) && parallel_worthwhile;
+      // The binned kernel is deterministic, so it may be used even when
+      // deterministic algorithms are requested.
+      bool use_deterministic_parallel_for = parallel_worthwhile;
       if (use_parallel_for && iter.dtype() == ScalarType::Float) {
         cpu_index_kernel<float>(iter, index_size, index_stride, [](char* dst, char* src, int64_t offset) {
           cpu_atomic_add_float((float*)(dst + offset), *(float*)src);
         });
+      } else if (use_deterministic_parallel_for) {
+        // Conflict-free binned accumulation: parallel, yet bitwise
+        // identical to the serial kernel, so it stays safe when
+        // deterministic algorithms are enabled.
+        cpu_index_kernel_accumulate_binned<scalar_t>(iter, index_size, index_stride,
+            [](char* dst, char* src, int64_t offset) {
+          *(scalar_t*)(dst + offset) += *(scalar_t*)src;
+        });
       } else {
-        // TODO: investigate parallelization of the accumulate kernel. Unlike the non-accumulate case,
-        // this needs to be thread-safe.
         cpu_index_kernel<scalar_t>(iter, index_size, index_stride, [](char* dst, char* src, int64_t offset) {
           *(scalar_t*)(dst + offset) += *(scalar_t*)src;
         }, /*serial_execution=*/true);
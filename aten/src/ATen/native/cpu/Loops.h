@@ -35,6 +35,7 @@
 #include <ATen/native/TensorIterator.h>
 #include <ATen/native/TensorIteratorDynamicCasting.h>
 #include <ATen/cpu/vec/vec.h>
+#include <c10/core/DynamicCast.h>
 
 #ifndef _MSC_VER
 #pragma GCC diagnostic push
@@ -193,11 +194,54 @@ multiple_outputs_loop(char* C10_RESTRICT data[], const int64_t* strides_, int64_
   }
 }
 
+// [Note: bf16 vectorized loop]
+// BFloat16 kernels may pair a scalar functor on BFloat16 with a vector
+// functor written in terms of Vectorized<float>.  In that case the
+// vectorized loop below loads bf16 vectors, widens each one to a pair of
+// float vectors, applies the float functor to both halves and narrows on
+// the store.  This converts once per vector instead of once per element
+// (the cpu_kernel fallback) or once per arithmetic op (what chained
+// Vectorized<BFloat16> math does).
+template <typename func_t, typename vec_func_t>
+struct is_bfloat16_float_op
+    : std::integral_constant<
+          bool,
+          std::is_same<
+              typename function_traits<func_t>::result_type,
+              BFloat16>::value &&
+              std::is_same<
+                  typename function_traits<vec_func_t>::result_type,
+                  Vectorized<float>>::value> {};
+
+template <typename vec_func_t, std::size_t... INDEX>
+static inline Vectorized<BFloat16> apply_bfloat16_as_float_impl(
+    vec_func_t&& vop,
+    const Vectorized<BFloat16>* inputs,
+    std::index_sequence<INDEX...>) {
+  std::tuple<Vectorized<float>, Vectorized<float>> widened[sizeof...(INDEX)] =
+      {convert_bfloat16_float(inputs[INDEX])...};
+  auto out0 = vop(std::get<0>(widened[INDEX])...);
+  auto out1 = vop(std::get<1>(widened[INDEX])...);
+  return convert_float_bfloat16(out0, out1);
+}
+
+template <typename vec_func_t>
+static inline Vectorized<BFloat16> apply_bfloat16_as_float(
+    vec_func_t&& vop,
+    const Vectorized<BFloat16>* inputs) {
+  using Indices =
+      std::make_index_sequence<function_traits<vec_func_t>::arity>;
+  return apply_bfloat16_as_float_impl(
+      std::forward<vec_func_t>(vop), inputs, Indices{});
+}
+
 // Explicitly vectorized loop implementation. All inputs and outputs must be
 // the same type and contiguous with one exception: a single input may be
 // a scalar (stride 0). It's position is indicated by the argument `S`. If `S`
 // is 0, then there are no scalar inputs.
-template <typename func_t, typename vec_func_t>
+template <typename func_t, typename vec_func_t,
+    typename std::enable_if<
+        !is_bfloat16_float_op<func_t, vec_func_t>::value, int>::type = 0>
 static inline void
 vectorized_loop(char** C10_RESTRICT data_, int64_t n, int64_t S, func_t&& op, vec_func_t&& vop) {
   using traits = function_traits<vec_func_t>;
@@ -229,6 +273,194 @@ vectorized_loop(char** C10_RESTRICT data_, int64_t n, int64_t S, func_t&& op, ve
   }
 }
 
+// BFloat16 fast path, see [Note: bf16 vectorized loop] above.  A single
+// bf16 vector spans two float vectors, so each iteration covers the same
+// number of elements as one unrolled step of the generic loop.
+template <typename func_t, typename vec_func_t,
+    typename std::enable_if<
+        is_bfloat16_float_op<func_t, vec_func_t>::value, int>::type = 0>
+static inline void
+vectorized_loop(char** C10_RESTRICT data_, int64_t n, int64_t S, func_t&& op, vec_func_t&& vop) {
+  using traits = function_traits<vec_func_t>;
+  using scalar_t = BFloat16;
+  using Vec = Vectorized<scalar_t>;
+  constexpr int ntensors = traits::arity + 1;
+
+  char* C10_RESTRICT data[ntensors];
+  for (const auto arg : c10::irange(ntensors)) {
+    data[arg] = data_[arg];
+  }
+
+  Vec opt_scalar = Vec(S > 0 ? *(scalar_t*)data[S] : scalar_t(0));
+  int64_t i = 0;
+  for (; i <= n - Vec::size(); i += Vec::size()) {
+    Vec inputs[traits::arity];
+    for (const auto arg : c10::irange(ntensors - 1)) {
+      inputs[arg] = (S > 0 && arg + 1 == S)
+          ? opt_scalar
+          : Vec::loadu(data[arg + 1] + i * sizeof(scalar_t));
+    }
+    auto out = apply_bfloat16_as_float(vop, inputs);
+    out.store(data[0] + i * sizeof(scalar_t));
+  }
+  if (i < n) {
+    int64_t strides[ntensors];
+    for (const auto arg : c10::irange(ntensors)) {
+      strides[arg] = (S > 0 && arg == S) ? 0 : sizeof(scalar_t);
+    }
+    basic_loop(data, strides, i, n, std::forward<func_t>(op));
+  }
+}
+
+// [Note: dynamic casting on CPU]
+// When the operand dtypes do not match the functor's argument and result
+// types, CUDA pushes the conversion into the kernel with fetch_and_cast /
+// cast_and_store (see TensorIteratorDynamicCasting.h).  The loops below do
+// the same on CPU so that cpu_kernel and cpu_kernel_vec keep working --
+// and, for contiguous data, keep their vectorization -- instead of
+// asserting.  The vectorized variant converts whole chunks at a time with
+// vec::convert (which has intrinsic implementations for the common
+// mixed-precision pairs) and runs the unmodified vectorized loop over a
+// small stack buffer in the functor's compute type.
+
+template <typename traits, std::size_t... INDEX>
+typename traits::ArgsTuple
+dereference_cast_impl(char* C10_RESTRICT data[], const int64_t* strides,
+                      const ScalarType* dtypes, int64_t i,
+                      std::index_sequence<INDEX...>) {
+  return std::make_tuple(
+      c10::fetch_and_cast<typename traits::template arg<INDEX>::type>(
+          dtypes[INDEX], data[INDEX] + i * strides[INDEX])...);
+}
+
+template <typename traits>
+typename traits::ArgsTuple
+dereference_cast(char* C10_RESTRICT data[], const int64_t* strides,
+                 const ScalarType* dtypes, int64_t i) {
+  using Indices = std::make_index_sequence<traits::arity>;
+  return dereference_cast_impl<traits>(data, strides, dtypes, i, Indices{});
+}
+
+// Strided loop with per-element dynamic casting.  Only the relative order
+// of loads and stores differs from basic_loop; the strides are the byte
+// strides of the actual operands, so they already account for the
+// mismatched element sizes.
+template <typename func_t>
+static inline void
+cast_basic_loop(char* C10_RESTRICT data[], const int64_t* strides_,
+                const ScalarType* dtypes, int64_t i, int64_t n, func_t&& op) {
+  using traits = function_traits<func_t>;
+  using result_type = typename traits::result_type;
+  constexpr int ntensors = traits::arity + 1;
+
+  // Copying strides to temporary array helps auto vectorization in older GCC
+  // versions.
+  int64_t strides[ntensors];
+  for (const auto arg : c10::irange(ntensors)) {
+    strides[arg] = strides_[arg];
+  }
+
+  for (; i < n; i++) {
+    result_type result = c10::guts::apply(std::forward<func_t>(op),
+        dereference_cast<traits>(
+            &data[1],
+            &strides[1],
+            &dtypes[1],
+            i));
+    c10::cast_and_store<result_type>(dtypes[0], data[0] + i * strides[0], result);
+  }
+}
+
+template <typename scalar_t>
+using cast_load_fn = void (*)(const char* src, scalar_t* dst, int64_t n);
+
+template <typename scalar_t>
+using cast_store_fn = void (*)(const scalar_t* src, char* dst, int64_t n);
+
+template <typename scalar_t, typename memory_t>
+static void cast_load(const char* src, scalar_t* dst, int64_t n) {
+  vec::convert(reinterpret_cast<const memory_t*>(src), dst, n);
+}
+
+template <typename scalar_t, typename memory_t>
+static void cast_store(const scalar_t* src, char* dst, int64_t n) {
+  vec::convert(src, reinterpret_cast<memory_t*>(dst), n);
+}
+
+// Resolve the dynamic dtype of an operand to a conversion routine once,
+// outside the loop, instead of switching on it per element.
+template <typename scalar_t>
+static cast_load_fn<scalar_t> pick_cast_load(ScalarType src_type) {
+  switch (src_type) {
+#define CAST_LOAD_CASE(type, scalartype) \
+  case ScalarType::scalartype:           \
+    return &cast_load<scalar_t, type>;
+    AT_FORALL_SCALAR_TYPES_WITH_COMPLEX(CAST_LOAD_CASE)
+#undef CAST_LOAD_CASE
+    default:
+      TORCH_CHECK(false, "Unexpected scalar type");
+  }
+  return nullptr; // just to avoid compiler warning
+}
+
+template <typename scalar_t>
+static cast_store_fn<scalar_t> pick_cast_store(ScalarType dest_type) {
+  switch (dest_type) {
+#define CAST_STORE_CASE(type, scalartype) \
+  case ScalarType::scalartype:            \
+    return &cast_store<scalar_t, type>;
+    AT_FORALL_SCALAR_TYPES_WITH_COMPLEX(CAST_STORE_CASE)
+#undef CAST_STORE_CASE
+    default:
+      TORCH_CHECK(false, "Unexpected scalar type");
+  }
+  return nullptr; // just to avoid compiler warning
+}
+
+// Contiguous loop with vectorized dynamic casting, see
+// [Note: dynamic casting on CPU].  Inputs are widened chunk-wise into
+// stack buffers of the compute type, the regular vectorized loop runs over
+// the buffers, and the result chunk is narrowed on the way out.
+template <typename func_t, typename vec_func_t>
+static inline void
+cast_vectorized_loop(char** C10_RESTRICT data_, int64_t n, const ScalarType* dtypes,
+                     func_t&& op, vec_func_t&& vop) {
+  using traits = function_traits<func_t>;
+  using scalar_t = typename traits::result_type;
+  using Vec = Vectorized<scalar_t>;
+  constexpr int ntensors = traits::arity + 1;
+  // A few vectors per operand amortizes the indirect conversion calls
+  // without the buffers spilling out of L1.
+  constexpr int64_t kChunk = 4 * Vec::size();
+
+  char* C10_RESTRICT data[ntensors];
+  int64_t element_sizes[ntensors];
+  for (const auto arg : c10::irange(ntensors)) {
+    data[arg] = data_[arg];
+    element_sizes[arg] = static_cast<int64_t>(c10::elementSize(dtypes[arg]));
+  }
+
+  cast_load_fn<scalar_t> loads[ntensors > 1 ? ntensors - 1 : 1];
+  for (const auto arg : c10::irange(ntensors - 1)) {
+    loads[arg] = pick_cast_load<scalar_t>(dtypes[arg + 1]);
+  }
+  cast_store_fn<scalar_t> store = pick_cast_store<scalar_t>(dtypes[0]);
+
+  __at_align__ scalar_t buffers[ntensors][kChunk];
+  char* buffer_ptrs[ntensors];
+  for (const auto arg : c10::irange(ntensors)) {
+    buffer_ptrs[arg] = reinterpret_cast<char*>(buffers[arg]);
+  }
+
+  for (int64_t i = 0; i < n; i += kChunk) {
+    int64_t m = std::min(kChunk, n - i);
+    for (const auto arg : c10::irange(ntensors - 1)) {
+      loads[arg](data[arg + 1] + i * element_sizes[arg + 1], buffers[arg + 1], m);
+    }
+    vectorized_loop(buffer_ptrs, m, 0, op, vop);
+    store(buffers[0], data[0] + i * element_sizes[0], m);
+  }
+}
 
 template <typename traits, typename cb_t>
 static inline void unroll_contiguous_scalar_checks(
@@ -306,14 +538,114 @@ VectorizedLoop2d<op_t, vop_t> make_vectorized_loop2d(
   return VectorizedLoop2d<op_t, vop_t>(op, vop);
 }
 
+// Analog of VectorizedLoop2d for iterators that need dynamic casting, see
+// [Note: dynamic casting on CPU].  Contiguity has to be checked against
+// the element sizes of the actual operand dtypes rather than the functor's
+// types, so the static is_contiguous checks don't apply here.  Scalar
+// broadcast operands and other stride patterns take the per-element
+// casting loop.
+template <typename op_t, typename vop_t>
+struct CastVectorizedLoop2d {
+  op_t op;
+  vop_t vop;
+
+  using traits = function_traits<op_t>;
+  static constexpr int ntensors = traits::arity + 1;
+  using data_t = std::array<char*, ntensors>;
+
+  std::array<ScalarType, ntensors> dtypes;
+
+  CastVectorizedLoop2d(const op_t &op, const vop_t &vop,
+                       const std::array<ScalarType, ntensors> &dtypes):
+    op(op), vop(vop), dtypes(dtypes) {}
+
+  static void advance(data_t &data, const int64_t *outer_strides) {
+    for (const auto arg : c10::irange(data.size())) {
+      data[arg] += outer_strides[arg];
+    }
+  }
+
+  bool is_contiguous_for_dtypes(const int64_t* strides) const {
+    for (const auto arg : c10::irange(ntensors)) {
+      if (strides[arg] != static_cast<int64_t>(c10::elementSize(dtypes[arg]))) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void operator()(char** base, const int64_t *strides, int64_t size0, int64_t size1) {
+    data_t data;
+    std::copy_n(base, ntensors, data.data());
+    const int64_t *outer_strides = &strides[ntensors];
+
+    if (is_contiguous_for_dtypes(strides)) {
+      for (const auto i : c10::irange(size1)) {
+        (void)i;
+        cast_vectorized_loop(data.data(), size0, dtypes.data(), op, vop);
+        advance(data, outer_strides);
+      }
+    } else {
+      for (const auto i : c10::irange(size1)) {
+        (void)i;
+        cast_basic_loop(data.data(), strides, dtypes.data(), 0, size0, op);
+        advance(data, outer_strides);
+      }
+    }
+  }
+};
+
+template <typename op_t, typename vop_t>
+CastVectorizedLoop2d<op_t, vop_t> make_cast_vectorized_loop2d(
+    const op_t &op, const vop_t &vop,
+    const std::array<ScalarType, function_traits<op_t>::arity + 1> &dtypes) {
+  return CastVectorizedLoop2d<op_t, vop_t>(op, vop, dtypes);
+}
+
+template <int ntensors>
+static std::array<ScalarType, ntensors> operand_dtypes(TensorIteratorBase& iter) {
+  std::array<ScalarType, ntensors> dtypes;
+  for (const auto arg : c10::irange(ntensors)) {
+    dtypes[arg] = iter.dtype(arg);
+  }
+  return dtypes;
+}
+
+// Fallback for mixed-dtype operands, see [Note: dynamic casting on CPU].
+// Only reachable for functors with an output; a void-returning functor has
+// nothing to cast, so its operand dtypes must already match.
+template <typename func_t,
+    typename std::enable_if<!std::is_void<typename function_traits<func_t>::result_type>::value, int>::type = 0>
+void cpu_kernel_cast(TensorIteratorBase& iter, func_t&& op, int64_t grain_size) {
+  using traits = function_traits<func_t>;
+  constexpr int ntensors = traits::arity + 1;
+  auto dtypes = operand_dtypes<ntensors>(iter);
+
+  iter.for_each([&](char** data, const int64_t* strides, int64_t n) {
+    cast_basic_loop(data, strides, dtypes.data(), 0, n, op);
+  }, grain_size);
+  iter.cast_outputs();
+}
+
+template <typename func_t,
+    typename std::enable_if<std::is_void<typename function_traits<func_t>::result_type>::value, int>::type = 0>
+void cpu_kernel_cast(TensorIteratorBase& /*iter*/, func_t&& /*op*/, int64_t /*grain_size*/) {
+  TORCH_INTERNAL_ASSERT(false,
+      "dynamic casting is not supported for void-returning CPU kernels");
+}
+
 template <typename func_t>
 void cpu_kernel(TensorIteratorBase& iter, func_t&& op, int64_t grain_size = at::internal::GRAIN_SIZE) {
   using traits = function_traits<func_t>;
   // this could be extended to work with void return types
   TORCH_INTERNAL_ASSERT(iter.ninputs() == traits::arity);
   TORCH_INTERNAL_ASSERT(iter.noutputs() == 1);
-  // dynamic casting not currently supported on CPU
-  TORCH_INTERNAL_ASSERT(!needs_dynamic_casting<func_t>::check(iter));
+  if (needs_dynamic_casting<func_t>::check(iter)) {
+    // Mismatched operand dtypes: convert on every load and store instead,
+    // like the CUDA loops do.
+    cpu_kernel_cast(iter, std::forward<func_t>(op), grain_size);
+    return;
+  }
 
   iter.for_each([&](char** data, const int64_t* strides, int64_t n) {
     // basic loop can handle 1d slices with arbitrary strides, and 1d slices is all that
@@ -349,13 +681,39 @@ void cpu_kernel_vec(TensorIteratorBase& iter, func_t&& op, vec_func_t&& vop, int
   // this could be extended to work with void return types
   TORCH_INTERNAL_ASSERT(iter.ninputs() == traits::arity);
   TORCH_INTERNAL_ASSERT(iter.noutputs() == 1);
-  // dynamic casting not currently supported on CPU, but some kernels (like Fill)
-  // explicitly dynamic_cast, so we give the opt-out of checking.
+  // Some kernels (like Fill) explicitly dynamic_cast themselves, so we give
+  // the opt-out of checking for it.
+  bool dynamic_casting = false;
   c10::guts::if_constexpr<check_dynamic_cast>([&] {
-    TORCH_INTERNAL_ASSERT(!needs_dynamic_casting<func_t>::check(iter));
+    dynamic_casting = needs_dynamic_casting<func_t>::check(iter);
   });
+  if (dynamic_casting) {
+    // Mismatched operand dtypes: convert on load and store inside the loop,
+    // see [Note: dynamic casting on CPU].
+    constexpr int ntensors = traits::arity + 1;
+    auto dtypes = operand_dtypes<ntensors>(iter);
+    iter.for_each(make_cast_vectorized_loop2d(op, vop, dtypes), grain_size);
+    iter.cast_outputs();
+    return;
+  }
 
-  iter.for_each(make_vectorized_loop2d(op, vop), grain_size);
+  // Small contiguous tensors spend a measurable fraction of their time in
+  // the generic 2d dispatch (stride buffer setup in serial_for_each plus the
+  // per-call contiguity re-checks in VectorizedLoop2d). When the iterator
+  // has already coalesced to a single contiguous dimension and the work is
+  // below the parallel grain, jump straight into the specialized contiguous
+  // loop stamped for this op/dtype instantiation.
+  const int64_t numel = iter.numel();
+  if (numel > 0 && numel <= grain_size && iter.is_contiguous()) {
+    constexpr int ntensors = traits::arity + 1;
+    std::array<char*, ntensors> data;
+    for (const auto arg : c10::irange(ntensors)) {
+      data[arg] = reinterpret_cast<char*>(iter.data_ptr(arg));
+    }
+    vectorized_loop(data.data(), numel, 0, std::forward<func_t>(op), std::forward<vec_func_t>(vop));
+  } else {
+    iter.for_each(make_vectorized_loop2d(op, vop), grain_size);
+  }
   iter.cast_outputs();
 }
 
@@ -365,7 +723,8 @@ void cpu_serial_kernel(TensorIteratorBase& iter, func_t&& op, const Range& range
   constexpr bool result_void = std::is_void<typename traits::result_type>::value;
   TORCH_INTERNAL_ASSERT(iter.ninputs() == traits::arity &&
                         ((result_void && iter.noutputs() == 0) || (!result_void && iter.noutputs() == 1)));
-  // dynamic casting not currently supported on CPU
+  // dynamic casting not currently supported in the serial kernels,
+  // see [Note: dynamic casting on CPU]
   TORCH_INTERNAL_ASSERT(!needs_dynamic_casting<func_t>::check(iter));
 
   iter.serial_for_each([&](char** data, const int64_t* strides, int64_t n) {
@@ -385,7 +744,8 @@ void cpu_serial_kernel_vec(TensorIteratorBase& iter, func_t&& op, vec_func_t&& v
   // this could be extended to work with void return types
   TORCH_INTERNAL_ASSERT(iter.ninputs() == traits::arity);
   TORCH_INTERNAL_ASSERT(iter.noutputs() == 1);
-  // dynamic casting not currently supported on CPU
+  // dynamic casting not currently supported in the serial kernels,
+  // see [Note: dynamic casting on CPU]
   TORCH_INTERNAL_ASSERT(!needs_dynamic_casting<func_t>::check(iter));
 
   iter.serial_for_each(make_vectorized_loop2d(op, vop), range);
@@ -0,0 +1,271 @@
+#include <ATen/ATen.h>
+#include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/native/MaskPacking.h>
+#include <ATen/native/cpu/Intrinsics.h>
+#include <c10/util/irange.h>
+#include <c10/util/llvmMathExtras.h>
+
+#include <cstring>
+#include <vector>
+
+namespace at {
+namespace native {
+namespace {
+
+// Note [Bitpacked boolean masks]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Bool tensors spend one byte per element; for masking-heavy workloads
+// the packed layout (bit i of byte j = element 8 * j + i, padding bits
+// zero) cuts mask memory and bandwidth 8x. The pack kernel's AVX2 path
+// turns 32 bools into 4 mask bytes with a single cmpgt/movemask, and
+// unpack inverts it with a shuffle/bit-test; movemask's bit order is
+// exactly the LSB-first layout, so no reshuffling is needed. The
+// reductions and masked_select walk the bitmap with popcount/ctz, so
+// they touch 1/8 of the bytes a bool mask would. Elementwise and/or/
+// xor of packed masks need no kernels at all: they are bitwise ops on
+// the uint8 bitmaps.
+
+constexpr int64_t kPackedChunkBytes = 4096; // 32768 mask elements
+
+// Reads len (< 8) bytes at p into the low bytes of a uint64_t.
+inline uint64_t load_tail_word(const uint8_t* p, int64_t len) {
+  uint64_t word = 0;
+  std::memcpy(&word, p, len);
+  return word;
+}
+
+// The mask byte for 8 bool bytes: bit i = p[i] != 0.
+inline uint8_t pack_8(const uint8_t* p) {
+  uint8_t byte = 0;
+  for (const auto i : c10::irange(8)) {
+    byte |= static_cast<uint8_t>((p[i] != 0 ? 1 : 0) << i);
+  }
+  return byte;
+}
+
+void pack_bool_bits_kernel(Tensor& result, const Tensor& self) {
+  const uint8_t* src = reinterpret_cast<const uint8_t*>(self.data_ptr<bool>());
+  uint8_t* dst = result.data_ptr<uint8_t>();
+  const int64_t numel = self.numel();
+  const int64_t full_bytes = numel / 8;
+
+  parallel_for(
+      0, full_bytes, internal::GRAIN_SIZE / 8, [&](int64_t begin, int64_t end) {
+        int64_t j = begin;
+#ifdef CPU_CAPABILITY_AVX2
+        const __m256i zero = _mm256_setzero_si256();
+        for (; j + 4 <= end; j += 4) {
+          const __m256i v = _mm256_loadu_si256(
+              reinterpret_cast<const __m256i*>(src + j * 8));
+          const uint32_t mask = static_cast<uint32_t>(
+              _mm256_movemask_epi8(_mm256_cmpgt_epi8(v, zero)));
+          std::memcpy(dst + j, &mask, 4);
+        }
+#endif
+        for (; j < end; ++j) {
+          dst[j] = pack_8(src + j * 8);
+        }
+      });
+
+  if (numel % 8 != 0) {
+    uint8_t byte = 0;
+    for (const auto i : c10::irange(numel % 8)) {
+      byte |= static_cast<uint8_t>((src[full_bytes * 8 + i] != 0 ? 1 : 0) << i);
+    }
+    dst[full_bytes] = byte;
+  }
+}
+
+void unpack_bool_bits_kernel(
+    Tensor& result,
+    const Tensor& self,
+    int64_t numel) {
+  const uint8_t* src = self.data_ptr<uint8_t>();
+  uint8_t* dst = reinterpret_cast<uint8_t*>(result.data_ptr<bool>());
+  const int64_t full_bytes = numel / 8;
+
+  parallel_for(
+      0, full_bytes, internal::GRAIN_SIZE / 8, [&](int64_t begin, int64_t end) {
+        int64_t j = begin;
+#ifdef CPU_CAPABILITY_AVX2
+        // Inverse movemask: replicate 4 mask bytes across the vector,
+        // pick byte k / 8 into lane k, test bit k % 8 there.
+        const __m256i byte_select = _mm256_setr_epi8(
+            0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1,
+            2, 2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3);
+        const __m256i bit_select = _mm256_setr_epi8(
+            1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128,
+            1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+        const __m256i one = _mm256_set1_epi8(1);
+        for (; j + 4 <= end; j += 4) {
+          uint32_t mask = 0;
+          std::memcpy(&mask, src + j, 4);
+          const __m256i bytes = _mm256_shuffle_epi8(
+              _mm256_set1_epi32(static_cast<int>(mask)), byte_select);
+          const __m256i bits =
+              _mm256_cmpeq_epi8(_mm256_and_si256(bytes, bit_select), bit_select);
+          _mm256_storeu_si256(
+              reinterpret_cast<__m256i*>(dst + j * 8),
+              _mm256_and_si256(bits, one));
+        }
+#endif
+        for (; j < end; ++j) {
+          for (const auto i : c10::irange(8)) {
+            dst[j * 8 + i] = (src[j] >> i) & 1;
+          }
+        }
+      });
+
+  for (const auto i : c10::irange(full_bytes * 8, numel)) {
+    dst[i] = (src[i / 8] >> (i % 8)) & 1;
+  }
+}
+
+void packed_bool_not_kernel(
+    Tensor& result,
+    const Tensor& self,
+    int64_t numel) {
+  const uint8_t* src = self.data_ptr<uint8_t>();
+  uint8_t* dst = result.data_ptr<uint8_t>();
+  const int64_t num_bytes = self.numel();
+
+  parallel_for(
+      0, num_bytes, internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+        for (const auto j : c10::irange(begin, end)) {
+          dst[j] = static_cast<uint8_t>(~src[j]);
+        }
+      });
+  // Re-zero the padding bits of the last byte.
+  if (numel % 8 != 0) {
+    dst[num_bytes - 1] &= static_cast<uint8_t>((1u << (numel % 8)) - 1);
+  }
+}
+
+bool packed_bool_any_kernel(const Tensor& self, int64_t numel) {
+  // The padding bits are zero by invariant, so this is a plain nonzero
+  // scan over the bytes, blocked for early exit.
+  const uint8_t* src = self.data_ptr<uint8_t>();
+  const int64_t num_bytes = self.numel();
+  for (int64_t start = 0; start < num_bytes; start += kPackedChunkBytes) {
+    const int64_t len = std::min(kPackedChunkBytes, num_bytes - start);
+    uint64_t acc = 0;
+    int64_t j = 0;
+    for (; j + 8 <= len; j += 8) {
+      uint64_t word = 0;
+      std::memcpy(&word, src + start + j, 8);
+      acc |= word;
+    }
+    acc |= load_tail_word(src + start + j, len - j);
+    if (acc != 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool packed_bool_all_kernel(const Tensor& self, int64_t numel) {
+  const uint8_t* src = self.data_ptr<uint8_t>();
+  const int64_t full_bytes = numel / 8;
+  for (int64_t start = 0; start < full_bytes; start += kPackedChunkBytes) {
+    const int64_t len = std::min(kPackedChunkBytes, full_bytes - start);
+    uint64_t acc = ~uint64_t(0);
+    int64_t j = 0;
+    for (; j + 8 <= len; j += 8) {
+      uint64_t word = 0;
+      std::memcpy(&word, src + start + j, 8);
+      acc &= word;
+    }
+    if (acc != ~uint64_t(0)) {
+      return false;
+    }
+    for (; j < len; ++j) {
+      if (src[start + j] != 0xff) {
+        return false;
+      }
+    }
+  }
+  if (numel % 8 != 0) {
+    return src[full_bytes] == static_cast<uint8_t>((1u << (numel % 8)) - 1);
+  }
+  return true;
+}
+
+// The number of set bits in mask[0, len) bytes.
+int64_t popcount_bytes(const uint8_t* mask, int64_t len) {
+  int64_t n = 0;
+  int64_t j = 0;
+  for (; j + 8 <= len; j += 8) {
+    uint64_t word = 0;
+    std::memcpy(&word, mask + j, 8);
+    n += c10::llvm::countPopulation(word);
+  }
+  n += c10::llvm::countPopulation(load_tail_word(mask + j, len - j));
+  return n;
+}
+
+template <typename scalar_t>
+void packed_masked_select_impl(
+    Tensor& result,
+    const Tensor& self,
+    const Tensor& mask) {
+  const scalar_t* src = self.data_ptr<scalar_t>();
+  const uint8_t* bits = mask.data_ptr<uint8_t>();
+  const int64_t num_bytes = mask.numel();
+
+  // Same two-pass scheme as _byte_find: per-chunk popcounts, an
+  // exclusive scan into output offsets, then a parallel fill walking
+  // each chunk's set bits with ctz.
+  const int64_t num_chunks = divup(num_bytes, kPackedChunkBytes);
+  std::vector<int64_t> offsets(num_chunks + 1, 0);
+  parallel_for(0, num_chunks, 1, [&](int64_t begin, int64_t end) {
+    for (const auto chunk : c10::irange(begin, end)) {
+      const int64_t start = chunk * kPackedChunkBytes;
+      const int64_t len = std::min(kPackedChunkBytes, num_bytes - start);
+      offsets[chunk + 1] = popcount_bytes(bits + start, len);
+    }
+  });
+  for (const auto chunk : c10::irange(num_chunks)) {
+    offsets[chunk + 1] += offsets[chunk];
+  }
+
+  result.resize_({offsets[num_chunks]});
+  scalar_t* out = result.data_ptr<scalar_t>();
+  parallel_for(0, num_chunks, 1, [&](int64_t begin, int64_t end) {
+    for (const auto chunk : c10::irange(begin, end)) {
+      const int64_t start = chunk * kPackedChunkBytes;
+      const int64_t len = std::min(kPackedChunkBytes, num_bytes - start);
+      scalar_t* chunk_out = out + offsets[chunk];
+      for (const auto j : c10::irange(start, start + len)) {
+        uint32_t byte = bits[j];
+        while (byte != 0) {
+          const int64_t bit = c10::llvm::countTrailingZeros(byte);
+          *chunk_out++ = src[j * 8 + bit];
+          byte &= byte - 1;
+        }
+      }
+    }
+  });
+}
+
+void packed_masked_select_kernel(
+    Tensor& result,
+    const Tensor& self,
+    const Tensor& mask) {
+  AT_DISPATCH_ALL_TYPES_AND_COMPLEX_AND3(
+      kHalf, kBFloat16, kBool, self.scalar_type(), "_packed_masked_select", [&] {
+        packed_masked_select_impl<scalar_t>(result, self, mask);
+      });
+}
+
+} // anonymous namespace
+
+REGISTER_DISPATCH(pack_bool_bits_stub, &pack_bool_bits_kernel);
+REGISTER_DISPATCH(unpack_bool_bits_stub, &unpack_bool_bits_kernel);
+REGISTER_DISPATCH(packed_bool_not_stub, &packed_bool_not_kernel);
+REGISTER_DISPATCH(packed_bool_any_stub, &packed_bool_any_kernel);
+REGISTER_DISPATCH(packed_bool_all_stub, &packed_bool_all_kernel);
+REGISTER_DISPATCH(packed_masked_select_stub, &packed_masked_select_kernel);
+
+} // namespace native
+} // namespace at
@@ -423,9 +423,19 @@ void cpu_max_pool_backward_channels_last(
   int64_t output_height = grad_output.size(2);
   int64_t output_width = grad_output.size(3);
 
-  // parallel on dim N
-  at::parallel_for(0, nbatch, 0, [&](int64_t begin, int64_t end) {
-    for (const auto n : c10::irange(begin, end)) {
+  // The scatter target for channel c is maxindex * channels + c, so
+  // gradients for different channels never collide and the channel
+  // dimension can be split across threads. Parallel on {N, C-tiles}
+  // to get scaling beyond the batch size; the tiles are large enough
+  // that false sharing at tile borders is negligible.
+  constexpr int64_t CHANNEL_TILE = 128;
+  int64_t num_tiles = divup(channels, CHANNEL_TILE);
+  at::parallel_for(0, nbatch * num_tiles, 0, [&](int64_t begin, int64_t end) {
+    for (const auto i : c10::irange(begin, end)) {
+      int64_t n = i / num_tiles;
+      int64_t c0 = (i % num_tiles) * CHANNEL_TILE;
+      int64_t c1 = std::min(c0 + CHANNEL_TILE, channels);
+
       scalar_t* grad_input_ptr = grad_input_data + n * input_height * input_width * channels;
       scalar_t* grad_output_ptr = grad_output_data + n * output_height * output_width * channels;
       int64_t* indices_ptr = indices_data + n * output_height * output_width * channels;
@@ -435,7 +445,7 @@ void cpu_max_pool_backward_channels_last(
           scalar_t* gout = grad_output_ptr + oh * output_width * channels + ow * channels;
           int64_t* ind = indices_ptr + oh * output_width * channels + ow * channels;
           // TODO: gcc vectorization
-          for (const auto c : c10::irange(channels)) {
+          for (const auto c : c10::irange(c0, c1)) {
             int64_t maxindex = ind[c];
             if (maxindex != -1) {
               grad_input_ptr[maxindex * channels + c] += gout[c];
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <ATen/native/cpu/Loops.h>
+#include <ATen/MapAllocator.h>
 #include <ATen/Parallel.h>
 #include <c10/util/TypeList.h>
 #include <c10/core/Scalar.h>
@@ -8,6 +9,10 @@
 
 #include <sstream>
 
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
 namespace at { namespace native { inline namespace CPU_CAPABILITY {
 
 using namespace vec;
@@ -91,6 +96,28 @@ static inline void vectorized_inner_reduction(char** data, int64_t n, func_t op,
   basic_loop(ptrs, strides, count * 4 * Vec::size(), n, op);
 }
 
+// [Note: page-aware outer reduction]
+// When the reduced dimension has a large stride, every row of a column
+// block lives on its own page, and walking all size0 rows per column
+// block cycles through size0 page translations -- far more than the
+// dTLB holds once the input outgrows memory-resident sizes.  Column
+// blocks of the same rows are adjacent bytes, though, so we tile the
+// rows into blocks small enough that their translations stay resident
+// and sweep the full width for one row block before advancing to the
+// next.  The block size is half a typical 64-entry L1 dTLB, leaving
+// room for the output and for translations the other threads need.
+// Rows closer together than a page already share translations, so they
+// are not tiled.
+constexpr int64_t kPageSize = 4096;
+constexpr int64_t kRowsPerPageBlock = 32;
+
+static inline int64_t outer_reduction_row_block(int64_t size0, int64_t inner_stride) {
+  if (inner_stride < kPageSize) {
+    return size0;
+  }
+  return std::min(size0, kRowsPerPageBlock);
+}
+
 // computes the reduction out = op(out, in)
 template <typename func_t, typename vec_func_t>
 static inline void vectorized_outer_reduction(char** data, int64_t inner_stride, int64_t size0, int64_t size1, func_t op, vec_func_t vop) {
@@ -102,18 +129,46 @@ static inline void vectorized_outer_reduction(char** data, int64_t inner_stride,
 #else
   int64_t outer_stride[2] = { 128, 128 };
 #endif
-  UNARY_OUTER_LOOP(data, outer_stride, size1 / (4 * Vec::size()), [&] {
-    vectorized_reduction(data, size0, inner_stride, op, vop, /*reduce=*/false);
-  });
+  const int64_t row_block = outer_reduction_row_block(size0, inner_stride);
+  for (int64_t row = 0; row < size0; row += row_block) {
+    const int64_t rows = std::min(row_block, size0 - row);
+    char* block_data[2] = { data[0], data[1] + row * inner_stride };
+    UNARY_OUTER_LOOP(block_data, outer_stride, size1 / (4 * Vec::size()), [&] {
+      vectorized_reduction(block_data, rows, inner_stride, op, vop, /*reduce=*/false);
+    });
 
-  // reduce down the remaining columns
-  int64_t step[] = { sizeof(scalar_t), sizeof(scalar_t) };
-  int64_t remaining = size1 % (4 * Vec::size());
-  UNARY_OUTER_LOOP(data, step, remaining, [&] {
-    char* ptrs[3] = { data[0], data[0], data[1] };
-    int64_t strides[] = { 0, 0, inner_stride };
-    basic_loop(ptrs, strides, 0, size0, op);
-  });
+    // reduce down the remaining columns
+    int64_t step[] = { sizeof(scalar_t), sizeof(scalar_t) };
+    int64_t remaining = size1 % (4 * Vec::size());
+    UNARY_OUTER_LOOP(block_data, step, remaining, [&] {
+      char* ptrs[3] = { block_data[0], block_data[0], block_data[1] };
+      int64_t strides[] = { 0, 0, inner_stride };
+      basic_loop(ptrs, strides, 0, rows, op);
+    });
+  }
+}
+
+// Inputs backed by an mmap'd storage (shared memory or from_file tensors)
+// fault their pages in on first touch, which serializes a strided
+// reduction behind one page-sized read per row.  Advise the kernel to
+// read the mapping ahead of the walk; for ordinary in-memory storages
+// this is a no-op.
+static inline void mapped_reduction_readahead(TensorIteratorBase& iter) {
+#if defined(__linux__)
+  for (int arg = iter.noutputs(); arg < iter.ntensors(); arg++) {
+    const auto& input = iter.tensor_base(arg);
+    if (!input.has_storage()) {
+      continue;
+    }
+    auto* allocator = at::MapAllocator::fromDataPtr(input.storage().data_ptr());
+    if (allocator == nullptr || allocator->data() == nullptr) {
+      continue;
+    }
+    madvise(allocator->data(), allocator->size(), MADV_WILLNEED);
+  }
+#else
+  (void)iter;
+#endif
 }
 
 template<typename traits, typename res_t>
@@ -210,6 +265,7 @@ void binary_kernel_reduce(TensorIteratorBase& iter, ops_t ops, init_t init) {
     "the accumulate type must be default-constructible"
   );
   const int num_outputs = iter.noutputs();
+  mapped_reduction_readahead(iter);
   iter.foreach_reduced_elt([&ops, &init, num_outputs](TensorIteratorBase &sub_iter) {
     auto reduction_body = [&ops, &sub_iter, num_outputs](acc_t acc, int64_t begin, int64_t end) -> acc_t {
       int ntensors = sub_iter.ntensors();
@@ -262,6 +318,7 @@ void binary_kernel_reduce_vec(TensorIteratorBase& iter, func_t op, vec_func_t vo
     "all types must match");
 
   iter.output_base().fill_(ident);
+  mapped_reduction_readahead(iter);
   iter.parallel_reduce([&](char** data, const int64_t* strides, int64_t size0, int64_t size1) {
     int64_t outer_strides[] = { strides[2], strides[3] };
     if (is_contiguous_reduction<traits>(strides)) {
@@ -3,6 +3,7 @@
 
 #include <ATen/core/Tensor.h>
 #include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
 #include <ATen/cpu/vec/vec.h>
 #include <ATen/cpu/vec/functional.h>
 #include <ATen/native/ReduceOps.h>
@@ -18,6 +19,8 @@
 #include <ATen/ops/imag.h>
 #endif
 
+#include <ATen/native/cpu/moments_utils.h>
+
 #include <c10/util/Optional.h>
 #include <c10/util/irange.h>
 #include <ATen/AccumulateType.h>
@@ -75,11 +78,101 @@ static inline void cpu_cum_base_kernel(const Tensor& result,
   iter.for_each(loop);
 }
 
+constexpr int64_t kScanBlockSize = at::internal::GRAIN_SIZE;
+
+// Whether to scan `dim` with the blocked parallel kernel below: the scanned
+// dimension must be contiguous and long, with too few rows for the per-row
+// parallelism of cpu_cum_base_kernel to occupy the thread pool.
+static bool is_blocked_scan_candidate(
+    const Tensor& result,
+    const Tensor& self,
+    int64_t dim,
+    int64_t dim_size) {
+  if (!self.is_contiguous() || !result.is_contiguous() ||
+      result.sizes() != self.sizes() || dim != self.dim() - 1) {
+    return false;
+  }
+  const int64_t num_rows = self.numel() / dim_size;
+  return dim_size >= 2 * kScanBlockSize && num_rows < at::get_num_threads();
+}
+
+// Blocked parallel scan over a long contiguous scan dimension. Each block
+// computes its local inclusive scan in parallel, a serial pass combines the
+// block totals into exclusive carries, and a second parallel pass folds each
+// block's carry into its entries. The fold is the only stage of a scan that
+// vectorizes cleanly, so it is supplied per op and uses Vectorized where the
+// combine supports it.
+template <typename scalar_t, typename combine_t, typename fold_t>
+static inline void cpu_cum_blocked_scan_kernel(
+    const Tensor& result,
+    const Tensor& self,
+    int64_t dim_size,
+    const combine_t& combine,
+    const fold_t& fold,
+    scalar_t init_val) {
+  using acc_t = at::acc_type<scalar_t, false>;
+  const scalar_t* self_data = self.data_ptr<scalar_t>();
+  scalar_t* result_data = result.data_ptr<scalar_t>();
+  const int64_t num_rows = self.numel() / dim_size;
+  const int64_t num_blocks = (dim_size + kScanBlockSize - 1) / kScanBlockSize;
+  std::vector<acc_t> carries(num_blocks);
+
+  for (const auto row : c10::irange(num_rows)) {
+    const scalar_t* row_self = self_data + row * dim_size;
+    scalar_t* row_result = result_data + row * dim_size;
+
+    at::parallel_for(0, num_blocks, 1, [&](int64_t begin, int64_t end) {
+      for (const auto block : c10::irange(begin, end)) {
+        const int64_t block_begin = block * kScanBlockSize;
+        const int64_t block_end =
+            std::min(block_begin + kScanBlockSize, dim_size);
+        auto acc = static_cast<acc_t>(init_val);
+        for (const auto i : c10::irange(block_begin, block_end)) {
+          acc = combine(acc, static_cast<acc_t>(row_self[i]));
+          row_result[i] = static_cast<scalar_t>(acc);
+        }
+        carries[block] = acc;
+      }
+    });
+
+    auto offset = static_cast<acc_t>(init_val);
+    for (const auto block : c10::irange(num_blocks)) {
+      const auto total = carries[block];
+      carries[block] = offset;
+      offset = combine(offset, total);
+    }
+
+    // Block 0 has the identity carry; its entries are already final.
+    at::parallel_for(1, num_blocks, 1, [&](int64_t begin, int64_t end) {
+      for (const auto block : c10::irange(begin, end)) {
+        const int64_t block_begin = block * kScanBlockSize;
+        const int64_t block_end =
+            std::min(block_begin + kScanBlockSize, dim_size);
+        fold(row_result + block_begin, block_end - block_begin, carries[block]);
+      }
+    });
+  }
+}
+
 static void cumsum_cpu_kernel(const Tensor& result, const Tensor& self, int64_t dim) {
   auto wrap_dim = maybe_wrap_dim(dim, self.dim());
   int64_t self_dim_size = ensure_nonempty_size(self, wrap_dim);
 
   AT_DISPATCH_ALL_TYPES_AND_COMPLEX_AND(kBFloat16, self.scalar_type(), "cumsum_out_cpu", [&] {
+    using acc_t = at::acc_type<scalar_t, false>;
+    if (is_blocked_scan_candidate(result, self, wrap_dim, self_dim_size)) {
+      cpu_cum_blocked_scan_kernel<scalar_t>(
+        result, self, self_dim_size,
+        [](acc_t acc, acc_t val) { return acc + val; },
+        [](scalar_t* out, int64_t size, acc_t offset) {
+          // map() hands BFloat16 data to the functor as Vectorized<float>.
+          using Vec = Vectorized<vec_scalar_t<scalar_t>>;
+          const Vec offset_vec(static_cast<vec_scalar_t<scalar_t>>(offset));
+          vec::map([offset_vec](Vec x) { return x + offset_vec; }, out, out, size);
+        }, /*init_val=*/ 0
+      );
+      return;
+    }
     cpu_cum_base_kernel<scalar_t>(result, self, wrap_dim, [&] (
       scalar_t* result_data, auto result_dim_stride,
       const scalar_t* self_data, auto self_dim_stride, scalar_t init_val) {
@@ -99,6 +192,19 @@ static void cumprod_cpu_kernel(const Tensor& result, const Tensor& self, int64_t
   int64_t self_dim_size = ensure_nonempty_size(self, wrap_dim);
 
   AT_DISPATCH_ALL_TYPES_AND_COMPLEX_AND(kBFloat16, self.scalar_type(), "cumprod_out_cpu", [&] {
+    using acc_t = at::acc_type<scalar_t, false>;
+    if (is_blocked_scan_candidate(result, self, wrap_dim, self_dim_size)) {
+      cpu_cum_blocked_scan_kernel<scalar_t>(
+        result, self, self_dim_size,
+        [](acc_t acc, acc_t val) { return acc * val; },
+        [](scalar_t* out, int64_t size, acc_t offset) {
+          using Vec = Vectorized<vec_scalar_t<scalar_t>>;
+          const Vec offset_vec(static_cast<vec_scalar_t<scalar_t>>(offset));
+          vec::map([offset_vec](Vec x) { return x * offset_vec; }, out, out, size);
+        }, /*init_val=*/ 1
+      );
+      return;
+    }
     cpu_cum_base_kernel<scalar_t>(result, self, wrap_dim, [&] (
       scalar_t* result_data, auto result_dim_stride,
       const scalar_t* self_data, auto self_dim_stride, scalar_t init_val) {
@@ -113,32 +219,48 @@ static void cumprod_cpu_kernel(const Tensor& result, const Tensor& self, int64_t
   });
 }
 
+// Reference : https://www.tensorflow.org/api_docs/python/tf/math/cumulative_logsumexp
+template <typename accscalar_t>
+static inline accscalar_t _log_add_exp(accscalar_t x, accscalar_t y) {
+  accscalar_t min = std::isnan(y) ? y : std::min(x,y); //std::min returns first arg if one of the args is nan
+  accscalar_t max = std::isnan(y) ? y : std::max(x,y); //std::max returns first arg if one of the args is nan
+  if (min != max || std::isfinite(min)) {
+    // nan will be propagated here
+    return std::log1p(std::exp(min - max)) + max;
+  } else {
+ // special case to correctly handle infinite cases
+    return x;
+  }
+}
+
 static void logcumsumexp_cpu_kernel(Tensor& result, const Tensor& self, int64_t dim) {
   auto wrap_dim = maybe_wrap_dim(dim, self.dim());
   int64_t self_dim_size = ensure_nonempty_size(self, wrap_dim);
 
   AT_DISPATCH_FLOATING_TYPES_AND(kBFloat16, self.scalar_type(), "logcumsumexp_out_cpu", [&] {
+    using accscalar_t = at::acc_type<scalar_t, false>;
+    if (is_blocked_scan_candidate(result, self, wrap_dim, self_dim_size)) {
+      cpu_cum_blocked_scan_kernel<scalar_t>(
+        result, self, self_dim_size,
+        [](accscalar_t acc, accscalar_t val) { return _log_add_exp(val, acc); },
+        [](scalar_t* out, int64_t size, accscalar_t offset) {
+          // log-add-exp has no Vectorized counterpart; fold scalar-wise.
+          for (const auto i : c10::irange(size)) {
+            out[i] = static_cast<scalar_t>(
+                _log_add_exp(static_cast<accscalar_t>(out[i]), offset));
+          }
+        }, /*init_val=*/ -std::numeric_limits<scalar_t>::infinity()
+      );
+      return;
+    }
     cpu_cum_base_kernel<scalar_t>(result, self, wrap_dim, [&] (
       scalar_t* result_data, auto result_dim_stride,
       const scalar_t* self_data, auto self_dim_stride, scalar_t init_val) {
-        using accscalar_t = at::acc_type<scalar_t, false>;
         auto cum_number = (accscalar_t)init_val;
         for (const auto i : c10::irange(self_dim_size)) {
           accscalar_t x = self_data[i * self_dim_stride];
 
-          // Reference : https://www.tensorflow.org/api_docs/python/tf/math/cumulative_logsumexp
-          auto log_add_exp = [](accscalar_t x, accscalar_t y) -> accscalar_t {
-            accscalar_t min = std::isnan(y) ? y : std::min(x,y); //std::min returns first arg if one of the args is nan
-            accscalar_t max = std::isnan(y) ? y : std::max(x,y); //std::max returns first arg if one of the args is nan
-            if (min != max || std::isfinite(min)) {
-              // nan will be propagated here
-              return std::log1p(std::exp(min - max)) + max;
-            } else {
-           // special case to correctly handle infinite cases
-              return x;
-            }
-          };
-          cum_number = log_add_exp(x, cum_number);
+          cum_number = _log_add_exp(x, cum_number);
           result_data[i * result_dim_stride] = static_cast<scalar_t>(cum_number);
         }
       }, /*init_val=*/ -std::numeric_limits<scalar_t>::infinity()
@@ -157,7 +279,115 @@ static void mean_kernel_impl(TensorIterator& iter) {
   });
 }
 
+// Like is_reduce_lastdim, but accounts for var_mean/std_mean iterators
+// having two outputs in front of the input operand.
+static bool is_reduce_lastdim_contiguous(TensorIteratorBase& iter) {
+  const auto in_idx = iter.noutputs();
+  return iter.num_reduce_dims() == 1 && iter.is_dim_reduced(0)
+      && iter.ninputs() == 1
+      && iter.strides(in_idx)[0] == iter.element_size(in_idx);
+}
+
+// Single-pass fused mean+var over the contiguous last dimension, using the
+// cascaded vectorized Welford core that layer_norm's statistics already rely
+// on. Writes var (or std) to the first output and, for var_mean/std_mean,
+// the mean to the second.
+template <typename scalar_t>
+static void std_var_lastdim_kernel(
+    TensorIteratorBase& iter,
+    int64_t correction,
+    bool take_sqrt) {
+  auto shape = iter.shape();
+  int64_t dim_size = shape[0];
+  int64_t grain_size = std::max((int64_t)1, at::internal::GRAIN_SIZE / dim_size);
+  const int num_outputs = iter.noutputs();
+  TensorIterator sub_iter(iter);
+  // create sub iterator to parallel on all non-reduce-dims
+  sub_iter.narrow(0, 0, 1);
+  auto loop = [&](char** data, const int64_t* strides, int64_t size) {
+    for (const auto i : c10::irange(size)) {
+      const scalar_t* self_data =
+          (const scalar_t*)(data[num_outputs] + i * strides[num_outputs]);
+      // NOLINTNEXTLINE(cppcoreguidelines-init-variables)
+      scalar_t mean, var;
+      std::tie(mean, var) =
+          utils::RowwiseMoments(self_data, dim_size, correction);
+      *(scalar_t*)(data[0] + i * strides[0]) =
+          take_sqrt ? std::sqrt(var) : var;
+      if (num_outputs == 2) {
+        *(scalar_t*)(data[1] + i * strides[1]) = mean;
+      }
+    }
+  };
+  sub_iter.for_each(loop, grain_size);
+}
+
+// Full reduction to a single element: each thread runs the cascaded
+// vectorized Welford over its chunk, and the per-thread partial moments are
+// combined pairwise with AddMoments.
+template <typename scalar_t>
+static void std_var_all_kernel(
+    TensorIteratorBase& iter,
+    int64_t correction,
+    bool take_sqrt) {
+  const int num_outputs = iter.noutputs();
+  const scalar_t* self_data = (const scalar_t*)iter.data_ptr(num_outputs);
+  const int64_t size = iter.shape()[0];
+
+  using moments_t = std::tuple<int64_t, scalar_t, scalar_t>;
+  moments_t acc = at::parallel_reduce(
+      0,
+      size,
+      at::internal::GRAIN_SIZE,
+      moments_t(0, scalar_t(0), scalar_t(0)),
+      [self_data](int64_t begin, int64_t end, moments_t ident) {
+        // NOLINTNEXTLINE(cppcoreguidelines-init-variables)
+        scalar_t m1, m2;
+        std::tie(m1, m2) = utils::RowwiseMomentsRaw(self_data + begin, end - begin);
+        utils::AddMoments(
+            end - begin, m1, m2,
+            std::get<0>(ident), std::get<1>(ident), std::get<2>(ident));
+        return ident;
+      },
+      [](moments_t a, moments_t b) {
+        utils::AddMoments(
+            std::get<0>(b), std::get<1>(b), std::get<2>(b),
+            std::get<0>(a), std::get<1>(a), std::get<2>(a));
+        return a;
+      });
+
+  const scalar_t var = std::get<2>(acc) / static_cast<scalar_t>(size - correction);
+  *(scalar_t*)iter.data_ptr(0) = take_sqrt ? std::sqrt(var) : var;
+  if (num_outputs == 2) {
+    *(scalar_t*)iter.data_ptr(1) = std::get<1>(acc);
+  }
+}
+
 static void std_var_kernel_impl(TensorIterator& iter, int64_t correction, bool take_sqrt) {
+  // The generic Welford path below reduces one scalar at a time through
+  // double accumulators. For fp32/fp64 reductions over a contiguous last
+  // dimension, the cascaded vectorized Welford in moments_utils.h is both
+  // faster and accurate enough (chunked accumulation plus a pairwise
+  // combine tree). Degenerate row lengths (empty rows, or rows shorter
+  // than the correction) keep the generic path, which already defines the
+  // nan/inf semantics for them.
+  if (is_reduce_lastdim_contiguous(iter) &&
+      iter.input_dtype() == iter.dtype(0) &&
+      (iter.input_dtype() == kFloat || iter.input_dtype() == kDouble) &&
+      iter.shape()[0] > correction) {
+    if (iter.num_output_elements() == 1) {
+      // Reducing everything into one element: parallelize over the
+      // reduction dimension itself instead of the (absent) outer dims.
+      AT_DISPATCH_FLOATING_TYPES(iter.input_dtype(), "std_cpu", [&] {
+        std_var_all_kernel<scalar_t>(iter, correction, take_sqrt);
+      });
+      return;
+    }
+    AT_DISPATCH_FLOATING_TYPES(iter.input_dtype(), "std_cpu", [&] {
+      std_var_lastdim_kernel<scalar_t>(iter, correction, take_sqrt);
+    });
+    return;
+  }
   AT_DISPATCH_FLOATING_TYPES_AND2(kHalf, kBFloat16, iter.dtype(), "std_cpu", [&] {
     binary_kernel_reduce(
         iter,
@@ -264,14 +494,33 @@ static void norm_kernel_tensor_iterator_impl(
 
           using Vec = Vectorized<scalar_t>;
           using fVec = Vectorized<acc_t>;
-          fVec acc_vec{acc_t(0)};
+          // A single accumulator serializes the reduction on the FMA latency
+          // chain; eight independent accumulators keep the FMA ports busy and
+          // are tree-combined at the end.
+          constexpr int kAccumulators = 8;
+          constexpr int64_t kBlockSize = kAccumulators * Vec::size();
+          fVec acc[kAccumulators];
+          for (const auto k : c10::irange(kAccumulators)) {
+            acc[k] = fVec(acc_t(0));
+          }
           acc_t buffer[fVec::size()];
           int64_t d = 0;
+          for (; d < size - (size % kBlockSize); d += kBlockSize) {
+            for (const auto k : c10::irange(kAccumulators)) {
+              Vec data_vec = Vec::loadu(self_data + d + k * Vec::size());
+              norm_two_reduce_step(acc[k], data_vec);
+            }
+          }
           for (; d < size - (size % Vec::size()); d += Vec::size()) {
             Vec data_vec = Vec::loadu(self_data + d);
-            norm_two_reduce_step(acc_vec, data_vec);
+            norm_two_reduce_step(acc[0], data_vec);
+          }
+          for (int step = kAccumulators / 2; step > 0; step /= 2) {
+            for (int k = 0; k < step; k++) {
+              acc[k] += acc[k + step];
+            }
           }
-          acc_vec.store(buffer);
+          acc[0].store(buffer);
           for (int j = 1; j < fVec::size(); j++) {
             buffer[0] = buffer[0] + buffer[j];
           }
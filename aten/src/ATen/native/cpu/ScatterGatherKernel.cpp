@@ -596,7 +596,72 @@ void scatter_fill_cpu_kernel(const Tensor& self, int64_t dim, const Tensor& inde
     self, dim, index, value, "scatter_fill_cpu_", tensor_assign);
 }
 
+// scatter_add over dim 0 of a 1-d tensor degenerates in the base kernel:
+// TensorIterator has a single outer element, so the whole index loop runs on
+// one thread (parallelizing it naively would both race and lose run-to-run
+// determinism). Instead, stable-sort the index into segments of equal
+// destination and reduce each segment on the thread owning its first
+// element. Within a segment the stable sort preserves original positions,
+// so the additions happen in exactly the order the serial loop performs
+// them and the result is bit-for-bit identical; distinct segments touch
+// distinct bins, so threads never contend.
+bool scatter_add_use_sorted_path(const Tensor& self, int64_t dim,
+    const Tensor& index, const Tensor& src) {
+  return dim == 0 && self.dim() == 1 && index.dim() == 1 && src.dim() == 1 &&
+      self.is_contiguous() && index.is_contiguous() && src.is_contiguous() &&
+      index.numel() >= at::internal::GRAIN_SIZE && at::get_num_threads() > 1;
+}
+
+void scatter_add_sorted_cpu_kernel(const Tensor& self, const Tensor& index, const Tensor& src) {
+  int64_t nnz = index.numel();
+  // NOLINTNEXTLINE(cppcoreguidelines-init-variables)
+  Tensor sorted_index, sort_perm;
+  std::tie(sorted_index, sort_perm) =
+      index.sort(/*stable=*/true, /*dim=*/0);
+  const int64_t* sorted_idx_p = sorted_index.data_ptr<int64_t>();
+  const int64_t* perm_p = sort_perm.data_ptr<int64_t>();
+  int64_t index_upper_bound = self.size(0);
+
+  AT_DISPATCH_ALL_TYPES_AND_COMPLEX_AND3(
+    ScalarType::Bool, ScalarType::Half, ScalarType::BFloat16, self.scalar_type(),
+    "scatter_add_sorted_", [&] {
+      scalar_t* self_p = self.data_ptr<scalar_t>();
+      const scalar_t* src_p = src.data_ptr<scalar_t>();
+      at::parallel_for(0, nnz, at::internal::GRAIN_SIZE,
+        [&](int64_t begin, int64_t end) {
+          // Segments may straddle chunk boundaries; skip a leading partial
+          // segment, it belongs to the thread that owns its first element.
+          while (begin > 0 && begin < end &&
+                 sorted_idx_p[begin] == sorted_idx_p[begin - 1]) {
+            ++begin;
+          }
+          int64_t i = begin;
+          while (i < end) {
+            int64_t idx_dim = sorted_idx_p[i];
+            // we are not putting idx_dim in the error message because it disables
+            // loop optimization in clang-7
+            TORCH_CHECK(idx_dim >= 0 && idx_dim < index_upper_bound,
+              "index ", sorted_idx_p[i],
+              " is out of bounds for dimension ", 0,
+              " with size ", index_upper_bound
+            );
+            scalar_t acc = self_p[idx_dim];
+            int64_t j = i;
+            for (; j < nnz && sorted_idx_p[j] == idx_dim; ++j) {
+              acc += src_p[perm_p[j]];
+            }
+            self_p[idx_dim] = acc;
+            i = j;
+          }
+        });
+    });
+}
+
 void scatter_add_cpu_kernel(const Tensor& self, int64_t dim, const Tensor& index, const Tensor& src) {
+  if (scatter_add_use_sorted_path(self, dim, index, src)) {
+    scatter_add_sorted_cpu_kernel(self, index, src);
+    return;
+  }
   cpu_scatter_gather_base_kernel<>()(
     self, dim, index, src,
     "scatter_add_", reduce_add);
@@ -721,6 +721,282 @@ struct vec_softmax {
   }
 };
 
+// NB: fast kernel for softmax/log_softmax backward when dim != -1, using the
+// same blocking scheme as _vec_logsoftmax above: shapes are normalized to
+// {outer_size, dim_size, inner_size} and inner_size is chunked so that a
+// {dim_size, CHUNK_SIZE} block of columns stays cache resident while the
+// vertical sum reduction and the update pass stream over it with contiguous
+// vector loads.
+template <bool LogSoftMax, typename scalar_t>
+inline void _vec_softmax_backward(
+    scalar_t* grad_input_data_base,
+    scalar_t* grad_output_data_base,
+    scalar_t* output_data_base,
+    int64_t outer_size,
+    int64_t inner_size,
+    int64_t dim_size) {
+  using Vec = vec::Vectorized<scalar_t>;
+  int64_t BLOCK_SIZE = 128 * 1024;
+  int64_t CHUNK_SIZE = std::max(
+      int64_t(BLOCK_SIZE / dim_size / sizeof(scalar_t)), (int64_t)Vec::size());
+  CHUNK_SIZE = CHUNK_SIZE / Vec::size() * Vec::size();
+  int64_t num_chunks = divup(inner_size, CHUNK_SIZE);
+
+  int64_t grain_size = internal::GRAIN_SIZE / (16 * dim_size * CHUNK_SIZE);
+  at::parallel_for(0, outer_size * num_chunks, grain_size, [&](int64_t begin, int64_t end) {
+    // thread local temp buffer which holds the vertical sum reduction.
+    std::unique_ptr<scalar_t []> buffer(new scalar_t[CHUNK_SIZE]);
+    scalar_t* tmp_sum_data = buffer.get();
+
+    for (int64_t i = begin; i < end; i++) {
+      int64_t outer_idx = i / num_chunks;
+      int64_t k = i % num_chunks;
+      int64_t inner_idx_begin = k * CHUNK_SIZE;
+      int64_t size = std::min(CHUNK_SIZE, inner_size - inner_idx_begin);
+
+      // init
+      Vec zero_vec = Vec(scalar_t(0));
+      int64_t d0 = 0;
+      for (; d0 < size - (size % Vec::size()); d0 += Vec::size()) {
+        zero_vec.store(tmp_sum_data + d0);
+      }
+      for (; d0 < size; d0++) {
+        tmp_sum_data[d0] = scalar_t(0);
+      }
+
+      // compute sum of grad (log_softmax) or grad * output (softmax)
+      for (int64_t dim_idx = 0; dim_idx < dim_size; dim_idx++) {
+        int64_t offset = outer_idx * dim_size * inner_size
+            + dim_idx * inner_size + inner_idx_begin;
+        scalar_t* grad_output_ptr = grad_output_data_base + offset;
+        scalar_t* output_ptr = output_data_base + offset;
+
+        int64_t d1 = 0;
+        for (; d1 < size - (size % Vec::size()); d1 += Vec::size()) {
+          Vec grad_vec = Vec::loadu(grad_output_ptr + d1);
+          Vec sum_vec = Vec::loadu(tmp_sum_data + d1);
+          if (LogSoftMax) {
+            sum_vec += grad_vec;
+          } else {
+            sum_vec += grad_vec * Vec::loadu(output_ptr + d1);
+          }
+          sum_vec.store(tmp_sum_data + d1);
+        }
+        for (; d1 < size; d1++) {
+          if (LogSoftMax) {
+            tmp_sum_data[d1] += grad_output_ptr[d1];
+          } else {
+            tmp_sum_data[d1] += grad_output_ptr[d1] * output_ptr[d1];
+          }
+        }
+      }
+
+      // compute grad - output.exp() * sum (log_softmax)
+      //      or output * (grad - sum) (softmax)
+      for (int64_t dim_idx = 0; dim_idx < dim_size; dim_idx++) {
+        int64_t offset = outer_idx * dim_size * inner_size
+            + dim_idx * inner_size + inner_idx_begin;
+        scalar_t* grad_input_ptr = grad_input_data_base + offset;
+        scalar_t* grad_output_ptr = grad_output_data_base + offset;
+        scalar_t* output_ptr = output_data_base + offset;
+
+        int64_t d2 = 0;
+        for (; d2 < size - (size % Vec::size()); d2 += Vec::size()) {
+          Vec grad_vec = Vec::loadu(grad_output_ptr + d2);
+          Vec output_vec = Vec::loadu(output_ptr + d2);
+          Vec sum_vec = Vec::loadu(tmp_sum_data + d2);
+          Vec out_vec;
+          if (LogSoftMax) {
+            out_vec = grad_vec - output_vec.exp() * sum_vec;
+          } else {
+            out_vec = output_vec * (grad_vec - sum_vec);
+          }
+          out_vec.store(grad_input_ptr + d2);
+        }
+        for (; d2 < size; d2++) {
+          if (LogSoftMax) {
+            grad_input_ptr[d2] = grad_output_ptr[d2] -
+                std::exp(output_ptr[d2]) * tmp_sum_data[d2];
+          } else {
+            grad_input_ptr[d2] =
+                output_ptr[d2] * (grad_output_ptr[d2] - tmp_sum_data[d2]);
+          }
+        }
+      }
+    }
+  });
+}
+
+template <bool LogSoftMax>
+inline void _vec_softmax_backward(
+    BFloat16* grad_input_data_base,
+    BFloat16* grad_output_data_base,
+    BFloat16* output_data_base,
+    int64_t outer_size,
+    int64_t inner_size,
+    int64_t dim_size) {
+  using bVec = vec::Vectorized<BFloat16>;
+  using fVec = vec::Vectorized<float>;
+  int64_t BLOCK_SIZE = 128 * 1024;
+  int64_t CHUNK_SIZE = std::max(
+      int64_t(BLOCK_SIZE / dim_size / sizeof(BFloat16)), (int64_t)bVec::size());
+  CHUNK_SIZE = CHUNK_SIZE / bVec::size() * bVec::size();
+  int64_t num_chunks = divup(inner_size, CHUNK_SIZE);
+
+  int64_t grain_size = internal::GRAIN_SIZE / (16 * dim_size * CHUNK_SIZE);
+  at::parallel_for(0, outer_size * num_chunks, grain_size, [&](int64_t begin, int64_t end) {
+    // thread local temp buffer which holds the vertical sum reduction.
+    std::unique_ptr<float []> buffer(new float[CHUNK_SIZE]);
+    float* tmp_sum_data = buffer.get();
+
+    // thread local buffers that hold grad_output and output in float32 to
+    // save the dtype conversion in the update pass; the reduction both
+    // accumulates and runs in float32 as well.
+    std::unique_ptr<float []> grad_output_buffer(new float[dim_size * CHUNK_SIZE]);
+    float* grad_output_buffer_data = grad_output_buffer.get();
+    std::unique_ptr<float []> output_buffer(new float[dim_size * CHUNK_SIZE]);
+    float* output_buffer_data = output_buffer.get();
+
+    for (int64_t i = begin; i < end; i++) {
+      int64_t outer_idx = i / num_chunks;
+      int64_t k = i % num_chunks;
+      int64_t inner_idx_begin = k * CHUNK_SIZE;
+      int64_t size = std::min(CHUNK_SIZE, inner_size - inner_idx_begin);
+
+      // init
+      fVec zero_fvec = fVec(float(0));
+      int64_t d0 = 0;
+      for (; d0 < size - (size % bVec::size()); d0 += bVec::size()) {
+        zero_fvec.store(tmp_sum_data + d0);
+        zero_fvec.store(tmp_sum_data + d0 + fVec::size());
+      }
+      for (; d0 < size; d0++) {
+        tmp_sum_data[d0] = float(0);
+      }
+
+      // compute sum of grad (log_softmax) or grad * output (softmax),
+      // caching the converted float inputs along the way
+      for (int64_t dim_idx = 0; dim_idx < dim_size; dim_idx++) {
+        int64_t offset = outer_idx * dim_size * inner_size
+            + dim_idx * inner_size + inner_idx_begin;
+        BFloat16* grad_output_ptr = grad_output_data_base + offset;
+        BFloat16* output_ptr = output_data_base + offset;
+        float* grad_output_buffer_ptr =
+            grad_output_buffer_data + dim_idx * CHUNK_SIZE;
+        float* output_buffer_ptr = output_buffer_data + dim_idx * CHUNK_SIZE;
+
+        int64_t d1 = 0;
+        for (; d1 < size - (size % bVec::size()); d1 += bVec::size()) {
+          bVec grad_bvec = bVec::loadu(grad_output_ptr + d1);
+          fVec grad_fvec0, grad_fvec1;
+          std::tie(grad_fvec0, grad_fvec1) = convert_bfloat16_float(grad_bvec);
+          bVec output_bvec = bVec::loadu(output_ptr + d1);
+          fVec output_fvec0, output_fvec1;
+          std::tie(output_fvec0, output_fvec1) =
+              convert_bfloat16_float(output_bvec);
+          fVec sum_fvec0 = fVec::loadu(tmp_sum_data + d1);
+          fVec sum_fvec1 = fVec::loadu(tmp_sum_data + d1 + fVec::size());
+          if (LogSoftMax) {
+            sum_fvec0 += grad_fvec0;
+            sum_fvec1 += grad_fvec1;
+          } else {
+            sum_fvec0 += grad_fvec0 * output_fvec0;
+            sum_fvec1 += grad_fvec1 * output_fvec1;
+          }
+          sum_fvec0.store(tmp_sum_data + d1);
+          sum_fvec1.store(tmp_sum_data + d1 + fVec::size());
+
+          // cache the 'converted' float inputs
+          grad_fvec0.store(grad_output_buffer_ptr + d1);
+          grad_fvec1.store(grad_output_buffer_ptr + d1 + fVec::size());
+          output_fvec0.store(output_buffer_ptr + d1);
+          output_fvec1.store(output_buffer_ptr + d1 + fVec::size());
+        }
+        for (; d1 < size; d1++) {
+          float grad_val = float(grad_output_ptr[d1]);
+          float output_val = float(output_ptr[d1]);
+          if (LogSoftMax) {
+            tmp_sum_data[d1] += grad_val;
+          } else {
+            tmp_sum_data[d1] += grad_val * output_val;
+          }
+          grad_output_buffer_ptr[d1] = grad_val;
+          output_buffer_ptr[d1] = output_val;
+        }
+      }
+
+      // compute grad - output.exp() * sum (log_softmax)
+      //      or output * (grad - sum) (softmax)
+      for (int64_t dim_idx = 0; dim_idx < dim_size; dim_idx++) {
+        BFloat16* grad_input_ptr = grad_input_data_base
+            + outer_idx * dim_size * inner_size + dim_idx * inner_size
+            + inner_idx_begin;
+        float* grad_output_buffer_ptr =
+            grad_output_buffer_data + dim_idx * CHUNK_SIZE;
+        float* output_buffer_ptr = output_buffer_data + dim_idx * CHUNK_SIZE;
+
+        int64_t d2 = 0;
+        for (; d2 < size - (size % bVec::size()); d2 += bVec::size()) {
+          fVec grad_fvec0 = fVec::loadu(grad_output_buffer_ptr + d2);
+          fVec grad_fvec1 = fVec::loadu(grad_output_buffer_ptr + d2 + fVec::size());
+          fVec output_fvec0 = fVec::loadu(output_buffer_ptr + d2);
+          fVec output_fvec1 = fVec::loadu(output_buffer_ptr + d2 + fVec::size());
+          fVec sum_fvec0 = fVec::loadu(tmp_sum_data + d2);
+          fVec sum_fvec1 = fVec::loadu(tmp_sum_data + d2 + fVec::size());
+          fVec out_fvec0, out_fvec1;
+          if (LogSoftMax) {
+            out_fvec0 = grad_fvec0 - output_fvec0.exp() * sum_fvec0;
+            out_fvec1 = grad_fvec1 - output_fvec1.exp() * sum_fvec1;
+          } else {
+            out_fvec0 = output_fvec0 * (grad_fvec0 - sum_fvec0);
+            out_fvec1 = output_fvec1 * (grad_fvec1 - sum_fvec1);
+          }
+          bVec out_bvec = convert_float_bfloat16(out_fvec0, out_fvec1);
+          out_bvec.store(grad_input_ptr + d2);
+        }
+        for (; d2 < size; d2++) {
+          if (LogSoftMax) {
+            grad_input_ptr[d2] = BFloat16(grad_output_buffer_ptr[d2] -
+                std::exp(output_buffer_ptr[d2]) * tmp_sum_data[d2]);
+          } else {
+            grad_input_ptr[d2] = BFloat16(output_buffer_ptr[d2] *
+                (grad_output_buffer_ptr[d2] - tmp_sum_data[d2]));
+          }
+        }
+      }
+    }
+  });
+}
+
+template <typename scalar_t, bool LogSoftMax>
+struct vec_softmax_backward {
+  static void apply(
+      const Tensor& grad_input,
+      const Tensor& grad,
+      const Tensor& output,
+      int64_t dim) {
+    int64_t outer_size = 1;
+    int64_t dim_size = grad.size(dim);
+    int64_t inner_size = 1;
+    for (const auto i : c10::irange(dim)) {
+      outer_size *= grad.size(i);
+    }
+    for (int64_t i = dim + 1; i < grad.dim(); ++i) {
+      inner_size *= grad.size(i);
+    }
+    scalar_t* grad_input_data_base = grad_input.data_ptr<scalar_t>();
+    scalar_t* grad_data_base = grad.data_ptr<scalar_t>();
+    scalar_t* output_data_base = output.data_ptr<scalar_t>();
+    _vec_softmax_backward<LogSoftMax>(
+        grad_input_data_base,
+        grad_data_base,
+        output_data_base,
+        outer_size,
+        inner_size,
+        dim_size);
+  }
+};
+
 template <typename scalar_t, bool LogSoftMax>
 struct vec_host_softmax_backward_lastdim {
   static void
@@ -795,6 +1071,32 @@ static void log_softmax_backward_lastdim_kernel_impl(
       });
 }
 
+static void softmax_backward_kernel_impl(
+    const Tensor& grad_input,
+    const Tensor& grad,
+    const Tensor& output,
+    int64_t dim) {
+  AT_DISPATCH_FLOATING_TYPES_AND(
+      at::ScalarType::BFloat16, grad.scalar_type(),
+      "softmax_backward_kernel_impl", [&] {
+        vec_softmax_backward<scalar_t, false>::apply(
+            grad_input, grad, output, dim);
+      });
+}
+
+static void log_softmax_backward_kernel_impl(
+    const Tensor& grad_input,
+    const Tensor& grad,
+    const Tensor& output,
+    int64_t dim) {
+  AT_DISPATCH_FLOATING_TYPES_AND(
+      at::ScalarType::BFloat16, grad.scalar_type(),
+      "log_softmax_backward_kernel_impl", [&] {
+        vec_softmax_backward<scalar_t, true>::apply(
+            grad_input, grad, output, dim);
+      });
+}
+
 } // anonymous namespace
 
 REGISTER_DISPATCH(softmax_lastdim_kernel, &softmax_lastdim_kernel_impl);
@@ -809,4 +1111,9 @@ REGISTER_DISPATCH(
 REGISTER_DISPATCH(softmax_kernel, &softmax_kernel_impl);
 REGISTER_DISPATCH(log_softmax_kernel, &log_softmax_kernel_impl);
 
+REGISTER_DISPATCH(softmax_backward_kernel, &softmax_backward_kernel_impl);
+REGISTER_DISPATCH(
+    log_softmax_backward_kernel,
+    &log_softmax_backward_kernel_impl);
+
 }} // namespace at::native
@@ -20,5 +20,10 @@ using forward_fn_with_dim = void(*)(const Tensor &, const Tensor &, const int64_
 DECLARE_DISPATCH(forward_fn_with_dim, softmax_kernel);
 DECLARE_DISPATCH(forward_fn_with_dim, log_softmax_kernel);
 
+using backward_fn_with_dim =
+    void (*)(const Tensor&, const Tensor&, const Tensor&, const int64_t);
+DECLARE_DISPATCH(backward_fn_with_dim, softmax_backward_kernel);
+DECLARE_DISPATCH(backward_fn_with_dim, log_softmax_backward_kernel);
+
 }
 }
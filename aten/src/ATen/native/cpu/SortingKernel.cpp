@@ -66,6 +66,196 @@ void _dim_apply(
   );
 }
 
+// Minimum size of the sort dimension before the radix paths beat the
+// comparison sorts (and have enough work to split across cores).
+constexpr int64_t kMinRadixSortSize = 4096;
+
+// Parallel LSD radix sort over (key, index) pairs for a contiguous 1-D
+// input. Each pass histograms one key byte per chunk, prefix-sums the
+// counts bucket-major so equal bytes stay ordered first by chunk and then by
+// position (which keeps the sort stable), and scatters into the scratch
+// arrays. See Note [CPU radix selection] in TopKImpl.h for the key mapping.
+template <
+    typename scalar_t,
+    typename std::enable_if<RadixSortKey<scalar_t>::supported, int>::type = 0>
+bool radix_sort_1d(
+    scalar_t* values,
+    int64_t* indices,
+    int64_t n,
+    bool descending,
+    bool stable) {
+  using traits = RadixSortKey<scalar_t>;
+  using key_t = typename traits::key_t;
+  constexpr int64_t kNumBuckets = 256;
+  constexpr int kNumPasses = sizeof(key_t);
+
+  if (stable && !traits::exact_order) {
+    // See FloatRadixKey: -0.0 and +0.0 would be reordered.
+    return false;
+  }
+
+  const int64_t num_chunks = std::max<int64_t>(
+      1,
+      std::min<int64_t>(at::get_num_threads(), divup(n, kMinRadixSortSize)));
+  const auto chunk_begin = [n, num_chunks](int64_t c) {
+    return n * c / num_chunks;
+  };
+
+  std::vector<key_t> keys(n);
+  std::vector<key_t> keys_scratch(n);
+  std::vector<int64_t> idx_scratch(n);
+
+  // Build the keys, remembering the OR and AND over each chunk so that
+  // passes where every key agrees on the byte can be skipped entirely (an
+  // int64 tensor holding small values needs one or two passes, not eight).
+  std::vector<key_t> chunk_or(num_chunks);
+  std::vector<key_t> chunk_and(num_chunks);
+  at::parallel_for(0, num_chunks, 1, [&](int64_t cbegin, int64_t cend) {
+    for (const auto c : c10::irange(cbegin, cend)) {
+      key_t ored = 0;
+      key_t anded = ~key_t(0);
+      for (const auto i : c10::irange(chunk_begin(c), chunk_begin(c + 1))) {
+        key_t key = traits::transform(values[i]);
+        if (descending) {
+          key = ~key;
+        }
+        keys[i] = key;
+        ored |= key;
+        anded &= key;
+      }
+      chunk_or[c] = ored;
+      chunk_and[c] = anded;
+    }
+  });
+  key_t varying = 0;
+  for (const auto c : c10::irange(num_chunks)) {
+    varying |= static_cast<key_t>(chunk_or[c] ^ chunk_and[c]);
+  }
+
+  std::vector<int64_t> counts(num_chunks * kNumBuckets);
+  key_t* src_keys = keys.data();
+  key_t* dst_keys = keys_scratch.data();
+  int64_t* src_idx = indices;
+  int64_t* dst_idx = idx_scratch.data();
+  for (const auto pass : c10::irange(kNumPasses)) {
+    const int shift = 8 * pass;
+    if (((varying >> shift) & 0xFF) == 0) {
+      continue;
+    }
+    std::fill(counts.begin(), counts.end(), int64_t{0});
+    at::parallel_for(0, num_chunks, 1, [&](int64_t cbegin, int64_t cend) {
+      for (const auto c : c10::irange(cbegin, cend)) {
+        int64_t* my_counts = counts.data() + c * kNumBuckets;
+        for (const auto i : c10::irange(chunk_begin(c), chunk_begin(c + 1))) {
+          my_counts[(src_keys[i] >> shift) & 0xFF]++;
+        }
+      }
+    });
+    int64_t running = 0;
+    for (const auto b : c10::irange(kNumBuckets)) {
+      for (const auto c : c10::irange(num_chunks)) {
+        int64_t& slot = counts[c * kNumBuckets + b];
+        const int64_t count = slot;
+        slot = running;
+        running += count;
+      }
+    }
+    at::parallel_for(0, num_chunks, 1, [&](int64_t cbegin, int64_t cend) {
+      for (const auto c : c10::irange(cbegin, cend)) {
+        int64_t* my_offsets = counts.data() + c * kNumBuckets;
+        for (const auto i : c10::irange(chunk_begin(c), chunk_begin(c + 1))) {
+          const key_t key = src_keys[i];
+          const int64_t pos = my_offsets[(key >> shift) & 0xFF]++;
+          dst_keys[pos] = key;
+          dst_idx[pos] = src_idx[i];
+        }
+      }
+    });
+    std::swap(src_keys, dst_keys);
+    std::swap(src_idx, dst_idx);
+  }
+
+  // The keys only encode ordering; gather the output values through the
+  // sorted indices so NaN payloads and signed zeros are copied out verbatim.
+  std::vector<scalar_t> gathered(n);
+  at::parallel_for(0, n, internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+    for (const auto i : c10::irange(begin, end)) {
+      gathered[i] = values[src_idx[i]];
+    }
+  });
+  const bool idx_in_scratch = src_idx != indices;
+  at::parallel_for(0, n, internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+    for (const auto i : c10::irange(begin, end)) {
+      values[i] = gathered[i];
+      if (idx_in_scratch) {
+        indices[i] = src_idx[i];
+      }
+    }
+  });
+  return true;
+}
+
+template <
+    typename scalar_t,
+    typename std::enable_if<!RadixSortKey<scalar_t>::supported, int>::type = 0>
+bool radix_sort_1d(
+    scalar_t* /*values*/,
+    int64_t* /*indices*/,
+    int64_t /*n*/,
+    bool /*descending*/,
+    bool /*stable*/) {
+  return false;
+}
+
+static bool try_radix_sort(
+    const TensorBase& values,
+    const TensorBase& indices,
+    int64_t dim,
+    bool descending,
+    bool stable) {
+  const int64_t n = values.size(dim);
+  if (values.numel() != n || n < kMinRadixSortSize ||
+      values.stride(dim) != 1 || indices.stride(dim) != 1) {
+    return false;
+  }
+  bool done = false;
+  AT_DISPATCH_ALL_TYPES_AND3(
+    ScalarType::Bool, ScalarType::Half, ScalarType::BFloat16,
+    values.scalar_type(), "radix_sort_cpu", [&] {
+      done = radix_sort_1d<scalar_t>(
+          values.data_ptr<scalar_t>(),
+          indices.data_ptr<int64_t>(),
+          n, descending, stable);
+    });
+  return done;
+}
+
+static bool try_radix_select_topk(
+    const TensorBase& values,
+    const TensorBase& indices,
+    const TensorBase& self,
+    int64_t k,
+    int64_t dim,
+    bool largest,
+    bool sorted) {
+  const int64_t n = self.size(dim);
+  if (self.numel() != n || n < kMinRadixSortSize || k == 0 ||
+      self.stride(dim) != 1 ||
+      values.stride(dim) != 1 || indices.stride(dim) != 1) {
+    return false;
+  }
+  bool done = false;
+  AT_DISPATCH_ALL_TYPES_AND(
+    ScalarType::BFloat16, self.scalar_type(), "radix_select_topk_cpu", [&] {
+      done = topk_radix_select_impl<scalar_t>(
+          values.data_ptr<scalar_t>(),
+          indices.data_ptr<int64_t>(),
+          self.data_ptr<scalar_t>(),
+          k, n, largest, sorted);
+    });
+  return done;
+}
+
 template <typename scalar_t>
 struct KeyValueCompAsc {
   template <typename LHS, typename RHS>
@@ -93,6 +283,11 @@ static void sort_kernel(
     bool stable) {
   dim = maybe_wrap_dim(dim, values.dim());
   _fill_indices(indices, dim);
+  // A large single-row sort has no outer dimension for _dim_apply to
+  // parallelize over; hand it to the multi-threaded radix sort instead.
+  if (try_radix_sort(values, indices, dim, descending, stable)) {
+    return;
+  }
   _dim_apply(
     values, indices, dim,
     "sort_cpu", [&](
@@ -142,6 +337,11 @@ static void topk_kernel(
     bool largest,
     bool sorted) {
   auto sizes = self.sizes();
+  // Same single-row situation as in sort_kernel: the loop below only
+  // parallelizes across rows, so a lone huge row goes to radix selection.
+  if (try_radix_select_topk(values, indices, self, k, dim, largest, sorted)) {
+    return;
+  }
   auto iter = TensorIteratorConfig()
     .check_all_same_dtype(false)
     .resize_outputs(false)
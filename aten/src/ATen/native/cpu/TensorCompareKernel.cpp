@@ -19,6 +19,8 @@
 #include <ATen/native/ReduceOpsUtils.h>
 #include <ATen/native/Resize.h>
 #include <ATen/native/cpu/Loops.h>
+#include <ATen/cpu/vec/functional.h>
+#include <ATen/cpu/vec/vec.h>
 
 #ifndef AT_PER_OPERATOR_HEADERS
 #include <ATen/Functions.h>
@@ -165,6 +167,33 @@ static void max_kernel_impl(
   });
 }
 
+// Vectorized fast path for aminmax when the reduced dim is contiguous.
+// NaN propagates through vec::minimum/vec::maximum, so the result matches
+// the NaN handling of the scalar loop below. Returns false for bool, which
+// has no vectorized min/max.
+template <typename scalar_t,
+          typename std::enable_if<!std::is_same<scalar_t, bool>::value, int>::type = 0>
+static inline bool aminmax_contiguous_reduce(
+    const scalar_t* self_data, int64_t size,
+    scalar_t* min_result_data, scalar_t* max_result_data) {
+  using Vec = vec::Vectorized<scalar_t>;
+  std::pair<scalar_t, scalar_t> result = vec::reduce2_all<scalar_t>(
+      [](Vec x, Vec y) { return vec::minimum(x, y); },
+      [](Vec x, Vec y) { return vec::maximum(x, y); },
+      self_data, size);
+  *min_result_data = result.first;
+  *max_result_data = result.second;
+  return true;
+}
+
+template <typename scalar_t,
+          typename std::enable_if<std::is_same<scalar_t, bool>::value, int>::type = 0>
+static inline bool aminmax_contiguous_reduce(
+    const scalar_t* /*self_data*/, int64_t /*size*/,
+    scalar_t* /*min_result_data*/, scalar_t* /*max_result_data*/) {
+  return false;
+}
+
 static void aminmax_kernel(
     const Tensor& self,
     int64_t dim,
@@ -182,6 +211,11 @@ static void aminmax_kernel(
     compare_base_kernel<scalar_t, scalar_t>(min_result, max_result, self, wrap_dim, keepdim, [&] (
       scalar_t* min_result_data, scalar_t* max_result_data,
       const scalar_t* self_data, auto self_dim_stride) {
+        if (self_dim_stride == 1 &&
+            aminmax_contiguous_reduce(
+                self_data, self_dim_size, min_result_data, max_result_data)) {
+          return;
+        }
         scalar_t min_number = c10::load(self_data);
         scalar_t max_number = min_number;
         for (const auto i : c10::irange(self_dim_size)) {
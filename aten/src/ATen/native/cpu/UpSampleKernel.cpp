@@ -298,6 +298,55 @@ static inline void basic_loop_aa_single_dim_nonzero_strides(
   }
 }
 
+// Fixed-point variants of the single-dim anti-alias loops for uint8 data,
+// as in PIL: weights are pre-quantized to int16 with kByteWeightsPrecision
+// fractional bits (see _compute_indices_weights_aa_int16), the products are
+// accumulated in int32 and rounded back to uint8. This avoids the per-pixel
+// uint8 <-> float round trips of the generic path; the multiply-accumulate
+// over small integers also autovectorizes much wider. For channels-last
+// images the inner TensorIterator dimension runs along the channels, so the
+// loop body stays contiguous in memory on both passes.
+constexpr int kByteWeightsPrecision = 14;
+
+static inline uint8_t interpolate_aa_single_dim_uint8(
+    char* src,
+    char** data,
+    const int64_t* strides,
+    int64_t i,
+    const int64_t ids_stride) {
+  int64_t ids_min = *(int64_t*)&data[0][i * strides[0]];
+  int64_t ids_size = *(int64_t*)&data[1][i * strides[1]];
+
+  char* src_min = src + ids_min;
+  int64_t wts_idx = *(int64_t*)&data[4][i * strides[4]];
+  int16_t* wts_ptr = (int16_t*)&data[3][wts_idx];
+
+  // Round-to-nearest via a half-ulp bias before the shift.
+  int32_t output = 1 << (kByteWeightsPrecision - 1);
+  for (const auto j : c10::irange(ids_size)) {
+    output += static_cast<int32_t>(*(uint8_t*)&src_min[j * ids_stride]) *
+        static_cast<int32_t>(wts_ptr[j]);
+  }
+  output >>= kByteWeightsPrecision;
+  // Cubic weights overshoot, so the result has to be clamped.
+  return static_cast<uint8_t>(std::min(std::max(output, 0), 255));
+}
+
+static inline void basic_loop_aa_single_dim_uint8(
+    char** data,
+    const int64_t* strides,
+    int64_t n) {
+  char* dst = data[0];
+  char* src = data[1];
+  // index stride is constant for the given dimension
+  const int64_t ids_stride = *(int64_t*)&data[2 + 2][0];
+
+  for (const auto i : c10::irange(n)) {
+    *(uint8_t*)&dst[i * strides[0]] = interpolate_aa_single_dim_uint8(
+        src + i * strides[1], &data[2], &strides[2], i, ids_stride);
+  }
+}
+
 // Generic upsampling computation method using TensorIterator for Nd case.
 // Supports: nearest, linear, cubic modes with interp_size template argument: 1, 2, 4
 //
@@ -717,6 +766,82 @@ struct HelperInterpBase {
     return output;
   }
 
+  // Variant of _compute_indices_weights_aa for uint8 data: the weights are
+  // computed in float and quantized to int16 fixed point with
+  // kByteWeightsPrecision fractional bits, matching what
+  // basic_loop_aa_single_dim_uint8 accumulates in int32. Normalized
+  // anti-alias weights have magnitude <= 1, so they always fit.
+  template <typename aa_filter_fn_t>
+  static inline std::vector<Tensor> _compute_indices_weights_aa_int16(
+    int64_t input_size, int64_t output_size, int64_t stride, int64_t ndims,
+    int64_t reshape_dim, float scale,
+    int interp_size, aa_filter_fn_t aa_filter_fn
+  ) {
+
+    std::vector<Tensor> output;
+
+    float support =
+        (scale >= 1.0) ? (interp_size * 0.5) * scale : interp_size * 0.5;
+    interp_size = (int)ceilf(support) * 2 + 1;
+
+    auto new_shape = std::vector<int64_t>(ndims, 1);
+    new_shape[reshape_dim] = output_size;
+
+    output.emplace_back(
+        empty(new_shape, CPU(c10::CppTypeToScalarType<int64_t>())));
+    output.emplace_back(
+        empty(new_shape, CPU(c10::CppTypeToScalarType<int64_t>())));
+    output.emplace_back(
+        empty(new_shape, CPU(c10::CppTypeToScalarType<int64_t>())));
+
+    {
+      // Weights
+      new_shape[reshape_dim] = output_size * interp_size;
+      auto wts = empty(new_shape, CPU(c10::CppTypeToScalarType<int16_t>()));
+      auto strides = wts.strides().vec();
+      strides[reshape_dim] = 0;
+      new_shape[reshape_dim] = output_size;
+      wts = wts.as_strided(new_shape, strides);
+      output.emplace_back(wts);
+      // Weights indices
+      output.emplace_back(
+          empty(new_shape, CPU(c10::CppTypeToScalarType<int64_t>())));
+    }
+
+    int64_t* idx_ptr_xmin = output[0].data_ptr<int64_t>();
+    int64_t* idx_ptr_size = output[1].data_ptr<int64_t>();
+    int64_t* idx_ptr_stride = output[2].data_ptr<int64_t>();
+    int16_t* wt_ptr = output[3].data_ptr<int16_t>();
+    int64_t* wt_idx_ptr = output[4].data_ptr<int64_t>();
+
+    std::vector<float> wt_buffer(interp_size);
+    int64_t xmin, xmax;
+
+    for (const auto i : c10::irange(output_size)) {
+      HelperInterpBase::_compute_weights_aa(
+          i,
+          input_size,
+          scale,
+          support,
+          wt_buffer.data(),
+          interp_size,
+          aa_filter_fn,
+          xmin,
+          xmax);
+
+      for (const auto j : c10::irange(interp_size)) {
+        wt_ptr[i * interp_size + j] = static_cast<int16_t>(
+            std::lround(wt_buffer[j] * (1 << kByteWeightsPrecision)));
+      }
+
+      idx_ptr_xmin[i] = xmin * stride;
+      idx_ptr_size[i] = xmax;
+      idx_ptr_stride[i] = stride;
+      wt_idx_ptr[i] = i * interp_size * sizeof(int16_t);
+    }
+    return output;
+  }
+
 };
 
 struct HelperInterpNearest : public HelperInterpBase {
@@ -942,6 +1067,28 @@ struct HelperInterpLinear : public HelperInterpBase {
     );
     return indices_weights;
   }
+
+  static inline std::vector<Tensor> compute_indices_weights_aa_int16(
+    int64_t input_size,
+    int64_t output_size,
+    int64_t stride,
+    int64_t ndims,
+    int64_t reshape_dim,
+    bool align_corners,
+    const c10::optional<double> opt_scale
+  ) {
+    float scale = area_pixel_compute_scale<float>(
+        input_size, output_size, align_corners, opt_scale);
+    return HelperInterpLinear::_compute_indices_weights_aa_int16(
+        input_size,
+        output_size,
+        stride,
+        ndims,
+        reshape_dim,
+        scale,
+        HelperInterpLinear::interp_size,
+        &HelperInterpLinear::aa_filter<float>);
+  }
 };
 
 struct HelperInterpCubic : public HelperInterpBase {
@@ -1053,6 +1200,28 @@ struct HelperInterpCubic : public HelperInterpBase {
     );
     return indices_weights;
   }
+
+  static inline std::vector<Tensor> compute_indices_weights_aa_int16(
+    int64_t input_size,
+    int64_t output_size,
+    int64_t stride,
+    int64_t ndims,
+    int64_t reshape_dim,
+    bool align_corners,
+    const c10::optional<double> opt_scale
+  ) {
+    float scale = area_pixel_compute_scale<float>(
+        input_size, output_size, align_corners, opt_scale);
+    return HelperInterpCubic::_compute_indices_weights_aa_int16(
+        input_size,
+        output_size,
+        stride,
+        ndims,
+        reshape_dim,
+        scale,
+        HelperInterpCubic::interp_size,
+        &HelperInterpCubic::aa_filter<float>);
+  }
 };
 
 // Generic upsampling interpolation kernel for N-d case.
@@ -1156,6 +1325,17 @@ void cpu_upsample_generic_aa(at::TensorIterator& iter) {
   iter.for_each(loop);
 }
 
+// Fixed-point anti-alias path for uint8 data; the weights were quantized to
+// int16 by _compute_indices_weights_aa_int16.
+void cpu_upsample_generic_aa_uint8(at::TensorIterator& iter) {
+
+  auto loop = [&](char** data, const int64_t* strides, int64_t n) {
+    basic_loop_aa_single_dim_uint8(data, strides, n);
+  };
+
+  iter.for_each(loop);
+}
+
 // Generic separable upsampling interpolation kernels for N-d case with anti-aliasing
 template <int out_ndims, typename scale_type, class F>
 void _separable_upsample_generic_Nd_kernel_impl_single_dim(
@@ -1191,11 +1371,22 @@ void _separable_upsample_generic_Nd_kernel_impl_single_dim(
     input_scalar_type = at::ScalarType::Float;
   }
 
-  indices_weights.emplace_back(
-      F::compute_indices_weights_aa(
-        input_scalar_type, input.size(interp_dim), oshape[interp_dim],
-        input.stride(interp_dim) * input.element_size(),
-        input.dim(), interp_dim, align_corners, scales[interp_dim - 2]));
+  if (interp_size > 1 && input_scalar_type == at::ScalarType::Byte) {
+    // Anti-aliased uint8 resize (image preprocessing) runs on the
+    // fixed-point path: int16 weights, int32 accumulation, see
+    // basic_loop_aa_single_dim_uint8.
+    indices_weights.emplace_back(
+        F::compute_indices_weights_aa_int16(
+          input.size(interp_dim), oshape[interp_dim],
+          input.stride(interp_dim) * input.element_size(),
+          input.dim(), interp_dim, align_corners, scales[interp_dim - 2]));
+  } else {
+    indices_weights.emplace_back(
+        F::compute_indices_weights_aa(
+          input_scalar_type, input.size(interp_dim), oshape[interp_dim],
+          input.stride(interp_dim) * input.element_size(),
+          input.dim(), interp_dim, align_corners, scales[interp_dim - 2]));
+  }
 
   TensorIteratorConfig config;
   config.check_all_same_dtype(false)
@@ -1213,9 +1404,13 @@ void _separable_upsample_generic_Nd_kernel_impl_single_dim(
 
   if (interp_size > 1) {
     // Nearest also supports uint8 tensor, so need to handle it separately
-    AT_DISPATCH_FLOATING_TYPES(iter.dtype(), "upsample_generic_Nd_aa", [&] {
-      cpu_upsample_generic_aa<scalar_t>(iter);
-    });
+    if (iter.dtype() == at::ScalarType::Byte) {
+      cpu_upsample_generic_aa_uint8(iter);
+    } else {
+      AT_DISPATCH_FLOATING_TYPES(iter.dtype(), "upsample_generic_Nd_aa", [&] {
+        cpu_upsample_generic_aa<scalar_t>(iter);
+      });
+    }
   } else {
     AT_DISPATCH_FLOATING_TYPES_AND(
         at::ScalarType::Byte, iter.dtype(), "upsample_generic_Nd_aa", [&] {
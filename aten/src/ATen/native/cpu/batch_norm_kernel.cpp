@@ -168,6 +168,59 @@ void batch_norm_cpu_channels_last_impl(Tensor& output, const Tensor& input,
   });
 }
 
+/// A fused variant of the channels last kernel above that clamps the
+/// normalized value at zero before it is stored, so that a following ReLU
+/// does not have to read and write the activation again.
+template <typename scalar_t>
+void batch_norm_cpu_channels_last_relu_impl(Tensor& output, const Tensor& input,
+    const Tensor& weight, const Tensor& bias, const Tensor& save_mean, const Tensor& save_invstd,
+    const Tensor& running_mean, const Tensor& running_var, bool train, double eps) {
+
+  using Vec = Vectorized<scalar_t>;
+  int64_t n_batch = input.size(0);
+  int64_t n_channel = input.size(1);
+  int64_t image_size = input.numel() / n_batch / n_channel;
+
+  Tensor alpha = at::empty({n_channel}, input.options());
+  Tensor beta = at::empty({n_channel}, input.options());
+  scalar_t* alpha_data = alpha.data_ptr<scalar_t>();
+  scalar_t* beta_data = beta.data_ptr<scalar_t>();
+
+  batch_norm_cpu_collect_linear_and_constant_terms<scalar_t, scalar_t>(
+      alpha_data, beta_data, n_channel, weight, bias,
+      save_mean, save_invstd, running_mean, running_var, train, eps);
+
+  scalar_t* output_data = output.data_ptr<scalar_t>();
+  const scalar_t* input_data = input.data_ptr<scalar_t>();
+
+  // Apply the linear terms and the ReLU to the input,
+  // output(n, c, h, w) = max(input(n, c, h, w) * alpha(c) + beta(c), 0)
+  const Vec zero_vec(scalar_t(0));
+  const int64_t loop_size = n_channel - (n_channel % Vec::size());
+  at::parallel_for(0, n_batch * image_size, 1, [&](int64_t begin, int64_t end) {
+    for (const auto i : c10::irange(begin, end)) {
+      int64_t offset = i * n_channel;
+      int64_t d = 0;
+      // vectorize on channel dimension, for normal batch_norm input size,
+      // alpha/beta should fit in L1 cache, otherwise consider blocking.
+      for (; d < loop_size; d += Vec::size()) {
+        Vec alpha_vec = Vec::loadu(alpha_data + d);
+        Vec beta_vec = Vec::loadu(beta_data + d);
+        Vec data_vec = Vec::loadu(input_data + offset + d);
+        Vec output_vec = vec::maximum(data_vec * alpha_vec + beta_vec, zero_vec);
+        output_vec.store(output_data + offset + d);
+      }
+      if (n_channel - d > 0) {
+        Vec alpha_vec = Vec::loadu(alpha_data + d, n_channel - d);
+        Vec beta_vec = Vec::loadu(beta_data + d, n_channel - d);
+        Vec data_vec = Vec::loadu(input_data + offset + d, n_channel - d);
+        Vec output_vec = vec::maximum(data_vec * alpha_vec + beta_vec, zero_vec);
+        output_vec.store(output_data + offset + d, n_channel - d);
+      }
+    }
+  });
+}
+
 template <typename scalar_t>
 void batch_norm_cpu_collect_stats_contiguous_impl(
     Tensor& mean, Tensor& var_sum, const Tensor& input) {
@@ -224,72 +277,79 @@ void batch_norm_cpu_collect_stats_channels_last_impl(
   scalar_t* var_sum_data = var_sum.data_ptr<scalar_t>();
 
   // Typical vertical reduce from shape of {NHW, C} to {C}.
-  // Apply two path parallel reduction:
-  // First path: allocate an immediate buffer of size {max_threads, C}, parallel along dim0,
+  // Apply single pass Welford parallel reduction:
+  // First path: allocate buffers of running mean and running m2 of size
+  //    {max_threads, C}, parallel along dim0 with one sweep over the input,
   //    {NHW, C} => {max_threads, C}
   //
-  // Second path: parallel along dim1 of the immediate buffer,
+  // Second path: parallel along dim1 of the buffers, merging the per thread
+  //    partial results with Chan's update,
   //    {max_threads, C} => {C}
   //
+  // A single Welford sweep reads the input once instead of twice (once for
+  // the mean and once for the variance), which matters since NHW * C does
+  // not normally fit in cache.
+  //
   // Normal size of C should fit in L1, otherwise consider blocking on C.
   //
   int num_threads = at::get_num_threads();
-  Tensor buffer = at::empty({num_threads, n_channel}, input.options()).zero_();
-  scalar_t* buffer_data = buffer.data_ptr<scalar_t>();
+  Tensor mean_buffer = at::empty({num_threads, n_channel}, input.options()).zero_();
+  Tensor m2_buffer = at::empty({num_threads, n_channel}, input.options()).zero_();
+  scalar_t* mean_buffer_data = mean_buffer.data_ptr<scalar_t>();
+  scalar_t* m2_buffer_data = m2_buffer.data_ptr<scalar_t>();
+  std::vector<int64_t> counts(num_threads, 0);
 
-  // compute mean per input
   at::parallel_for(0, N, 1, [&](int64_t begin, int64_t end) {
     int tid = at::get_thread_num();
     TORCH_CHECK(tid < num_threads,
                 "expect thread id smaller than ", num_threads, ", got thread id ", tid);
-    scalar_t* buffer_ptr = buffer_data + tid * n_channel;
+    scalar_t* mean_ptr = mean_buffer_data + tid * n_channel;
+    scalar_t* m2_ptr = m2_buffer_data + tid * n_channel;
+    int64_t count = counts[tid];
     for (const auto i : c10::irange(begin, end)) {
       const scalar_t* x_ptr = input_data + i * n_channel;
-      vec::map2<scalar_t>(
-          [](Vec x, Vec y) { return x + y; },
-          buffer_ptr,
-          x_ptr,
-          buffer_ptr,
-          n_channel);
-    }
-  });
-
-  at::parallel_for(0, n_channel, 1, [&](int64_t begin, int64_t end) {
-    for (const auto c : c10::irange(begin, end)) {
-      accscalar_t sum = 0;
-      for (const auto t : c10::irange(num_threads)) {
-        sum += buffer_data[t * n_channel + c];
+      count += 1;
+      const Vec count_inv_vec(scalar_t(1) / count);
+      int64_t d = 0;
+      for (; d < n_channel - (n_channel % Vec::size()); d += Vec::size()) {
+        Vec x_vec = Vec::loadu(x_ptr + d);
+        Vec mean_vec = Vec::loadu(mean_ptr + d);
+        Vec delta_vec = x_vec - mean_vec;
+        mean_vec = mean_vec + delta_vec * count_inv_vec;
+        Vec m2_vec = Vec::loadu(m2_ptr + d) + delta_vec * (x_vec - mean_vec);
+        mean_vec.store(mean_ptr + d);
+        m2_vec.store(m2_ptr + d);
+      }
+      for (; d < n_channel; d++) {
+        scalar_t x = x_ptr[d];
+        scalar_t delta = x - mean_ptr[d];
+        mean_ptr[d] += delta / count;
+        m2_ptr[d] += delta * (x - mean_ptr[d]);
       }
-      scalar_t mean = sum / N;
-      mean_data[c] = mean;
-    }
-  });
-
-  // compute variance per input, reuse the immediate buffer
-  buffer.zero_();
-  at::parallel_for(0, N, 1, [&](int64_t begin, int64_t end) {
-    int tid = at::get_thread_num();
-    TORCH_CHECK(tid < num_threads, "expect thread id smaller than ", num_threads, ", got thread id ", tid);
-    scalar_t* buffer_ptr = buffer_data + tid * n_channel;
-    for (const auto i : c10::irange(begin, end)) {
-      const scalar_t* x_ptr = input_data + i * n_channel;
-      vec::map3<scalar_t>(
-          [](Vec x, Vec y, Vec mean) { return y + (x - mean) * (x - mean); },
-          buffer_ptr,
-          x_ptr,
-          buffer_ptr,
-          mean_data,
-          n_channel);
     }
+    counts[tid] = count;
   });
 
   at::parallel_for(0, n_channel, 1, [&](int64_t begin, int64_t end) {
     for (const auto c : c10::irange(begin, end)) {
-      accscalar_t _var_sum = 0;
+      accscalar_t count = 0;
+      accscalar_t avg = 0;
+      accscalar_t m2 = 0;
       for (const auto t : c10::irange(num_threads)) {
-        _var_sum += buffer_data[t * n_channel + c];
+        accscalar_t thread_count = counts[t];
+        if (thread_count == 0) {
+          continue;
+        }
+        accscalar_t thread_avg = mean_buffer_data[t * n_channel + c];
+        accscalar_t delta = thread_avg - avg;
+        accscalar_t new_count = count + thread_count;
+        avg += delta * thread_count / new_count;
+        m2 += m2_buffer_data[t * n_channel + c]
+            + delta * delta * count * thread_count / new_count;
+        count = new_count;
       }
-      var_sum_data[c] = _var_sum;
+      mean_data[c] = avg;
+      var_sum_data[c] = m2;
     }
   });
 }
@@ -714,6 +774,65 @@ void batch_norm_cpu_channels_last_impl<BFloat16>(Tensor& output, const Tensor& i
   });
 }
 
+template <>
+void batch_norm_cpu_channels_last_relu_impl<BFloat16>(Tensor& output, const Tensor& input,
+    const Tensor& weight, const Tensor& bias, const Tensor& save_mean, const Tensor& save_invstd,
+    const Tensor& running_mean, const Tensor& running_var, bool train, double eps) {
+
+  using bVec = Vectorized<BFloat16>;
+  using fVec = Vectorized<float>;
+  int64_t n_batch = input.size(0);
+  int64_t n_channel = input.size(1);
+  int64_t image_size = input.numel() / n_batch / n_channel;
+
+  Tensor alpha = at::empty({n_channel}, input.options().dtype(kFloat));
+  Tensor beta = at::empty({n_channel}, input.options().dtype(kFloat));
+  float* alpha_data = alpha.data_ptr<float>();
+  float* beta_data = beta.data_ptr<float>();
+
+  const bool mixed_type = is_mixed_type(input, weight, bias, save_mean, save_invstd, running_mean, running_var);
+  if (mixed_type) {
+    batch_norm_cpu_collect_linear_and_constant_terms<float, float>(
+        alpha_data, beta_data, n_channel, weight, bias,
+        save_mean, save_invstd, running_mean, running_var, train, eps);
+  } else {
+    batch_norm_cpu_collect_linear_and_constant_terms<BFloat16, float>(
+        alpha_data, beta_data, n_channel, weight, bias,
+        save_mean, save_invstd, running_mean, running_var, train, eps);
+  }
+
+  BFloat16* output_data = output.data_ptr<BFloat16>();
+  const BFloat16* input_data = input.data_ptr<BFloat16>();
+
+  const fVec zero_fvec(float(0));
+  const int64_t loop_size = n_channel - (n_channel % bVec::size());
+  at::parallel_for(0, n_batch * image_size, 1, [&](int64_t begin, int64_t end) {
+    for (const auto i : c10::irange(begin, end)) {
+      const BFloat16* input_ptr = input_data + i * n_channel;
+      BFloat16* output_ptr = output_data + i * n_channel;
+      int64_t d = 0;
+      for (; d < loop_size; d += bVec::size()) {
+        fVec alpha_fvec0 = fVec::loadu(alpha_data + d);
+        fVec alpha_fvec1 = fVec::loadu(alpha_data + d + fVec::size());
+        fVec beta_fvec0 = fVec::loadu(beta_data + d);
+        fVec beta_fvec1 = fVec::loadu(beta_data + d + fVec::size());
+        bVec data_bvec = bVec::loadu(input_ptr + d);
+        fVec data_fvec0, data_fvec1;
+        std::tie(data_fvec0, data_fvec1) = convert_bfloat16_float(data_bvec);
+
+        fVec out_fvec0 = vec::maximum(data_fvec0 * alpha_fvec0 + beta_fvec0, zero_fvec);
+        fVec out_fvec1 = vec::maximum(data_fvec1 * alpha_fvec1 + beta_fvec1, zero_fvec);
+        bVec out_bvec = convert_float_bfloat16(out_fvec0, out_fvec1);
+        out_bvec.store(output_ptr + d);
+      }
+      for (; d < n_channel; d++) {
+        float out_val = float(input_ptr[d]) * alpha_data[d] + beta_data[d];
+        output_ptr[d] = BFloat16(out_val > float(0) ? out_val : float(0));
+      }
+    }
+  });
+}
+
 template <typename param_t>
 inline void batch_norm_cpu_collect_stats_contiguous_internal(
     Tensor& mean, Tensor& var_sum, const Tensor& input) {
@@ -1254,6 +1373,21 @@ void batch_norm_cpu_kernel(Tensor& output, const Tensor& input,
   }
 }
 
+void batch_norm_cpu_relu_kernel(Tensor& output, const Tensor& input,
+    const Tensor& weight, const Tensor& bias, const Tensor& save_mean,  const Tensor& save_invstd,
+    const Tensor& running_mean, const Tensor& running_var, bool train, double eps) {
+  int64_t image_size = input.numel() / input.size(0) / input.size(1);
+  if (input.is_contiguous(at::MemoryFormat::ChannelsLast) ||
+      (input.is_contiguous() && image_size == 1)) { // NC11 is also channels last
+    AT_DISPATCH_FLOATING_TYPES_AND(ScalarType::BFloat16, input.scalar_type(), "batch_norm_cpu_relu_channels_last", [&] {
+      batch_norm_cpu_channels_last_relu_impl<scalar_t>(output, input, weight, bias,
+          save_mean, save_invstd, running_mean, running_var, train, eps);
+    });
+  } else {
+    TORCH_CHECK(false, "batch_norm_cpu_relu_kernel: expecting input to be channels last contiguous.");
+  }
+}
+
 void batch_norm_cpu_collect_stats_kernel(
     Tensor& mean, Tensor& var_sum, const Tensor& input) {
   int64_t image_size = input.numel() / input.size(0) / input.size(1);
@@ -1302,6 +1436,7 @@ void batch_norm_cpu_backward_kernel(Tensor& grad_input, Tensor& grad_weight, Ten
 }// anonymous namespace
 
 REGISTER_DISPATCH(batch_norm_cpu_stub, &batch_norm_cpu_kernel);
+REGISTER_DISPATCH(batch_norm_cpu_relu_stub, &batch_norm_cpu_relu_kernel);
 REGISTER_DISPATCH(batch_norm_cpu_collect_stats_stub, &batch_norm_cpu_collect_stats_kernel);
 REGISTER_DISPATCH(batch_norm_cpu_backward_stub, &batch_norm_cpu_backward_kernel);
 
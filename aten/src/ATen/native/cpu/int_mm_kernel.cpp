@@ -0,0 +1,157 @@
+#define TORCH_ASSERT_ONLY_METHOD_OPERATORS
+#include <ATen/core/Tensor.h>
+
+#include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/native/cpu/int_mm_kernel.h>
+#include <c10/util/irange.h>
+
+namespace at { namespace native {
+
+namespace {
+
+// Kernels for weight-only quantized matmul: the activation matrix stays in
+// floating point while the weight matrix is stored as int8 (one scale per
+// output channel) or as packed int4 (two values per byte, one scale and
+// zero point per qGroupSize-element group of an output channel), and is
+// dequantized in-register inside the inner loop.
+//
+// The hot loops are deliberately plain scalar code: this file is compiled
+// once per CPU capability with the matching -m flags, so the dequant + fma
+// loops autovectorize to the widest ISA available (AVX-512 included)
+// without maintaining per-level intrinsics.
+
+// Pack an int32 [N, K] matrix of 4-bit values (0..15) into [N, K/2] bytes,
+// low nibble first along K.
+void weight_to_int4pack_kernel(const Tensor& weight_packed, const Tensor& weight) {
+  uint8_t* packed = weight_packed.data_ptr<uint8_t>();
+  const int32_t* w = weight.data_ptr<int32_t>();
+  const int64_t N = weight.size(0);
+  const int64_t K = weight.size(1);
+  const int64_t Kh = K / 2;
+  at::parallel_for(0, N, 1, [&](int64_t begin, int64_t end) {
+    for (const auto n : c10::irange(begin, end)) {
+      const int32_t* src = w + n * K;
+      uint8_t* dst = packed + n * Kh;
+      for (const auto k : c10::irange(Kh)) {
+        uint8_t lo = static_cast<uint8_t>(src[2 * k] & 0xf);
+        uint8_t hi = static_cast<uint8_t>(src[2 * k + 1] & 0xf);
+        dst[k] = lo | (hi << 4);
+      }
+    }
+  });
+}
+
+// C [M, N] = A [M, K] @ dequant(B) [N, K]^T where a weight with quantized
+// value q in group g of row n dequantizes to
+//   (q - 8) * scale[g][n] + zero[g][n].
+// The zero-point contribution is factored out of the inner loop: per group
+// it only needs the plain sum of the activations, so the k-loop is two fmas
+// per packed byte.
+template <typename scalar_t>
+void int4pack_mm_kernel_impl(
+    const Tensor& C,
+    const Tensor& A,
+    const Tensor& B,
+    int64_t qGroupSize,
+    const Tensor& qScaleAndZeros) {
+  const scalar_t* a = A.data_ptr<scalar_t>();
+  const uint8_t* b = B.data_ptr<uint8_t>();
+  const float* qsz = qScaleAndZeros.data_ptr<float>();
+  scalar_t* c = C.data_ptr<scalar_t>();
+  const int64_t M = A.size(0);
+  const int64_t K = A.size(1);
+  const int64_t N = B.size(0);
+  const int64_t groups = K / qGroupSize;
+
+  const int64_t grain = std::max<int64_t>(1, internal::GRAIN_SIZE / K);
+  at::parallel_for(0, M * N, grain, [&](int64_t begin, int64_t end) {
+    for (const auto i : c10::irange(begin, end)) {
+      const int64_t m = i / N;
+      const int64_t n = i % N;
+      const scalar_t* a_row = a + m * K;
+      const uint8_t* b_row = b + n * (K / 2);
+      float acc = 0.f;
+      for (const auto g : c10::irange(groups)) {
+        const float scale = qsz[(g * N + n) * 2];
+        const float zero = qsz[(g * N + n) * 2 + 1];
+        const int64_t k_begin = g * qGroupSize;
+        float group_dot = 0.f;
+        float group_sum = 0.f;
+        for (int64_t k = k_begin; k < k_begin + qGroupSize; k += 2) {
+          const uint8_t byte = b_row[k / 2];
+          const float w0 = static_cast<float>(byte & 0xf) - 8.f;
+          const float w1 = static_cast<float>(byte >> 4) - 8.f;
+          const float a0 = static_cast<float>(a_row[k]);
+          const float a1 = static_cast<float>(a_row[k + 1]);
+          group_dot += a0 * w0 + a1 * w1;
+          group_sum += a0 + a1;
+        }
+        acc += scale * group_dot + zero * group_sum;
+      }
+      c[m * N + n] = static_cast<scalar_t>(acc);
+    }
+  });
+}
+
+// C [M, N] = A [M, K] @ dequant(B) [N, K]^T with one scale per row of B.
+template <typename scalar_t>
+void int8pack_mm_kernel_impl(
+    const Tensor& C,
+    const Tensor& A,
+    const Tensor& B,
+    const Tensor& scales) {
+  const scalar_t* a = A.data_ptr<scalar_t>();
+  const int8_t* b = B.data_ptr<int8_t>();
+  const scalar_t* s = scales.data_ptr<scalar_t>();
+  scalar_t* c = C.data_ptr<scalar_t>();
+  const int64_t M = A.size(0);
+  const int64_t K = A.size(1);
+  const int64_t N = B.size(0);
+
+  const int64_t grain = std::max<int64_t>(1, internal::GRAIN_SIZE / K);
+  at::parallel_for(0, M * N, grain, [&](int64_t begin, int64_t end) {
+    for (const auto i : c10::irange(begin, end)) {
+      const int64_t m = i / N;
+      const int64_t n = i % N;
+      const scalar_t* a_row = a + m * K;
+      const int8_t* b_row = b + n * K;
+      float acc = 0.f;
+      for (const auto k : c10::irange(K)) {
+        acc += static_cast<float>(a_row[k]) * static_cast<float>(b_row[k]);
+      }
+      c[m * N + n] = static_cast<scalar_t>(static_cast<float>(s[n]) * acc);
+    }
+  });
+}
+
+void int4pack_mm_kernel(
+    const Tensor& C,
+    const Tensor& A,
+    const Tensor& B,
+    int64_t qGroupSize,
+    const Tensor& qScaleAndZeros) {
+  AT_DISPATCH_FLOATING_TYPES_AND2(
+      ScalarType::Half, ScalarType::BFloat16, A.scalar_type(), "int4pack_mm_cpu", [&]() {
+    int4pack_mm_kernel_impl<scalar_t>(C, A, B, qGroupSize, qScaleAndZeros);
+  });
+}
+
+void int8pack_mm_kernel(
+    const Tensor& C,
+    const Tensor& A,
+    const Tensor& B,
+    const Tensor& scales) {
+  AT_DISPATCH_FLOATING_TYPES_AND2(
+      ScalarType::Half, ScalarType::BFloat16, A.scalar_type(), "int8pack_mm_cpu", [&]() {
+    int8pack_mm_kernel_impl<scalar_t>(C, A, B, scales);
+  });
+}
+
+} // anonymous namespace
+
+REGISTER_DISPATCH(weight_to_int4pack_stub, &weight_to_int4pack_kernel);
+REGISTER_DISPATCH(int4pack_mm_stub, &int4pack_mm_kernel);
+REGISTER_DISPATCH(int8pack_mm_stub, &int8pack_mm_kernel);
+
+}} // at::native
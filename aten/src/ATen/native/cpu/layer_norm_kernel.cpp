@@ -6,8 +6,10 @@
 
 #include <ATen/core/Tensor.h>
 #include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
 #include <ATen/cpu/vec/functional.h>
 #include <ATen/cpu/vec/vec.h>
+#include <ATen/native/CPUBlas.h>
 #include <ATen/native/cpu/moments_utils.h>
 #include <c10/util/irange.h>
 
@@ -103,6 +105,219 @@ void LayerNormKernelImpl(
   });
 }
 
+template <typename T>
+void LayerNormLinearKernelImplInternal(
+    const Tensor& X,
+    const Tensor& gamma,
+    const Tensor& beta,
+    int64_t M,
+    int64_t N,
+    T eps,
+    const Tensor& fc_weight,
+    const Tensor& fc_bias,
+    Tensor* Y) {
+  using Vec = vec::Vectorized<T>;
+  DCHECK_EQ(X.numel(), M * N);
+  DCHECK(!gamma.defined() || gamma.numel() == N);
+  DCHECK(!beta.defined() || beta.numel() == N);
+  const T* X_data = X.data_ptr<T>();
+  const T* gamma_data = gamma.defined() ? gamma.data_ptr<T>() : nullptr;
+  const T* beta_data = beta.defined() ? beta.data_ptr<T>() : nullptr;
+  const T* W_data = fc_weight.data_ptr<T>();
+  const T* fc_bias_data = fc_bias.defined() ? fc_bias.data_ptr<T>() : nullptr;
+  const int64_t K = fc_weight.size(0);
+  T* Y_data = Y->data_ptr<T>();
+
+  const bool gamma_null = gamma_data == nullptr;
+  const bool beta_null = beta_data == nullptr;
+
+  // Normalize a block of rows into a per-thread buffer and immediately
+  // feed the block to the GEMM, so the normalized activation stays cache
+  // resident instead of making a round trip through DRAM between the two
+  // ops. The block is sized to roughly half of a typical 32K L1d.
+  constexpr int64_t kTileBytes = 16384;
+  const int64_t block_rows =
+      std::max(int64_t(1), kTileBytes / (int64_t(sizeof(T)) * N));
+  const int64_t num_blocks = divup(M, block_rows);
+  at::parallel_for(0, num_blocks, 1, [&](int64_t begin, int64_t end) {
+    std::vector<T> buf(block_rows * N);
+    T* buf_data = buf.data();
+    for (const auto b : c10::irange(begin, end)) {
+      const int64_t row_begin = b * block_rows;
+      const int64_t rows = std::min(block_rows, M - row_begin);
+      for (const auto i : c10::irange(rows)) {
+        const T* X_ptr = X_data + (row_begin + i) * N;
+        T* buf_ptr = buf_data + i * N;
+        T mean_val;
+        T rstd_val;
+        std::tie(mean_val, rstd_val) = utils::RowwiseMoments(X_ptr, N);
+        rstd_val = T(1) / std::sqrt(rstd_val + eps);
+        const T scale = rstd_val;
+        const T bias = -rstd_val * mean_val;
+        if (gamma_null || beta_null) {
+          for (const auto j : c10::irange(N)) {
+            const T gamma_v = gamma_null ? T(1) : gamma_data[j];
+            const T beta_v = beta_null ? T(0) : beta_data[j];
+            buf_ptr[j] = (X_ptr[j] * scale + bias) * gamma_v + beta_v;
+          }
+        } else {
+          vec::map3<T>(
+              [scale, bias](Vec x, Vec gamma, Vec beta) {
+                return (x * Vec(scale) + Vec(bias)) * gamma + beta;
+              },
+              buf_ptr,
+              X_ptr,
+              gamma_data,
+              beta_data,
+              N);
+        }
+      }
+      // Row-major Y[rows x K] = buf[rows x N] * W^T, expressed in the
+      // column-major convention of cpublas::gemm.
+      cpublas::gemm(
+          TransposeType::Transpose,
+          TransposeType::NoTranspose,
+          K,
+          rows,
+          N,
+          T(1),
+          W_data,
+          N,
+          buf_data,
+          N,
+          T(0),
+          Y_data + row_begin * K,
+          K);
+      if (fc_bias_data != nullptr) {
+        for (const auto i : c10::irange(rows)) {
+          T* Y_ptr = Y_data + (row_begin + i) * K;
+          vec::map2<T>(
+              [](Vec y, Vec fc_bias) { return y + fc_bias; },
+              Y_ptr,
+              Y_ptr,
+              fc_bias_data,
+              K);
+        }
+      }
+    }
+  });
+}
+
+void LayerNormLinearKernelImpl(
+    const Tensor& X,
+    const Tensor& gamma,
+    const Tensor& beta,
+    int64_t M,
+    int64_t N,
+    double eps,
+    const Tensor& fc_weight,
+    const Tensor& fc_bias,
+    Tensor* Y) {
+  AT_DISPATCH_FLOATING_TYPES(X.scalar_type(),
+      "LayerNormLinearKernelImpl", [&]() {
+    LayerNormLinearKernelImplInternal<scalar_t>(
+        X, gamma, beta, M, N, static_cast<scalar_t>(eps), fc_weight,
+        fc_bias, Y);
+  });
+}
+
+template <typename T>
+void DropoutAddLayerNormKernelImplInternal(
+    const Tensor& X,
+    const Tensor& R,
+    const Tensor& mask,
+    T dropout_scale,
+    const Tensor& gamma,
+    const Tensor& beta,
+    int64_t M,
+    int64_t N,
+    T eps,
+    Tensor* Y,
+    Tensor* mean,
+    Tensor* rstd) {
+  using T_ACC = vec::vec_scalar_t<T>;
+  using Vec = vec::Vectorized<T_ACC>;
+  DCHECK_EQ(X.numel(), M * N);
+  DCHECK_EQ(R.numel(), M * N);
+  DCHECK_EQ(mask.numel(), M * N);
+  DCHECK(!gamma.defined() || gamma.numel() == N);
+  DCHECK(!beta.defined() || beta.numel() == N);
+  const T* X_data = X.data_ptr<T>();
+  const T* R_data = R.data_ptr<T>();
+  const bool* mask_data = mask.data_ptr<bool>();
+  const T* gamma_data = gamma.defined() ? gamma.data_ptr<T>() : nullptr;
+  const T* beta_data = beta.defined() ? beta.data_ptr<T>() : nullptr;
+  T* Y_data = Y->data_ptr<T>();
+  T* mean_data = mean->data_ptr<T>();
+  T* rstd_data = rstd->data_ptr<T>();
+
+  const bool gamma_null = gamma_data == nullptr;
+  const bool beta_null = beta_data == nullptr;
+  at::parallel_for(0, M, 1, [&](int64_t start, int64_t end) {
+    // The masked-and-shifted row is kept in a thread-local buffer, so the
+    // dropout, residual add and normalization are a single cache-resident
+    // pass per row instead of three activation-sized memory round trips.
+    std::vector<T> buf(N);
+    T* buf_data = buf.data();
+    for (const auto i : c10::irange(start, end)) {
+      const T* X_ptr = X_data + i * N;
+      const T* R_ptr = R_data + i * N;
+      const bool* mask_ptr = mask_data + i * N;
+      T* Y_ptr = Y_data + i * N;
+      for (const auto j : c10::irange(N)) {
+        buf_data[j] =
+            (mask_ptr[j] ? X_ptr[j] * dropout_scale : T(0)) + R_ptr[j];
+      }
+      T mean_val;
+      T rstd_val;
+      std::tie(mean_val, rstd_val) = utils::RowwiseMoments(buf_data, N);
+      rstd_val = T(1) / std::sqrt(rstd_val + eps);
+      const T_ACC scale = rstd_val;
+      const T_ACC bias = -rstd_val * mean_val;
+      if (gamma_null || beta_null) {
+        for (const auto j : c10::irange(N)) {
+          const T gamma_v = gamma_null ? T(1) : gamma_data[j];
+          const T beta_v = beta_null ? T(0) : beta_data[j];
+          Y_ptr[j] = (buf_data[j] * scale + bias) * gamma_v + beta_v;
+        }
+      } else {
+        vec::map3<T>(
+            [scale, bias](Vec x, Vec gamma, Vec beta) {
+              return (x * Vec(scale) + Vec(bias)) * gamma + beta;
+            },
+            Y_ptr,
+            buf_data,
+            gamma_data,
+            beta_data,
+            N);
+      }
+      mean_data[i] = mean_val;
+      rstd_data[i] = rstd_val;
+    }
+  });
+}
+
+void DropoutAddLayerNormKernelImpl(
+    const Tensor& X,
+    const Tensor& R,
+    const Tensor& mask,
+    double dropout_scale,
+    const Tensor& gamma,
+    const Tensor& beta,
+    int64_t M,
+    int64_t N,
+    double eps,
+    Tensor* Y,
+    Tensor* mean,
+    Tensor* rstd) {
+  AT_DISPATCH_FLOATING_TYPES_AND(at::ScalarType::BFloat16, X.scalar_type(),
+      "DropoutAddLayerNormKernelImpl", [&]() {
+    DropoutAddLayerNormKernelImplInternal<scalar_t>(
+        X, R, mask, static_cast<scalar_t>(dropout_scale), gamma, beta, M, N,
+        static_cast<scalar_t>(eps), Y, mean, rstd);
+  });
+}
+
 template <typename T>
 void LayerNormBackwardKernelImplInternal(
     const Tensor& dY,
@@ -306,10 +521,224 @@ void LayerNormBackwardKernelImpl(
   });
 }
 
+template <typename T>
+void DropoutAddLayerNormBackwardKernelImplInternal(
+    const Tensor& dY,
+    const Tensor& X,
+    const Tensor& R,
+    const Tensor& mask,
+    T dropout_scale,
+    const Tensor& mean,
+    const Tensor& rstd,
+    const Tensor& gamma,
+    int64_t M,
+    int64_t N,
+    Tensor* dX,
+    Tensor* dR,
+    Tensor* dgamma,
+    Tensor* dbeta) {
+  using T_ACC = vec::vec_scalar_t<T>;
+  using Vec = vec::Vectorized<T_ACC>;
+  DCHECK_EQ(dY.numel(), M * N);
+  DCHECK_EQ(X.numel(), M * N);
+  DCHECK_EQ(R.numel(), M * N);
+  DCHECK_EQ(mask.numel(), M * N);
+  DCHECK_EQ(mean.numel(), M);
+  DCHECK_EQ(rstd.numel(), M);
+  DCHECK(!gamma.defined() || gamma.numel() == N);
+  const T* dY_data = dY.template data_ptr<T>();
+  const T* X_data = X.template data_ptr<T>();
+  const T* R_data = R.template data_ptr<T>();
+  const bool* mask_data = mask.template data_ptr<bool>();
+  const T* mean_data = mean.template data_ptr<T>();
+  const T* rstd_data = rstd.template data_ptr<T>();
+  const T* gamma_data =
+      gamma.defined() ? gamma.template data_ptr<T>() : nullptr;
+  T* dX_data = dX->defined() ? dX->template data_ptr<T>() : nullptr;
+  T* dR_data = dR->defined() ? dR->template data_ptr<T>() : nullptr;
+  T* dgamma_data = dgamma->defined() ? dgamma->template data_ptr<T>() : nullptr;
+  T* dbeta_data = dbeta->defined() ? dbeta->template data_ptr<T>() : nullptr;
+  const T_ACC scale = T_ACC(1) / static_cast<T_ACC>(N);
+  const bool gamma_null = gamma_data == nullptr;
+  const bool dX_null = dX_data == nullptr;
+  const bool dR_null = dR_data == nullptr;
+  const bool dgamma_null = dgamma_data == nullptr;
+  const bool dbeta_null = dbeta_data == nullptr;
+
+  // Same two path reduction as LayerNormBackwardKernelImplInternal; the
+  // pre-norm sum Z = dropout(X) + R is not materialized by the forward, so
+  // each row is recomputed into a thread-local buffer and consumed while
+  // still cache resident.
+  int num_threads = at::get_num_threads();
+  Tensor buffer = at::empty({0}, X.options());
+  T* buffer_data = nullptr;
+  if (!dgamma_null || !dbeta_null) {
+    // zero the immediate buffer and skip zero dgamma and dbeta
+    buffer.resize_({2, num_threads, N}).zero_();
+    buffer_data = buffer.template data_ptr<T>();
+  }
+
+  at::parallel_for(0, M, 1, [&](int64_t start, int64_t end) {
+    int tid = at::get_thread_num();
+    TORCH_CHECK(
+        tid < num_threads,
+        "expect thread id smaller than ",
+        num_threads,
+        ", got thread id ",
+        tid);
+    T* dgamma_buffer_ptr = dgamma_null ? nullptr : buffer_data + tid * N;
+    T* dbeta_buffer_ptr =
+        dbeta_null ? nullptr : buffer_data + num_threads * N + tid * N;
+    std::vector<T> buf(N);
+    T* Z_ptr = buf.data();
+    for (const auto i : c10::irange(start, end)) {
+      const T* dY_ptr = dY_data + i * N;
+      const T* X_ptr = X_data + i * N;
+      const T* R_ptr = R_data + i * N;
+      const bool* mask_ptr = mask_data + i * N;
+      for (const auto j : c10::irange(N)) {
+        Z_ptr[j] = (mask_ptr[j] ? X_ptr[j] * dropout_scale : T(0)) + R_ptr[j];
+      }
+      if (!dgamma_null) {
+        const T_ACC a = rstd_data[i];
+        const T_ACC b = -a * mean_data[i];
+        vec::map3<T>(
+            [a, b](Vec dgamma, Vec dy, Vec z) {
+              return dgamma + dy * (Vec(a) * z + Vec(b));
+            },
+            dgamma_buffer_ptr,
+            dgamma_buffer_ptr,
+            dY_ptr,
+            Z_ptr,
+            N);
+      }
+      if (!dbeta_null) {
+        vec::map2<T>(
+            [](Vec dbeta, Vec dy) { return dbeta + dy; },
+            dbeta_buffer_ptr,
+            dbeta_buffer_ptr,
+            dY_ptr,
+            N);
+      }
+      if (!dX_null || !dR_null) {
+        T_ACC ds = T_ACC(0);
+        T_ACC db = T_ACC(0);
+        if (gamma_null) {
+          ds = vec::map2_reduce_all<T>(
+              [](Vec x, Vec y) { return x * y; },
+              [](Vec x, Vec y) { return x + y; },
+              dY_ptr,
+              Z_ptr,
+              N);
+          db = vec::reduce_all<T>(
+              [](Vec& x, Vec& y) { return x + y; }, dY_ptr, N);
+        } else {
+          ds = vec::map3_reduce_all<T>(
+              [](Vec x, Vec y, Vec z) { return x * y * z; },
+              [](Vec x, Vec y) { return x + y; },
+              dY_ptr,
+              Z_ptr,
+              gamma_data,
+              N);
+          db = vec::map2_reduce_all<T>(
+              [](Vec x, Vec y) { return x * y; },
+              [](Vec x, Vec y) { return x + y; },
+              dY_ptr,
+              gamma_data,
+              N);
+        }
+        const T_ACC a = rstd_data[i];
+        const T_ACC b = (db * mean_data[i] - ds) * a * a * a * scale;
+        const T_ACC c = -b * mean_data[i] - db * a * scale;
+        // dZ is the gradient of the pre-norm sum: it is dR as is, and dX
+        // after the dropout mask and scale are re-applied. Write it into
+        // whichever output is requested and derive the other from it.
+        T* dZ_ptr = dR_null ? dX_data + i * N : dR_data + i * N;
+        if (gamma_null) {
+          vec::map2<T>(
+              [a, b, c](Vec dy, Vec z) {
+                return Vec(a) * dy + Vec(b) * z + Vec(c);
+              },
+              dZ_ptr,
+              dY_ptr,
+              Z_ptr,
+              N);
+        } else {
+          vec::map3<T>(
+              [a, b, c](Vec dy, Vec gamma, Vec z) {
+                return Vec(a) * dy * gamma + Vec(b) * z + Vec(c);
+              },
+              dZ_ptr,
+              dY_ptr,
+              gamma_data,
+              Z_ptr,
+              N);
+        }
+        if (!dX_null) {
+          T* dX_ptr = dX_data + i * N;
+          for (const auto j : c10::irange(N)) {
+            dX_ptr[j] = mask_ptr[j] ? dZ_ptr[j] * dropout_scale : T(0);
+          }
+        }
+      }
+    }
+  });
+
+  // Second path of dgamma/dbeta
+  if (buffer_data != nullptr) {
+    parallel_for(0, N, 1, [&](int64_t start, int64_t end) {
+      for (const auto j : c10::irange(start, end)) {
+        T_ACC dgamma_v = T_ACC(0);
+        T_ACC dbeta_v = T_ACC(0);
+        for (const auto i : c10::irange(num_threads)) {
+          dgamma_v += buffer_data[i * N + j];
+          dbeta_v += buffer_data[num_threads * N + i * N + j];
+        }
+        if (!dgamma_null) {
+          // NOLINTNEXTLINE(clang-analyzer-core.NullDereference)
+          dgamma_data[j] = dgamma_v;
+        }
+        if (!dbeta_null) {
+          // NOLINTNEXTLINE(clang-analyzer-core.NullDereference)
+          dbeta_data[j] = dbeta_v;
+        }
+      }
+    });
+  }
+}
+
+void DropoutAddLayerNormBackwardKernelImpl(
+    const Tensor& dY,
+    const Tensor& X,
+    const Tensor& R,
+    const Tensor& mask,
+    double dropout_scale,
+    const Tensor& mean,
+    const Tensor& rstd,
+    const Tensor& gamma,
+    int64_t M,
+    int64_t N,
+    Tensor* dX,
+    Tensor* dR,
+    Tensor* dgamma,
+    Tensor* dbeta) {
+  AT_DISPATCH_FLOATING_TYPES_AND(at::ScalarType::BFloat16, X.scalar_type(),
+      "DropoutAddLayerNormBackwardKernelImpl", [&]() {
+    DropoutAddLayerNormBackwardKernelImplInternal<scalar_t>(
+        dY.contiguous(), X, R, mask, static_cast<scalar_t>(dropout_scale),
+        mean, rstd, gamma, M, N, dX, dR, dgamma, dbeta);
+  });
+}
+
 } // namespace
 
 REGISTER_DISPATCH(LayerNormKernel, &LayerNormKernelImpl);
 REGISTER_DISPATCH(LayerNormBackwardKernel, &LayerNormBackwardKernelImpl);
+REGISTER_DISPATCH(LayerNormLinearKernel, &LayerNormLinearKernelImpl);
+REGISTER_DISPATCH(DropoutAddLayerNormKernel, &DropoutAddLayerNormKernelImpl);
+REGISTER_DISPATCH(
+    DropoutAddLayerNormBackwardKernel,
+    &DropoutAddLayerNormBackwardKernelImpl);
 
 } // namespace native
 } // namespace at
@@ -57,7 +57,7 @@ C10_ALWAYS_INLINE void AddMomentsVec(
 // https://en.wikipedia.org/wiki/Algorithms_for_calculating_variance
 // https://en.wikipedia.org/wiki/Pairwise_summation
 template <typename T, int64_t kMaxDepth>
-std::pair<T, T> RowwiseMomentsImpl(const T* X, int64_t N, int64_t ddof = 0) {
+std::pair<T, T> RowwiseMomentsImpl(const T* X, int64_t N) {
   using Vec = vec::Vectorized<T>;
 
   constexpr int64_t kVecSize = Vec::size();
@@ -127,29 +127,41 @@ std::pair<T, T> RowwiseMomentsImpl(const T* X, int64_t N, int64_t ddof = 0) {
     AddMoments(n, m1_arr[i], m2_arr[i], m0, m1, m2);
   }
 
-  return std::make_pair(m1, m2 / static_cast<T>(N - ddof));
+  return std::make_pair(m1, m2);
 }
 
+// Like RowwiseMoments below, but returns the raw centered second moment
+// instead of dividing by (N - ddof). This lets callers combine partial
+// results computed by different threads with AddMoments before applying
+// their own correction term.
 template <typename T>
-std::pair<T, T> RowwiseMoments(const T* X, int64_t N, int64_t ddof = 0) {
+std::pair<T, T> RowwiseMomentsRaw(const T* X, int64_t N) {
   using Vec = vec::Vectorized<T>;
   constexpr int64_t kVecSize = Vec::size();
   const int64_t n = N / kVecSize;
   const int64_t m = divup(n, kChunkSize);
   const int64_t depth = CeilLog2(m);
   if (depth <= 4) {
-    return RowwiseMomentsImpl<T, 4>(X, N, ddof);
+    return RowwiseMomentsImpl<T, 4>(X, N);
   } else if (depth <= 8) {
-    return RowwiseMomentsImpl<T, 8>(X, N, ddof);
+    return RowwiseMomentsImpl<T, 8>(X, N);
   } else if (depth <= 16) {
-    return RowwiseMomentsImpl<T, 16>(X, N, ddof);
+    return RowwiseMomentsImpl<T, 16>(X, N);
   } else if (depth <= 32) {
-    return RowwiseMomentsImpl<T, 32>(X, N, ddof);
+    return RowwiseMomentsImpl<T, 32>(X, N);
   } else {
-    return RowwiseMomentsImpl<T, 64>(X, N, ddof);
+    return RowwiseMomentsImpl<T, 64>(X, N);
   }
 }
 
+template <typename T>
+std::pair<T, T> RowwiseMoments(const T* X, int64_t N, int64_t ddof = 0) {
+  // NOLINTNEXTLINE(cppcoreguidelines-init-variables)
+  T m1, m2;
+  std::tie(m1, m2) = RowwiseMomentsRaw(X, N);
+  return std::make_pair(m1, m2 / static_cast<T>(N - ddof));
+}
+
 } // namespace utils
 } // namespace native
 } // namespace at
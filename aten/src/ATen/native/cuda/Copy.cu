@@ -10,6 +10,10 @@
 #include <ATen/native/Copy.h>
 #include <ATen/native/TensorIterator.h>
 #include <ATen/native/cuda/Loops.cuh>
+#include <c10/util/irange.h>
+
+#include <algorithm>
+#include <cstring>
 
 #ifndef AT_PER_OPERATOR_HEADERS
 #include <ATen/Functions.h>
@@ -157,6 +161,96 @@ static bool maybe_enable_p2p_access(Device dst_device, Device src_device) {
   return at::cuda::get_p2p_access(src_device.index(), dst_device.index());
 }
 
+// Note [Chunked pageable copy]
+// A single blocking cudaMemcpy between pageable host memory and the device
+// makes the driver stage the whole transfer through its own (small) pinned
+// buffer, serializing the host-side paging work with the PCIe DMA. For large
+// transfers we instead split the copy into fixed-size chunks double-buffered
+// through two pinned staging buffers from the caching host allocator: while
+// one chunk is in flight on a dedicated copy stream, the host packs (H2D) or
+// drains (D2H) the other. Running on a side stream also keeps the transfer
+// from blocking kernels queued on the current stream after this copy. Pinned
+// host memory doesn't take this path: it is already a single DMA, and
+// chunking it through staging would only add copies. The size threshold is
+// configurable via at::globalContext().setChunkedPageableCopyThreshold().
+static void chunked_pageable_copy_and_sync(
+    void* dst,
+    void* src,
+    int64_t nbytes,
+    cudaMemcpyKind kind,
+    CUDAStream current_stream) {
+  constexpr int64_t kChunkBytes = 32 * 1024 * 1024;
+
+  // The copy stream still has to order after all work already queued on the
+  // current stream that may touch the device buffer.
+  CUDAStream copy_stream = getStreamFromPool(
+      /*isHighPriority=*/false, current_stream.device_index());
+  CUDAEvent device_ready;
+  device_ready.record(current_stream);
+  device_ready.block(copy_stream);
+
+  at::DataPtr staging[2] = {HostAlloc(kChunkBytes), HostAlloc(kChunkBytes)};
+  CUDAEvent chunk_done[2];
+  const int64_t num_chunks = (nbytes + kChunkBytes - 1) / kChunkBytes;
+
+  if (kind == cudaMemcpyDeviceToHost) {
+    // Drain chunk i - 1 into the pageable destination while chunk i is in
+    // flight. Reusing staging buffer (i % 2) for chunk i is safe because its
+    // previous occupant, chunk i - 2, was drained on the host one iteration
+    // ago.
+    for (const auto i : c10::irange(num_chunks)) {
+      const int64_t offset = i * kChunkBytes;
+      const int64_t len = std::min(kChunkBytes, nbytes - offset);
+      AT_CUDA_CHECK(cudaMemcpyAsync(
+          staging[i % 2].get(),
+          static_cast<char*>(src) + offset,
+          len,
+          cudaMemcpyDeviceToHost,
+          copy_stream));
+      chunk_done[i % 2].record(copy_stream);
+      if (i > 0) {
+        const int64_t prev_offset = (i - 1) * kChunkBytes;
+        chunk_done[(i - 1) % 2].synchronize();
+        std::memcpy(
+            static_cast<char*>(dst) + prev_offset,
+            staging[(i - 1) % 2].get(),
+            std::min(kChunkBytes, nbytes - prev_offset));
+      }
+    }
+    const int64_t last_offset = (num_chunks - 1) * kChunkBytes;
+    chunk_done[(num_chunks - 1) % 2].synchronize();
+    std::memcpy(
+        static_cast<char*>(dst) + last_offset,
+        staging[(num_chunks - 1) % 2].get(),
+        nbytes - last_offset);
+  } else {
+    TORCH_INTERNAL_ASSERT(kind == cudaMemcpyHostToDevice);
+    // Pack chunk i into staging while chunk i - 1 is in flight. Before
+    // overwriting staging buffer (i % 2) we have to wait for chunk i - 2 to
+    // be consumed by the DMA.
+    for (const auto i : c10::irange(num_chunks)) {
+      const int64_t offset = i * kChunkBytes;
+      const int64_t len = std::min(kChunkBytes, nbytes - offset);
+      if (i >= 2) {
+        chunk_done[i % 2].synchronize();
+      }
+      std::memcpy(
+          staging[i % 2].get(), static_cast<char*>(src) + offset, len);
+      AT_CUDA_CHECK(cudaMemcpyAsync(
+          static_cast<char*>(dst) + offset,
+          staging[i % 2].get(),
+          len,
+          cudaMemcpyHostToDevice,
+          copy_stream));
+      chunk_done[i % 2].record(copy_stream);
+    }
+  }
+
+  // This is a blocking copy: fully synchronize before the staging buffers
+  // are handed back to the caching host allocator.
+  c10::cuda::stream_synchronize(copy_stream);
+}
+
 static void copy_kernel_cuda(TensorIterator& iter, bool non_blocking) {
   AT_ASSERT(iter.ntensors() == 2);
 
@@ -251,7 +345,16 @@ static void copy_kernel_cuda(TensorIterator& iter, bool non_blocking) {
     CachingHostAllocator_recordEvent(ptr, ctx, stream);
 
   } else {
-    at::cuda::memcpy_and_sync(dst, src, nbytes, kind, stream);
+    const auto& host_tensor =
+        (dst_device == kCPU ? iter.tensor(0) : iter.tensor(1));
+    const auto threshold = at::globalContext().chunkedPageableCopyThreshold();
+    if (threshold > 0 && static_cast<size_t>(nbytes) >= threshold &&
+        !host_tensor.is_pinned()) {
+      // See Note [Chunked pageable copy]
+      chunked_pageable_copy_and_sync(dst, src, nbytes, kind, stream);
+    } else {
+      at::cuda::memcpy_and_sync(dst, src, nbytes, kind, stream);
+    }
   }
 
   if (iter.tensor(0).is_conj() != iter.tensor(1).is_conj()) {
@@ -0,0 +1,276 @@
+#define TORCH_ASSERT_ONLY_METHOD_OPERATORS
+#include <ATen/Dispatch.h>
+#include <ATen/OpMathType.h>
+#include <ATen/native/ForeachUtils.h>
+#include <ATen/native/FusedOptimizerOps.h>
+#include <ATen/native/cuda/ForeachFunctors.cuh>
+#include <ATen/native/cuda/MultiTensorApply.cuh>
+
+#ifndef AT_PER_OPERATOR_HEADERS
+#include <ATen/NativeFunctions.h>
+#else
+#include <ATen/ops/_fused_adam_native.h>
+#include <ATen/ops/_fused_adamw_native.h>
+#endif
+
+namespace at { namespace native {
+
+namespace {
+
+// Whole Adam/AdamW update in one multi_tensor_apply pass per parameter
+// chunk, instead of the 6 passes a chain of `_foreach_*` calls makes over
+// parameter memory. The math mirrors adam_math in
+// cpu/FusedOptimizerKernels.cpp. The per-tensor step count rides in the
+// scalar_vals slot of the metadata, so tensors at different steps can
+// share one launch; bias corrections are derived from it per tensor.
+// With amsgrad the depth is 5 and the last list is max_exp_avg_sqs.
+template<typename T, int depth, ADAM_MODE mode>
+struct FusedAdamFunctor {
+    using opmath_t = at::opmath_type<T>;
+    __device__ __forceinline__ void operator() (
+        int chunk_size,
+        TensorListScalarListMetadata<opmath_t, depth>& tl,
+        double lr,
+        double beta1,
+        double beta2,
+        double weight_decay,
+        double eps,
+        bool maximize) {
+            int tensor_loc = tl.block_to_tensor[blockIdx.x];
+            int chunk_idx = tl.block_to_chunk[blockIdx.x];
+            int n = tl.numel_for_tensor[tensor_loc];
+
+            const double step = static_cast<double>(tl.scalar_vals[tensor_loc]);
+            const opmath_t step_size =
+                static_cast<opmath_t>(lr / (1 - ::pow(beta1, step)));
+            const opmath_t bias_correction2_sqrt =
+                static_cast<opmath_t>(::sqrt(1 - ::pow(beta2, step)));
+            const opmath_t wd = static_cast<opmath_t>(weight_decay);
+            const opmath_t adamw_decay =
+                static_cast<opmath_t>(1 - lr * weight_decay);
+
+            T* args[depth];
+            bool all_aligned = init_args<depth>(args, tl, chunk_idx, chunk_size, tensor_loc);
+            n -= chunk_idx * chunk_size;
+            T r_args[depth][kILP];
+
+            if(n % kILP == 0 && chunk_size % kILP == 0 && all_aligned) {
+                for(int i_start = threadIdx.x; i_start * kILP < n && i_start * kILP < chunk_size; i_start += blockDim.x) {
+#pragma unroll
+                    for(int d = 0; d < depth; d++) {
+                        load_store(r_args[d], args[d], 0, i_start);
+                    }
+                    adam_math(
+                        r_args, step_size, bias_correction2_sqrt, wd, adamw_decay,
+                        static_cast<opmath_t>(beta1), static_cast<opmath_t>(beta2),
+                        static_cast<opmath_t>(eps), maximize);
+                    // param, exp_avg, exp_avg_sq and (with amsgrad)
+                    // max_exp_avg_sq are written back; grad is read-only.
+                    load_store(args[0], r_args[0], i_start, 0);
+#pragma unroll
+                    for(int d = 2; d < depth; d++) {
+                        load_store(args[d], r_args[d], i_start, 0);
+                    }
+                }
+            }
+            else {
+                for(int i_start = 0; i_start < n && i_start < chunk_size; i_start += blockDim.x * kILP) {
+                    load_args<depth>(r_args, args, i_start, chunk_size, n);
+                    adam_math(
+                        r_args, step_size, bias_correction2_sqrt, wd, adamw_decay,
+                        static_cast<opmath_t>(beta1), static_cast<opmath_t>(beta2),
+                        static_cast<opmath_t>(eps), maximize);
+                    store_args(args[0], r_args[0], i_start, chunk_size, n);
+#pragma unroll
+                    for(int d = 2; d < depth; d++) {
+                        store_args(args[d], r_args[d], i_start, chunk_size, n);
+                    }
+                }
+            }
+    }
+
+ private:
+    __device__ __forceinline__ void adam_math(
+        T r_args[depth][kILP],
+        opmath_t step_size,
+        opmath_t bias_correction2_sqrt,
+        opmath_t wd,
+        opmath_t adamw_decay,
+        opmath_t beta1,
+        opmath_t beta2,
+        opmath_t eps,
+        bool maximize) {
+#pragma unroll
+            for(int ii = 0; ii < kILP; ii++) {
+                opmath_t p = static_cast<opmath_t>(r_args[0][ii]);
+                opmath_t g = static_cast<opmath_t>(r_args[1][ii]);
+                opmath_t m = static_cast<opmath_t>(r_args[2][ii]);
+                opmath_t v = static_cast<opmath_t>(r_args[3][ii]);
+                if (maximize) {
+                    g = -g;
+                }
+                if (wd != opmath_t(0)) {
+                    if (mode == ADAM_MODE::ADAMW) {
+                        p = p * adamw_decay;
+                    } else {
+                        g = g + p * wd;
+                    }
+                }
+                m = beta1 * m + (opmath_t(1) - beta1) * g;
+                v = beta2 * v + (opmath_t(1) - beta2) * g * g;
+                opmath_t denom_src = v;
+                if (depth == 5) {
+                    // r_args[depth - 1] is max_exp_avg_sq.
+                    denom_src = ::max(
+                        static_cast<opmath_t>(r_args[depth - 1][ii]), v);
+                    r_args[depth - 1][ii] = static_cast<T>(denom_src);
+                }
+                const opmath_t denom =
+                    ::sqrt(denom_src) / bias_correction2_sqrt + eps;
+                p = p - step_size * m / denom;
+                r_args[0][ii] = static_cast<T>(p);
+                r_args[2][ii] = static_cast<T>(m);
+                r_args[3][ii] = static_cast<T>(v);
+            }
+    }
+};
+
+void check_fused_optimizer_tensor_cuda(
+    const Tensor& t,
+    const Tensor& param,
+    const char* list_name) {
+    TORCH_CHECK(
+        t.is_cuda() && t.device() == param.device(),
+        "Fused optimizer kernels: expected all tensors to be on ",
+        param.device(), ", but ", list_name, " has a tensor on ", t.device());
+    TORCH_CHECK(
+        t.layout() == at::kStrided && t.is_contiguous(),
+        "Fused optimizer kernels: expected all tensors to be contiguous and "
+        "strided, but ", list_name, " has a tensor that is not");
+    TORCH_CHECK(
+        t.scalar_type() == param.scalar_type(),
+        "Fused optimizer kernels: expected all state tensors to match their "
+        "parameter's dtype, but got ", t.scalar_type(), " in ", list_name,
+        " for a ", param.scalar_type(), " parameter");
+    TORCH_CHECK(
+        t.numel() == param.numel(),
+        "Fused optimizer kernels: expected all state tensors to match their "
+        "parameter's number of elements, but got ", t.numel(), " in ",
+        list_name, " for a parameter with ", param.numel());
+}
+
+template<ADAM_MODE mode>
+void fused_adam_cuda_impl(
+    at::TensorList params,
+    at::TensorList grads,
+    at::TensorList exp_avgs,
+    at::TensorList exp_avg_sqs,
+    at::TensorList max_exp_avg_sqs,
+    at::TensorList state_steps,
+    const double lr,
+    const double beta1,
+    const double beta2,
+    const double weight_decay,
+    const double eps,
+    const bool amsgrad,
+    const bool maximize) {
+    check_foreach_api_restrictions(params, grads, exp_avgs);
+    check_foreach_api_restrictions(params, exp_avg_sqs, state_steps);
+    if (amsgrad) {
+        check_foreach_api_restrictions(params, max_exp_avg_sqs);
+    }
+    std::vector<Scalar> steps;
+    steps.reserve(params.size());
+    for (const auto i : c10::irange(params.size())) {
+        TORCH_CHECK(
+            at::isFloatingType(params[i].scalar_type()),
+            "Fused Adam only supports floating point parameters, got ",
+            params[i].scalar_type());
+        check_fused_optimizer_tensor_cuda(params[i], params[i], "params");
+        check_fused_optimizer_tensor_cuda(grads[i], params[i], "grads");
+        check_fused_optimizer_tensor_cuda(exp_avgs[i], params[i], "exp_avgs");
+        check_fused_optimizer_tensor_cuda(
+            exp_avg_sqs[i], params[i], "exp_avg_sqs");
+        if (amsgrad) {
+            check_fused_optimizer_tensor_cuda(
+                max_exp_avg_sqs[i], params[i], "max_exp_avg_sqs");
+        }
+        // Step counts stay on the host (matching the CPU kernels), so
+        // reading them here costs no device synchronization; they enter
+        // the launch through the metadata's scalar slot.
+        TORCH_CHECK(
+            state_steps[i].device().is_cpu(),
+            "Fused optimizer kernels: expected state_steps on CPU, got a "
+            "tensor on ", state_steps[i].device());
+        steps.emplace_back(state_steps[i].item<double>());
+    }
+
+    std::vector<std::vector<at::Tensor>> tensor_lists{
+        params.vec(), grads.vec(), exp_avgs.vec(), exp_avg_sqs.vec()};
+    if (amsgrad) {
+        tensor_lists.emplace_back(max_exp_avg_sqs.vec());
+    }
+
+    AT_DISPATCH_FLOATING_TYPES_AND2(
+        ScalarType::Half,
+        ScalarType::BFloat16,
+        params[0].scalar_type(),
+        "fused_adam_cuda",
+        [&]() {
+            if (amsgrad) {
+                multi_tensor_apply<5, double>(
+                    tensor_lists,
+                    steps,
+                    FusedAdamFunctor<scalar_t, 5, mode>(),
+                    lr, beta1, beta2, weight_decay, eps, maximize);
+            } else {
+                multi_tensor_apply<4, double>(
+                    tensor_lists,
+                    steps,
+                    FusedAdamFunctor<scalar_t, 4, mode>(),
+                    lr, beta1, beta2, weight_decay, eps, maximize);
+            }
+        });
+}
+
+} // namespace
+
+void _fused_adam_kernel_cuda_(
+    at::TensorList params,
+    at::TensorList grads,
+    at::TensorList exp_avgs,
+    at::TensorList exp_avg_sqs,
+    at::TensorList max_exp_avg_sqs,
+    at::TensorList state_steps,
+    const double lr,
+    const double beta1,
+    const double beta2,
+    const double weight_decay,
+    const double eps,
+    const bool amsgrad,
+    const bool maximize) {
+    fused_adam_cuda_impl<ADAM_MODE::ORIGINAL>(
+        params, grads, exp_avgs, exp_avg_sqs, max_exp_avg_sqs, state_steps,
+        lr, beta1, beta2, weight_decay, eps, amsgrad, maximize);
+}
+
+void _fused_adamw_kernel_cuda_(
+    at::TensorList params,
+    at::TensorList grads,
+    at::TensorList exp_avgs,
+    at::TensorList exp_avg_sqs,
+    at::TensorList max_exp_avg_sqs,
+    at::TensorList state_steps,
+    const double lr,
+    const double beta1,
+    const double beta2,
+    const double weight_decay,
+    const double eps,
+    const bool amsgrad,
+    const bool maximize) {
+    fused_adam_cuda_impl<ADAM_MODE::ADAMW>(
+        params, grads, exp_avgs, exp_avg_sqs, max_exp_avg_sqs, state_steps,
+        lr, beta1, beta2, weight_decay, eps, amsgrad, maximize);
+}
+
+}} // namespace at::native
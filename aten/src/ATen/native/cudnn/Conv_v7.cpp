@@ -11,6 +11,7 @@
 #include <ATen/ATen.h>
 #include <ATen/NativeFunctions.h>
 #include <ATen/Config.h>
+#include <ATen/cuda/CUDAContext.h>
 #include <ATen/cuda/CUDAGraphsUtils.cuh>
 #include <ATen/cuda/Exceptions.h>
 #include <ATen/native/cudnn/ConvShared.h>
@@ -22,6 +23,9 @@
 #include <ATen/TensorUtils.h>
 #include <c10/util/irange.h>
 
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
 #include <functional>
 #include <iterator>
 #include <sstream>
@@ -98,6 +102,32 @@ std::ostream& operator<<(std::ostream & out, const ConvolutionArgs& args) {
 //
 // ---------------------------------------------------------------------
 
+// Note [Persistent benchmark cache]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Re-benchmarking hundreds of convolution configs after every process
+// restart costs tens of seconds of degraded latency before the in-memory
+// caches warm back up. When TORCH_CUDNN_BENCHMARK_CACHE_PATH is set, the
+// benchmark caches are loaded from that file before the first algorithm
+// lookup and written back at process exit. ConvolutionParams and the cudnn
+// perf structs are PODs (and are already hashed byte-wise, so they contain
+// no indeterminate padding), which lets entries be stored as raw bytes
+// behind a fingerprint of the cudnn version and the visible GPU models; a
+// file whose fingerprint or struct sizes do not match the running process
+// is ignored wholesale. The v8 frontend cache (Conv_v8.cpp) holds live
+// cudnn_frontend::ExecutionPlan objects that cannot be rehydrated from
+// bytes, so it is not covered.
+
+template <typename T>
+void writeCacheBytes(std::ostream& out, const T& value) {
+  out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool readCacheBytes(std::istream& in, T* value) {
+  in.read(reinterpret_cast<char*>(value), sizeof(T));
+  return static_cast<bool>(in);
+}
+
 // TODO: Use something less heavy duty than a big honking mutex
 template <typename T>
 struct BenchmarkCache {
@@ -118,12 +148,145 @@ struct BenchmarkCache {
     std::lock_guard<std::mutex> guard(mutex);
     map[params] = results;
   }
+
+  // See Note [Persistent benchmark cache]
+  void serialize(std::ostream& out) {
+    std::lock_guard<std::mutex> guard(mutex);
+    writeCacheBytes(out, static_cast<uint64_t>(sizeof(T)));
+    writeCacheBytes(out, static_cast<uint64_t>(map.size()));
+    for (const auto& kv : map) {
+      writeCacheBytes(out, kv.first);
+      writeCacheBytes(out, kv.second);
+    }
+  }
+
+  bool deserialize(std::istream& in) {
+    uint64_t value_size = 0;
+    uint64_t count = 0;
+    if (!readCacheBytes(in, &value_size) || value_size != sizeof(T) ||
+        !readCacheBytes(in, &count)) {
+      return false;
+    }
+    std::lock_guard<std::mutex> guard(mutex);
+    for (uint64_t i = 0; i < count; ++i) {
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init)
+      ConvolutionParams params;
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init)
+      T results;
+      if (!readCacheBytes(in, &params) || !readCacheBytes(in, &results)) {
+        map.clear();
+        return false;
+      }
+      map.emplace(params, results);
+    }
+    return true;
+  }
 };
 
 BenchmarkCache<cudnnConvolutionFwdAlgoPerf_t> fwd_algos;
 BenchmarkCache<cudnnConvolutionBwdDataAlgoPerf_t> bwd_data_algos;
 BenchmarkCache<cudnnConvolutionBwdFilterAlgoPerf_t> bwd_filter_algos;
 
+// "PTCNNBC1", little endian
+constexpr uint64_t kBenchmarkCacheMagic = 0x3143424e4e435450ULL;
+
+const char* benchmarkCachePath() {
+  static const char* path = std::getenv("TORCH_CUDNN_BENCHMARK_CACHE_PATH");
+  return path;
+}
+
+// Memoized so the save at process exit does not have to query device
+// properties after the CUDA runtime may already have shut down.
+const std::string& benchmarkCacheFingerprint() {
+  static const std::string fingerprint = []() {
+    std::ostringstream oss;
+    oss << cudnnGetVersion();
+    for (const auto i : c10::irange(c10::cuda::device_count())) {
+      const auto* prop = at::cuda::getDeviceProperties(i);
+      oss << ";" << prop->name << ";" << prop->major << "." << prop->minor;
+    }
+    return oss.str();
+  }();
+  return fingerprint;
+}
+
+void saveBenchmarkCaches() {
+  const char* path = benchmarkCachePath();
+  if (path == nullptr) {
+    return;
+  }
+  // Write to a sibling file and rename so a concurrently starting process
+  // never observes a half-written cache.
+  const std::string tmp_path = std::string(path) + ".tmp";
+  {
+    std::ofstream out(
+        tmp_path,
+        std::ofstream::out | std::ofstream::trunc | std::ofstream::binary);
+    if (!out) {
+      TORCH_WARN(
+          "Could not open cuDNN benchmark cache file for writing: ", tmp_path);
+      return;
+    }
+    writeCacheBytes(out, kBenchmarkCacheMagic);
+    const std::string& fingerprint = benchmarkCacheFingerprint();
+    writeCacheBytes(out, static_cast<uint64_t>(fingerprint.size()));
+    out.write(fingerprint.data(), fingerprint.size());
+    writeCacheBytes(out, static_cast<uint64_t>(sizeof(ConvolutionParams)));
+    fwd_algos.serialize(out);
+    bwd_data_algos.serialize(out);
+    bwd_filter_algos.serialize(out);
+    if (!out) {
+      TORCH_WARN("Could not write cuDNN benchmark cache file: ", tmp_path);
+      return;
+    }
+  }
+  std::rename(tmp_path.c_str(), path);
+}
+
+void loadBenchmarkCaches() {
+  const char* path = benchmarkCachePath();
+  if (path == nullptr) {
+    return;
+  }
+  std::atexit(saveBenchmarkCaches);
+  std::ifstream in(path, std::ifstream::in | std::ifstream::binary);
+  if (!in) {
+    // First run; the file will be created at exit.
+    return;
+  }
+  uint64_t magic = 0;
+  uint64_t fingerprint_size = 0;
+  if (!readCacheBytes(in, &magic) || magic != kBenchmarkCacheMagic ||
+      !readCacheBytes(in, &fingerprint_size)) {
+    TORCH_WARN("Ignoring unrecognized cuDNN benchmark cache file: ", path);
+    return;
+  }
+  std::string fingerprint(fingerprint_size, '\0');
+  in.read(&fingerprint[0], fingerprint_size);
+  if (!in || fingerprint != benchmarkCacheFingerprint()) {
+    // Produced under a different cudnn version or GPU layout; algorithm
+    // choices do not carry over, start fresh.
+    return;
+  }
+  uint64_t params_size = 0;
+  if (!readCacheBytes(in, &params_size) ||
+      params_size != sizeof(ConvolutionParams)) {
+    return;
+  }
+  if (!fwd_algos.deserialize(in) || !bwd_data_algos.deserialize(in) ||
+      !bwd_filter_algos.deserialize(in)) {
+    fwd_algos.map.clear();
+    bwd_data_algos.map.clear();
+    bwd_filter_algos.map.clear();
+    TORCH_WARN("Ignoring truncated cuDNN benchmark cache file: ", path);
+  }
+}
+
+void initBenchmarkCachePersistence() {
+  static std::once_flag once;
+  std::call_once(once, loadBenchmarkCaches);
+}
+
 // TODO: Stop manually allocating CUDA memory; allocate an ATen byte
 // tensor instead.
 struct Workspace {
@@ -470,6 +633,27 @@ struct algorithm_search<cudnnConvolutionBwdFilterAlgoPerf_t> {
   }
 };
 
+// Note [Pinned cuDNN algorithms]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// With benchmark mode (and, to a lesser degree, the heuristics) the
+// algorithm picked for a convolution signature can change from process to
+// process, or even within a process when a cache entry OOMs and the search
+// reruns. For serving workloads that attribute latency per request this is
+// a problem: two identical requests can land on different kernels and show
+// very different timings whenever shapes hover near an algorithm switch
+// point.
+//
+// Context::pinnedCuDNNAlgorithms() freezes the choice instead. The
+// intended workflow is a calibration run with benchmarkCuDNN() enabled and
+// TORCH_CUDNN_BENCHMARK_CACHE_PATH set, which records the winning
+// algorithm per ConvolutionParams and persists it (see Note [Persistent
+// benchmark cache] above). Production then loads that cache
+// and sets pinnedCuDNNAlgorithms(true): cache hits are replayed verbatim,
+// and cache misses take the default algorithm deterministically rather
+// than consulting cudnnFind or the heuristics. The miss decision is cached
+// and persisted like any other, so an incomplete calibration converges to
+// a stable, self-consistent set of choices instead of re-benchmarking in
+// production.
 template<typename perf_t>
 class AlgoIterator {
   using search = algorithm_search<perf_t>;
@@ -497,6 +681,7 @@ public:
   }
 
   void try_all(std::function<void (const perf_t &perf)> f) {
+    initBenchmarkCachePersistence();
     bool only_use_default = args.params.deterministic && !benchmark;
 
     auto& cache = search::cache();
@@ -510,7 +695,11 @@ public:
       }
     }
 
-    auto perfResults = only_use_default ? onlyDefaultAlgorithm(args) : search::findAlgorithms(args, benchmark);
+    // See Note [Pinned cuDNN algorithms]: on a cache miss in pinned mode the
+    // default algorithm is taken deterministically instead of searching, and
+    // the decision is cached (and persisted) like any other.
+    bool pin_default = at::globalContext().pinnedCuDNNAlgorithms();
+    auto perfResults = (only_use_default || pin_default) ? onlyDefaultAlgorithm(args) : search::findAlgorithms(args, benchmark);
     for (auto &algoPerf : perfResults) {
       try {
         f(algoPerf);
@@ -120,6 +120,11 @@ struct CacheKeyFused {
   float alpha;
 };
 
+// Unlike the v7 benchmark caches, this one is not persisted to disk (see
+// Note [Persistent benchmark cache] in Conv_v7.cpp): the cached values are
+// live cudnn_frontend::ExecutionPlan objects tied to backend descriptors,
+// which cannot be rebuilt from serialized bytes without re-running the
+// plan construction they exist to avoid.
 template <typename T, typename KeyType>
 struct BenchmarkCache {
 std::mutex mutex;
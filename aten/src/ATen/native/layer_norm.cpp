@@ -167,6 +167,228 @@ std::tuple<Tensor, Tensor, Tensor> layer_norm_backward_cpu(
   return std::make_tuple(std::move(dX), std::move(dgamma), std::move(dbeta));
 }
 
+Tensor layer_norm_linear_cpu(
+    const Tensor& input,
+    IntArrayRef normalized_shape, const c10::optional<Tensor>& weight_opt /* optional */, const c10::optional<Tensor>& bias_opt /* optional */,
+    double eps,
+    const Tensor& fc_weight, const c10::optional<Tensor>& fc_bias_opt /* optional */) {
+  // See [Note: hacky wrapper removal for optional tensor]
+  c10::MaybeOwned<Tensor> weight_maybe_owned = at::borrow_from_optional_tensor(weight_opt);
+  const Tensor& weight = *weight_maybe_owned;
+  c10::MaybeOwned<Tensor> bias_maybe_owned = at::borrow_from_optional_tensor(bias_opt);
+  const Tensor& bias = *bias_maybe_owned;
+  c10::MaybeOwned<Tensor> fc_bias_maybe_owned = at::borrow_from_optional_tensor(fc_bias_opt);
+  const Tensor& fc_bias = *fc_bias_maybe_owned;
+
+  auto M_N = _check_layer_norm_inputs(input, normalized_shape, weight, bias);
+  auto M = M_N.first;
+  auto N = M_N.second;
+  TORCH_CHECK(
+      fc_weight.dim() == 2 && fc_weight.size(1) == N,
+      "Expected fc_weight to be 2-dimensional with size(1) = ",
+      N,
+      ", but got fc_weight of shape ",
+      fc_weight.sizes());
+  const int64_t K = fc_weight.size(0);
+  TORCH_CHECK(
+      !fc_bias.defined() || (fc_bias.dim() == 1 && fc_bias.size(0) == K),
+      "Expected fc_bias to be 1-dimensional with ",
+      K,
+      " elements, but got fc_bias of shape ",
+      fc_bias.sizes());
+  auto X = input.expect_contiguous();
+  auto gamma = weight.expect_contiguous();
+  auto beta = bias.expect_contiguous();
+  auto fc_w = fc_weight.expect_contiguous();
+  auto fc_b = fc_bias.expect_contiguous();
+
+  const auto input_shape = input.sizes();
+  const size_t axis = input.dim() - normalized_shape.size();
+  DimVector output_shape(input_shape.begin(), input_shape.begin() + axis);
+  output_shape.emplace_back(K);
+  Tensor Y = at::empty(output_shape, X->options());
+  if (M > 0) {
+    LayerNormLinearKernel(kCPU, *X, *gamma, *beta, M, N, eps, *fc_w, *fc_b, &Y);
+  }
+  return Y;
+}
+
+std::tuple<Tensor, Tensor, Tensor, Tensor> fused_dropout_add_layer_norm_cpu(
+    const Tensor& input,
+    const Tensor& residual,
+    IntArrayRef normalized_shape, const c10::optional<Tensor>& weight_opt /* optional */, const c10::optional<Tensor>& bias_opt /* optional */,
+    double p,
+    bool train,
+    double eps) {
+  // See [Note: hacky wrapper removal for optional tensor]
+  c10::MaybeOwned<Tensor> weight_maybe_owned = at::borrow_from_optional_tensor(weight_opt);
+  const Tensor& weight = *weight_maybe_owned;
+  c10::MaybeOwned<Tensor> bias_maybe_owned = at::borrow_from_optional_tensor(bias_opt);
+  const Tensor& bias = *bias_maybe_owned;
+
+  auto M_N = _check_layer_norm_inputs(input, normalized_shape, weight, bias);
+  auto M = M_N.first;
+  auto N = M_N.second;
+  TORCH_CHECK(
+      residual.sizes().equals(input.sizes()),
+      "Expected residual to have the same shape as input, but got residual "
+      "of shape ",
+      residual.sizes(),
+      " and input of shape ",
+      input.sizes());
+  TORCH_CHECK(
+      p >= 0 && p <= 1,
+      "dropout probability has to be between 0 and 1, but got ",
+      p);
+  auto X = input.expect_contiguous();
+  auto R = residual.expect_contiguous();
+  auto gamma = weight.expect_contiguous();
+  auto beta = bias.expect_contiguous();
+
+  Tensor mask;
+  double dropout_scale;
+  if (train) {
+    const double p1m = 1. - p;
+    // Check for probability of zero to avoid divide by zero and NaN results
+    dropout_scale = p1m == 0 ? 0. : 1. / p1m;
+    mask = at::empty_like(
+        *X, X->options().dtype(c10::CppTypeToScalarType<bool>::value));
+    mask.bernoulli_(p1m);
+  } else {
+    dropout_scale = 1.;
+    mask = at::ones_like(
+        *X, X->options().dtype(c10::CppTypeToScalarType<bool>::value));
+  }
+
+  Tensor Y = at::native::empty_like(
+      *X,
+      c10::nullopt /* dtype */,
+      c10::nullopt /* layout */,
+      c10::nullopt /* device */,
+      c10::nullopt /* pin_memory */,
+      at::MemoryFormat::Contiguous);
+  Tensor mean = at::empty({M}, X->options());
+  Tensor rstd = at::empty({M}, X->options());
+  if (M > 0) {
+    DropoutAddLayerNormKernel(
+        kCPU, *X, *R, mask, dropout_scale, *gamma, *beta, M, N, eps, &Y,
+        &mean, &rstd);
+  }
+
+  const auto input_shape = input.sizes();
+  const size_t axis = input.dim() - normalized_shape.size();
+  DimVector stat_shape;
+  for (const auto idx : c10::irange(axis)) {
+    stat_shape.emplace_back(input_shape[idx]);
+  }
+  for (const auto idx : c10::irange(axis, input.dim())) {
+    (void)idx; // Suppress unused variable warning
+    stat_shape.emplace_back(1);
+  }
+  mean = mean.view(stat_shape);
+  rstd = rstd.view(stat_shape);
+  return std::make_tuple(
+      std::move(Y), std::move(mask), std::move(mean), std::move(rstd));
+}
+
+std::tuple<Tensor, Tensor, Tensor, Tensor>
+fused_dropout_add_layer_norm_backward_cpu(
+    const Tensor& dY,
+    const Tensor& input,
+    const Tensor& residual,
+    IntArrayRef normalized_shape,
+    const Tensor& mask,
+    const Tensor& mean,
+    const Tensor& rstd,
+    const c10::optional<Tensor>& weight_opt /* optional */,
+    const c10::optional<Tensor>& bias_opt /* optional */,
+    double dropout_scale,
+    std::array<bool, 4> grad_input_mask) {
+  // See [Note: hacky wrapper removal for optional tensor]
+  c10::MaybeOwned<Tensor> weight_maybe_owned =
+      at::borrow_from_optional_tensor(weight_opt);
+  const Tensor& weight = *weight_maybe_owned;
+  c10::MaybeOwned<Tensor> bias_maybe_owned =
+      at::borrow_from_optional_tensor(bias_opt);
+  const Tensor& bias = *bias_maybe_owned;
+
+  auto M_N = _check_layer_norm_inputs(input, normalized_shape, weight, bias);
+  auto M = M_N.first;
+  auto N = M_N.second;
+  auto X = input.expect_contiguous();
+  auto R = residual.expect_contiguous();
+  auto mask_c = mask.expect_contiguous();
+  auto mean_c = mean.expect_contiguous();
+  auto rstd_c = rstd.expect_contiguous();
+  auto gamma = weight.expect_contiguous();
+  auto beta = bias.expect_contiguous();
+
+  Tensor dX;
+  Tensor dResidual;
+  Tensor dgamma;
+  Tensor dbeta;
+  if (grad_input_mask[0]) {
+    dX = at::native::empty_like(
+        *X,
+        c10::nullopt /* dtype */,
+        c10::nullopt /* layout */,
+        c10::nullopt /* device */,
+        c10::nullopt /* pin_memory */,
+        at::MemoryFormat::Contiguous);
+  }
+  if (grad_input_mask[1]) {
+    dResidual = at::native::empty_like(
+        *X,
+        c10::nullopt /* dtype */,
+        c10::nullopt /* layout */,
+        c10::nullopt /* device */,
+        c10::nullopt /* pin_memory */,
+        at::MemoryFormat::Contiguous);
+  }
+  if (grad_input_mask[2]) {
+    dgamma = M > 0 ? at::native::empty_like(
+                         *gamma,
+                         c10::nullopt /* dtype */,
+                         c10::nullopt /* layout */,
+                         c10::nullopt /* device */,
+                         c10::nullopt /* pin_memory */,
+                         at::MemoryFormat::Contiguous)
+                   : at::native::zeros_like(
+                         *gamma,
+                         c10::nullopt /* dtype */,
+                         c10::nullopt /* layout */,
+                         c10::nullopt /* device */,
+                         c10::nullopt /* pin_memory */,
+                         at::MemoryFormat::Contiguous);
+  }
+  if (grad_input_mask[3]) {
+    dbeta = M > 0 ? at::native::empty_like(
+                        *beta,
+                        c10::nullopt /* dtype */,
+                        c10::nullopt /* layout */,
+                        c10::nullopt /* device */,
+                        c10::nullopt /* pin_memory */,
+                        at::MemoryFormat::Contiguous)
+                  : at::native::zeros_like(
+                        *beta,
+                        c10::nullopt /* dtype */,
+                        c10::nullopt /* layout */,
+                        c10::nullopt /* device */,
+                        c10::nullopt /* pin_memory */,
+                        at::MemoryFormat::Contiguous);
+  }
+  if (M > 0) {
+    DropoutAddLayerNormBackwardKernel(
+        kCPU, dY, *X, *R, *mask_c, dropout_scale, *mean_c, *rstd_c, *gamma, M,
+        N, &dX, &dResidual, &dgamma, &dbeta);
+  }
+  return std::make_tuple(
+      std::move(dX),
+      std::move(dResidual),
+      std::move(dgamma),
+      std::move(dbeta));
+}
+
 Tensor layer_norm(
     const Tensor& input,
     IntArrayRef normalized_shape, const c10::optional<Tensor>& weight_opt /* optional */, const c10::optional<Tensor>& bias_opt /* optional */,
@@ -184,6 +406,9 @@ Tensor layer_norm(
 
 DEFINE_DISPATCH(LayerNormKernel);
 DEFINE_DISPATCH(LayerNormBackwardKernel);
+DEFINE_DISPATCH(LayerNormLinearKernel);
+DEFINE_DISPATCH(DropoutAddLayerNormKernel);
+DEFINE_DISPATCH(DropoutAddLayerNormBackwardKernel);
 
 // Ported from pytorch/xla repo
 std::tuple<Tensor, Tensor, Tensor> math_native_layer_norm(
@@ -237,5 +462,80 @@ std::tuple<Tensor, Tensor, Tensor> math_native_layer_norm(
   rstd = rstd.view(stat_shape);
   return std::make_tuple(out, mean, rstd);
 }
+
+// Reference path for backends without a handwritten fused kernel (notably
+// CUDA); composes the existing dropout and layer_norm natives so every
+// backend shares one op schema and numerics.
+std::tuple<Tensor, Tensor, Tensor, Tensor> math_fused_dropout_add_layer_norm(
+    const Tensor& input,
+    const Tensor& residual,
+    IntArrayRef normalized_shape, const c10::optional<Tensor>& weight_opt, const c10::optional<Tensor>& bias_opt,
+    double p,
+    bool train,
+    double eps) {
+  TORCH_CHECK(
+      residual.sizes().equals(input.sizes()),
+      "Expected residual to have the same shape as input, but got residual "
+      "of shape ",
+      residual.sizes(),
+      " and input of shape ",
+      input.sizes());
+  auto dropout = at::native_dropout(input, p, train);
+  auto ln = at::native_layer_norm(
+      std::get<0>(dropout).add_(residual),
+      normalized_shape,
+      weight_opt,
+      bias_opt,
+      eps);
+  return std::make_tuple(
+      std::move(std::get<0>(ln)),
+      std::move(std::get<1>(dropout)),
+      std::move(std::get<1>(ln)),
+      std::move(std::get<2>(ln)));
+}
+
+std::tuple<Tensor, Tensor, Tensor, Tensor>
+math_fused_dropout_add_layer_norm_backward(
+    const Tensor& dY,
+    const Tensor& input,
+    const Tensor& residual,
+    IntArrayRef normalized_shape,
+    const Tensor& mask,
+    const Tensor& mean,
+    const Tensor& rstd,
+    const c10::optional<Tensor>& weight_opt,
+    const c10::optional<Tensor>& bias_opt,
+    double dropout_scale,
+    std::array<bool, 4> grad_input_mask) {
+  // Recompute the pre-norm sum; the fused forward deliberately does not
+  // materialize it.
+  Tensor Z = at::native_dropout_backward(input, mask, dropout_scale)
+                 .add_(residual);
+  auto ln_grads = at::native_layer_norm_backward(
+      dY,
+      Z,
+      normalized_shape,
+      mean,
+      rstd,
+      weight_opt,
+      bias_opt,
+      {grad_input_mask[0] || grad_input_mask[1],
+       grad_input_mask[2],
+       grad_input_mask[3]});
+  Tensor dZ = std::get<0>(ln_grads);
+  Tensor dX;
+  Tensor dResidual;
+  if (grad_input_mask[0]) {
+    dX = at::native_dropout_backward(dZ, mask, dropout_scale);
+  }
+  if (grad_input_mask[1]) {
+    dResidual = std::move(dZ);
+  }
+  return std::make_tuple(
+      std::move(dX),
+      std::move(dResidual),
+      std::move(std::get<1>(ln_grads)),
+      std::move(std::get<2>(ln_grads)));
+}
 } // namespace native
 } // namespace at
@@ -95,8 +95,54 @@ using backward_fn = void (*)(
     Tensor* /* dgamma */,
     Tensor* /* dbeta */);
 
+using dropout_add_layer_norm_forward_fn = void (*)(
+    const Tensor& /* X */,
+    const Tensor& /* residual */,
+    const Tensor& /* mask */,
+    double /* dropout_scale */,
+    const Tensor& /* gamma */,
+    const Tensor& /* beta */,
+    int64_t /* M */,
+    int64_t /* N */,
+    double /* eps */,
+    Tensor* /* Y */,
+    Tensor* /* mean */,
+    Tensor* /* rstd */);
+
+using dropout_add_layer_norm_backward_fn = void (*)(
+    const Tensor& /* dY */,
+    const Tensor& /* X */,
+    const Tensor& /* residual */,
+    const Tensor& /* mask */,
+    double /* dropout_scale */,
+    const Tensor& /* mean */,
+    const Tensor& /* rstd */,
+    const Tensor& /* gamma */,
+    int64_t /* M */,
+    int64_t /* N */,
+    Tensor* /* dX */,
+    Tensor* /* dResidual */,
+    Tensor* /* dgamma */,
+    Tensor* /* dbeta */);
+
+using layer_norm_linear_fn = void (*)(
+    const Tensor& /* X */,
+    const Tensor& /* gamma */,
+    const Tensor& /* beta */,
+    int64_t /* M */,
+    int64_t /* N */,
+    double /* eps */,
+    const Tensor& /* fc_weight */,
+    const Tensor& /* fc_bias */,
+    Tensor* /* Y */);
+
 DECLARE_DISPATCH(forward_fn, LayerNormKernel);
 DECLARE_DISPATCH(backward_fn, LayerNormBackwardKernel);
+DECLARE_DISPATCH(layer_norm_linear_fn, LayerNormLinearKernel);
+DECLARE_DISPATCH(dropout_add_layer_norm_forward_fn, DropoutAddLayerNormKernel);
+DECLARE_DISPATCH(
+    dropout_add_layer_norm_backward_fn,
+    DropoutAddLayerNormBackwardKernel);
 
 } // namespace native
 } // namespace at
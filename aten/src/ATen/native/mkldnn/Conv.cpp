@@ -102,7 +102,23 @@ Tensor mkldnn_convolution(
   auto output = at::empty({0}, input.options());
 
   const ideep::tensor x = itensor_from_tensor(input);
-  const ideep::tensor w = itensor_from_tensor(weight);
+  ideep::tensor w = itensor_from_tensor(weight);
+  if (!weight.is_mkldnn() && prepack_cache_enabled()) {
+    // See Note [MKLDNN prepacked weight cache]
+    auto expected_desc = ideep::convolution_forward::expected_weights_desc(
+        w.get_dims(),
+        w.get_data_type(),
+        {stride.begin(), stride.end()},
+        {padding.begin(), padding.end()},
+        {padding.begin(), padding.end()},
+        {dilation.begin(), dilation.end()},
+        groups,
+        ideep::algorithm::convolution_direct,
+        ideep::prop_kind::forward,
+        x.get_data_type(),
+        x.get_dims());
+    w = get_prepacked_weight(weight, w, expected_desc);
+  }
 
   ideep::tensor y;
   if (is_channels_last) {
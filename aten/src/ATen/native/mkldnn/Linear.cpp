@@ -65,7 +65,13 @@ Tensor mkldnn_linear(
   const ideep::tensor x = itensor_from_mkldnn(self_reshaped);
   // weight_t can be a mkldnn tensor or dense tensor.
   const Tensor weight = (weight_t.is_mkldnn() || weight_t.is_contiguous()) ? weight_t : weight_t.contiguous();
-  const ideep::tensor w = itensor_from_tensor(weight);
+  ideep::tensor w = itensor_from_tensor(weight);
+  if (!weight.is_mkldnn() && prepack_cache_enabled()) {
+    // See Note [MKLDNN prepacked weight cache]
+    auto expected_desc = ideep::inner_product_forward::expected_weights_desc(
+        w.get_dims(), w.get_data_type(), x.get_data_type(), x.get_dims());
+    w = get_prepacked_weight(weight, w, expected_desc);
+  }
 
   ideep::tensor y;
   if (bias.defined()) {
@@ -2,6 +2,14 @@
 #include <ATen/OpaqueTensorImpl.h>
 #include <c10/core/Allocator.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
 #if AT_MKLDNN_ENABLED()
 
 #include <ideep.hpp>
@@ -117,6 +125,257 @@ ideep::tensor itensor_from_tensor(const Tensor& tensor) {
   }
 }
 
+// Note [MKLDNN prepacked weight cache]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// When a dense weight feeds an mkldnn convolution or inner product, oneDNN
+// first reorders it into its blocked layout. Servers that keep many models
+// resident and call them repeatedly pay that reorder on every invocation
+// unless each model was converted to mkldnn tensors up front, which with
+// enough models thrashes memory on its own. The cache below keeps the
+// reordered ("prepacked") weights around, keyed on the weight's storage
+// pointer and version counter together with the blocked descriptor (the
+// same weight can legitimately need several descriptors, e.g. for
+// different batch sizes).
+//
+// Entries are LRU-evicted against a configurable byte budget; a budget of
+// zero (the default) disables caching entirely, so there is no behavior
+// change unless it is turned on via TORCH_MKLDNN_PREPACK_CACHE_LIMIT
+// (megabytes) or mkldnn_set_prepack_cache_limit(). Weights pinned with
+// mkldnn_set_prepacked_weight_pinned() count against the budget but are
+// never evicted, so a latency-critical model's packs stay resident while
+// the rest of the fleet shares what budget remains.
+//
+// An in-place update to a weight bumps its version counter, which strands
+// the old entry (it is dropped the next time the weight is seen, or
+// evicted by LRU). Tensors mutated inside InferenceMode do not bump their
+// version counter, so such weights must not be mutated while the cache is
+// enabled.
+namespace {
+
+class PrepackedWeightCache {
+ public:
+  static PrepackedWeightCache& singleton() {
+    static PrepackedWeightCache cache;
+    return cache;
+  }
+
+  size_t limit() const {
+    return limit_.load(std::memory_order_relaxed);
+  }
+
+  void set_limit(size_t nbytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    limit_.store(nbytes, std::memory_order_relaxed);
+    evict_locked();
+  }
+
+  size_t bytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return bytes_;
+  }
+
+  void clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    index_.clear();
+    bytes_ = 0;
+  }
+
+  void set_pinned(const void* ptr, bool pinned) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (pinned) {
+      pinned_.insert(ptr);
+    } else {
+      pinned_.erase(ptr);
+    }
+    auto it = index_.find(ptr);
+    if (it != index_.end()) {
+      for (auto& entry_it : it->second) {
+        entry_it->pinned = pinned;
+      }
+    }
+    if (!pinned) {
+      evict_locked();
+    }
+  }
+
+  ideep::tensor get(
+      const void* ptr,
+      uint32_t version,
+      const ideep::tensor& w,
+      const ideep::tensor::desc& desc) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = index_.find(ptr);
+      if (it != index_.end()) {
+        // Packs for stale versions of this weight can never be used again.
+        auto& slots = it->second;
+        for (auto sit = slots.begin(); sit != slots.end();) {
+          if ((*sit)->version != version) {
+            bytes_ -= (*sit)->nbytes;
+            entries_.erase(*sit);
+            sit = slots.erase(sit);
+          } else {
+            ++sit;
+          }
+        }
+        for (const auto& entry_it : slots) {
+          if (entry_it->desc == desc) {
+            entries_.splice(entries_.begin(), entries_, entry_it);
+            return entry_it->packed;
+          }
+        }
+        if (slots.empty()) {
+          index_.erase(it);
+        }
+      }
+    }
+
+    // Reorder outside the lock; packing is the expensive part.
+    ideep::tensor packed;
+    packed.init(desc);
+    packed.feed_from(w);
+
+    const size_t nbytes = desc.get_size();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (nbytes <= limit()) {
+        // Another thread may have packed the same weight concurrently.
+        auto it = index_.find(ptr);
+        const bool already_cached = it != index_.end() &&
+            std::any_of(
+                it->second.begin(),
+                it->second.end(),
+                [&](const std::list<Entry>::iterator& entry_it) {
+                  return entry_it->version == version &&
+                      entry_it->desc == desc;
+                });
+        if (!already_cached) {
+          entries_.push_front(Entry{
+              ptr, version, desc, packed, nbytes, pinned_.count(ptr) != 0});
+          index_[ptr].push_back(entries_.begin());
+          bytes_ += nbytes;
+          evict_locked();
+        }
+      }
+    }
+    return packed;
+  }
+
+ private:
+  struct Entry {
+    const void* ptr;
+    uint32_t version;
+    ideep::tensor::desc desc;
+    ideep::tensor packed;
+    size_t nbytes;
+    bool pinned;
+  };
+
+  PrepackedWeightCache() {
+    const char* env = std::getenv("TORCH_MKLDNN_PREPACK_CACHE_LIMIT");
+    if (env != nullptr) {
+      limit_.store(
+          static_cast<size_t>(std::strtoull(env, nullptr, 10)) * 1024 * 1024,
+          std::memory_order_relaxed);
+    }
+  }
+
+  void evict_locked() {
+    const size_t limit = this->limit();
+    for (auto it = entries_.end(); bytes_ > limit && it != entries_.begin();) {
+      --it;
+      if (it->pinned) {
+        continue;
+      }
+      auto& slots = index_[it->ptr];
+      slots.erase(std::find(slots.begin(), slots.end(), it));
+      if (slots.empty()) {
+        index_.erase(it->ptr);
+      }
+      bytes_ -= it->nbytes;
+      it = entries_.erase(it);
+    }
+  }
+
+  mutable std::mutex mutex_;
+  std::atomic<size_t> limit_{0};
+  size_t bytes_ = 0;
+  // Most recently used first.
+  std::list<Entry> entries_;
+  std::unordered_map<const void*, std::vector<std::list<Entry>::iterator>>
+      index_;
+  std::unordered_set<const void*> pinned_;
+};
+
+} // namespace
+
+bool prepack_cache_enabled() {
+  return PrepackedWeightCache::singleton().limit() > 0;
+}
+
+ideep::tensor get_prepacked_weight(
+    const Tensor& weight,
+    const ideep::tensor& w,
+    const ideep::tensor::desc& expected_desc) {
+  const auto& version_counter =
+      weight.unsafeGetTensorImpl()->version_counter();
+  const uint32_t version =
+      version_counter.enabled() ? version_counter.current_version() : 0;
+  return PrepackedWeightCache::singleton().get(
+      weight.data_ptr(), version, w, expected_desc);
+}
+
+void mkldnn_set_prepack_cache_limit(size_t nbytes) {
+  PrepackedWeightCache::singleton().set_limit(nbytes);
+}
+
+size_t mkldnn_prepack_cache_limit() {
+  return PrepackedWeightCache::singleton().limit();
+}
+
+size_t mkldnn_prepack_cache_bytes() {
+  return PrepackedWeightCache::singleton().bytes();
+}
+
+void mkldnn_clear_prepack_cache() {
+  PrepackedWeightCache::singleton().clear();
+}
+
+void mkldnn_set_prepacked_weight_pinned(const Tensor& weight, bool pinned) {
+  TORCH_CHECK(
+      !weight.is_mkldnn(),
+      "mkldnn_set_prepacked_weight_pinned: expected a dense weight; "
+      "mkldnn tensors are already packed");
+  PrepackedWeightCache::singleton().set_pinned(weight.data_ptr(), pinned);
+}
+
+}}
+
+#else
+
+namespace at { namespace native {
+
+void mkldnn_set_prepack_cache_limit(size_t nbytes) {
+  TORCH_CHECK(false, "mkldnn_set_prepack_cache_limit: MKL-DNN build is disabled");
+}
+
+size_t mkldnn_prepack_cache_limit() {
+  TORCH_CHECK(false, "mkldnn_prepack_cache_limit: MKL-DNN build is disabled");
+}
+
+size_t mkldnn_prepack_cache_bytes() {
+  TORCH_CHECK(false, "mkldnn_prepack_cache_bytes: MKL-DNN build is disabled");
+}
+
+void mkldnn_clear_prepack_cache() {
+  TORCH_CHECK(false, "mkldnn_clear_prepack_cache: MKL-DNN build is disabled");
+}
+
+void mkldnn_set_prepacked_weight_pinned(const Tensor& weight, bool pinned) {
+  TORCH_CHECK(false, "mkldnn_set_prepacked_weight_pinned: MKL-DNN build is disabled");
+}
+
 }}
 
 #endif // AT_MKLDNN_ENABLED()
@@ -24,6 +24,32 @@ TORCH_API ideep::tensor itensor_view_from_dense(const Tensor& tensor);
 // Helper function for getting an ideep tensor out of an aten Tensor or MKL-DNN tensor.
 TORCH_API ideep::tensor itensor_from_tensor(const Tensor& tensor);
 
+// Returns true when the prepacked weight cache has a nonzero byte budget.
+// See Note [MKLDNN prepacked weight cache].
+TORCH_API bool prepack_cache_enabled();
+
+// Returns `weight` reordered to `expected_desc`, serving it from the
+// process-level prepacked weight cache when possible. `w` must be an ideep
+// view of `weight`'s storage. See Note [MKLDNN prepacked weight cache].
+TORCH_API ideep::tensor get_prepacked_weight(
+    const Tensor& weight,
+    const ideep::tensor& w,
+    const ideep::tensor::desc& expected_desc);
+
 }}
 
 #endif // AT_MKLDNN_ENABLED
+
+namespace at { namespace native {
+
+// Control API for the prepacked weight cache. Declared unconditionally so
+// the Python bindings always link; the implementations throw when the build
+// has no MKL-DNN support. See Note [MKLDNN prepacked weight cache] in
+// MKLDNNCommon.cpp.
+TORCH_API void mkldnn_set_prepack_cache_limit(size_t nbytes);
+TORCH_API size_t mkldnn_prepack_cache_limit();
+TORCH_API size_t mkldnn_prepack_cache_bytes();
+TORCH_API void mkldnn_clear_prepack_cache();
+TORCH_API void mkldnn_set_prepacked_weight_pinned(const Tensor& weight, bool pinned);
+
+}}
@@ -373,6 +373,39 @@ Tensor NestedTensor_from_padded_and_nested_example(
   return _nested_from_padded(padded, get_nested_tensor_impl(nt_example)->get_nested_size_tensor());
 }
 
+Tensor nested_from_buffer(const Tensor& buffer, const Tensor& nested_size) {
+  TORCH_CHECK(
+      buffer.dim() == 1 && buffer.is_contiguous(),
+      "_nested_from_buffer expects a 1D contiguous buffer, but got a ",
+      buffer.dim(),
+      "D tensor");
+  TORCH_CHECK(
+      nested_size.dim() == 2 &&
+          nested_size.device().type() == at::kCPU &&
+          nested_size.scalar_type() == at::kLong,
+      "_nested_from_buffer expects nested_size to be a 2D CPU int64 tensor");
+  auto sizes = nested_size.contiguous();
+  const int64_t ntensors = sizes.size(0);
+  const int64_t ndims = sizes.size(1);
+  const int64_t* sizes_ptr = sizes.data_ptr<int64_t>();
+  int64_t numel = 0;
+  for (const auto i : c10::irange(ntensors)) {
+    int64_t n = 1;
+    for (const auto j : c10::irange(ndims)) {
+      n *= sizes_ptr[i * ndims + j];
+    }
+    numel += n;
+  }
+  TORCH_CHECK(
+      numel == buffer.numel(),
+      "_nested_from_buffer expects the buffer to hold exactly the elements "
+      "described by nested_size, but got ",
+      buffer.numel(),
+      " elements for a nested size totalling ",
+      numel);
+  return wrap_buffer(buffer, std::move(sizes));
+}
+
 Tensor nested_from_padded_generic(
     const Tensor& padded,
     const Tensor& sizes,
@@ -791,16 +824,59 @@ Tensor bmm_nested(const Tensor& self, const Tensor& mat2) {
   }
   Tensor out_buffer = self_buffer.new_empty(out_numel);
   Tensor output = wrap_buffer(out_buffer, out_sizemat);
-  // call tensor mm
-  // TODO: `padding nested tensor -> bmm -> remove padding` may be more efficient
-  //       until we have specialized nested tensor bmm kernel
-  //       useful resource: `aten/src/ATen/native/cpu/LinearAlgebra.cpp/bmm_out_or_baddbmm_`
-  //                        `aten/src/ATen/native/cuda/Blas.cpp/baddbmm_out_cuda_impl`
+  // Batch maximal runs of identically-shaped, uniformly-spaced matrices into
+  // a single strided bmm, which dispatches to batched BLAS underneath.
+  // Ragged batches that are sorted or bucketed by length then collapse into
+  // a handful of grouped GEMM calls at near dense throughput, instead of one
+  // mm dispatch per sequence; irregular entries fall back to the mm loop.
   std::vector<Tensor> output_unbind = output.unbind();
-  for (int64_t i = 0; i < ntensors; i++) {
-    at::mm_out(output_unbind[i],
-               self_buffer.as_strided(self_sizes[i], self_strides[i], self_offsets[i]),
-               mat2_buffer.as_strided(mat2_sizes[i], mat2_strides[i], mat2_offsets[i]));
+  int64_t out_offset = 0;
+  int64_t i = 0;
+  while (i < ntensors) {
+    const IntArrayRef& self_shape = self_sizes[i],
+        & mat2_shape = mat2_sizes[i];
+    const int64_t& self_size0 = self_shape[0], & self_size1 = self_shape[1],
+        & mat2_size1 = mat2_shape[1];
+    // extend the run while shapes and strides repeat and the matrices are
+    // equally spaced within both buffers
+    int64_t j = i + 1;
+    while (j < ntensors &&
+        self_sizes[j].equals(self_shape) &&
+        mat2_sizes[j].equals(mat2_shape) &&
+        self_strides[j].equals(self_strides[i]) &&
+        mat2_strides[j].equals(mat2_strides[i]) &&
+        self_offsets[j] - self_offsets[j - 1] ==
+            self_offsets[i + 1] - self_offsets[i] &&
+        mat2_offsets[j] - mat2_offsets[j - 1] ==
+            mat2_offsets[i + 1] - mat2_offsets[i]) {
+      j++;
+    }
+    const int64_t group_size = j - i;
+    if (group_size == 1) {
+      at::mm_out(output_unbind[i],
+                 self_buffer.as_strided(self_sizes[i], self_strides[i], self_offsets[i]),
+                 mat2_buffer.as_strided(mat2_sizes[i], mat2_strides[i], mat2_offsets[i]));
+    } else {
+      Tensor self_batch = self_buffer.as_strided(
+          {group_size, self_size0, self_size1},
+          {self_offsets[i + 1] - self_offsets[i],
+           self_strides[i][0], self_strides[i][1]},
+          self_offsets[i]);
+      Tensor mat2_batch = mat2_buffer.as_strided(
+          {group_size, self_size1, mat2_size1},
+          {mat2_offsets[i + 1] - mat2_offsets[i],
+           mat2_strides[i][0], mat2_strides[i][1]},
+          mat2_offsets[i]);
+      // the output buffer is freshly created and contiguous, so the run's
+      // outputs form a dense batch starting at out_offset
+      Tensor out_batch = out_buffer.as_strided(
+          {group_size, self_size0, mat2_size1},
+          {self_size0 * mat2_size1, mat2_size1, 1},
+          out_offset);
+      at::bmm_out(out_batch, self_batch, mat2_batch);
+    }
+    out_offset += group_size * self_size0 * mat2_size1;
+    i = j;
   }
   return output;
 }
@@ -48,7 +48,6 @@ using fake_quant_per_channel_fn = void (*)(
 
 using fake_quant_per_channel_cachemask_fn = void (*)(
     TensorIterator &iter,
-    TensorIterator &iter_mask,
     int64_t quant_min,
     int64_t quant_max);
 
@@ -80,18 +80,11 @@ std::tuple<Tensor, Tensor> fake_quantize_per_channel_affine_cachemask(
   std::vector<int64_t> expected_shape(self.dim(), 1);
   expected_shape[axis] = self.size(axis);
 
+  // The fake_quant output and the mask are produced in a single pass over
+  // the input, same as the per-tensor variant.
   TensorIterator iter = TensorIteratorConfig()
     .check_all_same_dtype(false)
     .add_output(Y)
-    .add_input(self)
-    .add_owned_input(native::_unsafe_view(scale, expected_shape))
-    .add_owned_input(native::_unsafe_view(zero_point, expected_shape))
-    .build();
-
-  // TODO(future, optional): read once, write twice.  Not done at the moment
-  //   for simplicity, as we do not expect this to be a bottleneck.
-  TensorIterator iter_mask = TensorIteratorConfig()
-    .check_all_same_dtype(false)
     .add_output(mask)
     .add_input(self)
     .add_owned_input(native::_unsafe_view(scale, expected_shape))
@@ -100,7 +93,7 @@ std::tuple<Tensor, Tensor> fake_quantize_per_channel_affine_cachemask(
 
   // TODO(future, optional): look into packing the mask further (BoolTensor uses
   //   1 byte per element, we only need 1 bit per element).
-  fake_quant_per_channel_cachemask_stub(iter.device_type(), iter, iter_mask, quant_min, quant_max);
+  fake_quant_per_channel_cachemask_stub(iter.device_type(), iter, quant_min, quant_max);
   return std::make_tuple(Y, mask);
 }
 
@@ -1326,71 +1326,190 @@ void qadd_scalar_kernel(Tensor& out, const Tensor& self, const Scalar& other) {
         });
   });
 }
+// Note [Integer-domain quantized add]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Adding two quantized tensors only needs each operand rescaled from its
+// own scale to the output scale:
+//
+//   c_q = clamp(rescale(a_q - z_a, s_a / s_c) +
+//               rescale(b_q - z_b, s_b / s_c) + z_c)
+//
+// Instead of dequantizing to float and requantizing (two int<->float round
+// trips per element), the scale ratios are precomputed as fixed-point
+// multipliers -- a Q31 mantissa in [2^30, 2^31) plus a right shift, the
+// same representation gemmlowp and QNNPACK use -- so the whole kernel
+// stays in the integer domain: widen to int32, one 64-bit multiply and
+// rounding shift per operand, add, then saturating pack. Ties round
+// half-up, which can differ from the float path's round-half-even by one
+// quantum at exact midpoints.
+struct RequantMultiplier {
+  int32_t multiplier; // Q31 mantissa in [2^30, 2^31)
+  int shift; // right shift applied to the 64-bit product
+};
+
+inline RequantMultiplier make_requant_multiplier(double value) {
+  TORCH_CHECK(value > 0, "requantization multiplier must be positive");
+  int exponent;
+  const double mantissa = std::frexp(value, &exponent); // in [0.5, 1)
+  auto q = static_cast<int64_t>(std::nearbyint(mantissa * (1LL << 31)));
+  if (q == (1LL << 31)) {
+    q >>= 1;
+    ++exponent;
+  }
+  const int shift = 31 - exponent;
+  TORCH_CHECK(
+      shift >= 1 && shift <= 62,
+      "requantization multiplier ",
+      value,
+      " is out of the representable range");
+  return {static_cast<int32_t>(q), shift};
+}
+
+inline int32_t requant_rescale(int32_t v, RequantMultiplier m) {
+  const int64_t prod = static_cast<int64_t>(v) * m.multiplier;
+  return static_cast<int32_t>(
+      (prod + (static_cast<int64_t>(1) << (m.shift - 1))) >> m.shift);
+}
+
+#ifdef CPU_CAPABILITY_AVX2
+// Arithmetic 64-bit right shift, which AVX2 lacks: logical shift plus the
+// sign bits re-filled from a comparison mask.
+inline __m256i requant_sra_epi64(__m256i x, int shift) {
+  __m256i sign = _mm256_cmpgt_epi64(_mm256_setzero_si256(), x);
+  return _mm256_or_si256(
+      _mm256_srli_epi64(x, shift), _mm256_slli_epi64(sign, 64 - shift));
+}
+
+inline __m256i requant_rescale_v(__m256i v, RequantMultiplier m) {
+  const __m256i mult = _mm256_set1_epi64x(m.multiplier);
+  const __m256i round = _mm256_set1_epi64x(static_cast<int64_t>(1) << (m.shift - 1));
+  // 32x32 -> 64 bit products of the even and odd int32 lanes. The odd
+  // lanes are moved down with a logical shift; _mm256_mul_epi32 only reads
+  // (and sign-extends) the low 32 bits of each 64-bit element.
+  __m256i even = requant_sra_epi64(
+      _mm256_add_epi64(_mm256_mul_epi32(v, mult), round), m.shift);
+  __m256i odd = requant_sra_epi64(
+      _mm256_add_epi64(_mm256_mul_epi32(_mm256_srli_epi64(v, 32), mult), round),
+      m.shift);
+  // Interleave the low 32 bits of the results back into int32 lanes.
+  return _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xAA);
+}
+
+// Adds the zero point and saturating-packs rescaled int32 sums back into
+// the quantized type; the same pack/permute dance as RequantizeAvx2 minus
+// the float multiply.
+template <typename Vec>
+Vec requant_pack(const typename Vec::int_vec_return_type& c, int32_t zero_point);
+
+template <>
+Vectorized<c10::qint32> requant_pack<Vectorized<c10::qint32>>(
+    const Vectorized<c10::qint32>::int_vec_return_type& c,
+    int32_t zero_point) {
+  return _mm256_add_epi32(c[0], _mm256_set1_epi32(zero_point));
+}
+
+template <typename T>
+__m256i requant_pack_impl(
+    const std::array<Vectorized<c10::qint32>, 4>& c,
+    int32_t zero_point) {
+  constexpr auto min_val = std::numeric_limits<T>::min();
+  constexpr auto max_val = std::numeric_limits<T>::max();
+  const __m256i zp = _mm256_set1_epi32(zero_point);
+  const __m256i permute_mask_v =
+      _mm256_set_epi32(0x07, 0x03, 0x06, 0x02, 0x05, 0x01, 0x04, 0x00);
+  __m256i x_v = _mm256_add_epi32(c[0], zp);
+  __m256i y_v = _mm256_add_epi32(c[1], zp);
+  __m256i z_v = _mm256_add_epi32(c[2], zp);
+  __m256i w_v = _mm256_add_epi32(c[3], zp);
+  __m256i xy_packed_v = _mm256_packs_epi32(x_v, y_v);
+  __m256i zw_packed_v = _mm256_packs_epi32(z_v, w_v);
+  __m256i xyzw_clamped_v =
+      vec::pack_saturate_and_clamp<T>(xy_packed_v, zw_packed_v, min_val, max_val);
+  return _mm256_permutevar8x32_epi32(xyzw_clamped_v, permute_mask_v);
+}
+
+template <>
+Vectorized<c10::qint8> requant_pack<Vectorized<c10::qint8>>(
+    const Vectorized<c10::qint8>::int_vec_return_type& c,
+    int32_t zero_point) {
+  return requant_pack_impl<int8_t>(c, zero_point);
+}
+
+template <>
+Vectorized<c10::quint8> requant_pack<Vectorized<c10::quint8>>(
+    const Vectorized<c10::quint8>::int_vec_return_type& c,
+    int32_t zero_point) {
+  return requant_pack_impl<uint8_t>(c, zero_point);
+}
+#endif // CPU_CAPABILITY_AVX2
+
 // Note: out is assumed to be the same size as self and other.
 // Note: Addition is only supported when self, other, out are of the same dtype.
 template <bool ReLUFused = false>
 void qadd_kernel(Tensor& out, const Tensor& self, const Tensor& other) {
   int64_t zero_point = out.q_zero_point();
-  // NOLINTNEXTLINE(bugprone-narrowing-conversions,cppcoreguidelines-narrowing-conversions)
-  float scale = out.q_scale();
-  float inv_scale = 1.0f / scale;
+  double scale = out.q_scale();
   int64_t self_zero_point = self.q_zero_point();
-  // NOLINTNEXTLINE(bugprone-narrowing-conversions,cppcoreguidelines-narrowing-conversions)
-  float self_scale = self.q_scale();
+  double self_scale = self.q_scale();
   int64_t other_zero_point = other.q_zero_point();
-  // NOLINTNEXTLINE(bugprone-narrowing-conversions,cppcoreguidelines-narrowing-conversions)
-  float other_scale = other.q_scale();
+  double other_scale = other.q_scale();
 
-  // Broadcast out the parameters here to amortize out that cost across
-  // loop iterations.
-  // TODO: we can optimize dequantization by doing a premultiplication
-  // of the zero point by scale and doing FMA on scale*x_q - (scale*zero_point)
-  auto self_zero_point_vec = Vectorized<float>((float)self_zero_point);
-  auto self_scale_vec = Vectorized<float>(self_scale);
-  auto other_zero_point_vec = Vectorized<float>((float)other_zero_point);
-  auto other_scale_vec = Vectorized<float>(other_scale);
-
-  auto self_scale_neg_zp_premul_vec = self_scale_vec * self_zero_point_vec.neg();
-  auto other_scale_zp_premul_vec = other_scale_vec * other_zero_point_vec.neg();
+  // See Note [Integer-domain quantized add] above.
+  const auto mult_a = make_requant_multiplier(self_scale / scale);
+  const auto mult_b = make_requant_multiplier(other_scale / scale);
 
   auto iter = TensorIterator::borrowing_binary_op(out, self, other);
 
   AT_DISPATCH_QINT_TYPES(out.scalar_type(), "qadd", [&]() {
     using Vec = Vectorized<scalar_t>;
+    // NOLINTNEXTLINE(bugprone-signed-char-misuse)
+    const int64_t q_min = std::numeric_limits<underlying_t>::min();
+    const int64_t q_max = std::numeric_limits<underlying_t>::max();
+    const auto scalar_op = [&](scalar_t a, scalar_t b) -> scalar_t {
+      const int32_t a_sub_z = static_cast<int32_t>(a.val_) -
+          static_cast<int32_t>(self_zero_point);
+      const int32_t b_sub_z = static_cast<int32_t>(b.val_) -
+          static_cast<int32_t>(other_zero_point);
+      int64_t c = static_cast<int64_t>(requant_rescale(a_sub_z, mult_a)) +
+          requant_rescale(b_sub_z, mult_b) + zero_point;
+      if (ReLUFused) {
+        c = std::max<int64_t>(c, zero_point);
+      }
+      return static_cast<scalar_t>(
+          std::min<int64_t>(std::max<int64_t>(c, q_min), q_max));
+    };
     cpu_kernel_vec(
         iter,
-        [&](scalar_t a, scalar_t b) -> scalar_t {
-          const auto da =
-              at::native::dequantize_val(self_scale, self_zero_point, a);
-          const auto db =
-              at::native::dequantize_val(other_scale, other_zero_point, b);
-          float c = da + db;
-          if (ReLUFused) {
-            c = std::max<float>(c, 0.0);
-          }
-          return at::native::quantize_val<scalar_t>(scale, zero_point, c);
-        },
+        scalar_op,
         [&](Vec a, Vec b) -> Vec {
-          const auto da = a.dequantize(
-              self_scale_vec, self_zero_point_vec, self_scale_neg_zp_premul_vec);
-          const auto db = b.dequantize(
-              other_scale_vec, other_zero_point_vec, other_scale_zp_premul_vec);
-          Vec::float_vec_return_type retvals;
-          for (const auto i : c10::irange(Vec::float_num_vecs())) {
-            auto c = da[i] + db[i];
-            if (ReLUFused) {
-              c = vec::maximum(c, Vectorized<float>(0.0f));
-            }
-            retvals[i] = c;
+#ifdef CPU_CAPABILITY_AVX2
+          const auto a_sub_zp = a.widening_subtract(
+              Vec(static_cast<scalar_t>(self_zero_point)));
+          const auto b_sub_zp = b.widening_subtract(
+              Vec(static_cast<scalar_t>(other_zero_point)));
+          typename Vec::int_vec_return_type c;
+          for (const auto i : c10::irange(Vec::int_num_vecs())) {
+            c[i] = _mm256_add_epi32(
+                requant_rescale_v(a_sub_zp[i], mult_a),
+                requant_rescale_v(b_sub_zp[i], mult_b));
+          }
+          Vec rv = requant_pack<Vec>(c, zero_point);
+          if (ReLUFused) {
+            rv = rv.maximum(Vec(static_cast<scalar_t>(zero_point)));
           }
-          // TODO: fbgemm::Quantize doesn't support taking in the
-          // pre-broadcasted parameters. We might be able to save some cycles by
-          // enabling that in the API.
-          // TODO: specialize fbgemm::Quantize for a single vector and make it
-          // inlineable. This could help with interleaving as suggested by the
-          // TensorIterator implementations
-          auto rv = Vec::quantize(retvals, scale, zero_point, inv_scale);
           return rv;
+#else
+          // Lane-wise fallback so every capability produces the same bits.
+          __at_align__ scalar_t a_vals[Vec::size()];
+          __at_align__ scalar_t b_vals[Vec::size()];
+          __at_align__ scalar_t r_vals[Vec::size()];
+          a.store(a_vals);
+          b.store(b_vals);
+          for (const auto i : c10::irange(Vec::size())) {
+            r_vals[i] = scalar_op(a_vals[i], b_vals[i]);
+          }
+          return Vec::loadu(r_vals);
+#endif
         });
   });
 }
@@ -2530,7 +2649,6 @@ void fake_quantize_learnable_tensor_grad_kernel_cpu(
 template <typename SelfType>
 void _fake_quant_per_channel_cachemask_cpu_helper(
     TensorIterator& iter,
-    TensorIterator& iter_mask,
     const int64_t quant_min,
     const int64_t quant_max) {
 
@@ -2541,48 +2659,38 @@ void _fake_quant_per_channel_cachemask_cpu_helper(
     // Xq = Round(Xf * inv_scale + zero_point)
     // where zero_point is in float.
     AT_DISPATCH_FLOATING_TYPES_AND_HALF(zero_point_dtype, "fake_quantize_channel_cachemask_cpu_zero_point_handling", [&] {
-      // write mask
-      cpu_kernel(iter_mask, [=](SelfType self, float scale, scalar_t zero_point) -> bool {
-        float inv_scale = 1.0f / scale;
-        const auto qval = std::lrintf(zero_point + (self * inv_scale));
-        return ((quant_min <= qval) && (qval <= quant_max));
-      });
-
-      // write fake_quant
-      cpu_kernel(iter, [=](SelfType self, float scale, scalar_t zero_point) -> SelfType {
-        float inv_scale = 1.0f / scale;
-        // NOLINTNEXTLINE(bugprone-narrowing-conversions,cppcoreguidelines-narrowing-conversions)
-        return (std::fmin(
-                    std::fmax(
-                        std::lrintf(zero_point + self * inv_scale),
-                        quant_min),
-                    quant_max) -
-                zero_point) *
-            scale;
-      });
+      // write fake_quant and mask in one pass (read once, write twice)
+      cpu_kernel_multiple_outputs(
+          iter,
+          [=](SelfType self, float scale, scalar_t zero_point) -> std::tuple<SelfType, bool> {
+            float inv_scale = 1.0f / scale;
+            const auto qval = std::lrintf(zero_point + (self * inv_scale));
+            // NOLINTNEXTLINE(bugprone-narrowing-conversions,cppcoreguidelines-narrowing-conversions)
+            const SelfType yval =
+                (std::fmin(std::fmax(qval, quant_min), quant_max) -
+                 zero_point) *
+                scale;
+            const bool mask_val = ((quant_min <= qval) && (qval <= quant_max));
+            return std::make_tuple(yval, mask_val);
+          });
     });
 
   } else {
-      // write mask
-      cpu_kernel(iter_mask, [=](SelfType self, float scale, int32_t zero_point) -> bool {
-        float inv_scale = 1.0f / scale;
-        const auto qval = static_cast<int64_t>(zero_point + std::nearbyint(self * inv_scale));
-        return ((quant_min <= qval) && (qval <= quant_max));
-      });
-
-      // write fake_quant
-      cpu_kernel(iter, [=](SelfType self, float scale, int32_t zero_point) -> SelfType {
-        float inv_scale = 1.0f / scale;
-        // NOLINTNEXTLINE(bugprone-narrowing-conversions,cppcoreguidelines-narrowing-conversions)
-        return (std::fmin(
-                    std::fmax(
-                        static_cast<int64_t>(
-                            zero_point + std::nearbyint(self * inv_scale)),
-                        quant_min),
-                    quant_max) -
-                zero_point) *
-            scale;
-      });
+      // write fake_quant and mask in one pass (read once, write twice)
+      cpu_kernel_multiple_outputs(
+          iter,
+          [=](SelfType self, float scale, int32_t zero_point) -> std::tuple<SelfType, bool> {
+            float inv_scale = 1.0f / scale;
+            const auto qval = static_cast<int64_t>(
+                zero_point + std::nearbyint(self * inv_scale));
+            // NOLINTNEXTLINE(bugprone-narrowing-conversions,cppcoreguidelines-narrowing-conversions)
+            const SelfType yval =
+                (std::fmin(std::fmax(qval, quant_min), quant_max) -
+                 zero_point) *
+                scale;
+            const bool mask_val = ((quant_min <= qval) && (qval <= quant_max));
+            return std::make_tuple(yval, mask_val);
+          });
   }
 
 }
@@ -2590,14 +2698,10 @@ void _fake_quant_per_channel_cachemask_cpu_helper(
 
 void fake_quant_per_channel_cachemask_cpu(
     TensorIterator& iter,
-    TensorIterator& iter_mask,
     int64_t quant_min,
     int64_t quant_max) {
-  // TODO(future, optional): read once, write twice.  Not done at the moment
-  //   for simplicity, as we do not expect this to be a bottleneck.
-
   AT_DISPATCH_FLOATING_TYPES_AND_HALF(iter.dtype(), "fake_quantize_channel_cachemask_cpu_type_handling", [&] {
-    _fake_quant_per_channel_cachemask_cpu_helper<scalar_t>(iter, iter_mask, quant_min, quant_max);
+    _fake_quant_per_channel_cachemask_cpu_helper<scalar_t>(iter, quant_min, quant_max);
   });
 }
 
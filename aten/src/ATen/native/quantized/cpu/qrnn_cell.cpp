@@ -0,0 +1,182 @@
+#include <ATen/native/quantized/cpu/qrnn_cell.h>
+
+#include <ATen/Parallel.h>
+#include <ATen/TensorIterator.h>
+#include <ATen/cpu/vec/vec.h>
+#include <c10/util/irange.h>
+
+#include <algorithm>
+#include <tuple>
+
+namespace at {
+namespace native {
+
+namespace {
+
+// Note [Fused quantized RNN cell pointwise]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The dynamically quantized LSTM/GRU cells already run their gate GEMMs
+// through prepacked int8 linear (apply_dynamic, with per-channel weight
+// scales and fused bias). What remained generic was the cell epilogue: a
+// chain of chunk/sigmoid_/tanh_/mul/add ops that allocates half a dozen
+// temporaries per timestep and walks the gate buffer several times. For
+// speech-sized hidden states that pointwise chain, not the GEMM, bounds the
+// per-core step rate.
+//
+// The kernels below compute the full epilogue in one vectorized pass per
+// row: gates and previous state are read once, the new state is written
+// once, so the working set per row is a few cache lines and the hidden
+// state stays resident across the timestep loop. Rows are distributed over
+// threads with parallel_for; the column loop runs on Vectorized<float>
+// lanes with sigmoid composed from exp (Sleef-backed, same as at::sigmoid's
+// vectorized path).
+
+using fvec = vec::Vectorized<float>;
+
+inline fvec vec_sigmoid(fvec x) {
+  const fvec one(1.0f);
+  return one / (one + (fvec(0.0f) - x).exp());
+}
+
+inline float scalar_sigmoid(float x) {
+  return 1.0f / (1.0f + std::exp(-x));
+}
+
+bool is_eligible_2d(const Tensor& t, int64_t rows, int64_t cols) {
+  return t.defined() && t.device().is_cpu() &&
+      t.scalar_type() == kFloat && t.layout() == kStrided &&
+      t.dim() == 2 && t.size(0) == rows && t.size(1) == cols &&
+      t.is_contiguous();
+}
+
+void lstm_cell_pointwise_kernel(
+    const float* gates,
+    const float* cx,
+    float* hy,
+    float* cy,
+    int64_t batch,
+    int64_t hidden) {
+  const int64_t rows_per_grain =
+      std::max<int64_t>(1, at::internal::GRAIN_SIZE / (4 * hidden));
+  at::parallel_for(0, batch, rows_per_grain, [&](int64_t begin, int64_t end) {
+    for (const auto b : c10::irange(begin, end)) {
+      const float* i_gate = gates + b * 4 * hidden;
+      const float* f_gate = i_gate + hidden;
+      const float* g_gate = f_gate + hidden;
+      const float* o_gate = g_gate + hidden;
+      const float* cx_row = cx + b * hidden;
+      float* hy_row = hy + b * hidden;
+      float* cy_row = cy + b * hidden;
+      int64_t h = 0;
+      for (; h + fvec::size() <= hidden; h += fvec::size()) {
+        const fvec ig = vec_sigmoid(fvec::loadu(i_gate + h));
+        const fvec fg = vec_sigmoid(fvec::loadu(f_gate + h));
+        const fvec gg = fvec::loadu(g_gate + h).tanh();
+        const fvec og = vec_sigmoid(fvec::loadu(o_gate + h));
+        const fvec c = fg * fvec::loadu(cx_row + h) + ig * gg;
+        c.store(cy_row + h);
+        (og * c.tanh()).store(hy_row + h);
+      }
+      for (; h < hidden; h++) {
+        const float ig = scalar_sigmoid(i_gate[h]);
+        const float fg = scalar_sigmoid(f_gate[h]);
+        const float gg = std::tanh(g_gate[h]);
+        const float og = scalar_sigmoid(o_gate[h]);
+        const float c = fg * cx_row[h] + ig * gg;
+        cy_row[h] = c;
+        hy_row[h] = og * std::tanh(c);
+      }
+    }
+  });
+}
+
+void gru_cell_pointwise_kernel(
+    const float* igates,
+    const float* hgates,
+    const float* hx,
+    float* hy,
+    int64_t batch,
+    int64_t hidden) {
+  const int64_t rows_per_grain =
+      std::max<int64_t>(1, at::internal::GRAIN_SIZE / (3 * hidden));
+  at::parallel_for(0, batch, rows_per_grain, [&](int64_t begin, int64_t end) {
+    for (const auto b : c10::irange(begin, end)) {
+      const float* ir = igates + b * 3 * hidden;
+      const float* iz = ir + hidden;
+      const float* in = iz + hidden;
+      const float* hr = hgates + b * 3 * hidden;
+      const float* hz = hr + hidden;
+      const float* hn = hz + hidden;
+      const float* hx_row = hx + b * hidden;
+      float* hy_row = hy + b * hidden;
+      int64_t h = 0;
+      for (; h + fvec::size() <= hidden; h += fvec::size()) {
+        const fvec r = vec_sigmoid(fvec::loadu(ir + h) + fvec::loadu(hr + h));
+        const fvec z = vec_sigmoid(fvec::loadu(iz + h) + fvec::loadu(hz + h));
+        const fvec n = (fvec::loadu(in + h) + r * fvec::loadu(hn + h)).tanh();
+        const fvec prev = fvec::loadu(hx_row + h);
+        ((prev - n) * z + n).store(hy_row + h);
+      }
+      for (; h < hidden; h++) {
+        const float r = scalar_sigmoid(ir[h] + hr[h]);
+        const float z = scalar_sigmoid(iz[h] + hz[h]);
+        const float n = std::tanh(in[h] + r * hn[h]);
+        hy_row[h] = (hx_row[h] - n) * z + n;
+      }
+    }
+  });
+}
+
+} // namespace
+
+c10::optional<std::tuple<Tensor, Tensor>> fused_quantized_lstm_cell_pointwise(
+    const Tensor& gates,
+    const Tensor& cx) {
+  if (!cx.defined() || cx.dim() != 2) {
+    return c10::nullopt;
+  }
+  const int64_t batch = cx.size(0);
+  const int64_t hidden = cx.size(1);
+  if (hidden == 0 || !is_eligible_2d(cx, batch, hidden) ||
+      !is_eligible_2d(gates, batch, 4 * hidden)) {
+    return c10::nullopt;
+  }
+  Tensor hy = at::empty_like(cx);
+  Tensor cy = at::empty_like(cx);
+  lstm_cell_pointwise_kernel(
+      gates.data_ptr<float>(),
+      cx.data_ptr<float>(),
+      hy.data_ptr<float>(),
+      cy.data_ptr<float>(),
+      batch,
+      hidden);
+  return std::make_tuple(std::move(hy), std::move(cy));
+}
+
+c10::optional<Tensor> fused_quantized_gru_cell_pointwise(
+    const Tensor& igates,
+    const Tensor& hgates,
+    const Tensor& hidden) {
+  if (!hidden.defined() || hidden.dim() != 2) {
+    return c10::nullopt;
+  }
+  const int64_t batch = hidden.size(0);
+  const int64_t hidden_size = hidden.size(1);
+  if (hidden_size == 0 || !is_eligible_2d(hidden, batch, hidden_size) ||
+      !is_eligible_2d(igates, batch, 3 * hidden_size) ||
+      !is_eligible_2d(hgates, batch, 3 * hidden_size)) {
+    return c10::nullopt;
+  }
+  Tensor hy = at::empty_like(hidden);
+  gru_cell_pointwise_kernel(
+      igates.data_ptr<float>(),
+      hgates.data_ptr<float>(),
+      hidden.data_ptr<float>(),
+      hy.data_ptr<float>(),
+      batch,
+      hidden_size);
+  return hy;
+}
+
+} // namespace native
+} // namespace at
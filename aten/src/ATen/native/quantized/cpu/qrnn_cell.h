@@ -0,0 +1,30 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <c10/util/Optional.h>
+
+namespace at {
+namespace native {
+
+// Fused pointwise epilogues for the dynamically quantized RNN cells, see
+// Note [Fused quantized RNN cell pointwise] in qrnn_cell.cpp. The gate
+// pre-activations come out of the prepacked int8 gate GEMMs in fp32; these
+// kernels apply the gate nonlinearities and the state update in a single
+// vectorized pass. They return nullopt when the inputs are not eligible
+// (wrong dtype, layout or shape), in which case the caller composes the cell
+// out of generic ops.
+
+// gates = W_ih x + W_hh h + b, laid out as [batch, 4 * hidden] with chunks
+// (input, forget, cell, output). Returns (hy, cy).
+TORCH_API c10::optional<std::tuple<Tensor, Tensor>>
+fused_quantized_lstm_cell_pointwise(const Tensor& gates, const Tensor& cx);
+
+// igates = W_ih x + b_ih, hgates = W_hh h + b_hh, each [batch, 3 * hidden]
+// with chunks (reset, update, new). Returns the new hidden state.
+TORCH_API c10::optional<Tensor> fused_quantized_gru_cell_pointwise(
+    const Tensor& igates,
+    const Tensor& hgates,
+    const Tensor& hidden);
+
+} // namespace native
+} // namespace at
@@ -125,65 +125,47 @@ REGISTER_DISPATCH(fake_quant_grad_learnable_tensor_stub, &_fake_quantize_grad_le
 template<typename SelfType>
 void _fake_quant_per_channel_cachemask_cuda_helper(
     TensorIterator & iter,
-    TensorIterator & iter_mask,
     const int64_t quant_min,
     const int64_t quant_max
 ) {
-  // TODO(future, optional): read once, write twice.  Not done at the moment
-  //   for simplicity, as we do not expect this to be a bottleneck.
-
-  //
   const auto & zero_point_dtype = iter.input_dtype(2);
 
-  //
   if (at::isFloatingType(zero_point_dtype)) {
     // When zero_point is float, quantize mirroring affine quantizer equation
     // Xq = Round(Xf * inv_scale + zero_point)
     // where zero_point is in float.
     AT_DISPATCH_FLOATING_TYPES_AND_HALF(zero_point_dtype, "fake_quantize_channel_cachemask_cuda_mask_type_handling", [&] {
-      // write mask
-      gpu_kernel(iter_mask,
-        [=] GPU_LAMBDA (const SelfType input_val, const float scale, const scalar_t zero_point) -> bool {
-          const float inv_scale = 1.0f / scale;
-          const auto qval = std::lrint(input_val * inv_scale + zero_point);
-          return ((quant_min <= qval) && (qval <= quant_max));
-      });
-
-      // write fake_quant
-      gpu_kernel(iter,
-        [=] GPU_LAMBDA (const SelfType input_val, const float scale, const scalar_t zero_point) -> SelfType {
+      // write fake_quant and mask in one pass (read once, write twice)
+      gpu_kernel_multiple_outputs(iter,
+        [=] GPU_LAMBDA (const SelfType input_val, const float scale, const scalar_t zero_point) -> thrust::tuple<SelfType, bool> {
           const float inv_scale = 1.0f / scale;
           const auto qval = std::lrint(input_val * inv_scale + zero_point);
           const auto bounded_qval = fminf(quant_max, fmaxf(quant_min, qval));
-          return (bounded_qval - zero_point) * scale;
+          const SelfType yval = (bounded_qval - zero_point) * scale;
+          const bool mask_val = ((quant_min <= qval) && (qval <= quant_max));
+          return {yval, mask_val};
       });
     });
   }
   else {
-    // write mask
-    gpu_kernel(iter_mask,
-      [=] GPU_LAMBDA (const SelfType input_val, const float scale, const int64_t zero_point) -> bool {
-        const float inv_scale = 1.0f / scale;
-        const auto qval = static_cast<int64_t>(std::nearbyint(input_val * inv_scale)) + zero_point;
-        return ((quant_min <= qval) && (qval <= quant_max));
-    });
-
-    // write fake_quant
-    gpu_kernel(iter,
-      [=] GPU_LAMBDA (const SelfType input_val, const float scale, const int64_t zero_point) -> SelfType {
+    // write fake_quant and mask in one pass (read once, write twice)
+    gpu_kernel_multiple_outputs(iter,
+      [=] GPU_LAMBDA (const SelfType input_val, const float scale, const int64_t zero_point) -> thrust::tuple<SelfType, bool> {
         const float inv_scale = 1.0f / scale;
         const auto qval = static_cast<int64_t>(std::nearbyint(input_val * inv_scale)) + zero_point;
         const auto bounded_qval = std::min(quant_max, std::max(quant_min, qval));
-        return (bounded_qval - zero_point) * scale;
+        const SelfType yval = (bounded_qval - zero_point) * scale;
+        const bool mask_val = ((quant_min <= qval) && (qval <= quant_max));
+        return {yval, mask_val};
     });
   }
 }
 
 
 void fake_quant_per_channel_cachemask_cuda(
-    TensorIterator &iter, TensorIterator &iter_mask, int64_t quant_min, int64_t quant_max) {
+    TensorIterator &iter, int64_t quant_min, int64_t quant_max) {
   AT_DISPATCH_FLOATING_TYPES_AND_HALF(iter.dtype(), "fake_quantize_channel_cachemask_cpu_type_handling", [&] {
-    _fake_quant_per_channel_cachemask_cuda_helper<scalar_t>(iter, iter_mask, quant_min, quant_max);
+    _fake_quant_per_channel_cachemask_cuda_helper<scalar_t>(iter, quant_min, quant_max);
   });
 }
 
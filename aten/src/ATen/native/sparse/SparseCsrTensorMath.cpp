@@ -408,24 +408,52 @@ void addmm_out_sparse_csr_native_cpu(
         int64_t r_stride0 = r.stride(0);
         int64_t r_stride1 = r.stride(1);
 
+        // Partition rows so that every task gets roughly the same number of
+        // nonzeros rather than the same number of rows. crow_indices is
+        // already the prefix sum of per-row nnz, so each task finds its row
+        // range by binary searching for its nnz boundaries. With skewed
+        // (e.g. power-law) row lengths, equal-row chunking leaves most
+        // threads idle while one grinds through the heavy rows.
+        const index_t* csr_data = csr_accessor.data();
+        int64_t total_nnz = csr_accessor[dim_i];
+        int64_t num_tasks = std::max<int64_t>(
+            1,
+            std::min<int64_t>(
+                at::get_num_threads(),
+                total_nnz * dim_k / internal::GRAIN_SIZE));
+
         at::parallel_for(
-            0,
-            dim_i,
-            internal::GRAIN_SIZE,
-            [&](int64_t irow_start, int64_t irow_end) {
-              for (index_t h = irow_start; h < irow_end; ++h) {
-                index_t i_start = csr_accessor[h];
-                index_t i_end = csr_accessor[h + 1];
-                for (index_t i = i_start; i < i_end; i++) {
-                  scalar_t val = values_accessor[i];
-                  index_t col = col_indices_accessor[i];
-                  at::native::cpublas::axpy<scalar_t>(
-                      dim_k,
-                      cast_alpha * val,
-                      dense_ptr + col * dense_stride0,
-                      dense_stride1,
-                      r_ptr + h * r_stride0,
-                      r_stride1);
+            0, num_tasks, 1, [&](int64_t task_begin, int64_t task_end) {
+              for (int64_t task = task_begin; task < task_end; task++) {
+                index_t nnz_start = total_nnz * task / num_tasks;
+                // a row belongs to the task whose nnz range contains the
+                // row's first nonzero, so every row (including empty ones
+                // and rows straddling a boundary) is written by exactly one
+                // thread
+                int64_t row_start =
+                    std::lower_bound(csr_data, csr_data + dim_i, nnz_start) -
+                    csr_data;
+                int64_t row_end = dim_i;
+                if (task + 1 < num_tasks) {
+                  index_t nnz_end = total_nnz * (task + 1) / num_tasks;
+                  row_end =
+                      std::lower_bound(csr_data, csr_data + dim_i, nnz_end) -
+                      csr_data;
+                }
+                for (int64_t h = row_start; h < row_end; ++h) {
+                  index_t i_start = csr_accessor[h];
+                  index_t i_end = csr_accessor[h + 1];
+                  for (index_t i = i_start; i < i_end; i++) {
+                    scalar_t val = values_accessor[i];
+                    index_t col = col_indices_accessor[i];
+                    at::native::cpublas::axpy<scalar_t>(
+                        dim_k,
+                        cast_alpha * val,
+                        dense_ptr + col * dense_stride0,
+                        dense_stride1,
+                        r_ptr + h * r_stride0,
+                        r_stride1);
+                  }
                 }
               }
             });
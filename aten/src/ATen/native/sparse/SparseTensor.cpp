@@ -645,49 +645,99 @@ SparseTensor _coalesce_sparse_cpu(const SparseTensor& self) {
   auto indicesPermutationAccessor = indicesPermutation.accessor<int64_t, 1>();
   auto indicesBufferAccessor = indicesBuffer.accessor<int64_t, 1>();
 
-  int64_t i = -1;
+  // The sort above is the parallel radix sort (see SortingKernel.cpp), so
+  // what is left is the duplicate merge. Find the segment boundaries (runs
+  // of equal flattened indices) with a chunked count / exclusive scan /
+  // fill, then reduce every segment's values in parallel; both passes are
+  // bandwidth-bound.
+  constexpr int64_t kCoalesceChunk = 32768;
+  const int64_t num_chunks = divup(nnz, kCoalesceChunk);
+  std::vector<int64_t> chunk_offsets(num_chunks + 1, 0);
+  at::parallel_for(0, num_chunks, 1, [&](int64_t begin, int64_t end) {
+    for (const auto chunk : c10::irange(begin, end)) {
+      const int64_t start = chunk * kCoalesceChunk;
+      const int64_t len = std::min(kCoalesceChunk, nnz - start);
+      int64_t count = 0;
+      for (const auto j : c10::irange(start, start + len)) {
+        if (j == 0 || indicesBufferAccessor[j] != indicesBufferAccessor[j - 1]) {
+          ++count;
+        }
+      }
+      chunk_offsets[chunk + 1] = count;
+    }
+  });
+  for (const auto chunk : c10::irange(num_chunks)) {
+    chunk_offsets[chunk + 1] += chunk_offsets[chunk];
+  }
+  const int64_t num_segments = chunk_offsets[num_chunks];
+  std::vector<int64_t> segment_offsets(num_segments + 1);
+  segment_offsets[num_segments] = nnz;
+  at::parallel_for(0, num_chunks, 1, [&](int64_t begin, int64_t end) {
+    for (const auto chunk : c10::irange(begin, end)) {
+      const int64_t start = chunk * kCoalesceChunk;
+      const int64_t len = std::min(kCoalesceChunk, nnz - start);
+      int64_t* out = segment_offsets.data() + chunk_offsets[chunk];
+      for (const auto j : c10::irange(start, start + len)) {
+        if (j == 0 || indicesBufferAccessor[j] != indicesBufferAccessor[j - 1]) {
+          *out++ = j;
+        }
+      }
+    }
+  });
+
   AT_DISPATCH_ALL_TYPES_AND_COMPLEX_AND4(
       at::ScalarType::ComplexHalf, at::ScalarType::BFloat16, at::ScalarType::Half, at::ScalarType::Bool,
       values.scalar_type(), "coalesce", [&] {
-    int64_t prev = -1;
     int64_t blockSize = values.stride(0);
     scalar_t* values_ptr = values.data_ptr<scalar_t>();
     scalar_t* newValues_ptr = newValues.data_ptr<scalar_t>();
-    for (const auto j : c10::irange(nnz)) {
-      int64_t pos = indicesPermutationAccessor[j];
-      int64_t curr = indicesBufferAccessor[j];
-      if (curr == prev) {
-        if (values.numel() >
-            0) { // if values is an empty tensor, there are no elements to copy
-          at::native::cpublas::axpy<scalar_t>(
-              blockSize,
-              static_cast<scalar_t>(1),
-              values_ptr + pos * blockSize,
-              1,
-              newValues_ptr + i * blockSize,
-              1);
-        }
-      } else {
-        ++i;
+    const bool has_values =
+        values.numel() > 0; // if values is an empty tensor, there are no
+                            // elements to copy
+    const int64_t grain = std::max<int64_t>(
+        1, at::internal::GRAIN_SIZE / std::max<int64_t>(1, blockSize));
+    at::parallel_for(0, num_segments, grain, [&](int64_t begin, int64_t end) {
+      for (const auto s : c10::irange(begin, end)) {
+        const int64_t segBegin = segment_offsets[s];
+        const int64_t segEnd = segment_offsets[s + 1];
+        const int64_t firstPos = indicesPermutationAccessor[segBegin];
         for (const auto d : c10::irange(sparse_dim)) {
-          newIndicesAccessor[d][i] = indicesAccessor[d][pos];
+          newIndicesAccessor[d][s] = indicesAccessor[d][firstPos];
+        }
+        if (!has_values) {
+          continue;
         }
-        if (values.numel() >
-            0) { // if values is an empty tensor, there are no elements to copy
+        if (blockSize == 1) {
+          // The common dense_dim == 0 case: accumulate in a register
+          // instead of paying one axpy call per duplicate.
+          scalar_t sum = values_ptr[firstPos];
+          for (const auto j : c10::irange(segBegin + 1, segEnd)) {
+            sum += values_ptr[indicesPermutationAccessor[j]];
+          }
+          newValues_ptr[s] = sum;
+        } else {
           at::native::cpublas::copy<scalar_t>(
               blockSize,
-              values_ptr + pos * blockSize,
+              values_ptr + firstPos * blockSize,
               1,
-              newValues_ptr + i * blockSize,
+              newValues_ptr + s * blockSize,
               1);
+          for (const auto j : c10::irange(segBegin + 1, segEnd)) {
+            at::native::cpublas::axpy<scalar_t>(
+                blockSize,
+                static_cast<scalar_t>(1),
+                values_ptr + indicesPermutationAccessor[j] * blockSize,
+                1,
+                newValues_ptr + s * blockSize,
+                1);
+          }
         }
       }
-      prev = curr;
-    }
+    });
   });
 
   dst._coalesced_(true);
-  get_sparse_impl(dst)->set_nnz_and_narrow(i + 1);
+  get_sparse_impl(dst)->set_nnz_and_narrow(num_segments);
 
   return dst;
 }
@@ -0,0 +1,285 @@
+#include <ATen/native/transformers/PagedKVCache.h>
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <ATen/AccumulateType.h>
+#include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+
+#ifndef AT_PER_OPERATOR_HEADERS
+#include <ATen/NativeFunctions.h>
+#else
+#include <ATen/ops/empty.h>
+#include <ATen/ops/empty_like.h>
+#endif
+
+namespace at {
+namespace native {
+
+// See Note [Paged KV cache] in PagedKVCache.h.
+
+PagedKVCacheManager::PagedKVCacheManager(
+    int64_t num_pages,
+    int64_t page_size,
+    int64_t num_heads,
+    int64_t head_dim,
+    const TensorOptions& options)
+    : page_size_(page_size) {
+  TORCH_CHECK(num_pages > 0, "paged KV cache needs at least one page");
+  TORCH_CHECK(page_size > 0, "paged KV cache page size must be positive");
+  key_pool_ = at::empty({num_pages, page_size, num_heads, head_dim}, options);
+  value_pool_ = at::empty({num_pages, page_size, num_heads, head_dim}, options);
+  free_pages_.reserve(num_pages);
+  // Popping from the back hands out low page ids first.
+  for (int64_t page = num_pages - 1; page >= 0; --page) {
+    free_pages_.push_back(page);
+  }
+}
+
+int64_t PagedKVCacheManager::create_sequence() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  const int64_t seq_id = next_seq_id_++;
+  sequences_.emplace(seq_id, Sequence());
+  return seq_id;
+}
+
+void PagedKVCacheManager::release_sequence(int64_t seq_id) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  auto it = sequences_.find(seq_id);
+  TORCH_CHECK(it != sequences_.end(), "unknown KV cache sequence ", seq_id);
+  free_pages_.insert(
+      free_pages_.end(), it->second.pages.begin(), it->second.pages.end());
+  sequences_.erase(it);
+}
+
+const PagedKVCacheManager::Sequence& PagedKVCacheManager::sequence(
+    int64_t seq_id) const {
+  auto it = sequences_.find(seq_id);
+  TORCH_CHECK(it != sequences_.end(), "unknown KV cache sequence ", seq_id);
+  return it->second;
+}
+
+void PagedKVCacheManager::append(
+    int64_t seq_id,
+    const Tensor& key,
+    const Tensor& value) {
+  TORCH_CHECK(
+      key.sizes() == value.sizes(),
+      "paged KV cache append: key and value shapes must match");
+  TORCH_CHECK(
+      key.dim() == 2 || key.dim() == 3,
+      "paged KV cache append expects [num_heads, head_dim] or "
+      "[T, num_heads, head_dim], got ",
+      key.dim(),
+      " dimensions");
+  const auto token_sizes = key_pool_.sizes().slice(2);
+  TORCH_CHECK(
+      key.sizes().slice(key.dim() - 2) == token_sizes,
+      "paged KV cache append: token shape ",
+      key.sizes(),
+      " does not match pool head layout ",
+      token_sizes);
+  const int64_t tokens = key.dim() == 2 ? 1 : key.size(0);
+
+  std::lock_guard<std::mutex> guard(mutex_);
+  auto it = sequences_.find(seq_id);
+  TORCH_CHECK(it != sequences_.end(), "unknown KV cache sequence ", seq_id);
+  auto& seq = it->second;
+  for (const auto t : c10::irange(tokens)) {
+    if (seq.length % page_size_ == 0) {
+      TORCH_CHECK(
+          !free_pages_.empty(),
+          "paged KV cache is out of pages (",
+          key_pool_.size(0),
+          " pages of ",
+          page_size_,
+          " tokens)");
+      seq.pages.push_back(free_pages_.back());
+      free_pages_.pop_back();
+    }
+    const int64_t page = seq.pages.back();
+    const int64_t slot = seq.length % page_size_;
+    const Tensor k = key.dim() == 2 ? key : key.select(0, t);
+    const Tensor v = value.dim() == 2 ? value : value.select(0, t);
+    key_pool_.select(0, page).select(0, slot).copy_(k);
+    value_pool_.select(0, page).select(0, slot).copy_(v);
+    seq.length++;
+  }
+}
+
+int64_t PagedKVCacheManager::sequence_length(int64_t seq_id) const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return sequence(seq_id).length;
+}
+
+int64_t PagedKVCacheManager::free_page_count() const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return static_cast<int64_t>(free_pages_.size());
+}
+
+std::pair<Tensor, Tensor> PagedKVCacheManager::batch_tables(
+    ArrayRef<int64_t> seq_ids) const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  const int64_t B = static_cast<int64_t>(seq_ids.size());
+  int64_t max_pages = 1; // keep the table non-empty for all-empty batches
+  for (const auto seq_id : seq_ids) {
+    max_pages = std::max(
+        max_pages, static_cast<int64_t>(sequence(seq_id).pages.size()));
+  }
+  // Staged on CPU; a single small H2D copy per step on CUDA pools.
+  auto table = at::empty(
+      {B, max_pages}, key_pool_.options().dtype(at::kLong).device(at::kCPU));
+  auto lens =
+      at::empty({B}, key_pool_.options().dtype(at::kLong).device(at::kCPU));
+  auto* table_data = table.data_ptr<int64_t>();
+  auto* lens_data = lens.data_ptr<int64_t>();
+  for (const auto b : c10::irange(B)) {
+    const auto& seq = sequence(seq_ids[b]);
+    for (const auto p : c10::irange(max_pages)) {
+      table_data[b * max_pages + p] =
+          p < static_cast<int64_t>(seq.pages.size()) ? seq.pages[p] : 0;
+    }
+    lens_data[b] = seq.length;
+  }
+  if (key_pool_.is_cpu()) {
+    return std::make_pair(std::move(table), std::move(lens));
+  }
+  return std::make_pair(
+      table.to(key_pool_.device()), lens.to(key_pool_.device()));
+}
+
+void check_paged_attention_inputs(
+    const Tensor& query,
+    const Tensor& key_pool,
+    const Tensor& value_pool,
+    const Tensor& page_table,
+    const Tensor& seq_lens) {
+  TORCH_CHECK(
+      query.dim() == 3,
+      "_paged_attention: query must be [batch, num_heads, head_dim], got ",
+      query.dim(),
+      " dimensions");
+  TORCH_CHECK(
+      key_pool.dim() == 4 && value_pool.sizes() == key_pool.sizes(),
+      "_paged_attention: pools must both be "
+      "[num_pages, page_size, num_heads, head_dim]");
+  TORCH_CHECK(
+      key_pool.size(2) == query.size(1) && key_pool.size(3) == query.size(2),
+      "_paged_attention: pool head layout ",
+      key_pool.sizes().slice(2),
+      " does not match query ",
+      query.sizes().slice(1));
+  TORCH_CHECK(
+      query.scalar_type() == key_pool.scalar_type() &&
+          query.scalar_type() == value_pool.scalar_type(),
+      "_paged_attention: query and pools must share a dtype");
+  TORCH_CHECK(
+      page_table.dim() == 2 && page_table.size(0) == query.size(0),
+      "_paged_attention: page_table must be [batch, max_pages]");
+  TORCH_CHECK(
+      page_table.scalar_type() == ScalarType::Long &&
+          seq_lens.scalar_type() == ScalarType::Long,
+      "_paged_attention: page_table and seq_lens must be int64");
+  TORCH_CHECK(
+      seq_lens.dim() == 1 && seq_lens.size(0) == query.size(0),
+      "_paged_attention: seq_lens must be [batch]");
+}
+
+Tensor paged_attention_cpu(
+    const Tensor& query,
+    const Tensor& key_pool,
+    const Tensor& value_pool,
+    const Tensor& page_table,
+    const Tensor& seq_lens,
+    double scale) {
+  check_paged_attention_inputs(
+      query, key_pool, value_pool, page_table, seq_lens);
+  const auto q = query.contiguous();
+  const auto k_pool = key_pool.contiguous();
+  const auto v_pool = value_pool.contiguous();
+  const auto table = page_table.contiguous();
+  const auto lens = seq_lens.contiguous();
+
+  const int64_t B = q.size(0);
+  const int64_t H = q.size(1);
+  const int64_t D = q.size(2);
+  const int64_t S = k_pool.size(1);
+  const int64_t max_pages = table.size(1);
+
+  auto out = at::empty_like(q);
+  const auto* table_data = table.data_ptr<int64_t>();
+  const auto* lens_data = lens.data_ptr<int64_t>();
+
+  AT_DISPATCH_FLOATING_TYPES_AND2(
+      ScalarType::Half,
+      ScalarType::BFloat16,
+      q.scalar_type(),
+      "paged_attention_cpu",
+      [&] {
+        using accscalar_t = at::acc_type<scalar_t, false>;
+        const auto* q_data = q.data_ptr<scalar_t>();
+        const auto* k_data = k_pool.data_ptr<scalar_t>();
+        const auto* v_data = v_pool.data_ptr<scalar_t>();
+        auto* out_data = out.data_ptr<scalar_t>();
+        at::parallel_for(0, B * H, 1, [&](int64_t begin, int64_t end) {
+          std::vector<accscalar_t> scores;
+          for (const auto i : c10::irange(begin, end)) {
+            const int64_t b = i / H;
+            const int64_t h = i % H;
+            const int64_t T = lens_data[b];
+            scalar_t* o = out_data + i * D;
+            if (T == 0) {
+              for (const auto d : c10::irange(D)) {
+                o[d] = scalar_t(0);
+              }
+              continue;
+            }
+            TORCH_CHECK(
+                T <= max_pages * S,
+                "_paged_attention: sequence length ",
+                T,
+                " exceeds the page table");
+            const scalar_t* q_row = q_data + i * D;
+            scores.resize(T);
+            accscalar_t max_score =
+                -std::numeric_limits<accscalar_t>::infinity();
+            for (const auto t : c10::irange(T)) {
+              const int64_t page = table_data[b * max_pages + t / S];
+              const scalar_t* k =
+                  k_data + ((page * S + t % S) * H + h) * D;
+              accscalar_t s = 0;
+              for (const auto d : c10::irange(D)) {
+                s += static_cast<accscalar_t>(q_row[d]) *
+                    static_cast<accscalar_t>(k[d]);
+              }
+              scores[t] = s * static_cast<accscalar_t>(scale);
+              max_score = std::max(max_score, scores[t]);
+            }
+            accscalar_t sum = 0;
+            for (const auto t : c10::irange(T)) {
+              scores[t] = std::exp(scores[t] - max_score);
+              sum += scores[t];
+            }
+            std::vector<accscalar_t> acc(D, accscalar_t(0));
+            for (const auto t : c10::irange(T)) {
+              const int64_t page = table_data[b * max_pages + t / S];
+              const scalar_t* v =
+                  v_data + ((page * S + t % S) * H + h) * D;
+              const accscalar_t p = scores[t] / sum;
+              for (const auto d : c10::irange(D)) {
+                acc[d] += p * static_cast<accscalar_t>(v[d]);
+              }
+            }
+            for (const auto d : c10::irange(D)) {
+              o[d] = static_cast<scalar_t>(acc[d]);
+            }
+          }
+        });
+      });
+  return out;
+}
+
+} // namespace native
+} // namespace at
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <ATen/ATen.h>
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace at {
+namespace native {
+
+// Note [Paged KV cache]
+// ~~~~~~~~~~~~~~~~~~~~~
+// Incremental decoding keeps per-sequence key/value history around between
+// steps. Allocating that history as one contiguous [max_seq_len, H, D]
+// tensor per sequence reserves worst-case memory up front: a sequence that
+// stops after 40 tokens still pins the full allocation, and batch capacity
+// is bounded by the longest sequence anyone might submit.
+//
+// PagedKVCacheManager instead carves a fixed pool of fixed-size pages (the
+// pool tensors come from the regular caching allocator) and maps each
+// sequence onto pages through a per-sequence page table, so cache memory
+// tracks the number of tokens actually generated. Pages are recycled on a
+// free list when a sequence is released. _paged_attention (see
+// native_functions.yaml) consumes the pool plus a batched page table
+// directly, so the pages are never gathered back into contiguous tensors.
+//
+// The manager only does bookkeeping and token-sized copies; it is guarded
+// by a mutex so several request threads can share one pool, but the caller
+// is responsible for ordering appends against the kernels that read them
+// (on CUDA, by issuing both on the same stream).
+class TORCH_API PagedKVCacheManager {
+ public:
+  // Pool layout is [num_pages, page_size, num_heads, head_dim] for keys and
+  // values separately; `options` picks the dtype and device.
+  PagedKVCacheManager(
+      int64_t num_pages,
+      int64_t page_size,
+      int64_t num_heads,
+      int64_t head_dim,
+      const TensorOptions& options);
+
+  // Registers a new empty sequence and returns its id. No pages are held
+  // until the first append.
+  int64_t create_sequence();
+
+  // Returns the sequence's pages to the free list.
+  void release_sequence(int64_t seq_id);
+
+  // Appends one token's keys/values ([num_heads, head_dim]) or a run of
+  // tokens ([T, num_heads, head_dim]), taking a fresh page whenever the
+  // current one fills up. Throws if the pool is exhausted.
+  void append(int64_t seq_id, const Tensor& key, const Tensor& value);
+
+  int64_t sequence_length(int64_t seq_id) const;
+  int64_t free_page_count() const;
+
+  // Builds the `page_table` ([B, max_pages_in_batch], padded with 0) and
+  // `seq_lens` ([B]) arguments of _paged_attention for a batch of
+  // sequences, on the pool's device.
+  std::pair<Tensor, Tensor> batch_tables(ArrayRef<int64_t> seq_ids) const;
+
+  const Tensor& key_pool() const {
+    return key_pool_;
+  }
+  const Tensor& value_pool() const {
+    return value_pool_;
+  }
+  int64_t page_size() const {
+    return page_size_;
+  }
+
+ private:
+  struct Sequence {
+    std::vector<int64_t> pages;
+    int64_t length = 0;
+  };
+
+  const Sequence& sequence(int64_t seq_id) const;
+
+  Tensor key_pool_;
+  Tensor value_pool_;
+  int64_t page_size_;
+  std::vector<int64_t> free_pages_;
+  std::unordered_map<int64_t, Sequence> sequences_;
+  int64_t next_seq_id_ = 0;
+  mutable std::mutex mutex_;
+};
+
+// Argument validation shared by the CPU and CUDA _paged_attention kernels.
+TORCH_API void check_paged_attention_inputs(
+    const Tensor& query,
+    const Tensor& key_pool,
+    const Tensor& value_pool,
+    const Tensor& page_table,
+    const Tensor& seq_lens);
+
+} // namespace native
+} // namespace at
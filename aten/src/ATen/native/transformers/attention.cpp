@@ -1,3 +1,5 @@
+#include <cmath>
+#include <limits>
 #include <type_traits>
 
 #include <ATen/ATen.h>
@@ -6,12 +8,20 @@
 #include <ATen/NestedTensorImpl.h>
 #include <ATen/Parallel.h>
 #include <ATen/TensorIndexing.h>
+#include <ATen/core/grad_mode.h>
+#include <ATen/cpu/vec/functional.h>
 #include <ATen/cpu/vec/vec256/vec256.h>
 
 #ifndef AT_PER_OPERATOR_HEADERS
 #include <ATen/NativeFunctions.h>
 #else
+#include <ATen/ops/arange.h>
 #include <ATen/ops/cat.h>
+#include <ATen/ops/dropout.h>
+#include <ATen/ops/empty.h>
+#include <ATen/ops/matmul.h>
+#include <ATen/ops/ones.h>
+#include <ATen/ops/softmax.h>
 #endif
 
 #include <ATen/native/nested/NestedTensorTransformerFunctions.h>
@@ -259,8 +269,493 @@ Tensor qkv_projection(
   return qkv;
 }
 
+// Note [Flash attention CPU kernel]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The decomposed attention path materializes the full S = QK^T matrix, which
+// for an 8k context is 64M floats per head and blows past L3. This kernel
+// instead walks the keys in tiles and maintains, per query row, a running
+// max, a running sum of exponentials rescaled whenever the max moves
+// ("online softmax"), and an accumulator of probability-weighted V rows.
+// Only a [query block x key block] score tile and a [query block x Ev]
+// accumulator live at any time, so memory is O(N) and the tiles stay in
+// cache. Work is split across threads by (batch * head, query block).
+constexpr int64_t kFlashQueryBlock = 32;
+constexpr int64_t kFlashKeyBlock = 128;
+
+template <typename scalar_t>
+void cpu_flash_attention_inner_loop(
+    scalar_t* out_data, // [batch, M, Ev]
+    const scalar_t* q_data, // [batch, M, E]
+    const scalar_t* k_data, // [batch, N, E]
+    const scalar_t* v_data, // [batch, N, Ev]
+    int64_t num_q_blocks,
+    int64_t M,
+    int64_t N,
+    int64_t E,
+    int64_t Ev,
+    scalar_t scale,
+    int64_t window_left,
+    int64_t window_right,
+    int64_t begin,
+    int64_t end) {
+  using Vec = vec::Vectorized<scalar_t>;
+  constexpr int64_t kQueryBlock = kFlashQueryBlock;
+  constexpr int64_t kKeyBlock = kFlashKeyBlock;
+  // Query i attends to keys j with i + offset - window_left <= j <=
+  // i + offset + window_right, where offset = N - M aligns the last query
+  // row with the last key (the incremental decoding convention). Causal
+  // attention is window_right == 0; a width of M + N is unbounded.
+  const int64_t offset = N - M;
+
+  const auto dot = [E](const scalar_t* a, const scalar_t* b) -> scalar_t {
+    Vec acc_vec(scalar_t(0));
+    int64_t d = 0;
+    for (; d + Vec::size() <= E; d += Vec::size()) {
+      acc_vec = vec::fmadd(Vec::loadu(a + d), Vec::loadu(b + d), acc_vec);
+    }
+    scalar_t acc = vec::vec_reduce_all<scalar_t>(
+        [](Vec& x, Vec& y) { return x + y; }, acc_vec);
+    for (; d < E; d++) {
+      acc += a[d] * b[d];
+    }
+    return acc;
+  };
+
+  std::vector<scalar_t> scores(kQueryBlock * kKeyBlock);
+  std::vector<scalar_t> accum(kQueryBlock * Ev);
+  std::vector<scalar_t> row_max(kQueryBlock);
+  std::vector<scalar_t> row_sum(kQueryBlock);
+  for (const auto task : c10::irange(begin, end)) {
+    const int64_t b = task / num_q_blocks;
+    const int64_t q_start = (task % num_q_blocks) * kQueryBlock;
+    const int64_t q_size = std::min(kQueryBlock, M - q_start);
+    const scalar_t* q_block = q_data + b * M * E + q_start * E;
+    std::fill(accum.begin(), accum.begin() + q_size * Ev, scalar_t(0));
+    std::fill(
+        row_max.begin(),
+        row_max.begin() + q_size,
+        -std::numeric_limits<scalar_t>::infinity());
+    std::fill(row_sum.begin(), row_sum.begin() + q_size, scalar_t(0));
+    // Tiles fully left of the band are never visited; tiles right of it
+    // terminate the key scan.
+    const int64_t first_tile = std::max<int64_t>(
+        int64_t(0), (q_start + offset - window_left) / kKeyBlock * kKeyBlock);
+    for (int64_t k_start = first_tile; k_start < N; k_start += kKeyBlock) {
+      if (k_start > q_start + q_size - 1 + offset + window_right) {
+        break;
+      }
+      const int64_t k_size = std::min(kKeyBlock, N - k_start);
+      const scalar_t* k_block = k_data + b * N * E + k_start * E;
+      const scalar_t* v_block = v_data + b * N * Ev + k_start * Ev;
+      for (const auto i : c10::irange(q_size)) {
+        const int64_t q_row_idx = q_start + i + offset;
+        const int64_t j_begin =
+            std::max<int64_t>(int64_t(0), q_row_idx - window_left - k_start);
+        const int64_t j_end =
+            std::min(k_size, q_row_idx + window_right - k_start + 1);
+        if (j_end <= j_begin) {
+          continue;
+        }
+        const int64_t j_len = j_end - j_begin;
+        scalar_t* s = scores.data() + i * kKeyBlock + j_begin;
+        const scalar_t* q_row = q_block + i * E;
+        for (const auto j : c10::irange(j_len)) {
+          s[j] = scale * dot(q_row, k_block + (j_begin + j) * E);
+        }
+        const scalar_t block_max = vec::reduce_all<scalar_t>(
+            [](Vec& x, Vec& y) { return vec::maximum(x, y); }, s, j_len);
+        const scalar_t new_max = std::max(row_max[i], block_max);
+        // Exponentiate the tile in place against the new max and rescale
+        // the running sum and accumulator by exp(old_max - new_max).
+        const Vec max_vec(new_max);
+        Vec sum_vec(scalar_t(0));
+        int64_t j = 0;
+        for (; j + Vec::size() <= j_len; j += Vec::size()) {
+          const Vec p = (Vec::loadu(s + j) - max_vec).exp();
+          p.store(s + j);
+          sum_vec = sum_vec + p;
+        }
+        scalar_t block_sum = vec::vec_reduce_all<scalar_t>(
+            [](Vec& x, Vec& y) { return x + y; }, sum_vec);
+        for (; j < j_len; j++) {
+          const scalar_t p = std::exp(s[j] - new_max);
+          s[j] = p;
+          block_sum += p;
+        }
+        const scalar_t correction =
+            row_max[i] == new_max ? scalar_t(1) : std::exp(row_max[i] - new_max);
+        row_sum[i] = row_sum[i] * correction + block_sum;
+        row_max[i] = new_max;
+        scalar_t* acc_row = accum.data() + i * Ev;
+        if (correction != scalar_t(1)) {
+          const Vec corr_vec(correction);
+          int64_t d = 0;
+          for (; d + Vec::size() <= Ev; d += Vec::size()) {
+            (Vec::loadu(acc_row + d) * corr_vec).store(acc_row + d);
+          }
+          for (; d < Ev; d++) {
+            acc_row[d] *= correction;
+          }
+        }
+        for (const auto jj : c10::irange(j_len)) {
+          const Vec p_vec(s[jj]);
+          const scalar_t* v_row = v_block + (j_begin + jj) * Ev;
+          int64_t d = 0;
+          for (; d + Vec::size() <= Ev; d += Vec::size()) {
+            vec::fmadd(p_vec, Vec::loadu(v_row + d), Vec::loadu(acc_row + d))
+                .store(acc_row + d);
+          }
+          for (; d < Ev; d++) {
+            acc_row[d] += s[jj] * v_row[d];
+          }
+        }
+      }
+    }
+    scalar_t* out_block = out_data + b * M * Ev + q_start * Ev;
+    for (const auto i : c10::irange(q_size)) {
+      // row_sum > 0: every row sees at least one key (the callers reject
+      // causal shapes with N < M, empty key sequences, and bands that
+      // leave a query row without keys).
+      const Vec inv_vec(scalar_t(1) / row_sum[i]);
+      const scalar_t* acc_row = accum.data() + i * Ev;
+      scalar_t* out_row = out_block + i * Ev;
+      int64_t d = 0;
+      for (; d + Vec::size() <= Ev; d += Vec::size()) {
+        (Vec::loadu(acc_row + d) * inv_vec).store(out_row + d);
+      }
+      for (; d < Ev; d++) {
+        out_row[d] = acc_row[d] / row_sum[i];
+      }
+    }
+  }
+}
+
+bool can_use_cpu_flash_attention(
+    const Tensor& query,
+    const Tensor& key,
+    const Tensor& value,
+    const c10::optional<Tensor>& attn_mask,
+    double dropout_p,
+    bool need_attn_weights,
+    bool is_causal) {
+  if (need_attn_weights || dropout_p != 0.0 || attn_mask.has_value()) {
+    return false;
+  }
+  if (!query.is_cpu() || !key.is_cpu() || !value.is_cpu()) {
+    return false;
+  }
+  if (query.is_nested() || key.is_nested() || value.is_nested()) {
+    return false;
+  }
+  if (query.layout() != kStrided || key.layout() != kStrided ||
+      value.layout() != kStrided) {
+    return false;
+  }
+  const auto type = query.scalar_type();
+  if ((type != ScalarType::Float && type != ScalarType::Double) ||
+      key.scalar_type() != type || value.scalar_type() != type) {
+    return false;
+  }
+  if (query.dim() < 3 || key.dim() != query.dim() ||
+      value.dim() != query.dim()) {
+    return false;
+  }
+  // Identical batch/head dims; broadcasting stays on the math path.
+  for (const auto d : c10::irange(query.dim() - 2)) {
+    if (key.size(d) != query.size(d) || value.size(d) != query.size(d)) {
+      return false;
+    }
+  }
+  if (query.size(-1) != key.size(-1) || key.size(-2) != value.size(-2)) {
+    return false;
+  }
+  if (query.size(-2) == 0 || query.size(-1) == 0 || key.size(-2) == 0 ||
+      value.size(-1) == 0) {
+    return false;
+  }
+  // The kernel's causal convention needs every query row to see a key.
+  if (is_causal && key.size(-2) < query.size(-2)) {
+    return false;
+  }
+  // The fused kernel has no backward.
+  if (GradMode::is_enabled() &&
+      (query.requires_grad() || key.requires_grad() || value.requires_grad())) {
+    return false;
+  }
+  return true;
+}
+
+Tensor cpu_flash_attention(
+    const Tensor& query,
+    const Tensor& key,
+    const Tensor& value,
+    int64_t window_left,
+    int64_t window_right) {
+  const int64_t M = query.size(-2);
+  const int64_t E = query.size(-1);
+  const int64_t N = key.size(-2);
+  const int64_t Ev = value.size(-1);
+  const int64_t batch = query.numel() / (M * E);
+  const auto q = query.contiguous();
+  const auto k = key.contiguous();
+  const auto v = value.contiguous();
+  auto out_sizes = query.sizes().vec();
+  out_sizes.back() = Ev;
+  auto out = at::empty(out_sizes, query.options());
+
+  const int64_t num_q_blocks = (M + kFlashQueryBlock - 1) / kFlashQueryBlock;
+  AT_DISPATCH_FLOATING_TYPES(query.scalar_type(), "cpu_flash_attention", [&] {
+    scalar_t* out_data = out.data_ptr<scalar_t>();
+    const scalar_t* q_data = q.data_ptr<scalar_t>();
+    const scalar_t* k_data = k.data_ptr<scalar_t>();
+    const scalar_t* v_data = v.data_ptr<scalar_t>();
+    const auto scale =
+        static_cast<scalar_t>(1.0 / std::sqrt(static_cast<double>(E)));
+    parallel_for(
+        0, batch * num_q_blocks, 1, [&](int64_t begin, int64_t end) {
+          cpu_flash_attention_inner_loop(
+              out_data,
+              q_data,
+              k_data,
+              v_data,
+              num_q_blocks,
+              M,
+              N,
+              E,
+              Ev,
+              scale,
+              window_left,
+              window_right,
+              begin,
+              end);
+        });
+  });
+  return out;
+}
+
+// Banded attention for backends without the fused kernel (CUDA and autograd
+// included): each query chunk attends only to its in-band key slab, so
+// compute and memory are O(M * window) instead of O(M * N) while staying on
+// ordinary, differentiable matmul/softmax ops (batched GEMMs on GPU).
+Tensor banded_attention_chunked(
+    const Tensor& query,
+    const Tensor& key,
+    const Tensor& value,
+    int64_t window_left,
+    int64_t window_right) {
+  const int64_t M = query.size(-2);
+  const int64_t N = key.size(-2);
+  const int64_t offset = N - M;
+  const auto scale = 1.0 / std::sqrt(static_cast<double>(query.size(-1)));
+  // Chunks at least as wide as the band amortize the slab overlap between
+  // neighbouring chunks.
+  const int64_t chunk =
+      std::max<int64_t>(kFlashKeyBlock, window_left + window_right + 1);
+  std::vector<Tensor> out_chunks;
+  out_chunks.reserve((M + chunk - 1) / chunk);
+  const auto long_opts = query.options().dtype(at::kLong);
+  for (int64_t q_start = 0; q_start < M; q_start += chunk) {
+    const int64_t q_size = std::min(chunk, M - q_start);
+    const int64_t k_begin =
+        std::max<int64_t>(int64_t(0), q_start + offset - window_left);
+    const int64_t k_end =
+        std::min(N, q_start + q_size - 1 + offset + window_right + 1);
+    const auto q_chunk = query.narrow(-2, q_start, q_size);
+    const auto k_slab = key.narrow(-2, k_begin, k_end - k_begin);
+    const auto v_slab = value.narrow(-2, k_begin, k_end - k_begin);
+    auto attn = at::matmul(q_chunk, k_slab.transpose(-2, -1)) * scale;
+    // Mask the slab corners that fall outside the band.
+    const auto rows =
+        at::arange(q_start + offset, q_start + offset + q_size, long_opts)
+            .unsqueeze(1);
+    const auto cols = at::arange(k_begin, k_end, long_opts).unsqueeze(0);
+    const auto dist = cols - rows;
+    const auto out_of_band =
+        dist.lt(-window_left).logical_or_(dist.gt(window_right));
+    attn = attn.masked_fill(
+        out_of_band, -std::numeric_limits<double>::infinity());
+    out_chunks.push_back(at::matmul(at::softmax(attn, -1), v_slab));
+  }
+  return at::cat(out_chunks, -2);
+}
+
+// Recognizes a 2-D boolean mask that encodes a contiguous sliding window
+// around the (N - M)-aligned diagonal and returns its left/right widths.
+// Costs a few passes over the mask, which is negligible next to the dense
+// attention it avoids.
+c10::optional<std::pair<int64_t, int64_t>> detect_banded_mask(
+    const Tensor& mask,
+    int64_t M,
+    int64_t N) {
+  if (mask.dim() != 2 || mask.scalar_type() != ScalarType::Bool ||
+      mask.size(0) != M || mask.size(1) != N) {
+    return c10::nullopt;
+  }
+  const auto counts = mask.sum(-1);
+  if (counts.min().item<int64_t>() == 0) {
+    // A row with no keys is not a window (softmax would NaN anyway).
+    return c10::nullopt;
+  }
+  // argmax on the byte view finds the first/last true entry per row.
+  const auto bytes = mask.to(ScalarType::Byte);
+  const auto first = bytes.argmax(-1);
+  const auto last = (N - 1) - bytes.flip(-1).argmax(-1);
+  if (!counts.equal(last - first + 1)) {
+    return c10::nullopt; // holes inside a row
+  }
+  const auto rows = at::arange(N - M, N, mask.options().dtype(at::kLong));
+  const int64_t window_left = (rows - first).max().item<int64_t>();
+  const int64_t window_right = (last - rows).max().item<int64_t>();
+  if (window_left < 0 || window_right < 0) {
+    return c10::nullopt; // band entirely off the diagonal
+  }
+  // The widths must reproduce the mask exactly, up to clipping at the
+  // edges of the key sequence.
+  if (!first.equal((rows - window_left).clamp_min(0)) ||
+      !last.equal((rows + window_right).clamp_max(N - 1))) {
+    return c10::nullopt;
+  }
+  return std::make_pair(window_left, window_right);
+}
+
+std::tuple<Tensor, Tensor> scaled_dot_product_attention_math(
+    const Tensor& query,
+    const Tensor& key,
+    const Tensor& value,
+    const c10::optional<Tensor>& attn_mask_opt,
+    double dropout_p,
+    bool is_causal) {
+  const auto scaling_factor =
+      1.0 / std::sqrt(static_cast<double>(query.size(-1)));
+  auto attn = at::matmul(query, key.transpose(-2, -1)) * scaling_factor;
+  if (is_causal) {
+    TORCH_CHECK(
+        !attn_mask_opt.has_value(),
+        "_scaled_dot_product_attention: Explicit attn_mask should not be "
+        "set when is_causal=True");
+    const auto causal_mask =
+        at::ones({query.size(-2), key.size(-2)},
+                 query.options().dtype(at::kBool))
+            .tril();
+    attn = attn.masked_fill(
+        causal_mask.logical_not(),
+        -std::numeric_limits<double>::infinity());
+  }
+  if (attn_mask_opt.has_value()) {
+    if (attn_mask_opt->dtype() == at::kBool) {
+      attn = attn.masked_fill(
+          attn_mask_opt->logical_not(),
+          -std::numeric_limits<double>::infinity());
+    } else {
+      attn = attn + *attn_mask_opt;
+    }
+  }
+  attn = at::softmax(attn, -1);
+  if (dropout_p > 0.0) {
+    attn = at::dropout(attn, dropout_p, /*train=*/true);
+  }
+  return std::make_tuple(at::matmul(attn, value), std::move(attn));
+}
+
 } // namespace
 
+Tensor _banded_scaled_dot_product_attention(
+    const Tensor& query,
+    const Tensor& key,
+    const Tensor& value,
+    int64_t window_left,
+    int64_t window_right) {
+  TORCH_CHECK(
+      !query.is_nested() && !key.is_nested() && !value.is_nested(),
+      "_banded_scaled_dot_product_attention: nested tensors are not "
+      "supported");
+  TORCH_CHECK(
+      query.dim() >= 3 && key.dim() == query.dim() &&
+          value.dim() == query.dim(),
+      "_banded_scaled_dot_product_attention: query, key and value must have "
+      "the same number of dimensions (at least 3)");
+  for (const auto d : c10::irange(query.dim() - 2)) {
+    TORCH_CHECK(
+        key.size(d) == query.size(d) && value.size(d) == query.size(d),
+        "_banded_scaled_dot_product_attention: query, key and value must "
+        "share batch and head dimensions");
+  }
+  TORCH_CHECK(
+      query.size(-1) == key.size(-1) && key.size(-2) == value.size(-2),
+      "_banded_scaled_dot_product_attention: inconsistent embedding or "
+      "sequence dimensions");
+  TORCH_CHECK(
+      query.size(-2) > 0 && query.size(-1) > 0 && key.size(-2) > 0 &&
+          value.size(-1) > 0,
+      "_banded_scaled_dot_product_attention: expected non-empty tensors");
+  TORCH_CHECK(
+      window_left >= 0 && window_right >= 0,
+      "_banded_scaled_dot_product_attention: window widths must be "
+      "non-negative");
+  // Rows are aligned to the (N - M) diagonal; the first query row is the
+  // one at risk of an empty band.
+  TORCH_CHECK(
+      key.size(-2) - query.size(-2) + window_right >= 0,
+      "_banded_scaled_dot_product_attention: the first query row attends to "
+      "no key; widen window_right");
+  if (can_use_cpu_flash_attention(
+          query, key, value, c10::nullopt, /*dropout_p=*/0.0,
+          /*need_attn_weights=*/false, /*is_causal=*/false)) {
+    return cpu_flash_attention(query, key, value, window_left, window_right);
+  }
+  return banded_attention_chunked(
+      query, key, value, window_left, window_right);
+}
+
+std::tuple<Tensor, Tensor> _scaled_dot_product_attention(
+    const Tensor& query,
+    const Tensor& key,
+    const Tensor& value,
+    const c10::optional<Tensor>& attn_mask,
+    double dropout_p,
+    bool need_attn_weights,
+    bool is_causal) {
+  // See Note [Flash attention CPU kernel].
+  if (can_use_cpu_flash_attention(
+          query, key, value, attn_mask, dropout_p, need_attn_weights,
+          is_causal)) {
+    const int64_t unbounded = query.size(-2) + key.size(-2);
+    return std::make_tuple(
+        cpu_flash_attention(
+            query, key, value, unbounded, is_causal ? 0 : unbounded),
+        Tensor());
+  }
+  // A boolean mask that encodes a narrow sliding window routes to the
+  // banded kernel, which skips out-of-band score tiles entirely.
+  if (attn_mask.has_value() && !need_attn_weights && !is_causal &&
+      dropout_p == 0.0 && !query.is_nested() && !key.is_nested() &&
+      !value.is_nested() && query.dim() >= 3 && key.dim() == query.dim() &&
+      value.dim() == query.dim() && query.size(-2) > 0 &&
+      query.size(-1) > 0 && key.size(-2) > 0 && value.size(-1) > 0 &&
+      query.size(-1) == key.size(-1) && key.size(-2) == value.size(-2)) {
+    bool same_batch = true;
+    for (const auto d : c10::irange(query.dim() - 2)) {
+      same_batch = same_batch && key.size(d) == query.size(d) &&
+          value.size(d) == query.size(d);
+    }
+    if (same_batch) {
+      const int64_t N = key.size(-2);
+      const auto band =
+          detect_banded_mask(*attn_mask, query.size(-2), N);
+      // Route only when the band is narrow enough for the skipped tiles to
+      // pay for the detection scan.
+      if (band.has_value() && band->first + band->second + 1 <= N / 2) {
+        return std::make_tuple(
+            _banded_scaled_dot_product_attention(
+                query, key, value, band->first, band->second),
+            Tensor());
+      }
+    }
+  }
+  return scaled_dot_product_attention_math(
+      query, key, value, attn_mask, dropout_p, is_causal);
+}
+
 // compute q = (q + q_bias) / sqrt(dim_per_head), k = k + k_bias, v = v + v_bias
 std::tuple<Tensor, Tensor, Tensor> transform_bias_rescale_qkv_cpu(
     const Tensor& qkv,
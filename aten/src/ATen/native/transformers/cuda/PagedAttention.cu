@@ -0,0 +1,197 @@
+#include <ATen/ATen.h>
+#include <ATen/AccumulateType.h>
+#include <ATen/Dispatch.h>
+
+#include <ATen/cuda/CUDAContext.h>
+
+#include <ATen/native/transformers/PagedKVCache.h>
+
+#ifndef AT_PER_OPERATOR_HEADERS
+#include <ATen/NativeFunctions.h>
+#else
+#include <ATen/ops/empty_like.h>
+#endif
+
+namespace at {
+
+namespace native {
+
+namespace {
+
+// One block per (sequence, head). Threads sweep the cached tokens in
+// shared-memory chunks: the block first computes the scores of a chunk
+// (threads strided over tokens, following the page table into the pool),
+// then folds the chunk into a running online softmax (threads strided over
+// head dims), so neither the scores nor the gathered keys/values for the
+// whole sequence are ever materialized. See Note [Paged KV cache].
+constexpr int kPagedAttentionThreads = 128;
+constexpr int kPagedAttentionChunk = 128;
+// Per-thread output accumulator registers; bounds head_dim to
+// kPagedAttentionThreads * kPagedAttentionMaxDimsPerThread.
+constexpr int kPagedAttentionMaxDimsPerThread = 4;
+
+template <typename scalar_t, typename accscalar_t>
+__global__ void paged_attention_kernel(
+    const scalar_t* __restrict__ query, // [B, H, D]
+    const scalar_t* __restrict__ key_pool, // [P, S, H, D]
+    const scalar_t* __restrict__ value_pool, // [P, S, H, D]
+    const int64_t* __restrict__ page_table, // [B, max_pages]
+    const int64_t* __restrict__ seq_lens, // [B]
+    scalar_t* __restrict__ out, // [B, H, D]
+    int H,
+    int D,
+    int S,
+    int max_pages,
+    accscalar_t scale) {
+  const int b = blockIdx.x;
+  const int h = blockIdx.y;
+  const int tid = threadIdx.x;
+  const int64_t T = seq_lens[b];
+
+  scalar_t* o = out + (static_cast<int64_t>(b) * H + h) * D;
+  if (T == 0) {
+    for (int d = tid; d < D; d += blockDim.x) {
+      o[d] = scalar_t(0);
+    }
+    return;
+  }
+
+  extern __shared__ char smem_raw[];
+  accscalar_t* q_s = reinterpret_cast<accscalar_t*>(smem_raw); // [D]
+  accscalar_t* scores = q_s + D; // [kPagedAttentionChunk]
+  __shared__ accscalar_t running_max, running_sum, rescale_s;
+
+  const scalar_t* q_row = query + (static_cast<int64_t>(b) * H + h) * D;
+  for (int d = tid; d < D; d += blockDim.x) {
+    q_s[d] = static_cast<accscalar_t>(q_row[d]);
+  }
+  if (tid == 0) {
+    running_max = -INFINITY;
+    running_sum = 0;
+  }
+
+  accscalar_t acc[kPagedAttentionMaxDimsPerThread];
+  for (int i = 0; i < kPagedAttentionMaxDimsPerThread; ++i) {
+    acc[i] = 0;
+  }
+
+  for (int64_t t0 = 0; t0 < T; t0 += kPagedAttentionChunk) {
+    const int chunk = T - t0 < kPagedAttentionChunk
+        ? static_cast<int>(T - t0)
+        : kPagedAttentionChunk;
+    __syncthreads();
+    for (int i = tid; i < chunk; i += blockDim.x) {
+      const int64_t t = t0 + i;
+      const int64_t page = page_table[b * max_pages + t / S];
+      const scalar_t* k = key_pool + ((page * S + t % S) * H + h) * D;
+      accscalar_t s = 0;
+      for (int d = 0; d < D; ++d) {
+        s += q_s[d] * static_cast<accscalar_t>(k[d]);
+      }
+      scores[i] = s * scale;
+    }
+    __syncthreads();
+    if (tid == 0) {
+      // The chunk is small; a serial pass here is cheap next to the dot
+      // products above and keeps the softmax state updates race-free.
+      accscalar_t chunk_max = running_max;
+      for (int i = 0; i < chunk; ++i) {
+        chunk_max = scores[i] > chunk_max ? scores[i] : chunk_max;
+      }
+      accscalar_t chunk_sum = 0;
+      for (int i = 0; i < chunk; ++i) {
+        scores[i] = ::exp(scores[i] - chunk_max);
+        chunk_sum += scores[i];
+      }
+      const accscalar_t rescale = ::exp(running_max - chunk_max);
+      running_sum = running_sum * rescale + chunk_sum;
+      running_max = chunk_max;
+      rescale_s = rescale;
+    }
+    __syncthreads();
+    const accscalar_t rescale = rescale_s;
+    for (int i = 0, d = tid; d < D; ++i, d += blockDim.x) {
+      acc[i] *= rescale;
+    }
+    for (int j = 0; j < chunk; ++j) {
+      const int64_t t = t0 + j;
+      const int64_t page = page_table[b * max_pages + t / S];
+      const scalar_t* v = value_pool + ((page * S + t % S) * H + h) * D;
+      const accscalar_t p = scores[j];
+      for (int i = 0, d = tid; d < D; ++i, d += blockDim.x) {
+        acc[i] += p * static_cast<accscalar_t>(v[d]);
+      }
+    }
+  }
+  __syncthreads();
+  const accscalar_t inv_sum = accscalar_t(1) / running_sum;
+  for (int i = 0, d = tid; d < D; ++i, d += blockDim.x) {
+    o[d] = static_cast<scalar_t>(acc[i] * inv_sum);
+  }
+}
+
+} // namespace
+
+Tensor paged_attention_cuda(
+    const Tensor& query,
+    const Tensor& key_pool,
+    const Tensor& value_pool,
+    const Tensor& page_table,
+    const Tensor& seq_lens,
+    double scale) {
+  check_paged_attention_inputs(
+      query, key_pool, value_pool, page_table, seq_lens);
+  const auto q = query.contiguous();
+  const auto k_pool = key_pool.contiguous();
+  const auto v_pool = value_pool.contiguous();
+  const auto table = page_table.contiguous();
+  const auto lens = seq_lens.contiguous();
+
+  const int64_t B = q.size(0);
+  const int64_t H = q.size(1);
+  const int64_t D = q.size(2);
+  const int64_t S = k_pool.size(1);
+  const int64_t max_pages = table.size(1);
+  TORCH_CHECK(
+      D <= kPagedAttentionThreads * kPagedAttentionMaxDimsPerThread,
+      "_paged_attention: head_dim ",
+      D,
+      " exceeds the kernel limit of ",
+      kPagedAttentionThreads * kPagedAttentionMaxDimsPerThread);
+
+  auto out = at::empty_like(q);
+  if (B == 0 || H == 0) {
+    return out;
+  }
+
+  const dim3 grid(B, H);
+  auto stream = at::cuda::getCurrentCUDAStream();
+  AT_DISPATCH_FLOATING_TYPES_AND2(
+      ScalarType::Half,
+      ScalarType::BFloat16,
+      q.scalar_type(),
+      "paged_attention_cuda",
+      [&] {
+        using accscalar_t = at::acc_type<scalar_t, true>;
+        const size_t smem =
+            (D + kPagedAttentionChunk) * sizeof(accscalar_t);
+        paged_attention_kernel<scalar_t, accscalar_t>
+            <<<grid, kPagedAttentionThreads, smem, stream>>>(
+                q.data_ptr<scalar_t>(),
+                k_pool.data_ptr<scalar_t>(),
+                v_pool.data_ptr<scalar_t>(),
+                table.data_ptr<int64_t>(),
+                lens.data_ptr<int64_t>(),
+                out.data_ptr<scalar_t>(),
+                static_cast<int>(H),
+                static_cast<int>(D),
+                static_cast<int>(S),
+                static_cast<int>(max_pages),
+                static_cast<accscalar_t>(scale));
+        C10_CUDA_KERNEL_LAUNCH_CHECK();
+      });
+  return out;
+}
+
+} // namespace native
+} // namespace at
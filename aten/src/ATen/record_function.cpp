@@ -34,6 +34,40 @@ thread_local uint64_t current_thread_id_ = 0;
 static constexpr size_t NumRecordScopes =
     static_cast<size_t>(RecordScope::NUM_SCOPES);
 
+// Recycled blocks backing ObserverContext::operator new/delete. Contexts are
+// allocated once per observed call and freed when the RecordFunction exits,
+// so under a sampled profiler the same handful of sizes cycles through the
+// allocator constantly. Small contexts are served from per-thread free lists
+// bucketed in 64-byte steps instead; oversized or overflowing blocks fall
+// back to the global allocator. Blocks may be freed by a different thread
+// than the one that allocated them - they simply land on the freeing
+// thread's list, which is fine because every block of a bucket is
+// interchangeable.
+constexpr size_t kCtxBlockBytes = 64;
+constexpr size_t kCtxNumBuckets = 4; // up to 256-byte contexts
+constexpr size_t kCtxMaxFreePerBucket = 64;
+
+struct CtxFreeLists {
+  struct Node {
+    Node* next;
+  };
+
+  ~CtxFreeLists() {
+    for (auto& head : heads) {
+      while (head != nullptr) {
+        Node* next = head->next;
+        ::operator delete(head);
+        head = next;
+      }
+    }
+  }
+
+  std::array<Node*, kCtxNumBuckets> heads{{nullptr}};
+  std::array<size_t, kCtxNumBuckets> counts{{0}};
+};
+
+thread_local CtxFreeLists ctx_free_lists_;
+
 RecordFunctionCallbacks::iterator findCallback(
     RecordFunctionCallbacks& entries,
     CallbackHandle handle) {
@@ -97,6 +131,24 @@ c10::optional<RecordFunctionCallback> extractCallback(
 // on RecordScope, we can consolidate the decrement to a single shared counter
 // and update individual counters during rebuild.
 
+// In the steady state of a latency-critical workload there are no observers
+// at all, yet every dispatched op still pays for the TLS singleton lookup and
+// the per-scope cache bookkeeping just to discover that. We keep a
+// process-wide count of registered callbacks (global plus every thread's
+// local ones); while it is zero, getStepCallbacksUnlessEmpty is a single
+// relaxed atomic load and one predictable branch. The count is conservative:
+// a registered-but-disabled callback keeps it non-zero, so a zero count
+// always means there is nothing to run.
+std::atomic<int64_t> callback_population_{0};
+
+void adjustCallbackPopulation(int64_t delta) {
+  callback_population_.fetch_add(delta, std::memory_order_relaxed);
+}
+
+bool anyCallbacksRegistered() {
+  return callback_population_.load(std::memory_order_relaxed) > 0;
+}
+
 class GlobalCallbackManager {
  public:
   static GlobalCallbackManager& get(); // Singleton
@@ -170,6 +222,8 @@ class LocalCallbackManager {
   LocalCallbackManager();
 
  public:
+  ~LocalCallbackManager();
+
   const RecordFunctionTLS& getTLS() const;
   StepCallbacks getActiveCallbacks(const RecordScope scope);
   c10::optional<StepCallbacks> getActiveCallbacksUnlessEmpty(const RecordScope scope);
@@ -225,6 +279,7 @@ CallbackHandle GlobalCallbackManager::addCallback(RecordFunctionCallback cb) {
   ++version_;
   auto handle = next_unique_callback_handle();
   global_callbacks_.emplace_back(std::move(cb), handle);
+  adjustCallbackPopulation(1);
   return handle;
 }
 
@@ -247,6 +302,7 @@ void GlobalCallbackManager::removeCallback(CallbackHandle handle) {
   std::lock_guard<std::mutex> guard(update_mutex_);
   if (extractCallback(global_callbacks_, handle).has_value()) {
     ++version_;
+    adjustCallbackPopulation(-1);
   } else {
     LOG(WARNING) << "Requested callback is not found";
   }
@@ -255,6 +311,7 @@ void GlobalCallbackManager::removeCallback(CallbackHandle handle) {
 void GlobalCallbackManager::clearCallbacks() {
   std::lock_guard<std::mutex> guard(update_mutex_);
   ++version_;
+  adjustCallbackPopulation(-static_cast<int64_t>(global_callbacks_.size()));
   global_callbacks_.clear();
 }
 
@@ -378,6 +435,13 @@ LocalCallbackManager::LocalCallbackManager() {
   rebuild_all(GlobalCallbackManager::get().getSnapshot());
 }
 
+LocalCallbackManager::~LocalCallbackManager() {
+  // This thread's local callbacks leave the process-wide population when the
+  // thread exits.
+  adjustCallbackPopulation(
+      -static_cast<int64_t>(registered_callbacks_.sorted_tls_callbacks_.size()));
+}
+
 const RecordFunctionTLS& LocalCallbackManager::getTLS() const {
   return registered_callbacks_;
 }
@@ -402,6 +466,9 @@ c10::optional<StepCallbacks> LocalCallbackManager::getActiveCallbacksUnlessEmpty
 }
 
 void LocalCallbackManager::setTLS(const RecordFunctionTLS& tls) {
+  adjustCallbackPopulation(
+      static_cast<int64_t>(tls.sorted_tls_callbacks_.size()) -
+      static_cast<int64_t>(registered_callbacks_.sorted_tls_callbacks_.size()));
   registered_callbacks_ = tls;
   rebuild_all(GlobalCallbackManager::get().getSnapshot());
 }
@@ -415,6 +482,7 @@ CallbackHandle LocalCallbackManager::addCallback(
   auto handle = next_unique_callback_handle();
   auto& callbacks = registered_callbacks_.sorted_tls_callbacks_;
   callbacks.emplace_back(std::move(callback), handle);
+  adjustCallbackPopulation(1);
   rebuild_callback_scopes(
       GlobalCallbackManager::get().getSnapshot(), callbacks.back().callback_);
   return handle;
@@ -437,6 +505,7 @@ bool LocalCallbackManager::removeCallback(CallbackHandle handle) {
   auto& callbacks = registered_callbacks_.sorted_tls_callbacks_;
   auto callback = extractCallback(callbacks, handle);
   if (callback.has_value()) {
+    adjustCallbackPopulation(-1);
     rebuild_callback_scopes(
         GlobalCallbackManager::get().getSnapshot(), *callback);
   }
@@ -444,6 +513,8 @@ bool LocalCallbackManager::removeCallback(CallbackHandle handle) {
 }
 
 void LocalCallbackManager::clearCallbacks() {
+  adjustCallbackPopulation(
+      -static_cast<int64_t>(registered_callbacks_.sorted_tls_callbacks_.size()));
   registered_callbacks_.sorted_tls_callbacks_.clear();
   rebuild_all(GlobalCallbackManager::get().getSnapshot());
 }
@@ -524,6 +595,37 @@ C10_ALWAYS_INLINE bool tryRunCallback(
 
 } // namespace
 
+void* ObserverContext::operator new(std::size_t size) {
+  const size_t bucket = (size - 1) / kCtxBlockBytes;
+  if (bucket < kCtxNumBuckets) {
+    auto& lists = ctx_free_lists_;
+    if (auto* node = lists.heads[bucket]) {
+      lists.heads[bucket] = node->next;
+      --lists.counts[bucket];
+      return node;
+    }
+    return ::operator new((bucket + 1) * kCtxBlockBytes);
+  }
+  return ::operator new(size);
+}
+
+void ObserverContext::operator delete(void* ptr, std::size_t size) {
+  // `size` is the most-derived object's size because the destructor is
+  // virtual, so it lands in the same bucket the allocation came from.
+  const size_t bucket = (size - 1) / kCtxBlockBytes;
+  if (bucket < kCtxNumBuckets) {
+    auto& lists = ctx_free_lists_;
+    if (lists.counts[bucket] < kCtxMaxFreePerBucket) {
+      auto* node = static_cast<CtxFreeLists::Node*>(ptr);
+      node->next = lists.heads[bucket];
+      lists.heads[bucket] = node;
+      ++lists.counts[bucket];
+      return;
+    }
+  }
+  ::operator delete(ptr);
+}
+
 RecordFunction::RecordFunction(RecordScope scope)
     : RecordFunction(getStepCallbacks(scope)) {}
 
@@ -612,6 +714,12 @@ StepCallbacks getStepCallbacks(RecordScope scope) {
 }
 
 c10::optional<StepCallbacks> getStepCallbacksUnlessEmpty(RecordScope scope) {
+  // With no observers registered anywhere in the process this is a single
+  // relaxed atomic load; we never touch the TLS singleton or the per-scope
+  // caches. See the comment on callback_population_.
+  if (C10_LIKELY(!anyCallbacksRegistered())) {
+    return c10::nullopt;
+  }
   return LocalCallbackManager::get().getActiveCallbacksUnlessEmpty(scope);
 }
 
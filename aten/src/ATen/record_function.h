@@ -90,9 +90,17 @@ constexpr std::size_t kSoftLimitCallbacks = 4;
 
 // An abstract base class for various observer contexts that can be attached to
 // the RecordFunction.
-struct ObserverContext {
+struct TORCH_API ObserverContext {
   virtual ~ObserverContext() {}
 
+  // Observers allocate one context per observed call, which shows up as
+  // allocator traffic when a sampled profiler is active. These operators
+  // serve small contexts from per-thread recycled blocks so steady-state
+  // profiling does not hit the allocator; see the implementation for the
+  // size buckets.
+  static void* operator new(std::size_t size);
+  static void operator delete(void* ptr, std::size_t size);
+
  protected:
   ObserverContext() {}
 };
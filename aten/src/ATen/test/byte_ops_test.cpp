@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+
+#include <ATen/ATen.h>
+
+#include <cstring>
+#include <string>
+
+using namespace at;
+
+namespace {
+
+Tensor bytes(const std::string& s) {
+  auto t = empty({static_cast<int64_t>(s.size())}, kByte);
+  std::memcpy(t.data_ptr<uint8_t>(), s.data(), s.size());
+  return t;
+}
+
+} // namespace
+
+TEST(ByteOpsTest, TranslateRemapsThroughTable) {
+  // An uppercasing table.
+  auto table = empty({256}, kByte);
+  uint8_t* lut = table.data_ptr<uint8_t>();
+  for (int c = 0; c < 256; ++c) {
+    lut[c] = static_cast<uint8_t>(c >= 'a' && c <= 'z' ? c - 'a' + 'A' : c);
+  }
+  auto result = _byte_translate(bytes("Hello, World!"), table);
+  ASSERT_TRUE(result.equal(bytes("HELLO, WORLD!")));
+}
+
+TEST(ByteOpsTest, TranslateRejectsWrongTableSize) {
+  // NOLINTNEXTLINE(cppcoreguidelines-avoid-goto,hicpp-avoid-goto)
+  ASSERT_THROW(
+      _byte_translate(bytes("abc"), zeros({16}, kByte)), c10::Error);
+}
+
+TEST(ByteOpsTest, FindReturnsAllNeedleIndices) {
+  auto indices = _byte_find(bytes("a b,c d,e"), bytes(" ,"));
+  ASSERT_TRUE(indices.equal(tensor({1, 3, 5, 7}, kLong)));
+
+  ASSERT_EQ(_byte_find(bytes("abc"), bytes("xyz")).numel(), 0);
+  ASSERT_EQ(_byte_find(bytes(""), bytes(" ")).numel(), 0);
+}
+
+TEST(ByteOpsTest, FindMatchesScalarReferenceOnLargeInput) {
+  manual_seed(42);
+  auto data = randint(0, 256, {100000}, kByte);
+  auto needles = bytes("\n\t xq");
+  auto indices = _byte_find(data, needles);
+  // Reference via boolean mask + nonzero.
+  auto mask = zeros({100000}, kBool);
+  for (const auto needle : {'\n', '\t', ' ', 'x', 'q'}) {
+    mask = mask.logical_or(data == static_cast<uint8_t>(needle));
+  }
+  ASSERT_TRUE(indices.equal(mask.nonzero().flatten()));
+}
+
+TEST(ByteOpsTest, RunLengthsSegmentsRuns) {
+  Tensor values, lengths;
+  std::tie(values, lengths) = _byte_run_lengths(bytes("aaabccd"));
+  ASSERT_TRUE(values.equal(bytes("abcd")));
+  ASSERT_TRUE(lengths.equal(tensor({3, 1, 2, 1}, kLong)));
+
+  // A run longer than one SIMD block.
+  std::tie(values, lengths) =
+      _byte_run_lengths(bytes(std::string(1000, 'x') + "y"));
+  ASSERT_TRUE(values.equal(bytes("xy")));
+  ASSERT_TRUE(lengths.equal(tensor({1000, 1}, kLong)));
+
+  std::tie(values, lengths) = _byte_run_lengths(bytes(""));
+  ASSERT_EQ(values.numel(), 0);
+  ASSERT_EQ(lengths.numel(), 0);
+}
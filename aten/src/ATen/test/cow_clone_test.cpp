@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+
+#include <ATen/ATen.h>
+#include <c10/util/Flags.h>
+
+C10_DECLARE_bool(caffe2_cpu_allocator_use_memfd);
+
+TEST(CowCloneTest, FallsBackToDeepCopy) {
+  // Without the memfd allocator flag, _cow_clone is a plain clone.
+  auto a = at::randn({8, 8});
+  auto b = at::_cow_clone(a);
+  ASSERT_TRUE(b.equal(a));
+  a.add_(1);
+  ASSERT_FALSE(b.equal(a));
+}
+
+#ifdef __linux__
+TEST(CowCloneTest, MemfdSnapshotIsStableUnderSourceWrites) {
+  FLAGS_caffe2_cpu_allocator_use_memfd = true;
+  // 4 MiB, above the memfd allocation threshold.
+  auto a = at::randn({1024, 1024});
+  auto reference = a.clone();
+
+  auto snap = at::_cow_clone(a);
+  ASSERT_TRUE(snap.equal(reference));
+
+  // Training keeps writing; the snapshot must not move.
+  a.mul_(2);
+  ASSERT_TRUE(snap.equal(reference));
+  ASSERT_FALSE(snap.equal(a));
+
+  // A second snapshot (fresh memfd generation) sees the updated contents
+  // and is itself stable.
+  auto snap2 = at::_cow_clone(a);
+  ASSERT_TRUE(snap2.equal(a));
+  a.add_(1);
+  ASSERT_TRUE(snap2.equal(reference.mul(2)));
+
+  // Writes to one snapshot do not leak into the source or other snapshots.
+  snap.zero_();
+  ASSERT_TRUE(snap2.equal(reference.mul(2)));
+  ASSERT_TRUE(a.equal(reference.mul(2).add(1)));
+
+  FLAGS_caffe2_cpu_allocator_use_memfd = false;
+}
+
+TEST(CowCloneTest, ViewsSnapshotTheWholeStorage) {
+  FLAGS_caffe2_cpu_allocator_use_memfd = true;
+  auto base = at::randn({1024, 1024});
+  auto view = base.narrow(0, 512, 256);
+  auto snap = at::_cow_clone(view);
+  ASSERT_TRUE(snap.equal(view));
+  base.mul_(3);
+  ASSERT_FALSE(snap.equal(view));
+  FLAGS_caffe2_cpu_allocator_use_memfd = false;
+}
+#endif
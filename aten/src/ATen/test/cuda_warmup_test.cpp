@@ -0,0 +1,19 @@
+#include <gtest/gtest.h>
+
+#include <ATen/ATen.h>
+#include <ATen/cuda/CUDAContext.h>
+#include <ATen/cuda/Warmup.h>
+
+TEST(TestWarmup, WarmupCurrentDevice) {
+  if (!at::cuda::is_available()) return;
+  at::cuda::warmup(/*device=*/0);
+  // The device must be fully usable afterwards.
+  auto t = at::ones({4, 4}, at::TensorOptions(at::kCUDA));
+  ASSERT_TRUE(t.mm(t).allclose(at::full({4, 4}, 4.0, at::TensorOptions(at::kCUDA))));
+}
+
+TEST(TestWarmup, WarmupAllDevices) {
+  if (!at::cuda::is_available()) return;
+  at::cuda::warmup();
+  at::cuda::warmup(/*device=*/-1, /*prime_streams=*/false);
+}
@@ -0,0 +1,26 @@
+#include <gtest/gtest.h>
+
+#include <ATen/ATen.h>
+#include <ATen/native/DispatchStub.h>
+
+using at::native::CPUCapability;
+
+TEST(DispatchStubTest, PerStubCapabilityOverride) {
+  auto t = at::randn({67});
+  const auto expected = t.abs();
+
+  // Pin one stub to the scalar kernel; the result must not change.
+  ASSERT_TRUE(at::native::set_cpu_capability_override(
+      "abs_stub", CPUCapability::DEFAULT));
+  EXPECT_TRUE(at::allclose(t.abs(), expected));
+
+  // Restore the global choice for the rest of the test binary.
+  ASSERT_TRUE(at::native::set_cpu_capability_override(
+      "abs_stub", at::native::get_cpu_capability()));
+  EXPECT_TRUE(at::allclose(t.abs(), expected));
+}
+
+TEST(DispatchStubTest, UnknownStubNameIsRejected) {
+  EXPECT_FALSE(at::native::set_cpu_capability_override(
+      "no_such_stub", CPUCapability::DEFAULT));
+}
@@ -31,3 +31,17 @@ TEST(TestDlconvertor, TestDlconvertorNoStrides) {
 
   ASSERT_TRUE(a.equal(b));
 }
+
+TEST(TestDlconvertor, TestDlconvertorExchangeStreamIgnoredOnCPU) {
+  manual_seed(123);
+
+  // Exchange streams only matter for stream-ordered devices; for CPU
+  // tensors they are ignored rather than rejected.
+  Tensor a = rand({3, 4});
+  c10::Stream stream = c10::Stream(c10::Stream::DEFAULT, a.device());
+  DLManagedTensor* dlMTensor = toDLPack(a, stream);
+
+  Tensor b = fromDLPack(dlMTensor, stream);
+
+  ASSERT_TRUE(a.equal(b));
+}
@@ -0,0 +1,37 @@
+#include <gtest/gtest.h>
+
+#include <ATen/ParallelGrainTuner.h>
+
+using at::internal::pick_grain_size;
+using at::internal::record_grain_timing;
+
+// Exercises the tuning table directly; parallel_for_tuned itself only
+// reaches it when PYTORCH_ADAPTIVE_GRAIN is set.
+TEST(GrainTunerTest, SettlesOnFastestCandidate) {
+  constexpr const char* kSite = "grain_tuner_test_site";
+  constexpr int64_t kWork = 1 << 20;
+  constexpr int64_t kDefault = 32768;
+
+  // Feed timings until the entry settles; make the half-grain candidate
+  // the consistently fastest one.
+  int64_t settled_grain = 0;
+  for (int i = 0; i < 100; ++i) {
+    const auto decision = pick_grain_size(kSite, kWork, kDefault);
+    if (!decision.measure) {
+      settled_grain = decision.grain;
+      break;
+    }
+    const double seconds = decision.grain == kDefault / 2 ? 1e-4 : 1e-3;
+    record_grain_timing(kSite, kWork, decision.grain, seconds);
+  }
+  ASSERT_EQ(settled_grain, kDefault / 2);
+
+  // Settled entries are stable.
+  const auto decision = pick_grain_size(kSite, kWork, kDefault);
+  EXPECT_FALSE(decision.measure);
+  EXPECT_EQ(decision.grain, kDefault / 2);
+
+  // A different size bucket tunes independently.
+  const auto other = pick_grain_size(kSite, 128, kDefault);
+  EXPECT_TRUE(other.measure);
+}
@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+
+#include <ATen/ATen.h>
+
+using namespace at;
+
+TEST(MaskPackingTest, PackUnpackRoundTrips) {
+  manual_seed(7);
+  // 1001 exercises a partial last byte.
+  auto mask = randint(0, 2, {1001}, kByte).to(kBool);
+  auto packed = _pack_bool_bits(mask);
+  ASSERT_EQ(packed.scalar_type(), kByte);
+  ASSERT_EQ(packed.numel(), (1001 + 7) / 8);
+  ASSERT_TRUE(_unpack_bool_bits(packed, 1001).equal(mask));
+
+  ASSERT_EQ(_pack_bool_bits(empty({0}, kBool)).numel(), 0);
+  ASSERT_EQ(_unpack_bool_bits(empty({0}, kByte), 0).numel(), 0);
+}
+
+TEST(MaskPackingTest, PackedPaddingBitsAreZero) {
+  auto packed = _pack_bool_bits(ones({3}, kBool));
+  ASSERT_EQ(packed.item<uint8_t>(), 0b111);
+}
+
+TEST(MaskPackingTest, BitwiseOpsMatchLogicalOps) {
+  manual_seed(8);
+  auto a = randint(0, 2, {500}, kByte).to(kBool);
+  auto b = randint(0, 2, {500}, kByte).to(kBool);
+  auto pa = _pack_bool_bits(a);
+  auto pb = _pack_bool_bits(b);
+  // and/or/xor on packed masks are plain bitwise ops on the bitmaps.
+  ASSERT_TRUE(pa.bitwise_and(pb).equal(_pack_bool_bits(a.logical_and(b))));
+  ASSERT_TRUE(pa.bitwise_or(pb).equal(_pack_bool_bits(a.logical_or(b))));
+  ASSERT_TRUE(pa.bitwise_xor(pb).equal(_pack_bool_bits(a.logical_xor(b))));
+  // NOT needs the dedicated op so the padding bits stay zero.
+  ASSERT_TRUE(
+      _packed_bool_not(pa, 500).equal(_pack_bool_bits(a.logical_not())));
+}
+
+TEST(MaskPackingTest, AnyAllHandleTailBits) {
+  auto all_true = _pack_bool_bits(ones({13}, kBool));
+  ASSERT_TRUE(_packed_bool_all(all_true, 13).item<bool>());
+  ASSERT_TRUE(_packed_bool_any(all_true, 13).item<bool>());
+
+  auto mask = ones({13}, kBool);
+  mask[12] = false; // only a padding-adjacent tail bit differs
+  auto packed = _pack_bool_bits(mask);
+  ASSERT_FALSE(_packed_bool_all(packed, 13).item<bool>());
+  ASSERT_TRUE(_packed_bool_any(packed, 13).item<bool>());
+
+  auto all_false = _pack_bool_bits(zeros({13}, kBool));
+  ASSERT_FALSE(_packed_bool_any(all_false, 13).item<bool>());
+
+  // Like Tensor::all/any on an empty tensor.
+  auto empty_mask = _pack_bool_bits(empty({0}, kBool));
+  ASSERT_TRUE(_packed_bool_all(empty_mask, 0).item<bool>());
+  ASSERT_FALSE(_packed_bool_any(empty_mask, 0).item<bool>());
+}
+
+TEST(MaskPackingTest, MaskedSelectMatchesUnpackedReference) {
+  manual_seed(9);
+  auto values = randn({100000});
+  auto mask = randint(0, 2, {100000}, kByte).to(kBool);
+  auto packed = _pack_bool_bits(mask);
+  ASSERT_TRUE(
+      _packed_masked_select(values, packed, 100000)
+          .equal(values.masked_select(mask)));
+
+  auto ints = randint(0, 1000, {77}, kLong);
+  auto small_mask = randint(0, 2, {77}, kByte).to(kBool);
+  ASSERT_TRUE(
+      _packed_masked_select(ints, _pack_bool_bits(small_mask), 77)
+          .equal(ints.masked_select(small_mask)));
+}
+
+TEST(MaskPackingTest, RejectsMismatchedSizes) {
+  // NOLINTNEXTLINE(cppcoreguidelines-avoid-goto,hicpp-avoid-goto)
+  ASSERT_THROW(_unpack_bool_bits(zeros({2}, kByte), 100), c10::Error);
+  // NOLINTNEXTLINE(cppcoreguidelines-avoid-goto,hicpp-avoid-goto)
+  ASSERT_THROW(_pack_bool_bits(zeros({8}, kByte)), c10::Error);
+  // NOLINTNEXTLINE(cppcoreguidelines-avoid-goto,hicpp-avoid-goto)
+  ASSERT_THROW(
+      _packed_masked_select(randn({10}), zeros({2}, kByte), 11), c10::Error);
+}
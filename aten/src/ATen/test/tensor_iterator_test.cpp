@@ -240,3 +240,57 @@ TEST(TensorIteratorTest, CpuKernelMultipleOutputs_##name) {
   EXPECT_TRUE(out2.equal(expected2));                                                               \
 }
 AT_FORALL_SCALAR_TYPES(MULTIPLE_OUTPUTS_TEST_ITER_FOR_TYPE)
+
+// The operand dtypes deliberately do not match the functor's float signature,
+// exercising the dynamic casting loops in Loops.h
+// (see [Note: dynamic casting on CPU]).
+TEST(TensorIteratorTest, CpuKernelVecDynamicCastingContiguous) {
+  Tensor in1 = at::randn({5, 25}).to(at::kHalf);
+  Tensor in2 = at::randn({5, 25});
+  Tensor out = at::empty({5, 25}, at::kDouble);
+  auto iter = at::TensorIteratorConfig()
+    .add_output(out)
+    .add_owned_input(in1)
+    .add_owned_input(in2)
+    .check_all_same_dtype(false)
+    .build();
+  at::native::cpu_kernel_vec(iter,
+    [](float a, float b) -> float { return a + b; },
+    [](at::vec::Vectorized<float> a, at::vec::Vectorized<float> b) { return a + b; });
+  auto expected = (in1.to(at::kFloat) + in2).to(at::kDouble);
+  EXPECT_TRUE(out.equal(expected));
+}
+
+// A transposed input keeps the inner dimension strided, so this goes down the
+// per-element casting loop rather than the chunked vectorized one.
+TEST(TensorIteratorTest, CpuKernelVecDynamicCastingStrided) {
+  Tensor in1 = at::randn({25, 5}).to(at::kBFloat16).t();
+  Tensor in2 = at::randn({5, 25});
+  Tensor out = at::empty({5, 25});
+  auto iter = at::TensorIteratorConfig()
+    .add_output(out)
+    .add_owned_input(in1)
+    .add_owned_input(in2)
+    .check_all_same_dtype(false)
+    .build();
+  at::native::cpu_kernel_vec(iter,
+    [](float a, float b) -> float { return a + b; },
+    [](at::vec::Vectorized<float> a, at::vec::Vectorized<float> b) { return a + b; });
+  auto expected = in1.to(at::kFloat) + in2;
+  EXPECT_TRUE(out.equal(expected));
+}
+
+TEST(TensorIteratorTest, CpuKernelDynamicCasting) {
+  Tensor in1 = at::randn({5, 25}).to(at::kHalf);
+  Tensor in2 = at::randn({5, 25});
+  Tensor out = at::empty({5, 25});
+  auto iter = at::TensorIteratorConfig()
+    .add_output(out)
+    .add_owned_input(in1)
+    .add_owned_input(in2)
+    .check_all_same_dtype(false)
+    .build();
+  at::native::cpu_kernel(iter, [](float a, float b) -> float { return a + b; });
+  auto expected = in1.to(at::kFloat) + in2;
+  EXPECT_TRUE(out.equal(expected));
+}
@@ -0,0 +1,31 @@
+#include <c10/core/CPUAllocator.h>
+#include <benchmark/benchmark.h>
+#include <torch/torch.h>
+
+// Allocation/deallocation throughput, both through at::empty (includes
+// TensorImpl construction) and through the raw CPU allocator.
+
+namespace {
+
+static void BM_EmptyTensor(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  for (auto _ : state) {
+    auto t = torch::empty({n});
+    benchmark::DoNotOptimize(t.data_ptr());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_EmptyTensor)->Arg(64)->Arg(1 << 12)->Arg(1 << 20);
+
+static void BM_RawAllocation(benchmark::State& state) {
+  const int64_t nbytes = state.range(0);
+  auto* allocator = c10::GetCPUAllocator();
+  for (auto _ : state) {
+    auto data = allocator->allocate(nbytes);
+    benchmark::DoNotOptimize(data.get());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RawAllocation)->Arg(256)->Arg(1 << 14)->Arg(1 << 22);
+
+} // namespace
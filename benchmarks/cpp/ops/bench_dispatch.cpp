@@ -0,0 +1,50 @@
+#include <benchmark/benchmark.h>
+#include <torch/torch.h>
+
+// Per-call dispatcher and op-entry overhead, measured on tensors small
+// enough that the kernel body is negligible.
+
+namespace {
+
+static void BM_AddInplace1Element(benchmark::State& state) {
+  torch::NoGradGuard no_grad;
+  auto a = torch::ones({1});
+  auto b = torch::ones({1});
+  for (auto _ : state) {
+    a.add_(b);
+  }
+}
+BENCHMARK(BM_AddInplace1Element);
+
+static void BM_AddOut1Element(benchmark::State& state) {
+  torch::NoGradGuard no_grad;
+  auto a = torch::ones({1});
+  auto b = torch::ones({1});
+  auto out = torch::empty({1});
+  for (auto _ : state) {
+    at::add_out(out, a, b);
+  }
+}
+BENCHMARK(BM_AddOut1Element);
+
+static void BM_MulScalar1Element(benchmark::State& state) {
+  torch::NoGradGuard no_grad;
+  auto a = torch::ones({1});
+  for (auto _ : state) {
+    a.mul_(0.5);
+  }
+}
+BENCHMARK(BM_MulScalar1Element);
+
+// contiguous() on an already-contiguous tensor returns an alias, so this is
+// close to a pure round trip through the dispatcher.
+static void BM_ContiguousNoOp(benchmark::State& state) {
+  torch::NoGradGuard no_grad;
+  auto a = torch::ones({1});
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a.contiguous());
+  }
+}
+BENCHMARK(BM_ContiguousNoOp);
+
+} // namespace
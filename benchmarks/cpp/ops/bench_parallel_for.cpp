@@ -0,0 +1,50 @@
+#include <ATen/Parallel.h>
+#include <benchmark/benchmark.h>
+#include <torch/torch.h>
+
+#include <vector>
+
+// parallel_for scheduling overhead and scaling. The loop body is a trivial
+// streaming add so the timings are dominated by task launch and memory
+// bandwidth; comparing thread counts for one size shows the scaling curve.
+
+namespace {
+
+static void BM_ParallelFor(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  at::set_num_threads(state.range(1));
+  std::vector<float> x(n, 1.0f);
+  std::vector<float> y(n, 2.0f);
+  for (auto _ : state) {
+    at::parallel_for(0, n, at::internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+      for (int64_t i = begin; i < end; ++i) {
+        x[i] += y[i];
+      }
+    });
+  }
+  state.counters["elements"] = benchmark::Counter(
+      uint64_t(state.iterations()) * n, benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_ParallelFor)
+    ->Args({1 << 10, 1})
+    ->Args({1 << 16, 1})
+    ->Args({1 << 16, 4})
+    ->Args({1 << 22, 1})
+    ->Args({1 << 22, 4})
+    ->Args({1 << 22, 8})
+    ->UseRealTime();
+
+// Launch cost alone: a range below the grain size never spawns tasks, while
+// the larger range pays for inter-thread dispatch every iteration.
+static void BM_ParallelForLaunch(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  at::set_num_threads(4);
+  for (auto _ : state) {
+    at::parallel_for(0, n, 1, [](int64_t begin, int64_t end) {
+      benchmark::DoNotOptimize(begin + end);
+    });
+  }
+}
+BENCHMARK(BM_ParallelForLaunch)->Arg(1)->Arg(64)->UseRealTime();
+
+} // namespace
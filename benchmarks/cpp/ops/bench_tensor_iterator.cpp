@@ -0,0 +1,58 @@
+#include <ATen/TensorIterator.h>
+#include <benchmark/benchmark.h>
+#include <torch/torch.h>
+
+// Cost of building a TensorIterator (shape computation, type promotion,
+// dimension coalescing), without running any loop over it.
+
+namespace {
+
+static void BM_BinaryOpSetupContiguous(benchmark::State& state) {
+  auto a = torch::randn({state.range(0)});
+  auto b = torch::randn({state.range(0)});
+  auto out = torch::empty_like(a);
+  for (auto _ : state) {
+    auto iter = at::TensorIteratorConfig()
+                    .add_output(out)
+                    .add_input(a)
+                    .add_input(b)
+                    .build();
+    benchmark::DoNotOptimize(iter);
+  }
+}
+BENCHMARK(BM_BinaryOpSetupContiguous)->Arg(1)->Arg(1 << 12);
+
+// Transposed inputs defeat the fast setup path and exercise full stride
+// sorting and coalescing.
+static void BM_BinaryOpSetupTransposed(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  auto a = torch::randn({n, n}).t();
+  auto b = torch::randn({n, n}).t();
+  auto out = torch::empty({n, n}).t();
+  for (auto _ : state) {
+    auto iter = at::TensorIteratorConfig()
+                    .add_output(out)
+                    .add_input(a)
+                    .add_input(b)
+                    .build();
+    benchmark::DoNotOptimize(iter);
+  }
+}
+BENCHMARK(BM_BinaryOpSetupTransposed)->Arg(64);
+
+static void BM_ReduceOpSetup(benchmark::State& state) {
+  auto a = torch::randn({state.range(0)});
+  auto out = torch::empty({});
+  for (auto _ : state) {
+    auto iter = at::TensorIteratorConfig()
+                    .add_output(out)
+                    .add_input(a)
+                    .resize_outputs(false)
+                    .is_reduction(true)
+                    .build();
+    benchmark::DoNotOptimize(iter);
+  }
+}
+BENCHMARK(BM_ReduceOpSetup)->Arg(1 << 12);
+
+} // namespace
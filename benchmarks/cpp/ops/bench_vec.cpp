@@ -0,0 +1,45 @@
+#include <benchmark/benchmark.h>
+#include <torch/torch.h>
+
+// Throughput of the vectorized CPU kernels on contiguous fp32 buffers,
+// through their out-variants so no allocation is timed.
+
+namespace {
+
+static void BM_VecAdd(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  auto a = torch::randn({n});
+  auto b = torch::randn({n});
+  auto out = torch::empty({n});
+  for (auto _ : state) {
+    at::add_out(out, a, b);
+  }
+  state.counters["elements"] = benchmark::Counter(
+      uint64_t(state.iterations()) * n, benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_VecAdd)->Arg(1 << 14)->Arg(1 << 20);
+
+static void BM_VecExp(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  auto a = torch::randn({n});
+  auto out = torch::empty({n});
+  for (auto _ : state) {
+    at::exp_out(out, a);
+  }
+  state.counters["elements"] = benchmark::Counter(
+      uint64_t(state.iterations()) * n, benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_VecExp)->Arg(1 << 14)->Arg(1 << 20);
+
+static void BM_VecSum(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  auto a = torch::randn({n});
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a.sum());
+  }
+  state.counters["elements"] = benchmark::Counter(
+      uint64_t(state.iterations()) * n, benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_VecSum)->Arg(1 << 14)->Arg(1 << 20);
+
+} // namespace
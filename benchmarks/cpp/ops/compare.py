@@ -0,0 +1,70 @@
+#!/usr/bin/env python3
+"""Compares two op_bench JSON outputs and flags regressions.
+
+Usage:
+    op_bench --benchmark_out=baseline.json --benchmark_out_format=json
+    # ... apply the change, rebuild ...
+    op_bench --benchmark_out=contender.json --benchmark_out_format=json
+    python compare.py baseline.json contender.json [--threshold 0.05]
+
+Exits non-zero if any benchmark slowed down by more than the threshold, so
+this can gate a bisect or a vendor-drop upgrade in CI.
+"""
+
+import argparse
+import json
+import sys
+
+
+def load_benchmarks(path):
+    with open(path) as f:
+        report = json.load(f)
+    return {
+        b["name"]: b["real_time"]
+        for b in report["benchmarks"]
+        if b.get("run_type", "iteration") == "iteration"
+    }
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("baseline", help="JSON output of the baseline run")
+    parser.add_argument("contender", help="JSON output of the contender run")
+    parser.add_argument(
+        "--threshold",
+        type=float,
+        default=0.05,
+        help="relative slowdown treated as a regression (default: 0.05)",
+    )
+    args = parser.parse_args()
+
+    baseline = load_benchmarks(args.baseline)
+    contender = load_benchmarks(args.contender)
+
+    regressions = []
+    name_width = max(len(name) for name in baseline) if baseline else 0
+    for name, base_time in sorted(baseline.items()):
+        if name not in contender:
+            print("{:<{}}  missing from contender".format(name, name_width))
+            continue
+        new_time = contender[name]
+        ratio = new_time / base_time if base_time else float("inf")
+        print(
+            "{:<{}}  {:>12.1f}  {:>12.1f}  {:>+7.1%}".format(
+                name, name_width, base_time, new_time, ratio - 1.0
+            )
+        )
+        if ratio - 1.0 > args.threshold:
+            regressions.append((name, ratio))
+
+    if regressions:
+        print()
+        print("{} regression(s) above {:.0%}:".format(len(regressions), args.threshold))
+        for name, ratio in regressions:
+            print("  {} ({:+.1%})".format(name, ratio - 1.0))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
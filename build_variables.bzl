@@ -118,6 +118,7 @@ core_sources_common = [
 
 torch_unpickler_common = [
     "torch/csrc/jit/serialization/import_read.cpp",
+    "torch/csrc/jit/serialization/storage_dedup.cpp",
     "torch/csrc/jit/serialization/unpickler.cpp",
 ]
 
@@ -130,9 +131,11 @@ libtorch_profiler_sources = [
     "torch/csrc/profiler/api.cpp",
     "torch/csrc/profiler/collection.cpp",
     "torch/csrc/profiler/kineto_shim.cpp",
+    "torch/csrc/profiler/perf.cpp",
     "torch/csrc/profiler/nvtx_observer.cpp",
     "torch/csrc/profiler/kineto_client_interface.cpp",
     "torch/csrc/profiler/itt_observer.cpp",
+    "torch/csrc/profiler/sampling_observer.cpp",
     "torch/csrc/monitor/counters.cpp",
     "torch/csrc/monitor/events.cpp",
 ]
@@ -142,6 +145,7 @@ libtorch_edge_profiler_sources = libtorch_profiler_sources + [
 ]
 
 core_trainer_sources = [
+    "torch/csrc/autograd/activation_offload.cpp",
     "torch/csrc/autograd/anomaly_mode.cpp",
     "torch/csrc/autograd/autograd.cpp",
     "torch/csrc/autograd/autograd_not_implemented_fallback.cpp",
@@ -149,6 +153,7 @@ core_trainer_sources = [
     "torch/csrc/autograd/custom_function.cpp",
     "torch/csrc/autograd/engine.cpp",
     "torch/csrc/autograd/function.cpp",
+    "torch/csrc/autograd/node_pool.cpp",
     "torch/csrc/autograd/function_hook.cpp",
     "torch/csrc/autograd/functions/accumulate_grad.cpp",
     "torch/csrc/autograd/functions/basic_ops.cpp",
@@ -166,9 +171,12 @@ core_trainer_sources = [
 ]
 
 core_sources_full_mobile_no_backend_interface = [
+    "torch/csrc/jit/api/batched_module.cpp",
     "torch/csrc/jit/api/function_impl.cpp",
+    "torch/csrc/jit/api/hot_swap_module.cpp",
     "torch/csrc/jit/api/module.cpp",
     "torch/csrc/jit/api/object.cpp",
+    "torch/csrc/jit/api/shared_weight_region.cpp",
     "torch/csrc/jit/backends/backend_debug_handler.cpp",
     "torch/csrc/jit/backends/backend_detail.cpp",
     "torch/csrc/jit/backends/backend_resolver.cpp",
@@ -223,17 +231,20 @@ core_sources_full_mobile_no_backend_interface = [
     "torch/csrc/jit/passes/restore_mutation.cpp",
     "torch/csrc/jit/passes/create_autodiff_subgraphs.cpp",
     "torch/csrc/jit/passes/cuda_graph_fuser.cpp",
+    "torch/csrc/jit/passes/cuda_stream_partitioning.cpp",
     "torch/csrc/jit/passes/dead_code_elimination.cpp",
     "torch/csrc/jit/passes/eliminate_no_ops.cpp",
     "torch/csrc/jit/passes/remove_redundant_profiles.cpp",
     "torch/csrc/jit/passes/remove_exceptions.cpp",
     "torch/csrc/jit/passes/decompose_ops.cpp",
     "torch/csrc/jit/passes/dtype_analysis.cpp",
+    "torch/csrc/jit/passes/device_region_planning.cpp",
     "torch/csrc/jit/passes/device_type_analysis.cpp",
     "torch/csrc/jit/passes/erase_number_types.cpp",
     "torch/csrc/jit/passes/fixup_trace_scope_blocks.cpp",
     "torch/csrc/jit/passes/freeze_module.cpp",
     "torch/csrc/jit/passes/fuse_linear.cpp",
+    "torch/csrc/jit/passes/fuse_pointwise_chains.cpp",
     "torch/csrc/jit/passes/fuse_relu.cpp",
     "torch/csrc/jit/passes/graph_fuser.cpp",
     "torch/csrc/jit/passes/graph_rewrite_helper.cpp",
@@ -250,6 +261,7 @@ core_sources_full_mobile_no_backend_interface = [
     "torch/csrc/jit/passes/loop_unrolling.cpp",
     "torch/csrc/jit/passes/lower_grad_of.cpp",
     "torch/csrc/jit/passes/lower_tuples.cpp",
+    "torch/csrc/jit/passes/memory_format_propagation.cpp",
     "torch/csrc/jit/passes/normalize_ops.cpp",
     "torch/csrc/jit/passes/peephole_dict_idioms.cpp",
     "torch/csrc/jit/passes/peephole_list_idioms.cpp",
@@ -260,6 +272,7 @@ core_sources_full_mobile_no_backend_interface = [
     "torch/csrc/jit/passes/peephole_non_tensor.cpp",
     "torch/csrc/jit/passes/create_functional_graphs.cpp",
     "torch/csrc/jit/passes/refine_tuple_types.cpp",
+    "torch/csrc/jit/passes/reinplace.cpp",
     "torch/csrc/jit/passes/remove_mutation.cpp",
     "torch/csrc/jit/passes/prepack_folding.cpp",
     "torch/csrc/jit/passes/fold_conv_bn.cpp",
@@ -503,6 +516,7 @@ libtorch_distributed_extra_sources = [
     "torch/csrc/distributed/rpc/python_call.cpp",
     "torch/csrc/distributed/rpc/python_remote_call.cpp",
     "torch/csrc/distributed/rpc/python_resp.cpp",
+    "torch/csrc/distributed/rpc/remote_storage.cpp",
     "torch/csrc/distributed/rpc/request_callback.cpp",
     "torch/csrc/distributed/rpc/request_callback_no_python.cpp",
     "torch/csrc/distributed/rpc/rpc_agent.cpp",
@@ -574,6 +588,7 @@ libtorch_lite_eager_symbolication = [
     # to have better separation within build and only build relevant parts.
     "torch/csrc/jit/serialization/pickle.cpp",
     "torch/csrc/jit/serialization/pickler.cpp",
+    "torch/csrc/jit/serialization/storage_dedup.cpp",
     "torch/csrc/jit/serialization/unpickler.cpp",
 ]
 
@@ -736,6 +751,7 @@ libtorch_cuda_core_sources = [
     "torch/csrc/jit/passes/frozen_conv_add_relu_fusion_cuda.cpp",
     "torch/csrc/jit/tensorexpr/cuda_codegen.cpp",
     "torch/csrc/jit/runtime/register_cuda_ops.cpp",
+    "torch/csrc/jit/runtime/static/cuda_graphs.cpp",
 ]
 
 # These files are the only ones that are supported on Windows.
@@ -762,6 +778,7 @@ libtorch_cuda_sources = libtorch_cuda_core_sources + libtorch_cuda_distributed_s
 
 torch_cpp_srcs = [
     "torch/csrc/api/src/cuda.cpp",  # this just forwards stuff, no real CUDA
+    "torch/csrc/api/src/data/datasets/csv.cpp",
     "torch/csrc/api/src/data/datasets/mnist.cpp",
     "torch/csrc/api/src/data/samplers/distributed.cpp",
     "torch/csrc/api/src/data/samplers/random.cpp",
@@ -815,6 +832,7 @@ torch_cpp_srcs = [
     "torch/csrc/api/src/optim/rmsprop.cpp",
     "torch/csrc/api/src/optim/serialize.cpp",
     "torch/csrc/api/src/optim/sgd.cpp",
+    "torch/csrc/api/src/optim/state_arena.cpp",
     "torch/csrc/api/src/optim/schedulers/lr_scheduler.cpp",
     "torch/csrc/api/src/optim/schedulers/step_lr.cpp",
     "torch/csrc/api/src/serialize/input-archive.cpp",
@@ -998,6 +1016,7 @@ aten_cpu_source_non_codegen_list = [
     "aten/src/ATen/NamedTensorUtils.cpp",
     "aten/src/ATen/NestedTensorImpl.cpp",
     "aten/src/ATen/ParallelCommon.cpp",
+    "aten/src/ATen/ParallelGrainTuner.cpp",
     "aten/src/ATen/ParallelNative.cpp",
     "aten/src/ATen/ParallelNativeTBB.cpp",
     "aten/src/ATen/ParallelOpenMP.cpp",
@@ -1119,6 +1138,7 @@ aten_native_source_codegen_list = [
     "aten/src/ATen/native/cpu/AvgPoolKernel.cpp",
     "aten/src/ATen/native/cpu/BinaryOpsKernel.cpp",
     "aten/src/ATen/native/cpu/BlasKernel.cpp",
+    "aten/src/ATen/native/cpu/ByteOpsKernel.cpp",
     "aten/src/ATen/native/cpu/CatKernel.cpp",
     "aten/src/ATen/native/cpu/ChannelShuffleKernel.cpp",
     "aten/src/ATen/native/cpu/ComplexKernel.cpp",
@@ -1129,11 +1149,13 @@ aten_native_source_codegen_list = [
     "aten/src/ATen/native/cpu/DistributionKernels.cpp",
     "aten/src/ATen/native/cpu/FillKernel.cpp",
     "aten/src/ATen/native/cpu/FunctionOfAMatrixUtilsKernel.cpp",
+    "aten/src/ATen/native/cpu/FusedOptimizerKernels.cpp",
     "aten/src/ATen/native/cpu/GridSamplerKernel.cpp",
     "aten/src/ATen/native/cpu/HistogramKernel.cpp",
     "aten/src/ATen/native/cpu/IndexKernel.cpp",
     "aten/src/ATen/native/cpu/LerpKernel.cpp",
     "aten/src/ATen/native/cpu/LinearAlgebraKernel.cpp",
+    "aten/src/ATen/native/cpu/MaskPackingKernel.cpp",
     "aten/src/ATen/native/cpu/MaxPoolKernel.cpp",
     "aten/src/ATen/native/cpu/MaxPooling.cpp",
     "aten/src/ATen/native/cpu/MaxUnpoolKernel.cpp",
@@ -1160,6 +1182,7 @@ aten_native_source_codegen_list = [
     "aten/src/ATen/native/cpu/airy_ai.cpp",
     "aten/src/ATen/native/cpu/batch_norm_kernel.cpp",
     "aten/src/ATen/native/cpu/group_norm_kernel.cpp",
+    "aten/src/ATen/native/cpu/int_mm_kernel.cpp",
     "aten/src/ATen/native/cpu/layer_norm_kernel.cpp",
     "aten/src/ATen/native/cpu/scaled_modified_bessel_k0.cpp",
     "aten/src/ATen/native/cpu/scaled_modified_bessel_k1.cpp",
@@ -1211,6 +1234,7 @@ aten_native_source_non_codegen_list = [
     "aten/src/ATen/native/quantized/cpu/Pooling.cpp",
     "aten/src/ATen/native/quantized/cpu/ReduceOps.cpp",
     "aten/src/ATen/native/quantized/cpu/qrelu.cpp",
+    "aten/src/ATen/native/quantized/cpu/qrnn_cell.cpp",
     "aten/src/ATen/native/quantized/cpu/qsigmoid.cpp",
     "aten/src/ATen/native/quantized/cpu/qsoftmax.cpp",
     "aten/src/ATen/native/quantized/cpu/Sorting.cpp",
@@ -1250,6 +1274,7 @@ aten_native_source_non_codegen_list = [
     "aten/src/ATen/native/Blas.cpp",
     "aten/src/ATen/native/BlasKernel.cpp",
     "aten/src/ATen/native/Bucketization.cpp",
+    "aten/src/ATen/native/ByteOps.cpp",
     "aten/src/ATen/native/CPUBlas.cpp",
     "aten/src/ATen/native/ChanelShuffle.cpp",
     "aten/src/ATen/native/Col2Im.cpp",
@@ -1277,6 +1302,7 @@ aten_native_source_non_codegen_list = [
     "aten/src/ATen/native/FractionalMaxPool2d.cpp",
     "aten/src/ATen/native/FractionalMaxPool3d.cpp",
     "aten/src/ATen/native/FunctionOfAMatrixUtils.cpp",
+    "aten/src/ATen/native/FusedOptimizerOps.cpp",
     "aten/src/ATen/native/GatedLinearUnit.cpp",
     "aten/src/ATen/native/GridSampler.cpp",
     "aten/src/ATen/native/Histogram.cpp",
@@ -1294,6 +1320,7 @@ aten_native_source_non_codegen_list = [
     "aten/src/ATen/native/LossMultiMargin.cpp",
     "aten/src/ATen/native/LossNLL.cpp",
     "aten/src/ATen/native/LossNLL2d.cpp",
+    "aten/src/ATen/native/MaskPacking.cpp",
     "aten/src/ATen/native/MaxPooling.cpp",
     "aten/src/ATen/native/MaxUnpooling.cpp",
     "aten/src/ATen/native/Memory.cpp",
@@ -1375,6 +1402,7 @@ aten_native_source_non_codegen_list = [
     "aten/src/ATen/native/sparse/SparseCsrTensorMath.cpp",
     "aten/src/ATen/native/sparse/SparseFactories.cpp",
     "aten/src/ATen/native/sparse/ValidateCompressedIndicesKernel.cpp",
+    "aten/src/ATen/native/transformers/PagedKVCache.cpp",
     "aten/src/ATen/native/transformers/attention.cpp",
     "aten/src/ATen/native/transformers/transformer.cpp",
     "aten/src/ATen/native/xnnpack/Activation.cpp",
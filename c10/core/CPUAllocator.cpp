@@ -1,10 +1,20 @@
 #include <c10/core/Allocator.h>
 #include <c10/core/CPUAllocator.h>
 #include <c10/core/DeviceType.h>
+#include <c10/core/MemoryArena.h>
+#include <c10/core/MemoryWatermark.h>
 #include <c10/core/alignment.h>
 #include <c10/core/impl/alloc_cpu.h>
 #include <c10/mobile/CPUCachingAllocator.h>
 #include <c10/mobile/CPUProfilingAllocator.h>
+#include <c10/util/flat_hash_map.h>
+#include <c10/util/numa.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
 
 // TODO: rename flag to C10
 C10_DEFINE_bool(
@@ -12,19 +22,306 @@ C10_DEFINE_bool(
     false,
     "If set, print out detailed memory usage");
 
+C10_DEFINE_bool(
+    caffe2_cpu_allocator_cache_freed_blocks,
+    false,
+    "If set, DefaultCPUAllocator recycles freed blocks through size-classed "
+    "per-NUMA-node free lists instead of returning them to the OS. See Note "
+    "[Size-classed CPU allocation cache]. Can be toggled at runtime with "
+    "c10::setCPUCachingAllocatorEnabled().");
+
+C10_DECLARE_bool(caffe2_cpu_allocator_use_hugepages);
+
 namespace c10 {
 
+// Note [Size-classed CPU allocation cache]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// alloc_cpu/free_cpu return memory to the OS on every free, so an op that
+// repeatedly materializes a multi-megabyte temporary pays the page faults of
+// a cold mapping on every call. When enabled, DefaultCPUAllocator instead
+// parks freed blocks on power-of-two free lists and serves later requests of
+// the same size class from them, keeping the pages warm. The free lists are
+// per NUMA node: a block is parked on the node it was allocated from (where
+// the first touch placed its pages) and only handed back to threads running
+// on that node, so recycling never converts a local allocation into a remote
+// one. A lazily started background thread sweeps the lists once per
+// kTrimInterval and releases blocks that sat unused for a full interval, so
+// a burst of large temporaries does not pin memory forever. Counters are
+// surfaced through c10::getCPUCachingAllocatorStats().
+//
+// The mobile CPUCachingAllocator (c10/mobile/CPUCachingAllocator.cpp) caches
+// exact sizes with no trimming and is scoped to explicitly guarded regions;
+// this cache is process-wide and sits directly inside the default allocator.
+
+namespace {
+
+// Blocks outside [kMinCachedBlockSize, kMaxCachedBlockSize] bypass the
+// cache: small ones are cheap to get from the OS allocator, huge ones would
+// dominate the cached footprint for little reuse.
+constexpr size_t kMinCachedBlockSize = 4096;
+constexpr size_t kMaxCachedBlockSize = static_cast<size_t>(64) << 20;
+constexpr int kNumSizeClasses = 15; // 4KB ... 64MB, consecutive powers of two
+constexpr auto kTrimInterval = std::chrono::seconds(1);
+
+size_t size_class_of(size_t nbytes) {
+  size_t cls = 0;
+  size_t bytes = kMinCachedBlockSize;
+  while (bytes < nbytes) {
+    bytes <<= 1;
+    ++cls;
+  }
+  return cls;
+}
+
+size_t size_class_bytes(size_t cls) {
+  return kMinCachedBlockSize << cls;
+}
+
+class AllocationCache {
+ public:
+  AllocationCache()
+      : pools_(std::max(1, GetNumNUMANodes())),
+        enabled_(FLAGS_caffe2_cpu_allocator_cache_freed_blocks) {}
+
+  // Returns nullptr when the cache declines (disabled or size out of range);
+  // the caller then falls back to plain alloc_cpu. Misses for cacheable
+  // sizes are allocated (rounded up to the size class) and tracked so the
+  // matching free can be absorbed.
+  void* allocate(size_t nbytes) {
+    if (!enabled_.load(std::memory_order_relaxed) ||
+        nbytes < kMinCachedBlockSize || nbytes > kMaxCachedBlockSize) {
+      return nullptr;
+    }
+    const size_t cls = size_class_of(nbytes);
+    const int node = current_node();
+    Pool& pool = pools_[node];
+    {
+      std::lock_guard<std::mutex> guard(stats_mutex_);
+      std::lock_guard<std::mutex> pool_guard(pool.mutex);
+      auto& free_list = pool.free_lists[cls];
+      if (!free_list.empty()) {
+        void* ptr = free_list.back().ptr;
+        free_list.pop_back();
+        stats_.num_cache_hits++;
+        stats_.cached_bytes -= size_class_bytes(cls);
+        return ptr;
+      }
+    }
+    void* ptr = nullptr;
+    try {
+      ptr = c10::alloc_cpu(size_class_bytes(cls));
+    } catch (c10::Error&) {
+      // Give the cached blocks back to the OS and retry before reporting
+      // the failure to the caller.
+      empty();
+      ptr = c10::alloc_cpu(size_class_bytes(cls));
+    }
+    std::lock_guard<std::mutex> guard(stats_mutex_);
+    stats_.num_cache_misses++;
+    block_map_[ptr] = Block{cls, node};
+    return ptr;
+  }
+
+  // Returns true when the block was absorbed into a free list; false means
+  // the pointer is not cache-managed and the caller must free it.
+  bool maybe_free(void* ptr) {
+    std::unique_lock<std::mutex> guard(stats_mutex_);
+    auto it = block_map_.find(ptr);
+    if (it == block_map_.end()) {
+      return false;
+    }
+    if (!enabled_.load(std::memory_order_relaxed)) {
+      // The cache was turned off after this block was handed out; stop
+      // tracking it and let the caller release it.
+      block_map_.erase(it);
+      return false;
+    }
+    const Block block = it->second;
+    Pool& pool = pools_[block.node];
+    {
+      std::lock_guard<std::mutex> pool_guard(pool.mutex);
+      pool.free_lists[block.cls].push_back(
+          CachedBlock{ptr, pool.generation});
+    }
+    stats_.num_cached_frees++;
+    stats_.cached_bytes += size_class_bytes(block.cls);
+    stats_.max_cached_bytes =
+        std::max(stats_.max_cached_bytes, stats_.cached_bytes);
+    guard.unlock();
+    start_trimmer();
+    return true;
+  }
+
+  void set_enabled(bool enabled) {
+    enabled_.store(enabled, std::memory_order_relaxed);
+    if (!enabled) {
+      empty();
+    }
+  }
+
+  bool enabled() const {
+    return enabled_.load(std::memory_order_relaxed);
+  }
+
+  void empty() {
+    for (auto& pool : pools_) {
+      std::array<std::vector<CachedBlock>, kNumSizeClasses> stale;
+      {
+        std::lock_guard<std::mutex> pool_guard(pool.mutex);
+        stale.swap(pool.free_lists);
+      }
+      release(stale, /*trimmed=*/false);
+    }
+  }
+
+  CPUCachingAllocatorStats stats() {
+    std::lock_guard<std::mutex> guard(stats_mutex_);
+    return stats_;
+  }
+
+ private:
+  struct Block {
+    size_t cls;
+    int node;
+  };
+
+  struct CachedBlock {
+    void* ptr;
+    // Value of Pool::generation when the block was parked; blocks that
+    // survive a full trim interval untouched get released.
+    uint64_t generation;
+  };
+
+  struct Pool {
+    std::mutex mutex;
+    std::array<std::vector<CachedBlock>, kNumSizeClasses> free_lists;
+    uint64_t generation = 0;
+  };
+
+  int current_node() const {
+    const int node = GetCurrentNUMANode();
+    if (node < 0 || node >= static_cast<int>(pools_.size())) {
+      return 0;
+    }
+    return node;
+  }
+
+  // Frees the given blocks and drops their tracking entries and cached
+  // bytes. Called with no locks held.
+  void release(
+      const std::array<std::vector<CachedBlock>, kNumSizeClasses>& blocks,
+      bool trimmed) {
+    for (size_t cls = 0; cls < blocks.size(); ++cls) {
+      for (const auto& block : blocks[cls]) {
+        c10::free_cpu(block.ptr);
+        std::lock_guard<std::mutex> guard(stats_mutex_);
+        block_map_.erase(block.ptr);
+        stats_.cached_bytes -= size_class_bytes(cls);
+        if (trimmed) {
+          stats_.num_trimmed_blocks++;
+        }
+      }
+    }
+  }
+
+  void trim() {
+    for (auto& pool : pools_) {
+      std::array<std::vector<CachedBlock>, kNumSizeClasses> stale;
+      {
+        std::lock_guard<std::mutex> pool_guard(pool.mutex);
+        pool.generation++;
+        for (size_t cls = 0; cls < pool.free_lists.size(); ++cls) {
+          auto& free_list = pool.free_lists[cls];
+          // Blocks are pushed in generation order and reused from the
+          // back, so the stale ones form a prefix.
+          size_t keep = 0;
+          while (keep < free_list.size() &&
+                 free_list[keep].generation + 1 < pool.generation) {
+            ++keep;
+          }
+          stale[cls].assign(
+              free_list.begin(), free_list.begin() + keep);
+          free_list.erase(free_list.begin(), free_list.begin() + keep);
+        }
+      }
+      release(stale, /*trimmed=*/true);
+    }
+  }
+
+  void start_trimmer() {
+    std::call_once(trimmer_started_, [this] {
+      std::thread([this] {
+        while (true) {
+          std::this_thread::sleep_for(kTrimInterval);
+          if (enabled_.load(std::memory_order_relaxed)) {
+            trim();
+          }
+        }
+      }).detach();
+    });
+  }
+
+  std::vector<Pool> pools_;
+  std::atomic<bool> enabled_;
+  std::once_flag trimmer_started_;
+  // Guards block_map_ and stats_. Taken before the pool mutex when both
+  // are needed.
+  std::mutex stats_mutex_;
+  ska::flat_hash_map<void*, Block> block_map_;
+  CPUCachingAllocatorStats stats_;
+};
+
+// Deliberately leaked: the detached trimmer thread and late frees may touch
+// the cache during process shutdown.
+AllocationCache& cpu_allocation_cache() {
+  static AllocationCache* cache = new AllocationCache();
+  return *cache;
+}
+
+} // namespace
+
+void setCPUCachingAllocatorEnabled(bool enabled) {
+  cpu_allocation_cache().set_enabled(enabled);
+}
+
+bool isCPUCachingAllocatorEnabled() {
+  return cpu_allocation_cache().enabled();
+}
+
+void emptyCPUCachingAllocator() {
+  cpu_allocation_cache().empty();
+}
+
+CPUCachingAllocatorStats getCPUCachingAllocatorStats() {
+  return cpu_allocation_cache().stats();
+}
+
 struct C10_API DefaultCPUAllocator final : at::Allocator {
   DefaultCPUAllocator() = default;
   at::DataPtr allocate(size_t nbytes) const override {
     void* data = nullptr;
-    try {
-      data = c10::alloc_cpu(nbytes);
-    } catch (c10::Error& e) {
-      profiledCPUMemoryReporter().OutOfMemory(nbytes);
-      throw e;
+    // See Note [Request-scoped memory arenas] in MemoryArena.cpp. Arena
+    // pointers share ReportAndDelete with heap pointers, which keeps the
+    // raw_allocate/raw_deallocate interface working under a guard.
+    if (MemoryArena* arena = MemoryArena::ThreadLocal()) {
+      data = arena->allocate(nbytes);
+    }
+    if (data == nullptr) {
+      try {
+        // See Note [Size-classed CPU allocation cache]. The cache declines
+        // (returns nullptr) when disabled or when nbytes is outside the
+        // cached size range.
+        data = cpu_allocation_cache().allocate(nbytes);
+        if (data == nullptr) {
+          data = c10::alloc_cpu(nbytes);
+        }
+      } catch (c10::Error& e) {
+        profiledCPUMemoryReporter().OutOfMemory(nbytes);
+        throw e;
+      }
     }
     profiledCPUMemoryReporter().New(data, nbytes);
+    memory_watermark::reportCPUAllocation(data, nbytes);
     return {data, data, &ReportAndDelete, at::Device(at::DeviceType::CPU)};
   }
 
@@ -33,6 +330,13 @@ struct C10_API DefaultCPUAllocator final : at::Allocator {
       return;
     }
     profiledCPUMemoryReporter().Delete(ptr);
+    memory_watermark::reportCPUDeallocation(ptr);
+    if (MemoryArena::MaybeRelease(ptr)) {
+      return;
+    }
+    if (cpu_allocation_cache().maybe_free(ptr)) {
+      return;
+    }
     free_cpu(ptr);
   }
 
@@ -205,6 +509,11 @@ void ProfiledCPUMemoryReporter::New(void* ptr, size_t nbytes) {
   if (FLAGS_caffe2_report_cpu_memory_usage) {
     LOG(INFO) << "C10 alloc " << nbytes << " bytes, total alloc " << allocated
               << " bytes.";
+    if (FLAGS_caffe2_cpu_allocator_use_hugepages) {
+      LOG(INFO) << "C10 huge page coverage: " << hugepage_advised_bytes()
+                << " of " << hugepage_eligible_bytes()
+                << " eligible bytes advised.";
+    }
   }
   if (profile_memory) {
     reportMemoryUsageToProfiler(
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <cstring>
 #include <unordered_map>
 
@@ -54,4 +55,28 @@ C10_API void SetCPUCachingAllocator(Allocator* alloc, uint8_t priority = 0);
 // Get the CPU Caching Allocator
 C10_API Allocator* GetCPUCachingAllocator();
 
+// Counters for the block cache inside DefaultCPUAllocator. See Note
+// [Size-classed CPU allocation cache] in CPUAllocator.cpp. Unrelated to the
+// experimental StaticRuntime hook above.
+struct C10_API CPUCachingAllocatorStats {
+  // Allocations served from a free list vs. handed to the OS.
+  uint64_t num_cache_hits = 0;
+  uint64_t num_cache_misses = 0;
+  // Frees absorbed into the free lists.
+  uint64_t num_cached_frees = 0;
+  // Cached blocks released back to the OS by background trimming.
+  uint64_t num_trimmed_blocks = 0;
+  // Bytes currently parked in free lists, and their high-water mark.
+  uint64_t cached_bytes = 0;
+  uint64_t max_cached_bytes = 0;
+};
+
+// Turns the DefaultCPUAllocator block cache on or off at runtime; the
+// caffe2_cpu_allocator_cache_freed_blocks flag sets the initial state.
+C10_API void setCPUCachingAllocatorEnabled(bool enabled);
+C10_API bool isCPUCachingAllocatorEnabled();
+// Releases every cached block back to the OS.
+C10_API void emptyCPUCachingAllocator();
+C10_API CPUCachingAllocatorStats getCPUCachingAllocatorStats();
+
 } // namespace c10
@@ -1,5 +1,4 @@
 #include <c10/core/DispatchKeySet.h>
-#include <c10/util/irange.h>
 #include <iostream>
 
 namespace c10 {
@@ -236,42 +235,4 @@ DispatchKeySet::iterator& DispatchKeySet::iterator::operator++() {
   return *this;
 }
 
-std::array<FunctionalityOffsetAndMask, num_functionality_keys>
-initializeFunctionalityOffsetsAndMasks() {
-  std::array<FunctionalityOffsetAndMask, num_functionality_keys>
-      offsets_and_masks;
-  // manualy set the first entry, which corresponds to Undefined.
-  offsets_and_masks[0] = FunctionalityOffsetAndMask(0, 0);
-  // loop through every functionality key (aside from Undefined).
-  for (const auto functionality_idx : c10::irange(1, num_functionality_keys)) {
-    // functionality_idx should be Dense -> 1, ...
-    auto prev_offset_and_mask = offsets_and_masks[functionality_idx - 1];
-    auto k = static_cast<DispatchKey>(functionality_idx);
-
-    // If the previous functionality was not per-backend, then we can just
-    // increment the previous offset. Otherwise, the next offset =
-    // previous_offset + num_backends.
-    auto next_offset = prev_offset_and_mask.offset +
-        (prev_offset_and_mask.mask == 0 ? 1 : num_backends);
-    // the mask is used in the runtime index calculation to find the offset of
-    // the backend. For non-per-backend functionalities, this offset should
-    // always be 0. Otherwise, we need to get the index of the backend (which we
-    // can do using a backend mask).
-    auto next_mask = isPerBackendFunctionalityKey(k) ? full_backend_mask : 0;
-    offsets_and_masks[functionality_idx] =
-        FunctionalityOffsetAndMask(next_offset, next_mask);
-  }
-  // Sanity check that the computed offset index of the last functionality key
-  // is correct. This assumes that the highest priority functionality key is not
-  // per backend.
-  TORCH_INTERNAL_ASSERT(
-      offsets_and_masks[num_functionality_keys - 1].offset ==
-          (num_runtime_entries - 1),
-      "num_runtime_entries: ",
-      num_runtime_entries,
-      "last_offset: ",
-      offsets_and_masks[num_functionality_keys - 1].offset);
-  return offsets_and_masks;
-}
-
 } // namespace c10
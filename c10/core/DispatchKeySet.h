@@ -8,10 +8,8 @@
 namespace c10 {
 
 struct FunctionalityOffsetAndMask {
-  // empty constructor shouldn't be used; only needed to initialize
-  // the array before populating it.
-  FunctionalityOffsetAndMask() {}
-  FunctionalityOffsetAndMask(uint16_t offset, uint16_t mask)
+  constexpr FunctionalityOffsetAndMask() : offset(0), mask(0) {}
+  constexpr FunctionalityOffsetAndMask(uint16_t offset, uint16_t mask)
       : offset(offset), mask(mask) {}
   // This needs to big enough to cover the size of the operator table.
   uint16_t offset;
@@ -25,16 +23,81 @@ static_assert(
     c10::num_runtime_entries < 65536,
     "The dispatcher currently only supports up to 2^16 runtime entries");
 
-C10_API std::array<FunctionalityOffsetAndMask, num_functionality_keys>
-initializeFunctionalityOffsetsAndMasks();
-
-C10_ALWAYS_INLINE static const std::
-    array<FunctionalityOffsetAndMask, num_functionality_keys>&
-    offsetsAndMasks() {
-  static auto offsets_and_masks_ = initializeFunctionalityOffsetsAndMasks();
-  return offsets_and_masks_;
+// Note [Direct-mapped dispatch index table]
+// getDispatchTableIndexForDispatchKeySet() is some of the hottest code in the
+// dispatcher: it runs on every operator call to turn a keyset into a slot in
+// the per-operator dispatch table. The offset-and-mask table it reads used to
+// be a function-local static populated on first use, which costs a
+// thread-safe initialization check on every lookup, and it was indexed by the
+// functionality bits only, which costs an extra shift before the bit-scan.
+// Instead, we precompute the table at compile time and direct-map it by the
+// index of the highest set bit of the full 64-bit keyset representation
+// (backend bits included), so that resolving the functionality is a single
+// bit-scan plus one indexed load:
+// - entry 0 (empty keyset) and entries [1, num_backends] (keysets whose
+//   highest bit is a backend bit) resolve to the Undefined slot.
+// - entry (num_backends + f) holds the operator-table offset and backend mask
+//   for functionality f.
+// Note that the table is intentionally NOT stored per operator: the
+// keyset-to-slot mapping is identical for every operator, and the only
+// per-operator state involved in key resolution (which kernels are
+// fallthrough) is already precomputed at registration time in
+// DispatchKeyExtractor.
+struct FunctionalityOffsetAndMaskTable {
+  // Direct-mapped by DispatchKeySet::indexOfHighestBit().
+  FunctionalityOffsetAndMask entries[64];
+};
+static_assert(
+    num_backends + num_functionality_keys <= 64,
+    "The direct-mapped dispatch index table is indexed by the position of "
+    "the highest bit in the 64-bit keyset representation");
+
+constexpr FunctionalityOffsetAndMaskTable
+computeFunctionalityOffsetsAndMasks() {
+  FunctionalityOffsetAndMaskTable table{};
+  // loop through every functionality key (aside from Undefined).
+  for (uint8_t functionality_idx = 1;
+       functionality_idx < num_functionality_keys;
+       functionality_idx++) {
+    // functionality_idx should be Dense -> 1, ...
+    const auto& prev_offset_and_mask =
+        table.entries[num_backends + functionality_idx - 1];
+    auto k = static_cast<DispatchKey>(functionality_idx);
+
+    // If the previous functionality was not per-backend, then we can just
+    // increment the previous offset. Otherwise, the next offset =
+    // previous_offset + num_backends.
+    auto next_offset = static_cast<uint16_t>(
+        prev_offset_and_mask.offset +
+        (prev_offset_and_mask.mask == 0 ? 1 : num_backends));
+    // the mask is used in the runtime index calculation to find the offset of
+    // the backend. For non-per-backend functionalities, this offset should
+    // always be 0. Otherwise, we need to get the index of the backend (which
+    // we can do using a backend mask).
+    auto next_mask = static_cast<uint16_t>(
+        isPerBackendFunctionalityKey(k) ? full_backend_mask : 0);
+    table.entries[num_backends + functionality_idx] =
+        FunctionalityOffsetAndMask(next_offset, next_mask);
+  }
+  return table;
 }
 
+constexpr FunctionalityOffsetAndMaskTable offsets_and_masks_table =
+    computeFunctionalityOffsetsAndMasks();
+
+#if !defined(C10_MOBILE_TRIM_DISPATCH_KEYS)
+// Sanity check that the computed offset of the last functionality key lines
+// up with the size of the runtime operator table. This assumes that the
+// highest priority functionality key is not per backend. (The check doesn't
+// hold for trimmed mobile builds, which size the operator table with a
+// hand-rolled switch; see [Note: Trimmed Mobile Dispatch Keys].)
+static_assert(
+    offsets_and_masks_table.entries[num_backends + num_functionality_keys - 1]
+            .offset == num_runtime_entries - 1,
+    "The direct-mapped dispatch index table disagrees with "
+    "num_runtime_entries");
+#endif
+
 // A representation of a set of DispatchKeys. A DispatchKeySet contains both
 // "functionality" bits and "backend bits", and every tensor holds its own
 // DispatchKeySet. The Dispatcher implements multiple dispatch by grabbing the
@@ -463,9 +526,9 @@ class DispatchKeySet final {
   // highestPriorityTypeId(), but this code is very hotpath and we can do it
   // faster without it.
   int getDispatchTableIndexForDispatchKeySet() const {
-    auto functionality_idx =
-        DispatchKeySet(repr_ >> num_backends).indexOfHighestBit();
-    auto offset_and_mask = offsetsAndMasks()[functionality_idx];
+    // A single bit-scan over the full representation, plus one indexed load.
+    // See Note [Direct-mapped dispatch index table].
+    auto offset_and_mask = offsets_and_masks_table.entries[indexOfHighestBit()];
     // Mask the functionality bits out first, then right-shift by 1.
     // right-shifting by 1 because everything is zero-indexed.
     // E.g. 000001 (CPU) should give us an offset of 0, 000010 (CUDA) should
@@ -0,0 +1,166 @@
+#include <c10/core/MemoryArena.h>
+
+#include <c10/core/alignment.h>
+#include <c10/core/impl/alloc_cpu.h>
+#include <c10/util/Exception.h>
+
+#include <atomic>
+#include <map>
+#include <mutex>
+
+namespace c10 {
+
+// Note [Request-scoped memory arenas]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// A latency-sensitive inference request allocates thousands of short-lived
+// tensors; serving each one from the heap costs a malloc/free round trip
+// and fragments the allocator. While a MemoryArenaGuard is installed,
+// DefaultCPUAllocator redirects allocations at or below the guard's size
+// threshold here, and an allocation is a pointer bump into the arena's
+// current chunk (chunks come from alloc_cpu, so bump offsets rounded up to
+// gAlignment keep every allocation as aligned as the heap would).
+//
+// Lifetimes are reference counted per chunk: the arena holds one reference
+// to each of its chunks and every allocation holds one more. Frees inside
+// the scope just drop a reference (the memory is not reused until the whole
+// chunk dies, which is the point: freeing is wholesale). When the guard
+// exits, the arena drops its references; a chunk whose allocations have all
+// been released is freed on the spot, while a chunk still referenced by an
+// escaped tensor is pinned until the last such tensor goes away.
+//
+// Arena pointers are freed through the same deleter as heap pointers
+// (ReportAndDelete in CPUAllocator.cpp), which keeps DataPtr's context equal
+// to the data pointer and therefore keeps the raw_allocate/raw_deallocate
+// interface working under a guard. The deleter tells the two kinds apart by
+// asking MaybeRelease, which consults a registry of live chunk address
+// ranges; the registry mutex is only ever touched while at least one arena
+// chunk exists in the process, so the query is one relaxed atomic load for
+// programs that never use a guard.
+
+namespace {
+
+// Chunks grow in fixed slabs; allocations are capped by the guard's
+// threshold, which callers should keep well below this.
+constexpr size_t kArenaChunkBytes = 1024 * 1024;
+
+struct ChunkRegistry {
+  std::mutex mutex;
+  // Keyed by chunk base address; see MaybeRelease for the lookup.
+  std::map<uintptr_t, MemoryArena::Chunk*> by_base;
+};
+
+ChunkRegistry& chunk_registry() {
+  static ChunkRegistry registry;
+  return registry;
+}
+
+std::atomic<int64_t> live_chunk_count{0};
+
+thread_local MemoryArena* tls_memory_arena = nullptr;
+
+} // namespace
+
+struct MemoryArena::Chunk {
+  // One reference held by the owning arena plus one per live allocation.
+  std::atomic<int64_t> refcount{1};
+  void* data;
+  size_t size;
+  size_t used = 0;
+
+  static Chunk* New(size_t size) {
+    void* data = nullptr;
+    try {
+      data = alloc_cpu(size);
+    } catch (const c10::Error&) {
+      return nullptr;
+    }
+    auto* chunk = new Chunk();
+    chunk->data = data;
+    chunk->size = size;
+    {
+      auto& registry = chunk_registry();
+      std::lock_guard<std::mutex> guard(registry.mutex);
+      registry.by_base.emplace(reinterpret_cast<uintptr_t>(data), chunk);
+    }
+    live_chunk_count.fetch_add(1, std::memory_order_relaxed);
+    return chunk;
+  }
+
+  void decref() {
+    if (refcount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      {
+        auto& registry = chunk_registry();
+        std::lock_guard<std::mutex> guard(registry.mutex);
+        registry.by_base.erase(reinterpret_cast<uintptr_t>(data));
+      }
+      live_chunk_count.fetch_sub(1, std::memory_order_relaxed);
+      free_cpu(data);
+      delete this;
+    }
+  }
+};
+
+MemoryArena::MemoryArena(size_t small_alloc_threshold)
+    : small_alloc_threshold_(small_alloc_threshold) {}
+
+MemoryArena::~MemoryArena() {
+  for (auto* chunk : chunks_) {
+    chunk->decref();
+  }
+}
+
+void* MemoryArena::allocate(size_t nbytes) {
+  if (nbytes == 0 || nbytes > small_alloc_threshold_) {
+    return nullptr;
+  }
+  // Round up so the next bump stays as aligned as alloc_cpu's result.
+  const size_t rounded = (nbytes + gAlignment - 1) & ~(gAlignment - 1);
+  if (current_ == nullptr || current_->size - current_->used < rounded) {
+    Chunk* chunk = Chunk::New(kArenaChunkBytes);
+    if (chunk == nullptr) {
+      return nullptr;
+    }
+    chunks_.push_back(chunk);
+    current_ = chunk;
+  }
+  void* ptr = static_cast<char*>(current_->data) + current_->used;
+  current_->used += rounded;
+  current_->refcount.fetch_add(1, std::memory_order_relaxed);
+  return ptr;
+}
+
+bool MemoryArena::MaybeRelease(void* ptr) {
+  if (live_chunk_count.load(std::memory_order_relaxed) == 0) {
+    return false;
+  }
+  Chunk* chunk = nullptr;
+  {
+    auto& registry = chunk_registry();
+    std::lock_guard<std::mutex> guard(registry.mutex);
+    auto it = registry.by_base.upper_bound(reinterpret_cast<uintptr_t>(ptr));
+    if (it == registry.by_base.begin()) {
+      return false;
+    }
+    --it;
+    if (reinterpret_cast<uintptr_t>(ptr) - it->first >= it->second->size) {
+      return false;
+    }
+    chunk = it->second;
+  }
+  // The allocation being released still holds a reference, so the chunk
+  // cannot have been freed between the lookup and this decref.
+  chunk->decref();
+  return true;
+}
+
+MemoryArena* MemoryArena::ThreadLocal() {
+  return tls_memory_arena;
+}
+
+MemoryArena* MemoryArena::SetThreadLocal(MemoryArena* arena) {
+  MemoryArena* prev = tls_memory_arena;
+  tls_memory_arena = arena;
+  return prev;
+}
+
+} // namespace c10
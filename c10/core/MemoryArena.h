@@ -0,0 +1,72 @@
+#pragma once
+
+#include <c10/macros/Macros.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace c10 {
+
+// A request-scoped bump-pointer arena for small, short-lived CPU
+// allocations. Install one with MemoryArenaGuard; while the guard is alive,
+// DefaultCPUAllocator serves allocations at or below the guard's size
+// threshold by bumping a pointer into chunks owned by the arena instead of
+// hitting the heap. See Note [Request-scoped memory arenas] in
+// MemoryArena.cpp for the lifetime protocol.
+class C10_API MemoryArena {
+ public:
+  explicit MemoryArena(size_t small_alloc_threshold);
+  ~MemoryArena();
+  MemoryArena(const MemoryArena&) = delete;
+  MemoryArena& operator=(const MemoryArena&) = delete;
+
+  // Carves nbytes out of the current chunk. Returns nullptr when nbytes is
+  // zero or over the threshold, or when a fresh chunk cannot be allocated;
+  // the caller falls back to the heap. Only the thread that installed the
+  // arena calls this (it is found through thread-local state).
+  void* allocate(size_t nbytes);
+
+  // If ptr belongs to a live arena chunk (including chunks kept alive by
+  // tensors that escaped their guard), drops its reference and returns
+  // true; the deleter must then not free ptr itself. Costs one relaxed
+  // atomic load when no arena chunk exists in the process.
+  static bool MaybeRelease(void* ptr);
+
+  // The arena installed on this thread, if any.
+  static MemoryArena* ThreadLocal();
+
+  struct Chunk;
+
+ private:
+  const size_t small_alloc_threshold_;
+  Chunk* current_ = nullptr;
+  std::vector<Chunk*> chunks_;
+
+  friend struct MemoryArenaGuard;
+  static MemoryArena* SetThreadLocal(MemoryArena* arena);
+};
+
+constexpr size_t kDefaultArenaSmallAllocThreshold = 65536;
+
+// Redirects this thread's small CPU allocations into a fresh arena for the
+// lifetime of the guard. Chunks are freed wholesale when the guard exits;
+// any allocation still referenced by a tensor at that point pins its chunk
+// until the last such tensor is released. Guards nest: the innermost one
+// wins.
+struct C10_API MemoryArenaGuard {
+  explicit MemoryArenaGuard(
+      size_t small_alloc_threshold = kDefaultArenaSmallAllocThreshold)
+      : arena_(small_alloc_threshold),
+        prev_(MemoryArena::SetThreadLocal(&arena_)) {}
+  ~MemoryArenaGuard() {
+    MemoryArena::SetThreadLocal(prev_);
+  }
+  MemoryArenaGuard(const MemoryArenaGuard&) = delete;
+  MemoryArenaGuard& operator=(const MemoryArenaGuard&) = delete;
+
+ private:
+  MemoryArena arena_;
+  MemoryArena* prev_;
+};
+
+} // namespace c10
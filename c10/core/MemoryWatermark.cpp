@@ -0,0 +1,245 @@
+#include <c10/core/MemoryWatermark.h>
+#include <c10/util/irange.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+
+namespace c10 {
+namespace memory_watermark {
+
+// Note [Memory watermark ring buffer]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Attributing an OOM in production requires knowing which operator drove
+// memory to its peak, but the profiler path in Allocator.h only reports
+// allocations while a profiler is attached, and keeping one attached is too
+// expensive to leave on. Instead, the allocators feed this module on every
+// allocation, and we record an event only when a device's total allocated
+// bytes exceeds its previous maximum. High-water marks rise ever more rarely
+// as a workload warms up, so the steady-state cost per allocation is one
+// relaxed atomic load and compare.
+//
+// Events go into a fixed-size global ring. Writers claim a slot with an
+// atomic ticket and publish it with a per-slot sequence counter (odd while
+// the write is in flight, even once published); snapshot() copies each slot
+// and discards it if the sequence changed underneath the copy. This keeps
+// both sides lock-free: a torn or overwritten slot costs us one event, never
+// a stall on the allocation path.
+//
+// Operator attribution comes from a thread-local name installed by the
+// dispatcher around kernel invocation; allocations made outside of any
+// operator record an empty name. The name is copied into the event, so
+// events stay valid even if the operator is later deregistered.
+
+namespace {
+
+constexpr size_t kRingSize = 1024; // must be a power of two
+constexpr size_t kMaxDeviceIndex = 64;
+
+struct RingSlot {
+  // Odd while a writer owns the slot, even once the payload is published.
+  std::atomic<uint64_t> seq{0};
+  MemoryWatermarkEvent event;
+};
+
+struct Ring {
+  std::atomic<uint64_t> next_ticket{0};
+  RingSlot slots[kRingSize];
+};
+
+Ring& ring() {
+  static Ring ring_;
+  return ring_;
+}
+
+std::atomic<int64_t>& watermark(DeviceType device_type, DeviceIndex index) {
+  static std::atomic<int64_t> watermarks
+      [static_cast<size_t>(DeviceType::COMPILE_TIME_MAX_DEVICE_TYPES)]
+      [kMaxDeviceIndex];
+  auto type_idx = static_cast<size_t>(device_type);
+  auto device_idx = static_cast<size_t>(index) % kMaxDeviceIndex;
+  return watermarks[type_idx][device_idx];
+}
+
+int64_t now_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+void push_event(
+    Device device,
+    int64_t alloc_size,
+    int64_t total_allocated) {
+  auto& r = ring();
+  const uint64_t ticket =
+      r.next_ticket.fetch_add(1, std::memory_order_relaxed);
+  RingSlot& slot = r.slots[ticket & (kRingSize - 1)];
+
+  slot.seq.store(2 * ticket + 1, std::memory_order_release);
+  MemoryWatermarkEvent& e = slot.event;
+  const char* op_name = currentOpName();
+  if (op_name != nullptr) {
+    strncpy(e.op_name, op_name, sizeof(e.op_name) - 1);
+    e.op_name[sizeof(e.op_name) - 1] = '\0';
+  } else {
+    e.op_name[0] = '\0';
+  }
+  e.alloc_size = alloc_size;
+  e.total_allocated = total_allocated;
+  e.timestamp_ns = now_ns();
+  e.device_type = device.type();
+  e.device_index = device.index();
+  slot.seq.store(2 * ticket + 2, std::memory_order_release);
+}
+
+// The default CPU allocator doesn't know allocation sizes at free time, so
+// we remember them in a fixed-size open-addressing table with lock-free
+// insert/erase. If an allocation doesn't find a free slot within the probe
+// limit it is simply not counted: undercounting a burst is preferable to
+// letting unmatched frees drift the running total.
+constexpr size_t kCPUSizeTableSize = 1 << 16; // must be a power of two
+constexpr size_t kCPUSizeTableMaxProbe = 16;
+
+struct CPUSizeSlot {
+  std::atomic<void*> ptr{nullptr};
+  size_t nbytes{0};
+};
+
+CPUSizeSlot* cpu_size_table() {
+  static CPUSizeSlot table[kCPUSizeTableSize];
+  return table;
+}
+
+size_t cpu_size_table_hash(void* ptr) {
+  // Allocations are at least cache-line aligned; drop the dead low bits.
+  return (reinterpret_cast<uintptr_t>(ptr) >> 6) & (kCPUSizeTableSize - 1);
+}
+
+std::atomic<int64_t>& cpu_total_allocated() {
+  static std::atomic<int64_t> total{0};
+  return total;
+}
+
+} // namespace
+
+void reportAllocation(
+    Device device,
+    int64_t alloc_size,
+    int64_t total_allocated) {
+  auto& mark = watermark(device.type(), device.index());
+  int64_t prev = mark.load(std::memory_order_relaxed);
+  while (total_allocated > prev) {
+    if (mark.compare_exchange_weak(
+            prev, total_allocated, std::memory_order_relaxed)) {
+      push_event(device, alloc_size, total_allocated);
+      return;
+    }
+    // prev was reloaded by compare_exchange_weak; retry unless another
+    // thread has already raised the mark past us.
+  }
+}
+
+void reportCPUAllocation(void* ptr, size_t nbytes) {
+  if (ptr == nullptr || nbytes == 0) {
+    return;
+  }
+  auto* table = cpu_size_table();
+  const size_t start = cpu_size_table_hash(ptr);
+  for (size_t i = 0; i < kCPUSizeTableMaxProbe; i++) {
+    CPUSizeSlot& slot = table[(start + i) & (kCPUSizeTableSize - 1)];
+    void* expected = nullptr;
+    if (slot.ptr.compare_exchange_strong(
+            expected, ptr, std::memory_order_acq_rel)) {
+      // Writing nbytes after claiming the slot is safe: the matching free
+      // happens-after this allocation returns (the pointer has to be handed
+      // to whoever frees it), so the free always observes this store.
+      slot.nbytes = nbytes;
+      auto total = cpu_total_allocated().fetch_add(
+                       nbytes, std::memory_order_relaxed) +
+          static_cast<int64_t>(nbytes);
+      reportAllocation(
+          Device(DeviceType::CPU), static_cast<int64_t>(nbytes), total);
+      return;
+    }
+  }
+  // Table is locally full: leave this allocation out of the total.
+}
+
+void reportCPUDeallocation(void* ptr) {
+  if (ptr == nullptr) {
+    return;
+  }
+  auto* table = cpu_size_table();
+  const size_t start = cpu_size_table_hash(ptr);
+  for (size_t i = 0; i < kCPUSizeTableMaxProbe; i++) {
+    CPUSizeSlot& slot = table[(start + i) & (kCPUSizeTableSize - 1)];
+    if (slot.ptr.load(std::memory_order_acquire) == ptr) {
+      auto nbytes = slot.nbytes;
+      slot.ptr.store(nullptr, std::memory_order_release);
+      cpu_total_allocated().fetch_sub(nbytes, std::memory_order_relaxed);
+      return;
+    }
+  }
+  // Not tracked (table was full at allocation time); nothing to undo.
+}
+
+std::vector<MemoryWatermarkEvent> snapshot() {
+  auto& r = ring();
+  std::vector<MemoryWatermarkEvent> events;
+  events.reserve(kRingSize);
+  const uint64_t head = r.next_ticket.load(std::memory_order_acquire);
+  // Walk the ring oldest-first: the oldest live slot is the one the next
+  // ticket would overwrite.
+  for (size_t i = 0; i < kRingSize; i++) {
+    RingSlot& slot = r.slots[(head + i) & (kRingSize - 1)];
+    const uint64_t seq_before = slot.seq.load(std::memory_order_acquire);
+    if (seq_before == 0 || (seq_before & 1) != 0) {
+      // Never written, or a write is in flight.
+      continue;
+    }
+    MemoryWatermarkEvent event = slot.event;
+    if (slot.seq.load(std::memory_order_acquire) != seq_before) {
+      // Overwritten while we copied; drop the torn event.
+      continue;
+    }
+    events.push_back(event);
+  }
+  return events;
+}
+
+void reset() {
+  auto& r = ring();
+  for (auto& slot : r.slots) {
+    slot.seq.store(0, std::memory_order_relaxed);
+  }
+  for (const auto type_idx :
+       c10::irange(static_cast<size_t>(
+           DeviceType::COMPILE_TIME_MAX_DEVICE_TYPES))) {
+    for (const auto device_idx : c10::irange(kMaxDeviceIndex)) {
+      watermark(
+          static_cast<DeviceType>(type_idx),
+          static_cast<DeviceIndex>(device_idx))
+          .store(0, std::memory_order_relaxed);
+    }
+  }
+}
+
+#if defined(_MSC_VER) || defined(C10_ANDROID) || defined(C10_IPHONE)
+static thread_local const char* tls_current_op_name = nullptr;
+
+const char* currentOpName() {
+  return tls_current_op_name;
+}
+
+const char* swapCurrentOpName(const char* name) {
+  const char* prev = tls_current_op_name;
+  tls_current_op_name = name;
+  return prev;
+}
+#else // defined(_MSC_VER) || defined(C10_ANDROID) || defined(C10_IPHONE)
+thread_local const char* tls_current_op_name = nullptr;
+#endif // defined(_MSC_VER) || defined(C10_ANDROID) || defined(C10_IPHONE)
+
+} // namespace memory_watermark
+} // namespace c10
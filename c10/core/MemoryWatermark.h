@@ -0,0 +1,93 @@
+#pragma once
+
+#include <c10/core/Device.h>
+#include <c10/macros/Macros.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace c10 {
+
+// A single high-water-mark event. See Note [Memory watermark ring buffer]
+// in MemoryWatermark.cpp.
+struct C10_API MemoryWatermarkEvent {
+  // Name of the operator being dispatched on the allocating thread
+  // (truncated, always '\0'-terminated); empty when the allocation happened
+  // outside of any operator.
+  char op_name[64];
+  // Size of the allocation that set the new high-water mark.
+  int64_t alloc_size;
+  // Total allocated bytes on the device after the allocation, i.e. the new
+  // high-water mark.
+  int64_t total_allocated;
+  // Wall-clock timestamp in nanoseconds since the unix epoch.
+  int64_t timestamp_ns;
+  DeviceType device_type;
+  DeviceIndex device_index;
+};
+
+namespace memory_watermark {
+
+// Feed an allocation from an allocator that tracks its own running total
+// (e.g. the CUDA caching allocator). Records an event if total_allocated is
+// a new high-water mark for the device. Lock-free; safe to call from any
+// thread.
+C10_API void reportAllocation(
+    Device device,
+    int64_t alloc_size,
+    int64_t total_allocated);
+
+// Feed allocations from the default CPU allocator, which does not track a
+// running total of its own. The total is maintained internally in a
+// fixed-size lock-free pointer-to-size table; allocations that don't fit in
+// the table are left out of the total rather than allowed to skew it.
+C10_API void reportCPUAllocation(void* ptr, size_t nbytes);
+C10_API void reportCPUDeallocation(void* ptr);
+
+// Copies out the recorded high-water-mark events, oldest first. Events being
+// overwritten concurrently are skipped.
+C10_API std::vector<MemoryWatermarkEvent> snapshot();
+
+// Discards recorded events and resets the per-device high-water marks, so
+// that subsequent allocations record fresh events.
+C10_API void reset();
+
+// thread_local variables cannot be C10_API on Windows.
+#if defined(_MSC_VER) || defined(C10_ANDROID) || defined(C10_IPHONE)
+C10_API const char* currentOpName();
+C10_API const char* swapCurrentOpName(const char* name);
+#else // defined(_MSC_VER) || defined(C10_ANDROID) || defined(C10_IPHONE)
+extern C10_API thread_local const char* tls_current_op_name;
+
+inline const char* currentOpName() {
+  return tls_current_op_name;
+}
+
+inline const char* swapCurrentOpName(const char* name) {
+  const char* prev = tls_current_op_name;
+  tls_current_op_name = name;
+  return prev;
+}
+#endif // defined(_MSC_VER) || defined(C10_ANDROID) || defined(C10_IPHONE)
+
+// RAII guard installing `name` as the operator attribution for allocations
+// performed by the current thread. `name` must outlive the guard; the
+// dispatcher passes the interned operator name, which lives as long as the
+// operator is registered.
+struct ThreadOpNameGuard {
+  explicit ThreadOpNameGuard(const char* name)
+      : prev_(swapCurrentOpName(name)) {}
+  ThreadOpNameGuard(const ThreadOpNameGuard&) = delete;
+  ThreadOpNameGuard& operator=(const ThreadOpNameGuard&) = delete;
+  ThreadOpNameGuard(ThreadOpNameGuard&&) = delete;
+  ThreadOpNameGuard& operator=(ThreadOpNameGuard&&) = delete;
+  ~ThreadOpNameGuard() {
+    swapCurrentOpName(prev_);
+  }
+
+ private:
+  const char* prev_;
+};
+
+} // namespace memory_watermark
+} // namespace c10
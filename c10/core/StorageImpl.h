@@ -204,6 +204,19 @@ struct C10_API StorageImpl : public c10::intrusive_ptr_target {
     return received_cuda_;
   }
 
+  // Marks this storage as a candidate that higher layers (e.g. an inference
+  // cache manager registered as a CUDA allocator offload hook) may migrate
+  // off-device under memory pressure. The core does not act on this flag
+  // itself; whoever sets it is responsible for the migration and for
+  // repointing the storage before its data is used again.
+  void set_offloadable(bool offloadable) {
+    offloadable_ = offloadable;
+  }
+
+  bool offloadable() const {
+    return offloadable_;
+  }
+
  private:
   DataPtr data_ptr_;
   SymInt size_bytes_;
@@ -211,6 +224,8 @@ struct C10_API StorageImpl : public c10::intrusive_ptr_target {
   // Identifies that Storage was received from another process and doesn't have
   // local to process cuda memory allocation
   bool received_cuda_;
+  // See set_offloadable above
+  bool offloadable_ = false;
   Allocator* allocator_;
 };
 } // namespace c10
@@ -335,6 +335,12 @@ void TensorImpl::release_resources() {
 }
 
 void TensorImpl::destroy_pyobj_if_needed() {
+  // In lean eager mode no tensor ever owns a PyObject (init_pyobj
+  // refuses), so the destructor can skip the check; see
+  // Note [Lean eager mode].
+  if (impl::lean_eager_mode_enabled()) {
+    return;
+  }
   if (owns_pyobj()) {
     TORCH_INTERNAL_ASSERT(pyobj_interpreter_ != nullptr);
     TORCH_INTERNAL_ASSERT(pyobj_ != nullptr);
@@ -9,6 +9,7 @@
 #include <c10/core/SymIntArrayRef.h>
 #include <c10/core/TensorOptions.h>
 #include <c10/core/WrapDimMinimal.h>
+#include <c10/core/impl/LeanEagerMode.h>
 #include <c10/core/impl/LocalDispatchKeySet.h>
 #include <c10/core/impl/PyInterpreter.h>
 #include <c10/core/impl/SizesAndStrides.h>
@@ -539,11 +540,22 @@ struct C10_API TensorImpl : public c10::intrusive_ptr_target {
     return key_set_;
   }
 
+  // Note [Symbolic shapes and the sizes/strides fast path]
+  // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+  // Shape reads are on the hot path of every eager op, so the accessors
+  // below must compile down to a plain load for ordinary dense tensors.
+  // Although sizes_and_strides_ stores SymInt entries, we never test
+  // SymInt::is_symbolic() per element here: set_sym_sizes_and_strides()
+  // raises sizes_strides_policy_ to CustomSizes whenever symbolic entries
+  // are installed, so the single (well-predicted) policy branch that the
+  // accessors already pay subsumes the symbolic check.  The *_default()
+  // paths may therefore assume concrete integers and read the storage
+  // directly; this invariant is enforced with debug asserts below.
   /**
    * Return a reference to the sizes of this tensor.  This reference remains
    * valid as long as the tensor is live and not resized.
    */
-  IntArrayRef sizes() const {
+  C10_ALWAYS_INLINE IntArrayRef sizes() const {
     if (C10_UNLIKELY(
             sizes_strides_policy_ >=
             static_cast<uint8_t>(SizesStridesPolicy::CustomSizes))) {
@@ -568,7 +580,7 @@ struct C10_API TensorImpl : public c10::intrusive_ptr_target {
    * Return a reference to the strides of this tensor.  This reference remains
    * valid as long as the tensor is live and not restrided.
    */
-  IntArrayRef strides() const {
+  C10_ALWAYS_INLINE IntArrayRef strides() const {
     if (C10_UNLIKELY(
             sizes_strides_policy_ >=
             static_cast<uint8_t>(SizesStridesPolicy::CustomStrides))) {
@@ -584,7 +596,7 @@ struct C10_API TensorImpl : public c10::intrusive_ptr_target {
    * NOTE: if you know wrapping is unnecessary, do sizes()[d] instead; it will
    * be faster
    */
-  int64_t size(int64_t d) const {
+  C10_ALWAYS_INLINE int64_t size(int64_t d) const {
     if (C10_UNLIKELY(
             sizes_strides_policy_ >=
             static_cast<uint8_t>(SizesStridesPolicy::CustomSizes))) {
@@ -594,15 +606,18 @@ struct C10_API TensorImpl : public c10::intrusive_ptr_target {
     return sizes_and_strides_.size_at_unchecked(d).as_int_unchecked();
   }
 
-  c10::SymInt sym_size(int64_t d) const {
+  C10_ALWAYS_INLINE c10::SymInt sym_size(int64_t d) const {
     if (C10_UNLIKELY(
             sizes_strides_policy_ >=
             static_cast<uint8_t>(SizesStridesPolicy::CustomSizes))) {
       return sym_size_custom(d);
     }
     d = maybe_wrap_dim(d, dim(), /*wrap_scalar=*/false);
-    const auto sizes = this->sym_sizes();
-    return sizes[d];
+    // Read the storage directly instead of going through the virtual
+    // sym_sizes(); the policy branch above already ruled out the custom
+    // (and thus the symbolic) case.  See
+    // Note [Symbolic shapes and the sizes/strides fast path].
+    return sizes_and_strides_.size_at_unchecked(d);
   }
 
   /**
@@ -612,7 +627,7 @@ struct C10_API TensorImpl : public c10::intrusive_ptr_target {
    * NOTE: if you know wrapping is unnecessary, do sizes()[d] instead; it will
    * be faster
    */
-  int64_t stride(int64_t d) const {
+  C10_ALWAYS_INLINE int64_t stride(int64_t d) const {
     d = maybe_wrap_dim(d, dim(), false);
     if (C10_UNLIKELY(
             sizes_strides_policy_ >=
@@ -626,7 +641,7 @@ struct C10_API TensorImpl : public c10::intrusive_ptr_target {
    * Return the number of dimensions of this tensor.  Note that 0-dimension
    * represents a Tensor that is a Scalar, e.g., one that has a single element.
    */
-  int64_t dim() const {
+  C10_ALWAYS_INLINE int64_t dim() const {
     if (C10_UNLIKELY(
             sizes_strides_policy_ >=
             static_cast<uint8_t>(SizesStridesPolicy::CustomSizes))) {
@@ -643,7 +658,7 @@ struct C10_API TensorImpl : public c10::intrusive_ptr_target {
    * is no longer true; numel always accurately reports the product
    * of sizes of a tensor.
    */
-  int64_t numel() const {
+  C10_ALWAYS_INLINE int64_t numel() const {
     if (C10_UNLIKELY(
             sizes_strides_policy_ >=
             static_cast<uint8_t>(SizesStridesPolicy::CustomSizes))) {
@@ -670,12 +685,18 @@ struct C10_API TensorImpl : public c10::intrusive_ptr_target {
   }
 
   inline IntArrayRef strides_default() const {
+    // See Note [Symbolic shapes and the sizes/strides fast path]; the
+    // reinterpret_cast below is only valid for concrete integers.
+    TORCH_INTERNAL_ASSERT_DEBUG_ONLY(!has_symbolic_sizes_strides_);
     return c10::IntArrayRef(
         reinterpret_cast<const int64_t*>(sizes_and_strides_.strides_data()),
         sizes_and_strides_.size());
   }
 
   inline IntArrayRef sizes_default() const {
+    // See Note [Symbolic shapes and the sizes/strides fast path]; the
+    // reinterpret_cast below is only valid for concrete integers.
+    TORCH_INTERNAL_ASSERT_DEBUG_ONLY(!has_symbolic_sizes_strides_);
     return c10::IntArrayRef(
         reinterpret_cast<const int64_t*>(sizes_and_strides_.sizes_data()),
         sizes_and_strides_.size());
@@ -1480,6 +1501,43 @@ struct C10_API TensorImpl : public c10::intrusive_ptr_target {
     refresh_contiguous();
   }
 
+  /**
+   * Like set_sizes_and_strides, but requires non-negative strides and
+   * consults the geometry interning table so that recurring out-of-line
+   * geometries share one immutable record instead of allocating per
+   * tensor. Used on hot view-creation paths (setStrided); see
+   * Note [Geometry interning] in c10/core/impl/SizesAndStrides.cpp.
+   *
+   * WARNING: This function does not check if the requested
+   * sizes/strides are in bounds for the storage that is allocated;
+   * this is the responsibility of the caller
+   */
+  void set_sizes_and_strides_interned(
+      IntArrayRef new_size,
+      IntArrayRef new_stride) {
+    TORCH_CHECK(
+        allow_tensor_metadata_change(),
+        "set_sizes_and_strides_interned ",
+        err_msg_tensor_metadata_change_not_allowed);
+    TORCH_CHECK(
+        !has_symbolic_sizes_strides_,
+        "set_sizes_and_strides_interned() called on tensor with symbolic shape")
+    TORCH_CHECK(
+        new_size.size() == new_stride.size(),
+        "dimensionality of sizes (",
+        new_size.size(),
+        ") must match dimensionality of strides (",
+        new_stride.size(),
+        ")");
+
+    sizes_and_strides_.set_interned_sizes_and_strides(
+        SymIntArrayRef::fromIntArrayRef(new_size),
+        SymIntArrayRef::fromIntArrayRef(new_stride));
+
+    refresh_numel();
+    refresh_contiguous();
+  }
+
   /**
    * Set whether a tensor allows changes to its metadata (e.g. sizes / strides /
    * storage / storage_offset). See NOTE [ Metadata Change for a Detached Tensor
@@ -1515,6 +1573,10 @@ struct C10_API TensorImpl : public c10::intrusive_ptr_target {
    */
   void set_named_tensor_meta(
       std::unique_ptr<c10::NamedTensorMetaInterface> named_tensor_meta) {
+    TORCH_CHECK(
+        !named_tensor_meta || !impl::lean_eager_mode_enabled(),
+        "cannot create named tensors while lean eager mode is enabled; "
+        "see Note [Lean eager mode]");
     TORCH_WARN_ONCE(
         "Named tensors and all their associated APIs are an experimental feature ",
         "and subject to change. Please do not use them for anything important ",
@@ -1706,6 +1768,10 @@ struct C10_API TensorImpl : public c10::intrusive_ptr_target {
       impl::PyInterpreter* self_interpreter,
       PyObject* pyobj,
       c10::impl::PyInterpreterStatus status) {
+    TORCH_CHECK(
+        !impl::lean_eager_mode_enabled(),
+        "cannot associate a PyObject with a tensor while lean eager mode is "
+        "enabled; see Note [Lean eager mode]");
     impl::PyInterpreter* expected = nullptr;
     switch (status) {
       case impl::PyInterpreterStatus::DEFINITELY_UNINITIALIZED:
@@ -0,0 +1,35 @@
+#include <c10/core/impl/LeanEagerMode.h>
+#include <c10/util/Exception.h>
+
+#include <atomic>
+
+namespace c10 {
+namespace impl {
+
+#ifndef C10_LEAN_EAGER
+namespace {
+
+// Process-wide, not thread-local: the promise is about what the whole
+// binary does, and a relaxed load keeps the hot-path check to a single
+// non-serializing instruction.
+std::atomic<bool> lean_eager_mode{false};
+
+} // namespace
+
+bool lean_eager_mode_enabled() {
+  return lean_eager_mode.load(std::memory_order_relaxed);
+}
+#endif
+
+void set_lean_eager_mode_enabled(bool enabled) {
+#ifdef C10_LEAN_EAGER
+  TORCH_CHECK(
+      enabled,
+      "this build was compiled with C10_LEAN_EAGER; lean eager mode cannot be disabled");
+#else
+  lean_eager_mode.store(enabled, std::memory_order_relaxed);
+#endif
+}
+
+} // namespace impl
+} // namespace c10
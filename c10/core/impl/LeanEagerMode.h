@@ -0,0 +1,39 @@
+#pragma once
+
+#include <c10/macros/Macros.h>
+
+namespace c10 {
+namespace impl {
+
+// Note [Lean eager mode]
+// ~~~~~~~~~~~~~~~~~~~~~~
+// Pure C++ deployments that never create Python tensor objects or named
+// tensors still pay for the hooks supporting them on every op: name
+// inference probes each operand when a TensorIterator is built, and each
+// TensorImpl destructor checks whether a PyObject must be released.
+// Lean eager mode is a process-wide promise that neither feature is
+// used, letting those hooks exit immediately. It can be enabled at
+// runtime via set_lean_eager_mode_enabled(true), or baked into the
+// build by defining C10_LEAN_EAGER (in the spirit of C10_MOBILE), in
+// which case the checks compile out entirely.
+//
+// The promise is enforced: creating a named tensor or initializing a
+// tensor's PyObject while lean eager mode is enabled raises an error,
+// so a misconfigured deployment fails loudly instead of silently
+// dropping names or leaking PyObjects. Enable it at process startup,
+// before any tensors exist — the enforcement only covers associations
+// made after the flag is set.
+
+#ifdef C10_LEAN_EAGER
+constexpr inline bool lean_eager_mode_enabled() {
+  return true;
+}
+#else
+C10_API bool lean_eager_mode_enabled();
+#endif
+
+// In C10_LEAN_EAGER builds this only accepts `true`.
+C10_API void set_lean_eager_mode_enabled(bool enabled);
+
+} // namespace impl
+} // namespace c10
@@ -1,8 +1,135 @@
 #include <c10/core/impl/SizesAndStrides.h>
 
+#include <atomic>
+
 namespace c10 {
 namespace impl {
 
+// Note [Geometry interning]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+// Workloads that stamp out many views of the same high-dimensional tensor
+// pay a malloc/free plus a 2*ndim*8-byte copy for every TensorImpl whose
+// geometry spills out of the 5-dim inline buffer. Since the set of
+// distinct (sizes, strides) pairs in such programs is tiny, we hash-cons
+// out-of-line geometries: set_interned_sizes_and_strides() looks the pair
+// up in a global lock-free table and, on a hit, stores a pointer to the
+// shared immutable record instead of allocating. The top bit of size_
+// tags the instance as interned (see kInternedBit in the header), which
+// makes copies pointer-sized and destruction free.
+//
+// Records are immortal: they are CAS-published into a fixed-size
+// open-addressed table and never removed, so readers need no reference
+// counting and no fences beyond acquire on the slot load. The table is
+// deliberately small; once it fills up (or a probe window is exhausted)
+// further geometries simply fall back to owned storage, bounding the
+// leak at kInternTableSize records. Mutation of an interned instance
+// (resize, non-const data access) first materializes an owned copy, so
+// records stay immutable.
+//
+// Inline geometries (ndim <= 5) are already allocation-free and are
+// stored as before; interning applies only to the out-of-line case.
+
+namespace {
+
+struct GeometryRecord {
+  size_t ndim;
+  // 2 * ndim SymInts follow: [sizes..., strides...], the same layout as
+  // owned out-of-line storage, so the const accessors work unchanged.
+  SymInt* data() noexcept {
+    return reinterpret_cast<SymInt*>(this + 1);
+  }
+};
+
+constexpr size_t kInternTableSize = 2048;
+constexpr size_t kInternMaxProbe = 8;
+
+std::atomic<GeometryRecord*> intern_table[kInternTableSize];
+
+uint64_t hashGeometry(
+    SymIntArrayRef sizes,
+    SymIntArrayRef strides) noexcept {
+  uint64_t h = 0xcbf29ce484222325ULL;
+  auto mix = [&h](uint64_t v) {
+    for (size_t byte = 0; byte < sizeof(v); ++byte) {
+      h = (h ^ ((v >> (byte * 8)) & 0xff)) * 0x100000001b3ULL;
+    }
+  };
+  mix(sizes.size());
+  for (const auto& s : sizes) {
+    mix(static_cast<uint64_t>(s.as_int_unchecked()));
+  }
+  for (const auto& s : strides) {
+    mix(static_cast<uint64_t>(s.as_int_unchecked()));
+  }
+  return h;
+}
+
+bool recordMatches(
+    const GeometryRecord* record,
+    SymIntArrayRef sizes,
+    SymIntArrayRef strides) noexcept {
+  if (record->ndim != sizes.size()) {
+    return false;
+  }
+  const SymInt* data = const_cast<GeometryRecord*>(record)->data();
+  for (size_t i = 0; i < sizes.size(); ++i) {
+    if (data[i].as_int_unchecked() != sizes[i].as_int_unchecked()) {
+      return false;
+    }
+  }
+  for (size_t i = 0; i < strides.size(); ++i) {
+    if (data[sizes.size() + i].as_int_unchecked() !=
+        strides[i].as_int_unchecked()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Returns the shared record for (sizes, strides), inserting it if absent,
+// or nullptr when the probe window is exhausted (caller falls back to
+// owned storage).
+GeometryRecord* internGeometry(SymIntArrayRef sizes, SymIntArrayRef strides) {
+  const uint64_t hash = hashGeometry(sizes, strides);
+  GeometryRecord* fresh = nullptr;
+  for (size_t probe = 0; probe < kInternMaxProbe; ++probe) {
+    auto& slot = intern_table[(hash + probe) % kInternTableSize];
+    GeometryRecord* existing = slot.load(std::memory_order_acquire);
+    if (existing == nullptr) {
+      if (fresh == nullptr) {
+        fresh = static_cast<GeometryRecord*>(malloc(
+            sizeof(GeometryRecord) + 2 * sizes.size() * sizeof(SymInt)));
+        if (fresh == nullptr) {
+          return nullptr;
+        }
+        fresh->ndim = sizes.size();
+        memcpy(fresh->data(), sizes.data(), sizes.size() * sizeof(SymInt));
+        memcpy(
+            fresh->data() + sizes.size(),
+            strides.data(),
+            strides.size() * sizeof(SymInt));
+      }
+      GeometryRecord* expected = nullptr;
+      if (slot.compare_exchange_strong(
+              expected, fresh, std::memory_order_acq_rel)) {
+        // Published; the table now owns `fresh` forever.
+        return fresh;
+      }
+      // Lost the race; `expected` holds the winner. Keep `fresh` around
+      // in case a later probe slot is empty.
+      existing = expected;
+    }
+    if (recordMatches(existing, sizes, strides)) {
+      free(fresh);
+      return existing;
+    }
+  }
+  free(fresh);
+  return nullptr;
+}
+
+} // namespace
+
 void SizesAndStrides::resizeSlowPath(
     const size_t newSize,
     const size_t oldSize) {
@@ -76,5 +203,40 @@ void SizesAndStrides::resizeSlowPath(
   size_ = newSize;
 }
 
+void SizesAndStrides::materializeOutOfLineStorage() {
+  TORCH_INTERNAL_ASSERT_DEBUG_ONLY(isInterned());
+  const SymInt* shared = outOfLineStorage_;
+  size_ &= ~kInternedBit;
+  allocateOutOfLineStorage(size_);
+  memcpy(outOfLineStorage_, shared, storageBytes(size_));
+}
+
+void SizesAndStrides::set_interned_sizes_and_strides(
+    SymIntArrayRef newSizes,
+    SymIntArrayRef newStrides) {
+  TORCH_INTERNAL_ASSERT(newSizes.size() == newStrides.size());
+  const auto newSize = newSizes.size();
+  if (newSize <= C10_SIZES_AND_STRIDES_MAX_INLINE_SIZE) {
+    // Inline geometries are already allocation-free.
+    resize(newSize);
+    std::copy(newSizes.begin(), newSizes.end(), sizes_begin());
+    std::copy(newStrides.begin(), newStrides.end(), strides_begin());
+    return;
+  }
+  GeometryRecord* record = internGeometry(newSizes, newStrides);
+  if (C10_UNLIKELY(record == nullptr)) {
+    // Table contention or exhaustion; fall back to an owned copy.
+    resize(newSize);
+    std::copy(newSizes.begin(), newSizes.end(), sizes_begin());
+    std::copy(newStrides.begin(), newStrides.end(), strides_begin());
+    return;
+  }
+  if (!isInline()) {
+    freeOwnedStorage();
+  }
+  outOfLineStorage_ = record->data();
+  size_ = newSize | kInternedBit;
+}
+
 } // namespace impl
 } // namespace c10
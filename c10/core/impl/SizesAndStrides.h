@@ -23,6 +23,13 @@ namespace impl {
 // 1 size_t for the size
 // 5 eightbytes of inline sizes and 5 eightbytes of inline strides, OR pointer
 // to out-of-line array
+//
+// Out-of-line geometries can additionally be interned: the pointer then
+// refers to a shared immutable record from a global hash-consed table
+// instead of owned storage, flagged by the top bit of size_. Interned
+// metadata is copied by pointer and freed for free; any mutation first
+// materializes an owned copy. See Note [Geometry interning] in
+// SizesAndStrides.cpp.
 class C10_API SizesAndStrides {
  public:
   // TODO: different iterator types for sizes & strides to prevent
@@ -39,13 +46,16 @@ class C10_API SizesAndStrides {
 
   ~SizesAndStrides() {
     if (C10_UNLIKELY(!isInline())) {
-      free(outOfLineStorage_);
+      freeOwnedStorage();
     }
   }
 
   SizesAndStrides(const SizesAndStrides& rhs) : size_(rhs.size_) {
     if (C10_LIKELY(rhs.isInline())) {
       copyDataInline(rhs);
+    } else if (rhs.isInterned()) {
+      // Shared immutable record; copying the pointer is enough.
+      outOfLineStorage_ = rhs.outOfLineStorage_;
     } else {
       allocateOutOfLineStorage(size_);
       copyDataOutline(rhs);
@@ -58,14 +68,19 @@ class C10_API SizesAndStrides {
     }
     if (C10_LIKELY(rhs.isInline())) {
       if (C10_UNLIKELY(!isInline())) {
-        free(outOfLineStorage_);
+        freeOwnedStorage();
       }
       copyDataInline(rhs);
+    } else if (rhs.isInterned()) {
+      if (C10_UNLIKELY(!isInline())) {
+        freeOwnedStorage();
+      }
+      outOfLineStorage_ = rhs.outOfLineStorage_;
     } else {
-      if (isInline()) {
-        allocateOutOfLineStorage(rhs.size_);
+      if (isInline() || isInterned()) {
+        allocateOutOfLineStorage(rhs.size());
       } else {
-        resizeOutOfLineStorage(rhs.size_);
+        resizeOutOfLineStorage(rhs.size());
       }
       copyDataOutline(rhs);
     }
@@ -92,13 +107,14 @@ class C10_API SizesAndStrides {
     }
     if (C10_LIKELY(rhs.isInline())) {
       if (C10_UNLIKELY(!isInline())) {
-        free(outOfLineStorage_);
+        freeOwnedStorage();
       }
       copyDataInline(rhs);
     } else {
-      // They're outline. We're going to steal their vector.
+      // They're outline (owned or interned). We're going to steal their
+      // pointer.
       if (!isInline()) {
-        free(outOfLineStorage_);
+        freeOwnedStorage();
       }
       outOfLineStorage_ = rhs.outOfLineStorage_;
       rhs.outOfLineStorage_ = nullptr;
@@ -110,7 +126,14 @@ class C10_API SizesAndStrides {
   }
 
   size_t size() const noexcept {
-    return size_;
+    return size_ & ~kInternedBit;
+  }
+
+  // True when this instance references a shared record from the geometry
+  // interning table rather than owned storage. See
+  // Note [Geometry interning] in SizesAndStrides.cpp.
+  bool isInterned() const noexcept {
+    return (size_ & kInternedBit) != 0;
   }
 
   const SymInt* sizes_data() const noexcept {
@@ -141,6 +164,9 @@ class C10_API SizesAndStrides {
     if (C10_LIKELY(isInline())) {
       return &inlineStorage_[0];
     } else {
+      if (C10_UNLIKELY(isInterned())) {
+        materializeOutOfLineStorage();
+      }
       return &outOfLineStorage_[0];
     }
   }
@@ -191,6 +217,9 @@ class C10_API SizesAndStrides {
     if (C10_LIKELY(isInline())) {
       return &inlineStorage_[C10_SIZES_AND_STRIDES_MAX_INLINE_SIZE];
     } else {
+      if (C10_UNLIKELY(isInterned())) {
+        materializeOutOfLineStorage();
+      }
       return &outOfLineStorage_[size()];
     }
   }
@@ -207,6 +236,9 @@ class C10_API SizesAndStrides {
     if (C10_LIKELY(isInline())) {
       return &inlineStorage_[C10_SIZES_AND_STRIDES_MAX_INLINE_SIZE];
     } else {
+      if (C10_UNLIKELY(isInterned())) {
+        materializeOutOfLineStorage();
+      }
       return &outOfLineStorage_[size()];
     }
   }
@@ -261,11 +293,22 @@ class C10_API SizesAndStrides {
     return strides_data()[idx];
   }
 
+  // Sets sizes and strides in one shot, consulting the geometry interning
+  // table for out-of-line dimensionalities so that recurring geometries
+  // share one immutable record instead of each owning a heap copy. See
+  // Note [Geometry interning] in SizesAndStrides.cpp.
+  void set_interned_sizes_and_strides(
+      SymIntArrayRef newSizes,
+      SymIntArrayRef newStrides);
+
   void resize(size_t newSize) {
     const auto oldSize = size();
     if (newSize == oldSize) {
       return;
     }
+    if (C10_UNLIKELY(isInterned())) {
+      materializeOutOfLineStorage();
+    }
     if (C10_LIKELY(
             newSize <= C10_SIZES_AND_STRIDES_MAX_INLINE_SIZE && isInline())) {
       if (oldSize < newSize) {
@@ -286,10 +329,30 @@ class C10_API SizesAndStrides {
   void resizeSlowPath(size_t newSize, size_t oldSize);
 
  private:
+  // Top bit of size_ flags that outOfLineStorage_ points at a shared
+  // interned record rather than owned storage. Interned geometries always
+  // have more than C10_SIZES_AND_STRIDES_MAX_INLINE_SIZE dimensions, so a
+  // tagged size_ never looks inline.
+  static constexpr size_t kInternedBit = size_t(1)
+      << (sizeof(size_t) * 8 - 1);
+
   bool isInline() const noexcept {
     return size_ <= C10_SIZES_AND_STRIDES_MAX_INLINE_SIZE;
   }
 
+  // Replaces a reference to an interned record with an owned copy of its
+  // data; called before any mutation. Defined in SizesAndStrides.cpp.
+  void materializeOutOfLineStorage();
+
+  void freeOwnedStorage() noexcept {
+    TORCH_INTERNAL_ASSERT_DEBUG_ONLY(!isInline());
+    // Interned records are shared and immortal; only owned storage is
+    // ours to free.
+    if (C10_LIKELY(!isInterned())) {
+      free(outOfLineStorage_);
+    }
+  }
+
   void copyDataInline(const SizesAndStrides& rhs) {
     TORCH_INTERNAL_ASSERT_DEBUG_ONLY(rhs.isInline());
     memcpy(inlineStorage_, rhs.inlineStorage_, sizeof(inlineStorage_));
@@ -316,7 +379,7 @@ class C10_API SizesAndStrides {
   }
 
   void copyDataOutline(const SizesAndStrides& rhs) noexcept {
-    memcpy(outOfLineStorage_, rhs.outOfLineStorage_, storageBytes(rhs.size_));
+    memcpy(outOfLineStorage_, rhs.outOfLineStorage_, storageBytes(rhs.size()));
   }
 
   size_t size_;
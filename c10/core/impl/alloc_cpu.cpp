@@ -1,11 +1,18 @@
 #include <c10/core/impl/alloc_cpu.h>
 
 #include <c10/core/alignment.h>
+#include <c10/core/impl/cow_cpu.h>
 #include <c10/util/Flags.h>
 #include <c10/util/Logging.h>
 #include <c10/util/irange.h>
 #include <c10/util/numa.h>
 
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#include <atomic>
+#endif
+
 // TODO: rename flags to C10
 C10_DEFINE_bool(
     caffe2_cpu_allocator_do_zero_fill,
@@ -17,6 +24,19 @@ C10_DEFINE_bool(
     false,
     "If set, fill memory with deterministic junk when allocating on CPU");
 
+C10_DEFINE_bool(
+    caffe2_cpu_allocator_use_hugepages,
+    false,
+    "If set, advise the kernel to back large CPU allocations with "
+    "transparent huge pages to reduce dTLB misses (Linux only)");
+
+C10_DEFINE_bool(
+    caffe2_cpu_allocator_use_memfd,
+    false,
+    "If set, back large CPU allocations with an anonymous memfd so they "
+    "can be cloned copy-on-write for snapshotting (Linux only). See "
+    "Note [Memfd-backed CPU allocations and CoW snapshots]");
+
 namespace c10 {
 
 namespace {
@@ -41,6 +61,41 @@ void memset_junk(void* data, size_t num) {
   }
 }
 
+#ifdef __linux__
+// Allocations at least this large are advised to use huge pages; smaller
+// ones cannot span a 2MB huge page, so madvise would be pure overhead.
+constexpr size_t kHugePageThreshold = 2 * 1024 * 1024;
+
+std::atomic<size_t> g_hugepage_eligible_bytes{0};
+std::atomic<size_t> g_hugepage_advised_bytes{0};
+
+// Ask the kernel to back the allocation with transparent huge pages.
+// posix_memalign only guarantees gAlignment, so only the page-aligned
+// interior of the allocation can be advised. This is best effort: madvise
+// fails (and we fall back to regular pages) when THP is disabled in the
+// kernel, and even on success the kernel may not assemble huge pages until
+// khugepaged gets around to it.
+void advise_hugepages(void* data, size_t nbytes) {
+  if (nbytes < kHugePageThreshold) {
+    return;
+  }
+  g_hugepage_eligible_bytes.fetch_add(nbytes, std::memory_order_relaxed);
+  static const size_t page_size = sysconf(_SC_PAGESIZE);
+  uintptr_t begin = reinterpret_cast<uintptr_t>(data);
+  uintptr_t end = begin + nbytes;
+  begin = (begin + page_size - 1) & ~(page_size - 1);
+  end = end & ~(page_size - 1);
+  if (begin >= end) {
+    return;
+  }
+  if (madvise(reinterpret_cast<void*>(begin), end - begin, MADV_HUGEPAGE) ==
+      0) {
+    g_hugepage_advised_bytes.fetch_add(
+        end - begin, std::memory_order_relaxed);
+  }
+}
+#endif
+
 } // namespace
 
 void* alloc_cpu(size_t nbytes) {
@@ -56,6 +111,19 @@ void* alloc_cpu(size_t nbytes) {
 
   // NOLINTNEXTLINE(cppcoreguidelines-init-variables)
   void* data;
+#ifdef __linux__
+  if (FLAGS_caffe2_cpu_allocator_use_memfd) {
+    data = impl::try_memfd_alloc(nbytes);
+    if (data != nullptr) {
+      // Fresh memfd pages are already zeroed by the kernel.
+      NUMAMove(data, nbytes, GetCurrentNUMANode());
+      if (FLAGS_caffe2_cpu_allocator_do_junk_fill) {
+        memset_junk(data, nbytes);
+      }
+      return data;
+    }
+  }
+#endif
 #ifdef __ANDROID__
   data = memalign(gAlignment, nbytes);
   CAFFE_ENFORCE(
@@ -83,6 +151,12 @@ void* alloc_cpu(size_t nbytes) {
       ")");
 #endif
 
+#ifdef __linux__
+  if (FLAGS_caffe2_cpu_allocator_use_hugepages) {
+    advise_hugepages(data, nbytes);
+  }
+#endif
+
   // move data to a thread's NUMA node
   NUMAMove(data, nbytes, GetCurrentNUMANode());
   CHECK(
@@ -98,7 +172,28 @@ void* alloc_cpu(size_t nbytes) {
   return data;
 }
 
+size_t hugepage_eligible_bytes() {
+#ifdef __linux__
+  return g_hugepage_eligible_bytes.load(std::memory_order_relaxed);
+#else
+  return 0;
+#endif
+}
+
+size_t hugepage_advised_bytes() {
+#ifdef __linux__
+  return g_hugepage_advised_bytes.load(std::memory_order_relaxed);
+#else
+  return 0;
+#endif
+}
+
 void free_cpu(void* data) {
+#ifdef __linux__
+  if (impl::try_memfd_free(data)) {
+    return;
+  }
+#endif
 #ifdef _MSC_VER
   _aligned_free(data);
 #else
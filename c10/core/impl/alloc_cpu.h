@@ -9,4 +9,11 @@ namespace c10 {
 C10_API void* alloc_cpu(size_t nbytes);
 C10_API void free_cpu(void* data);
 
+// Running totals for --caffe2_cpu_allocator_use_hugepages: bytes in
+// allocations large enough to be huge page candidates, and the subset the
+// kernel accepted MADV_HUGEPAGE for. Both are zero off Linux or when the
+// flag is unset.
+C10_API size_t hugepage_eligible_bytes();
+C10_API size_t hugepage_advised_bytes();
+
 } // namespace c10
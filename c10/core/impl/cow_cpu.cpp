@@ -0,0 +1,242 @@
+#include <c10/core/impl/cow_cpu.h>
+
+#include <c10/util/Logging.h>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+
+#ifndef MFD_CLOEXEC
+#define MFD_CLOEXEC 0x0001U
+#endif
+#endif
+
+namespace c10 {
+namespace impl {
+
+#ifdef __linux__
+
+namespace {
+
+// Per-tensor memfds are wasteful for small buffers; snapshotting targets
+// model-sized storages anyway.
+constexpr size_t kMemfdAllocThreshold = 1024 * 1024;
+
+struct MemfdRegion {
+  int fd;
+  size_t mapped_size; // page-rounded; what mmap/munmap use
+  // True once the source mapping has been flipped to MAP_PRIVATE by a
+  // snapshot; the file then stops tracking the live buffer.
+  bool frozen;
+};
+
+std::mutex& regions_mutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+// Source allocations by base pointer.
+std::unordered_map<void*, MemfdRegion>& regions() {
+  static auto* map = new std::unordered_map<void*, MemfdRegion>();
+  return *map;
+}
+
+// Snapshot mappings by base pointer, with their page-rounded sizes.
+std::unordered_map<void*, size_t>& snapshots() {
+  static auto* map = new std::unordered_map<void*, size_t>();
+  return *map;
+}
+
+// Lets try_memfd_free skip taking the lock while no memfd allocations are
+// live, which is the common case.
+std::atomic<size_t> g_live_regions{0};
+
+size_t page_round_up(size_t nbytes) {
+  static const size_t page_size = sysconf(_SC_PAGESIZE);
+  return (nbytes + page_size - 1) & ~(page_size - 1);
+}
+
+int create_memfd() {
+#ifdef SYS_memfd_create
+  return static_cast<int>(
+      syscall(SYS_memfd_create, "pytorch_cpu_alloc", MFD_CLOEXEC));
+#else
+  errno = ENOSYS;
+  return -1;
+#endif
+}
+
+// Creates a new memfd generation holding the current contents of `data`
+// and returns its fd, or -1 on failure. Costs a full copy; only needed
+// when an already-frozen allocation is snapshotted again.
+int materialize_generation(const void* data, size_t mapped_size) {
+  int fd = create_memfd();
+  if (fd < 0) {
+    return -1;
+  }
+  if (ftruncate(fd, mapped_size) != 0) {
+    close(fd);
+    return -1;
+  }
+  void* staging =
+      mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (staging == MAP_FAILED) {
+    close(fd);
+    return -1;
+  }
+  memcpy(staging, data, mapped_size);
+  munmap(staging, mapped_size);
+  return fd;
+}
+
+} // namespace
+
+void* try_memfd_alloc(size_t nbytes) {
+  if (nbytes < kMemfdAllocThreshold) {
+    return nullptr;
+  }
+  const size_t mapped_size = page_round_up(nbytes);
+  int fd = create_memfd();
+  if (fd < 0) {
+    return nullptr;
+  }
+  if (ftruncate(fd, mapped_size) != 0) {
+    close(fd);
+    return nullptr;
+  }
+  void* data =
+      mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (data == MAP_FAILED) {
+    close(fd);
+    return nullptr;
+  }
+  {
+    std::lock_guard<std::mutex> lock(regions_mutex());
+    regions().emplace(data, MemfdRegion{fd, mapped_size, /*frozen=*/false});
+  }
+  g_live_regions.fetch_add(1, std::memory_order_relaxed);
+  return data;
+}
+
+bool try_memfd_free(void* data) {
+  if (g_live_regions.load(std::memory_order_relaxed) == 0) {
+    return false;
+  }
+  MemfdRegion region;
+  {
+    std::lock_guard<std::mutex> lock(regions_mutex());
+    auto it = regions().find(data);
+    if (it == regions().end()) {
+      return false;
+    }
+    region = it->second;
+    regions().erase(it);
+  }
+  g_live_regions.fetch_sub(1, std::memory_order_relaxed);
+  munmap(data, region.mapped_size);
+  // Outstanding snapshot mappings keep the file alive past the close.
+  close(region.fd);
+  return true;
+}
+
+void* memfd_cow_snapshot(void* data) {
+  std::lock_guard<std::mutex> lock(regions_mutex());
+  auto it = regions().find(data);
+  if (it == regions().end()) {
+    return nullptr;
+  }
+  MemfdRegion& region = it->second;
+  if (region.frozen) {
+    // The file is stale once the source went private; start a fresh
+    // generation from the live contents. Older snapshots keep the old fd's
+    // pages alive through their own mappings.
+    int fd = materialize_generation(data, region.mapped_size);
+    if (fd < 0) {
+      return nullptr;
+    }
+    if (mmap(
+            data,
+            region.mapped_size,
+            PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_FIXED,
+            fd,
+            0) == MAP_FAILED) {
+      close(fd);
+      return nullptr;
+    }
+    close(region.fd);
+    region.fd = fd;
+  } else {
+    // Freeze: replace the shared source mapping in place by a private one
+    // of the same file. Contents are identical and live pointers stay
+    // valid; from here on source writes fault into private pages instead
+    // of reaching the file.
+    if (mmap(
+            data,
+            region.mapped_size,
+            PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_FIXED,
+            region.fd,
+            0) == MAP_FAILED) {
+      return nullptr;
+    }
+    region.frozen = true;
+  }
+  void* snapshot = mmap(
+      nullptr,
+      region.mapped_size,
+      PROT_READ | PROT_WRITE,
+      MAP_PRIVATE,
+      region.fd,
+      0);
+  if (snapshot == MAP_FAILED) {
+    return nullptr;
+  }
+  snapshots().emplace(snapshot, region.mapped_size);
+  return snapshot;
+}
+
+void delete_memfd_cow_snapshot(void* snapshot) {
+  if (snapshot == nullptr) {
+    return;
+  }
+  size_t mapped_size = 0;
+  {
+    std::lock_guard<std::mutex> lock(regions_mutex());
+    auto it = snapshots().find(snapshot);
+    TORCH_INTERNAL_ASSERT(
+        it != snapshots().end(),
+        "delete_memfd_cow_snapshot called on an unknown pointer");
+    mapped_size = it->second;
+    snapshots().erase(it);
+  }
+  munmap(snapshot, mapped_size);
+}
+
+#else // __linux__
+
+void* try_memfd_alloc(size_t /* nbytes */) {
+  return nullptr;
+}
+
+bool try_memfd_free(void* /* data */) {
+  return false;
+}
+
+void* memfd_cow_snapshot(void* /* data */) {
+  return nullptr;
+}
+
+void delete_memfd_cow_snapshot(void* /* snapshot */) {}
+
+#endif // __linux__
+
+} // namespace impl
+} // namespace c10
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <c10/macros/Macros.h>
+
+#include <cstddef>
+
+namespace c10 {
+namespace impl {
+
+// Note [Memfd-backed CPU allocations and CoW snapshots]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// When --caffe2_cpu_allocator_use_memfd is set, CPU allocations at least
+// kMemfdAllocThreshold bytes large are backed by an anonymous memfd mapped
+// MAP_SHARED instead of posix_memalign. Such an allocation can be cloned
+// copy-on-write: the source mapping is replaced in place by a MAP_PRIVATE
+// mapping of the same file (contents are identical, live pointers stay
+// valid) and the snapshot gets its own MAP_PRIVATE mapping. From then on
+// the file is effectively immutable; writes to either mapping fault
+// individual pages into private copies, so the snapshot costs O(page
+// tables) and physical copying is deferred to the pages actually written.
+//
+// Once the source has been remapped private, the file no longer tracks it;
+// a later snapshot of the same allocation first materializes a fresh memfd
+// generation with a full copy of the current contents (the cost of one
+// clone) and continues copy-on-write from there.
+//
+// Everything here is Linux only. On other platforms, and for pointers that
+// did not come from the memfd path, the snapshot entry points report
+// failure and callers fall back to a deep copy.
+
+// Tries to back an allocation of `nbytes` with a fresh memfd. Returns
+// nullptr (and the caller falls back to posix_memalign) when the size is
+// under threshold or any syscall fails.
+C10_API void* try_memfd_alloc(size_t nbytes);
+
+// Unmaps `data` if it came from try_memfd_alloc and returns true; returns
+// false (without touching it) otherwise, so free_cpu can fall through.
+C10_API bool try_memfd_free(void* data);
+
+// Returns a private copy-on-write mapping of the allocation starting at
+// `data`, or nullptr if `data` is not memfd-backed or the remap fails.
+C10_API void* memfd_cow_snapshot(void* data);
+
+// DataPtr-compatible deleter for pointers returned by memfd_cow_snapshot.
+C10_API void delete_memfd_cow_snapshot(void* snapshot);
+
+} // namespace impl
+} // namespace c10
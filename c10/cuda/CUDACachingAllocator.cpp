@@ -1,17 +1,41 @@
 
 #include <c10/cuda/CUDACachingAllocator.h>
 
+#include <c10/core/MemoryWatermark.h>
+#include <c10/core/StorageImpl.h>
+#include <c10/cuda/CUDAEventPool.h>
 #include <c10/cuda/CUDAException.h>
 #include <c10/cuda/CUDAFunctions.h>
 #include <c10/cuda/CUDAGuard.h>
+#include <c10/util/Type.h>
 #include <c10/util/UniqueVoidPtr.h>
 #include <c10/util/flat_hash_map.h>
 #include <c10/util/irange.h>
 #include <c10/util/llvmMathExtras.h>
 
 #include <cuda_runtime_api.h>
+
+#if !defined(USE_ROCM) && defined(__linux__) && defined(CUDART_VERSION) && \
+    CUDART_VERSION >= 11000
+#define PYTORCH_EXPANDABLE_SEGMENTS_SUPPORTED
+#include <cuda.h>
+#include <dlfcn.h>
+#endif
+
+#if !defined(USE_ROCM) && defined(CUDART_VERSION) && CUDART_VERSION >= 11040
+#define PYTORCH_CUDA_MALLOC_ASYNC_SUPPORTED
+#endif
+
+#if defined(__linux__) && !defined(__ANDROID__)
+#include <dlfcn.h>
+#include <execinfo.h>
+#endif
+
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <bitset>
+#include <condition_variable>
 #include <deque>
 #include <iterator>
 #include <map>
@@ -19,11 +43,14 @@
 #include <mutex>
 #include <regex>
 #include <set>
+#include <sstream>
+#include <thread>
 #include <vector>
 
 namespace c10 {
 
 C10_DEFINE_REGISTRY(FreeCudaMemoryCallbacksRegistry, FreeMemoryCallback);
+C10_DEFINE_REGISTRY(CudaOffloadHooksRegistry, OffloadHook);
 
 namespace cuda {
 namespace CUDACachingAllocator {
@@ -279,59 +306,9 @@ struct AllocParams {
   cudaError_t err;
 };
 
-// Note: cudaEventCreate when concurrently invoked from multiple threads can be
-// very expensive (at least on certain device/driver combinations). Thus, we a)
-// serialize event creation at a per-device level, and b) pool the events to
-// avoid constantly calling cudaEventCreate/cudaEventDestroy. This results in
-// significant improvements in multithreaded workloads with high allocation
-// rates.
-class EventPool {
- public:
-  using Event = std::unique_ptr<cudaEvent_t, std::function<void(cudaEvent_t*)>>;
-  // TODO: Explicit device count
-  EventPool() : pools_(at::cuda::device_count()) {}
-
-  Event get(int device) {
-    TORCH_INTERNAL_ASSERT(0 <= device);
-    TORCH_INTERNAL_ASSERT(device < static_cast<int>(pools_.size()));
-    auto& pool = pools_[device];
-    auto destructor = [&pool](cudaEvent_t* event) {
-      std::lock_guard<std::mutex> g(pool.mutex_);
-      pool.event_pool_.push_back(std::unique_ptr<cudaEvent_t>(event));
-    };
-
-    // Try to acquire an event from the per-device pool.
-    {
-      std::lock_guard<std::mutex> g(pool.mutex_);
-      if (!pool.event_pool_.empty()) {
-        auto* event = pool.event_pool_.back().release();
-        pool.event_pool_.pop_back();
-        return Event(event, destructor);
-      }
-    }
-    // otherwise, allocate a new event that will be returned to the pool on
-    // destruction.
-    auto new_ptr = std::make_unique<cudaEvent_t>();
-    C10_CUDA_CHECK(
-        cudaEventCreateWithFlags(new_ptr.get(), cudaEventDisableTiming));
-
-    return Event(new_ptr.release(), destructor);
-  }
-
-  void empty_cache() {
-    for (auto& pool : pools_) {
-      std::lock_guard<std::mutex> g(pool.mutex_);
-      pool.event_pool_.clear();
-    }
-  }
-
- private:
-  struct PerDevicePool {
-    alignas(64) std::mutex mutex_;
-    std::vector<std::unique_ptr<cudaEvent_t>> event_pool_;
-  };
-  std::vector<PerDevicePool> pools_;
-};
+// Events are recycled through the process-wide per-device pool shared with
+// the other stream-sync paths, see c10/cuda/CUDAEventPool.h.
+using EventPool = c10::cuda::CUDAEventPool;
 
 // CUDA graphs helper
 struct PrivatePool {
@@ -382,6 +359,172 @@ cudaError_t cudaMallocMaybeCapturing(void** p, size_t size) {
 #endif
 }
 
+#ifdef PYTORCH_EXPANDABLE_SEGMENTS_SUPPORTED
+
+// Minimal, lazily resolved slice of the CUDA driver virtual memory
+// management API. c10 cannot link against libcuda directly (it ships with
+// the driver, not the toolkit), so the handful of entry points needed by
+// ExpandableSegment are looked up in the already-loaded driver at runtime.
+// get() returns nullptr when the driver is unavailable or too old, in which
+// case expandable segments are silently disabled.
+struct DriverAPI {
+  // NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define C10_FORALL_DRIVER_API(_)  \
+  _(cuMemAddressReserve)          \
+  _(cuMemAddressFree)             \
+  _(cuMemCreate)                  \
+  _(cuMemRelease)                 \
+  _(cuMemMap)                     \
+  _(cuMemUnmap)                   \
+  _(cuMemSetAccess)               \
+  _(cuMemGetAllocationGranularity)\
+  _(cuGetErrorString)
+
+#define C10_DECLARE_DRIVER_ENTRY(name) decltype(&name) name##_ = nullptr;
+  C10_FORALL_DRIVER_API(C10_DECLARE_DRIVER_ENTRY)
+#undef C10_DECLARE_DRIVER_ENTRY
+
+  static DriverAPI* get() {
+    static DriverAPI* api = []() -> DriverAPI* {
+      // RTLD_NOLOAD: the runtime has already pulled in the driver on any
+      // machine where a CUDA context can exist.
+      void* handle = dlopen("libcuda.so.1", RTLD_LAZY | RTLD_NOLOAD);
+      if (!handle) {
+        return nullptr;
+      }
+      auto result = std::make_unique<DriverAPI>();
+#define C10_RESOLVE_DRIVER_ENTRY(name)                     \
+  result->name##_ = reinterpret_cast<decltype(&name)>(     \
+      dlsym(handle, #name));                               \
+  if (!result->name##_) {                                  \
+    return nullptr;                                        \
+  }
+      C10_FORALL_DRIVER_API(C10_RESOLVE_DRIVER_ENTRY)
+#undef C10_RESOLVE_DRIVER_ENTRY
+      return result.release();
+    }();
+    return api;
+  }
+};
+
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define C10_CUDA_DRIVER_CHECK(EXPR)                            \
+  do {                                                         \
+    CUresult __err = EXPR;                                     \
+    if (__err != CUDA_SUCCESS) {                               \
+      const char* err_str = nullptr;                           \
+      DriverAPI::get()->cuGetErrorString_(__err, &err_str);    \
+      TORCH_CHECK(                                             \
+          false,                                               \
+          "CUDA driver error: ",                               \
+          err_str ? err_str : "<unknown>");                    \
+    }                                                          \
+  } while (0)
+
+// A segment of device virtual address space whose physical backing can grow
+// in place. The constructor only reserves address space; map() commits
+// physical memory in allocation-granularity chunks at the end of the mapped
+// region. Because the segment's base address never changes, free blocks at
+// the tail of the segment can be extended to satisfy larger allocations
+// instead of carving a brand new segment out of the device, which is what
+// fragments memory with dynamic shapes.
+struct ExpandableSegment {
+  ExpandableSegment(int device, size_t reserve_size) : device_(device) {
+    CUmemAllocationProp prop = {};
+    prop.type = CU_MEM_ALLOCATION_TYPE_PINNED;
+    prop.location.type = CU_MEM_LOCATION_TYPE_DEVICE;
+    prop.location.id = device_;
+    auto* api = DriverAPI::get();
+    C10_CUDA_DRIVER_CHECK(api->cuMemGetAllocationGranularity_(
+        &granularity_, &prop, CU_MEM_ALLOC_GRANULARITY_MINIMUM));
+    reserve_size_ = round_up(reserve_size);
+    C10_CUDA_DRIVER_CHECK(api->cuMemAddressReserve_(
+        &ptr_, reserve_size_, 0ULL, 0, 0ULL));
+  }
+
+  ExpandableSegment(const ExpandableSegment&) = delete;
+  ExpandableSegment& operator=(const ExpandableSegment&) = delete;
+
+  char* ptr() const {
+    // NOLINTNEXTLINE(performance-no-int-to-ptr)
+    return reinterpret_cast<char*>(ptr_);
+  }
+
+  size_t mapped_size() const {
+    return handles_.size() * granularity_;
+  }
+
+  // Maps at least `size` additional bytes of physical memory at the end of
+  // the segment. Returns the number of bytes actually mapped (a granularity
+  // multiple), or 0 if the device is out of physical memory or the address
+  // reservation is exhausted.
+  size_t map(size_t size) {
+    size_t begin = mapped_size();
+    size_t end = begin + round_up(size);
+    if (end > reserve_size_) {
+      return 0;
+    }
+    CUmemAllocationProp prop = {};
+    prop.type = CU_MEM_ALLOCATION_TYPE_PINNED;
+    prop.location.type = CU_MEM_LOCATION_TYPE_DEVICE;
+    prop.location.id = device_;
+    auto* api = DriverAPI::get();
+    size_t num_new = (end - begin) / granularity_;
+    for (const auto i : c10::irange(num_new)) {
+      CUmemGenericAllocationHandle handle = 0;
+      CUresult err = api->cuMemCreate_(&handle, granularity_, &prop, 0ULL);
+      if (err == CUDA_ERROR_OUT_OF_MEMORY) {
+        // Roll back the chunks committed by this call and report failure so
+        // the caller can fall back to freeing cached blocks.
+        for (const auto j : c10::irange(i)) {
+          api->cuMemUnmap_(ptr_ + begin + j * granularity_, granularity_);
+          api->cuMemRelease_(handles_.back());
+          handles_.pop_back();
+        }
+        return 0;
+      }
+      C10_CUDA_DRIVER_CHECK(err);
+      C10_CUDA_DRIVER_CHECK(api->cuMemMap_(
+          ptr_ + begin + i * granularity_, granularity_, 0, handle, 0ULL));
+      handles_.push_back(handle);
+    }
+    CUmemAccessDesc desc = {};
+    desc.location.type = CU_MEM_LOCATION_TYPE_DEVICE;
+    desc.location.id = device_;
+    desc.flags = CU_MEM_ACCESS_FLAGS_PROT_READWRITE;
+    C10_CUDA_DRIVER_CHECK(
+        api->cuMemSetAccess_(ptr_ + begin, end - begin, &desc, 1));
+    return end - begin;
+  }
+
+  ~ExpandableSegment() {
+    auto* api = DriverAPI::get();
+    // Errors are ignored here deliberately: the destructor runs during
+    // emptyCache and process teardown, where the driver may already be
+    // shutting down.
+    if (!handles_.empty()) {
+      api->cuMemUnmap_(ptr_, mapped_size());
+      for (auto handle : handles_) {
+        api->cuMemRelease_(handle);
+      }
+    }
+    api->cuMemAddressFree_(ptr_, reserve_size_);
+  }
+
+ private:
+  size_t round_up(size_t size) const {
+    return ((size + granularity_ - 1) / granularity_) * granularity_;
+  }
+
+  int device_;
+  size_t granularity_{0};
+  size_t reserve_size_{0};
+  CUdeviceptr ptr_{0};
+  std::vector<CUmemGenericAllocationHandle> handles_;
+};
+
+#endif // PYTORCH_EXPANDABLE_SEGMENTS_SUPPORTED
+
 } // namespace
 
 class CachingAllocatorConfig {
@@ -401,6 +544,23 @@ class CachingAllocatorConfig {
     return instance().m_roundup_power2_divisions;
   }
 
+  // When true, large-pool segments are backed by the CUDA virtual memory
+  // management API and grow in place instead of new fixed-size cudaMalloc
+  // calls, which avoids fragmentation OOMs with dynamic shapes. Enabled
+  // with: PYTORCH_CUDA_ALLOC_CONF=expandable_segments:True
+  static bool expandable_segments() {
+    return instance().m_expandable_segments;
+  }
+
+  // When true, allocations are served by cudaMallocAsync from each device's
+  // default memory pool instead of the native caching pool, so PyTorch and
+  // other stream-ordered-allocation libraries (RAPIDS etc.) draw from one
+  // driver-managed pool. See Note [cudaMallocAsync backend]. Enabled with:
+  // PYTORCH_CUDA_ALLOC_CONF=backend:cudaMallocAsync
+  static bool use_cuda_malloc_async() {
+    return instance().m_use_cuda_malloc_async;
+  }
+
  private:
   static CachingAllocatorConfig& instance() {
     static CachingAllocatorConfig* s_instance = ([]() {
@@ -418,6 +578,8 @@ class CachingAllocatorConfig {
   size_t m_max_split_size;
   size_t m_roundup_power2_divisions;
   double m_garbage_collection_threshold;
+  bool m_expandable_segments{false};
+  bool m_use_cuda_malloc_async{false};
 
   void parseArgs() {
     const char* val = getenv("PYTORCH_CUDA_ALLOC_CONF");
@@ -473,6 +635,37 @@ class CachingAllocatorConfig {
                 "garbage_collect_threshold too big, set it 0.0~1.0",
                 "");
             m_garbage_collection_threshold = val2;
+          } else if (kv[0].compare("expandable_segments") == 0) {
+            TORCH_CHECK(
+                kv[1].compare("True") == 0 || kv[1].compare("False") == 0,
+                "Expected a value of True or False for expandable_segments, got ",
+                kv[1],
+                "");
+#ifdef PYTORCH_EXPANDABLE_SEGMENTS_SUPPORTED
+            m_expandable_segments = (kv[1].compare("True") == 0);
+#else
+            if (kv[1].compare("True") == 0) {
+              TORCH_WARN(
+                  "expandable_segments is not supported in this build "
+                  "(requires Linux and CUDA >= 11); option ignored");
+            }
+#endif
+          } else if (kv[0].compare("backend") == 0) {
+            TORCH_CHECK(
+                kv[1].compare("native") == 0 ||
+                    kv[1].compare("cudaMallocAsync") == 0,
+                "Expected native or cudaMallocAsync for backend, got ",
+                kv[1],
+                "");
+#ifdef PYTORCH_CUDA_MALLOC_ASYNC_SUPPORTED
+            m_use_cuda_malloc_async = (kv[1].compare("cudaMallocAsync") == 0);
+#else
+            if (kv[1].compare("cudaMallocAsync") == 0) {
+              TORCH_WARN(
+                  "backend:cudaMallocAsync is not supported in this build "
+                  "(requires CUDA >= 11.4); option ignored");
+            }
+#endif
           } else {
             TORCH_CHECK(false, "Unrecognized CachingAllocator option: ", kv[0]);
           }
@@ -482,6 +675,237 @@ class CachingAllocatorConfig {
   }
 };
 
+// Note [Allocator pressure signals]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The allocator's only native failure signal is CUDAOutOfMemoryError, which
+// arrives too late for a serving layer to do anything but drop the request.
+// PressureMonitor gives registered listeners an earlier, cheaper signal.
+// The allocation and free paths report the device's aggregate allocated
+// bytes while they already hold the device lock; the report is one relaxed
+// atomic load when nobody listens, and otherwise just notes when the
+// utilization moved to a different percent bucket and nudges the signal
+// thread. Everything with a real cost -- walking the pools for the largest
+// free block, evaluating threshold edges, running user callbacks -- happens
+// on that thread, never on the allocating one.
+//
+// The score listeners are compared against is 1 - largest contiguous free
+// chunk / allowed capacity: the fraction of capacity unavailable to a
+// single allocation. For an unfragmented pool this equals utilization, and
+// it rises toward 1 as the free space shatters, so a threshold on the
+// score catches both "nearly full" and "plenty free but in useless
+// pieces". Listeners fire on every crossing of their threshold, in either
+// direction, and receive the full reading.
+namespace {
+
+class PressureMonitor {
+ public:
+  static PressureMonitor& instance() {
+    // Leaky singleton: reports can arrive during program teardown.
+    static PressureMonitor* monitor = new PressureMonitor();
+    return *monitor;
+  }
+
+  uint64_t addListener(double threshold, PressureListener fn) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!thread_started_) {
+      std::thread([this] { run(); }).detach();
+      thread_started_ = true;
+    }
+    auto listener = std::make_shared<Listener>();
+    const uint64_t id = listener->id = next_id_++;
+    listener->threshold = threshold;
+    listener->fn = std::move(fn);
+    listeners_.push_back(std::move(listener));
+    armed_.store(true, std::memory_order_relaxed);
+    // Evaluate every known device once so a listener registered while
+    // pressure is already above its threshold hears about it now.
+    int device_count = 0;
+    if (C10_CUDA_ERROR_HANDLED(cudaGetDeviceCount(&device_count)) !=
+        cudaSuccess) {
+      cudaGetLastError();
+      device_count = 0;
+    }
+    for (int device = 0;
+         device < std::min(device_count, C10_COMPILE_TIME_MAX_GPUS);
+         device++) {
+      devices_[device].dirty = true;
+    }
+    pending_ = true;
+    lock.unlock();
+    cv_.notify_one();
+    return id;
+  }
+
+  void removeListener(uint64_t id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    listeners_.erase(
+        std::remove_if(
+            listeners_.begin(),
+            listeners_.end(),
+            [id](const std::shared_ptr<Listener>& l) { return l->id == id; }),
+        listeners_.end());
+    if (listeners_.empty()) {
+      armed_.store(false, std::memory_order_relaxed);
+    }
+  }
+
+  // Hot-path hook, called by the device allocator with its lock held after
+  // every allocation and free. allowed_bytes is the setMemoryFraction cap,
+  // or -1 when the whole device is allowed.
+  void report(int device, int64_t allocated_bytes, int64_t allowed_bytes) {
+    if (C10_LIKELY(!armed_.load(std::memory_order_relaxed))) {
+      return;
+    }
+    if (device < 0 || device >= C10_COMPILE_TIME_MAX_GPUS) {
+      return;
+    }
+    DeviceState& state = devices_[device];
+    state.allowed.store(allowed_bytes, std::memory_order_relaxed);
+    const int64_t capacity = allowed_bytes > 0
+        ? allowed_bytes
+        : state.total.load(std::memory_order_relaxed);
+    const int64_t bucket =
+        capacity > 0 ? allocated_bytes * 100 / capacity : -1;
+    if (bucket == state.last_bucket.exchange(bucket, std::memory_order_relaxed)) {
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      state.dirty = true;
+      pending_ = true;
+    }
+    cv_.notify_one();
+  }
+
+ private:
+  struct Listener {
+    uint64_t id = 0;
+    double threshold = 0;
+    PressureListener fn;
+    // Which side of the threshold each device was last seen on:
+    // -1 not yet evaluated, 0 below, 1 at or above. Only the signal
+    // thread touches this.
+    std::array<int8_t, C10_COMPILE_TIME_MAX_GPUS> side;
+    Listener() {
+      side.fill(-1);
+    }
+  };
+
+  struct DeviceState {
+    // Last reported setMemoryFraction cap; -1 means the whole device.
+    std::atomic<int64_t> allowed{-1};
+    // Total device memory, filled in by the signal thread.
+    std::atomic<int64_t> total{0};
+    std::atomic<int64_t> last_bucket{-1};
+    bool dirty = false; // guarded by mutex_
+  };
+
+  PressureMonitor() = default;
+
+  void run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      cv_.wait(lock, [this] { return pending_; });
+      pending_ = false;
+      std::array<bool, C10_COMPILE_TIME_MAX_GPUS> dirty{};
+      for (const auto device : c10::irange(C10_COMPILE_TIME_MAX_GPUS)) {
+        dirty[device] = devices_[device].dirty;
+        devices_[device].dirty = false;
+      }
+      auto listeners = listeners_;
+      lock.unlock();
+      for (const auto device : c10::irange(C10_COMPILE_TIME_MAX_GPUS)) {
+        if (!dirty[device]) {
+          continue;
+        }
+        PressureReading reading;
+        if (!computeReading(device, reading)) {
+          continue;
+        }
+        for (const auto& listener : listeners) {
+          const int8_t side = reading.score >= listener->threshold ? 1 : 0;
+          if (listener->side[device] == side) {
+            continue;
+          }
+          const bool first = listener->side[device] < 0;
+          listener->side[device] = side;
+          if (first && side == 0) {
+            // Nothing to announce: the listener starts out below threshold.
+            continue;
+          }
+          try {
+            listener->fn(reading);
+          } catch (const std::exception& e) {
+            TORCH_WARN("pressure listener raised: ", e.what());
+          }
+        }
+      }
+      lock.lock();
+    }
+  }
+
+  bool computeReading(int device, PressureReading& reading) {
+    DeviceState& state = devices_[device];
+    int64_t total = state.total.load(std::memory_order_relaxed);
+    if (total == 0) {
+      cudaDeviceProp prop{};
+      if (C10_CUDA_ERROR_HANDLED(cudaGetDeviceProperties(&prop, device)) !=
+          cudaSuccess) {
+        cudaGetLastError();
+        return false;
+      }
+      total = static_cast<int64_t>(prop.totalGlobalMem);
+      state.total.store(total, std::memory_order_relaxed);
+    }
+    const int64_t allowed = state.allowed.load(std::memory_order_relaxed);
+    const int64_t capacity = allowed > 0 ? allowed : total;
+    if (capacity <= 0) {
+      return false;
+    }
+
+    const DeviceStats stats = getDeviceStats(device);
+    const size_t agg = static_cast<size_t>(StatType::AGGREGATE);
+    reading.device = device;
+    reading.allocated_bytes =
+        static_cast<size_t>(std::max<int64_t>(stats.allocated_bytes[agg].current, 0));
+    reading.reserved_bytes =
+        static_cast<size_t>(std::max<int64_t>(stats.reserved_bytes[agg].current, 0));
+
+    size_t free_cached = 0;
+    size_t largest = 0;
+    {
+      // cacheInfo seeds `largest` from cudaMemGetInfo, which reads the
+      // current device.
+      CUDAGuard guard(device);
+      cacheInfo(device, &free_cached, &largest);
+    }
+    const int64_t free_total = std::max<int64_t>(
+        capacity - static_cast<int64_t>(reading.allocated_bytes), 0);
+    const int64_t largest_block =
+        std::min<int64_t>(static_cast<int64_t>(largest), free_total);
+    reading.largest_free_block = static_cast<size_t>(largest_block);
+    reading.utilization = std::min<double>(
+        static_cast<double>(reading.allocated_bytes) / capacity, 1.0);
+    reading.fragmentation = free_total > 0
+        ? 1.0 - static_cast<double>(largest_block) / free_total
+        : 0.0;
+    reading.score = 1.0 - static_cast<double>(largest_block) / capacity;
+    return true;
+  }
+
+  std::atomic<bool> armed_{false};
+  std::array<DeviceState, C10_COMPILE_TIME_MAX_GPUS> devices_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool pending_ = false;
+  bool thread_started_ = false;
+  uint64_t next_id_ = 1;
+  std::vector<std::shared_ptr<Listener>> listeners_;
+};
+
+} // namespace
+
 class DeviceCachingAllocator {
  private:
   // lock around all operations
@@ -515,6 +939,13 @@ class DeviceCachingAllocator {
   // record used memory.
   size_t total_allocated_memory = 0;
 
+#ifdef PYTORCH_EXPANDABLE_SEGMENTS_SUPPORTED
+  // Expandable segments owned by this device, keyed by segment base pointer.
+  // Populated only when PYTORCH_CUDA_ALLOC_CONF=expandable_segments:True.
+  ska::flat_hash_map<void*, std::unique_ptr<ExpandableSegment>>
+      expandable_segments_;
+#endif
+
   size_t allowed_memory_maximum = 0;
 
   bool set_fraction = false;
@@ -535,6 +966,10 @@ class DeviceCachingAllocator {
   // in case we want multiple captures to share the same pool
   ska::flat_hash_map<CaptureId_t, MempoolId_t> capture_to_pool_map;
 
+  // Maps a stream to the mempool_id of its private pool, if the user
+  // attached one. See Note [Per-stream memory pools].
+  ska::flat_hash_map<cudaStream_t, MempoolId_t> stream_to_pool_map;
+
  public:
   DeviceCachingAllocator()
       : large_blocks(BlockComparator, /*is_small=*/false),
@@ -585,7 +1020,11 @@ class DeviceCachingAllocator {
         garbage_collect_cached_blocks();
       }
       // Attempt allocate
-      block_found = alloc_block(params, false)
+      block_found =
+          // Grow an existing expandable segment in place (no-op unless
+          // expandable_segments:True)
+          try_expand_segment(params)
+          || alloc_block(params, false)
           // Free enough available cached blocks to satisfy alloc and retry
           // alloc.
           || (release_available_cached_blocks(params) &&
@@ -595,6 +1034,16 @@ class DeviceCachingAllocator {
               alloc_block(params, true));
     }
 
+    // Before giving up, let offload hooks spill opted-in storages (e.g. cold
+    // KV-cache blocks) to host memory, then retry the whole sequence once.
+    if (!block_found && C10_UNLIKELY(trigger_offload_hooks(params))) {
+      block_found = get_free_block(params) || alloc_block(params, false) ||
+          (release_available_cached_blocks(params) &&
+           alloc_block(params, false)) ||
+          (C10_LIKELY(captures_underway == 0) && release_cached_blocks() &&
+           alloc_block(params, true));
+    }
+
     if (!block_found) {
       // For any error code other than cudaErrorMemoryAllocation,
       // alloc_block should have thrown an exception already.
@@ -718,6 +1167,17 @@ class DeviceCachingAllocator {
     if (block->size >= CachingAllocatorConfig::max_split_size())
       update_stat(stats.oversize_allocations, 1);
 
+    c10::memory_watermark::reportAllocation(
+        c10::Device(c10::DeviceType::CUDA, device),
+        block->size,
+        stats.allocated_bytes[static_cast<size_t>(StatType::AGGREGATE)]
+            .current);
+
+    PressureMonitor::instance().report(
+        device,
+        stats.allocated_bytes[static_cast<size_t>(StatType::AGGREGATE)].current,
+        set_fraction ? static_cast<int64_t>(allowed_memory_maximum) : -1);
+
     c10::reportMemoryUsageToProfiler(
         block->ptr,
         block->size,
@@ -763,6 +1223,11 @@ class DeviceCachingAllocator {
       free_block(block);
     }
 
+    PressureMonitor::instance().report(
+        block->device,
+        stats.allocated_bytes[static_cast<size_t>(StatType::AGGREGATE)].current,
+        set_fraction ? static_cast<int64_t>(allowed_memory_maximum) : -1);
+
     c10::reportMemoryUsageToProfiler(
         orig_block_ptr,
         -orig_block_size,
@@ -813,6 +1278,39 @@ class DeviceCachingAllocator {
     release_cached_blocks();
   }
 
+  /** Decides whether the defragmentation pass should relocate `block`.
+   ** See Note [GPU defragmentation]. Relocation only pays off when it can
+   ** eventually vacate a whole segment, so we walk the segment the block
+   ** was split from and require it to be mostly dead. **/
+  bool shouldRelocate(Block* block) {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    if (captures_underway != 0) {
+      return false;
+    }
+    if (!block->allocated || block->event_count > 0 ||
+        !block->stream_uses.empty()) {
+      return false;
+    }
+    if (block->pool->owner_PrivatePool) {
+      // Graph-owned memory is baked into replayed capture addresses and can
+      // never move.
+      return false;
+    }
+    Block* head = block;
+    while (head->prev) {
+      head = head->prev;
+    }
+    size_t segment_size = 0;
+    size_t allocated_size = 0;
+    for (Block* b = head; b != nullptr; b = b->next) {
+      segment_size += b->size;
+      if (b->allocated) {
+        allocated_size += b->size;
+      }
+    }
+    return allocated_size * 2 <= segment_size;
+  }
+
   /** Retrieves info (total size + largest block) of the memory cache **/
   void cacheInfo(size_t* total, size_t* largest) {
     std::lock_guard<std::recursive_mutex> lock(mutex);
@@ -1027,6 +1525,111 @@ class DeviceCachingAllocator {
     }
   }
 
+  // Note [Per-stream memory pools]
+  // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+  // By default, cross-stream use of a block is tracked with recordStream:
+  // the block's end-of-life events are polled in process_events, so after
+  // a free the block stays unusable for the whole poll latency, and
+  // multi-stream pipelines inflate peak memory accordingly. Streams doing
+  // steady-state pipeline work can instead attach a private pool (reusing
+  // the PrivatePool machinery CUDA graphs introduced): allocations made
+  // on the stream come from its own pool, and releaseToStream rehomes a
+  // produced block to the consuming stream behind an event-ordered
+  // hand-off, so the consumer's eventual free returns the block for
+  // immediate same-stream reuse instead of waiting for the event sweep.
+  //
+  // Per-stream pools are registered in graph_pools under a synthetic
+  // MempoolId_t with both fields equal and nonzero. Capture pools use
+  // {capture_id, 0} and graph_pool_handle() pools use {0, uuid}, so the
+  // id spaces cannot collide, and all existing pool lifecycle machinery
+  // (graph_pools_freeable, release_cached_blocks, snapshot) applies to
+  // stream pools unchanged.
+  void attachStreamPool(cudaStream_t stream) {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    TORCH_CHECK(
+        stream_to_pool_map.find(stream) == stream_to_pool_map.end(),
+        "stream already has a private memory pool attached");
+    static std::atomic<CaptureId_t> uid{1};
+    CaptureId_t u = uid++;
+    MempoolId_t mempool_id{u, u};
+    bool inserted =
+        graph_pools.emplace(mempool_id, std::make_unique<PrivatePool>()).second;
+    TORCH_INTERNAL_ASSERT(inserted);
+    stream_to_pool_map.emplace(stream, mempool_id);
+  }
+
+  void detachStreamPool(cudaStream_t stream) {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    auto it = stream_to_pool_map.find(stream);
+    TORCH_CHECK(
+        it != stream_to_pool_map.end(),
+        "stream has no private memory pool attached");
+    MempoolId_t mempool_id = it->second;
+    stream_to_pool_map.erase(it);
+    // Same retirement strategy as notifyCaptureDestroy: outstanding
+    // allocations may still live in the pool, so it is only marked
+    // freeable here; release_cached_blocks deletes it once emptied.
+    auto it1 = graph_pools.find(mempool_id);
+    TORCH_INTERNAL_ASSERT(it1 != graph_pools.end());
+    auto uc = --(it1->second->use_count);
+    TORCH_INTERNAL_ASSERT(uc == 0);
+    bool inserted =
+        graph_pools_freeable.insert({mempool_id, it1->second.get()}).second;
+    TORCH_INTERNAL_ASSERT(inserted);
+  }
+
+  // Hands a block produced on its home stream over to a consumer stream:
+  // the consumer stream waits (on the GPU) for all work the producer has
+  // queued so far, and the block is rehomed to the consumer so that the
+  // eventual free does not go through stream_uses/event polling at all.
+  // See Note [Per-stream memory pools].
+  void releaseToStream(Block* block, cuda::CUDAStream stream) {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    TORCH_CHECK(
+        stream.device_index() == block->device,
+        "releaseToStream: block and target stream are on different devices");
+    TORCH_CHECK(
+        captures_underway == 0,
+        "releaseToStream is not allowed during CUDA graph capture");
+    if (block->stream == stream.stream()) {
+      return;
+    }
+
+    int prev_device = 0;
+    C10_CUDA_CHECK(cudaGetDevice(&prev_device));
+    C10_CUDA_CHECK(cudaSetDevice(block->device));
+    EventPool::Event event = create_event_internal(block->device);
+    C10_CUDA_CHECK(cudaEventRecord(*event, block->stream));
+    C10_CUDA_CHECK(cudaStreamWaitEvent(stream.stream(), *event, 0));
+    C10_CUDA_CHECK(cudaSetDevice(prev_device));
+
+    block->stream = stream.stream();
+    // The target stream is the home stream now; a recorded use on it no
+    // longer needs end-of-life events.
+    block->stream_uses.erase(stream);
+
+    // A whole-segment block can also move to the pool serving the target
+    // stream, so the free after the consumer is done puts it where the
+    // consumer's next allocation will look. Split blocks must stay with
+    // their segment: their free neighbors belong to the producer's pool
+    // and may be merged and reused on the producer stream, which would
+    // not be ordered after the consumer's work.
+    if (block->prev == nullptr && block->next == nullptr) {
+      BlockPool& dst = pool_for_stream(stream.stream(), block->pool->is_small);
+      if (&dst != block->pool) {
+        // The segment's cudaMalloc accounting follows the block so the
+        // owning PrivatePool (if any) can still be retired cleanly.
+        if (block->pool->owner_PrivatePool) {
+          block->pool->owner_PrivatePool->cudaMalloc_count--;
+        }
+        if (dst.owner_PrivatePool) {
+          dst.owner_PrivatePool->cudaMalloc_count++;
+        }
+        block->pool = &dst;
+      }
+    }
+  }
+
  private:
   // All private methods do not acquire the allocator mutex.
 
@@ -1156,6 +1759,11 @@ class DeviceCachingAllocator {
       }
     }
 #endif
+    if (C10_UNLIKELY(!stream_to_pool_map.empty())) {
+      // The stream may have a private pool attached.
+      // See Note [Per-stream memory pools].
+      return pool_for_stream(stream, size <= kSmallSize);
+    }
     if (size <= kSmallSize) {
       return small_blocks;
     } else {
@@ -1163,6 +1771,18 @@ class DeviceCachingAllocator {
     }
   }
 
+  // Returns the pool serving allocations made on the given stream: its
+  // private pool if one is attached, the global pools otherwise.
+  BlockPool& pool_for_stream(cudaStream_t stream, bool is_small) {
+    auto it = stream_to_pool_map.find(stream);
+    if (it != stream_to_pool_map.end()) {
+      auto it1 = graph_pools.find(it->second);
+      TORCH_INTERNAL_ASSERT(it1 != graph_pools.end());
+      return is_small ? it1->second->small_blocks : it1->second->large_blocks;
+    }
+    return is_small ? small_blocks : large_blocks;
+  }
+
   StatType get_stat_type_for_pool(const BlockPool& pool) {
     return pool.is_small ? StatType::SMALL_POOL : StatType::LARGE_POOL;
   }
@@ -1224,6 +1844,17 @@ class DeviceCachingAllocator {
     return freed_memory;
   }
 
+  // Last-resort hooks that spill opted-in storages to pinned host memory;
+  // see the OffloadHook comment in CUDACachingAllocator.h.
+  bool trigger_offload_hooks(AllocParams& p) {
+    bool freed_memory = false;
+    for (const auto& name : CudaOffloadHooksRegistry()->Keys()) {
+      freed_memory |= CudaOffloadHooksRegistry()->Create(name)->Offload(
+          p.device(), p.alloc_size);
+    }
+    return freed_memory;
+  }
+
   void garbage_collect_cached_blocks() {
     // Free unused cached blocks to reclaim GPU memory.
     // Unlike release_cached_blocks(), this does not enforce synchronization and
@@ -1280,6 +1911,70 @@ class DeviceCachingAllocator {
     }
   }
 
+  // Whether this allocation may be served from an expandable segment.
+  // Restricted to the default large pool: private (graph) pools must keep
+  // stable cudaMalloc'd segments for capture/replay, and the small pool's
+  // 2 MiB segments do not fragment.
+  bool expandable_segments_eligible(const AllocParams& p) const {
+#ifdef PYTORCH_EXPANDABLE_SEGMENTS_SUPPORTED
+    return CachingAllocatorConfig::expandable_segments() &&
+        DriverAPI::get() != nullptr && !p.pool->is_small &&
+        !p.pool->owner_PrivatePool && captures_underway == 0;
+#else
+    (void)p;
+    return false;
+#endif
+  }
+
+  // In expandable-segments mode, look for a segment whose tail block is free
+  // and grow its physical backing in place so the tail block can satisfy the
+  // request, rather than reserving a brand new segment. This is what keeps
+  // memory that was committed for earlier (larger) shapes reusable for later
+  // ones instead of stranding it behind fixed segment boundaries.
+  bool try_expand_segment(AllocParams& p) {
+#ifdef PYTORCH_EXPANDABLE_SEGMENTS_SUPPORTED
+    if (!expandable_segments_eligible(p)) {
+      return false;
+    }
+    BlockPool& pool = *p.pool;
+    for (Block* candidate : pool.blocks) {
+      if (candidate->stream != p.stream() || candidate->next != nullptr ||
+          candidate->size >= p.alloc_size) {
+        continue;
+      }
+      Block* head = candidate;
+      while (head->prev) {
+        head = head->prev;
+      }
+      auto it = expandable_segments_.find(head->ptr);
+      if (it == expandable_segments_.end()) {
+        continue;
+      }
+      size_t grown = it->second->map(p.alloc_size - candidate->size);
+      if (grown == 0) {
+        continue;
+      }
+      pool.blocks.erase(candidate);
+      candidate->size += grown;
+      total_allocated_memory += grown;
+      for_each_selected_stat_type(p.stat_types, [&](size_t stat_type) {
+        update_stat(stats.reserved_bytes[stat_type], grown);
+      });
+      if (candidate->is_split()) {
+        // The grown bytes belong to an inactive split block until the caller
+        // carves the requested size out of it.
+        update_stat_array(stats.inactive_split_bytes, grown, p.stat_types);
+      }
+      p.block = candidate;
+      p.err = cudaSuccess;
+      return true;
+    }
+#else
+    (void)p;
+#endif
+    return false;
+  }
+
   bool alloc_block(AllocParams& p, bool isRetry) {
     // Defensively checks for preexisting CUDA error state.
     C10_CUDA_CHECK(cudaGetLastError());
@@ -1295,6 +1990,27 @@ class DeviceCachingAllocator {
         total_allocated_memory + size > allowed_memory_maximum) {
       p.err = cudaErrorMemoryAllocation;
       return false;
+#ifdef PYTORCH_EXPANDABLE_SEGMENTS_SUPPORTED
+    } else if (expandable_segments_eligible(p)) {
+      size_t device_free;
+      size_t device_total;
+      C10_CUDA_CHECK(cudaMemGetInfo(&device_free, &device_total));
+      // Reserve address space for the whole device up front; only `size`
+      // bytes of physical memory are committed here. Virtual address space
+      // is plentiful, and a maximal reservation means any segment can later
+      // grow to whatever a new shape needs.
+      auto segment =
+          std::make_unique<ExpandableSegment>(p.device(), device_total);
+      size_t mapped = segment->map(size);
+      if (mapped == 0) {
+        p.err = cudaErrorMemoryAllocation;
+        return false;
+      }
+      size = mapped;
+      ptr = segment->ptr();
+      expandable_segments_[ptr] = std::move(segment);
+      p.err = cudaSuccess;
+#endif
     } else {
       p.err = cudaMallocMaybeCapturing(&ptr, size);
       if (p.err != cudaSuccess) {
@@ -1407,7 +2123,19 @@ class DeviceCachingAllocator {
   }
 
   void release_block(Block* block) {
+#ifdef PYTORCH_EXPANDABLE_SEGMENTS_SUPPORTED
+    auto exp_it = expandable_segments_.find(block->ptr);
+    if (exp_it != expandable_segments_.end()) {
+      // release_blocks only frees unsplit blocks, so a base-pointer match
+      // means the whole segment is free: unmap the physical backing and
+      // return the address reservation.
+      expandable_segments_.erase(exp_it);
+    } else {
+      C10_CUDA_CHECK(cudaFree((void*)block->ptr));
+    }
+#else
     C10_CUDA_CHECK(cudaFree((void*)block->ptr));
+#endif
     total_allocated_memory -= block->size;
 
     auto* pool = block->pool;
@@ -1444,9 +2172,8 @@ class DeviceCachingAllocator {
   }
 
   EventPool::Event create_event_internal(int idx) {
-    // Leak the event pool to avoid shutdown issues.
-    static auto* event_pool = new EventPool();
-    return event_pool->get(idx);
+    // The shared pool is leaked, so there are no shutdown ordering issues.
+    return EventPool::instance().get(static_cast<c10::DeviceIndex>(idx));
   }
 
   void synchronize_and_free_events() {
@@ -1569,6 +2296,11 @@ class THCCachingAllocator {
   // lock around calls to cudaFree (to prevent deadlocks with NCCL)
   mutable std::mutex cuda_free_mutex;
 
+  // storages that opted into relocation by the defragmentation pass.
+  // See Note [GPU defragmentation].
+  std::mutex relocatable_mutex;
+  std::vector<c10::weak_intrusive_ptr<c10::StorageImpl>> relocatable_storages;
+
   void add_allocated_block(Block* block) {
     std::lock_guard<std::mutex> lock(mutex);
     allocated_blocks[block->ptr] = block;
@@ -1651,6 +2383,105 @@ class THCCachingAllocator {
       da->emptyCache();
   }
 
+  // Note [GPU defragmentation]
+  // ~~~~~~~~~~~~~~~~~~~~~~~~~~
+  // Week-long serving processes slowly fragment: long-lived allocations end
+  // up scattered across segments whose remaining space is too broken up to
+  // satisfy large requests, and emptyCache() cannot help because a segment
+  // with a single live block can never be returned to the driver. The
+  // allocator cannot move memory on its own - it hands out raw pointers and
+  // has no idea who holds them - so relocation is strictly opt-in: callers
+  // register the storages they know are safe to move (typically long-lived
+  // weights or cache pools), and defragment() runs in a maintenance window
+  // when the caller guarantees no concurrent use of those storages.
+  //
+  // The pass quiesces the device, then for every registered storage whose
+  // block sits in a mostly-dead segment (see shouldRelocate) it allocates a
+  // fresh block, copies device-to-device, and swaps the storage's DataPtr;
+  // destroying the old DataPtr frees the old block through the normal path.
+  // A final emptyCache() hands the vacated segments back to the driver.
+  // Relocations that would need memory we cannot get simply stop the pass -
+  // the process is no worse off than before.
+
+  void registerRelocatable(const c10::intrusive_ptr<c10::StorageImpl>& storage) {
+    std::lock_guard<std::mutex> lock(relocatable_mutex);
+    relocatable_storages.emplace_back(
+        c10::weak_intrusive_ptr<c10::StorageImpl>(storage));
+  }
+
+  size_t defragment(int device) {
+    TORCH_INTERNAL_ASSERT(
+        0 <= device && static_cast<size_t>(device) < device_allocator.size(),
+        "Allocator not initialized for device ",
+        device,
+        ": did you call init?");
+    int activated_device;
+    C10_CUDA_CHECK(cudaGetDevice(&activated_device));
+    if (activated_device != device) {
+      C10_CUDA_CHECK(cudaSetDevice(device));
+    }
+    // Quiesce the device: in-flight kernels may still read the addresses we
+    // are about to vacate.
+    C10_CUDA_CHECK(cudaDeviceSynchronize());
+
+    // Snapshot the live registered storages on this device, pruning expired
+    // registrations along the way.
+    std::vector<c10::intrusive_ptr<c10::StorageImpl>> candidates;
+    {
+      std::lock_guard<std::mutex> lock(relocatable_mutex);
+      auto it = relocatable_storages.begin();
+      while (it != relocatable_storages.end()) {
+        auto storage = it->lock();
+        if (!storage) {
+          it = relocatable_storages.erase(it);
+          continue;
+        }
+        if (storage->device().index() == device &&
+            storage->data_ptr().get() != nullptr &&
+            storage->data_ptr().get_deleter() == &raw_delete) {
+          candidates.push_back(std::move(storage));
+        }
+        ++it;
+      }
+    }
+
+    size_t relocated = 0;
+    for (auto& storage : candidates) {
+      void* old_ptr = storage->data_ptr().get();
+      Block* block = get_allocated_block(old_ptr);
+      if (!block || block->device != device) {
+        continue;
+      }
+      if (!device_allocator[device]->shouldRelocate(block)) {
+        continue;
+      }
+      const size_t nbytes = storage->nbytes();
+      void* new_ptr = nullptr;
+      try {
+        malloc(&new_ptr, device, nbytes, block->stream);
+      } catch (const CUDAOutOfMemoryError&) {
+        // No room to shuffle; keep what we compacted so far.
+        break;
+      }
+      // The device is idle, so a synchronous copy on the default stream
+      // cannot race anything.
+      C10_CUDA_CHECK(
+          cudaMemcpy(new_ptr, old_ptr, nbytes, cudaMemcpyDeviceToDevice));
+      // The returned old DataPtr frees the old block on destruction.
+      storage->set_data_ptr(
+          DataPtr(new_ptr, new_ptr, &raw_delete, storage->device()));
+      relocated++;
+    }
+
+    // Hand the vacated segments back to the driver.
+    device_allocator[device]->emptyCache();
+
+    if (activated_device != device) {
+      C10_CUDA_CHECK(cudaSetDevice(activated_device));
+    }
+    return relocated;
+  }
+
   void* getBaseAllocation(void* ptr, size_t* outSize) {
     Block* block = get_allocated_block(ptr);
     if (!block) {
@@ -1680,6 +2511,28 @@ class THCCachingAllocator {
     device_allocator[block->device]->recordStream(block, stream);
   }
 
+  void attachStreamPool(cuda::CUDAStream stream) {
+    device_allocator[stream.device_index()]->attachStreamPool(stream.stream());
+  }
+
+  void detachStreamPool(cuda::CUDAStream stream) {
+    device_allocator[stream.device_index()]->detachStreamPool(stream.stream());
+  }
+
+  void releaseToStream(const DataPtr& ptr, cuda::CUDAStream stream) {
+    if (!ptr.get()) {
+      return;
+    }
+    // See recordStream above for why externally allocated memory is
+    // skipped here.
+    if (ptr.get_deleter() != &raw_delete) {
+      return;
+    }
+    Block* block = get_allocated_block(ptr.get());
+    TORCH_INTERNAL_ASSERT(block != nullptr, "No allocated block can be found");
+    device_allocator[block->device]->releaseToStream(block, stream);
+  }
+
   std::vector<SegmentInfo> snapshot() {
     std::vector<SegmentInfo> result;
     for (auto& da : device_allocator) {
@@ -1693,6 +2546,192 @@ class THCCachingAllocator {
 
 THCCachingAllocator caching_allocator;
 
+// Note [Allocator trace]
+// ~~~~~~~~~~~~~~~~~~~~~~
+// An opt-in ring buffer of allocation and free events, each carrying a
+// compact native call stack. Attributing device memory to code paths through
+// Python-level tracking misses allocations made from C++, so the stack is
+// captured natively (raw return addresses from backtrace(3)); symbolization
+// is deferred to export time, keeping the capture cost to one frame walk and
+// one memcpy per allocation. The ring is fixed-size, so tracing can stay on
+// in a long-running serving binary with bounded memory overhead; events that
+// fall off the ring simply stop contributing to the export.
+//
+// exportAllocTraceFolded() replays the ring to pair allocations with their
+// frees and emits the still-live bytes aggregated by call stack in the
+// collapsed-stack text format ("outer;...;inner <bytes>") consumed directly
+// by flamegraph tooling and convertible to pprof profiles.
+namespace {
+
+constexpr size_t kAllocTraceMaxFrames = 32;
+// The innermost frames are the tracer and the allocator entry point; they
+// carry no attribution value, so they are not recorded.
+constexpr size_t kAllocTraceSkipFrames = 2;
+
+struct AllocTraceEntry {
+  void* ptr = nullptr;
+  // Negative for frees.
+  int64_t size = 0;
+  int device = -1;
+  size_t depth = 0;
+  std::array<void*, kAllocTraceMaxFrames> frames{};
+};
+
+class AllocTracer {
+ public:
+  static AllocTracer& instance() {
+    // Leaky singleton: frees can be recorded during program teardown.
+    static AllocTracer* tracer = new AllocTracer();
+    return *tracer;
+  }
+
+  bool enabled() const {
+    return enabled_.load(std::memory_order_relaxed);
+  }
+
+  void setEnabled(bool enabled) {
+    enabled_.store(enabled, std::memory_order_relaxed);
+  }
+
+  void setMaxEntries(size_t max_entries) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    capacity_ = std::max<size_t>(max_entries, 1);
+    ring_.clear();
+    next_ = 0;
+  }
+
+  void recordAlloc(void* ptr, size_t size, int device) {
+    if (ptr == nullptr) {
+      return;
+    }
+    AllocTraceEntry entry;
+    entry.ptr = ptr;
+    entry.size = static_cast<int64_t>(size);
+    entry.device = device;
+    captureStack(entry);
+    push(entry);
+  }
+
+  void recordFree(void* ptr) {
+    if (ptr == nullptr) {
+      return;
+    }
+    AllocTraceEntry entry;
+    entry.ptr = ptr;
+    entry.size = -1;
+    push(entry);
+  }
+
+  std::string exportFolded() {
+    std::vector<AllocTraceEntry> entries;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      entries.reserve(ring_.size());
+      // Oldest first: the ring wraps at next_ once it is full.
+      for (size_t i = 0; i < ring_.size(); ++i) {
+        entries.emplace_back(ring_[(next_ + i) % ring_.size()]);
+      }
+    }
+
+    // Replay to find allocations that are still live. Frees whose
+    // allocation fell off the ring are ignored.
+    ska::flat_hash_map<void*, const AllocTraceEntry*> live;
+    for (const auto& entry : entries) {
+      if (entry.size >= 0) {
+        live[entry.ptr] = &entry;
+      } else {
+        live.erase(entry.ptr);
+      }
+    }
+
+    // Aggregate live bytes by symbolized stack, outermost frame first as
+    // flamegraph tooling expects.
+    std::map<std::string, int64_t> folded;
+    for (const auto& kv : live) {
+      const AllocTraceEntry& entry = *kv.second;
+      std::ostringstream stack;
+      for (size_t i = entry.depth; i > 0; --i) {
+        stack << symbolize(entry.frames[i - 1]);
+        if (i > 1) {
+          stack << ";";
+        }
+      }
+      if (entry.depth == 0) {
+        stack << "<no stack>";
+      }
+      folded[stack.str()] += entry.size;
+    }
+
+    std::ostringstream out;
+    for (const auto& kv : folded) {
+      out << kv.first << " " << kv.second << "\n";
+    }
+    return out.str();
+  }
+
+ private:
+  AllocTracer() = default;
+
+  void captureStack(AllocTraceEntry& entry) {
+#if defined(__linux__) && !defined(__ANDROID__)
+    std::array<void*, kAllocTraceMaxFrames + kAllocTraceSkipFrames> frames;
+    int depth = ::backtrace(frames.data(), frames.size());
+    if (depth <= static_cast<int>(kAllocTraceSkipFrames)) {
+      return;
+    }
+    entry.depth = depth - kAllocTraceSkipFrames;
+    std::copy(
+        frames.begin() + kAllocTraceSkipFrames,
+        frames.begin() + depth,
+        entry.frames.begin());
+#endif
+  }
+
+  static std::string symbolize(void* frame) {
+#if defined(__linux__) && !defined(__ANDROID__)
+    Dl_info info;
+    if (dladdr(frame, &info) && info.dli_sname != nullptr) {
+      return c10::demangle(info.dli_sname);
+    }
+#endif
+    std::ostringstream name;
+    name << frame;
+    return name.str();
+  }
+
+  void push(const AllocTraceEntry& entry) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (ring_.size() < capacity_) {
+      ring_.emplace_back(entry);
+    } else {
+      ring_[next_] = entry;
+      next_ = (next_ + 1) % capacity_;
+    }
+  }
+
+  std::atomic<bool> enabled_{false};
+  std::mutex mutex_;
+  std::vector<AllocTraceEntry> ring_;
+  size_t next_ = 0;
+  size_t capacity_ = 65536;
+};
+
+// Kept out of the hot path behind a single relaxed atomic load; when tracing
+// is off the cost is one predictable branch.
+inline void trace_alloc(void* ptr, size_t size, int device) {
+  if (C10_UNLIKELY(AllocTracer::instance().enabled())) {
+    AllocTracer::instance().recordAlloc(ptr, size, device);
+  }
+}
+
+inline void trace_free(void* ptr) {
+  if (C10_UNLIKELY(AllocTracer::instance().enabled())) {
+    AllocTracer::instance().recordFree(ptr);
+  }
+}
+
+} // namespace
+
 // Returns whether to force all allocations to bypass the caching allocator and
 // go straight to cudaMalloc.  This setting is useful when debugging GPU memory
 // errors, since the caching allocator foils cuda-memcheck.
@@ -1703,9 +2742,144 @@ bool forceUncachedAllocator() {
 }
 
 static void uncached_delete(void* ptr) {
+  trace_free(ptr);
   C10_CUDA_CHECK(cudaFree(ptr));
 }
 
+// Note [cudaMallocAsync backend]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// PYTORCH_CUDA_ALLOC_CONF=backend:cudaMallocAsync swaps the native caching
+// pool for CUDA's stream-ordered allocator on each device's default memory
+// pool. The point is interop: external libraries that also allocate through
+// cudaMallocAsync (RAPIDS and friends) then share one driver-managed pool
+// with PyTorch instead of two private pools fighting over the device and
+// OOMing while the other side sits on cached memory. The pool's release
+// threshold is set to "never release" so the driver caches freed memory the
+// way the native allocator does; emptyCache() trims it back to zero.
+//
+// Cross-stream uses still go through recordStream: frees are issued
+// stream-ordered on the allocation stream after it waits on an event
+// recorded on every other stream that used the allocation. Stats, snapshots
+// and CUDA-graph private pools remain native-backend features; the driver
+// owns all bookkeeping here.
+#ifdef PYTORCH_CUDA_MALLOC_ASYNC_SUPPORTED
+namespace cuda_malloc_async {
+
+struct AsyncAllocInfo {
+  int device;
+  cudaStream_t stream; // allocation stream; frees are ordered on it
+  std::vector<cudaStream_t> recorded_streams;
+};
+
+std::mutex async_mutex;
+ska::flat_hash_map<void*, AsyncAllocInfo> async_allocations;
+std::vector<bool> async_device_ready;
+
+// Raise the pool's release threshold once per device so the driver keeps
+// freed memory cached instead of returning it eagerly. Caller holds
+// async_mutex.
+void lazy_init_device(int device) {
+  if (static_cast<size_t>(device) >= async_device_ready.size()) {
+    int device_count = 0;
+    C10_CUDA_CHECK(cudaGetDeviceCount(&device_count));
+    async_device_ready.resize(device_count, false);
+  }
+  if (async_device_ready[device]) {
+    return;
+  }
+  cudaMemPool_t pool = nullptr;
+  C10_CUDA_CHECK(cudaDeviceGetDefaultMemPool(&pool, device));
+  uint64_t threshold = std::numeric_limits<uint64_t>::max();
+  C10_CUDA_CHECK(cudaMemPoolSetAttribute(
+      pool, cudaMemPoolAttrReleaseThreshold, &threshold));
+  async_device_ready[device] = true;
+}
+
+void malloc(void** devPtr, int device, size_t size, cudaStream_t stream) {
+  std::lock_guard<std::mutex> lock(async_mutex);
+  lazy_init_device(device);
+  cudaError_t err = cudaMallocAsync(devPtr, size, stream);
+  if (err == cudaErrorMemoryAllocation) {
+    // The pool may be able to satisfy us once in-flight frees retire.
+    cudaGetLastError();
+    C10_CUDA_CHECK(cudaStreamSynchronize(stream));
+    err = cudaMallocAsync(devPtr, size, stream);
+    if (err == cudaErrorMemoryAllocation) {
+      cudaGetLastError();
+      TORCH_CHECK_WITH(
+          CUDAOutOfMemoryError,
+          false,
+          "CUDA out of memory (cudaMallocAsync backend). Tried to allocate ",
+          size,
+          " bytes on device ",
+          device,
+          ".");
+    }
+  }
+  C10_CUDA_CHECK(err);
+  async_allocations.emplace(*devPtr, AsyncAllocInfo{device, stream, {}});
+}
+
+void free(void* ptr) {
+  std::lock_guard<std::mutex> lock(async_mutex);
+  auto it = async_allocations.find(ptr);
+  TORCH_CHECK(
+      it != async_allocations.end(), "invalid device pointer: ", ptr);
+  const AsyncAllocInfo& info = it->second;
+  for (cudaStream_t used : info.recorded_streams) {
+    cudaEvent_t event = nullptr;
+    C10_CUDA_CHECK(cudaEventCreateWithFlags(&event, cudaEventDisableTiming));
+    C10_CUDA_CHECK(cudaEventRecord(event, used));
+    C10_CUDA_CHECK(cudaStreamWaitEvent(info.stream, event, 0));
+    C10_CUDA_CHECK(cudaEventDestroy(event));
+  }
+  C10_CUDA_CHECK(cudaFreeAsync(ptr, info.stream));
+  async_allocations.erase(it);
+}
+
+void recordStream(void* ptr, cudaStream_t stream) {
+  std::lock_guard<std::mutex> lock(async_mutex);
+  auto it = async_allocations.find(ptr);
+  if (it == async_allocations.end()) {
+    return;
+  }
+  AsyncAllocInfo& info = it->second;
+  if (stream == info.stream) {
+    return;
+  }
+  if (std::find(
+          info.recorded_streams.begin(),
+          info.recorded_streams.end(),
+          stream) == info.recorded_streams.end()) {
+    info.recorded_streams.push_back(stream);
+  }
+}
+
+void emptyCache() {
+  std::lock_guard<std::mutex> lock(async_mutex);
+  for (size_t device = 0; device < async_device_ready.size(); device++) {
+    if (!async_device_ready[device]) {
+      continue;
+    }
+    cudaMemPool_t pool = nullptr;
+    C10_CUDA_CHECK(
+        cudaDeviceGetDefaultMemPool(&pool, static_cast<int>(device)));
+    C10_CUDA_CHECK(cudaDeviceSynchronize());
+    C10_CUDA_CHECK(cudaMemPoolTrimTo(pool, 0));
+  }
+}
+
+void* memPoolHandle(int device) {
+  std::lock_guard<std::mutex> lock(async_mutex);
+  lazy_init_device(device);
+  cudaMemPool_t pool = nullptr;
+  C10_CUDA_CHECK(cudaDeviceGetDefaultMemPool(&pool, device));
+  return static_cast<void*>(pool);
+}
+
+} // namespace cuda_malloc_async
+#endif // PYTORCH_CUDA_MALLOC_ASYNC_SUPPORTED
+
 // NB: I decided not to fold this into THCCachingAllocator, because the latter
 // has a lot more methods and it wasn't altogether clear that they should
 // actually be publicly exposed
@@ -1723,11 +2897,21 @@ struct CudaCachingAllocator : public Allocator {
       // Deliberately don't use cudaMallocMaybeCapturing here, to force an error
       // if someone tries to use forceUncachedAllocator while capturing.
       C10_CUDA_CHECK(cudaMalloc(&r, size));
+      trace_alloc(r, size, device);
       return {r, r, &uncached_delete, Device(DeviceType::CUDA, device)};
     }
     if (size != 0) {
+#ifdef PYTORCH_CUDA_MALLOC_ASYNC_SUPPORTED
+      if (CachingAllocatorConfig::use_cuda_malloc_async()) {
+        cuda_malloc_async::malloc(
+            &r, device, size, cuda::getCurrentCUDAStream(device));
+        trace_alloc(r, size, device);
+        return {r, r, &raw_delete, Device(DeviceType::CUDA, device)};
+      }
+#endif
       caching_allocator.malloc(
           &r, device, size, cuda::getCurrentCUDAStream(device));
+      trace_alloc(r, size, device);
     }
     return {r, r, &raw_delete, Device(DeviceType::CUDA, device)};
   }
@@ -1755,6 +2939,12 @@ void setMemoryFraction(double fraction, int device) {
 }
 
 void emptyCache(void) {
+#ifdef PYTORCH_CUDA_MALLOC_ASYNC_SUPPORTED
+  if (CachingAllocatorConfig::use_cuda_malloc_async()) {
+    cuda_malloc_async::emptyCache();
+    return;
+  }
+#endif
   caching_allocator.emptyCache();
 }
 
@@ -1768,9 +2958,26 @@ void* getBaseAllocation(void* ptr, size_t* size) {
 }
 
 void recordStream(const DataPtr& ptr, cuda::CUDAStream stream) {
+#ifdef PYTORCH_CUDA_MALLOC_ASYNC_SUPPORTED
+  if (CachingAllocatorConfig::use_cuda_malloc_async()) {
+    if (ptr.get() && ptr.get_deleter() == &raw_delete) {
+      cuda_malloc_async::recordStream(ptr.get(), stream.stream());
+    }
+    return;
+  }
+#endif
   caching_allocator.recordStream(ptr, stream);
 }
 
+void registerRelocatableStorage(
+    const c10::intrusive_ptr<c10::StorageImpl>& storage) {
+  caching_allocator.registerRelocatable(storage);
+}
+
+size_t defragment(int device) {
+  return caching_allocator.defragment(device);
+}
+
 std::mutex* getFreeMutex() {
   return caching_allocator.getCudaFreeMutex();
 }
@@ -1803,6 +3010,36 @@ std::vector<SegmentInfo> snapshot() {
   return caching_allocator.snapshot();
 }
 
+void setAllocTraceEnabled(bool enabled) {
+  AllocTracer::instance().setEnabled(enabled);
+}
+
+bool allocTraceEnabled() {
+  return AllocTracer::instance().enabled();
+}
+
+void setAllocTraceMaxEntries(size_t max_entries) {
+  AllocTracer::instance().setMaxEntries(max_entries);
+}
+
+std::string exportAllocTraceFolded() {
+  return AllocTracer::instance().exportFolded();
+}
+
+uint64_t addPressureListener(double threshold, PressureListener listener) {
+  TORCH_CHECK(
+      threshold >= 0.0 && threshold <= 1.0,
+      "pressure threshold must be in [0, 1], got ",
+      threshold);
+  TORCH_CHECK(listener, "expected a callable pressure listener");
+  return PressureMonitor::instance().addListener(
+      threshold, std::move(listener));
+}
+
+void removePressureListener(uint64_t handle) {
+  PressureMonitor::instance().removeListener(handle);
+}
+
 // CUDAGraph interactions
 void notifyCaptureBegin(
     int device,
@@ -1823,6 +3060,23 @@ void notifyCaptureDestroy(int device, MempoolId_t mempool_id) {
   caching_allocator.device_allocator[device]->notifyCaptureDestroy(mempool_id);
 }
 
+// Per-stream memory pools
+// See Note [Per-stream memory pools] for the semantics of these APIs.
+
+void attachStreamPool(CUDAStream stream) {
+  assertValidDevice(stream.device_index());
+  caching_allocator.attachStreamPool(stream);
+}
+
+void detachStreamPool(CUDAStream stream) {
+  assertValidDevice(stream.device_index());
+  caching_allocator.detachStreamPool(stream);
+}
+
+void releaseToStream(const DataPtr& ptr, CUDAStream stream) {
+  caching_allocator.releaseToStream(ptr, stream);
+}
+
 //
 // In CUDA IPC, sender sends a tensor to receiver, getIpcDevPtr
 // is called by the receiving process to map the CUDA memory from the sending
@@ -1885,8 +3139,17 @@ void* raw_alloc(size_t nbytes) {
   int device;
   C10_CUDA_CHECK(cudaGetDevice(&device));
   void* r = nullptr;
+#ifdef PYTORCH_CUDA_MALLOC_ASYNC_SUPPORTED
+  if (CachingAllocatorConfig::use_cuda_malloc_async()) {
+    cuda_malloc_async::malloc(
+        &r, device, nbytes, cuda::getCurrentCUDAStream(device));
+    trace_alloc(r, nbytes, device);
+    return r;
+  }
+#endif
   caching_allocator.malloc(
       &r, device, nbytes, cuda::getCurrentCUDAStream(device));
+  trace_alloc(r, nbytes, device);
   return r;
 }
 
@@ -1897,14 +3160,38 @@ void* raw_alloc_with_stream(size_t nbytes, cudaStream_t stream) {
   int device;
   C10_CUDA_CHECK(cudaGetDevice(&device));
   void* r = nullptr;
+#ifdef PYTORCH_CUDA_MALLOC_ASYNC_SUPPORTED
+  if (CachingAllocatorConfig::use_cuda_malloc_async()) {
+    cuda_malloc_async::malloc(&r, device, nbytes, stream);
+    trace_alloc(r, nbytes, device);
+    return r;
+  }
+#endif
   caching_allocator.malloc(&r, device, nbytes, stream);
+  trace_alloc(r, nbytes, device);
   return r;
 }
 
 void raw_delete(void* ptr) {
+  trace_free(ptr);
+#ifdef PYTORCH_CUDA_MALLOC_ASYNC_SUPPORTED
+  if (CachingAllocatorConfig::use_cuda_malloc_async()) {
+    cuda_malloc_async::free(ptr);
+    return;
+  }
+#endif
   caching_allocator.free(ptr);
 }
 
+void* getMemPoolHandle(int device) {
+#ifdef PYTORCH_CUDA_MALLOC_ASYNC_SUPPORTED
+  if (CachingAllocatorConfig::use_cuda_malloc_async()) {
+    return cuda_malloc_async::memPoolHandle(device);
+  }
+#endif
+  return nullptr;
+}
+
 } // namespace CUDACachingAllocator
 
 } // namespace cuda
@@ -5,12 +5,16 @@
 #include <c10/cuda/CUDAMacros.h>
 #include <c10/cuda/CUDAStream.h>
 #include <c10/util/Registry.h>
+#include <c10/util/intrusive_ptr.h>
 
 #include <array>
+#include <functional>
 #include <mutex>
 
 namespace c10 {
 
+struct StorageImpl;
+
 class C10_CUDA_API CUDAOutOfMemoryError : public c10::Error {
   using Error::Error;
 };
@@ -27,6 +31,26 @@ C10_DECLARE_REGISTRY(FreeCudaMemoryCallbacksRegistry, FreeMemoryCallback);
 #define REGISTER_FREE_MEMORY_CALLBACK(name, ...) \
   C10_REGISTER_CLASS(FreeCudaMemoryCallbacksRegistry, name, __VA_ARGS__);
 
+// Consulted as a last resort when an allocation still cannot be satisfied
+// after every cached block has been returned to the driver. Implementations
+// are expected to spill cold storages that opted in via
+// StorageImpl::set_offloadable (e.g. inference KV-cache blocks) to pinned
+// host memory and return true if any device memory was released; the
+// allocation sequence is then retried once before CUDAOutOfMemoryError is
+// raised. Hooks run with the device allocator lock held; the lock is
+// reentrant, so freeing device tensors from inside a hook is fine. The
+// device and the size of the failed allocation are passed in so a hook can
+// stop once it has released enough.
+class C10_CUDA_API OffloadHook {
+ public:
+  virtual ~OffloadHook() = default;
+  virtual bool Offload(int device, size_t alloc_size) = 0;
+};
+
+C10_DECLARE_REGISTRY(CudaOffloadHooksRegistry, OffloadHook);
+#define REGISTER_CUDA_OFFLOAD_HOOK(name, ...) \
+  C10_REGISTER_CLASS(CudaOffloadHooksRegistry, name, __VA_ARGS__);
+
 namespace cuda {
 
 // TODO: Turn this into an honest to goodness class. I briefly attempted to do
@@ -145,6 +169,84 @@ C10_CUDA_API void notifyCaptureBegin(
 C10_CUDA_API void notifyCaptureEnd(int device, CaptureId_t graph_id);
 C10_CUDA_API void notifyCaptureDestroy(int device, MempoolId_t mempool_id);
 
+// Per-stream private pools, for multi-stream pipelines where the
+// recordStream/event-polling path delays block reuse too much. After
+// attachStreamPool, allocations made on the stream are served from a
+// pool private to that stream; releaseToStream hands a tensor produced
+// on its home stream over to a consumer stream behind a GPU-side event
+// wait and rehomes its block there, so the eventual free reuses the
+// block immediately. See Note [Per-stream memory pools] in
+// CUDACachingAllocator.cpp.
+C10_CUDA_API void attachStreamPool(CUDAStream stream);
+C10_CUDA_API void detachStreamPool(CUDAStream stream);
+C10_CUDA_API void releaseToStream(const DataPtr&, CUDAStream stream);
+
+// Explicit defragmentation for long-running processes. Storages registered
+// via registerRelocatableStorage may have their device memory moved by
+// defragment(device): the device is quiesced, storages pinning mostly-dead
+// segments are copied into fresh blocks, their DataPtrs are swapped, and the
+// vacated segments are returned to the driver. The caller must guarantee
+// that no other thread touches the registered storages for the duration of
+// the call (e.g. a serving maintenance window). Registration holds only a
+// weak reference; expired entries are pruned on the next pass. Returns the
+// number of storages that were relocated. See Note [GPU defragmentation] in
+// CUDACachingAllocator.cpp.
+C10_CUDA_API void registerRelocatableStorage(
+    const c10::intrusive_ptr<c10::StorageImpl>& storage);
+C10_CUDA_API size_t defragment(int device);
+
+// When the cudaMallocAsync backend is active
+// (PYTORCH_CUDA_ALLOC_CONF=backend:cudaMallocAsync), returns the device's
+// cudaMemPool_t (as an opaque pointer) that PyTorch allocates from, so
+// external libraries can target the same pool. Returns nullptr under the
+// native backend. See Note [cudaMallocAsync backend] in
+// CUDACachingAllocator.cpp.
+C10_CUDA_API void* getMemPoolHandle(int device);
+
+// Opt-in native allocation tracing: alloc/free events carry a compact C++
+// call stack and land in a bounded ring buffer, exportable in the collapsed
+// stack format consumed by flamegraph tooling. Attributes device memory to
+// the C++ code paths that Python-level tracking cannot see. See
+// Note [Allocator trace] in CUDACachingAllocator.cpp.
+C10_CUDA_API void setAllocTraceEnabled(bool enabled);
+C10_CUDA_API bool allocTraceEnabled();
+C10_CUDA_API void setAllocTraceMaxEntries(size_t max_entries);
+C10_CUDA_API std::string exportAllocTraceFolded();
+
+// Early-warning pressure signals for load shedding. A listener registered
+// with addPressureListener is invoked on a dedicated signal thread whenever
+// a device's pressure score crosses the listener's threshold in either
+// direction, so a batch scheduler can shrink batches before allocations
+// start failing rather than reacting to OOMs. The score accounts for
+// fragmentation: it is the fraction of the device's allowed capacity that
+// is unavailable to a single contiguous allocation. See
+// Note [Allocator pressure signals] in CUDACachingAllocator.cpp.
+struct PressureReading {
+  int device = 0;
+  // Client-allocated bytes over the allowed device capacity.
+  double utilization = 0.0;
+  // 1 - largest contiguous free chunk / total free bytes: 0 when the
+  // remaining memory is one block, approaching 1 as the pool shatters.
+  double fragmentation = 0.0;
+  // 1 - largest contiguous free chunk / allowed capacity. Equals
+  // utilization for an unfragmented pool; listener thresholds are
+  // compared against this value.
+  double score = 0.0;
+  size_t allocated_bytes = 0;
+  size_t reserved_bytes = 0;
+  size_t largest_free_block = 0;
+};
+
+using PressureListener = std::function<void(const PressureReading&)>;
+
+// `threshold` must be in [0, 1]. Returns a handle for
+// removePressureListener. Listeners run off the allocation path; one call
+// that was already in flight may still be delivered after removal.
+C10_CUDA_API uint64_t addPressureListener(
+    double threshold,
+    PressureListener listener);
+C10_CUDA_API void removePressureListener(uint64_t handle);
+
 C10_CUDA_API std::mutex* getFreeMutex();
 
 C10_CUDA_API std::shared_ptr<void> getIpcDevPtr(std::string handle);
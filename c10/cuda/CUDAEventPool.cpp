@@ -0,0 +1,74 @@
+#include <c10/cuda/CUDAEventPool.h>
+
+#include <c10/cuda/CUDAException.h>
+#include <c10/cuda/CUDAFunctions.h>
+#include <c10/cuda/CUDAGuard.h>
+#include <c10/util/Exception.h>
+
+namespace c10 {
+namespace cuda {
+
+CUDAEventPool::CUDAEventPool() : pools_(device_count()) {}
+
+CUDAEventPool::PerDevicePool& CUDAEventPool::pool_for(DeviceIndex device) {
+  TORCH_INTERNAL_ASSERT(0 <= device);
+  TORCH_INTERNAL_ASSERT(static_cast<size_t>(device) < pools_.size());
+  return pools_[device];
+}
+
+cudaEvent_t CUDAEventPool::acquire(DeviceIndex device) {
+  auto& pool = pool_for(device);
+  {
+    std::lock_guard<std::mutex> g(pool.mutex);
+    if (!pool.events.empty()) {
+      cudaEvent_t event = pool.events.back();
+      pool.events.pop_back();
+      return event;
+    }
+  }
+  // Create outside the pool lock; the guard ensures the event belongs to the
+  // right device context.
+  CUDAGuard device_guard(device);
+  cudaEvent_t event{};
+  C10_CUDA_CHECK(cudaEventCreateWithFlags(&event, cudaEventDisableTiming));
+  return event;
+}
+
+void CUDAEventPool::release(DeviceIndex device, cudaEvent_t event) {
+  auto& pool = pool_for(device);
+  std::lock_guard<std::mutex> g(pool.mutex);
+  pool.events.push_back(event);
+}
+
+CUDAEventPool::Event CUDAEventPool::get(DeviceIndex device) {
+  auto* event = new cudaEvent_t(acquire(device));
+  return Event(event, [this, device](cudaEvent_t* e) {
+    release(device, *e);
+    delete e;
+  });
+}
+
+void CUDAEventPool::empty_cache() {
+  for (size_t i = 0; i < pools_.size(); ++i) {
+    auto& pool = pools_[i];
+    std::lock_guard<std::mutex> g(pool.mutex);
+    if (pool.events.empty()) {
+      continue;
+    }
+    // Destroy on the creating device to avoid spinning up contexts on other
+    // devices.
+    CUDAGuard device_guard(static_cast<DeviceIndex>(i));
+    for (cudaEvent_t event : pool.events) {
+      C10_CUDA_CHECK_WARN(cudaEventDestroy(event));
+    }
+    pool.events.clear();
+  }
+}
+
+CUDAEventPool& CUDAEventPool::instance() {
+  static auto* pool = new CUDAEventPool();
+  return *pool;
+}
+
+} // namespace cuda
+} // namespace c10
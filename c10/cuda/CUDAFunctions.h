@@ -57,6 +57,16 @@ C10_CUDA_API __inline__ WarningState& warning_state() {
   static WarningState warning_state_;
   return warning_state_;
 }
+// Utilization gauges; see Note [Utilization gauges] in
+// CUDAUtilizationGauge.cpp. Declared here so memcpy_and_sync can feed
+// the memcpy bandwidth gauge without pulling in the gauge header.
+C10_CUDA_API bool utilization_gauge_active();
+namespace impl {
+C10_CUDA_API void utilization_gauge_record_memcpy(
+    cudaStream_t stream,
+    int64_t nbytes);
+} // namespace impl
+
 // the subsequent functions are defined in the header because for performance
 // reasons we want them to be inline
 C10_CUDA_API void __inline__ memcpy_and_sync(
@@ -69,6 +79,9 @@ C10_CUDA_API void __inline__ memcpy_and_sync(
           warning_state().get_sync_debug_mode() != SyncDebugMode::L_DISABLED)) {
     warn_or_error_on_sync();
   }
+  if (C10_UNLIKELY(utilization_gauge_active())) {
+    impl::utilization_gauge_record_memcpy(stream, nbytes);
+  }
 #if defined(TORCH_HIP_VERSION) && (TORCH_HIP_VERSION >= 301)
   C10_CUDA_CHECK(hipMemcpyWithStream(dst, src, nbytes, kind, stream));
 #else
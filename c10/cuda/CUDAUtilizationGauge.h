@@ -0,0 +1,74 @@
+#pragma once
+
+#include <c10/core/Device.h>
+#include <c10/cuda/CUDAMacros.h>
+
+#include <cuda_runtime_api.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace c10 {
+namespace cuda {
+
+// Lightweight in-process GPU utilization gauges. A background thread
+// samples the tracked streams of each device at a fixed interval via
+// cudaStreamQuery; a stream counts as busy for a tick when it still has
+// work queued. Bytes moving through memcpy_and_sync are accounted as
+// well, giving a host-side memcpy bandwidth gauge. All counters are
+// cumulative; callers diff two snapshots to get a busy fraction and
+// bandwidth for a request window. See Note [Utilization gauges] in
+// CUDAUtilizationGauge.cpp.
+
+struct StreamUtilization {
+  cudaStream_t stream;
+  // Sampling ticks observed for this stream, and how many of them found
+  // work still queued.
+  uint64_t samples;
+  uint64_t busy_samples;
+};
+
+struct DeviceUtilization {
+  DeviceIndex device;
+  // Wall clock of the snapshot, from std::chrono::steady_clock.
+  uint64_t snapshot_time_ns;
+  // Ticks where the device was sampled / where at least one tracked
+  // stream was busy.
+  uint64_t samples;
+  uint64_t busy_samples;
+  // Bytes moved through memcpy_and_sync on this device.
+  uint64_t memcpy_bytes;
+  std::vector<StreamUtilization> streams;
+};
+
+// Starts the sampling thread (idempotent). The interval bounds the
+// gauge's overhead and resolution; the default of 1ms keeps the cost of
+// querying a handful of streams well under 0.5% of one core.
+C10_CUDA_API void enable_utilization_gauge(uint64_t interval_us = 1000);
+
+// Stops the sampling thread; counters are retained.
+C10_CUDA_API void disable_utilization_gauge();
+
+C10_CUDA_API bool utilization_gauge_active();
+
+// Adds a stream to the device's tracked set. Streams seen by
+// memcpy_and_sync while the gauge is active are tracked automatically;
+// compute streams must be registered here (typically once per serving
+// thread, with its current stream). Tracking is capped per device;
+// registrations past the cap are ignored.
+C10_CUDA_API void track_stream_utilization(
+    DeviceIndex device,
+    cudaStream_t stream);
+
+// Cumulative counters for `device` at the time of the call.
+C10_CUDA_API DeviceUtilization utilization_snapshot(DeviceIndex device);
+
+namespace impl {
+// Called from memcpy_and_sync when the gauge is active.
+C10_CUDA_API void utilization_gauge_record_memcpy(
+    cudaStream_t stream,
+    int64_t nbytes);
+} // namespace impl
+
+} // namespace cuda
+} // namespace c10
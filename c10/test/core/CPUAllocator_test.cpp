@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+
+#include <c10/core/CPUAllocator.h>
+
+#include <cstdint>
+#include <cstring>
+
+namespace {
+
+// Restores the previous cache state so tests do not leak configuration
+// into each other.
+struct CacheEnabledGuard {
+  CacheEnabledGuard() : prev_(c10::isCPUCachingAllocatorEnabled()) {
+    c10::setCPUCachingAllocatorEnabled(true);
+  }
+  ~CacheEnabledGuard() {
+    c10::setCPUCachingAllocatorEnabled(prev_);
+    c10::emptyCPUCachingAllocator();
+  }
+  bool prev_;
+};
+
+} // namespace
+
+TEST(CPUCachingAllocatorTest, RecyclesSameSizeClass) {
+  CacheEnabledGuard guard;
+  auto* allocator = c10::GetDefaultCPUAllocator();
+  constexpr size_t kSize = 2 * 1024 * 1024;
+
+  void* first = nullptr;
+  {
+    c10::DataPtr a = allocator->allocate(kSize);
+    first = a.get();
+    std::memset(first, 0xab, kSize);
+  }
+  const auto before = c10::getCPUCachingAllocatorStats();
+  EXPECT_GE(before.cached_bytes, kSize);
+
+  c10::DataPtr b = allocator->allocate(kSize);
+  EXPECT_EQ(b.get(), first);
+  const auto after = c10::getCPUCachingAllocatorStats();
+  EXPECT_GT(after.num_cache_hits, before.num_cache_hits);
+}
+
+TEST(CPUCachingAllocatorTest, EmptyReleasesCachedBlocks) {
+  CacheEnabledGuard guard;
+  auto* allocator = c10::GetDefaultCPUAllocator();
+  { c10::DataPtr a = allocator->allocate(1024 * 1024); }
+  EXPECT_GT(c10::getCPUCachingAllocatorStats().cached_bytes, 0u);
+
+  c10::emptyCPUCachingAllocator();
+  EXPECT_EQ(c10::getCPUCachingAllocatorStats().cached_bytes, 0u);
+}
+
+TEST(CPUCachingAllocatorTest, SmallAllocationsBypassTheCache) {
+  CacheEnabledGuard guard;
+  c10::emptyCPUCachingAllocator();
+  auto* allocator = c10::GetDefaultCPUAllocator();
+  const auto before = c10::getCPUCachingAllocatorStats();
+  { c10::DataPtr a = allocator->allocate(64); }
+  const auto after = c10::getCPUCachingAllocatorStats();
+  EXPECT_EQ(after.num_cached_frees, before.num_cached_frees);
+}
+
+TEST(CPUCachingAllocatorTest, DisablingStopsRecycling) {
+  {
+    CacheEnabledGuard guard;
+    auto* allocator = c10::GetDefaultCPUAllocator();
+    c10::DataPtr a = allocator->allocate(1024 * 1024);
+    c10::setCPUCachingAllocatorEnabled(false);
+    // Freeing a cache-born block after disabling returns it to the OS
+    // instead of parking it.
+  }
+  EXPECT_EQ(c10::getCPUCachingAllocatorStats().cached_bytes, 0u);
+}
@@ -0,0 +1,19 @@
+#include <c10/core/impl/LeanEagerMode.h>
+
+#include <gtest/gtest.h>
+
+// The build-time C10_LEAN_EAGER flavor pins the mode on; only the
+// runtime flavor can be toggled.
+#ifndef C10_LEAN_EAGER
+
+TEST(LeanEagerModeTest, DisabledByDefaultAndToggleable) {
+  EXPECT_FALSE(c10::impl::lean_eager_mode_enabled());
+
+  c10::impl::set_lean_eager_mode_enabled(true);
+  EXPECT_TRUE(c10::impl::lean_eager_mode_enabled());
+
+  c10::impl::set_lean_eager_mode_enabled(false);
+  EXPECT_FALSE(c10::impl::lean_eager_mode_enabled());
+}
+
+#endif
@@ -418,3 +418,93 @@ TEST(SizesAndStridesTest, MoveAssignmentSelf) {
   selfMove(big, big);
   checkBig(big);
 }
+
+// See Note [Geometry interning] in SizesAndStrides.cpp.
+static const std::vector<int64_t> internedSizes = {2, 3, 4, 5, 6, 7, 8};
+static const std::vector<int64_t> internedStrides = {
+    20160, 6720, 1680, 336, 56, 8, 1};
+
+static SizesAndStrides makeInterned() {
+  SizesAndStrides sz;
+  sz.set_interned_sizes_and_strides(
+      SymIntArrayRef::fromIntArrayRef(internedSizes),
+      SymIntArrayRef::fromIntArrayRef(internedStrides));
+  return sz;
+}
+
+TEST(SizesAndStridesTest, InternedRoundTrip) {
+  SizesAndStrides sz = makeInterned();
+  EXPECT_TRUE(sz.isInterned());
+  checkData(sz, internedSizes, internedStrides);
+}
+
+TEST(SizesAndStridesTest, InternedSharesRecord) {
+  SizesAndStrides a = makeInterned();
+  SizesAndStrides b = makeInterned();
+  // Same geometry resolves to the same shared record.
+  EXPECT_EQ(a.sizes_arrayref().data(), b.sizes_arrayref().data());
+
+  // Copies of interned instances share it too.
+  SizesAndStrides c = a;
+  EXPECT_TRUE(c.isInterned());
+  EXPECT_EQ(a.sizes_arrayref().data(), c.sizes_arrayref().data());
+  checkData(c, internedSizes, internedStrides);
+}
+
+TEST(SizesAndStridesTest, InternedInlineStaysInline) {
+  SizesAndStrides sz;
+  sz.set_interned_sizes_and_strides(
+      SymIntArrayRef::fromIntArrayRef({5, 6, 7}),
+      SymIntArrayRef::fromIntArrayRef({42, 7, 1}));
+  EXPECT_FALSE(sz.isInterned());
+  checkData(sz, {5, 6, 7}, {42, 7, 1});
+}
+
+TEST(SizesAndStridesTest, InternedMutationMaterializes) {
+  SizesAndStrides a = makeInterned();
+  SizesAndStrides b = a;
+
+  b.stride_at(0) = 1;
+  EXPECT_FALSE(b.isInterned());
+  std::vector<int64_t> mutatedStrides = internedStrides;
+  mutatedStrides[0] = 1;
+  checkData(b, internedSizes, mutatedStrides);
+
+  // The shared record (and hence `a`) is untouched.
+  EXPECT_TRUE(a.isInterned());
+  checkData(a, internedSizes, internedStrides);
+}
+
+TEST(SizesAndStridesTest, InternedResizeMaterializes) {
+  SizesAndStrides sz = makeInterned();
+
+  sz.resize(8);
+  EXPECT_FALSE(sz.isInterned());
+  EXPECT_EQ(sz.size(), 8);
+  for (const auto i : c10::irange(7)) {
+    EXPECT_EQ(sz.size_at(i), internedSizes[i]);
+    EXPECT_EQ(sz.stride_at(i), internedStrides[i]);
+  }
+  EXPECT_EQ(sz.size_at(7), 0);
+  EXPECT_EQ(sz.stride_at(7), 0);
+
+  sz.resize(3);
+  checkData(
+      sz,
+      {internedSizes[0], internedSizes[1], internedSizes[2]},
+      {internedStrides[0], internedStrides[1], internedStrides[2]});
+}
+
+TEST(SizesAndStridesTest, InternedAssignmentOverOwned) {
+  SizesAndStrides sz = makeBig();
+  checkBig(sz);
+
+  sz = makeInterned();
+  EXPECT_TRUE(sz.isInterned());
+  checkData(sz, internedSizes, internedStrides);
+
+  // And back from interned to owned.
+  sz = makeBig();
+  EXPECT_FALSE(sz.isInterned());
+  checkBig(sz);
+}
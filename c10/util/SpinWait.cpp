@@ -0,0 +1,30 @@
+#include <c10/util/SpinWait.h>
+
+#include <cstdlib>
+
+namespace c10 {
+
+namespace {
+
+// Roughly a microsecond or two of polling on current x86 cores; long enough
+// to cover intra-host collectives and short kernels, short enough that a
+// thread facing a genuinely long wait parks almost immediately.
+constexpr int64_t kDefaultWaitSpinCount = 1024;
+
+int64_t read_wait_spin_count() {
+  const char* value = std::getenv("TORCH_WAIT_SPIN_COUNT");
+  if (value == nullptr) {
+    return kDefaultWaitSpinCount;
+  }
+  const int64_t count = std::strtoll(value, nullptr, 10);
+  return count > 0 ? count : 0;
+}
+
+} // namespace
+
+int64_t wait_spin_count() {
+  static const int64_t count = read_wait_spin_count();
+  return count;
+}
+
+} // namespace c10
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <c10/macros/Macros.h>
+
+#include <cstdint>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+namespace c10 {
+
+/// The number of polling iterations wait-side code may burn before parking
+/// on a condition variable. Read once from the TORCH_WAIT_SPIN_COUNT
+/// environment variable; 0 disables spinning entirely.
+C10_API int64_t wait_spin_count();
+
+namespace detail {
+
+/// Tells the core we are in a spin loop, lowering its power draw and
+/// yielding pipeline resources to the sibling hyperthread.
+inline void cpu_pause() {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+  _mm_pause();
+#elif defined(__x86_64__) || defined(__i386__)
+  asm volatile("pause" ::: "memory");
+#elif defined(__aarch64__)
+  asm volatile("yield" ::: "memory");
+#endif
+}
+
+} // namespace detail
+
+/// Polls `ready` for up to wait_spin_count() iterations with a pause
+/// instruction between polls, and returns whether `ready` became true. This
+/// is the spin half of an adaptive spin-then-park wait: when the condition
+/// is typically satisfied within microseconds, spinning skips the futex
+/// round trip of parking on a condition variable. Callers must still fall
+/// back to their condition variable when this returns false (and may
+/// unconditionally take their lock afterwards - it is uncontended if the
+/// spin succeeded), so the policy never affects correctness, only latency.
+template <typename Ready>
+bool spin_wait(const Ready& ready) {
+  for (int64_t i = wait_spin_count(); i > 0; i--) {
+    if (ready()) {
+      return true;
+    }
+    detail::cpu_pause();
+  }
+  return false;
+}
+
+} // namespace c10
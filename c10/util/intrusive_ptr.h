@@ -193,10 +193,14 @@ TTarget* assign_ptr_(TTarget* rhs) {
   }
 }
 
-// Increment needs to be acquire-release to make use_count() and
-// unique() reliable.
+// Increment can be relaxed: a thread can only increment a refcount it
+// already holds a reference through, so the object is known to be alive and
+// no later operation is ordered against the increment. This is the same
+// argument std::shared_ptr implementations use. All ordering needed by
+// use_count()/unique() readers is supplied by their own acquire loads
+// paired with the release in the decrement.
 inline size_t atomic_refcount_increment(std::atomic<size_t>& refcount) {
-  return refcount.fetch_add(1, std::memory_order_acq_rel) + 1;
+  return refcount.fetch_add(1, std::memory_order_relaxed) + 1;
 }
 
 // weak_use_count() is only used for testing, so we don't need it to
@@ -275,8 +279,24 @@ class intrusive_ptr final {
   }
 
   void reset_() noexcept {
-    if (target_ != NullType::singleton() &&
-        detail::atomic_refcount_decrement(target_->refcount_) == 0) {
+    if (target_ == NullType::singleton()) {
+      return;
+    }
+    // Uniquely-owned fast path: if we hold the only strong reference and no
+    // weak references exist (weakcount is 1, i.e. just the implicit +1 from
+    // refcount > 0), then no other thread can observe or revive the object,
+    // so it can be freed with plain stores instead of locked RMW
+    // instructions. Short-lived temporaries - the common case in the
+    // interpreter loop - take this path. The acquire loads pair with the
+    // releases of whichever threads dropped their references earlier.
+    if (target_->refcount_.load(std::memory_order_acquire) == 1 &&
+        target_->weakcount_.load(std::memory_order_acquire) == 1) {
+      // ~intrusive_ptr_target debug-asserts refcount == 0 on destruction.
+      target_->refcount_.store(0, std::memory_order_relaxed);
+      delete target_;
+      return;
+    }
+    if (detail::atomic_refcount_decrement(target_->refcount_) == 0) {
       // See comment above about weakcount. As long as refcount>0,
       // weakcount is one larger than the actual number of weak references.
       // So we need to decrement it here.
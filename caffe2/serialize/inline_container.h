@@ -1,13 +1,20 @@
 #pragma once
 
 #include <cerrno>
+#include <condition_variable>
 #include <cstdio>
 #include <cstring>
+#include <deque>
 #include <fstream>
 #include <istream>
+#include <memory>
 #include <mutex>
 #include <ostream>
+#include <thread>
+#include <unordered_map>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include <c10/core/Allocator.h>
 #include <c10/core/Backend.h>
@@ -90,6 +97,22 @@ typedef struct mz_zip_archive mz_zip_archive;
 // model.json as the last file when writing after we have accumulated all
 // other information.
 
+// -- Tensor section (opt-in) --
+// Storing every tensor as its own zip record interleaves local file headers
+// with payloads, which defeats readahead and direct I/O on cold-start loads.
+// When PyTorchStreamWriter::setTensorSectionEnabled(true) is set, tensor
+// records (uncompressed records under "data/" or "tensors/") are instead
+// coalesced into a single stored record, ".data/tensor_section", whose
+// payload starts at a 4KB file offset and holds every tensor payload
+// back-to-back, each padded to a 4KB boundary. A compact binary index
+// record, ".data/tensor_section.index", maps record names to
+// (offset-in-section, size). PyTorchStreamReader consults the index
+// transparently: the section is bulk-read once with a few large sequential
+// reads on first access, and getRecord() returns views into the shared
+// buffer, so per-tensor seeks disappear. The archive stays a valid zip, but
+// readers predating the index record cannot see the bundled tensors, so the
+// layout is opt-in.
+
 namespace caffe2 {
 namespace serialize {
 
@@ -101,7 +124,16 @@ class TORCH_API PyTorchStreamReader final {
 
   // return dataptr, size
   std::tuple<at::DataPtr, size_t> getRecord(const std::string& name);
+  // In-place version of getRecord() that reads the payload into a
+  // caller-provided buffer `dst` of capacity `n` (which must be at least
+  // getRecordSize(name)) and returns the record size. Stored records are
+  // read straight from the archive into `dst`, with no intermediate copy.
+  size_t getRecord(const std::string& name, void* dst, size_t n);
   size_t getRecordOffset(const std::string& name);
+  size_t getRecordSize(const std::string& name);
+  // whether the record is stored uncompressed, i.e. its payload can be read
+  // directly at getRecordOffset()
+  bool isRecordStored(const std::string& name);
   bool hasRecord(const std::string& name);
   std::vector<std::string> getAllRecords();
 
@@ -115,6 +147,23 @@ class TORCH_API PyTorchStreamReader final {
   size_t read(uint64_t pos, char* buf, size_t n);
   void valid(const char* what, const char* info = "");
   size_t getRecordID(const std::string& name);
+  // Offset of a record's payload, given its local header offset. Requires
+  // reader_lock_.
+  uint64_t recordDataOffset(uint64_t local_header_ofs);
+  // Reads a stored (uncompressed) record's payload directly into `dst`,
+  // bypassing miniz's extract path, and verifies its crc32 across worker
+  // threads. Requires reader_lock_.
+  void readStoredRecord(
+      uint64_t data_ofs,
+      char* dst,
+      uint64_t size,
+      uint32_t expected_crc,
+      const std::string& name);
+  // See "Tensor section" in the format comment above. The index is parsed
+  // once at init(); the section payload is bulk-read lazily on the first
+  // access to a bundled record.
+  void loadTensorSectionIndex();
+  void ensureTensorSectionLoaded();
 
   friend size_t
   istream_read_func(void* pOpaque, uint64_t file_ofs, void* pBuf, size_t n);
@@ -124,6 +173,84 @@ class TORCH_API PyTorchStreamReader final {
   std::shared_ptr<ReadAdapterInterface> in_;
   int64_t version_;
   std::mutex reader_lock_;
+
+  struct TensorSectionEntry {
+    uint64_t offset; // relative to the section payload start
+    uint64_t size;
+  };
+  std::unordered_map<std::string, TensorSectionEntry> tensor_section_index_;
+  uint64_t tensor_section_offset_ = 0;
+  uint64_t tensor_section_size_ = 0;
+  // Shared so that record views handed out by getRecord() can outlive the
+  // reader.
+  std::shared_ptr<at::DataPtr> tensor_section_data_;
+};
+
+// Restores checkpoints that were split across several archives ("shards").
+// All shards are opened up front and their record lists are merged into one
+// index, so callers address records by name without knowing the sharding.
+// Reads are serviced by a small reader thread pool with an N-deep prefetch
+// window that runs ahead of the consumer in index order: consecutive
+// getRecord() calls pull records whose payloads are already in flight on
+// other shards, so restore bandwidth aggregates across files instead of
+// draining one archive at a time. A record name may appear in only one
+// shard. Thread-safe to the same degree as PyTorchStreamReader; out-of-order
+// getRecord() calls are correct, they just don't benefit from the window.
+class TORCH_API PyTorchShardedReader final {
+ public:
+  explicit PyTorchShardedReader(
+      const std::vector<std::string>& shard_file_names,
+      size_t num_reader_threads = 4,
+      size_t prefetch_window = 8);
+  explicit PyTorchShardedReader(
+      std::vector<std::shared_ptr<PyTorchStreamReader>> shards,
+      size_t num_reader_threads = 4,
+      size_t prefetch_window = 8);
+
+  ~PyTorchShardedReader();
+
+  bool hasRecord(const std::string& name);
+  // Records of all shards, in shard order; this is also the order the
+  // prefetcher runs ahead in.
+  std::vector<std::string> getAllRecords();
+  std::tuple<at::DataPtr, size_t> getRecord(const std::string& name);
+  size_t getRecordSize(const std::string& name);
+
+  size_t shardCount() const {
+    return shards_.size();
+  }
+  // Highest format version among the shards.
+  uint64_t version() const;
+
+ private:
+  struct PrefetchedRecord {
+    std::tuple<at::DataPtr, size_t> value;
+    std::exception_ptr error;
+  };
+
+  void readerLoop();
+  // Tops the prefetch window back up, scheduling records at and after
+  // cursor_ until window slots run out. Requires state_lock_.
+  void schedulePrefetchLocked();
+
+  std::vector<std::shared_ptr<PyTorchStreamReader>> shards_;
+  size_t prefetch_window_;
+
+  std::unordered_map<std::string, size_t> record_to_shard_;
+  std::unordered_map<std::string, size_t> record_pos_;
+  std::vector<std::string> record_order_;
+
+  // Guards everything below.
+  std::mutex state_lock_;
+  std::condition_variable work_cv_;
+  std::condition_variable done_cv_;
+  std::deque<std::string> work_queue_;
+  std::unordered_set<std::string> inflight_;
+  std::unordered_map<std::string, PrefetchedRecord> done_;
+  // Index into record_order_ of the next record to schedule.
+  size_t cursor_ = 0;
+  bool stopping_ = false;
+  std::vector<std::thread> reader_threads_;
 };
 
 class TORCH_API PyTorchStreamWriter final {
@@ -134,6 +261,12 @@ class TORCH_API PyTorchStreamWriter final {
 
   void setMinVersion(const uint64_t version);
 
+  // Coalesce uncompressed tensor records into a single 4KB-aligned section
+  // record, see "Tensor section" in the format comment above. Must be set
+  // before the first tensor record is written; archives produced this way
+  // require a reader that understands the section index.
+  void setTensorSectionEnabled(bool enabled);
+
   void writeRecord(
       const std::string& name,
       const void* data,
@@ -156,8 +289,18 @@ class TORCH_API PyTorchStreamWriter final {
  private:
   void setup(const std::string& file_name);
   void valid(const char* what, const char* info = "");
+  void writeLocalRecord(
+      const std::string& name,
+      const void* data,
+      size_t size,
+      bool compress,
+      size_t alignment);
+  void flushTensorSection();
   size_t current_pos_ = 0;
   std::unordered_set<std::string> files_written_;
+  bool tensor_section_enabled_ = false;
+  // Buffered (name, payload) pairs awaiting flushTensorSection().
+  std::vector<std::pair<std::string, std::string>> pending_tensor_records_;
   std::unique_ptr<mz_zip_archive> ar_;
   std::string archive_name_;
   std::string archive_name_plus_slash_;
@@ -184,13 +327,24 @@ namespace detail {
 // Writer-specific constants
 constexpr uint64_t kFieldAlignment = 64;
 
+// Alignment of the tensor section payload (both its file offset and the
+// offsets of the bundled records inside it), chosen to match the common
+// filesystem block size so the section can be read with direct I/O.
+constexpr uint64_t kTensorSectionAlignment = 4096;
+
+// Record names used by the tensor section layout.
+constexpr const char* kTensorSectionRecordName = ".data/tensor_section";
+constexpr const char* kTensorSectionIndexRecordName =
+    ".data/tensor_section.index";
+
 // Returns a record to be appended to the local user extra data entry in order
-// to make data beginning aligned at kFieldAlignment bytes boundary.
+// to make data beginning aligned at an `alignment` bytes boundary.
 size_t getPadding(
     size_t cursor,
     size_t filename_size,
     size_t size,
-    std::string& padding_buf);
+    std::string& padding_buf,
+    size_t alignment = kFieldAlignment);
 } // namespace detail
 
 } // namespace serialize
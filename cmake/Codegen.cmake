@@ -258,7 +258,20 @@ if(INTERN_BUILD_ATEN_OPS)
     if(MSVC)
       list(APPEND CPU_CAPABILITY_FLAGS "${OPT_FLAG}/arch:AVX512")
     else(MSVC)
-      list(APPEND CPU_CAPABILITY_FLAGS "${OPT_FLAG} -mavx512f -mavx512bw -mavx512vl -mavx512dq -mfma")
+      set(CPU_AVX512_FLAGS "-mavx512f -mavx512bw -mavx512vl -mavx512dq -mfma")
+      # Native fp16 arithmetic (Sapphire Rapids and newer). Opt-in because
+      # AVX512 kernels built with it require AVX512-FP16 at runtime; like
+      # ATEN_AVX512_256, this trusts the builder to know the target machines.
+      if(DEFINED ENV{ATEN_AVX512_FP16})
+        if($ENV{ATEN_AVX512_FP16} MATCHES "TRUE")
+          check_cxx_compiler_flag("-mavx512fp16" COMPILER_SUPPORTS_AVX512FP16)
+          if(COMPILER_SUPPORTS_AVX512FP16)
+            message("-- ATen AVX512 kernels will use native fp16 arithmetic")
+            string(APPEND CPU_AVX512_FLAGS " -mavx512fp16")
+          endif(COMPILER_SUPPORTS_AVX512FP16)
+        endif()
+      endif()
+      list(APPEND CPU_CAPABILITY_FLAGS "${OPT_FLAG} ${CPU_AVX512_FLAGS}")
     endif(MSVC)
   endif(CXX_AVX512_FOUND)
 
@@ -4,6 +4,7 @@
 #include <ATen/core/op_registration/op_registration.h>
 #include <torch/torch.h>
 
+#include <torch/csrc/autograd/activation_offload.h>
 #include <torch/csrc/autograd/functions/basic_ops.h>
 
 #include <test/cpp/api/support.h>
@@ -1028,6 +1029,25 @@ TEST(CustomAutogradTest, BackwardWithCreateGraphWarns) {
   }
 }
 
+TEST(CustomAutogradTest, ActivationOffloadPassesThroughCpuTensors) {
+  // CPU tensors never qualify for offloading, so with the engine enabled the
+  // saved tensors take the hooks path as passthroughs and gradients must be
+  // unchanged. The CUDA round trip is exercised in test_autograd.py.
+  ASSERT_FALSE(ActivationOffloadEngine::enabled());
+  ActivationOffloadEngine::set_enabled(true);
+
+  Variable x = torch::randn({5, 5}, torch::requires_grad());
+  Variable y = torch::randn({5, 5}, torch::requires_grad());
+  auto res = simple_fn(x, y);
+  // Saved for backward while offloading is enabled, backward after disabling
+  // it: the hooks captured at save time must keep working.
+  ActivationOffloadEngine::set_enabled(false);
+  res.sum().backward();
+
+  ASSERT_VARIABLE_EQ(x.grad(), y + torch::ones({5, 5}));
+  ASSERT_VARIABLE_EQ(y.grad(), x + torch::ones({5, 5}) * 2);
+}
+
 /**
  * Tests for AutogradNotImplementedFallback
  * - Check that we created the NotImplemented kernel when inputs require grad
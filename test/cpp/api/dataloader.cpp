@@ -10,6 +10,7 @@
 
 #include <algorithm>
 #include <chrono>
+#include <fstream>
 #include <future>
 #include <iostream>
 #include <iterator>
@@ -60,6 +61,59 @@ TEST(DataTest, TransformCallsGetApplyCorrectly) {
   ASSERT_EQ(batch, expected);
 }
 
+TEST(DataTest, CSVDatasetParsesColumns) {
+  auto tempfile = c10::make_tempfile();
+  {
+    std::ofstream stream(tempfile.name);
+    stream << "x,y,label\n";
+    stream << "0.5,-1.25,0\n";
+    stream << "2,3e2,1\n";
+    stream << "-4.75,0.125,2\n";
+  }
+
+  datasets::CSV dataset(
+      tempfile.name,
+      datasets::CSVOptions().header(true).column_types(
+          {torch::kFloat32, torch::kFloat32, torch::kInt64}));
+
+  ASSERT_EQ(dataset.size().value(), 3);
+  ASSERT_EQ(dataset.columns().size(), 3);
+  ASSERT_TRUE(dataset.columns()[0].allclose(
+      torch::tensor({0.5f, 2.0f, -4.75f})));
+  ASSERT_TRUE(dataset.columns()[1].allclose(
+      torch::tensor({-1.25f, 300.0f, 0.125f})));
+  ASSERT_TRUE(dataset.columns()[2].equal(
+      torch::tensor({0, 1, 2}, torch::kInt64)));
+
+  auto example = dataset.get(1);
+  ASSERT_TRUE(example.data.allclose(torch::tensor({2.0f, 300.0f})));
+  ASSERT_EQ(example.target.item<int64_t>(), 1);
+}
+
+TEST(DataTest, CSVDatasetWorksWithDataLoader) {
+  auto tempfile = c10::make_tempfile();
+  {
+    std::ofstream stream(tempfile.name);
+    for (const auto i : c10::irange(10)) {
+      stream << i << "\t" << i * 2 << "\n";
+    }
+  }
+
+  auto dataset = datasets::CSV(
+                     tempfile.name, datasets::CSVOptions().delimiter('\t'))
+                     .map(transforms::Stack<>());
+  auto data_loader = make_data_loader(
+      std::move(dataset), DataLoaderOptions().batch_size(5));
+
+  size_t rows = 0;
+  for (auto& batch : *data_loader) {
+    ASSERT_EQ(batch.data.size(0), 5);
+    ASSERT_TRUE(batch.target.allclose(batch.data.squeeze(1) * 2));
+    rows += batch.data.size(0);
+  }
+  ASSERT_EQ(rows, 10);
+}
+
 // dummy chunk data reader with 3 chunks and 35 examples in total. Each chunk
 // contains 10, 5, 20 examples respectively.
 
@@ -940,6 +994,123 @@ TEST(DataTest, CanSaveAndLoadDistributedRandomSampler) {
   }
 }
 
+TEST(DataTest, DistributedStatelessRandomSamplerProducesPermutation) {
+  size_t sample_count = 10;
+  samplers::DistributedStatelessRandomSampler sampler(sample_count);
+
+  std::vector<size_t> res;
+  torch::optional<std::vector<size_t>> idx;
+  while ((idx = sampler.next(3)).has_value()) {
+    res.insert(std::end(res), std::begin(*idx), std::end(*idx));
+  }
+
+  ASSERT_EQ(res.size(), sample_count);
+
+  std::sort(res.begin(), res.end());
+  for (const auto i : c10::irange(res.size())) {
+    ASSERT_EQ(res[i], i);
+  }
+}
+
+TEST(DataTest, DistributedStatelessRandomSamplerMultiReplica) {
+  size_t sample_count = 10;
+  size_t num_replicas = 3;
+
+  auto test_function = [&](bool allow_duplicates,
+                           size_t local_sample_count,
+                           std::vector<size_t>& output,
+                           size_t batch_size) {
+    std::vector<std::unique_ptr<samplers::DistributedStatelessRandomSampler>>
+        samplers;
+
+    for (const auto i : c10::irange(num_replicas)) {
+      samplers.emplace_back(
+          torch::make_unique<samplers::DistributedStatelessRandomSampler>(
+              sample_count, num_replicas, i, allow_duplicates));
+    }
+
+    std::vector<size_t> res;
+    for (const auto i : c10::irange(num_replicas)) {
+      (*samplers[i]).reset();
+      torch::optional<std::vector<size_t>> idx;
+      while ((idx = (*samplers[i]).next(batch_size)).has_value()) {
+        res.insert(std::end(res), std::begin(*idx), std::end(*idx));
+      }
+      ASSERT_EQ(res.size(), local_sample_count * (i + 1));
+    }
+    std::sort(res.begin(), res.end());
+    ASSERT_EQ(res, output);
+  };
+
+  for (size_t batch_size = 1; batch_size <= 3; ++batch_size) {
+    size_t local_sample_count =
+        static_cast<size_t>(std::ceil(sample_count * 1.0 / num_replicas));
+    std::vector<size_t> output1{0, 0, 1, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    test_function(true, local_sample_count, output1, batch_size);
+
+    local_sample_count =
+        static_cast<size_t>(std::floor(sample_count * 1.0 / num_replicas));
+    std::vector<size_t> output2{0, 1, 2, 3, 4, 5, 6, 7, 8};
+    test_function(false, local_sample_count, output2, batch_size);
+  }
+}
+
+TEST(DataTest, DistributedStatelessRandomSamplerEpochChangesOrder) {
+  size_t sample_count = 100;
+  samplers::DistributedStatelessRandomSampler sampler(sample_count);
+
+  auto drain = [&] {
+    std::vector<size_t> res;
+    torch::optional<std::vector<size_t>> idx;
+    while ((idx = sampler.next(10)).has_value()) {
+      res.insert(std::end(res), std::begin(*idx), std::end(*idx));
+    }
+    return res;
+  };
+
+  auto epoch0 = drain();
+  sampler.set_epoch(1);
+  sampler.reset();
+  auto epoch1 = drain();
+
+  ASSERT_NE(epoch0, epoch1);
+  std::sort(epoch1.begin(), epoch1.end());
+  for (const auto i : c10::irange(epoch1.size())) {
+    ASSERT_EQ(epoch1[i], i);
+  }
+}
+
+TEST(DataTest, CanSaveAndLoadDistributedStatelessRandomSampler) {
+  {
+    samplers::DistributedStatelessRandomSampler a(10);
+    a.set_epoch(3);
+    a.next(3);
+    a.next(4);
+    ASSERT_EQ(a.index(), 7);
+    std::stringstream stream;
+    torch::save(a, stream);
+
+    samplers::DistributedStatelessRandomSampler b(10);
+    torch::load(b, stream);
+    ASSERT_EQ(b.epoch(), 3);
+    ASSERT_EQ(b.index(), 7);
+    // resuming is O(1): the restored sampler continues the exact sequence
+    auto rest_a = a.next(3);
+    auto rest_b = b.next(3);
+    ASSERT_TRUE(rest_a.has_value() && rest_b.has_value());
+    ASSERT_EQ(*rest_a, *rest_b);
+  }
+  {
+    // index_at addresses any position without advancing the cursor
+    samplers::DistributedStatelessRandomSampler a(10);
+    auto batch = a.next(10);
+    ASSERT_TRUE(batch.has_value());
+    for (const auto i : c10::irange(batch->size())) {
+      ASSERT_EQ((*batch)[i], a.index_at(i));
+    }
+  }
+}
+
 TEST(DataTest, DistributedSequentialSamplerSingleReplicaProduceCorrectSamples) {
   size_t sample_count = 10;
   size_t batch_size = 3;
@@ -1468,6 +1639,108 @@ TEST(DataLoaderTest, TestExceptionsArePropagatedFromWorkers) {
   }
 }
 
+TEST(DataLoaderTest, PipelinedDataLoaderOptionsCoalesceOptionalValues) {
+  auto options = PipelinedDataLoaderOptions(32).load_workers(4);
+  FullPipelinedDataLoaderOptions full(options);
+  ASSERT_EQ(full.batch_size, 32);
+  ASSERT_EQ(full.load_workers, 4);
+  ASSERT_EQ(full.collate_workers, 0);
+  ASSERT_EQ(full.readahead, 8);
+  ASSERT_FALSE(full.pin_memory);
+}
+
+TEST(DataLoaderTest, PipelinedDataLoaderYieldsOrderedPostprocessedBatches) {
+  DummyDataset dataset(20);
+  auto data_loader = torch::data::make_pipelined_data_loader(
+      dataset,
+      samplers::SequentialSampler(dataset.size().value()),
+      PipelinedDataLoaderOptions(4).load_workers(2).collate_workers(2),
+      [](std::vector<int> batch) {
+        for (auto& value : batch) {
+          value *= 10;
+        }
+        return batch;
+      });
+  std::vector<int> output;
+  for (auto& batch : *data_loader) {
+    output.insert(output.end(), batch.begin(), batch.end());
+  }
+  std::vector<int> expected;
+  for (const auto i : c10::irange(size_t(20))) {
+    expected.push_back((1 + i) * 10);
+  }
+  ASSERT_EQ(output, expected);
+}
+
+TEST(DataLoaderTest, PipelinedDataLoaderRunsCollateInlineWithoutWorkers) {
+  DummyDataset dataset(10);
+  auto data_loader = torch::data::make_pipelined_data_loader(
+      dataset,
+      samplers::SequentialSampler(dataset.size().value()),
+      PipelinedDataLoaderOptions(5).load_workers(1),
+      [](std::vector<int> batch) {
+        for (auto& value : batch) {
+          value += 100;
+        }
+        return batch;
+      });
+  std::vector<int> output;
+  for (auto& batch : *data_loader) {
+    output.insert(output.end(), batch.begin(), batch.end());
+  }
+  std::vector<int> expected(10);
+  std::iota(expected.begin(), expected.end(), 101);
+  ASSERT_EQ(output, expected);
+}
+
+TEST(DataLoaderTest, PipelinedDataLoaderPopulatesStageStats) {
+  DummyDataset dataset(12);
+  auto data_loader = torch::data::make_pipelined_data_loader(
+      dataset,
+      samplers::SequentialSampler(dataset.size().value()),
+      PipelinedDataLoaderOptions(4).load_workers(2).collate_workers(1),
+      [](std::vector<int> batch) { return batch; });
+  for (auto& batch : *data_loader) {
+    (void)batch;
+  }
+  auto stats = data_loader->stats();
+  ASSERT_EQ(stats.load.batches, 3);
+  ASSERT_EQ(stats.collate.batches, 3);
+}
+
+TEST(DataLoaderTest, PipelinedDataLoaderPropagatesExceptionsFromBothStages) {
+  struct D : datasets::Dataset<D, int> {
+    int get(size_t index) override {
+      throw std::invalid_argument("badness");
+    }
+    torch::optional<size_t> size() const override {
+      return 100;
+    }
+  };
+
+  {
+    auto data_loader = torch::data::make_pipelined_data_loader(
+        D{},
+        samplers::RandomSampler(100),
+        PipelinedDataLoaderOptions().load_workers(2));
+    auto iterator = data_loader->begin();
+    // NOLINTNEXTLINE(hicpp-avoid-goto,cppcoreguidelines-avoid-goto)
+    ASSERT_THROW((void)*iterator, torch::data::WorkerException);
+  }
+  {
+    auto data_loader = torch::data::make_pipelined_data_loader(
+        DummyDataset{},
+        samplers::RandomSampler(100),
+        PipelinedDataLoaderOptions().load_workers(2).collate_workers(1),
+        [](std::vector<int> batch) -> std::vector<int> {
+          throw std::invalid_argument("collate badness");
+        });
+    auto iterator = data_loader->begin();
+    // NOLINTNEXTLINE(hicpp-avoid-goto,cppcoreguidelines-avoid-goto)
+    ASSERT_THROW((void)*iterator, torch::data::WorkerException);
+  }
+}
+
 TEST(DataLoaderTest, StatefulDatasetWithNoWorkers) {
   const int kNumberOfExamplesAfterWhichTheDatasetExhausts = 10;
 
@@ -525,3 +525,28 @@ TEST(OptimTest, CheckLRChange_StepLR_Adam) {
 
   check_lr_change(optimizer, step_lr_scheduler, expected_epoch_lrs);
 }
+
+TEST(OptimTest, AdamStateSharesArenaSlab) {
+  std::vector<torch::Tensor> params = {
+      torch::randn({4, 4}, torch::requires_grad()),
+      torch::randn({16}, torch::requires_grad())};
+  Adam optimizer(params, AdamOptions().lr(1e-3));
+
+  (params[0].sum() + params[1].sum()).backward();
+  optimizer.step();
+
+  auto& state_0 = static_cast<AdamParamState&>(
+      *optimizer.state()[c10::guts::to_string(params[0].unsafeGetTensorImpl())]);
+  auto& state_1 = static_cast<AdamParamState&>(
+      *optimizer.state()[c10::guts::to_string(params[1].unsafeGetTensorImpl())]);
+
+  // All the state tensors are views into one shared slab.
+  ASSERT_TRUE(state_0.exp_avg().is_alias_of(state_0.exp_avg_sq()));
+  ASSERT_TRUE(state_0.exp_avg().is_alias_of(state_1.exp_avg()));
+  ASSERT_EQ(state_0.exp_avg().sizes(), params[0].sizes());
+  ASSERT_EQ(state_1.exp_avg().sizes(), params[1].sizes());
+
+  // The views update independently of one another.
+  ASSERT_TRUE(state_0.exp_avg().allclose(params[0].grad() * 0.1));
+  ASSERT_TRUE(state_1.exp_avg().allclose(params[1].grad() * 0.1));
+}
@@ -687,6 +687,44 @@ void testRecv(const std::string& path) {
   EXPECT_TRUE(recvCompleted);
 }
 
+void testSendRecvFutureChaining(const std::string& path) {
+  const auto size = 2;
+  auto tests = CollectiveTest::initialize(path, size);
+  constexpr uint64_t tag = 0x1338;
+
+  // Receiver: chain a continuation on the point-to-point work instead
+  // of polling wait() from a watcher thread.
+  std::thread recvThread([&]() {
+    auto& pg = tests[1].getProcessGroup();
+    std::vector<at::Tensor> tensors = {
+        at::zeros({16, 16}),
+    };
+    auto recvWork = pg.recv(tensors, /*srcRank=*/0, tag);
+    auto chained = recvWork->then(
+        [](c10::ivalue::Future& fut) { return fut.value(); },
+        c10::ListType::create(c10::TensorType::get()));
+    recvWork->wait();
+    chained->wait();
+    EXPECT_TRUE(chained->hasValue());
+    auto result = chained->value().toTensorVector();
+    EXPECT_TRUE(result[0].equal(at::ones({16, 16})));
+  });
+
+  std::thread sendThread([&]() {
+    auto& pg = tests[0].getProcessGroup();
+    std::vector<at::Tensor> tensors = {
+        at::ones({16, 16}),
+    };
+    auto sendWork = pg.send(tensors, /*dstRank=*/1, tag);
+    auto fut = sendWork->getFuture();
+    sendWork->wait();
+    EXPECT_TRUE(fut->completed());
+  });
+
+  sendThread.join();
+  recvThread.join();
+}
+
 void testStoreSetGet(const std::string& path) {
   const auto size = 2;
   auto tests = CollectiveTest::initialize(path, size);
@@ -788,6 +826,13 @@ TEST(ProcessGroupGlooTest, testRecv) {
   }
 }
 
+TEST(ProcessGroupGlooTest, testSendRecvFutureChaining) {
+  {
+    TemporaryFile file;
+    testSendRecvFutureChaining(file.path);
+  }
+}
+
 TEST(ProcessGroupGlooTest, testStoreSetGet) {
   TemporaryFile file;
   testStoreSetGet(file.path);
@@ -196,5 +196,27 @@ TEST(ArgumentSpecTest, Basic_CUDA) {
   ASSERT_EQ(spec.count(c), 1);
 }
 
+TEST(ArgumentSpecTest, MemoryFormatClassKey) {
+  auto nchw = at::randn({2, 3, 4, 5});
+  auto nhwc = nchw.contiguous(at::MemoryFormat::ChannelsLast);
+  ASSERT_EQ(memoryFormatClassOf(nchw), MemoryFormatClass::Contiguous);
+  ASSERT_EQ(memoryFormatClassOf(nhwc), MemoryFormatClass::ChannelsLast);
+  ASSERT_EQ(
+      memoryFormatClassOf(nchw.transpose(1, 2)), MemoryFormatClass::Other);
+  ASSERT_EQ(
+      memoryFormatClassOf(
+          at::randn({2, 3, 4, 5, 6})
+              .contiguous(at::MemoryFormat::ChannelsLast3d)),
+      MemoryFormatClass::ChannelsLast3d);
+
+  auto key = [](const std::vector<IValue>& inputs) {
+    return memoryFormatClassKey(inputs);
+  };
+  // The key only looks at the format class, not at values or shapes.
+  ASSERT_EQ(key({nchw, 1.0}), key({at::randn({1, 8, 2, 2}), 2.0}));
+  ASSERT_NE(key({nchw}), key({nhwc}));
+  ASSERT_NE(key({nchw, nhwc}), key({nhwc, nchw}));
+}
+
 } // namespace jit
 } // namespace torch
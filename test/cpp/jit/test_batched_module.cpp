@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+
+#include <torch/csrc/jit/api/batched_module.h>
+#include <torch/csrc/jit/api/module.h>
+#include <torch/torch.h>
+
+namespace torch {
+namespace jit {
+
+static Module makeScaleModule() {
+  Module m("m");
+  m.register_parameter("scale", torch::tensor({2.0}), /*is_buffer=*/false);
+  m.define(R"JIT(
+def forward(self, x: Tensor) -> Tensor:
+    return x * self.scale
+)JIT");
+  return m;
+}
+
+TEST(BatchedModuleTest, ScattersBatchedResults) {
+  auto m = makeScaleModule();
+  BatchedModuleOptions options;
+  options.max_batch_size = 4;
+  options.max_latency = std::chrono::microseconds(200);
+  BatchedModule batched(m, options);
+
+  auto a = torch::rand({1, 3});
+  auto b = torch::rand({2, 3});
+  auto fut_a = batched.forward({a});
+  auto fut_b = batched.forward({b});
+  fut_a->wait();
+  fut_b->wait();
+
+  ASSERT_FALSE(fut_a->hasError());
+  ASSERT_FALSE(fut_b->hasError());
+  ASSERT_TRUE(fut_a->value().toTensor().equal(a * 2.0));
+  ASSERT_TRUE(fut_b->value().toTensor().equal(b * 2.0));
+}
+
+TEST(BatchedModuleTest, RunsOversizedRequestAlone) {
+  auto m = makeScaleModule();
+  BatchedModuleOptions options;
+  options.max_batch_size = 2;
+  BatchedModule batched(m, options);
+
+  auto x = torch::rand({5, 3});
+  auto fut = batched.forward({x});
+  fut->wait();
+
+  ASSERT_FALSE(fut->hasError());
+  ASSERT_TRUE(fut->value().toTensor().equal(x * 2.0));
+}
+
+TEST(BatchedModuleTest, ScattersTupleResults) {
+  Module m("m");
+  m.define(R"JIT(
+def forward(self, x: Tensor) -> Tuple[Tensor, Tensor]:
+    return x + 1, x - 1
+)JIT");
+  BatchedModule batched(m);
+
+  auto x = torch::rand({2, 4});
+  auto y = torch::rand({3, 4});
+  auto fut_x = batched.forward({x});
+  auto fut_y = batched.forward({y});
+  fut_x->wait();
+  fut_y->wait();
+
+  auto elements = fut_y->value().toTupleRef().elements();
+  ASSERT_EQ(elements.size(), 2);
+  ASSERT_TRUE(elements[0].toTensor().equal(y + 1));
+  ASSERT_TRUE(elements[1].toTensor().equal(y - 1));
+}
+
+TEST(BatchedModuleTest, ForwardsErrorsToEveryFuture) {
+  Module m("m");
+  m.define(R"JIT(
+def forward(self, x: Tensor) -> Tensor:
+    return x.reshape([-1, 7])
+)JIT");
+  BatchedModule batched(m);
+
+  auto fut_a = batched.forward({torch::rand({1, 3})});
+  auto fut_b = batched.forward({torch::rand({1, 3})});
+  fut_a->wait();
+  fut_b->wait();
+
+  ASSERT_TRUE(fut_a->hasError());
+  ASSERT_TRUE(fut_b->hasError());
+}
+
+TEST(BatchedModuleTest, RejectsInputsBelowBatchDim) {
+  auto m = makeScaleModule();
+  BatchedModuleOptions options;
+  options.batch_dim = 1;
+  BatchedModule batched(m, options);
+
+  // NOLINTNEXTLINE(cppcoreguidelines-avoid-goto,hicpp-avoid-goto)
+  ASSERT_THROW(batched.forward({torch::rand({3})}), c10::Error);
+}
+
+} // namespace jit
+} // namespace torch
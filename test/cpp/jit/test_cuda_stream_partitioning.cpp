@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+
+#include <test/cpp/jit/test_utils.h>
+#include <torch/csrc/jit/ir/irparser.h>
+#include <torch/csrc/jit/passes/cuda_stream_partitioning.h>
+
+namespace torch {
+namespace jit {
+
+TEST(CudaStreamPartitioningTest, IndependentChains) {
+  const auto src = R"IR(
+        graph(%a: Tensor, %b: Tensor):
+            %x1: Tensor = aten::relu(%a)
+            %x2: Tensor = aten::relu(%x1)
+            %x3: Tensor = aten::relu(%x2)
+            %y1: Tensor = aten::tanh(%b)
+            %y2: Tensor = aten::tanh(%y1)
+            %y3: Tensor = aten::tanh(%y2)
+            return (%x3, %y3)
+    )IR";
+
+  auto graph = std::make_shared<Graph>();
+  parseIR(src, graph.get());
+  EXPECT_TRUE(CudaStreamPartitioning(graph));
+
+  // Two independent chains: one keeps the current stream, the other is
+  // wrapped in a begin/end pair.
+  testing::FileCheck()
+      .check_count("= cuda::_side_stream_begin", 1, /*exactly*/ true)
+      ->check_count("cuda::_side_stream_end", 1, /*exactly*/ true)
+      ->run(*graph);
+}
+
+TEST(CudaStreamPartitioningTest, BranchesOffSharedTrunk) {
+  const auto src = R"IR(
+        graph(%a: Tensor):
+            %t1: Tensor = aten::relu(%a)
+            %t2: Tensor = aten::relu(%t1)
+            %t3: Tensor = aten::relu(%t2)
+            %h1: Tensor = aten::exp(%t3)
+            %h2: Tensor = aten::exp(%h1)
+            %h3: Tensor = aten::exp(%h2)
+            %g1: Tensor = aten::tanh(%t3)
+            %g2: Tensor = aten::tanh(%g1)
+            %g3: Tensor = aten::tanh(%g2)
+            return (%h3, %g3)
+    )IR";
+
+  auto graph = std::make_shared<Graph>();
+  parseIR(src, graph.get());
+  EXPECT_TRUE(CudaStreamPartitioning(graph));
+
+  // The trunk has no sibling, so only one of the two heads moves to a
+  // side stream.
+  testing::FileCheck()
+      .check_count("= cuda::_side_stream_begin", 1, /*exactly*/ true)
+      ->check_count("cuda::_side_stream_end", 1, /*exactly*/ true)
+      ->run(*graph);
+}
+
+TEST(CudaStreamPartitioningTest, SingleChainUntouched) {
+  const auto src = R"IR(
+        graph(%a: Tensor):
+            %x1: Tensor = aten::relu(%a)
+            %x2: Tensor = aten::relu(%x1)
+            %x3: Tensor = aten::relu(%x2)
+            return (%x3)
+    )IR";
+
+  auto graph = std::make_shared<Graph>();
+  parseIR(src, graph.get());
+  EXPECT_FALSE(CudaStreamPartitioning(graph));
+
+  testing::FileCheck()
+      .check_count("cuda::_side_stream_begin", 0, /*exactly*/ true)
+      ->run(*graph);
+}
+
+} // namespace jit
+} // namespace torch
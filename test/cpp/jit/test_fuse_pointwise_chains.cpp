@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+
+#include <test/cpp/jit/test_utils.h>
+#include <torch/csrc/jit/ir/irparser.h>
+#include <torch/csrc/jit/passes/fuse_pointwise_chains.h>
+#include <torch/csrc/jit/testing/file_check.h>
+
+namespace torch {
+namespace jit {
+using namespace testing;
+
+TEST(FusePointwiseChainsTest, FusesSilu) {
+  auto graph = std::make_shared<Graph>();
+  parseIR(
+      R"IR(
+graph(%x : Tensor):
+  %s : Tensor = aten::sigmoid(%x)
+  %r : Tensor = aten::mul(%x, %s)
+  return (%r))IR",
+      graph.get());
+
+  FusePointwiseChains(graph);
+
+  FileCheck()
+      .check("aten::silu")
+      ->check_not("aten::sigmoid")
+      ->check_not("aten::mul")
+      ->run(*graph);
+}
+
+TEST(FusePointwiseChainsTest, FusesHardswish) {
+  auto graph = std::make_shared<Graph>();
+  parseIR(
+      R"IR(
+graph(%x : Tensor):
+  %s : Tensor = aten::hardsigmoid(%x)
+  %r : Tensor = aten::mul(%s, %x)
+  return (%r))IR",
+      graph.get());
+
+  FusePointwiseChains(graph);
+
+  FileCheck()
+      .check("aten::hardswish")
+      ->check_not("aten::hardsigmoid")
+      ->run(*graph);
+}
+
+TEST(FusePointwiseChainsTest, FusesAddcmul) {
+  auto graph = std::make_shared<Graph>();
+  parseIR(
+      R"IR(
+graph(%a : Tensor, %b : Tensor, %c : Tensor):
+  %alpha : int = prim::Constant[value=1]()
+  %t : Tensor = aten::mul(%b, %c)
+  %r : Tensor = aten::add(%a, %t, %alpha)
+  return (%r))IR",
+      graph.get());
+
+  FusePointwiseChains(graph);
+
+  FileCheck()
+      .check("aten::addcmul")
+      ->check_not("aten::add")
+      ->run(*graph);
+}
+
+TEST(FusePointwiseChainsTest, SkipsSharedIntermediate) {
+  auto graph = std::make_shared<Graph>();
+  // The sigmoid output has a second consumer, so the chain must stay
+  // unfused.
+  parseIR(
+      R"IR(
+graph(%x : Tensor):
+  %s : Tensor = aten::sigmoid(%x)
+  %r : Tensor = aten::mul(%x, %s)
+  %u : Tensor = aten::relu(%s)
+  return (%r, %u))IR",
+      graph.get());
+
+  FusePointwiseChains(graph);
+
+  FileCheck().check("aten::sigmoid")->check_not("aten::silu")->run(*graph);
+}
+
+TEST(FusePointwiseChainsTest, SkipsScalarOperand) {
+  auto graph = std::make_shared<Graph>();
+  // aten::mul here is the Tensor-Scalar overload; addcmul requires three
+  // tensors.
+  parseIR(
+      R"IR(
+graph(%a : Tensor, %b : Tensor, %c : float):
+  %alpha : int = prim::Constant[value=1]()
+  %t : Tensor = aten::mul(%b, %c)
+  %r : Tensor = aten::add(%a, %t, %alpha)
+  return (%r))IR",
+      graph.get());
+
+  FusePointwiseChains(graph);
+
+  FileCheck().check_not("aten::addcmul")->run(*graph);
+}
+
+} // namespace jit
+} // namespace torch
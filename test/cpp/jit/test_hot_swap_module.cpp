@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+
+#include <torch/csrc/jit/api/hot_swap_module.h>
+#include <torch/csrc/jit/api/module.h>
+#include <torch/torch.h>
+
+namespace torch {
+namespace jit {
+
+static Module makeScaleModule() {
+  Module m("m");
+  m.register_parameter("scale", torch::tensor({2.0}), /*is_buffer=*/false);
+  m.define(R"JIT(
+def forward(self, x: Tensor) -> Tensor:
+    return x * self.scale
+)JIT");
+  return m;
+}
+
+TEST(HotSwapModuleTest, SwapsWeightsBetweenCalls) {
+  HotSwapModule hot(makeScaleModule());
+  auto x = torch::rand({2, 3});
+
+  ASSERT_EQ(hot.version(), 0);
+  ASSERT_TRUE(hot.forward({x}).toTensor().equal(x * 2.0));
+
+  auto v = hot.update({{"scale", torch::tensor({3.0})}});
+  ASSERT_EQ(v, 1);
+  ASSERT_EQ(hot.version(), 1);
+  ASSERT_TRUE(hot.forward({x}).toTensor().equal(x * 3.0));
+}
+
+TEST(HotSwapModuleTest, PinnedGenerationSurvivesUpdate) {
+  HotSwapModule hot(makeScaleModule());
+  auto x = torch::rand({2, 3});
+
+  auto pinned = hot.weights();
+  hot.update({{"scale", torch::tensor({3.0})}});
+
+  // An in-flight request keeps running on the generation it pinned.
+  Module old_module = pinned->module;
+  ASSERT_EQ(pinned->version, 0);
+  ASSERT_TRUE(old_module.forward({x}).toTensor().equal(x * 2.0));
+  ASSERT_TRUE(hot.forward({x}).toTensor().equal(x * 3.0));
+}
+
+TEST(HotSwapModuleTest, UpdatesSubmoduleWeights) {
+  Module child("child");
+  child.register_parameter("bias", torch::tensor({1.0}), /*is_buffer=*/false);
+  Module m("m");
+  m.register_module("child", child);
+  m.register_parameter("scale", torch::tensor({2.0}), /*is_buffer=*/false);
+  m.define(R"JIT(
+def forward(self, x: Tensor) -> Tensor:
+    return x * self.scale + self.child.bias
+)JIT");
+
+  HotSwapModule hot(m);
+  auto x = torch::rand({2, 3});
+  hot.update(
+      {{"scale", torch::tensor({4.0})}, {"child.bias", torch::tensor({5.0})}});
+
+  ASSERT_TRUE(hot.forward({x}).toTensor().equal(x * 4.0 + 5.0));
+  // The original module is a different generation and stays untouched.
+  ASSERT_TRUE(m.forward({x}).toTensor().equal(x * 2.0 + 1.0));
+}
+
+TEST(HotSwapModuleTest, RejectsUnknownAndMismatchedWeights) {
+  HotSwapModule hot(makeScaleModule());
+
+  // NOLINTNEXTLINE(cppcoreguidelines-avoid-goto,hicpp-avoid-goto)
+  ASSERT_THROW(hot.update({{"missing", torch::tensor({1.0})}}), c10::Error);
+  // NOLINTNEXTLINE(cppcoreguidelines-avoid-goto,hicpp-avoid-goto)
+  ASSERT_THROW(hot.update({{"scale", torch::rand({4})}}), c10::Error);
+  // A failed update does not publish a new generation.
+  ASSERT_EQ(hot.version(), 0);
+}
+
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include <test/cpp/jit/test_utils.h>
+#include <torch/csrc/jit/ir/irparser.h>
+#include <torch/csrc/jit/passes/memory_format_propagation.h>
+#include <torch/csrc/jit/testing/file_check.h>
+
+namespace torch {
+namespace jit {
+using namespace testing;
+
+TEST(MemoryFormatPropagationTest, RemovesRepeatedContiguous) {
+  auto graph = std::make_shared<Graph>();
+  // memory_format 2 is ChannelsLast.
+  parseIR(
+      R"IR(
+graph(%x : Tensor):
+  %f : int = prim::Constant[value=2]()
+  %a : Tensor = aten::contiguous(%x, %f)
+  %b : Tensor = aten::contiguous(%a, %f)
+  return (%b))IR",
+      graph.get());
+
+  const auto removed = PropagateMemoryFormat(graph);
+
+  EXPECT_EQ(removed, 1);
+  FileCheck()
+      .check_count("aten::contiguous", 1, /*exactly=*/true)
+      ->run(*graph);
+}
+
+TEST(MemoryFormatPropagationTest, PropagatesThroughPointwiseOps) {
+  auto graph = std::make_shared<Graph>();
+  parseIR(
+      R"IR(
+graph(%x : Tensor):
+  %f : int = prim::Constant[value=2]()
+  %a : Tensor = aten::contiguous(%x, %f)
+  %r : Tensor = aten::relu(%a)
+  %s : Tensor = aten::sigmoid(%r)
+  %b : Tensor = aten::contiguous(%s, %f)
+  return (%b))IR",
+      graph.get());
+
+  const auto removed = PropagateMemoryFormat(graph);
+
+  EXPECT_EQ(removed, 1);
+  FileCheck()
+      .check_count("aten::contiguous", 1, /*exactly=*/true)
+      ->run(*graph);
+}
+
+TEST(MemoryFormatPropagationTest, KeepsConversionAcrossUnknownOps) {
+  auto graph = std::make_shared<Graph>();
+  // conv2d may change the layout, so the second contiguous must stay.
+  parseIR(
+      R"IR(
+graph(%x : Tensor, %w : Tensor, %b : Tensor?, %stride : int[], %pad : int[], %dil : int[], %groups : int):
+  %f : int = prim::Constant[value=2]()
+  %a : Tensor = aten::contiguous(%x, %f)
+  %c : Tensor = aten::conv2d(%a, %w, %b, %stride, %pad, %dil, %groups)
+  %out : Tensor = aten::contiguous(%c, %f)
+  return (%out))IR",
+      graph.get());
+
+  const auto removed = PropagateMemoryFormat(graph);
+
+  EXPECT_EQ(removed, 0);
+  FileCheck()
+      .check_count("aten::contiguous", 2, /*exactly=*/true)
+      ->run(*graph);
+}
+
+TEST(MemoryFormatPropagationTest, KeepsConversionToDifferentFormat) {
+  auto graph = std::make_shared<Graph>();
+  // format 0 is Contiguous, format 2 is ChannelsLast.
+  parseIR(
+      R"IR(
+graph(%x : Tensor):
+  %nchw : int = prim::Constant[value=0]()
+  %nhwc : int = prim::Constant[value=2]()
+  %a : Tensor = aten::contiguous(%x, %nhwc)
+  %b : Tensor = aten::contiguous(%a, %nchw)
+  return (%b))IR",
+      graph.get());
+
+  const auto removed = PropagateMemoryFormat(graph);
+
+  EXPECT_EQ(removed, 0);
+}
+
+} // namespace jit
+} // namespace torch
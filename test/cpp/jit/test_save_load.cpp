@@ -251,6 +251,31 @@ TEST(TestSourceRoundTrip,
   }
 }
 
+TEST(SerializationTest, MmapLoad) {
+  // Saves a module with a parameter to a temporary file and reloads it with
+  // mmap_storages=true; tensor contents must match the copying loader.
+  Module m("m");
+  m.register_parameter("foo", torch::randn({8, 8}), /*is_buffer=*/false);
+  m.define(R"(
+    def forward(self, x):
+        return self.foo + x
+  )");
+
+  auto tmp_path = std::tmpnam(nullptr);
+  m.save(tmp_path);
+
+  auto copied = torch::jit::load(tmp_path);
+  auto mapped = torch::jit::load(tmp_path, c10::nullopt, /*mmap_storages=*/true);
+
+  auto x = torch::randn({8, 8});
+  auto expect = copied.forward({x}).toTensor();
+  auto actual = mapped.forward({x}).toTensor();
+  AT_ASSERT(expect.allclose(actual));
+  AT_ASSERT(
+      copied.attr("foo").toTensor().equal(mapped.attr("foo").toTensor()));
+  std::remove(tmp_path);
+}
+
 TEST(SerializationTest, ParentDirNotExist) {
   expectThrowsEq(
       []() {
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+
+#include <ATen/MapAllocator.h>
+#include <torch/csrc/jit/api/module.h>
+#include <torch/csrc/jit/api/shared_weight_region.h>
+#include <torch/torch.h>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+Module makeAffineModule(double scale, double bias) {
+  Module child("child");
+  child.register_parameter("bias", torch::tensor({bias}), /*is_buffer=*/false);
+  Module m("m");
+  m.register_module("child", child);
+  m.register_parameter("scale", torch::tensor({scale}), /*is_buffer=*/false);
+  m.define(R"JIT(
+def forward(self, x: Tensor) -> Tensor:
+    return x * self.scale + self.child.bias
+)JIT");
+  return m;
+}
+
+} // namespace
+
+TEST(SharedWeightRegionTest, PublishAttachBindRoundTrip) {
+  const auto name = at::NewProcessWideShmHandle();
+  auto creator = SharedWeightRegion::publish(name, makeAffineModule(2.0, 1.0));
+
+  // A worker starts from its own copy of the model with different (e.g.
+  // freshly initialized) weights and binds the published ones.
+  auto worker = SharedWeightRegion::attach(name);
+  Module m = makeAffineModule(7.0, 7.0);
+  worker.verifyAll();
+  worker.bind(m);
+
+  auto x = torch::rand({2, 3});
+  ASSERT_TRUE(m.forward({x}).toTensor().equal(x * 2.0 + 1.0));
+  ASSERT_EQ(worker.generation(), creator.generation());
+  ASSERT_FALSE(worker.stale());
+}
+
+TEST(SharedWeightRegionTest, UpdatePropagatesThroughGeneration) {
+  const auto name = at::NewProcessWideShmHandle();
+  auto creator = SharedWeightRegion::publish(name, makeAffineModule(2.0, 1.0));
+  auto worker = SharedWeightRegion::attach(name);
+  Module m = makeAffineModule(0.0, 0.0);
+  worker.bind(m);
+
+  const auto before = worker.generation();
+  creator.update(makeAffineModule(3.0, 4.0));
+  ASSERT_TRUE(worker.stale());
+  worker.refresh();
+  ASSERT_FALSE(worker.stale());
+  ASSERT_GT(worker.generation(), before);
+
+  // The update rewrites the payload in place, so already-bound tensors
+  // observe the new weights; re-binding re-verifies the new hashes.
+  auto x = torch::rand({2, 3});
+  ASSERT_TRUE(m.forward({x}).toTensor().equal(x * 3.0 + 4.0));
+  worker.bind(m);
+  ASSERT_TRUE(m.forward({x}).toTensor().equal(x * 3.0 + 4.0));
+}
+
+TEST(SharedWeightRegionTest, RejectsMismatchedModule) {
+  const auto name = at::NewProcessWideShmHandle();
+  auto creator = SharedWeightRegion::publish(name, makeAffineModule(2.0, 1.0));
+  auto worker = SharedWeightRegion::attach(name);
+
+  // The worker's model lacks the submodule the manifest promises.
+  Module m("m");
+  m.register_parameter("scale", torch::tensor({1.0}), /*is_buffer=*/false);
+  // NOLINTNEXTLINE(cppcoreguidelines-avoid-goto,hicpp-avoid-goto)
+  ASSERT_THROW(worker.bind(m), c10::Error);
+
+  // Only the creator may publish a new generation.
+  // NOLINTNEXTLINE(cppcoreguidelines-avoid-goto,hicpp-avoid-goto)
+  ASSERT_THROW(worker.update(makeAffineModule(1.0, 1.0)), c10::Error);
+}
+
+TEST(SharedWeightRegionTest, RejectsUnknownRegion) {
+  // NOLINTNEXTLINE(cppcoreguidelines-avoid-goto,hicpp-avoid-goto)
+  ASSERT_THROW(
+      SharedWeightRegion::attach(at::NewProcessWideShmHandle()), c10::Error);
+}
+
+} // namespace jit
+} // namespace torch
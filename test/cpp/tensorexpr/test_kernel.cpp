@@ -921,6 +921,46 @@ TEST_F(Kernel, SumOneAxis) {
   }
 }
 
+TEST_F(Kernel, FuseIndependentReductions) {
+  // Two reductions over the same input share a single traversal of it even
+  // when a sibling loop with different bounds is present (which used to make
+  // horizontal fusion of the block give up entirely).
+  const auto graph_string = R"IR(
+      graph(%x : Float(5, 3, strides=[3, 1], device=cpu),
+            %y : Float(7, strides=[1], device=cpu)):
+        %dims : int[] = prim::Constant[value=[1]]()
+        %keepdim : bool = prim::Constant[value=0]()
+        %dtype : None = prim::Constant()
+        %xx : Float(5, 3, strides=[3, 1], device=cpu) = aten::mul(%x, %x)
+        %a : Float(5, strides=[1], device=cpu) = aten::sum(%x, %dims, %keepdim, %dtype)
+        %b : Float(5, strides=[1], device=cpu) = aten::sum(%xx, %dims, %keepdim, %dtype)
+        %c : Float(7, strides=[1], device=cpu) = aten::mul(%y, %y)
+        return (%a, %b, %c))IR";
+  auto graph = std::make_shared<Graph>();
+  parseIR(graph_string, &*graph);
+
+  auto x = iotaTensor({5, 3}, TensorOptions(kCPU).dtype(at::kFloat));
+  auto y = iotaTensor({7}, TensorOptions(kCPU).dtype(at::kFloat));
+
+  TensorExprKernel k(graph);
+  StmtPtr s = k.getCodeGenStmt();
+  std::ostringstream oss;
+  oss << *s;
+
+  // Unfused, the two sums are two loop nests of two loops each, plus one
+  // loop for %c: 5 loops. With their outer loops fused there are 4.
+  torch::jit::testing::FileCheck()
+      .check_count("for (", 4, /*exactly=*/true)
+      ->run(oss.str());
+
+  std::vector<IValue> stack =
+      fmap<IValue>(std::vector<at::Tensor>{x, y});
+  k.run(stack);
+  ASSERT_TRUE(at::allclose(stack[0].toTensor(), x.sum(1)));
+  ASSERT_TRUE(at::allclose(stack[1].toTensor(), (x * x).sum(1)));
+  ASSERT_TRUE(at::allclose(stack[2].toTensor(), y * y));
+}
+
 TEST_F(Kernel, SumMultipleAxes) {
   // Test lowering of sum on multiple axes.
   const auto graph_template = R"IR(
@@ -214,6 +214,19 @@ class TCPStoreTest(TestCase, StoreTestBase):
 
         rpc.shutdown()
 
+    def test_multi_set_get(self):
+        store = self._create_store()
+        store.multi_set(["key1", "key2", "key3"], ["value1", "value2", "value3"])
+        self.assertEqual(
+            store.multi_get(["key1", "key3", "key2"]),
+            [b"value1", b"value3", b"value2"],
+        )
+        # multi_set wakes up clients waiting on the keys like set does.
+        store.set_timeout(timedelta(seconds=10))
+        store.multi_set(["key4"], ["value4"])
+        store.wait(["key4"])
+        self.assertEqual(store.multi_get(["key4"]), [b"value4"])
+
     # The TCPStore has 6 keys in test_set_get. It contains the 5 keys added by
     # the user and one additional key used for coordinate all the workers.
     @property
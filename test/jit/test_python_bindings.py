@@ -108,3 +108,45 @@ graph(%p207 : Tensor,
         graph3 = torch._C.parse_ir(ir)
         graph3 = torch._C._jit_pass_canonicalize(graph3, False)
         FileCheck().check_not("%p207").run(graph3)
+
+    def test_output_conversion_plan_structures(self):
+        from typing import Dict, List, Optional, Tuple
+
+        class M(torch.nn.Module):
+            def forward(
+                self, x: torch.Tensor
+            ) -> Tuple[Dict[str, torch.Tensor], List[int], Optional[torch.Tensor]]:
+                d = {"a": x + 1, "b": x * 2}
+                return d, [1, 2, 3], None
+
+        m = torch.jit.script(M())
+        x = torch.randn(3)
+        d1, l1, o1 = m(x)
+        d2, l2, o2 = m(x)
+        self.assertEqual(d1["a"], x + 1)
+        self.assertEqual(d1["b"], x * 2)
+        self.assertEqual(l1, [1, 2, 3])
+        self.assertIsNone(o1)
+        self.assertEqual(d1, d2)
+        # string keys are interned across calls: the second call reuses the
+        # very same Python string objects
+        for k1, k2 in zip(d1.keys(), d2.keys()):
+            self.assertIs(k1, k2)
+
+    def test_output_conversion_plan_named_tuple(self):
+        from typing import NamedTuple
+
+        class Point(NamedTuple):
+            x: torch.Tensor
+            y: torch.Tensor
+
+        class M(torch.nn.Module):
+            def forward(self, x: torch.Tensor) -> Point:
+                return Point(x=x + 1, y=x - 1)
+
+        m = torch.jit.script(M())
+        x = torch.randn(2)
+        out = m(x)
+        # named tuples still take the generic conversion path
+        self.assertEqual(out.x, x + 1)
+        self.assertEqual(out.y, x - 1)
@@ -0,0 +1,91 @@
+# Owner(s): ["oncall: jit"]
+
+import os
+import sys
+
+import torch
+from torch.testing import FileCheck
+
+# Make the helper files in test/ importable
+pytorch_test_dir = os.path.dirname(os.path.dirname(os.path.realpath(__file__)))
+sys.path.append(pytorch_test_dir)
+from torch.testing._internal.jit_utils import JitTestCase
+
+if __name__ == '__main__':
+    raise RuntimeError("This test file is not meant to be run directly, use:\n\n"
+                       "\tpython test/test_jit.py TESTNAME\n\n"
+                       "instead.")
+
+
+class TestReinplaceOps(JitTestCase):
+    def test_reinplace_chain(self):
+        def fn(x, y):
+            return (x + y).mul(2).relu()
+
+        inputs = (torch.rand(4, 4), torch.rand(4, 4))
+        traced = torch.jit.trace(fn, inputs)
+        graph = traced.graph
+        self.assertTrue(torch._C._jit_pass_reinplace_ops(graph))
+        # The add reads the graph inputs so it must stay out-of-place, but
+        # its result is dead after the mul, which is dead after the relu.
+        FileCheck().check("aten::add(") \
+                   .check("aten::mul_") \
+                   .check("aten::relu_") \
+                   .run(graph)
+
+        x, y = torch.randn(4, 4), torch.randn(4, 4)
+        self.assertEqual(traced(x, y), fn(x, y))
+
+    def test_no_reinplace_when_input_live(self):
+        def fn(x):
+            y = x * 2
+            return y.relu() + y
+
+        traced = torch.jit.trace(fn, (torch.rand(4, 4),))
+        graph = traced.graph
+        torch._C._jit_pass_reinplace_ops(graph)
+        # y is still live after the relu, so the relu must not clobber it.
+        FileCheck().check_not("aten::relu_").run(graph)
+
+        x = torch.randn(4, 4)
+        self.assertEqual(traced(x), fn(x))
+
+    def test_no_reinplace_inside_loop_body(self):
+        # %y is a fresh tensor with a single use, but that use sits inside a
+        # loop body: in-placing it would mutate the captured tensor once per
+        # iteration. Tracing unrolls loops, so build the graph directly.
+        graph = torch._C.parse_ir("""
+graph(%x : Float(4, 4, strides=[4, 1], requires_grad=0, device=cpu),
+      %n : int):
+  %one : int = prim::Constant[value=1]()
+  %true : bool = prim::Constant[value=1]()
+  %y : Float(4, 4, strides=[4, 1], requires_grad=0, device=cpu) = aten::relu(%x)
+  %out : Float(4, 4, strides=[4, 1], requires_grad=0, device=cpu) = prim::Loop(%n, %true, %x)
+    block0(%i : int, %acc : Float(4, 4, strides=[4, 1], requires_grad=0, device=cpu)):
+      %z : Float(4, 4, strides=[4, 1], requires_grad=0, device=cpu) = aten::mul(%y, %one)
+      %next : Float(4, 4, strides=[4, 1], requires_grad=0, device=cpu) = aten::add(%acc, %z, %one)
+      -> (%true, %next)
+  return (%out)
+""")
+        torch._C._jit_pass_reinplace_ops(graph)
+        FileCheck().check("aten::mul(").check_not("aten::mul_").run(graph)
+
+        func = torch._C._create_function_from_graph("loop_fn", graph)
+        x = torch.randn(4, 4)
+        self.assertEqual(func(x, 3), x + 3 * x.relu())
+
+    def test_functionalize_then_reinplace(self):
+        def fn(x):
+            y = x + 1
+            y.mul_(2)
+            return y.relu()
+
+        traced = torch.jit.trace(fn, (torch.rand(4, 4),))
+        graph = traced.graph
+        self.assertTrue(torch._C._jit_pass_functionalize_then_reinplace(graph))
+        # The existing mutation is rewritten away and then restored where
+        # liveness allows it, alongside the newly in-placed relu.
+        FileCheck().check("aten::mul_").check("aten::relu_").run(graph)
+
+        x = torch.randn(4, 4)
+        self.assertEqual(traced(x), fn(x))
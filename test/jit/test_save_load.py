@@ -550,6 +550,57 @@ class TestSaveLoad(JitTestCase):
         self.assertTrue(m_buffers["buffer"].is_meta)
         self.assertTrue(m_loaded_buffers["buffer"].is_meta)
 
+    def test_storage_dedup_across_loads(self):
+        """
+        Check that identical weights are shared across loads when storage
+        deduplication is enabled, and copied when it is not.
+        """
+
+        class Foo(torch.nn.Module):
+            def __init__(self):
+                super().__init__()
+                self.fc = torch.nn.Linear(16, 16)
+
+            def forward(self, x):
+                return self.fc(x)
+
+        m = torch.jit.script(Foo())
+        buffer = io.BytesIO()
+        torch.jit.save(m, buffer)
+
+        # Disabled (the default): each load gets its own copy.
+        buffer.seek(0)
+        first = torch.jit.load(buffer)
+        buffer.seek(0)
+        second = torch.jit.load(buffer)
+        self.assertNotEqual(
+            first.fc.weight.data_ptr(), second.fc.weight.data_ptr()
+        )
+
+        torch._C._jit_set_storage_dedup_enabled(True)
+        try:
+            stats_before = torch._C._jit_storage_dedup_stats()
+            buffer.seek(0)
+            first = torch.jit.load(buffer)
+            buffer.seek(0)
+            second = torch.jit.load(buffer)
+            # The second load shares the first load's storages.
+            self.assertEqual(
+                first.fc.weight.data_ptr(), second.fc.weight.data_ptr()
+            )
+            self.assertEqual(
+                first.fc.bias.data_ptr(), second.fc.bias.data_ptr()
+            )
+            stats_after = torch._C._jit_storage_dedup_stats()
+            self.assertGreater(
+                stats_after["bytes_saved"], stats_before["bytes_saved"]
+            )
+            # Shared weights still produce the same results.
+            x = torch.rand(4, 16)
+            self.assertEqual(first(x), second(x))
+        finally:
+            torch._C._jit_set_storage_dedup_enabled(False)
+
 
 def script_module_to_buffer(script_module):
     module_buffer = io.BytesIO(
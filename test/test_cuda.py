@@ -292,6 +292,20 @@ class TestCuda(TestCase):
                 torch.cuda.caching_allocator_delete(mem)
                 self.assertEqual(torch.cuda.memory_allocated(), prev)
 
+    def test_alloc_trace(self):
+        gc.collect()
+        torch.cuda.empty_cache()
+        torch.cuda.memory._set_alloc_trace_max_entries(1024)
+        torch.cuda.memory._set_alloc_trace_enabled(True)
+        try:
+            x = torch.ones(4 * 1024, device='cuda')
+            trace = torch.cuda.memory._export_alloc_trace()
+            self.assertTrue(len(trace) > 0)
+            total_live = sum(int(line.rsplit(" ", 1)[1]) for line in trace.splitlines())
+            self.assertGreaterEqual(total_live, x.numel() * x.element_size())
+        finally:
+            torch.cuda.memory._set_alloc_trace_enabled(False)
+
     def test_check_error(self):
         # Assert this call doesn't raise.
         torch.cuda.check_error(0)
@@ -197,6 +197,26 @@ class TestTEFuser(JitTestCase):
     def test_nop(self):
         pass
 
+    def test_kernel_cache(self):
+        def func(x):
+            return (x + x) * x
+
+        # Same body as func, but a distinct function so scripting compiles
+        # it from scratch.
+        def func_clone(x):
+            return (x + x) * x
+
+        a = torch.ones(4, 4)
+        scripted = self.checkScript(func, (a,))
+        self.assertLastGraphAllFused()
+        before = torch._C._jit_texpr_kernel_cache_stats()
+        # An identical function specialized to the same shapes should hit
+        # the global kernel cache instead of recompiling.
+        rescripted = self.checkScript(func_clone, (a,))
+        self.assertLastGraphAllFused()
+        after = torch._C._jit_texpr_kernel_cache_stats()
+        self.assertGreater(after["hits"], before["hits"])
+
     def test_sum_dim(self):
         def func(x):
             return x.sum((0, )) * 2
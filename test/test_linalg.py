@@ -5901,6 +5901,25 @@ scipy_lobpcg  | {:10.2e}  | {:10.2e}  | {:6} | N/A
                     self.assertRaises(RuntimeError, lambda: torch.bmm(b1.cpu(), b2))
                     self.assertRaises(RuntimeError, lambda: torch.bmm(b1, b2, out=res2.cpu()))
 
+    @onlyCPU
+    @dtypes(torch.float32, torch.float64)
+    def test_bmm_batch_parallel(self, device, dtype):
+        # Large batches of small matrices (attention-head shapes) take a
+        # batch-parallel GEMM path on CPU; check it against a per-matrix
+        # reference, including transposed layouts and baddbmm.
+        num_batches = max(512, 4 * torch.get_num_threads())
+        M, N, O = 64, 48, 32
+        b1 = make_tensor((num_batches, M, N), dtype=dtype, device=device, low=-1, high=1)
+        b2 = make_tensor((num_batches, N, O), dtype=dtype, device=device, low=-1, high=1)
+        expect = torch.stack([b1[i] @ b2[i] for i in range(num_batches)])
+        for m1, m2 in itertools.product(
+                (b1, b1.transpose(1, 2).contiguous().transpose(1, 2)),
+                (b2, b2.transpose(1, 2).contiguous().transpose(1, 2))):
+            self.assertEqual(torch.bmm(m1, m2), expect)
+        t = make_tensor((num_batches, M, O), dtype=dtype, device=device, low=-1, high=1)
+        self.assertEqual(torch.baddbmm(t, b1, b2, beta=0.5, alpha=2),
+                         0.5 * t + 2 * expect)
+
     def _test_addbmm_baddbmm(self, func, b1, b2, ref, out_tensor):
         getattr(out_tensor, func + "_")(b1, b2)
         self.assertEqual(out_tensor, ref)
@@ -322,6 +322,27 @@ class TestNestedTensorDeviceType(TestCase):
             self.assertEqual(t1, t2)
         self.assertEqual(nt.device, nt_to.device)
 
+    @dtypes(torch.float)
+    @skipMeta
+    def test_nested_from_buffer(self, device, dtype):
+        ts = [torch.randn(n, 4, device=device, dtype=dtype) for n in (3, 1, 2)]
+        buffer = torch.cat([t.reshape(-1) for t in ts])
+        nested_size = torch.tensor([[3, 4], [1, 4], [2, 4]])
+        nt = torch._nested_from_buffer(buffer, nested_size)
+
+        for (t1, t2) in zip(nt.unbind(), ts):
+            self.assertEqual(t1, t2)
+        self.assertEqual(nt.device, buffer.device)
+
+        # the wrap is zero-copy: writes to the buffer are visible in the
+        # nested tensor
+        buffer.mul_(2)
+        for (t1, t2) in zip(nt.unbind(), ts):
+            self.assertEqual(t1, t2 * 2)
+
+        self.assertRaises(
+            RuntimeError, lambda: torch._nested_from_buffer(buffer[:-1], nested_size))
+
     @dtypes(torch.float)
     @dtypesIfCUDA(torch.float, torch.half)
     @skipMeta
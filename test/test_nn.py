@@ -7627,6 +7627,36 @@ tensor(..., device='meta', size=(1,), requires_grad=True)""")
             unpacked_sequences = rnn_utils.unpack_sequence(packed_sequences)
             self.assertEqual(sequences, unpacked_sequences)
 
+    def test_pack_sequence_concat(self):
+        # _pack_sequence_concat packs concatenated varlen data in a single
+        # gather; check it against pack_sequence on the same sequences.
+        lengths = [10, 8, 4, 2, 2, 2, 1]
+        sequences = [torch.randn(l, 5) for l in lengths]
+        concat = torch.cat(sequences)
+        data, batch_sizes = torch.ops.aten._pack_sequence_concat(
+            concat, torch.tensor(lengths))
+        expected = rnn_utils.pack_sequence(sequences, enforce_sorted=True)
+        self.assertEqual(data, expected.data)
+        self.assertEqual(batch_sizes, expected.batch_sizes)
+
+        # round trip back to the concatenated layout
+        unpacked, unpacked_lengths = torch.ops.aten._unpack_sequence_concat(
+            data, batch_sizes)
+        self.assertEqual(unpacked, concat)
+        self.assertEqual(unpacked_lengths, torch.tensor(lengths))
+
+        # gradients flow through the gather
+        concat.requires_grad_()
+        data, _ = torch.ops.aten._pack_sequence_concat(concat, torch.tensor(lengths))
+        data.sum().backward()
+        self.assertEqual(concat.grad, torch.ones_like(concat))
+
+        # lengths must be sorted in decreasing order
+        self.assertRaises(
+            RuntimeError,
+            lambda: torch.ops.aten._pack_sequence_concat(
+                concat.detach(), torch.tensor(sorted(lengths))))
+
     def test_pack_padded_sequence(self):
         def generate_test_case(sorted_lengths, should_shuffle):
             def pad(tensor, length):
@@ -9708,6 +9738,38 @@ tensor(..., device='meta', size=(1,), requires_grad=True)""")
             helper(self, shape, torch.bfloat16, False)
             helper(self, shape, torch.bfloat16, True)
 
+    def test_batchnorm_relu_fused_nhwc_cpu(self):
+        def helper(self, size, dtype, training, memory_format):
+            channels = size[1]
+            input = torch.randn(size, dtype=dtype, device='cpu')
+            input = input.contiguous(memory_format=memory_format)
+            weight = torch.rand(channels, dtype=dtype)
+            bias = torch.rand(channels, dtype=dtype)
+            running_mean = torch.zeros(channels, dtype=dtype)
+            running_var = torch.ones(channels, dtype=dtype)
+            ref_running_mean = running_mean.clone()
+            ref_running_var = running_var.clone()
+
+            out, save_mean, save_invstd = torch._batch_norm_with_relu(
+                input, weight, bias, running_mean, running_var, training, 0.1, 1e-5)
+            ref_out, ref_save_mean, ref_save_invstd = torch.native_batch_norm(
+                input, weight, bias, ref_running_mean, ref_running_var, training, 0.1, 1e-5)
+            ref_out = ref_out.relu()
+
+            self.assertTrue(out.is_contiguous(memory_format=memory_format))
+            self.assertEqual(out, ref_out)
+            self.assertEqual(save_mean, ref_save_mean)
+            self.assertEqual(save_invstd, ref_save_invstd)
+            self.assertEqual(running_mean, ref_running_mean)
+            self.assertEqual(running_var, ref_running_var)
+
+        # test NC11; test the non-channels-last fallback
+        for shape in [(4, 8, 10, 10), (4, 9, 1, 1)]:
+            for dtype in [torch.float, torch.bfloat16]:
+                for training in [False, True]:
+                    helper(self, shape, dtype, training, torch.channels_last)
+                    helper(self, shape, dtype, training, torch.contiguous_format)
+
     def test_batchnorm_non_contig_cpu(self):
         input = torch.arange(6, dtype=torch.float).reshape(1, 3, 2, 1).cpu()
         input = input.permute(0, 2, 1, 3)
@@ -10685,6 +10747,36 @@ tensor(..., device='meta', size=(1,), requires_grad=True)""")
                             with cudnn.flags(enabled=False):
                                 test(N, C, H, W, mode, padding_mode, align_corners, input_requires_grad)
 
+    def test_grid_sample_reused_grid(self):
+        # Repeated sampling with the same grid takes a compiled-grid fast path
+        # on CPU (see NOTE [ Compiled grid sampling ]); results must stay
+        # consistent with the first (uncompiled) call and track both in-place
+        # grid mutations and fresh inputs.
+        for padding_mode in ('zeros', 'border', 'reflection'):
+            for align_corners in (True, False):
+                input = torch.randn(2, 3, 8, 8)
+                grid = torch.rand(2, 5, 7, 2) * 2.5 - 1.25
+                reference = F.grid_sample(input, grid, mode='bilinear', padding_mode=padding_mode,
+                                          align_corners=align_corners)
+                for _ in range(3):
+                    out = F.grid_sample(input, grid, mode='bilinear', padding_mode=padding_mode,
+                                        align_corners=align_corners)
+                    self.assertEqual(out, reference)
+
+                # A new input through the same grid must be resampled.
+                input2 = torch.randn(2, 3, 8, 8)
+                out2 = F.grid_sample(input2, grid, mode='bilinear', padding_mode=padding_mode,
+                                     align_corners=align_corners)
+                self.assertEqual(out2, F.grid_sample(input2.clone(), grid.clone(), mode='bilinear',
+                                                     padding_mode=padding_mode, align_corners=align_corners))
+
+                # In-place mutation of the grid must invalidate the table.
+                grid.mul_(0.5)
+                out3 = F.grid_sample(input, grid, mode='bilinear', padding_mode=padding_mode,
+                                     align_corners=align_corners)
+                self.assertEqual(out3, F.grid_sample(input, grid.clone(), mode='bilinear',
+                                                     padding_mode=padding_mode, align_corners=align_corners))
+
     def test_grid_sample_3d(self):
         # Backward pass of native C++ and CUDA kernels branch depending on whether input requires gradient,
         # so we test both cases.
@@ -11921,6 +12013,43 @@ tensor(..., device='meta', size=(1,), requires_grad=True)""")
 
             self.assertEqual(grads1, grads2, rtol=rtol, atol=atol)
 
+    def test_fused_dropout_add_layer_norm(self):
+        # The fused op must match dropout -> residual add -> layer_norm
+        # composed from the reference ops, reusing the mask it returns.
+        for shape, normalized_shape in [((4, 4, 16), (16,)), ((8, 32), (32,))]:
+            for p in [0.0, 0.5]:
+                x = torch.randn(shape, requires_grad=True)
+                r = torch.randn(shape, requires_grad=True)
+                w = torch.randn(normalized_shape, requires_grad=True)
+                b = torch.randn(normalized_shape, requires_grad=True)
+                y, mask, _, _ = torch._fused_dropout_add_layer_norm(
+                    x, r, normalized_shape, w, b, p, True, 1e-5)
+
+                x_ref, r_ref, w_ref, b_ref = (
+                    t.detach().clone().requires_grad_() for t in (x, r, w, b))
+                scale = 1.0 / (1.0 - p)
+                z = x_ref * mask * scale + r_ref
+                y_ref = F.layer_norm(z, normalized_shape, w_ref, b_ref, 1e-5)
+                self.assertEqual(y, y_ref)
+
+                gy = torch.randn_like(y)
+                y.backward(gy)
+                y_ref.backward(gy)
+                self.assertEqual(x.grad, x_ref.grad)
+                self.assertEqual(r.grad, r_ref.grad)
+                self.assertEqual(w.grad, w_ref.grad)
+                self.assertEqual(b.grad, b_ref.grad)
+
+        # train=False is deterministic, so the full op is gradcheckable.
+        x = torch.randn(3, 8, dtype=torch.double, requires_grad=True)
+        r = torch.randn(3, 8, dtype=torch.double, requires_grad=True)
+        w = torch.randn(8, dtype=torch.double, requires_grad=True)
+        b = torch.randn(8, dtype=torch.double, requires_grad=True)
+        gradcheck(
+            lambda x, r, w, b: torch._fused_dropout_add_layer_norm(
+                x, r, (8,), w, b, 0.5, False, 1e-5)[0],
+            (x, r, w, b))
+
     def test_padding_list(self):
         # Padding can be a list, or tuple (regression test for gh-54452)
         x = torch.randn(4, 8, 32, 32)
@@ -840,6 +840,24 @@ class TestSerialization(TestCase, SerializationMixin):
             torch.save(model, path)
             torch.load(path)
 
+    def test_async_save(self):
+        state = {'weight': torch.randn(10, 20), 'step': 3}
+
+        with TemporaryFileName() as fname:
+            handle = torch.serialization._async_save(state, fname)
+            handle.wait()
+            self.assertTrue(handle.done())
+            result = torch.load(fname)
+            self.assertEqual(result, state)
+
+            # The snapshot must not observe mutations made after the call
+            # returns.
+            handle = torch.serialization._async_save(state, fname)
+            state['weight'].add_(1)
+            handle.wait()
+            result = torch.load(fname)
+            self.assertEqual(result['weight'], state['weight'] - 1)
+
     def test_meta_serialization(self):
         big_model = torch.nn.Conv2d(20000, 320000, kernel_size=3, device='meta')
 
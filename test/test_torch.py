@@ -2273,6 +2273,22 @@ else:
             # values such as nan or inf
             assert torch.isfinite(x.grad).all()
 
+    @skipIfMps
+    def test_cumsum_cumprod_parallel_scan(self, device):
+        # Long contiguous rows take the blocked parallel scan on CPU; compare
+        # against the serial per-row kernel, reached by scanning the same data
+        # along a non-contiguous dimension.
+        n = 100000
+        x = torch.randn(n, device=device)
+        self.assertEqual(torch.cumsum(x, 0), x.view(-1, 1).cumsum(0).view(-1))
+        self.assertEqual(
+            torch.cumprod(x, 0), x.view(-1, 1).cumprod(0).view(-1), atol=0.1, rtol=0.1)
+        self.assertEqual(
+            torch.logcumsumexp(x, 0), x.view(-1, 1).logcumsumexp(0).view(-1))
+
+        ix = torch.randint(-100, 100, (n,), dtype=torch.int64, device=device)
+        self.assertEqual(torch.cumsum(ix, 0), ix.view(-1, 1).cumsum(0).view(-1))
+
     @skipIfMps
     def test_cumsum(self, device):
         x = torch.rand(100, 100, device=device)
@@ -3652,6 +3668,21 @@ else:
                 torch.masked_select(v, m, out=out_dc)
                 self.assertEqual(out_dc, expected, atol=0, rtol=0)
 
+    # FIXME: find a test suite for the masked select operator
+    def test_masked_select_parallel_contiguous(self, device):
+        # Large contiguous inputs take the chunked two-pass compaction path
+        # on CPU; check it against boolean advanced indexing for assorted
+        # mask densities, including the all-false and all-true edges.
+        numel = 100000
+        src = torch.randn(numel, device=device)
+        for density in (0.0, 0.03, 0.5, 1.0):
+            mask = torch.rand(numel, device=device) < density
+            expected = src[mask]
+            self.assertEqual(torch.masked_select(src, mask), expected, atol=0, rtol=0)
+            out = torch.empty(0, device=device)
+            torch.masked_select(src, mask, out=out)
+            self.assertEqual(out, expected, atol=0, rtol=0)
+
     # FIXME: find a test suite for the masked fill operator
     @dtypes(*product(all_types_and_complex_and(torch.half, torch.bool, torch.bfloat16), (torch.uint8, torch.bool)))
     def test_masked_fill(self, device, dtypes):
@@ -6001,6 +6032,28 @@ class TestTorch(TestCase):
         self.assertTrue(torch.equal(s1, s3))
         self.assertFalse(torch.equal(s1, s4))
 
+    def test_fast_hash(self):
+        t = torch.randn(4, 4)
+
+        # Stable for an unmodified tensor, for both variants.
+        self.assertEqual(t.fast_hash(), t.fast_hash())
+        self.assertEqual(torch.fast_hash(t), t.fast_hash())
+
+        # Sensitive to metadata: views over the same storage hash differently.
+        self.assertNotEqual(t.fast_hash(), t.t().fast_hash())
+        self.assertNotEqual(t.fast_hash(), t[1:].fast_hash())
+
+        # In-place mutation changes the hash.
+        before = t.fast_hash()
+        t.add_(1)
+        self.assertNotEqual(before, t.fast_hash())
+
+        # Unsupported inputs.
+        q = torch._empty_affine_quantized([4], scale=1.0, zero_point=0, dtype=torch.qint8)
+        self.assertRaises(RuntimeError, lambda: q.fast_hash())
+        s = torch.sparse_coo_tensor(torch.zeros(2, 0, dtype=torch.long), torch.zeros(0), (2, 2))
+        self.assertRaises(RuntimeError, lambda: s.fast_hash())
+
     def test_element_size(self):
         byte = torch.ByteStorage().element_size()
         char = torch.CharStorage().element_size()
@@ -650,6 +650,167 @@ class TestTransformers(NNTestCase):
         self.assertEqual(result.shape, ref_output.shape)
         torch.testing.assert_close(result, ref_output, atol=1e-3, rtol=1e-2)
 
+    @parametrize("dtype", [torch.float32, torch.float64])
+    @parametrize("is_causal", [False, True])
+    def test_scaled_dot_product_attention_cpu_fused_matches_math(self, dtype, is_causal):
+        def math_sdp(q, k, v, is_causal):
+            attn = q @ k.transpose(-2, -1) / (q.size(-1) ** 0.5)
+            if is_causal:
+                mask = torch.ones(q.size(-2), k.size(-2), dtype=torch.bool).tril()
+                attn = attn.masked_fill(mask.logical_not(), float("-inf"))
+            return attn.softmax(-1) @ v
+
+        # (batch/head dims, M, N, E) including a decode-style single query
+        shapes = [((2, 3), 65, 65, 32), ((1, 2), 1, 128, 64), ((2,), 130, 257, 16)]
+        for batch_dims, M, N, E in shapes:
+            if is_causal and N != M:
+                # the causal math reference above assumes square attention
+                N = M
+            q = torch.randn(*batch_dims, M, E, dtype=dtype)
+            k = torch.randn(*batch_dims, N, E, dtype=dtype)
+            v = torch.randn(*batch_dims, N, E, dtype=dtype)
+            with torch.no_grad():
+                out, _ = torch._scaled_dot_product_attention(q, k, v, is_causal=is_causal)
+            ref = math_sdp(q, k, v, is_causal)
+            torch.testing.assert_close(out, ref, atol=1e-4, rtol=1e-4)
+
+    @staticmethod
+    def _banded_math_sdp(q, k, v, window_left, window_right):
+        M, N = q.size(-2), k.size(-2)
+        offset = N - M
+        rows = torch.arange(M).unsqueeze(1) + offset
+        cols = torch.arange(N).unsqueeze(0)
+        dist = cols - rows
+        mask = (dist >= -window_left) & (dist <= window_right)
+        attn = q @ k.transpose(-2, -1) / (q.size(-1) ** 0.5)
+        attn = attn.masked_fill(mask.logical_not(), float("-inf"))
+        return attn.softmax(-1) @ v
+
+    @parametrize("dtype", [torch.float32, torch.float64])
+    def test_banded_attention_matches_masked_math(self, dtype):
+        # (batch/head dims, M, N, E, window_left, window_right), mixing
+        # symmetric, asymmetric and cross-attention (M != N) bands
+        shapes = [
+            ((2, 3), 65, 65, 32, 8, 8),
+            ((1, 2), 60, 124, 16, 16, 0),
+            ((2,), 130, 130, 16, 0, 5),
+            ((1, 2), 300, 300, 8, 32, 32),
+        ]
+        for batch_dims, M, N, E, wl, wr in shapes:
+            q = torch.randn(*batch_dims, M, E, dtype=dtype)
+            k = torch.randn(*batch_dims, N, E, dtype=dtype)
+            v = torch.randn(*batch_dims, N, E, dtype=dtype)
+            with torch.no_grad():
+                out = torch._banded_scaled_dot_product_attention(q, k, v, wl, wr)
+            ref = self._banded_math_sdp(q, k, v, wl, wr)
+            torch.testing.assert_close(out, ref, atol=1e-4, rtol=1e-4)
+
+    def test_banded_attention_chunked_path_supports_grad(self):
+        q = torch.randn(2, 2, 48, 8, requires_grad=True)
+        k = torch.randn(2, 2, 48, 8, requires_grad=True)
+        v = torch.randn(2, 2, 48, 8, requires_grad=True)
+        out = torch._banded_scaled_dot_product_attention(q, k, v, 4, 4)
+        out.sum().backward()
+
+        q_ref = q.detach().clone().requires_grad_()
+        k_ref = k.detach().clone().requires_grad_()
+        v_ref = v.detach().clone().requires_grad_()
+        ref = self._banded_math_sdp(q_ref, k_ref, v_ref, 4, 4)
+        ref.sum().backward()
+
+        torch.testing.assert_close(out, ref, atol=1e-4, rtol=1e-4)
+        torch.testing.assert_close(q.grad, q_ref.grad, atol=1e-4, rtol=1e-4)
+        torch.testing.assert_close(k.grad, k_ref.grad, atol=1e-4, rtol=1e-4)
+        torch.testing.assert_close(v.grad, v_ref.grad, atol=1e-4, rtol=1e-4)
+
+    def test_scaled_dot_product_attention_routes_banded_mask(self):
+        M = N = 128
+        wl, wr = 8, 8
+        rows = torch.arange(M).unsqueeze(1)
+        cols = torch.arange(N).unsqueeze(0)
+        dist = cols - rows
+        mask = (dist >= -wl) & (dist <= wr)
+        q = torch.randn(2, 2, M, 16)
+        k = torch.randn(2, 2, N, 16)
+        v = torch.randn(2, 2, N, 16)
+        with torch.no_grad():
+            out, _ = torch._scaled_dot_product_attention(q, k, v, attn_mask=mask)
+        ref = self._banded_math_sdp(q, k, v, wl, wr)
+        torch.testing.assert_close(out, ref, atol=1e-4, rtol=1e-4)
+        # a mask with a hole is not a window and stays on the math path
+        holey = mask.clone()
+        holey[5, 5] = False
+        with torch.no_grad():
+            out, _ = torch._scaled_dot_product_attention(q, k, v, attn_mask=holey)
+        attn = q @ k.transpose(-2, -1) / (q.size(-1) ** 0.5)
+        attn = attn.masked_fill(holey.logical_not(), float("-inf"))
+        torch.testing.assert_close(
+            out, attn.softmax(-1) @ v, atol=1e-4, rtol=1e-4)
+
+    @parametrize("dtype", [torch.float32, torch.float64])
+    def test_paged_attention_matches_dense(self, dtype):
+        torch.manual_seed(0)
+        B, H, D = 3, 2, 16
+        page_size, num_pages = 8, 16
+        seq_lens = [5, 23, 17]
+        max_pages = max((T + page_size - 1) // page_size for T in seq_lens)
+
+        key_pool = torch.zeros(num_pages, page_size, H, D, dtype=dtype)
+        value_pool = torch.zeros(num_pages, page_size, H, D, dtype=dtype)
+        # deliberately non-contiguous page assignment
+        free = list(torch.randperm(num_pages))
+        page_table = torch.zeros(B, max_pages, dtype=torch.int64)
+        keys = [torch.randn(T, H, D, dtype=dtype) for T in seq_lens]
+        values = [torch.randn(T, H, D, dtype=dtype) for T in seq_lens]
+        for b, T in enumerate(seq_lens):
+            for t in range(T):
+                if t % page_size == 0:
+                    page_table[b, t // page_size] = free.pop()
+                page = page_table[b, t // page_size]
+                key_pool[page, t % page_size] = keys[b][t]
+                value_pool[page, t % page_size] = values[b][t]
+
+        q = torch.randn(B, H, D, dtype=dtype)
+        scale = D ** -0.5
+        out = torch._paged_attention(
+            q, key_pool, value_pool, page_table,
+            torch.tensor(seq_lens, dtype=torch.int64), scale)
+
+        for b, T in enumerate(seq_lens):
+            # [H, T] scores against the contiguous keys
+            attn = torch.einsum("hd,thd->ht", q[b], keys[b]) * scale
+            ref = torch.einsum("ht,thd->hd", attn.softmax(-1), values[b])
+            torch.testing.assert_close(out[b], ref, atol=1e-4, rtol=1e-4)
+
+    def test_paged_attention_empty_sequence_is_zero(self):
+        H, D, page_size = 2, 8, 4
+        key_pool = torch.randn(2, page_size, H, D)
+        value_pool = torch.randn(2, page_size, H, D)
+        q = torch.randn(1, H, D)
+        out = torch._paged_attention(
+            q, key_pool, value_pool,
+            torch.zeros(1, 1, dtype=torch.int64),
+            torch.zeros(1, dtype=torch.int64), D ** -0.5)
+        self.assertEqual(out.abs().sum().item(), 0.0)
+
+    def test_scaled_dot_product_attention_mask_and_grad_fallback(self):
+        q = torch.randn(2, 4, 16, 8, requires_grad=True)
+        k = torch.randn(2, 4, 16, 8, requires_grad=True)
+        v = torch.randn(2, 4, 16, 8, requires_grad=True)
+        mask = torch.zeros(16, 16, dtype=torch.bool)
+        mask[:, ::2] = True
+        out, attn = torch._scaled_dot_product_attention(
+            q, k, v, attn_mask=mask, need_attn_weights=True)
+        self.assertEqual(attn.shape, torch.Size([2, 4, 16, 16]))
+        # masked-out keys get zero weight
+        self.assertEqual(attn[..., 1::2].abs().sum().item(), 0.0)
+        # the decomposed path supports autograd
+        out.sum().backward()
+        self.assertIsNotNone(q.grad)
+        self.assertIsNotNone(k.grad)
+        self.assertIsNotNone(v.grad)
+
+
 instantiate_parametrized_tests(TestTransformers)
 
 if __name__ == '__main__':
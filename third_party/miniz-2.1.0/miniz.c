@@ -6308,7 +6308,10 @@ mz_bool mz_zip_writer_add_mem_ex_v2(mz_zip_archive *pZip, const char *pArchive_n
 
 	if (!(level_and_flags & MZ_ZIP_FLAG_COMPRESSED_DATA))
 	{
-		uncomp_crc32 = (mz_uint32)mz_crc32(MZ_CRC32_INIT, (const mz_uint8 *)pBuf, buf_size);
+		/* PyTorch addition: trust the crc32 supplied by the caller so it can be
+		   computed more efficiently (e.g. in parallel) outside the writer. */
+		if (!(level_and_flags & MZ_ZIP_FLAG_PRECOMPUTED_CRC32))
+			uncomp_crc32 = (mz_uint32)mz_crc32(MZ_CRC32_INIT, (const mz_uint8 *)pBuf, buf_size);
 		uncomp_size = buf_size;
 		if (uncomp_size <= 3)
 		{
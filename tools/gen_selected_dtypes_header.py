@@ -0,0 +1,112 @@
+#!/usr/bin/env python3
+"""Generates selected_dtypes.h for dtype-allowlist selective builds.
+
+The mobile selective build (tools/lite_interpreter/
+gen_selected_mobile_ops_header.py) prunes AT_DISPATCH_* cases per kernel
+tag, driven by tracing model execution. This is its server-side
+counterpart: a single build-wide dtype allowlist, for deployments that run
+a known, small set of dtypes (say fp32/bf16/int64) and want the kernel
+bodies of every other dtype out of the binary for icache residency. It is
+wired up through cmake -DSELECTED_DTYPE_LIST=Float,BFloat16,Long, which
+defines TORCH_DTYPE_SELECTIVE_BUILD; Dispatch.h then includes the
+generated header instead of the always-true default.
+
+Dispatching an excluded dtype becomes a runtime error. Note that ATen
+dispatches some dtypes internally that a model's inputs never show: index
+kernels use Int/Long, boolean masks use Bool, and mixed-precision
+comparisons produce Bool outputs. Long and Bool belong in almost every
+allowlist.
+"""
+import argparse
+import os
+
+from torchgen.code_template import CodeTemplate
+
+# Keep in sync with AT_FORALL_SCALAR_TYPES_WITH_COMPLEX_AND_QINTS in
+# c10/core/ScalarType.h. Validated up front so that a typo fails the build
+# instead of silently pruning the dtype it meant to keep.
+valid_dtype_names = {
+    "Byte",
+    "Char",
+    "Short",
+    "Int",
+    "Long",
+    "Half",
+    "Float",
+    "Double",
+    "ComplexHalf",
+    "ComplexFloat",
+    "ComplexDouble",
+    "Bool",
+    "QInt8",
+    "QUInt8",
+    "QInt32",
+    "BFloat16",
+    "QUInt4x2",
+    "QUInt2x4",
+}
+
+selected_dtypes_h_template_str = """#pragma once
+/**
+ * Generated by gen_selected_dtypes_header.py from
+ * SELECTED_DTYPE_LIST=$dtype_list
+ */
+
+#include <c10/core/ScalarType.h>
+
+namespace at {
+inline constexpr bool dtype_in_build_allowlist(at::ScalarType scalar_type) {
+  return $dtype_checks;
+}
+} // namespace at
+"""
+selected_dtypes_h_template = CodeTemplate(selected_dtypes_h_template_str)
+
+
+def write_selected_dtypes(output_file_path: str, dtype_list: str) -> None:
+    dtypes = [dtype.strip() for dtype in dtype_list.split(",") if dtype.strip()]
+    if not dtypes:
+        raise ValueError("SELECTED_DTYPE_LIST must name at least one dtype")
+    for dtype in dtypes:
+        if dtype not in valid_dtype_names:
+            raise ValueError(
+                "unknown dtype '{}' in SELECTED_DTYPE_LIST; expected names "
+                "from c10::ScalarType such as Float, BFloat16, Long".format(dtype)
+            )
+    conditions = [
+        "scalar_type == at::ScalarType::" + dtype for dtype in dtypes
+    ]
+    header_contents = selected_dtypes_h_template.substitute(
+        dtype_list=",".join(dtypes),
+        dtype_checks="\n      || ".join(conditions),
+    )
+    with open(output_file_path, "w") as out_file:
+        out_file.write(header_contents)
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(
+        description="Generate selected_dtypes.h for dtype-allowlist selective build."
+    )
+    parser.add_argument(
+        "--dtype_list",
+        type=str,
+        required=True,
+        help="Comma-separated c10::ScalarType names to keep, "
+        "e.g. Float,BFloat16,Long.",
+    )
+    parser.add_argument(
+        "--output_file_path",
+        type=str,
+        required=True,
+        help="Path to destination folder where selected_dtypes.h will be written.",
+    )
+    parsed_args = parser.parse_args()
+
+    output_file = os.path.join(parsed_args.output_file_path, "selected_dtypes.h")
+    print("Writing header file selected_dtypes.h: ", output_file)
+    write_selected_dtypes(output_file, parsed_args.dtype_list)
+
+
+if __name__ == "__main__":
+    main()
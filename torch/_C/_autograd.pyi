@@ -41,6 +41,7 @@ class _ExperimentalConfig:
         self,
         profiler_metrics: List[str] = ...,
         profiler_measure_per_kernel: bool = ...,
+        performance_events: List[str] = ...,
     ) -> None: ...
     ...
 
@@ -121,6 +121,11 @@ def _reset_current_rpc_agent(): ...
 def _delete_all_user_and_unforked_owner_rrefs(timeout: timedelta = ...): ...
 def _destroy_rref_context(ignoreRRefLeak: bool): ...
 def _rref_context_get_debug_info() -> Dict[str, str]: ...
+def _remote_storage_register(tensor: torch.Tensor) -> Tuple[int, int]: ...
+def _remote_storage_announce(owner_id: int, local_id: int): ...
+def _remote_storage_materialize(owner_id: int, local_id: int) -> torch.Tensor: ...
+def _remote_storage_delete(owner_id: int, local_id: int): ...
+def _remote_storage_get_debug_info() -> Dict[str, str]: ...
 def _cleanup_python_rpc_handler(): ...
 def _invoke_rpc_builtin(
     dst: WorkerInfo,
@@ -1745,6 +1745,15 @@ See :func:`torch.equal`
 """,
 )
 
+add_docstr_all(
+    "fast_hash",
+    r"""
+fast_hash() -> int
+
+See :func:`torch.fast_hash`
+""",
+)
+
 add_docstr_all(
     "erf",
     r"""
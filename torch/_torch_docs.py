@@ -4129,6 +4129,27 @@ Example::
 """,
 )
 
+add_docstr(
+    torch.fast_hash,
+    r"""
+fast_hash(input) -> int
+
+Returns a structural hash of :attr:`input` computed from its metadata
+(dtype, device, shape, strides), the identity of its storage, and its
+version counter, without reading the full tensor contents. The hash of an
+unmodified tensor is stable across calls and changes after in-place
+mutation, which makes it suitable for keying compilation or plan caches.
+Equal hashes are a strong but not certain signal of equality; use
+:func:`torch.equal` when an exact answer is required.
+
+Example::
+
+    >>> w = torch.randn(3, 3)
+    >>> torch.fast_hash(w) == torch.fast_hash(w)
+    True
+""",
+)
+
 add_docstr(
     torch.erf,
     r"""
@@ -130,3 +130,35 @@ class save_on_cpu(saved_tensors_hooks):
             return tensor.to(device, non_blocking=pin_memory)
 
         super().__init__(pack_to_cpu, unpack_from_cpu)
+
+
+class offload_activations():
+    """Context-manager under which large tensors saved by the forward pass are
+    offloaded to pinned CPU memory by the native activation offload engine.
+
+    This is the native counterpart of ``save_on_cpu(pin_memory=True)``:
+    instead of calling a pair of Python hooks for every saved tensor, a C++
+    engine copies qualifying tensors (CUDA tensors above a size threshold) to
+    pinned host buffers on a dedicated side stream during the forward pass
+    and copies them back, a few saved tensors ahead of consumption, during
+    backward. Saved tensors that do not qualify are kept on their device as
+    usual, so the context is safe to wrap around arbitrary (including
+    CPU-only) code.
+
+    Explicit :class:`saved_tensors_hooks` take precedence while both are
+    active.
+
+    Example::
+
+        >>> a = torch.randn(1024, 1024, requires_grad=True, device="cuda")
+        >>> with torch.autograd.graph.offload_activations():
+        ...     y = (a * a).relu()  # saved tensors live in pinned CPU memory
+        >>> y.sum().backward()      # copied back ahead of backward use
+
+    """
+    def __enter__(self):
+        self.prev = torch._C._autograd._is_activation_offloading_enabled()
+        torch._C._autograd._set_activation_offloading_enabled(True)
+
+    def __exit__(self, *args: Any):
+        torch._C._autograd._set_activation_offloading_enabled(self.prev)
@@ -9,12 +9,14 @@
 #include <ATen/DLConvertor.h>
 #include <ATen/ExpandUtils.h>
 #include <ATen/LinalgBackend.h>
+#include <ATen/MapAllocator.h>
 #include <ATen/Parallel.h>
 #include <ATen/Utils.h>
 #include <ATen/VmapMode.h>
 #include <ATen/core/Vitals.h>
 #include <ATen/dlpack.h>
 #include <ATen/native/ConvUtils.h>
+#include <ATen/native/mkldnn/MKLDNNCommon.h>
 #include <c10/util/Logging.h>
 #include <c10/util/irange.h>
 #include <libshm.h>
@@ -630,6 +632,98 @@ PyObject* THPModule_setFlushDenormal(PyObject* _unused, PyObject* arg) {
   Py_RETURN_TRUE;
 }
 
+PyObject* THPModule_setShareableAllocationThreshold(
+    PyObject* _unused,
+    PyObject* arg) {
+  HANDLE_TH_ERRORS
+  THPUtils_assert(
+      THPUtils_checkLong(arg),
+      "_set_shareable_allocation_threshold expects an int, "
+      "but got %s",
+      THPUtils_typename(arg));
+  int64_t threshold = THPUtils_unpackLong(arg);
+  THPUtils_assert(
+      threshold >= 0,
+      "_set_shareable_allocation_threshold expects a non-negative integer");
+  at::SetShareableCPUAllocatorThreshold(static_cast<size_t>(threshold));
+  Py_RETURN_NONE;
+  END_HANDLE_TH_ERRORS
+}
+
+PyObject* THPModule_getShareableAllocationThreshold(
+    PyObject* _unused,
+    PyObject* noargs) {
+  return THPUtils_packUInt64(at::GetShareableCPUAllocatorThreshold());
+}
+
+PyObject* THPModule_mkldnnSetPrepackCacheLimit(
+    PyObject* _unused,
+    PyObject* arg) {
+  HANDLE_TH_ERRORS
+  THPUtils_assert(
+      THPUtils_checkLong(arg),
+      "_mkldnn_set_prepack_cache_limit expects an int, "
+      "but got %s",
+      THPUtils_typename(arg));
+  int64_t nbytes = THPUtils_unpackLong(arg);
+  THPUtils_assert(
+      nbytes >= 0,
+      "_mkldnn_set_prepack_cache_limit expects a non-negative integer");
+  at::native::mkldnn_set_prepack_cache_limit(static_cast<size_t>(nbytes));
+  Py_RETURN_NONE;
+  END_HANDLE_TH_ERRORS
+}
+
+PyObject* THPModule_mkldnnPrepackCacheLimit(
+    PyObject* _unused,
+    PyObject* noargs) {
+  HANDLE_TH_ERRORS
+  return THPUtils_packUInt64(at::native::mkldnn_prepack_cache_limit());
+  END_HANDLE_TH_ERRORS
+}
+
+PyObject* THPModule_mkldnnPrepackCacheBytes(
+    PyObject* _unused,
+    PyObject* noargs) {
+  HANDLE_TH_ERRORS
+  return THPUtils_packUInt64(at::native::mkldnn_prepack_cache_bytes());
+  END_HANDLE_TH_ERRORS
+}
+
+PyObject* THPModule_mkldnnClearPrepackCache(
+    PyObject* _unused,
+    PyObject* noargs) {
+  HANDLE_TH_ERRORS
+  at::native::mkldnn_clear_prepack_cache();
+  Py_RETURN_NONE;
+  END_HANDLE_TH_ERRORS
+}
+
+PyObject* THPModule_mkldnnSetPrepackedWeightPinned(
+    PyObject* _unused,
+    PyObject* args) {
+  HANDLE_TH_ERRORS
+  PyObject* weight = nullptr;
+  PyObject* pinned = nullptr;
+  if (!PyArg_ParseTuple(args, "OO", &weight, &pinned)) {
+    return nullptr;
+  }
+  THPUtils_assert(
+      THPVariable_Check(weight),
+      "_mkldnn_set_prepacked_weight_pinned expects a Tensor, "
+      "but got %s",
+      THPUtils_typename(weight));
+  THPUtils_assert(
+      PyBool_Check(pinned),
+      "_mkldnn_set_prepacked_weight_pinned expects a bool, "
+      "but got %s",
+      THPUtils_typename(pinned));
+  at::native::mkldnn_set_prepacked_weight_pinned(
+      THPVariable_Unpack(weight), pinned == Py_True);
+  Py_RETURN_NONE;
+  END_HANDLE_TH_ERRORS
+}
+
 PyObject* THPModule_getDefaultDtype(PyObject* _unused, PyObject* arg) {
   HANDLE_TH_ERRORS
   auto scalar_type = torch::tensors::get_default_scalar_type();
@@ -858,6 +952,34 @@ static PyMethodDef TorchMethods[] = {
     {"_to_dlpack", THPModule_toDLPack, METH_O, nullptr},
     {"_from_dlpack", THPModule_fromDLPack, METH_O, nullptr},
     {"set_flush_denormal", THPModule_setFlushDenormal, METH_O, nullptr},
+    {"_set_shareable_allocation_threshold",
+     THPModule_setShareableAllocationThreshold,
+     METH_O,
+     nullptr},
+    {"_get_shareable_allocation_threshold",
+     THPModule_getShareableAllocationThreshold,
+     METH_NOARGS,
+     nullptr},
+    {"_mkldnn_set_prepack_cache_limit",
+     THPModule_mkldnnSetPrepackCacheLimit,
+     METH_O,
+     nullptr},
+    {"_mkldnn_prepack_cache_limit",
+     THPModule_mkldnnPrepackCacheLimit,
+     METH_NOARGS,
+     nullptr},
+    {"_mkldnn_prepack_cache_bytes",
+     THPModule_mkldnnPrepackCacheBytes,
+     METH_NOARGS,
+     nullptr},
+    {"_mkldnn_clear_prepack_cache",
+     THPModule_mkldnnClearPrepackCache,
+     METH_NOARGS,
+     nullptr},
+    {"_mkldnn_set_prepacked_weight_pinned",
+     THPModule_mkldnnSetPrepackedWeightPinned,
+     METH_VARARGS,
+     nullptr},
     {"get_default_dtype", THPModule_getDefaultDtype, METH_NOARGS, nullptr},
     {"_get_default_device", THPModule_getDefaultDevice, METH_NOARGS, nullptr},
     {"_get_qengine", THPModule_qEngine, METH_NOARGS, nullptr},
@@ -1143,6 +1265,7 @@ Call this whenever a new thread is created in order to propagate values from
       .value("CudaDepthwise3d", at::native::ConvBackend::CudaDepthwise3d)
       .value("Cudnn", at::native::ConvBackend::Cudnn)
       .value("CudnnTranspose", at::native::ConvBackend::CudnnTranspose)
+      .value("DepthwiseDirect2d", at::native::ConvBackend::DepthwiseDirect2d)
       .value("Empty", at::native::ConvBackend::Empty)
       .value("Miopen", at::native::ConvBackend::Miopen)
       .value("MiopenDepthwise", at::native::ConvBackend::MiopenDepthwise)
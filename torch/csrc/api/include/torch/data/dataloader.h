@@ -1,7 +1,9 @@
 #pragma once
 
+#include <torch/data/dataloader/pipelined.h>
 #include <torch/data/dataloader/stateful.h>
 #include <torch/data/dataloader/stateless.h>
+#include <torch/data/pin_memory.h>
 
 #include <torch/csrc/utils/memory.h>
 #include <torch/csrc/utils/variadic.h>
@@ -52,6 +54,27 @@ make_data_loader(
       std::move(options));
 }
 
+/// Creates a `PipelinedDataLoader` instance for a stateless `dataset`, a
+/// `sampler`, some `options` and an optional `postprocess` function run by the
+/// collate stage.
+template <typename Dataset, typename Sampler>
+torch::disable_if_t<
+    Dataset::is_stateful,
+    std::unique_ptr<PipelinedDataLoader<Dataset, Sampler>>>
+make_pipelined_data_loader(
+    Dataset dataset,
+    Sampler sampler,
+    PipelinedDataLoaderOptions options,
+    typename PipelinedDataLoader<Dataset, Sampler>::PostprocessType
+        postprocess = nullptr) {
+  return torch::make_unique<PipelinedDataLoader<Dataset, Sampler>>(
+      // NOLINTNEXTLINE(performance-move-const-arg)
+      std::move(dataset),
+      std::move(sampler),
+      std::move(options),
+      std::move(postprocess));
+}
+
 /// Creates a `DataLoader` for a stateful `dataset` and some `options`.
 template <typename Dataset, typename = torch::enable_if_t<Dataset::is_stateful>>
 std::unique_ptr<StatefulDataLoader<Dataset>> make_data_loader(
@@ -0,0 +1,390 @@
+#pragma once
+
+#include <torch/data/dataloader_options.h>
+#include <torch/data/detail/queue.h>
+#include <torch/data/detail/sequencers.h>
+#include <torch/data/iterator.h>
+#include <torch/data/pin_memory.h>
+#include <torch/data/worker_exception.h>
+#include <torch/types.h>
+
+#include <torch/csrc/utils/memory.h>
+
+#include <c10/util/Exception.h>
+#include <c10/util/irange.h>
+
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace torch {
+namespace data {
+
+/// A dataloader that splits batch production into two stages with separate
+/// thread pools.
+///
+/// *Load* workers fetch batches from (a copy of) the dataset, exactly like the
+/// workers of a `StatelessDataLoader`. Each fetched batch is then handed to a
+/// pool of *collate* workers, which run an optional user-supplied postprocess
+/// function and, if the `pin_memory` option is set, move the batch into pinned
+/// memory (via `pin_batch`) so the training loop can upload it to the GPU with
+/// asynchronous host-to-device copies. Separating the stages keeps expensive
+/// decode work (inside `Dataset::get_batch`) from serializing behind collation
+/// and pinning, which would otherwise steal time from the fetch pool.
+///
+/// The number of batches in flight across both stages is bounded by the
+/// `readahead` option; per-stage batch counts and cumulative wall time are
+/// available through `stats()` for diagnosing which stage is the bottleneck.
+/// With `collate_workers` set to zero, postprocessing runs inline in the load
+/// workers and the loader degenerates to a single-stage pipeline.
+template <typename Dataset, typename Sampler>
+class PipelinedDataLoader {
+ public:
+  using BatchType = typename Dataset::BatchType;
+  using BatchRequestType = typename Sampler::BatchRequestType;
+  using PostprocessType = std::function<BatchType(BatchType)>;
+
+  /// Throughput counters for one pipeline stage.
+  struct StageStats {
+    /// The number of batches the stage has completed.
+    size_t batches = 0;
+    /// The cumulative wall time the stage's workers spent on those batches.
+    std::chrono::nanoseconds total_time{0};
+  };
+
+  /// Per-stage throughput counters; see `stats()`.
+  struct Stats {
+    StageStats load;
+    StageStats collate;
+  };
+
+  /// Constructs the `PipelinedDataLoader` from a `dataset`, a `sampler`, some
+  /// `options` and an optional `postprocess` function that the collate stage
+  /// applies to every batch.
+  PipelinedDataLoader(
+      Dataset dataset,
+      Sampler sampler,
+      PipelinedDataLoaderOptions options,
+      PostprocessType postprocess = nullptr)
+      // NOLINTNEXTLINE(performance-move-const-arg)
+      : options_(std::move(options)),
+        sampler_(std::move(sampler)),
+        postprocess_(std::move(postprocess)),
+        sequencer_(new_sequencer()) {
+    TORCH_CHECK(
+        options_.load_workers > 0,
+        "PipelinedDataLoader requires at least one load worker");
+    for (const auto w : c10::irange(options_.load_workers)) {
+      // Like the StatelessDataLoader, each load worker owns a copy of the
+      // dataset, so the dataset must be trivially copiable.
+      (void)w; // Suppress unused variable warning
+      load_workers_.emplace_back(
+          [this, dataset]() mutable { this->load_worker_thread(dataset); });
+    }
+    for (const auto w : c10::irange(options_.collate_workers)) {
+      (void)w; // Suppress unused variable warning
+      collate_workers_.emplace_back([this] { this->collate_worker_thread(); });
+    }
+  }
+
+  // NOLINTNEXTLINE(bugprone-exception-escape)
+  ~PipelinedDataLoader() {
+    join();
+  }
+
+  /// Returns an iterator into the dataloader; see `DataLoaderBase::begin()`
+  /// for the iterator's semantics.
+  Iterator<BatchType> begin() {
+    TORCH_CHECK(
+        in_flight_jobs_ == 0,
+        "Attempted to get a new DataLoader iterator "
+        "while another iterator is not yet exhausted");
+    reset();
+    return Iterator<BatchType>(
+        torch::make_unique<detail::ValidIterator<BatchType>>(
+            [this] { return this->next(); }));
+  }
+
+  /// Returns a special "sentinel" iterator that compares equal with a
+  /// non-sentinel iterator once the dataloader is exhausted.
+  Iterator<BatchType> end() {
+    return Iterator<BatchType>(
+        torch::make_unique<detail::SentinelIterator<BatchType>>());
+  }
+
+  /// Joins the dataloader's worker threads and drains internal queues. May
+  /// only be invoked from the main thread (in which the dataloader lives).
+  void join() {
+    if (joined_) {
+      return;
+    }
+    drain();
+    // Quit the stages front to back: once every load worker has exited, no
+    // more batches can arrive at the collate stage, so its workers can be
+    // quit in turn. Each quit message is read by exactly one worker.
+    for (const auto w : c10::irange(options_.load_workers)) {
+      (void)w; // Suppress unused variable warning
+      jobs_.push(Job(QuitWorker(), sequence_number_++));
+    }
+    for (auto& worker : load_workers_) {
+      worker.join();
+    }
+    for (const auto w : c10::irange(options_.collate_workers)) {
+      (void)w; // Suppress unused variable warning
+      loaded_.push(Loaded(QuitWorker(), sequence_number_++));
+    }
+    for (auto& worker : collate_workers_) {
+      worker.join();
+    }
+    joined_ = true;
+  }
+
+  /// Returns the options with which the dataloader was configured.
+  const FullPipelinedDataLoaderOptions& options() const noexcept {
+    return options_;
+  }
+
+  /// Returns a snapshot of the per-stage throughput counters. Counters
+  /// accumulate across epochs; `reset()` does not clear them.
+  Stats stats() const {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    return stats_;
+  }
+
+ private:
+  /// Simple mix-in to give something a sequence number.
+  struct Sequenced {
+    Sequenced() = default;
+    Sequenced(size_t sqn) : sequence_number(sqn) {}
+    size_t sequence_number;
+  };
+
+  struct QuitWorker {};
+
+  /// A `Job` is either a `BatchRequest` (new indices to fetch data at) or a
+  /// `QuitWorker` object, to indicate the load worker should shut down.
+  struct Job : Sequenced {
+    Job() = default;
+    Job(QuitWorker q, size_t sqn) : Sequenced(sqn), quit(q) {}
+    Job(BatchRequestType&& i, size_t sqn)
+        : Sequenced(sqn), batch_request(std::move(i)) {}
+    optional<QuitWorker> quit;
+    optional<BatchRequestType> batch_request;
+  };
+
+  /// A batch fetched by a load worker, en route to the collate stage.
+  struct Loaded : Sequenced {
+    Loaded() = default;
+    Loaded(QuitWorker q, size_t sqn) : Sequenced(sqn), quit(q) {}
+    Loaded(BatchType&& b, size_t sqn) : Sequenced(sqn), batch(std::move(b)) {}
+    optional<QuitWorker> quit;
+    optional<BatchType> batch;
+  };
+
+  /// The finished result of a job, after both stages.
+  struct Result : Sequenced {
+    Result() = default;
+    Result(optional<BatchType>&& b, size_t sqn)
+        : Sequenced(sqn), batch(std::move(b)) {}
+    Result(std::exception_ptr exception, size_t sqn)
+        // NOLINTNEXTLINE(performance-move-const-arg)
+        : Sequenced(sqn), exception(std::move(exception)) {}
+    optional<BatchType> batch;
+    std::exception_ptr exception;
+  };
+
+  /// Resets the internal state of the dataloader and the sampler, and
+  /// prefetches up to `readahead` many new jobs.
+  void reset() {
+    drain();
+    sampler_.reset();
+    sequence_number_ = 0;
+    sequencer_ = new_sequencer();
+    prefetch(options_.readahead);
+  }
+
+  /// Schedules `requested_jobs` many new batches to be fetched. The actual
+  /// number of jobs scheduled may be less if the dataloader exhausts.
+  void prefetch(size_t requested_jobs) {
+    for (const auto r : c10::irange(requested_jobs)) {
+      (void)r; // Suppress unused variable warning
+      if (auto batch_request = get_batch_request()) {
+        jobs_.push(Job(std::move(*batch_request), sequence_number_++));
+        ++in_flight_jobs_;
+      } else {
+        break;
+      }
+    }
+  }
+
+  /// Queries the sampler for the next batch request (possibly progressing its
+  /// internal state).
+  optional<BatchRequestType> get_batch_request() {
+    auto indices = sampler_.next(options_.batch_size);
+    if (!indices ||
+        (indices->size() < options_.batch_size && options_.drop_last)) {
+      return nullopt;
+    }
+    AT_ASSERT(indices->size() > 0);
+    return indices;
+  }
+
+  /// Returns the next batch of data, or an empty `optional` if the dataloader
+  /// is exhausted. This operation will block until a batch is available if one
+  /// is still expected.
+  optional<BatchType> next() {
+    while (optional<Result> result = pop_result()) {
+      if (result->exception) {
+        throw WorkerException(result->exception);
+      } else if (result->batch) {
+        prefetch(1);
+        return std::move(result->batch);
+      }
+    }
+    return nullopt;
+  }
+
+  /// The function that load worker threads run.
+  void load_worker_thread(Dataset& dataset) {
+    while (true) {
+      auto job = jobs_.pop();
+      if (job.quit) {
+        break;
+      }
+      try {
+        auto start = std::chrono::steady_clock::now();
+        auto batch = dataset.get_batch(std::move(*job.batch_request));
+        record_stage_time(&Stats::load, start);
+        if (options_.collate_workers > 0) {
+          loaded_.push(Loaded(std::move(batch), job.sequence_number));
+        } else {
+          results_.push(collate(std::move(batch), job.sequence_number));
+        }
+      } catch (...) {
+        results_.push({std::current_exception(), job.sequence_number});
+      }
+    }
+  }
+
+  /// The function that collate worker threads run.
+  void collate_worker_thread() {
+    while (true) {
+      auto loaded = loaded_.pop();
+      if (loaded.quit) {
+        break;
+      }
+      results_.push(collate(std::move(*loaded.batch), loaded.sequence_number));
+    }
+  }
+
+  /// Runs the collate stage (postprocess and optional pinning) on one batch.
+  Result collate(BatchType batch, size_t sequence_number) {
+    try {
+      auto start = std::chrono::steady_clock::now();
+      if (postprocess_) {
+        batch = postprocess_(std::move(batch));
+      }
+      if (options_.pin_memory) {
+        batch = pin_batch(std::move(batch));
+      }
+      record_stage_time(&Stats::collate, start);
+      return {std::move(batch), sequence_number};
+    } catch (...) {
+      return {std::current_exception(), sequence_number};
+    }
+  }
+
+  /// Adds the time elapsed since `start` to the given stage's counters.
+  void record_stage_time(
+      StageStats Stats::*stage,
+      std::chrono::steady_clock::time_point start) {
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    ++(stats_.*stage).batches;
+    (stats_.*stage).total_time +=
+        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed);
+  }
+
+  /// Gets the next result from the sequencer, or nullopt once no more jobs
+  /// are in flight.
+  optional<Result> pop_result() {
+    return sequencer_->next([this]() -> optional<Result> {
+      if (in_flight_jobs_ == 0) {
+        return nullopt;
+      }
+      auto result = results_.pop(options_.timeout);
+      --in_flight_jobs_;
+      return result;
+    });
+  }
+
+  /// Discards any jobs not yet in flight and waits for all in-flight jobs to
+  /// drip through both stages, discarding their results.
+  void drain() {
+    in_flight_jobs_ -= jobs_.clear();
+    while (in_flight_jobs_ > 0) {
+      results_.pop();
+      --in_flight_jobs_;
+    }
+  }
+
+  /// Creates a new sequencer based on the `enforce_ordering` option.
+  std::unique_ptr<detail::sequencers::Sequencer<Result>> new_sequencer() {
+    if (options_.enforce_ordering) {
+      return torch::make_unique<detail::sequencers::OrderedSequencer<Result>>(
+          options_.readahead);
+    }
+    return torch::make_unique<detail::sequencers::NoSequencer<Result>>();
+  }
+
+  /// The options the dataloader was configured with.
+  const FullPipelinedDataLoaderOptions options_;
+
+  /// The `Sampler` used to produce batch requests.
+  Sampler sampler_;
+
+  /// The function the collate stage applies to every batch; may be empty.
+  PostprocessType postprocess_;
+
+  /// The sequence number for the *next* batch to be retrieved from the
+  /// dataset.
+  size_t sequence_number_ = 0;
+
+  /// The number of jobs anywhere in the pipeline whose result has not yet
+  /// been popped. NOTE: Not atomic because only manipulated by the main
+  /// thread (the same accounting as `detail::DataShuttle`).
+  size_t in_flight_jobs_ = 0;
+
+  /// Batch requests awaiting a load worker.
+  detail::Queue<Job> jobs_;
+
+  /// Fetched batches awaiting a collate worker; unused when
+  /// `collate_workers` is zero.
+  detail::Queue<Loaded> loaded_;
+
+  /// Finished (or failed) batches awaiting the main thread.
+  detail::Queue<Result> results_;
+
+  /// The `Sequencer`, which handles optional ordering of batches.
+  std::unique_ptr<detail::sequencers::Sequencer<Result>> sequencer_;
+
+  /// The load stage's worker threads.
+  std::vector<std::thread> load_workers_;
+
+  /// The collate stage's worker threads.
+  std::vector<std::thread> collate_workers_;
+
+  /// Per-stage throughput counters, guarded by `stats_mutex_`.
+  Stats stats_;
+  mutable std::mutex stats_mutex_;
+
+  /// True if the dataloader has joined its worker threads.
+  bool joined_ = false;
+};
+} // namespace data
+} // namespace torch
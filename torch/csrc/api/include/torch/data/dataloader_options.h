@@ -61,5 +61,68 @@ struct FullDataLoaderOptions {
   bool enforce_ordering;
   bool drop_last;
 };
+
+/// Options to configure a `PipelinedDataLoader`, which splits loading into a
+/// fetch stage and a collate/postprocess stage with separate thread pools.
+struct PipelinedDataLoaderOptions {
+  PipelinedDataLoaderOptions() = default;
+  /* implicit */ PipelinedDataLoaderOptions(size_t batch_size)
+      : batch_size_(batch_size) {}
+
+  /// The size of each batch to fetch.
+  TORCH_ARG(size_t, batch_size) = 1;
+
+  /// The number of worker threads fetching batches from the dataset.
+  TORCH_ARG(size_t, load_workers) = 1;
+
+  /// The number of worker threads running the postprocess function and
+  /// (optionally) pinning batch memory. If zero, postprocessing runs inline
+  /// in the load workers.
+  TORCH_ARG(size_t, collate_workers) = 0;
+
+  /// The maximum number of batches in flight across both stages, i.e. the
+  /// readahead depth. Defaults to two times the number of load workers.
+  TORCH_ARG(optional<size_t>, readahead);
+
+  /// An optional limit on the time to wait for the next batch.
+  TORCH_ARG(optional<std::chrono::milliseconds>, timeout);
+
+  /// Whether to enforce ordering of batches when multiple are loaded
+  /// asynchronously by worker threads. Set to `false` for better performance
+  /// if you do not care about determinism.
+  TORCH_ARG(bool, enforce_ordering) = true;
+
+  /// Whether to omit the last batch if it contains less than `batch_size`
+  /// examples.
+  TORCH_ARG(bool, drop_last) = false;
+
+  /// Whether the collate stage should move batches into pinned memory (via
+  /// `pin_batch`) after postprocessing, so the training loop can upload them
+  /// with asynchronous host-to-device copies.
+  TORCH_ARG(bool, pin_memory) = false;
+};
+
+/// Like `PipelinedDataLoaderOptions`, but without any unconfigured state; see
+/// `FullDataLoaderOptions` for the rationale.
+struct FullPipelinedDataLoaderOptions {
+  explicit FullPipelinedDataLoaderOptions(PipelinedDataLoaderOptions options)
+      : batch_size(options.batch_size()),
+        load_workers(options.load_workers()),
+        collate_workers(options.collate_workers()),
+        readahead(options.readahead().value_or(2 * load_workers)),
+        timeout(options.timeout()),
+        enforce_ordering(options.enforce_ordering()),
+        drop_last(options.drop_last()),
+        pin_memory(options.pin_memory()) {}
+
+  size_t batch_size;
+  size_t load_workers;
+  size_t collate_workers;
+  size_t readahead;
+  optional<std::chrono::milliseconds> timeout;
+  bool enforce_ordering;
+  bool drop_last;
+  bool pin_memory;
+};
 } // namespace data
 } // namespace torch
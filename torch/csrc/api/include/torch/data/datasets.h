@@ -2,6 +2,7 @@
 
 #include <torch/data/datasets/base.h>
 #include <torch/data/datasets/chunk.h>
+#include <torch/data/datasets/csv.h>
 #include <torch/data/datasets/map.h>
 #include <torch/data/datasets/mnist.h>
 #include <torch/data/datasets/shared.h>
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <torch/arg.h>
+#include <torch/data/datasets/base.h>
+#include <torch/data/example.h>
+#include <torch/types.h>
+
+#include <torch/csrc/Export.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace torch {
+namespace data {
+namespace datasets {
+
+/// Options for the `CSV` dataset.
+struct TORCH_API CSVOptions {
+  /// The field delimiter, e.g. `','` for CSV or `'\t'` for TSV files.
+  TORCH_ARG(char, delimiter) = ',';
+
+  /// Whether the first line is a header row that should be skipped.
+  TORCH_ARG(bool, header) = false;
+
+  /// The dtype each column is parsed as, either `torch::kFloat32` or
+  /// `torch::kInt64`. When empty, every column is parsed as
+  /// `torch::kFloat32`.
+  TORCH_ARG(std::vector<Dtype>, column_types) = {};
+
+  /// The column used as the example target. Negative values count from the
+  /// last column.
+  TORCH_ARG(int64_t, target_column) = -1;
+};
+
+/// A columnar dataset over a delimiter-separated text file (CSV/TSV).
+///
+/// The whole file is memory mapped and parsed once at construction: rows are
+/// located with a vectorized delimiter scan and the fields are converted in
+/// parallel, directly into one preallocated 1-D tensor per column, without
+/// materializing intermediate strings. `get()` then only gathers from the
+/// parsed columns, so the dataset plugs into the usual `torch::data`
+/// `DataLoader` templates like any other map-style dataset.
+class TORCH_API CSV : public Dataset<CSV> {
+ public:
+  /// Loads and parses the file at `path`.
+  explicit CSV(const std::string& path, CSVOptions options = {});
+
+  /// Returns the `Example` at the given `index`. The features are the
+  /// non-target columns of the row, cast to `torch::kFloat32`; the target is
+  /// the value of the target column in its column dtype.
+  Example<> get(size_t index) override;
+
+  /// Returns the number of rows in the file.
+  optional<size_t> size() const override;
+
+  /// Returns the parsed columns, one 1-D tensor per column.
+  const std::vector<Tensor>& columns() const;
+
+ private:
+  std::vector<Tensor> columns_;
+  size_t target_column_;
+};
+
+} // namespace datasets
+} // namespace data
+} // namespace torch
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <torch/data/example.h>
+#include <torch/types.h>
+
+#include <c10/util/ArrayRef.h>
+#include <c10/util/Exception.h>
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace torch {
+namespace data {
+
+namespace detail {
+/// Alignment of tensors inside a coalesced pinned slab. 64 bytes keeps every
+/// tensor dtype-viewable and cache-line aligned.
+constexpr int64_t kPinnedSlabAlignment = 64;
+
+inline int64_t aligned_nbytes(const Tensor& tensor) {
+  int64_t nbytes = tensor.numel() * tensor.element_size();
+  return (nbytes + kPinnedSlabAlignment - 1) / kPinnedSlabAlignment *
+      kPinnedSlabAlignment;
+}
+} // namespace detail
+
+/// Copies a batch of dense CPU tensors into a single pinned-memory slab and
+/// returns contiguous views into it, one per input tensor. Pinning thousands
+/// of small samples individually pays one `cudaHostAlloc` per tensor; the
+/// slab pays one per batch, and the whole batch can afterwards be uploaded
+/// with a single host-to-device copy (see `batch_to_device`).
+///
+/// `slab` receives the backing pinned uint8 tensor; keep it alive alongside
+/// the views and pass it to `batch_to_device`.
+inline std::vector<Tensor> pin_memory_batch(
+    at::ArrayRef<Tensor> tensors,
+    Tensor& slab) {
+  int64_t total = 0;
+  std::vector<int64_t> offsets;
+  offsets.reserve(tensors.size());
+  for (const Tensor& tensor : tensors) {
+    TORCH_CHECK(
+        tensor.layout() == at::kStrided && tensor.device().is_cpu(),
+        "pin_memory_batch expects dense CPU tensors");
+    offsets.push_back(total);
+    total += detail::aligned_nbytes(tensor);
+  }
+  slab = torch::empty(
+      {total},
+      torch::TensorOptions().dtype(torch::kUInt8).pinned_memory(true));
+  std::vector<Tensor> views;
+  views.reserve(tensors.size());
+  for (size_t i = 0; i < tensors.size(); ++i) {
+    const Tensor& tensor = tensors[i];
+    int64_t nbytes = tensor.numel() * tensor.element_size();
+    Tensor view = slab.narrow(0, offsets[i], nbytes)
+                      .view(tensor.scalar_type())
+                      .view(tensor.sizes());
+    view.copy_(tensor);
+    views.push_back(std::move(view));
+  }
+  return views;
+}
+
+/// Moves a batch produced by `pin_memory_batch` to `device` with a single
+/// host-to-device copy of the backing slab, rebuilding the per-tensor views
+/// on the device copy. Issue this under a dedicated copy stream guard (e.g.
+/// `at::cuda::CUDAStreamGuard` over a high-priority stream) to overlap the
+/// upload with compute; this layer is device-agnostic and does not manage
+/// streams itself.
+inline std::vector<Tensor> batch_to_device(
+    at::ArrayRef<Tensor> views,
+    const Tensor& slab,
+    Device device,
+    bool non_blocking = true) {
+  Tensor device_slab = slab.to(device, non_blocking);
+  std::vector<Tensor> moved;
+  moved.reserve(views.size());
+  for (const Tensor& view : views) {
+    int64_t byte_offset = static_cast<int64_t>(
+        static_cast<const uint8_t*>(view.data_ptr()) -
+        static_cast<const uint8_t*>(slab.data_ptr()));
+    int64_t nbytes = view.numel() * view.element_size();
+    moved.push_back(device_slab.narrow(0, byte_offset, nbytes)
+                        .view(view.scalar_type())
+                        .view(view.sizes()));
+  }
+  return moved;
+}
+
+/// `pin_batch` moves the tensors of a batch into pinned memory. Overloads
+/// exist for the batch types produced by the bundled datasets and transforms
+/// (`Tensor`, `Example` and vectors thereof); the generic fallback throws, so
+/// loaders can offer a runtime `pin_memory` switch for any batch type and
+/// only fail if it is actually enabled for an unsupported one.
+template <typename Batch>
+Batch pin_batch(Batch batch) {
+  TORCH_CHECK(
+      false,
+      "pin_memory is not supported for this batch type; "
+      "provide a postprocess function that performs the pinning instead");
+  return batch;
+}
+
+inline Tensor pin_batch(Tensor batch) {
+  return batch.pin_memory();
+}
+
+template <typename Data, typename Target>
+Example<Data, Target> pin_batch(Example<Data, Target> batch) {
+  return {pin_batch(std::move(batch.data)), pin_batch(std::move(batch.target))};
+}
+
+template <typename Data>
+Example<Data, example::NoTarget> pin_batch(
+    Example<Data, example::NoTarget> batch) {
+  return {pin_batch(std::move(batch.data))};
+}
+
+template <typename T>
+std::vector<T> pin_batch(std::vector<T> batch) {
+  for (auto& element : batch) {
+    element = pin_batch(std::move(element));
+  }
+  return batch;
+}
+
+} // namespace data
+} // namespace torch
@@ -4,6 +4,7 @@
 #include <torch/data/samplers/base.h>
 
 #include <cstddef>
+#include <cstdint>
 #include <vector>
 
 namespace torch {
@@ -101,6 +102,53 @@ class TORCH_API DistributedRandomSampler : public DistributedSampler<> {
   std::vector<size_t> all_indices_;
 };
 
+/// Select samples randomly through a stateless counter-based permutation.
+///
+/// Unlike `DistributedRandomSampler`, no index vector is ever materialized:
+/// the shuffled order is a pseudorandom permutation of the index space (a
+/// Feistel network whose round function is the Philox counter-based RNG,
+/// keyed by the epoch, with cycle walking to fit the dataset size), so the
+/// sample at any position is computable in O(1). Checkpoint state is just
+/// the epoch and the cursor -- 16 bytes regardless of dataset size -- and
+/// every shard reads its slice of positions without any index lists.
+class TORCH_API DistributedStatelessRandomSampler : public DistributedSampler<> {
+ public:
+  DistributedStatelessRandomSampler(
+      size_t size,
+      size_t num_replicas = 1,
+      size_t rank = 0,
+      bool allow_duplicates = true);
+
+  /// Resets the `DistributedStatelessRandomSampler` to a new set of indices.
+  void reset(optional<size_t> new_size = nullopt) override;
+
+  /// Returns the next batch of indices.
+  optional<std::vector<size_t>> next(size_t batch_size) override;
+
+  /// Serializes the `DistributedStatelessRandomSampler` to the `archive`.
+  void save(serialize::OutputArchive& archive) const override;
+
+  /// Deserializes the `DistributedStatelessRandomSampler` from the `archive`.
+  void load(serialize::InputArchive& archive) override;
+
+  /// Returns the current index of the `DistributedStatelessRandomSampler`.
+  size_t index() const noexcept;
+
+  /// Returns the sample at an absolute position of the current epoch's
+  /// shuffled order, independently of the cursor.
+  size_t index_at(size_t position) const;
+
+ private:
+  void update_bounds();
+  size_t permute(size_t position) const;
+
+  size_t begin_index_;
+  size_t end_index_;
+  size_t sample_index_;
+  size_t sample_count_;
+  uint32_t half_bits_;
+};
+
 /// Select samples sequentially.
 class TORCH_API DistributedSequentialSampler : public DistributedSampler<> {
  public:
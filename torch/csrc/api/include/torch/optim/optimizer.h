@@ -6,6 +6,7 @@
 
 #include <torch/arg.h>
 #include <torch/csrc/Export.h>
+#include <torch/optim/state_arena.h>
 
 #include <algorithm>
 #include <functional>
@@ -179,6 +180,10 @@ class TORCH_API Optimizer {
   ska::flat_hash_map<std::string, std::unique_ptr<OptimizerParamState>> state_;
   // NOLINTNEXTLINE(cppcoreguidelines-non-private-member-variables-in-classes)
   std::unique_ptr<OptimizerOptions> defaults_;
+  // Shared slabs backing the per-parameter state tensors; see
+  // `OptimizerStateArena`.
+  // NOLINTNEXTLINE(cppcoreguidelines-non-private-member-variables-in-classes)
+  OptimizerStateArena state_arena_;
 };
 
 /* How do we decide whether to serialize undefined tensors or
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <ATen/Tensor.h>
+#include <torch/csrc/Export.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace torch {
+using at::Tensor;
+namespace optim {
+
+/// A bump allocator for optimizer state tensors.
+///
+/// Optimizers keep one or more state tensors per parameter (Adam's
+/// `exp_avg` / `exp_avg_sq`, RMSprop's `square_avg`, ...). Allocating each
+/// of them separately spreads the state of a large model across thousands
+/// of unrelated allocations, so a step walks scattered memory and every
+/// tensor pays its own allocator metadata. The arena instead carves state
+/// tensors as views out of large contiguous slabs, one running slab per
+/// dtype/device pair, so state touched together is laid out back to back
+/// and a step sweeps linear memory. The slabs also expose the whole state
+/// of a dtype as a single flat tensor for bulk processing or
+/// serialization.
+///
+/// Views are handed out bump-style and never returned; the arena is meant
+/// for state that lives as long as the optimizer, which is how all the
+/// optimizers in this API use it.
+class TORCH_API OptimizerStateArena {
+ public:
+  /// Returns a zero-filled tensor with the shape and strides of `param`,
+  /// backed by a shared slab. Parameters whose layout a flat view cannot
+  /// represent (overlapping or non-dense) fall back to an ordinary
+  /// allocation.
+  Tensor zeros_like(const Tensor& param);
+
+  /// The flat 1-D slab tensors backing the views handed out so far.
+  std::vector<Tensor> slabs() const;
+
+ private:
+  struct Slab {
+    Tensor flat;
+    // Elements handed out; the next view starts at this offset, rounded
+    // up to a cache line.
+    int64_t used;
+  };
+
+  std::vector<Slab> slabs_;
+};
+
+} // namespace optim
+} // namespace torch
@@ -1,3 +1,4 @@
+#include <ATen/core/PhiloxRNGEngine.h>
 #include <c10/util/irange.h>
 #include <torch/data/samplers/distributed.h>
 #include <torch/serialize/archive.h>
@@ -95,6 +96,132 @@ size_t DistributedRandomSampler::index() const noexcept {
   return sample_index_;
 }
 
+namespace {
+
+// Feistel round function for DistributedStatelessRandomSampler: one Philox
+// evaluation keyed by the epoch, with the round number and the half-block
+// as the counter, so the output depends only on (epoch, round, half).
+uint32_t feistel_round(uint64_t epoch, uint32_t round, uint64_t half) {
+  at::Philox4_32_10 engine(
+      epoch, (static_cast<uint64_t>(round) << 32) | half, 0);
+  return engine();
+}
+
+} // namespace
+
+DistributedStatelessRandomSampler::DistributedStatelessRandomSampler(
+    size_t size,
+    size_t num_replicas,
+    size_t rank,
+    bool allow_duplicates)
+    : DistributedSampler(size, num_replicas, rank, allow_duplicates),
+      begin_index_(0),
+      end_index_(0),
+      sample_index_(0),
+      sample_count_(0),
+      half_bits_(0) {
+  reset(size_);
+}
+
+optional<std::vector<size_t>> DistributedStatelessRandomSampler::next(
+    size_t batch_size) {
+  if (sample_index_ == end_index_) {
+    return nullopt;
+  }
+
+  size_t end = sample_index_ + batch_size;
+  if (end > end_index_) {
+    end = end_index_;
+  }
+
+  std::vector<size_t> res(end - sample_index_);
+  for (const auto i : c10::irange(res.size())) {
+    res[i] = index_at(sample_index_ + i);
+  }
+  sample_index_ = end;
+  return res;
+}
+
+void DistributedStatelessRandomSampler::reset(optional<size_t> new_size) {
+  size_ = new_size.value_or(size_);
+  update_bounds();
+  sample_index_ = begin_index_;
+}
+
+void DistributedStatelessRandomSampler::update_bounds() {
+  size_t num_local_samples = local_sample_count();
+  sample_count_ =
+      num_replicas_ == 1 ? size_ : num_local_samples * num_replicas_;
+  // Smallest balanced Feistel domain (an even number of bits) that covers
+  // the sample count; out-of-range values are walked back into range in
+  // permute(), so on average fewer than four rounds of walking happen.
+  half_bits_ = 1;
+  while ((static_cast<uint64_t>(1) << (2 * half_bits_)) < sample_count_) {
+    ++half_bits_;
+  }
+  begin_index_ = rank_ * num_local_samples;
+  end_index_ = begin_index_ + num_local_samples;
+}
+
+size_t DistributedStatelessRandomSampler::permute(size_t position) const {
+  const uint64_t mask = (static_cast<uint64_t>(1) << half_bits_) - 1;
+  uint64_t value = position;
+  // A Feistel network is a bijection on the padded power-of-two domain for
+  // any round function; cycle walking restricts it to [0, sample_count_).
+  do {
+    uint64_t left = value >> half_bits_;
+    uint64_t right = value & mask;
+    for (const auto round : c10::irange(uint32_t(4))) {
+      const uint64_t next_right =
+          left ^ (feistel_round(epoch_, round, right) & mask);
+      left = right;
+      right = next_right;
+    }
+    value = (left << half_bits_) | right;
+  } while (value >= sample_count_);
+  return value;
+}
+
+size_t DistributedStatelessRandomSampler::index_at(size_t position) const {
+  TORCH_CHECK(
+      position < sample_count_,
+      "position ",
+      position,
+      " is out of bounds for a sample count of ",
+      sample_count_);
+  size_t index = permute(position);
+  // Positions past the dataset size are the duplicates added to give every
+  // replica the same number of samples.
+  return index >= size_ ? index - size_ : index;
+}
+
+void DistributedStatelessRandomSampler::save(
+    serialize::OutputArchive& archive) const {
+  archive.write(
+      "sample_index_",
+      torch::tensor(static_cast<int64_t>(sample_index_)),
+      /*is_buffer=*/true);
+  archive.write(
+      "epoch_",
+      torch::tensor(static_cast<int64_t>(epoch_)),
+      /*is_buffer=*/true);
+}
+
+void DistributedStatelessRandomSampler::load(serialize::InputArchive& archive) {
+  auto tensor = torch::empty(1, torch::kInt64);
+  archive.read("epoch_", tensor, /*is_buffer=*/true);
+  epoch_ = tensor.item<int64_t>();
+  reset(size_);
+
+  tensor = torch::empty(1, torch::kInt64);
+  archive.read("sample_index_", tensor, /*is_buffer=*/true);
+  sample_index_ = tensor.item<int64_t>();
+}
+
+size_t DistributedStatelessRandomSampler::index() const noexcept {
+  return sample_index_;
+}
+
 DistributedSequentialSampler::DistributedSequentialSampler(
     size_t size,
     size_t num_replicas,
@@ -93,12 +93,12 @@ Tensor Adam::step(LossClosure closure) {
         auto state = std::make_unique<AdamParamState>();
         state->step(0);
         // Exponential moving average of gradient values
-        state->exp_avg(torch::zeros_like(p, MemoryFormat::Preserve));
+        state->exp_avg(state_arena_.zeros_like(p));
         // Exponential moving average of squared gradient values
-        state->exp_avg_sq(torch::zeros_like(p, MemoryFormat::Preserve));
+        state->exp_avg_sq(state_arena_.zeros_like(p));
         if (options.amsgrad()) {
           // Maintains max of all exp. moving avg. of sq. grad. values
-          state->max_exp_avg_sq(torch::zeros_like(p, MemoryFormat::Preserve));
+          state->max_exp_avg_sq(state_arena_.zeros_like(p));
         }
         state_[c10::guts::to_string(p.unsafeGetTensorImpl())] =
             std::move(state);
@@ -93,12 +93,12 @@ Tensor RMSprop::step(LossClosure closure) {
       if (param_state == state_.end()) {
         auto state = std::make_unique<RMSpropParamState>();
         state->step(0);
-        state->square_avg(torch::zeros_like(p, MemoryFormat::Preserve));
+        state->square_avg(state_arena_.zeros_like(p));
         if (options.momentum() > 0) {
-          state->momentum_buffer(torch::zeros_like(p, MemoryFormat::Preserve));
+          state->momentum_buffer(state_arena_.zeros_like(p));
         }
         if (options.centered()) {
-          state->grad_avg(torch::zeros_like(p, MemoryFormat::Preserve));
+          state->grad_avg(state_arena_.zeros_like(p));
         }
         state_[c10::guts::to_string(p.unsafeGetTensorImpl())] =
             std::move(state);
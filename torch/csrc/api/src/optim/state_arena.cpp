@@ -0,0 +1,69 @@
+#include <torch/optim/state_arena.h>
+
+#include <torch/types.h>
+
+#include <ATen/ATen.h>
+
+#include <algorithm>
+
+namespace torch {
+namespace optim {
+
+namespace {
+
+// Views are aligned to cache lines so adjacent state tensors never share
+// a line, and a slab holds several megabytes of state before the next
+// cudaMalloc/malloc, amortizing allocator overhead across parameters.
+constexpr int64_t kAlignBytes = 64;
+constexpr int64_t kSlabBytes = 1 << 24; // 16 MiB
+
+int64_t align_up(int64_t value, int64_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+Tensor OptimizerStateArena::zeros_like(const Tensor& param) {
+  if (param.numel() == 0 ||
+      !param.unsafeGetTensorImpl()->is_non_overlapping_and_dense()) {
+    return torch::zeros_like(param, MemoryFormat::Preserve);
+  }
+
+  const int64_t numel = param.numel();
+  const int64_t itemsize = static_cast<int64_t>(param.dtype().itemsize());
+  const int64_t align = std::max<int64_t>(kAlignBytes / itemsize, 1);
+
+  Slab* slab = nullptr;
+  for (auto& candidate : slabs_) {
+    if (candidate.flat.scalar_type() == param.scalar_type() &&
+        candidate.flat.device() == param.device() &&
+        align_up(candidate.used, align) + numel <= candidate.flat.numel()) {
+      slab = &candidate;
+      break;
+    }
+  }
+  if (slab == nullptr) {
+    const int64_t slab_numel = std::max(numel, kSlabBytes / itemsize);
+    slabs_.push_back(Slab{torch::zeros({slab_numel}, param.options()), 0});
+    slab = &slabs_.back();
+  }
+
+  const int64_t offset = align_up(slab->used, align);
+  slab->used = offset + numel;
+
+  Tensor view = torch::empty({0}, param.options());
+  view.set_(slab->flat.storage(), offset, param.sizes(), param.strides());
+  return view;
+}
+
+std::vector<Tensor> OptimizerStateArena::slabs() const {
+  std::vector<Tensor> result;
+  result.reserve(slabs_.size());
+  for (const auto& slab : slabs_) {
+    result.push_back(slab.flat);
+  }
+  return result;
+}
+
+} // namespace optim
+} // namespace torch
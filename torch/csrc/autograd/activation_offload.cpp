@@ -0,0 +1,233 @@
+#include <torch/csrc/autograd/activation_offload.h>
+
+#include <c10/core/StreamGuard.h>
+#include <c10/core/impl/VirtualGuardImpl.h>
+
+#include <atomic>
+#include <utility>
+
+namespace torch {
+namespace autograd {
+
+namespace {
+
+std::atomic<bool> offload_enabled{false};
+
+} // namespace
+
+ActivationOffloadEngine& ActivationOffloadEngine::get() {
+  static ActivationOffloadEngine engine;
+  return engine;
+}
+
+bool ActivationOffloadEngine::enabled() {
+  return offload_enabled.load(std::memory_order_relaxed);
+}
+
+void ActivationOffloadEngine::set_enabled(bool enabled) {
+  offload_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+std::unique_ptr<SavedVariableHooks> ActivationOffloadEngine::
+    get_default_hooks() {
+  if (!enabled()) {
+    return nullptr;
+  }
+  return std::make_unique<ActivationOffloadHooks>();
+}
+
+ActivationOffloadEngine::Options ActivationOffloadEngine::options() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return options_;
+}
+
+void ActivationOffloadEngine::set_options(const Options& options) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  options_ = options;
+}
+
+bool ActivationOffloadEngine::should_offload(const at::Tensor& tensor) const {
+  if (!tensor.defined() || !tensor.device().is_cuda() ||
+      tensor.layout() != c10::kStrided) {
+    return false;
+  }
+  return tensor.nbytes() >= options().min_tensor_bytes;
+}
+
+c10::Stream ActivationOffloadEngine::d2h_stream_locked(at::Device device) {
+  auto it = d2h_streams_.find(device.index());
+  if (it == d2h_streams_.end()) {
+    const c10::impl::VirtualGuardImpl impl(device.type());
+    it = d2h_streams_
+             .emplace(device.index(), impl.getStreamFromGlobalPool(device))
+             .first;
+  }
+  return it->second;
+}
+
+c10::Stream ActivationOffloadEngine::h2d_stream_locked(at::Device device) {
+  auto it = h2d_streams_.find(device.index());
+  if (it == h2d_streams_.end()) {
+    const c10::impl::VirtualGuardImpl impl(device.type());
+    // High priority so that readbacks needed by backward are not starved by
+    // already-enqueued compute.
+    it = h2d_streams_
+             .emplace(
+                 device.index(),
+                 impl.getStreamFromGlobalPool(device, /*isHighPriority=*/true))
+             .first;
+  }
+  return it->second;
+}
+
+ActivationOffloadEngine::Handle ActivationOffloadEngine::pack(
+    const at::Tensor& tensor) {
+  const auto device = tensor.device();
+  const c10::impl::VirtualGuardImpl impl(device.type());
+  auto record = std::make_shared<Record>(device);
+  record->bytes = tensor.nbytes();
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  record->sequence = next_sequence_++;
+  auto d2h = d2h_stream_locked(device);
+
+  // Order the staging copy after whatever produced the activation on the
+  // current stream.
+  c10::Event produced(device.type());
+  produced.record(impl.getStream(device));
+  produced.block(d2h);
+
+  record->host = at::empty(
+      tensor.sizes(), tensor.options().device(at::kCPU).pinned_memory(true));
+  {
+    c10::StreamGuard guard(d2h);
+    record->host.copy_(tensor, /*non_blocking=*/true);
+    record->d2h_done.record(d2h);
+  }
+  // The device buffer is typically released as soon as the autograd graph
+  // drops the saved tensor, i.e. before the side-stream copy has run; make
+  // the caching allocator hold it until the copy completes.
+  impl.recordDataPtrOnStream(tensor.storage().data_ptr(), d2h);
+
+  ring_.push_back(RingEntry{record, record->bytes, /*retired=*/false});
+  pending_d2h_bytes_ += record->bytes;
+  throttle_locked(lock);
+  return record;
+}
+
+void ActivationOffloadEngine::throttle_locked(
+    std::unique_lock<std::mutex>& lock) {
+  auto retire_finished = [this]() {
+    for (auto& entry : ring_) {
+      if (entry.retired) {
+        continue;
+      }
+      auto record = entry.record.lock();
+      // An expired record took its events down with it, which is as good as
+      // the copy having completed for accounting purposes.
+      if (!record || record->d2h_done.query()) {
+        entry.retired = true;
+        pending_d2h_bytes_ -= entry.bytes;
+      }
+    }
+    // Entries are only dropped once the owning SavedVariable is gone; live
+    // retired ones stay around as prefetch candidates.
+    while (!ring_.empty() && ring_.front().retired &&
+           ring_.front().record.expired()) {
+      ring_.pop_front();
+    }
+  };
+
+  retire_finished();
+  while (pending_d2h_bytes_ > options_.high_watermark_bytes) {
+    // Block on the stream carrying the oldest outstanding copy; everything
+    // enqueued before it on that stream completes with it.
+    Handle oldest;
+    for (auto& entry : ring_) {
+      if (!entry.retired) {
+        oldest = entry.record.lock();
+        if (oldest) {
+          break;
+        }
+      }
+    }
+    if (!oldest) {
+      break;
+    }
+    const auto device = oldest->device;
+    const c10::impl::VirtualGuardImpl impl(device.type());
+    auto d2h = d2h_stream_locked(device);
+    lock.unlock();
+    impl.synchronizeStream(d2h);
+    lock.lock();
+    retire_finished();
+  }
+}
+
+void ActivationOffloadEngine::prefetch_locked(const Handle& record) {
+  if (record->prefetched.defined()) {
+    return;
+  }
+  auto h2d = h2d_stream_locked(record->device);
+  // The readback must not start before the staging copy has finished.
+  record->d2h_done.block(h2d);
+  c10::StreamGuard guard(h2d);
+  record->prefetched = record->host.to(
+      record->host.options().device(record->device),
+      /*non_blocking=*/true,
+      /*copy=*/true);
+  record->h2d_done.record(h2d);
+}
+
+at::Tensor ActivationOffloadEngine::unpack(const Handle& record) {
+  const c10::impl::VirtualGuardImpl impl(record->device.type());
+  std::unique_lock<std::mutex> lock(mutex_);
+  prefetch_locked(record);
+  record->consumed = true;
+
+  // Backward consumes saved tensors roughly in reverse pack order, so warm
+  // the records packed just before this one while its copy is in flight.
+  size_t warmed = 0;
+  for (auto it = ring_.rbegin();
+       it != ring_.rend() && warmed < options_.prefetch_ahead;
+       ++it) {
+    auto other = it->record.lock();
+    if (!other || other->consumed || other->sequence >= record->sequence ||
+        other->prefetched.defined()) {
+      continue;
+    }
+    prefetch_locked(other);
+    ++warmed;
+  }
+
+  // Moving out (rather than keeping a reference) lets a second unpack under
+  // retain_graph=True issue a fresh readback from the pinned host copy.
+  auto result = std::move(record->prefetched);
+  lock.unlock();
+
+  const auto current = impl.getStream(record->device);
+  record->h2d_done.block(current);
+  // The result was allocated on the side stream but is consumed (and later
+  // freed) on the current stream.
+  impl.recordDataPtrOnStream(result.storage().data_ptr(), current);
+  return result;
+}
+
+void ActivationOffloadHooks::call_pack_hook(const at::Tensor& tensor) {
+  auto& engine = ActivationOffloadEngine::get();
+  if (engine.should_offload(tensor)) {
+    handle_ = engine.pack(tensor);
+  } else {
+    passthrough_ = tensor;
+  }
+}
+
+at::Tensor ActivationOffloadHooks::call_unpack_hook() {
+  if (handle_) {
+    return ActivationOffloadEngine::get().unpack(handle_);
+  }
+  return passthrough_;
+}
+
+} // namespace autograd
+} // namespace torch
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <ATen/core/Tensor.h>
+#include <c10/core/Event.h>
+#include <c10/core/Stream.h>
+#include <torch/csrc/Export.h>
+#include <torch/csrc/autograd/saved_variable_hooks.h>
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace torch {
+namespace autograd {
+
+// Note [Activation offloading]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// When enabled, every tensor saved for backward that is large enough and
+// lives on a device with stream support is copied into a pinned host buffer
+// on a dedicated device-to-host side stream during the forward pass, and the
+// device copy is dropped. On unpack the tensor is copied back on a dedicated
+// host-to-device stream; because backward consumes saved tensors roughly in
+// reverse pack order, each unpack also starts the copies for the next few
+// older records so they overlap with backward compute.
+//
+// The engine is the native (no Python, no per-tensor interpreter overhead)
+// counterpart of a saved_tensors_hooks context manager that does
+// `pack=lambda t: t.cpu()` / `unpack=lambda t: t.to(device)`, and it plugs
+// into the same extension point: SavedVariable::get_default_hooks() returns
+// ActivationOffloadHooks when offloading is enabled and no explicit Python
+// default hooks are installed.
+//
+// Forward progress is throttled on the bytes of device-to-host copies that
+// have been issued but not yet observed complete: above the high watermark,
+// pack() first retires finished copies and, if still above, synchronizes the
+// side stream carrying the oldest one. This bounds both the pinned arena the
+// caching host allocator has to grow and the device memory kept alive by
+// pending copies.
+class TORCH_API ActivationOffloadEngine {
+ public:
+  struct Options {
+    // Tensors smaller than this stay on the device; the copy latency and
+    // pinned-buffer churn are not worth it for them.
+    size_t min_tensor_bytes = 1024 * 1024;
+    // Issued-but-unretired device-to-host bytes above which pack() blocks.
+    size_t high_watermark_bytes = 256 * 1024 * 1024;
+    // How many older records each unpack() warms ahead of backward.
+    size_t prefetch_ahead = 2;
+  };
+
+  // One offloaded activation. Owned jointly by the ActivationOffloadHooks
+  // stored in the SavedVariable and (weakly) by the engine's ring; the
+  // pinned host copy lives as long as the record so that retain_graph
+  // backward passes can unpack repeatedly.
+  struct Record {
+    uint64_t sequence = 0;
+    size_t bytes = 0;
+    at::Device device;
+    at::Tensor host; // pinned staging copy
+    c10::Event d2h_done;
+    bool d2h_retired = false; // host copy observed complete
+    at::Tensor prefetched; // device copy issued ahead of unpack
+    c10::Event h2d_done;
+    bool consumed = false; // unpacked at least once
+
+    explicit Record(at::Device device)
+        : device(device), d2h_done(device.type()), h2d_done(device.type()) {}
+  };
+  using Handle = std::shared_ptr<Record>;
+
+  static ActivationOffloadEngine& get();
+
+  static bool enabled();
+  static void set_enabled(bool enabled);
+
+  // Returns hooks implementing the offload, or nullptr when disabled.
+  // Called per saved tensor by SavedVariable::get_default_hooks().
+  static std::unique_ptr<SavedVariableHooks> get_default_hooks();
+
+  Options options() const;
+  void set_options(const Options& options);
+
+  bool should_offload(const at::Tensor& tensor) const;
+  Handle pack(const at::Tensor& tensor);
+  at::Tensor unpack(const Handle& record);
+
+ private:
+  ActivationOffloadEngine() = default;
+
+  // All _locked members expect mutex_ to be held.
+  void throttle_locked(std::unique_lock<std::mutex>& lock);
+  void prefetch_locked(const Handle& record);
+  c10::Stream d2h_stream_locked(at::Device device);
+  c10::Stream h2d_stream_locked(at::Device device);
+
+  // Ring slot for a record, in pack order. The byte count is duplicated
+  // here so that records whose owning SavedVariable died before their copy
+  // was retired can still be accounted for.
+  struct RingEntry {
+    std::weak_ptr<Record> record;
+    size_t bytes;
+    bool retired;
+  };
+
+  mutable std::mutex mutex_;
+  Options options_;
+  uint64_t next_sequence_ = 0;
+  std::deque<RingEntry> ring_;
+  size_t pending_d2h_bytes_ = 0;
+  // Dedicated side streams, one pair per device, fetched lazily from the
+  // global pool so they never alias the compute stream.
+  std::unordered_map<c10::DeviceIndex, c10::Stream> d2h_streams_;
+  std::unordered_map<c10::DeviceIndex, c10::Stream> h2d_streams_;
+};
+
+struct TORCH_API ActivationOffloadHooks : public SavedVariableHooks {
+  void call_pack_hook(const at::Tensor& tensor) override;
+  at::Tensor call_unpack_hook() override;
+
+ private:
+  ActivationOffloadEngine::Handle handle_;
+  // Tensors not worth offloading are passed through unchanged.
+  at::Tensor passthrough_;
+};
+
+} // namespace autograd
+} // namespace torch
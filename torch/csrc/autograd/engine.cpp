@@ -19,6 +19,7 @@
 #include <c10/core/StreamGuard.h>
 #include <c10/util/Exception.h>
 #include <c10/util/Optional.h>
+#include <c10/util/SpinWait.h>
 #include <c10/util/ThreadLocal.h>
 #include <c10/util/irange.h>
 
@@ -212,6 +213,7 @@ auto ReadyQueue::push(NodeTask item, bool incrementOutstandingTasks) -> void {
       ++graph_task->outstanding_tasks_;
     }
     heap_.push(std::move(item));
+    ++num_tasks_;
   }
   not_empty_.notify_one();
 }
@@ -220,6 +222,7 @@ auto ReadyQueue::pushShutdownTask() -> void {
   {
     std::lock_guard<std::mutex> lock(mutex_);
     heap_.push(NodeTask({}, nullptr, InputBuffer(0), true));
+    ++num_tasks_;
   }
   not_empty_.notify_one();
 }
@@ -231,12 +234,16 @@ size_t ReadyQueue::size() const {
 }
 
 auto ReadyQueue::pop() -> NodeTask {
+  // Spin briefly before parking: a producer is usually about to publish the
+  // next task, and polling the task counter skips the futex round trip.
+  c10::spin_wait([this] { return num_tasks_.load() != 0; });
   // Lock mutex for accesses to heap_
   std::unique_lock<std::mutex> lock(mutex_);
   not_empty_.wait(lock, [this] { return !heap_.empty(); });
   // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
   auto task = std::move(const_cast<NodeTask&>(heap_.top()));
   heap_.pop();
+  --num_tasks_;
   return task;
 }
 
@@ -246,6 +253,95 @@ bool ReadyQueue::empty() const {
   return heap_.empty();
 }
 
+WorkStealingReadyQueue::WorkStealingReadyQueue(size_t num_shards)
+    : shards_(num_shards) {
+  TORCH_INTERNAL_ASSERT(num_shards > 0);
+}
+
+size_t WorkStealingReadyQueue::home_shard() const {
+  static std::atomic<size_t> next_thread_id{0};
+  static thread_local size_t thread_id = next_thread_id++;
+  return thread_id % shards_.size();
+}
+
+auto WorkStealingReadyQueue::push(NodeTask item, bool incrementOutstandingTasks)
+    -> void {
+  auto& shard = shards_[home_shard()];
+  {
+    std::lock_guard<std::mutex> lock(shard.mutex_);
+    if (incrementOutstandingTasks) {
+      std::shared_ptr<GraphTask> graph_task = item.base_.lock();
+      TORCH_INTERNAL_ASSERT(graph_task, "GraphTask is no longer valid!");
+      ++graph_task->outstanding_tasks_;
+    }
+    shard.heap_.push(std::move(item));
+  }
+  ++total_size_;
+  if (sleepers_.load() > 0) {
+    // Briefly take the sleep mutex so the notify cannot race with a waiter
+    // that checked total_size_ but has not gone to sleep yet.
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+    not_empty_.notify_one();
+  }
+}
+
+auto WorkStealingReadyQueue::pushShutdownTask() -> void {
+  auto& shard = shards_[home_shard()];
+  {
+    std::lock_guard<std::mutex> lock(shard.mutex_);
+    shard.heap_.push(NodeTask({}, nullptr, InputBuffer(0), true));
+  }
+  ++total_size_;
+  // Wake everything up during shutdown; each shutdown task terminates one
+  // popping thread.
+  std::lock_guard<std::mutex> lock(sleep_mutex_);
+  not_empty_.notify_all();
+}
+
+bool WorkStealingReadyQueue::try_pop_from(Shard& shard, NodeTask& task) {
+  std::lock_guard<std::mutex> lock(shard.mutex_);
+  if (shard.heap_.empty()) {
+    return false;
+  }
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+  task = std::move(const_cast<NodeTask&>(shard.heap_.top()));
+  shard.heap_.pop();
+  --total_size_;
+  return true;
+}
+
+auto WorkStealingReadyQueue::pop() -> NodeTask {
+  const size_t home = home_shard();
+  const size_t num_shards = shards_.size();
+  NodeTask task({}, nullptr, InputBuffer(0));
+  while (true) {
+    // Prefer the home shard, then steal round robin from the others.
+    for (const auto i : c10::irange(num_shards)) {
+      if (try_pop_from(shards_[(home + i) % num_shards], task)) {
+        return task;
+      }
+    }
+    // Spin briefly before sleeping; another thread is often about to push
+    // or finish a task, and rescanning beats the futex round trip.
+    if (c10::spin_wait([this] { return total_size_.load() != 0; })) {
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(sleep_mutex_);
+    ++sleepers_;
+    not_empty_.wait(lock, [this] { return total_size_.load() != 0; });
+    --sleepers_;
+    // Another thread may win the race for the task that woke us; rescan.
+  }
+}
+
+size_t WorkStealingReadyQueue::size() const {
+  return total_size_.load();
+}
+
+bool WorkStealingReadyQueue::empty() const {
+  return total_size_.load() == 0;
+}
+
 Engine::Engine()
     : max_recursion_depth_(MAX_DEPTH), non_reentrant_device_thread_count_(0) {}
 
@@ -272,10 +368,19 @@ void Engine::stop() {
   for (auto& queue : device_ready_queues_) {
     noBackward = noBackward && queue->empty();
   }
+  if (cpu_worker_queue_) {
+    noBackward = noBackward && cpu_worker_queue_->empty();
+  }
   if (noBackward && wait_duration > 0.0f) {
     for (auto& queue : device_ready_queues_) {
       queue->pushShutdownTask();
     }
+    if (cpu_worker_queue_) {
+      for (const auto i : c10::irange(cpu_worker_pool_size())) {
+        (void)i;
+        cpu_worker_queue_->pushShutdownTask();
+      }
+    }
     // Do not wait for termination of global threads on Windows
     // Because CRT terminates DLL threads before calling
     // global object destructors
@@ -824,6 +929,15 @@ static variable_list call_function(
     outputs = fn(std::move(inputs));
   }
 
+  if (!graph_task->keep_graph_) {
+    // Release saved variables as soon as apply has enqueued its kernels,
+    // rather than after output validation and post hooks: the caching
+    // allocators free stream-ordered, so the activations' blocks become
+    // reusable by the very next allocation on the stream instead of staying
+    // pinned across whatever the post hooks run (e.g. DDP's allreduce).
+    fn.release_variables();
+  }
+
   validate_outputs(fn.next_edges(), outputs, [&](const std::string& msg) {
     std::ostringstream ss;
     ss << "Function " << fn.name() << " returned an " << msg;
@@ -870,6 +984,12 @@ void Engine::evaluate_function(
     }
     if (!fn_info.needed_) {
       // Skip execution if we don't need to execute the function.
+      if (!graph_task->keep_graph_) {
+        // This node will never run (and the graph cannot be re-executed
+        // once its buffers are released), so its saved activations can be
+        // freed now instead of lingering until the graph is destroyed.
+        func->release_variables();
+      }
       return;
     }
   }
@@ -877,10 +997,6 @@ void Engine::evaluate_function(
   auto outputs = call_function(graph_task, func, inputs);
 
   auto& fn = *func;
-  if (!graph_task->keep_graph_) {
-    fn.release_variables();
-  }
-
   int num_outputs = outputs.size();
   if (num_outputs == 0) { // Note: doesn't acquire the mutex
     // Records leaf stream (if applicable)
@@ -985,10 +1101,50 @@ inline static uint64_t compute_min_topological_nr(const edge_list& outputs) {
   return min_topo_nr;
 }
 
+// Note [Dependency cache]
+// ~~~~~~~~~~~~~~~~~~~~~~~
+// A Node's next_edges are fixed once the node is constructed, so for a given
+// live root node (and min_topo_nr) the dependency counts computed below are
+// the same on every backward call. Training loops that retain the graph and
+// call backward repeatedly over it would otherwise pay for a full graph
+// re-traversal each step just to rebuild an identical hash map. We therefore
+// remember the counts from the most recent backward over a retained graph
+// and, when the same root comes back, copy them into the new GraphTask
+// instead of re-traversing.
+//
+// The cache is only populated when keep_graph is set: without it the nodes
+// are released during execution, so the same root can never legally come
+// back. A hit requires the incoming root to match the cached root's address,
+// sequence_nr, topological_nr and fan-out; sequence numbers increase
+// monotonically per thread, so a recycled allocation at the same address
+// cannot impersonate a previously cached node. The counts depend only on
+// graph topology, not on exec_info or hooks, which is why a single backward
+// graph can serve both .backward() and .grad() calls over it.
 auto Engine::compute_dependencies(
     Node* root,
     GraphTask& task,
     uint64_t min_topo_nr) -> void {
+  {
+    std::lock_guard<std::mutex> lock(dependency_cache_lock_);
+    const auto& cache = dependency_cache_;
+    if (cache.root == root && cache.root_sequence_nr == root->sequence_nr() &&
+        cache.root_topological_nr == root->topological_nr() &&
+        cache.num_root_edges == root->next_edges().size() &&
+        cache.min_topo_nr == min_topo_nr) {
+      task.dependencies_ = cache.dependencies;
+      if (cache.will_use_cuda) {
+        // Streams are captured per-iteration, so this cannot be cached.
+        task.stash_current_streams();
+      }
+      if (!task.keep_graph_) {
+        // This backward releases the graph; drop the entry so a recycled
+        // allocation can never match it.
+        dependency_cache_ = DependencyCache();
+      }
+      return;
+    }
+  }
+
   // Computes the number of dependencies for each function which requires grad
   std::unordered_set<Node*> seen;
   std::vector<Node*> queue{root};
@@ -1022,6 +1178,24 @@ auto Engine::compute_dependencies(
     // so GraphTask::exec_post_processing can sync them with leaf_streams.
     task.stash_current_streams();
   }
+
+  {
+    std::lock_guard<std::mutex> lock(dependency_cache_lock_);
+    if (task.keep_graph_) {
+      dependency_cache_ = DependencyCache{
+          root,
+          root->sequence_nr(),
+          root->topological_nr(),
+          root->next_edges().size(),
+          min_topo_nr,
+          will_use_cuda,
+          dependencies};
+    } else if (dependency_cache_.root == root) {
+      // The graph will be released during this backward; drop the stale
+      // entry so a recycled allocation can never match it.
+      dependency_cache_ = DependencyCache();
+    }
+  }
 }
 
 auto Engine::execute(
@@ -1055,8 +1229,17 @@ auto Engine::execute(
   // initialize a new thread local ready queue on CPU or reuse the existing one
   // (if there is one allocated already, i.e. consecutive backward calls,
   // re-entrant backward calls), then memoize the local_ready_queue in GraphTask
-  init_local_ready_queue();
   bool not_reentrant_backward_call = worker_device == NO_DEVICE;
+  if (not_reentrant_backward_call && cpu_worker_pool_size() > 0) {
+    // Route CPU work through the shared work-stealing queue so the CPU
+    // worker pool can execute independent branches of the graph in parallel
+    // with this thread. See [Note: CPU autograd worker pool].
+    c10::call_once(
+        start_cpu_workers_flag_, &Engine::start_cpu_worker_threads, this);
+    init_local_ready_queue(cpu_worker_queue_);
+  } else {
+    init_local_ready_queue();
+  }
 
   auto graph_task = std::make_shared<GraphTask>(
       /* keep_graph */ keep_graph,
@@ -1315,6 +1498,67 @@ auto Engine::start_device_threads() -> void {
   }
 }
 
+// [Note: CPU autograd worker pool]
+// By default all CPU NodeTasks of a backward pass are executed by the one
+// thread that called Engine::execute (see the comment above
+// tls_local_ready_queue): the per-graph-task CPU ready queue has a single
+// consumer, so independent branches of a wide, CPU-heavy graph run strictly
+// sequentially while the rest of the machine idles.
+//
+// Setting TORCH_AUTOGRAD_CPU_WORKERS=N starts N long-running CPU worker
+// threads on the first top-level backward call. Top-level calls then use a
+// single process-wide WorkStealingReadyQueue as the CPU ready queue (both as
+// the calling thread's local queue and as GraphTask::cpu_ready_queue_), so
+// ready CPU NodeTasks can be popped concurrently by the calling thread and
+// the workers, with per-thread shards to keep queue contention off the hot
+// path. Correctness falls out of the existing protocol:
+//  - outstanding_tasks_ accounting and GraphTask::completed() are unchanged;
+//  - workers keep worker_device == NO_DEVICE and never own a graph task, so
+//    the dummy-NodeTask handoff in thread_main keeps re-arming until the
+//    owning thread observes completion;
+//  - concurrent backward calls from different user threads simply share the
+//    queue, each completing via its own GraphTask;
+//  - a reentrant backward issued from a worker is treated as a fresh
+//    top-level call (worker_device is NO_DEVICE there), which blocks that
+//    worker but leaves the rest of the pool and the owning thread running.
+size_t Engine::cpu_worker_pool_size() {
+  static const size_t num_workers = []() -> size_t {
+    const char* str = std::getenv("TORCH_AUTOGRAD_CPU_WORKERS");
+    if (!str) {
+      return 0;
+    }
+    const int val = std::atoi(str);
+    return val > 0 ? static_cast<size_t>(val) : 0;
+  }();
+  return num_workers;
+}
+
+void Engine::start_cpu_worker_threads() {
+  const auto num_workers = cpu_worker_pool_size();
+  // One shard per worker plus one for the calling thread(s).
+  cpu_worker_queue_ = std::make_shared<WorkStealingReadyQueue>(num_workers + 1);
+
+  // Since we're about to create threads, forking is not possible anymore
+  track_bad_autograd_forks();
+
+  for (const auto i : c10::irange(num_workers)) {
+    (void)i;
+    std::thread t(&Engine::cpu_worker_thread_init, this);
+    t.detach();
+  }
+}
+
+void Engine::cpu_worker_thread_init() {
+  increment_non_reentrant_thread_count();
+  at::init_num_threads();
+  // Deliberately leave worker_device at NO_DEVICE: the pool thread never
+  // owns a graph task, and the completion handoff in thread_main only
+  // re-arms when worker_device != owner.
+  init_local_ready_queue(cpu_worker_queue_);
+  thread_main(nullptr);
+  decrement_non_reentrant_thread_count();
+}
+
 void Engine::add_thread_pool_task(const std::weak_ptr<GraphTask>& graph_task) {
   std::unique_lock<std::mutex> lck(thread_pool_shared_->mutex_);
   // There may already be some items on the graphtasks_queue_ added by other
@@ -255,7 +255,7 @@ class CheckpointValidGuard {
 };
 
 struct ReadyQueue {
- private:
+ protected:
   // Returns true when t2 should be (weakly) BEFORE t1 in the queue.
   // Shutdown tasks are first and then empty NodeTask are next.
   struct CompareNodeTaskTime {
@@ -275,24 +275,71 @@ struct ReadyQueue {
     }
   };
 
+ private:
   // To notify threads waiting on the ReadyQueue of available tasks on the heap_
   std::condition_variable not_empty_;
   // To protect read and writes to heap_
   mutable std::mutex mutex_;
+  // Number of queued tasks, kept in sync with heap_ so that pop() can poll
+  // for work from its pre-park spin loop without taking mutex_.
+  std::atomic<size_t> num_tasks_{0};
 
   std::priority_queue<NodeTask, std::vector<NodeTask>, CompareNodeTaskTime>
       heap_;
 
  public:
+  virtual ~ReadyQueue() = default;
+
   // incrementOutstandingTasks indicates whether or not we should increment
   // 'outstanding_tasks_' for the associated GraphTask. This should mostly
   // always be true and is only set false in certain cases (see docs for
   // DistEngine.execute_graph_task_until_ready_queue_empty)
-  void push(NodeTask item, bool incrementOutstandingTasks = true);
-  void pushShutdownTask();
-  NodeTask pop();
-  bool empty() const;
-  size_t size() const;
+  virtual void push(NodeTask item, bool incrementOutstandingTasks = true);
+  virtual void pushShutdownTask();
+  virtual NodeTask pop();
+  virtual bool empty() const;
+  virtual size_t size() const;
+};
+
+// A ReadyQueue sharded into one priority heap per popping thread, with work
+// stealing. Used as the process-wide CPU ready queue when the CPU worker
+// pool is enabled, so that many threads can pop NodeTasks without
+// serializing on a single mutex. Pushes go to the calling thread's home
+// shard; pops scan the home shard first and then steal from the others.
+// Task priority ordering is only maintained per shard, which is acceptable
+// since the comparator is a scheduling heuristic, not a correctness
+// requirement. See [Note: CPU autograd worker pool].
+struct WorkStealingReadyQueue final : ReadyQueue {
+  explicit WorkStealingReadyQueue(size_t num_shards);
+
+  void push(NodeTask item, bool incrementOutstandingTasks = true) override;
+  void pushShutdownTask() override;
+  NodeTask pop() override;
+  bool empty() const override;
+  size_t size() const override;
+
+ private:
+  struct Shard {
+    mutable std::mutex mutex_;
+    std::priority_queue<NodeTask, std::vector<NodeTask>, CompareNodeTaskTime>
+        heap_;
+  };
+
+  // Index of the calling thread's home shard, assigned round robin on first
+  // use per thread.
+  size_t home_shard() const;
+  bool try_pop_from(Shard& shard, NodeTask& task);
+
+  std::vector<Shard> shards_;
+  // Total number of queued tasks across all shards.
+  std::atomic<size_t> total_size_{0};
+  // Number of threads currently blocked in pop(); lets push() skip the sleep
+  // mutex when nobody is waiting.
+  std::atomic<int64_t> sleepers_{0};
+  // Threads with no work to pop or steal wait here; the predicate is
+  // total_size_ != 0.
+  mutable std::mutex sleep_mutex_;
+  std::condition_variable not_empty_;
 };
 
 // A single instance of this struct should be created through the whole process
@@ -385,6 +432,13 @@ struct TORCH_API Engine {
   // start device threads (CUDA, XLA, etc.) in Engine,
   // note that it does NOT start CPU thread.
   void start_device_threads();
+  // start the optional CPU worker pool and its shared work-stealing queue;
+  // see [Note: CPU autograd worker pool]
+  void start_cpu_worker_threads();
+  void cpu_worker_thread_init();
+  // Number of CPU worker threads requested via TORCH_AUTOGRAD_CPU_WORKERS
+  // (0 when the pool is disabled, the default).
+  static size_t cpu_worker_pool_size();
   void increment_non_reentrant_thread_count();
   void decrement_non_reentrant_thread_count();
   virtual void thread_main(const std::shared_ptr<GraphTask>& task);
@@ -394,11 +448,37 @@ struct TORCH_API Engine {
   // Ensures device_ready_queues_ are initialized only once
   // NOLINTNEXTLINE(cppcoreguidelines-non-private-member-variables-in-classes)
   c10::once_flag start_device_threads_flag_;
+  // Ensures the CPU worker pool is started only once
+  // NOLINTNEXTLINE(cppcoreguidelines-non-private-member-variables-in-classes)
+  c10::once_flag start_cpu_workers_flag_;
+  // Shared CPU ready queue serviced by the CPU worker pool; null unless
+  // TORCH_AUTOGRAD_CPU_WORKERS is set. Safe to read without synchronization
+  // after initialization. See [Note: CPU autograd worker pool].
+  // NOLINTNEXTLINE(cppcoreguidelines-non-private-member-variables-in-classes)
+  std::shared_ptr<ReadyQueue> cpu_worker_queue_;
   // Safe to read device_ready_queues_ without synchronization after
   // initialization
   // NOLINTNEXTLINE(cppcoreguidelines-non-private-member-variables-in-classes)
   std::vector<std::shared_ptr<ReadyQueue>> device_ready_queues_;
 
+  // Cached dependency counts from the most recent backward over a retained
+  // graph, so repeated backward calls over the same graph skip the
+  // re-traversal in compute_dependencies. See Note [Dependency cache].
+  struct DependencyCache {
+    Node* root = nullptr;
+    uint64_t root_sequence_nr = 0;
+    uint64_t root_topological_nr = 0;
+    size_t num_root_edges = 0;
+    uint64_t min_topo_nr = 0;
+    bool will_use_cuda = false;
+    std::unordered_map<Node*, int> dependencies;
+  };
+  // NOLINTNEXTLINE(cppcoreguidelines-non-private-member-variables-in-classes)
+  DependencyCache dependency_cache_;
+  // To protect reads and writes to dependency_cache_
+  // NOLINTNEXTLINE(cppcoreguidelines-non-private-member-variables-in-classes)
+  std::mutex dependency_cache_lock_;
+
   // NOLINTNEXTLINE(cppcoreguidelines-non-private-member-variables-in-classes)
   std::vector<std::function<void()>> final_callbacks_;
   // To protect reads and writes to final_callbacks_
@@ -2,6 +2,7 @@
 
 #include <c10/util/ThreadLocal.h>
 #include <torch/csrc/autograd/engine.h>
+#include <torch/csrc/autograd/node_pool.h>
 #include <torch/csrc/autograd/variable.h>
 
 #include <ATen/ATen.h>
@@ -32,6 +33,14 @@ NodeGuard::~NodeGuard() {
   current_evaluating_node = std::move(last_evaluating_node_);
 }
 
+void* Node::operator new(size_t size) {
+  return allocate_node(size);
+}
+
+void Node::operator delete(void* ptr) {
+  deallocate_node(ptr);
+}
+
 void Node::assign_parent() {
   metadata()->assign_parent(current_evaluating_node);
 }
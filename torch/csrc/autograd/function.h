@@ -142,6 +142,14 @@ struct TORCH_API Node : std::enable_shared_from_this<Node> {
   Node& operator=(Node&& other) = delete;
   virtual ~Node() = default;
 
+  /// Nodes (and their subclasses) are allocated from a size-bucketed slab
+  /// pool: one Node per forward op adds up to a lot of small mallocs, and
+  /// pool slabs keep Nodes built together adjacent in memory, which is
+  /// roughly the order backward visits them. See Note [Node pool] in
+  /// node_pool.cpp.
+  static void* operator new(size_t size);
+  static void operator delete(void* ptr);
+
   /// Evaluates the function on the given inputs and returns the result of the
   /// function call.
   variable_list operator()(variable_list&& inputs) {
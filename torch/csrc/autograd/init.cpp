@@ -8,6 +8,7 @@
 #include <c10/core/InferenceMode.h>
 #include <c10/core/ScalarType.h>
 #include <torch/csrc/Exceptions.h>
+#include <torch/csrc/autograd/activation_offload.h>
 #include <torch/csrc/autograd/autograd.h>
 #include <torch/csrc/autograd/function.h>
 #include <torch/csrc/autograd/grad_mode.h>
@@ -24,6 +25,7 @@
 #include <torch/csrc/profiler/collection.h>
 #include <torch/csrc/profiler/execution_graph_observer.h>
 #include <torch/csrc/profiler/kineto_shim.h>
+#include <torch/csrc/profiler/sampling_observer.h>
 #include <torch/csrc/utils/disable_torch_function.h>
 #include <torch/csrc/utils/pybind.h>
 #include <torch/csrc/utils/pycfunction_helpers.h>
@@ -104,7 +106,8 @@ PyObject* THPAutograd_initExtension(PyObject* _unused, PyObject* unused) {
       .def(
           py::init<
               std::vector<std::string> /* profiler_metrics */,
-              bool /* profiler_measure_per_kernel */
+              bool /* profiler_measure_per_kernel */,
+              std::vector<std::string> /* performance_events */
               >(),
           "An experimental config for Kineto features. Please note that"
           "backward compatibility is not guaranteed.\n"
@@ -112,9 +115,13 @@ PyObject* THPAutograd_initExtension(PyObject* _unused, PyObject* unused) {
           "       to measure GPU performance events.\n"
           "       If this list contains values Kineto runs in CUPTI profiler mode\n"
           "    profiler_measure_per_kernel (bool) : whether to profile metrics per kernel\n"
-          "       or for the entire measurement duration.",
+          "       or for the entire measurement duration.\n"
+          "    performance_events : a list of CPU hardware counter names (e.g.\n"
+          "       cycles, instructions, cache-misses) counted per op via\n"
+          "       Linux perf_event and attached to the trace.",
           py::arg("profiler_metrics") = std::vector<std::string>(),
-          py::arg("profiler_measure_per_kernel") = false)
+          py::arg("profiler_measure_per_kernel") = false,
+          py::arg("performance_events") = std::vector<std::string>())
       .def(py::pickle(
           [](const ExperimentalConfig& p) { // __getstate__
             py::list py_metrics;
@@ -122,12 +129,18 @@ PyObject* THPAutograd_initExtension(PyObject* _unused, PyObject* unused) {
               py::bytes mbytes(metric);
               py_metrics.append(mbytes);
             }
+            py::list py_perf_events;
+            for (const auto& event : p.performance_events) {
+              py::bytes mbytes(event);
+              py_perf_events.append(mbytes);
+            }
             /* Return a tuple that fully encodes the state of the config */
-            return py::make_tuple(py_metrics, p.profiler_measure_per_kernel);
+            return py::make_tuple(
+                py_metrics, p.profiler_measure_per_kernel, py_perf_events);
           },
           [](py::tuple t) { // __setstate__
-            if (t.size() != 2) {
-              throw std::runtime_error("Expected 2 values in state");
+            if (t.size() != 3) {
+              throw std::runtime_error("Expected 3 values in state");
             }
 
             py::list py_metrics = t[0].cast<py::list>();
@@ -137,7 +150,17 @@ PyObject* THPAutograd_initExtension(PyObject* _unused, PyObject* unused) {
               metrics.push_back(py::str(py_metric));
             }
 
-            return ExperimentalConfig(std::move(metrics), t[1].cast<bool>());
+            py::list py_perf_events = t[2].cast<py::list>();
+            std::vector<std::string> performance_events{py_perf_events.size()};
+
+            for (const auto& py_perf_event : py_perf_events) {
+              performance_events.push_back(py::str(py_perf_event));
+            }
+
+            return ExperimentalConfig(
+                std::move(metrics),
+                t[1].cast<bool>(),
+                std::move(performance_events));
           }));
 
   py::class_<ProfilerConfig>(m, "ProfilerConfig")
@@ -267,6 +290,19 @@ PyObject* THPAutograd_initExtension(PyObject* _unused, PyObject* unused) {
       // Whether this is async event or not
       .def("is_async", [](const KinetoEvent& e) { return e.isAsync(); })
       .def("cuda_elapsed_us", &KinetoEvent::cudaElapsedUs)
+      // kernel launch tail latency, see Note [Launch tail latency]
+      .def(
+          "cuda_launch_count",
+          [](const KinetoEvent& e) { return e.cudaLaunchCount(); })
+      .def(
+          "cuda_launch_stall_us",
+          [](const KinetoEvent& e) { return e.cudaLaunchStallUs(); })
+      .def(
+          "cuda_launch_queue_depth",
+          [](const KinetoEvent& e) { return e.cudaLaunchQueueDepth(); })
+      .def(
+          "is_launch_bound",
+          [](const KinetoEvent& e) { return e.isLaunchBound(); })
       .def("nbytes", [](const KinetoEvent& e) { return e.nBytes(); });
 
   {
@@ -366,6 +402,34 @@ PyObject* THPAutograd_initExtension(PyObject* _unused, PyObject* unused) {
       "_disable_execution_graph_observer",
       &torch::profiler::impl::disableExecutionGraphObserver);
 
+  // PyTorch always-on sampling observer internal interface.
+  m.def(
+      "_add_sampling_observer",
+      [](int64_t sampling_period,
+         size_t ring_size,
+         int64_t latency_threshold_us,
+         const std::string& trace_dir) {
+        torch::profiler::impl::SamplingObserverConfig config;
+        config.sampling_period = sampling_period;
+        config.ring_size = ring_size;
+        config.latency_threshold_us = latency_threshold_us;
+        config.trace_dir = trace_dir;
+        return torch::profiler::impl::addSamplingObserver(config);
+      },
+      py::arg("sampling_period"),
+      py::arg("ring_size"),
+      py::arg("latency_threshold_us"),
+      py::arg("trace_dir"));
+  m.def(
+      "_remove_sampling_observer",
+      &torch::profiler::impl::removeSamplingObserver);
+  m.def(
+      "_sampling_observer_request_begin",
+      &torch::profiler::impl::samplingObserverRequestBegin);
+  m.def(
+      "_sampling_observer_request_end",
+      &torch::profiler::impl::samplingObserverRequestEnd);
+
   // NOTICE: These record functions are not torch operators and may not show up
   // in TorchScript tracing, FX transforms, or operator serialization. For these
   // use cases, please use `torch.profiler.record_function`.
@@ -447,6 +511,13 @@ PyObject* THPAutograd_initExtension(PyObject* _unused, PyObject* unused) {
   m.def("_pop_saved_tensors_default_hooks", []() {
     torch::autograd::PyDefaultSavedVariableHooks::pop_hooks();
   });
+  // See Note [Activation offloading]
+  m.def("_set_activation_offloading_enabled", [](bool enabled) {
+    torch::autograd::ActivationOffloadEngine::set_enabled(enabled);
+  });
+  m.def("_is_activation_offloading_enabled", []() {
+    return torch::autograd::ActivationOffloadEngine::enabled();
+  });
 
   _C_m.def(
       "_register_py_class_for_device",
@@ -0,0 +1,150 @@
+#include <torch/csrc/autograd/node_pool.h>
+
+#include <c10/macros/Macros.h>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace torch {
+namespace autograd {
+
+// Note [Node pool]
+// ~~~~~~~~~~~~~~~~
+// Autograd Nodes are small, short-lived and allocated one per forward op:
+// building the graph of a large model is tens of thousands of individual
+// mallocs per iteration, and the resulting Nodes scatter across the heap,
+// so the backward traversal chases pointers into cold lines. This pool
+// backs Node::operator new with size-bucketed slabs: allocations of a
+// bucket are carved consecutively out of 64 KB slabs - consecutive in
+// Node construction order, which is roughly backward visitation order -
+// and freed blocks go to a per-bucket freelist for reuse, so the steady
+// state performs no mallocs at all.
+//
+// The pool deliberately frees Nodes individually rather than wholesale
+// per backward pass. A Node's lifetime is the autograd graph's, not the
+// backward epoch's: tensors hold their grad_fn, graphs are kept across
+// backward calls with retain_graph, and a GraphTask only borrows the
+// graph it traverses. Slabs are never returned to the system; the pool's
+// high-water mark is one iteration's graph, which the next iteration
+// reuses.
+//
+// Blocks carry a one-word header with their bucket index so that the
+// unsized operator delete can route them back; oversized allocations
+// (a sentinel index) fall through to ::operator new. The header is 16
+// bytes to preserve max_align_t alignment for the Node behind it.
+
+namespace {
+
+constexpr size_t kAlignment = alignof(std::max_align_t);
+constexpr size_t kHeaderSize = kAlignment >= 16 ? kAlignment : 16;
+constexpr size_t kBucketStep = 64;
+constexpr size_t kMaxBucketedSize = 1024;
+constexpr size_t kNumBuckets = kMaxBucketedSize / kBucketStep;
+constexpr size_t kOversized = kNumBuckets;
+constexpr size_t kSlabSize = 64 * 1024;
+
+struct FreeBlock {
+  FreeBlock* next;
+};
+
+struct Bucket {
+  std::mutex mutex;
+  FreeBlock* freelist = nullptr;
+  std::vector<std::unique_ptr<char[]>> slabs;
+  char* bump = nullptr;
+  char* slab_end = nullptr;
+};
+
+struct NodePool {
+  std::array<Bucket, kNumBuckets> buckets;
+  std::atomic<size_t> allocated_bytes{0};
+  std::atomic<size_t> reserved_bytes{0};
+};
+
+NodePool& pool() {
+  // Leaky singleton: Nodes can be freed during program teardown.
+  static NodePool* pool = new NodePool();
+  return *pool;
+}
+
+size_t bucket_index(size_t block_size) {
+  return (block_size - 1) / kBucketStep;
+}
+
+void write_header(void* block, size_t index) {
+  *static_cast<size_t*>(block) = index;
+}
+
+size_t read_header(void* block) {
+  return *static_cast<size_t*>(block);
+}
+
+} // namespace
+
+void* allocate_node(size_t size) {
+  const size_t block_size = size + kHeaderSize;
+  if (block_size > kMaxBucketedSize) {
+    void* block = ::operator new(block_size);
+    write_header(block, kOversized);
+    return static_cast<char*>(block) + kHeaderSize;
+  }
+
+  const size_t index = bucket_index(block_size);
+  const size_t bucketed_size = (index + 1) * kBucketStep;
+  Bucket& bucket = pool().buckets[index];
+  void* block = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(bucket.mutex);
+    if (bucket.freelist != nullptr) {
+      block = bucket.freelist;
+      bucket.freelist = bucket.freelist->next;
+    } else {
+      if (static_cast<size_t>(bucket.slab_end - bucket.bump) < bucketed_size) {
+        bucket.slabs.emplace_back(new char[kSlabSize]);
+        bucket.bump = bucket.slabs.back().get();
+        bucket.slab_end = bucket.bump + kSlabSize;
+        pool().reserved_bytes.fetch_add(kSlabSize, std::memory_order_relaxed);
+      }
+      block = bucket.bump;
+      bucket.bump += bucketed_size;
+    }
+  }
+  write_header(block, index);
+  pool().allocated_bytes.fetch_add(bucketed_size, std::memory_order_relaxed);
+  return static_cast<char*>(block) + kHeaderSize;
+}
+
+void deallocate_node(void* ptr) {
+  if (ptr == nullptr) {
+    return;
+  }
+  void* block = static_cast<char*>(ptr) - kHeaderSize;
+  const size_t index = read_header(block);
+  if (index == kOversized) {
+    ::operator delete(block);
+    return;
+  }
+  Bucket& bucket = pool().buckets[index];
+  pool().allocated_bytes.fetch_sub(
+      (index + 1) * kBucketStep, std::memory_order_relaxed);
+  std::lock_guard<std::mutex> lock(bucket.mutex);
+  auto* free_block = static_cast<FreeBlock*>(block);
+  free_block->next = bucket.freelist;
+  bucket.freelist = free_block;
+}
+
+NodePoolStats node_pool_stats() {
+  NodePoolStats stats;
+  stats.allocated_bytes =
+      pool().allocated_bytes.load(std::memory_order_relaxed);
+  stats.reserved_bytes = pool().reserved_bytes.load(std::memory_order_relaxed);
+  return stats;
+}
+
+} // namespace autograd
+} // namespace torch
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <torch/csrc/Export.h>
+
+#include <cstddef>
+
+namespace torch {
+namespace autograd {
+
+// A size-bucketed slab pool backing `Node::operator new`. See
+// Note [Node pool] in node_pool.cpp.
+TORCH_API void* allocate_node(size_t size);
+TORCH_API void deallocate_node(void* ptr);
+
+struct TORCH_API NodePoolStats {
+  // Bytes currently handed out to live Nodes.
+  size_t allocated_bytes = 0;
+  // Bytes held in slabs (live Nodes plus the freelists).
+  size_t reserved_bytes = 0;
+};
+TORCH_API NodePoolStats node_pool_stats();
+
+} // namespace autograd
+} // namespace torch
@@ -17,6 +17,7 @@
 
 #include <ATen/Context.h>
 
+#include <algorithm>
 #include <deque>
 #include <limits>
 #include <sstream>
@@ -67,10 +68,12 @@ struct EventFieldsVisitor {
   EventFieldsVisitor(
       std::shared_ptr<Result>& result,
       KinetoEvent& kineto_event,
-      const post_process_t& post_process)
+      const post_process_t& post_process,
+      const std::vector<std::string>& performance_events)
       : kineto_activity_{result->kineto_activity_},
         kineto_event_{kineto_event},
-        post_process_{post_process} {
+        post_process_{post_process},
+        performance_events_{performance_events} {
     pushPythonMetadata(result->parent_.lock());
     c10::visit(*this, result->extra_fields_);
     handleStack(result->parent_);
@@ -114,6 +117,14 @@ struct EventFieldsVisitor {
       addMetadata("Fwd thread id", std::to_string(op_event.forward_tid_));
       addMetadata("Sequence number", std::to_string(op_event.sequence_number_));
     }
+
+    if (op_event.perf_event_counters_) {
+      auto& counters = *op_event.perf_event_counters_;
+      for (size_t i = 0; i < counters.size(); ++i) {
+        addMetadata(
+            performance_events_.get().at(i), std::to_string(counters[i]));
+      }
+    }
   }
 
   void operator()(ExtraFields<EventType::Backend>& backend_event) {
@@ -254,6 +265,7 @@ struct EventFieldsVisitor {
   torch::profiler::impl::kineto::activity_t* kineto_activity_;
   std::reference_wrapper<KinetoEvent> kineto_event_;
   std::reference_wrapper<const post_process_t> post_process_;
+  std::reference_wrapper<const std::vector<std::string>> performance_events_;
   std::vector<PythonMetadata> py_metadata_;
 };
 
@@ -263,6 +275,96 @@ static inline uint64_t getForwardThreadKey(uint64_t tid, uint64_t seqNr) {
   return (((tid) << 48) | ((seqNr) & (((uint64_t)1 << 48) - 1)));
 }
 
+#ifdef USE_KINETO
+// Note [Launch tail latency]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Tail latency regressions are often launch-bound rather than compute-bound:
+// the GPU sits idle while the CPU struggles to feed it. Telling the two apart
+// requires knowing, for each `cudaLaunchKernel`, how long the kernel waited
+// to start and how many kernels were already outstanding on the target
+// stream. CUPTI already timestamps both the runtime launch and the kernel
+// itself, and Kineto owns the CUPTI subscriber, so rather than installing a
+// second set of callbacks we recover these signals from the activity trace
+// after the fact:
+//
+//   launch stall = kernel start - launch call return
+//   queue depth  = kernels on the same stream that were launched earlier but
+//                  had not yet finished when this launch returned
+//
+// A launch that lands on an empty stream (depth == 0) should start almost
+// immediately; any stall there is launch overhead and the op is
+// launch-bound. A launch that queues behind earlier kernels (depth > 0) is
+// compute-bound and its stall is expected. Per-op aggregates are attached to
+// the CPU-side `KinetoEvent`s via the external correlation that links each
+// runtime launch back to the op that issued it.
+struct RuntimeLaunch {
+  int64_t end_us_; // time the launch call returned
+  uint64_t op_correlation_; // CPU op that issued the launch
+};
+
+struct KernelActivity {
+  int64_t correlation_; // shared with the runtime launch
+  int64_t device_;
+  int64_t resource_; // stream id
+  int64_t start_us_;
+  int64_t end_us_;
+};
+
+struct LaunchStats {
+  int64_t launches_ = 0;
+  int64_t stall_us_ = 0;
+  int64_t max_queue_depth_ = 0;
+};
+
+ska::flat_hash_map<uint64_t, LaunchStats> computeLaunchStats(
+    const ska::flat_hash_map<int64_t, RuntimeLaunch>& launches,
+    std::vector<KernelActivity>& kernels) {
+  ska::flat_hash_map<uint64_t, LaunchStats> out;
+  if (launches.empty() || kernels.empty()) {
+    return out;
+  }
+
+  // Group kernels by stream. Kernels on a stream execute in launch order, so
+  // within a group sorting by start time also recovers the launch order.
+  std::sort(
+      kernels.begin(), kernels.end(), [](const auto& a, const auto& b) {
+        return std::tie(a.device_, a.resource_, a.start_us_) <
+            std::tie(b.device_, b.resource_, b.start_us_);
+      });
+
+  for (size_t begin = 0; begin < kernels.size();) {
+    size_t end = begin;
+    while (end < kernels.size() &&
+           kernels[end].device_ == kernels[begin].device_ &&
+           kernels[end].resource_ == kernels[begin].resource_) {
+      ++end;
+    }
+
+    // `head` tracks the oldest kernel on this stream that had not finished
+    // when launch `i` returned; FIFO execution keeps it monotonic.
+    size_t head = begin;
+    for (size_t i = begin; i < end; ++i) {
+      auto it = launches.find(kernels[i].correlation_);
+      if (it == launches.end()) {
+        continue;
+      }
+      const auto& launch = it->second;
+      while (head < i && kernels[head].end_us_ <= launch.end_us_) {
+        ++head;
+      }
+      auto& stats = out[launch.op_correlation_];
+      stats.launches_++;
+      stats.stall_us_ +=
+          std::max<int64_t>(0, kernels[i].start_us_ - launch.end_us_);
+      stats.max_queue_depth_ =
+          std::max<int64_t>(stats.max_queue_depth_, i - head);
+    }
+    begin = end;
+  }
+  return out;
+}
+#endif // USE_KINETO
+
 struct KinetoThreadLocalState : public ProfilerThreadLocalStateBase {
   explicit KinetoThreadLocalState(
       const ProfilerConfig& config,
@@ -375,7 +477,10 @@ struct KinetoThreadLocalState : public ProfilerThreadLocalStateBase {
             .startThreadId(e->start_tid_);
 
         EventFieldsVisitor set_fields_and_metadata(
-            e, kineto_events_.back(), getEventPostProcessingCallback());
+            e,
+            kineto_events_.back(),
+            getEventPostProcessingCallback(),
+            config().experimental_config.performance_events);
 
         // It is not safe to use the activity after post processing.
         e->kineto_activity_ = nullptr;
@@ -462,12 +567,31 @@ struct KinetoThreadLocalState : public ProfilerThreadLocalStateBase {
   void addTraceEvents(
       torch::profiler::impl::kineto::ActivityTraceWrapper& trace) {
 #ifdef USE_KINETO
+    // See Note [Launch tail latency].
+    ska::flat_hash_map<int64_t, RuntimeLaunch> runtime_launches;
+    std::vector<KernelActivity> kernel_activities;
+
     const auto& events = *(trace.get()->activities());
     for (const auto& ev_ptr : events) {
       if (ev_ptr == nullptr) {
         continue;
       }
       const auto& activity = *ev_ptr;
+      if (activity.type() == libkineto::ActivityType::CUDA_RUNTIME &&
+          activity.linkedActivity() &&
+          activity.name().rfind("cudaLaunchKernel", 0) == 0) {
+        runtime_launches[activity.correlationId()] = RuntimeLaunch{
+            activity.timestamp() + activity.duration(),
+            static_cast<uint64_t>(activity.linkedActivity()->correlationId())};
+      } else if (
+          activity.type() == libkineto::ActivityType::CONCURRENT_KERNEL) {
+        kernel_activities.push_back(KernelActivity{
+            activity.correlationId(),
+            activity.deviceId(),
+            activity.resourceId(),
+            activity.timestamp(),
+            activity.timestamp() + activity.duration()});
+      }
       // These events are already processed
       if (activity.type() != libkineto::ActivityType::CPU_OP &&
           activity.type() != libkineto::ActivityType::CPU_INSTANT_EVENT &&
@@ -488,6 +612,19 @@ struct KinetoThreadLocalState : public ProfilerThreadLocalStateBase {
         kineto_event.deviceType(deviceTypeFromActivity(activity.type()));
       }
     }
+
+    auto launch_stats = computeLaunchStats(runtime_launches, kernel_activities);
+    if (!launch_stats.empty()) {
+      for (auto& kineto_event : kineto_events_) {
+        auto it = launch_stats.find(kineto_event.correlationId());
+        if (it != launch_stats.end() &&
+            kineto_event.deviceType() == c10::DeviceType::CPU) {
+          kineto_event.cudaLaunchCount(it->second.launches_)
+              .cudaLaunchStallUs(it->second.stall_us_)
+              .cudaLaunchQueueDepth(it->second.max_queue_depth_);
+        }
+      }
+    }
 #endif // USE_KINETO
   }
 
@@ -568,6 +705,10 @@ void onFunctionExit(
   TORCH_INTERNAL_ASSERT(kineto_ctx_ptr != nullptr);
   kineto_ctx_ptr->event_->end_time_ =
       torch::profiler::impl::getApproximateTime();
+  if (!config.experimental_config.performance_events.empty()) {
+    state_ptr->record_queue_.getSubqueue()->disable_perf_profiler(
+        *kineto_ctx_ptr->event_->counters_);
+  }
   kineto_ctx_ptr->event_->basic_fields_.end_tid_ =
       at::RecordFunction::currentThreadId();
   if (config.state == ProfilerState::KINETO_GPU_FALLBACK) {
@@ -253,6 +253,44 @@ struct TORCH_API KinetoEvent {
 
   int64_t cudaElapsedUs() const;
 
+  // Number of CUDA kernels launched while this op was on the stack.
+  int64_t cudaLaunchCount() const {
+    return cuda_launch_count_;
+  }
+
+  KinetoEvent& cudaLaunchCount(int64_t cuda_launch_count) {
+    cuda_launch_count_ = cuda_launch_count;
+    return *this;
+  }
+
+  // Total time from `cudaLaunchKernel` returning to the kernel actually
+  // starting, summed over this op's launches. See Note [Launch tail latency].
+  int64_t cudaLaunchStallUs() const {
+    return cuda_launch_stall_us_;
+  }
+
+  KinetoEvent& cudaLaunchStallUs(int64_t cuda_launch_stall_us) {
+    cuda_launch_stall_us_ = cuda_launch_stall_us;
+    return *this;
+  }
+
+  // Largest number of kernels already outstanding on the target stream at
+  // the moment one of this op's launches returned.
+  int64_t cudaLaunchQueueDepth() const {
+    return cuda_launch_queue_depth_;
+  }
+
+  KinetoEvent& cudaLaunchQueueDepth(int64_t cuda_launch_queue_depth) {
+    cuda_launch_queue_depth_ = cuda_launch_queue_depth;
+    return *this;
+  }
+
+  // Launch-bound ops hand kernels to an idle stream, so any launch stall is
+  // pure launch overhead. Compute-bound ops queue behind earlier kernels.
+  bool isLaunchBound() const {
+    return cuda_launch_count_ > 0 && cuda_launch_queue_depth_ == 0;
+  }
+
   uint64_t start_thread_id_ = 0;
   uint64_t end_thread_id_ = 0;
   uint64_t fwd_thread_id_ = 0;
@@ -275,6 +313,9 @@ struct TORCH_API KinetoEvent {
   uint64_t linked_correlation_id_ = 0;
   int64_t device_resource_id_ = 0;
   int64_t nbytes_ = 0;
+  int64_t cuda_launch_count_ = 0;
+  int64_t cuda_launch_stall_us_ = 0;
+  int64_t cuda_launch_queue_depth_ = -1;
   bool is_async_{false};
   int64_t debug_handle_{-1};
   std::string backend_;
@@ -42,7 +42,9 @@
 
 #include <c10/core/SymIntArrayRef.h>
 #include <structmember.h>
+#include <array>
 #include <cstdint>
+#include <cstring>
 #include <iostream>
 #include <memory>
 #include <utility>
@@ -1706,6 +1708,50 @@ static void clear_slots(PyTypeObject* type, PyObject* self) {
   }
 }
 
+// Note [THPVariable wrapper freelist]
+// Every op that returns a fresh Tensor allocates a torch.Tensor PyObject
+// through type->tp_alloc and releases it again in
+// THPVariable_subclass_dealloc; for sub-100us kernels that allocator
+// round trip is a measurable slice of the per-op Python binding
+// overhead. Instead of returning deallocated instances of the default
+// tensor class (THPVariableClass, i.e. torch.Tensor) to the allocator,
+// we park them on a small freelist and have THPVariable_NewWithVar
+// revive them in the same state tp_alloc would produce: zeroed body,
+// refcount one, tracked by the GC. Parked objects keep their reference
+// on the type, which the revive path correspondingly does not re-take.
+//
+// Only exact instances of the default class participate. Subclasses can
+// carry __slots__, finalizers, and differing basicsize, which would
+// defeat fixed-size recycling. All accesses happen under the GIL.
+static constexpr size_t kWrapperFreelistMaxSize = 256;
+static std::array<PyObject*, kWrapperFreelistMaxSize> wrapper_freelist;
+static size_t wrapper_freelist_size = 0;
+
+static bool THPVariable_usesWrapperFreelist(PyTypeObject* type) {
+  // A type-level finalizer (e.g. a __del__ patched onto torch.Tensor)
+  // marks the GC header "finalized" on the first dealloc; recycled
+  // wrappers would inherit the mark and skip the finalizer, so opt out.
+  return reinterpret_cast<PyObject*>(type) == THPVariableClass &&
+      type->tp_finalize == nullptr && type->tp_del == nullptr;
+}
+
+static PyObject* THPVariable_reviveFromWrapperFreelist(PyTypeObject* type) {
+  PyObject* obj = wrapper_freelist[--wrapper_freelist_size];
+  TORCH_INTERNAL_ASSERT_DEBUG_ONLY(Py_TYPE(obj) == type);
+  memset(
+      reinterpret_cast<char*>(obj) + sizeof(PyObject),
+      0,
+      type->tp_basicsize - sizeof(PyObject));
+// Same bookkeeping as THPVariable_tryResurrect: the parked object's
+// refcount is zero, so bump it back to one.
+#ifdef Py_TRACE_REFS
+  _Py_AddToAllObjects(obj, 1);
+#endif
+  Py_INCREF(obj);
+  PyObject_GC_Track(obj);
+  return obj;
+}
+
 // NB: this is not the tp_dealloc on THPVariable; instead, its the dealloc
 // on subclasses.  It's never valid to construct a THPVariable so it's not
 // necessary to implement the dealloc for that case
@@ -1798,6 +1844,15 @@ void THPVariable_subclass_dealloc(PyObject* self) {
   // Finally clear out the base THPVariable
   THPVariable_clear((THPVariable*)self);
   ((THPVariable*)self)->cdata.~MaybeOwned<Variable>();
+
+  if (THPVariable_usesWrapperFreelist(type) &&
+      wrapper_freelist_size < kWrapperFreelistMaxSize) {
+    // Park the wrapper (and its reference on the type) for reuse instead
+    // of freeing it, see Note [THPVariable wrapper freelist].
+    wrapper_freelist[wrapper_freelist_size++] = self;
+    return;
+  }
+
   Py_TYPE(self)->tp_free(self);
 
   // Python defined subclasses should always be on the heap
@@ -1833,7 +1888,13 @@ static PyObject* THPVariable_NewWithVar(
       "Creating a Tensor subclass from a class ",
       "that does not inherit from Tensor is not possible. Make sure your class inherits from Tensor.");
 
-  PyObject* obj = type->tp_alloc(type, 0);
+  PyObject* obj = nullptr;
+  if (THPVariable_usesWrapperFreelist(type) && wrapper_freelist_size > 0) {
+    // See Note [THPVariable wrapper freelist]
+    obj = THPVariable_reviveFromWrapperFreelist(type);
+  } else {
+    obj = type->tp_alloc(type, 0);
+  }
   if (obj) {
     auto v = (THPVariable*)obj;
     // TODO: named constructor to avoid default initialization
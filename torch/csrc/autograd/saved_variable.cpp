@@ -1,5 +1,6 @@
 #include <torch/csrc/autograd/saved_variable.h>
 
+#include <torch/csrc/autograd/activation_offload.h>
 #include <torch/csrc/autograd/anomaly_mode.h>
 #include <torch/csrc/autograd/edge.h>
 #include <torch/csrc/autograd/engine.h>
@@ -108,7 +109,13 @@ void SavedVariable::save_metadata(const Variable& data) {
 }
 
 std::unique_ptr<SavedVariableHooks> SavedVariable::get_default_hooks() {
-  return Engine::get_default_engine().get_default_saved_variable_hooks();
+  auto hooks = Engine::get_default_engine().get_default_saved_variable_hooks();
+  if (hooks) {
+    return hooks;
+  }
+  // Explicitly registered (Python) default hooks take precedence over the
+  // native activation offload engine.
+  return ActivationOffloadEngine::get_default_hooks();
 }
 
 void SavedVariable::reset_data() {
@@ -438,6 +438,9 @@ PyObject* THCPModule_setMemoryFraction(PyObject* _unused, PyObject* args) {
 
 PyObject* THCPModule_emptyCache(PyObject* _unused, PyObject* noargs) {
   HANDLE_TH_ERRORS
+  // Release the cached cuBLAS workspaces first so their blocks are
+  // returned to the allocator and freed by emptyCache below.
+  at::cuda::clearCublasWorkspaces();
   c10::cuda::CUDACachingAllocator::emptyCache();
   END_HANDLE_TH_ERRORS
   Py_RETURN_NONE;
@@ -561,6 +564,34 @@ PyObject* THCPModule_memorySnapshot(PyObject* _unused, PyObject* noargs) {
   END_HANDLE_TH_ERRORS
 }
 
+PyObject* THCPModule_setAllocTraceEnabled(PyObject* _unused, PyObject* arg) {
+  HANDLE_TH_ERRORS
+  THPUtils_assert(
+      PyBool_Check(arg), "invalid argument to _cuda_setAllocTraceEnabled");
+  c10::cuda::CUDACachingAllocator::setAllocTraceEnabled(arg == Py_True);
+  END_HANDLE_TH_ERRORS
+  Py_RETURN_NONE;
+}
+
+PyObject* THCPModule_setAllocTraceMaxEntries(PyObject* _unused, PyObject* arg) {
+  HANDLE_TH_ERRORS
+  THPUtils_assert(
+      THPUtils_checkLong(arg),
+      "invalid argument to _cuda_setAllocTraceMaxEntries");
+  const int64_t max_entries = THPUtils_unpackLong(arg);
+  TORCH_CHECK(max_entries > 0, "max_entries must be positive");
+  c10::cuda::CUDACachingAllocator::setAllocTraceMaxEntries(max_entries);
+  END_HANDLE_TH_ERRORS
+  Py_RETURN_NONE;
+}
+
+PyObject* THCPModule_exportAllocTrace(PyObject* _unused, PyObject* noargs) {
+  HANDLE_TH_ERRORS
+  return THPUtils_packString(
+      c10::cuda::CUDACachingAllocator::exportAllocTraceFolded());
+  END_HANDLE_TH_ERRORS
+}
+
 PyObject* THCPModule_cudaSetSyncDebugMode(PyObject* _unused, PyObject* arg) {
   HANDLE_TH_ERRORS
   TORCH_WARN_ONCE(
@@ -817,6 +848,18 @@ static struct PyMethodDef _THCPModule_methods[] = {
      METH_O,
      nullptr},
     {"_cuda_memorySnapshot", THCPModule_memorySnapshot, METH_NOARGS, nullptr},
+    {"_cuda_setAllocTraceEnabled",
+     THCPModule_setAllocTraceEnabled,
+     METH_O,
+     nullptr},
+    {"_cuda_setAllocTraceMaxEntries",
+     THCPModule_setAllocTraceMaxEntries,
+     METH_O,
+     nullptr},
+    {"_cuda_exportAllocTrace",
+     THCPModule_exportAllocTrace,
+     METH_NOARGS,
+     nullptr},
     {"_cuda_cudaHostAllocator",
      THCPModule_cudaHostAllocator,
      METH_NOARGS,
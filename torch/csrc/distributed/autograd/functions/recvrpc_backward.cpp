@@ -1,6 +1,8 @@
 #include <ATen/core/functional.h>
 #include <c10/util/irange.h>
+#include <torch/csrc/distributed/autograd/engine/dist_engine.h>
 #include <torch/csrc/distributed/autograd/functions/recvrpc_backward.h>
+#include <torch/csrc/distributed/autograd/functions/sendrpc_backward.h>
 #include <torch/csrc/distributed/autograd/rpc_messages/propagate_gradients_req.h>
 #include <torch/csrc/distributed/rpc/rpc_agent.h>
 
@@ -42,6 +44,27 @@ variable_list RecvRpcBackward::apply(variable_list&& grads) {
           "means the autograd context was cleaned up by a different thread due ",
           "to an error before RecvRcpBackward had a chance to run"));
 
+  auto rpcAgent = rpc::RpcAgent::getCurrentRpcAgent();
+  if (fromWorkerId_ == rpcAgent->getWorkerInfo().id_) {
+    // The matching send function lives in this very process (an RPC issued
+    // to ourselves), so there is nothing to serialize: attach the gradients
+    // to the local send function and resume the backward pass on the
+    // distributed engine directly, exactly as the BACKWARD_AUTOGRAD_REQ
+    // handler would after deserializing them. This keeps the full message
+    // round-trip off the backward critical path. For distinct processes the
+    // transport already picks shared-memory channels on the same host; only
+    // the same-process case can skip (de)serialization entirely.
+    std::shared_ptr<SendRpcBackward> sendFunction =
+        sharedContext->retrieveSendFunction(autogradMetadata_.autogradMessageId);
+    sendFunction->setGrads(outputGrads);
+    auto execFuture = DistEngine::getInstance().executeSendFunctionAsync(
+        sharedContext,
+        sendFunction,
+        sharedContext->retrieveGraphTask()->keep_graph_);
+    sharedContext->addOutstandingRpc(execFuture);
+    return variable_list();
+  }
+
   // Send the gradients over the wire and record the future in the autograd
   // context.
   PropagateGradientsReq gradCall(
@@ -50,7 +73,6 @@ variable_list RecvRpcBackward::apply(variable_list&& grads) {
       sharedContext->retrieveGraphTask()->keep_graph_);
 
   // Send the gradients over to the appropriate node.
-  auto rpcAgent = rpc::RpcAgent::getCurrentRpcAgent();
   auto jitFuture = rpcAgent->send(
       rpcAgent->getWorkerInfo(fromWorkerId_),
       std::move(gradCall).toMessage(),
@@ -2,6 +2,7 @@
 #include <c10d/ProcessGroup.hpp>
 
 #include <c10/util/Logging.h>
+#include <c10/util/SpinWait.h>
 #include <fmt/format.h>
 
 namespace c10d {
@@ -125,6 +126,10 @@ std::vector<at::Tensor> ProcessGroup::Work::result() {
 void ProcessGroup::Work::synchronize() {}
 
 bool ProcessGroup::Work::wait(std::chrono::milliseconds timeout) {
+  // Spin briefly before parking: intra-host collectives often complete in
+  // microseconds, faster than the futex round trip of a blocking wait, and
+  // the lock below is then uncontended.
+  c10::spin_wait([this] { return completed_.load(); });
   std::unique_lock<std::mutex> lock(mutex_);
   if (timeout == kNoTimeout) {
     // This waits without a timeout.
@@ -150,8 +155,51 @@ void ProcessGroup::Work::abort() {
   TORCH_CHECK(false, "ProcessGroup::Work::abort not implemented.");
 }
 
+namespace {
+
+// Work subclasses that predate futures do not all implement result();
+// the default future then just signals completion with an empty list.
+std::vector<at::Tensor> resultOrEmpty(ProcessGroup::Work& work) {
+  try {
+    return work.result();
+  } catch (const std::exception&) {
+    return {};
+  }
+}
+
+} // namespace
+
+void ProcessGroup::Work::completeFuture(
+    const c10::intrusive_ptr<c10::ivalue::Future>& future,
+    std::exception_ptr exception) {
+  // Callbacks chained on the future run inline here, so this must be
+  // called without mutex_ held.
+  if (!future || future->completed()) {
+    return;
+  }
+  if (exception) {
+    future->setError(exception);
+  } else {
+    future->markCompleted(at::IValue(resultOrEmpty(*this)));
+  }
+}
+
 c10::intrusive_ptr<c10::ivalue::Future> ProcessGroup::Work::getFuture() {
-  TORCH_CHECK(false, "ProcessGroup::Work::getFuture not implemented.")
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (!defaultFuture_) {
+    defaultFuture_ = c10::make_intrusive<c10::ivalue::Future>(
+        c10::ListType::create(c10::TensorType::get()));
+    if (completed_) {
+      // The work finished before anyone asked for a future; complete it
+      // on the spot.
+      auto future = defaultFuture_;
+      auto exception = exception_;
+      lock.unlock();
+      completeFuture(future, exception);
+      return future;
+    }
+  }
+  return defaultFuture_;
 }
 
 void ProcessGroup::Work::finish(std::exception_ptr exception) {
@@ -162,8 +210,10 @@ void ProcessGroup::Work::finish(std::exception_ptr exception) {
     recordFunctionEndCallback_();
     recordFunctionEndCallback_ = nullptr;
   }
+  auto future = defaultFuture_;
   lock.unlock();
   cv_.notify_all();
+  completeFuture(future, exception);
 }
 
 void ProcessGroup::Work::finishAndThrow(std::exception_ptr exception) {
@@ -174,8 +224,11 @@ void ProcessGroup::Work::finishAndThrow(std::exception_ptr exception) {
     recordFunctionEndCallback_();
     recordFunctionEndCallback_ = nullptr;
   }
-  if (exception_) {
-    std::rethrow_exception(exception_);
+  auto future = defaultFuture_;
+  lock.unlock();
+  completeFuture(future, exception);
+  if (exception) {
+    std::rethrow_exception(exception);
   }
 }
 
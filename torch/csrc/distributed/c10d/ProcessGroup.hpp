@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
 #include <memory>
 #include <mutex>
@@ -10,6 +11,7 @@
 #include <ATen/ATen.h>
 #include <c10/macros/Macros.h>
 
+#include <c10d/Store.hpp>
 #include <c10d/Types.hpp>
 #include <c10d/Utils.hpp>
 #include <c10d/debug.h>
@@ -144,9 +146,28 @@ class TORCH_API ProcessGroup : public torch::CustomClassHolder {
     virtual void abort();
 
     // Returns a Future object that will be associated with the completion of
-    // work. Only NCCL backend is currently supported.
+    // work. The default implementation returns a future that is completed
+    // from finish()/finishAndThrow() with the work's result() (or an empty
+    // tensor list if the work has none); backends with their own completion
+    // mechanism (NCCL device events, the MPI helper thread, the Gloo
+    // collective threads) override it.
     virtual c10::intrusive_ptr<c10::ivalue::Future> getFuture();
 
+    // Registers a continuation that runs once the work completes and
+    // returns a future for the callback's result (of type `type`). The
+    // callback receives the completed future; it must not block. For
+    // CUDA-aware backends the continuation is sequenced after the
+    // collective via device events, so compute/comm overlap composes
+    // without watcher threads:
+    //
+    //   work->then(
+    //       [](c10::ivalue::Future& fut) { /* consume fut.value() */ ... },
+    //       type);
+    template <typename T>
+    c10::intrusive_ptr<c10::ivalue::Future> then(T callback, c10::TypePtr type) {
+      return getFuture()->then(std::move(callback), std::move(type));
+    }
+
     OpType retrieveOpType();
 
     static c10::intrusive_ptr<Work> create_from_future(c10::intrusive_ptr<c10::ivalue::Future>);
@@ -160,11 +181,25 @@ class TORCH_API ProcessGroup : public torch::CustomClassHolder {
     // provided by the user.
     void finishAndThrow(std::exception_ptr exception);
 
+    // Completes `future` with this work's result (or `exception`), if it
+    // exists and has not been completed yet. Must be called without
+    // mutex_ held since chained callbacks run inline.
+    void completeFuture(
+        const c10::intrusive_ptr<c10::ivalue::Future>& future,
+        std::exception_ptr exception);
+
     mutable std::mutex mutex_;
     std::condition_variable cv_;
-    bool completed_ = false;
+    // Atomic so that wait() can poll it from its pre-park spin loop without
+    // taking mutex_; all writes still happen under mutex_.
+    std::atomic<bool> completed_{false};
     std::exception_ptr exception_;
 
+    // Future returned by the default getFuture() implementation, created
+    // lazily and completed by finish()/finishAndThrow(). Subclasses that
+    // override getFuture() manage their own future instead.
+    c10::intrusive_ptr<c10::ivalue::Future> defaultFuture_;
+
     // Current rank of the node.
     const int rank_;
 
@@ -209,6 +244,15 @@ class TORCH_API ProcessGroup : public torch::CustomClassHolder {
     TORCH_INTERNAL_ASSERT(false, "getBackendName is not implemented.");
   };
 
+  // Returns the store this process group was bootstrapped with, if the
+  // backend keeps one around, and nullptr otherwise. Used as an
+  // out-of-band rendezvous channel, e.g. by broadcast_coalesced to set up
+  // the same-host shared-memory fast path (see Note [Shared-memory
+  // broadcast] in comm.cpp).
+  virtual c10::intrusive_ptr<Store> getStore() const {
+    return c10::intrusive_ptr<Store>();
+  }
+
   // Consider using ops in Ops.hpp instead of the below, which route things
   // to the dispatcher.
   // TODO: Find a way to force the above rule programmatically.
@@ -433,6 +477,13 @@ class TORCH_API ProcessGroup : public torch::CustomClassHolder {
             "ProcessGroup ", getBackendName(), "does not support barrier"));
   }
 
+  // Issues any collectives the backend has queued for coalescing but not yet
+  // submitted. Returns the Work tracking the flushed batch, or nullptr if
+  // nothing was pending. Backends that do not coalesce treat this as a no-op.
+  virtual c10::intrusive_ptr<ProcessGroup::Work> flush() {
+    return nullptr;
+  }
+
  protected:
   // Implementations of this interface need to call this to setup
   // appropriate logging etc.
@@ -3,6 +3,7 @@
 #ifdef USE_C10D_GLOO
 
 #include <c10d/GlooDeviceFactory.hpp>
+#include <algorithm>
 #include <chrono>
 #include <exception>
 #include <ratio>
@@ -538,6 +539,10 @@ ProcessGroupGloo::SendWork::SendWork(
       tensor_(tensor),
       buffer_(std::move(buffer)) {}
 
+std::vector<at::Tensor> ProcessGroupGloo::SendWork::result() {
+  return {tensor_};
+}
+
 bool ProcessGroupGloo::SendWork::wait(std::chrono::milliseconds timeout) {
   bool sendCompleted = false;
   std::exception_ptr exception{nullptr};
@@ -578,6 +583,10 @@ int ProcessGroupGloo::RecvWork::sourceRank() const {
   return srcRank_;
 }
 
+std::vector<at::Tensor> ProcessGroupGloo::RecvWork::result() {
+  return {tensor_};
+}
+
 bool ProcessGroupGloo::RecvWork::wait(std::chrono::milliseconds timeout) {
   bool recvCompleted = false;
   std::exception_ptr exception{nullptr};
@@ -601,7 +610,9 @@ void ProcessGroupGloo::RecvWork::abort() {
 }
 
 ProcessGroupGloo::Options::Options(std::chrono::milliseconds timeout)
-    : ProcessGroup::Options(GLOO_BACKEND_NAME, timeout), threads(2) {}
+    : ProcessGroup::Options(GLOO_BACKEND_NAME, timeout),
+      threads(2),
+      hierarchical_allreduce(false) {}
 
 namespace {
 
@@ -648,6 +659,18 @@ bool doesHostnameResolveToUsableAddress(const std::string& hostname) {
   return rp != nullptr;
 }
 
+// Returns this machine's hostname, used to group ranks by host when
+// setting up the hierarchical allreduce contexts.
+std::string currentHostname() {
+  socketInitialize();
+  std::array<char, 256> hostname{};
+  auto rv = gethostname(hostname.data(), hostname.size() - 1);
+  if (rv != 0) {
+    throw std::system_error(errno, std::system_category());
+  }
+  return hostname.data();
+}
+
 } // namespace
 
 std::shared_ptr<::gloo::transport::Device> ProcessGroupGloo::
@@ -755,6 +778,10 @@ ProcessGroupGloo::ProcessGroupGloo(
     contexts_.push_back(std::move(context));
   }
 
+  if (options->hierarchical_allreduce && size_ > 1) {
+    initHierarchy();
+  }
+
   // Every worker thread stores the AsyncWork object it's currently
   // working on in the workInProgress_ vector. It must have size equal
   // to the number of workers such that they can simply index into it
@@ -795,6 +822,99 @@ std::shared_ptr<::gloo::Context> ProcessGroupGloo::getContext(uint32_t tag) {
   return contexts_[tag % contexts_.size()];
 }
 
+std::shared_ptr<::gloo::Context> ProcessGroupGloo::getIntraHostContext(
+    uint32_t tag) {
+  if (intraHostContexts_.empty()) {
+    return nullptr;
+  }
+  return intraHostContexts_[tag % intraHostContexts_.size()];
+}
+
+std::shared_ptr<::gloo::Context> ProcessGroupGloo::getCrossHostContext(
+    uint32_t tag) {
+  if (crossHostContexts_.empty()) {
+    return nullptr;
+  }
+  return crossHostContexts_[tag % crossHostContexts_.size()];
+}
+
+// See Note [Hierarchical allreduce].
+void ProcessGroupGloo::initHierarchy() {
+  // Group ranks by host by exchanging hostnames through the store. Every
+  // rank performs the same scan over the same keys, so all ranks agree on
+  // the set of hosts, their order, and each host's leader.
+  const std::string hostname = currentHostname();
+  store_->set(
+      "hierarchy/" + std::to_string(rank_),
+      std::vector<char>(hostname.begin(), hostname.end()));
+  std::vector<std::string> hosts;
+  std::vector<int> localRanks;
+  for (const auto i : c10::irange(size_)) {
+    const auto key = "hierarchy/" + std::to_string(i);
+    store_->wait({key});
+    const auto value = store_->get(key);
+    const std::string host(value.begin(), value.end());
+    if (std::find(hosts.begin(), hosts.end(), host) == hosts.end()) {
+      hosts.push_back(host);
+    }
+    if (host == hostname) {
+      localRanks.push_back(i);
+    }
+  }
+
+  // The hierarchy only pays off when there are multiple hosts and at least
+  // one of them runs more than one rank; otherwise it degenerates to the
+  // flat algorithm and we keep using that.
+  const auto numHosts = static_cast<int>(hosts.size());
+  if (numHosts <= 1 || numHosts == size_) {
+    return;
+  }
+
+  const auto hostIdx = static_cast<int>(std::distance(
+      hosts.begin(), std::find(hosts.begin(), hosts.end(), hostname)));
+  const auto localSize = static_cast<int>(localRanks.size());
+  const auto localRank = static_cast<int>(std::distance(
+      localRanks.begin(),
+      std::find(localRanks.begin(), localRanks.end(), rank_)));
+
+  // Connect a context covering only this host's ranks, over the loopback
+  // device. Ranks that are alone on their host skip the intra-host phases
+  // entirely and don't need one.
+  if (localSize > 1) {
+    auto localDevice = createDeviceForHostname(kLoopbackAddress);
+    intraHostContexts_.reserve(options_->devices.size());
+    for (const auto i : c10::irange(options_->devices.size())) {
+      auto context =
+          std::make_shared<::gloo::rendezvous::Context>(localRank, localSize);
+      auto store = ::gloo::rendezvous::PrefixStore(
+          "hierarchy/local/" + std::to_string(hostIdx) + "/" +
+              std::to_string(i),
+          *store_);
+      context->setTimeout(options_->timeout);
+      context->connectFullMesh(store, localDevice);
+      intraHostContexts_.push_back(std::move(context));
+    }
+  }
+
+  // Connect a context covering one leader (the lowest global rank) per
+  // host, over the configured devices. Like the flat contexts above, one
+  // context per device lets concurrent collectives spread across NICs.
+  if (localRank == 0) {
+    crossHostContexts_.reserve(options_->devices.size());
+    for (const auto i : c10::irange(options_->devices.size())) {
+      auto context =
+          std::make_shared<::gloo::rendezvous::Context>(hostIdx, numHosts);
+      auto store = ::gloo::rendezvous::PrefixStore(
+          "hierarchy/leaders/" + std::to_string(i), *store_);
+      context->setTimeout(options_->timeout);
+      context->connectFullMesh(store, options_->devices[i]);
+      crossHostContexts_.push_back(std::move(context));
+    }
+  }
+
+  hierarchyEnabled_ = true;
+}
+
 void ProcessGroupGloo::runLoop(int workerIndex) {
   std::unique_lock<std::mutex> lock(workMutex_);
 
@@ -1052,6 +1172,92 @@ class AsyncAllreduceCoalescedWork : public AsyncAllreduceWork {
   }
 };
 
+// Note [Hierarchical allreduce]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// On hosts that run multiple ranks, a flat allreduce sends every rank's
+// contribution across the NIC even though most of its peers sit on the
+// same machine. The hierarchical variant instead (1) reduces within each
+// host to a local leader (the lowest global rank on the host) over the
+// loopback device, (2) runs the allreduce only among the per-host leaders
+// over the configured devices, and (3) broadcasts the result back within
+// each host. With P ranks per host this cuts cross-host bytes by a factor
+// of P while the intra-host phases never leave the machine. Host
+// membership is negotiated through the store at construction time (see
+// initHierarchy()): ranks that are alone on their host have no intra-host
+// context and skip phases (1) and (3); ranks that are not their host's
+// leader have no cross-host context and skip phase (2). The three phases
+// share the collective's tag; they run back to back on their respective
+// contexts so there is no matching ambiguity.
+class AsyncHierarchicalAllreduceWork : public ProcessGroupGloo::AsyncWork {
+ public:
+  AsyncHierarchicalAllreduceWork(
+      std::shared_ptr<gloo::Context> intraHostContext,
+      std::shared_ptr<gloo::Context> crossHostContext,
+      std::vector<at::Tensor>& inputs,
+      ReduceOp reduceOp,
+      uint32_t tag)
+      : ProcessGroupGloo::AsyncWork({inputs}, "gloo:all_reduce", inputs),
+        intraHostContext(std::move(intraHostContext)),
+        crossHostContext(std::move(crossHostContext)),
+        inputs(inputs),
+        reduceOp(reduceOp),
+        tag(tag) {}
+
+  std::shared_ptr<gloo::Context> intraHostContext;
+  std::shared_ptr<gloo::Context> crossHostContext;
+  std::vector<at::Tensor> inputs;
+  const ReduceOp reduceOp;
+  const uint32_t tag;
+
+  void run() override {
+    const auto& scalarType = inputs[0].scalar_type();
+
+    // Phase 1: reduce to this host's leader (local rank 0).
+    if (intraHostContext) {
+      for (at::Tensor& tensor : inputs) {
+        gloo::ReduceOptions opts(intraHostContext);
+        opts.setRoot(0);
+        opts.setTag(tag);
+        opts.setReduceFunction(getFunction(scalarType, reduceOp));
+        GENERATE_ALL_TYPES(scalarType, setOutput, opts, tensor);
+        gloo::reduce(opts);
+      }
+    }
+
+    // Phase 2: allreduce among the per-host leaders.
+    if (crossHostContext) {
+      gloo::AllreduceOptions opts(crossHostContext);
+      opts.setReduceFunction(getFunction(scalarType, reduceOp));
+      opts.setTag(tag);
+      GENERATE_ALL_TYPES(scalarType, setOutputs, opts, inputs);
+      gloo::allreduce(opts);
+    }
+
+    // Phase 3: broadcast the result from the leader within the host.
+    if (intraHostContext) {
+      for (at::Tensor& tensor : inputs) {
+        gloo::BroadcastOptions opts(intraHostContext);
+        opts.setRoot(0);
+        opts.setTag(tag);
+        GENERATE_ALL_TYPES(scalarType, setOutput, opts, tensor);
+        gloo::broadcast(opts);
+      }
+    }
+  }
+
+ private:
+  template <typename T>
+  void getFunction(ReduceFunc& fn, const ReduceOp op) {
+    fn = toFunction<T>(op);
+  }
+
+  ReduceFunc getFunction(const at::ScalarType& dtype, const ReduceOp op) {
+    ReduceFunc fn = nullptr;
+    GENERATE_ALL_TYPES(dtype, getFunction, fn, op);
+    return fn;
+  }
+};
+
 class AsyncSparseAllreduceWork : public ProcessGroupGloo::AsyncWork {
  public:
   AsyncSparseAllreduceWork(
@@ -1460,8 +1666,17 @@ c10::intrusive_ptr<ProcessGroup::Work> ProcessGroupGloo::allreduce(
   auto context = getContext(tag);
   if (device.type() == at::kCPU) {
     if (layout == c10::kStrided) {
-      work = c10::make_intrusive<AsyncAllreduceWork>(
-          std::move(context), inputs, opts.reduceOp, tag);
+      if (hierarchyEnabled_) {
+        work = c10::make_intrusive<AsyncHierarchicalAllreduceWork>(
+            getIntraHostContext(tag),
+            getCrossHostContext(tag),
+            inputs,
+            opts.reduceOp,
+            tag);
+      } else {
+        work = c10::make_intrusive<AsyncAllreduceWork>(
+            std::move(context), inputs, opts.reduceOp, tag);
+      }
     } else if (layout == c10::kSparse) {
       work = c10::make_intrusive<AsyncSparseAllreduceWork>(
           std::move(context), inputs, tag);
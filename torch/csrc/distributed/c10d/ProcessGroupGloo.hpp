@@ -134,6 +134,10 @@ class TORCH_API ProcessGroupGloo : public ProcessGroup {
       store_->wait(keys, timeout);
     }
 
+    const c10::intrusive_ptr<::c10d::Store>& _getUnderlyingStore() const {
+      return store_;
+    }
+
    protected:
     c10::intrusive_ptr<::c10d::Store> store_;
   };
@@ -150,6 +154,8 @@ class TORCH_API ProcessGroupGloo : public ProcessGroup {
         at::Tensor& tensor,
         std::unique_ptr<::gloo::transport::UnboundBuffer> buffer);
 
+    std::vector<at::Tensor> result() override;
+
     bool wait(std::chrono::milliseconds timeout = kNoTimeout) override;
 
     void abort() override;
@@ -168,6 +174,8 @@ class TORCH_API ProcessGroupGloo : public ProcessGroup {
 
     int sourceRank() const override;
 
+    std::vector<at::Tensor> result() override;
+
     bool wait(std::chrono::milliseconds timeout = kNoTimeout) override;
 
     void abort() override;
@@ -190,12 +198,24 @@ class TORCH_API ProcessGroupGloo : public ProcessGroup {
 
     std::vector<std::shared_ptr<::gloo::transport::Device>> devices;
     int threads;
+
+    // Run allreduce on CPU tensors hierarchically: ranks sharing a host
+    // first reduce to a local leader over the loopback device, the leaders
+    // run an allreduce among themselves over the devices above, and the
+    // result is broadcast back within each host. See
+    // Note [Hierarchical allreduce] in ProcessGroupGloo.cpp.
+    bool hierarchical_allreduce;
   };
 
   const std::string getBackendName() const override {
     return std::string(GLOO_BACKEND_NAME);
   }
 
+  c10::intrusive_ptr<Store> getStore() const override {
+    // store_ is always the GlooStore wrapper created in the constructor.
+    return static_cast<GlooStore*>(store_.get())->_getUnderlyingStore();
+  }
+
   // Helper functions to create a new device object.
   // They are static functions on this class to keep them logically
   // separate from the rest of the code base (e.g. torch/csrc/distributed).
@@ -330,6 +350,17 @@ class TORCH_API ProcessGroupGloo : public ProcessGroup {
   // In order to use more than one device (or allow for parallelism on
   // a single device), you need multiple contexts.
   std::vector<std::shared_ptr<::gloo::Context>> contexts_;
+
+  // Contexts used by the hierarchical allreduce path; both stay empty
+  // unless Options::hierarchical_allreduce is set and the topology has
+  // multiple hosts with at least one of them running more than one rank.
+  // The intra-host contexts connect only the ranks sharing this host
+  // (over the loopback device), the cross-host contexts connect one
+  // leader rank per host. See Note [Hierarchical allreduce].
+  std::vector<std::shared_ptr<::gloo::Context>> intraHostContexts_;
+  std::vector<std::shared_ptr<::gloo::Context>> crossHostContexts_;
+  bool hierarchyEnabled_ = false;
+
   std::vector<std::thread> threads_;
   bool stop_;
 
@@ -347,6 +378,16 @@ class TORCH_API ProcessGroupGloo : public ProcessGroup {
   // to contexts being used in a round-robin fashion.
   std::shared_ptr<::gloo::Context> getContext(uint32_t tag);
 
+  // Same, for the hierarchical allreduce contexts. Either returns nullptr
+  // when the calling rank has no context for that tier (e.g. the rank is
+  // alone on its host, or is not its host's leader).
+  std::shared_ptr<::gloo::Context> getIntraHostContext(uint32_t tag);
+  std::shared_ptr<::gloo::Context> getCrossHostContext(uint32_t tag);
+
+  // Groups ranks by host and connects the hierarchical allreduce contexts.
+  // Called from the constructor when Options::hierarchical_allreduce is set.
+  void initHierarchy();
+
   // Entrypoint for worker threads.
   void runLoop(int workerIndex);
 
@@ -124,7 +124,9 @@ ProcessGroupMPI::AsyncWork::AsyncWork(
     const c10::optional<std::vector<at::Tensor>>& inputTensors)
     : ProcessGroup::Work(-1, OpType::UNKNOWN, profilingTitle, inputTensors),
       outputTensors_(std::move(outputTensors)),
-      request_(request) {
+      request_(request),
+      future_(c10::make_intrusive<at::ivalue::Future>(
+          c10::ListType::create(c10::TensorType::get()))) {
   memset(&status_, 0, sizeof(status_));
 }
 
@@ -154,6 +156,10 @@ bool ProcessGroupMPI::AsyncWork::isCompleted() {
   if (status_.MPI_ERROR != MPI_SUCCESS) {
     populateException();
   }
+  // Future callbacks run inline; release the global MPI lock first so
+  // they can issue MPI calls of their own.
+  globalLock.unlock();
+  completeFuture(exception_);
 
   return true;
 }
@@ -186,6 +192,10 @@ bool ProcessGroupMPI::AsyncWork::wait(std::chrono::milliseconds /* unused */) {
   std::unique_lock<std::mutex> globalLock(pgGlobalMutex_);
   MPI_CHECK(MPI_Wait(&request_, &status_));
   auto ok = (status_.MPI_ERROR == MPI_SUCCESS);
+  if (!ok) {
+    populateException();
+  }
+  globalLock.unlock();
 
   // AsyncWork needs to manually call profiling end callbacks if they are set,
   // since it does not call ProcessGroup::finish().
@@ -194,8 +204,8 @@ bool ProcessGroupMPI::AsyncWork::wait(std::chrono::milliseconds /* unused */) {
     ProcessGroup::Work::recordFunctionEndCallback_ = nullptr;
   }
 
+  completeFuture(exception_);
   if (!ok) {
-    populateException();
     std::rethrow_exception(exception_);
   }
   // Always return true, because abort API is not implemented.
@@ -209,6 +219,23 @@ std::vector<at::Tensor> ProcessGroupMPI::AsyncWork::result() {
   return outputTensors_;
 }
 
+c10::intrusive_ptr<c10::ivalue::Future> ProcessGroupMPI::AsyncWork::getFuture() {
+  return future_;
+}
+
+void ProcessGroupMPI::AsyncWork::completeFuture(std::exception_ptr eptr) {
+  // isCompleted() and wait() may both observe completion; only the
+  // first call completes the future.
+  if (future_->completed()) {
+    return;
+  }
+  if (eptr) {
+    future_->setError(eptr);
+  } else {
+    future_->markCompleted(at::IValue(outputTensors_));
+  }
+}
+
 void ProcessGroupMPI::AsyncWork::populateException() {
   std::array<char, MPI_MAX_ERROR_STRING> buf;
   int len = buf.size();
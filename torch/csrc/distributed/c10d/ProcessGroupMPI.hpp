@@ -132,13 +132,20 @@ class TORCH_API ProcessGroupMPI : public ProcessGroup {
 
     std::vector<at::Tensor> result() override;
 
+    c10::intrusive_ptr<c10::ivalue::Future> getFuture() override;
+
    protected:
     void populateException();
 
    private:
+    // Completes future_ (with the outputs or `eptr`) exactly once; the
+    // completion paths in isCompleted() and wait() both funnel here.
+    void completeFuture(std::exception_ptr eptr = nullptr);
+
     const std::vector<at::Tensor> outputTensors_;
     MPI_Request request_;
     MPI_Status status_;
+    c10::intrusive_ptr<at::ivalue::Future> future_;
   };
 
   // Constructor will spawn up the worker thread loop
@@ -177,6 +177,29 @@ at::Device getDeviceForRank(int rank) {
   return at::Device(at::DeviceType::CUDA, deviceIdx);
 }
 
+// Parses an environment variable holding a positive integer, falling back to
+// the given default when unset.
+size_t parseEnvVarPositiveInt(const char* envVarName, size_t defaultValue) {
+  char* stringValue = std::getenv(envVarName);
+  if (stringValue == nullptr) {
+    return defaultValue;
+  }
+  long long val = -1;
+  try {
+    val = std::stoll(stringValue);
+  } catch (std::exception& e) {
+    val = -1;
+  }
+  TORCH_CHECK(
+      val > 0,
+      "Invalid value for environment variable: ",
+      envVarName,
+      " (expected a positive integer, got `",
+      stringValue,
+      "`)");
+  return static_cast<size_t>(val);
+}
+
 // [Sync Streams] Helper that lets the input ncclStreams to wait for the current
 // stream. NCCL communications run on ncclStreams, but input tensors are
 // allocated on different streams (i.e., current streams). Communications on
@@ -552,6 +575,15 @@ ProcessGroupNCCL::ProcessGroupNCCL(
   blockingWait_ = parseEnvVarFlag(NCCL_BLOCKING_WAIT);
   asyncErrorHandling_ = parseEnvVarFlag(NCCL_ASYNC_ERROR_HANDLING);
   desyncDebug_ = parseEnvVarFlag(NCCL_DESYNC_DEBUG);
+  coalescingEnabled_ = parseEnvVarFlag(NCCL_COALESCE_SMALL_ALLREDUCES);
+  if (coalescingEnabled_) {
+    coalesceMaxTensorBytes_ =
+        parseEnvVarPositiveInt(NCCL_COALESCE_MAX_TENSOR_BYTES, 1024 * 1024);
+    coalesceFlushBytes_ =
+        parseEnvVarPositiveInt(NCCL_COALESCE_FLUSH_BYTES, 16 * 1024 * 1024);
+    coalesceFlushTimeout_ = std::chrono::microseconds(
+        parseEnvVarPositiveInt(NCCL_COALESCE_FLUSH_TIMEOUT_US, 1000));
+  }
 
   if (blockingWait_) {
     if (asyncErrorHandling_ || desyncDebug_) {
@@ -600,6 +632,16 @@ ProcessGroupNCCL::ProcessGroupNCCL(
             << "\nUSE_HIGH_PRIORITY_STREAM: "
             << options_->is_high_priority_stream;
 
+  if (!options_->warmup_device_ids.empty()) {
+    std::vector<std::vector<at::Device>> deviceLists;
+    deviceLists.reserve(options_->warmup_device_ids.size());
+    for (const auto id : options_->warmup_device_ids) {
+      deviceLists.push_back(
+          {at::Device(at::DeviceType::CUDA, static_cast<c10::DeviceIndex>(id))});
+    }
+    warmupComms(deviceLists);
+  }
+
 #ifdef USE_NCCL_WITH_UCC
   static c10::once_flag initialize_ucc_lib_flag;
   c10::call_once(initialize_ucc_lib_flag, [&] {
@@ -700,6 +742,13 @@ ProcessGroupNCCL::~ProcessGroupNCCL() {
     workCleanupThread_.join();
   }
 
+  {
+    // Anything still sitting in the lock-free pending stack was never
+    // spliced in by the background threads; reclaim the nodes here.
+    std::lock_guard<std::mutex> lock(workMetaListMutex_);
+    drainPendingWorks();
+  }
+
   {
     // Abort all NCCL Communicators on Process Group Destruction
     std::lock_guard<std::mutex> lock(mutex_);
@@ -718,6 +767,7 @@ ProcessGroupNCCL::~ProcessGroupNCCL() {
 void ProcessGroupNCCL::abortTimedOutCollectives(
     std::unordered_set<std::string>& abortedCommIds) {
   std::unique_lock<std::mutex> lock(workMetaListMutex_);
+  drainPendingWorks();
   for (auto& work : workMetaList_) {
     work.checkAndSetException();
     // Aborting NCCL Communicators due to errors is already handled above.
@@ -914,10 +964,32 @@ void ProcessGroupNCCL::workCleanupLoop() {
           lock,
           std::chrono::milliseconds(kWorkCleanupThreadSleepMillis),
           [&]() -> bool { return terminateProcessGroup_.load(); });
+      drainPendingWorks();
+
+      // Batched event sweep: end events on a device are recorded on that
+      // device's NCCL stream in issue order, so once one work's event
+      // reports not-ready, cudaEventQuery on later works touching the same
+      // device is wasted driver traffic. Skipping them can only delay a
+      // completion to the next sweep (e.g. for works on a different stream
+      // of the same device), never report one early, and it bounds the
+      // number of queries per sweep by the device count rather than the
+      // collective rate.
+      std::unordered_set<c10::DeviceIndex> stalledDevices;
 
       for (auto it = workMetaList_.begin(); it != workMetaList_.end();
            /* no increment*/) {
         auto& work = *it;
+        bool touchesStalledDevice = false;
+        for (const auto& device : work.devices_) {
+          if (stalledDevices.count(device.index()) != 0) {
+            touchesStalledDevice = true;
+            break;
+          }
+        }
+        if (touchesStalledDevice) {
+          ++it;
+          continue;
+        }
 
         if (desyncDebug_ && !work.exception()) {
           if (!work.startTraceUpdated_ && work.isStarted() &&
@@ -961,6 +1033,9 @@ void ProcessGroupNCCL::workCleanupLoop() {
         } else {
           // Increment the iterator if the current WorkNCCL object is not
           // completed.
+          for (const auto& device : work.devices_) {
+            stalledDevices.insert(device.index());
+          }
           ++it;
         }
       }
@@ -1085,6 +1160,44 @@ void ProcessGroupNCCL::destroyNCCLComms(const std::string& devNCCLCommMapKey) {
   usedDeviceIdxs_.clear();
 }
 
+namespace {
+
+// Note [NCCL communicator pool]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Sub-groups with identical membership each pay full communicator init for
+// the same device list. Groups that opt in via Options::comm_pool_key share
+// entries instead: the first pooled group to need a device list creates the
+// communicators, later groups adopt both the communicators and their NCCL
+// streams. Sharing the streams is what keeps reuse safe -- every pooled
+// group enqueues onto the same streams, so work on a shared communicator
+// stays serialized in issue order. The key is caller-provided because a
+// process group cannot see the global ranks behind its membership; callers
+// must only share a key between groups with identical membership, and must
+// construct and use pooled groups in the same order on all ranks. Point to
+// point communicators are never pooled. Events stay per-group, as they are
+// overwritten by each collective.
+struct NCCLCommPoolEntry {
+  std::vector<std::shared_ptr<NCCLComm>> comms;
+  std::vector<at::cuda::CUDAStream> streams;
+};
+
+std::mutex ncclCommPoolMutex;
+std::unordered_map<std::string, NCCLCommPoolEntry> ncclCommPool;
+
+} // namespace
+
+void ProcessGroupNCCL::warmupComms(
+    const std::vector<std::vector<at::Device>>& deviceLists) {
+  for (const auto& devices : deviceLists) {
+    TORCH_CHECK(
+        !devices.empty(),
+        "Cannot warm up an NCCL communicator for an empty device list");
+    // OpType only affects the send/recv rank plumbing; any collective type
+    // selects the plain collective path.
+    getNCCLComm(getKeyFromDevices(devices), devices, OpType::ALLREDUCE);
+  }
+}
+
 std::vector<std::shared_ptr<NCCLComm>>& ProcessGroupNCCL::getNCCLComm(
     const std::string& devicesKey,
     const std::vector<at::Device>& devices,
@@ -1121,6 +1234,27 @@ std::vector<std::shared_ptr<NCCLComm>>& ProcessGroupNCCL::getNCCLComm(
   // For batch_isend_irecv, ncclGroupStart() would be called upfront
   bool batchP2P = ncclActiveGroupCounter_ > 0;
   bool singleP2POp = isP2POp(opType, batchP2P);
+
+  // See Note [NCCL communicator pool].
+  const bool usePool = !options_->comm_pool_key.empty() && !singleP2POp;
+  const std::string poolKey = options_->comm_pool_key + "/" + devicesKey;
+  if (usePool) {
+    std::lock_guard<std::mutex> poolLock(ncclCommPoolMutex);
+    auto it = ncclCommPool.find(poolKey);
+    if (it != ncclCommPool.end()) {
+      LOG(INFO) << "[Rank " << rank_ << "] Reusing pooled NCCL communicators "
+                << "for key " << poolKey;
+      ncclStreams_.emplace(devicesKey, it->second.streams);
+      ncclEvents_.emplace(
+          std::piecewise_construct,
+          std::make_tuple(devicesKey),
+          std::make_tuple(devices.size()));
+      std::lock_guard<std::mutex> lock(mutex_);
+      devNCCLCommMap_.emplace(devicesKey, it->second.comms);
+      return devNCCLCommMap_[devicesKey];
+    }
+  }
+
   // For point-to-point communication, lower rank of the two will get unique id.
   if (rank_ == 0 || (singleP2POp && p2pRank == 0)) {
     C10D_NCCL_CHECK(ncclGetUniqueId(&ncclID), c10::nullopt);
@@ -1216,6 +1350,13 @@ std::vector<std::shared_ptr<NCCLComm>>& ProcessGroupNCCL::getNCCLComm(
       std::make_tuple(devicesKey),
       std::make_tuple(devices.size()));
 
+  // See Note [NCCL communicator pool].
+  if (usePool) {
+    std::lock_guard<std::mutex> poolLock(ncclCommPoolMutex);
+    ncclCommPool.emplace(
+        poolKey, NCCLCommPoolEntry{ncclComms, ncclStreams_[devicesKey]});
+  }
+
   // Hold the lock before modifying the cache.
   std::lock_guard<std::mutex> lock(mutex_);
 
@@ -1392,13 +1533,40 @@ c10::intrusive_ptr<c10::ivalue::Future> ProcessGroupNCCL::WorkNCCL::
 void ProcessGroupNCCL::workEnqueue(
     c10::intrusive_ptr<ProcessGroupNCCL::WorkNCCL> work) {
   if (!terminateProcessGroup_.load()) {
-    std::lock_guard<std::mutex> lock(workMetaListMutex_);
     // Avoid view tensors to be processed in cleanup thread.
     // View tensors' destruction invokes autograd_meta, which
     // needs to be destructed in user thread. Otherwise will
     // get deadlock. Here we enqueue work without outputs_.
-    workMetaList_.emplace_back(WorkNCCL(*work));
+    //
+    // Push onto the lock-free pending stack instead of taking
+    // workMetaListMutex_: the background sweeps can hold that mutex for a
+    // long time at high collective rates, and the issue path must not wait
+    // on them.
+    auto* node = new PendingWorkNode(WorkNCCL(*work));
+    node->next = pendingWorkHead_.load(std::memory_order_relaxed);
+    while (!pendingWorkHead_.compare_exchange_weak(
+        node->next,
+        node,
+        std::memory_order_release,
+        std::memory_order_relaxed)) {
+    }
+  }
+}
+
+void ProcessGroupNCCL::drainPendingWorks() {
+  PendingWorkNode* node =
+      pendingWorkHead_.exchange(nullptr, std::memory_order_acquire);
+  // The stack pops in LIFO order; prepend while unwinding it so
+  // workMetaList_ stays in submission order (the desync trace relies on
+  // seeing sequence numbers in order).
+  std::list<WorkNCCL> pending;
+  while (node != nullptr) {
+    pending.emplace_front(node->work);
+    PendingWorkNode* prev = node;
+    node = node->next;
+    delete prev;
   }
+  workMetaList_.splice(workMetaList_.end(), pending);
 }
 
 ProcessGroupNCCL::Options::Options(bool is_high_priority_stream)
@@ -1725,9 +1893,218 @@ c10::intrusive_ptr<ProcessGroup::Work> ProcessGroupNCCL::allreduce(
       std::vector<int64_t>(), // inSplitSizes
       std::vector<int64_t>()); // outSplitSizes
 
+  if (shouldCoalesce_(tensors, opts)) {
+    return coalesceAllreduce_(tensors[0], opts);
+  }
+
   return allreduce_impl(tensors, opts);
 }
 
+// [Note: small collective coalescing]
+// Launching one NCCL kernel per allreduce makes small per-layer gradients
+// pay the full launch and protocol overhead; at a few hundred KB per tensor
+// the wire time is a fraction of the fixed cost. When
+// NCCL_COALESCE_SMALL_ALLREDUCES is set, single-tensor allreduces below
+// NCCL_COALESCE_MAX_TENSOR_BYTES are queued instead of issued. The queue is
+// flushed into a single fused ncclAllReduce over a persistent staging arena
+// when the batch reaches NCCL_COALESCE_FLUSH_BYTES, when it is older than
+// NCCL_COALESCE_FLUSH_TIMEOUT_US at the next enqueue, when an incompatible
+// collective (different device, dtype or reduce op) arrives, when
+// ProcessGroup::flush() is called explicitly, or when a queued work handle
+// is waited on. Pack and unpack copies run on the NCCL stream inside the
+// pre/post hooks of the fused collective, so callers observe the same
+// stream-ordering guarantees as for an eager allreduce.
+//
+// Since all ranks must enqueue the same collectives in the same order (a
+// standing requirement of this class), every rank makes the same
+// flush-or-queue decision for the size, dtype and op triggers. The age
+// trigger is evaluated against the local clock and can fire on a subset of
+// ranks for a given enqueue; that only moves the batch boundary, and the
+// fused collective on each rank still covers the same tensors in the same
+// order by the time a handle is waited on.
+
+bool ProcessGroupNCCL::shouldCoalesce_(
+    const std::vector<at::Tensor>& tensors,
+    const AllreduceOptions& opts) const {
+  if (!coalescingEnabled_ || tensors.size() != 1) {
+    return false;
+  }
+  // Manual batching (e.g. batch_isend_irecv style grouping) takes priority.
+  if (ncclActiveGroupCounter_ > 0) {
+    return false;
+  }
+  const auto& tensor = tensors[0];
+  if (!tensor.is_cuda() || tensor.is_sparse() || !tensor.is_contiguous()) {
+    return false;
+  }
+  // PREMUL_SUM-style ops would need the scaling applied per tensor; only
+  // coalesce the plain elementwise reductions.
+  if (opts.reduceOp != ReduceOp::SUM && opts.reduceOp != ReduceOp::AVG &&
+      opts.reduceOp != ReduceOp::MIN && opts.reduceOp != ReduceOp::MAX &&
+      opts.reduceOp != ReduceOp::PRODUCT) {
+    return false;
+  }
+  const size_t bytes = tensor.numel() * tensor.element_size();
+  return bytes <= coalesceMaxTensorBytes_;
+}
+
+c10::intrusive_ptr<ProcessGroup::Work> ProcessGroupNCCL::coalesceAllreduce_(
+    at::Tensor& tensor,
+    const AllreduceOptions& opts) {
+  std::lock_guard<std::mutex> lock(coalesceMutex_);
+  const size_t bytes = tensor.numel() * tensor.element_size();
+  const auto now = std::chrono::steady_clock::now();
+  if (!pendingCoalesced_.empty()) {
+    const auto& first = pendingCoalesced_.front()->tensor_;
+    const bool compatible = first.device() == tensor.device() &&
+        first.scalar_type() == tensor.scalar_type() &&
+        pendingReduceOp_ == opts.reduceOp;
+    if (!compatible || pendingCoalescedBytes_ + bytes > coalesceFlushBytes_ ||
+        now - pendingCoalescedSince_ >= coalesceFlushTimeout_) {
+      flushCoalescedLocked_();
+    }
+  }
+  if (pendingCoalesced_.empty()) {
+    pendingReduceOp_ = opts.reduceOp;
+    pendingCoalescedSince_ = now;
+  }
+  auto work = c10::make_intrusive<CoalescedWorkNCCL>(this, tensor, rank_);
+  pendingCoalesced_.push_back(work);
+  pendingCoalescedBytes_ += bytes;
+  if (pendingCoalescedBytes_ >= coalesceFlushBytes_) {
+    flushCoalescedLocked_();
+  }
+  return work;
+}
+
+c10::intrusive_ptr<ProcessGroup::Work> ProcessGroupNCCL::
+    flushCoalescedLocked_() {
+  if (pendingCoalesced_.empty()) {
+    return nullptr;
+  }
+  auto pending = std::move(pendingCoalesced_);
+  pendingCoalesced_.clear();
+  pendingCoalescedBytes_ = 0;
+
+  const auto& first = pending.front()->tensor_;
+  int64_t totalNumel = 0;
+  for (const auto& w : pending) {
+    totalNumel += w->tensor_.numel();
+  }
+
+  // Grow (or retype) the persistent staging arena if the batch does not fit.
+  if (!coalesceArena_.defined() ||
+      coalesceArena_.device() != first.device() ||
+      coalesceArena_.scalar_type() != first.scalar_type() ||
+      coalesceArena_.numel() < totalNumel) {
+    coalesceArena_ = at::empty({totalNumel}, first.options());
+  }
+  auto fused = coalesceArena_.narrow(0, 0, totalNumel);
+  std::vector<at::Tensor> fusedVec = {fused};
+
+  const auto reduceOp = pendingReduceOp_;
+  auto work = collective(
+      fusedVec,
+      fusedVec,
+      [&](at::Tensor& input,
+          at::Tensor& output,
+          ncclComm_t comm,
+          at::cuda::CUDAStream& stream) {
+        return ncclAllReduce(
+            input.data_ptr(),
+            output.data_ptr(),
+            input.numel(),
+            getNcclDataType(input.scalar_type()),
+            getNcclReduceOp(reduceOp, input),
+            comm,
+            stream.stream());
+      },
+      [&](std::vector<at::cuda::CUDAStream>& ncclStreams) {
+        // Pack the queued tensors into the arena on the NCCL stream; the
+        // stream has already waited on the producer streams via syncStreams.
+        at::cuda::CUDAStreamGuard guard(ncclStreams[0]);
+        int64_t offset = 0;
+        for (const auto& w : pending) {
+          const auto numel = w->tensor_.numel();
+          c10::cuda::CUDACachingAllocator::recordStream(
+              w->tensor_.storage().data_ptr(), ncclStreams[0]);
+          fused.narrow(0, offset, numel)
+              .copy_(w->tensor_.view({numel}), /*non_blocking=*/true);
+          offset += numel;
+        }
+      },
+      [&](std::vector<at::cuda::CUDAStream>& ncclStreams) {
+        // Scatter the reduced arena back before the end events are recorded,
+        // so waiting on the fused work also orders the unpack copies.
+        at::cuda::CUDAStreamGuard guard(ncclStreams[0]);
+        int64_t offset = 0;
+        for (const auto& w : pending) {
+          const auto numel = w->tensor_.numel();
+          w->tensor_.view({numel}).copy_(
+              fused.narrow(0, offset, numel), /*non_blocking=*/true);
+          offset += numel;
+        }
+      },
+      OpType::ALLREDUCE_COALESCED,
+      "nccl:coalesced_all_reduce");
+
+  for (const auto& w : pending) {
+    w->fusedWork_ = work;
+  }
+  return work;
+}
+
+c10::intrusive_ptr<ProcessGroup::Work> ProcessGroupNCCL::flush() {
+  std::lock_guard<std::mutex> lock(coalesceMutex_);
+  return flushCoalescedLocked_();
+}
+
+ProcessGroupNCCL::CoalescedWorkNCCL::CoalescedWorkNCCL(
+    ProcessGroupNCCL* pg,
+    at::Tensor tensor,
+    int rank)
+    : Work(rank, OpType::ALLREDUCE_COALESCED),
+      pg_(pg),
+      tensor_(std::move(tensor)) {}
+
+c10::intrusive_ptr<ProcessGroup::Work> ProcessGroupNCCL::CoalescedWorkNCCL::
+    ensureFlushed_() {
+  std::lock_guard<std::mutex> lock(pg_->coalesceMutex_);
+  if (!fusedWork_) {
+    pg_->flushCoalescedLocked_();
+  }
+  TORCH_INTERNAL_ASSERT(fusedWork_);
+  return fusedWork_;
+}
+
+bool ProcessGroupNCCL::CoalescedWorkNCCL::isCompleted() {
+  return ensureFlushed_()->isCompleted();
+}
+
+bool ProcessGroupNCCL::CoalescedWorkNCCL::isSuccess() const {
+  // A batch that has not been issued yet cannot have completed. No flush
+  // here: this accessor is const and polling isCompleted() flushes first.
+  return fusedWork_ ? fusedWork_->isSuccess() : false;
+}
+
+bool ProcessGroupNCCL::CoalescedWorkNCCL::wait(
+    std::chrono::milliseconds timeout) {
+  return ensureFlushed_()->wait(timeout);
+}
+
+void ProcessGroupNCCL::CoalescedWorkNCCL::synchronize() {
+  ensureFlushed_()->synchronize();
+}
+
+c10::intrusive_ptr<c10::ivalue::Future> ProcessGroupNCCL::CoalescedWorkNCCL::
+    getFuture() {
+  return ensureFlushed_()->getFuture();
+}
+
+std::vector<at::Tensor> ProcessGroupNCCL::CoalescedWorkNCCL::result() {
+  return {tensor_};
+}
+
 c10::intrusive_ptr<ProcessGroup::Work> ProcessGroupNCCL::allreduce_coalesced(
     std::vector<at::Tensor>& tensors,
     const AllreduceCoalescedOptions& opts) {
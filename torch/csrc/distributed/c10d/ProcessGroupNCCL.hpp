@@ -42,6 +42,24 @@ constexpr const char* NCCL_ASYNC_ERROR_HANDLING = "NCCL_ASYNC_ERROR_HANDLING";
 // This variable must be set together with NCCL_ASYNC_ERROR_HANDLING.
 constexpr const char* NCCL_DESYNC_DEBUG = "NCCL_DESYNC_DEBUG";
 
+// Environment variable which controls whether small single-tensor allreduces
+// are transparently batched into one fused NCCL call. See
+// [Note: small collective coalescing].
+constexpr const char* NCCL_COALESCE_SMALL_ALLREDUCES =
+    "NCCL_COALESCE_SMALL_ALLREDUCES";
+
+// Upper bound, in bytes, on a tensor eligible for coalescing (default 1MB).
+constexpr const char* NCCL_COALESCE_MAX_TENSOR_BYTES =
+    "NCCL_COALESCE_MAX_TENSOR_BYTES";
+
+// Pending batch size, in bytes, at which the batch is flushed (default 16MB).
+constexpr const char* NCCL_COALESCE_FLUSH_BYTES = "NCCL_COALESCE_FLUSH_BYTES";
+
+// Age of the pending batch, in microseconds, past which the next queued
+// collective flushes it first (default 1000us).
+constexpr const char* NCCL_COALESCE_FLUSH_TIMEOUT_US =
+    "NCCL_COALESCE_FLUSH_TIMEOUT_US";
+
 constexpr const char* NCCL_BACKEND_NAME = "nccl";
 
 // ProcessGroupNCCL implements NCCL bindings for c10d.
@@ -218,6 +236,39 @@ class TORCH_API ProcessGroupNCCL : public ProcessGroup {
     friend class ProcessGroupNCCL;
   };
 
+  // Handle for one allreduce that was queued for coalescing. The fused NCCL
+  // call is only issued when the batch is flushed; waiting on (or polling)
+  // the handle forces a flush first, so the usual allreduce()->wait() pattern
+  // keeps working unchanged. See [Note: small collective coalescing].
+  class CoalescedWorkNCCL : public ProcessGroup::Work {
+   public:
+    CoalescedWorkNCCL(ProcessGroupNCCL* pg, at::Tensor tensor, int rank);
+
+    bool isCompleted() override;
+    bool isSuccess() const override;
+    bool wait(std::chrono::milliseconds timeout = kNoTimeout) override;
+    void synchronize() override;
+    // NOTE: the future completes with the fused staging buffer, not the
+    // original tensor; use it for completion tracking only.
+    c10::intrusive_ptr<c10::ivalue::Future> getFuture() override;
+    std::vector<at::Tensor> result() override;
+
+   private:
+    // Flushes the owning batch if it has not been issued yet and returns the
+    // Work of the fused collective.
+    c10::intrusive_ptr<ProcessGroup::Work> ensureFlushed_();
+
+    // The process group owns the communicators this work ultimately waits
+    // on and must outlive its in-flight work objects, so a plain pointer is
+    // sufficient here.
+    ProcessGroupNCCL* pg_;
+    at::Tensor tensor_;
+    // Work of the fused batch; set by flushCoalescedLocked_.
+    c10::intrusive_ptr<ProcessGroup::Work> fusedWork_;
+
+    friend class ProcessGroupNCCL;
+  };
+
   struct Options : ProcessGroup::Options {
     // NOTE: timeout in ProcessGroupNCCL::Options denote the timeout for
     // operations. This is only used when blockingWait_ is enabled.
@@ -232,6 +283,21 @@ class TORCH_API ProcessGroupNCCL : public ProcessGroup {
 
     // Schedule NCCL operations on high priority CUDA streams
     bool is_high_priority_stream;
+
+    // Device indices to eagerly create communicators for at construction
+    // instead of inside the first collective. Each index warms the
+    // single-device list {cuda:index}; layouts with several devices per
+    // process can call warmupComms() explicitly. All ranks must pass the
+    // same list, as warmup performs the same rendezvous as a collective.
+    std::vector<int64_t> warmup_device_ids;
+
+    // Non-empty key opts this group into a process-wide communicator pool:
+    // groups constructed with the same key share communicators (and their
+    // NCCL streams) for identical device lists instead of paying full
+    // communicator init again. Only valid for groups with identical
+    // membership that are constructed and used in the same order on all
+    // ranks. See Note [NCCL communicator pool].
+    std::string comm_pool_key;
   };
 
   // If you wish to create multiple process groups, each with a potentially
@@ -275,6 +341,10 @@ class TORCH_API ProcessGroupNCCL : public ProcessGroup {
       return std::string(NCCL_BACKEND_NAME);
   }
 
+  c10::intrusive_ptr<Store> getStore() const override {
+    return store_;
+  }
+
   c10::intrusive_ptr<ProcessGroup::Work> broadcast(
       std::vector<at::Tensor>& tensors,
       const BroadcastOptions& opts = BroadcastOptions()) override;
@@ -320,6 +390,10 @@ class TORCH_API ProcessGroupNCCL : public ProcessGroup {
   c10::intrusive_ptr<ProcessGroup::Work> barrier(
       const BarrierOptions& opts = BarrierOptions()) override;
 
+  // Issues the pending coalesced allreduce batch, if any. See
+  // [Note: small collective coalescing].
+  c10::intrusive_ptr<ProcessGroup::Work> flush() override;
+
   c10::intrusive_ptr<ProcessGroup::Work> alltoall_base(
       at::Tensor& outputTensor,
       at::Tensor& inputTensor,
@@ -373,6 +447,14 @@ class TORCH_API ProcessGroupNCCL : public ProcessGroup {
   // Tests if the UCC fallback path is available
   bool isUCCAvailable() const;
 
+  // Eagerly creates communicators (with their NCCL streams and event state)
+  // for the given device lists, so the multi-second initialization happens
+  // here rather than inside the first collective. Each inner list is the
+  // device list a collective would receive, e.g. {{cuda:0}} for the common
+  // one-device-per-process layout. Collective: all ranks of the group must
+  // call this with identical arguments.
+  void warmupComms(const std::vector<std::vector<at::Device>>& deviceLists);
+
  protected:
   // Helper that broadcasts nccl unique ID to all ranks through the store
   void broadcastUniqueNCCLID(
@@ -449,6 +531,22 @@ class TORCH_API ProcessGroupNCCL : public ProcessGroup {
       std::vector<at::Tensor>& tensors,
       const AllreduceOptions& opts = AllreduceOptions());
 
+  // Whether an allreduce call is eligible for small-collective coalescing.
+  bool shouldCoalesce_(
+      const std::vector<at::Tensor>& tensors,
+      const AllreduceOptions& opts) const;
+
+  // Queues a small allreduce into the pending batch, flushing first if the
+  // new tensor is incompatible with it or thresholds are exceeded.
+  c10::intrusive_ptr<ProcessGroup::Work> coalesceAllreduce_(
+      at::Tensor& tensor,
+      const AllreduceOptions& opts);
+
+  // Packs the pending batch into the staging arena, issues one fused
+  // ncclAllReduce and scatters the result back. Caller must hold
+  // coalesceMutex_.
+  c10::intrusive_ptr<ProcessGroup::Work> flushCoalescedLocked_();
+
   // Checks for NCCL errors on each of the communicators and returns an
   // appropriate exception_ptr (nullptr if no errors).
   static std::exception_ptr checkForNCCLErrorsInternal(
@@ -571,6 +669,23 @@ class TORCH_API ProcessGroupNCCL : public ProcessGroup {
   // Vector to Store WorkNCCL pointers
   std::list<ProcessGroupNCCL::WorkNCCL> workMetaList_;
 
+  // Lock-free hand-off from the collective issue path to the watchdog and
+  // cleanup threads: workEnqueue pushes a node with a single CAS onto this
+  // Treiber stack, and the background threads take the whole stack at once
+  // with drainPendingWorks. Issuing a collective therefore never contends on
+  // workMetaListMutex_, no matter how long a background sweep over
+  // workMetaList_ holds it.
+  struct PendingWorkNode {
+    explicit PendingWorkNode(const WorkNCCL& work) : work(work) {}
+    WorkNCCL work;
+    PendingWorkNode* next{nullptr};
+  };
+  std::atomic<PendingWorkNode*> pendingWorkHead_{nullptr};
+
+  // Moves everything queued by workEnqueue into workMetaList_, preserving
+  // submission order. Requires workMetaListMutex_ to be held.
+  void drainPendingWorks();
+
   // Add Work Pointer to workVector
   void workEnqueue(c10::intrusive_ptr<ProcessGroupNCCL::WorkNCCL>);
 
@@ -629,6 +744,22 @@ class TORCH_API ProcessGroupNCCL : public ProcessGroup {
   // Counting for the sequential number of NCCL collective call.
   uint64_t seq_{0};
 
+  // State of the small-collective coalescing manager; everything below is
+  // guarded by coalesceMutex_. See [Note: small collective coalescing].
+  bool coalescingEnabled_{false};
+  size_t coalesceMaxTensorBytes_{0};
+  size_t coalesceFlushBytes_{0};
+  std::chrono::microseconds coalesceFlushTimeout_{0};
+  std::mutex coalesceMutex_;
+  std::vector<c10::intrusive_ptr<CoalescedWorkNCCL>> pendingCoalesced_;
+  size_t pendingCoalescedBytes_{0};
+  ReduceOp pendingReduceOp_{ReduceOp::SUM};
+  std::chrono::steady_clock::time_point pendingCoalescedSince_;
+
+  // Persistent staging arena reused across flushes; regrown when the batch
+  // dtype, device or total size changes.
+  at::Tensor coalesceArena_;
+
 #ifdef USE_NCCL_WITH_UCC
   // ProcessGroupUCC shared library handle and ProcessGroup pointer
   static std::shared_ptr<at::DynamicLibrary> uccLib_;
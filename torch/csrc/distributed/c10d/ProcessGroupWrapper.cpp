@@ -271,6 +271,10 @@ const std::string ProcessGroupWrapper::getBackendName() const {
   return pg_->getBackendName();
 }
 
+c10::intrusive_ptr<Store> ProcessGroupWrapper::getStore() const {
+  return pg_->getStore();
+}
+
 c10::intrusive_ptr<ProcessGroup::Work> ProcessGroupWrapper::broadcast(
     std::vector<at::Tensor>& data,
     const BroadcastOptions& opts) {
@@ -17,6 +17,8 @@ class TORCH_API ProcessGroupWrapper : public ProcessGroup {
 
   const std::string getBackendName() const override;
 
+  c10::intrusive_ptr<Store> getStore() const override;
+
   c10::intrusive_ptr<ProcessGroup::Work> broadcast(
       std::vector<at::Tensor>& data,
       const BroadcastOptions& opts = BroadcastOptions()) override;
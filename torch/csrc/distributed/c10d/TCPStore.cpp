@@ -17,6 +17,10 @@
 #include <unistd.h>
 #endif
 
+#ifdef __linux__
+#include <sys/epoll.h>
+#endif
+
 #ifdef _WIN32
 #include <c10d/WinSockUtils.hpp>
 #else
@@ -146,6 +150,8 @@ enum class QueryType : uint8_t {
   GETNUMKEYS,
   WATCH_KEY,
   DELETE_KEY,
+  MULTI_GET,
+  MULTI_SET,
 };
 
 enum class CheckResponseType : uint8_t { READY, NOT_READY };
@@ -170,6 +176,8 @@ class TCPStoreMasterDaemon : public BackgroundThread {
   void run();
   void queryFds(std::vector<struct pollfd>& fds);
   void query(int socket);
+  // Forgets all the wait/watch state recorded for a closed socket.
+  void clearSocketWaitState(int socket);
 
   // The master runs on a single thread so only
   // one handler can be executed at a time
@@ -182,6 +190,12 @@ class TCPStoreMasterDaemon : public BackgroundThread {
   void deleteHandler(int socket);
   void waitHandler(int socket);
   void watchHandler(int socket);
+  void multiGetHandler(int socket) const;
+  void multiSetHandler(int socket);
+
+  // Stores a value and notifies waiting/watching clients; shared by
+  // setHandler and multiSetHandler.
+  void doSet(const std::string& key, const std::vector<uint8_t>& newData);
 
   bool checkKeys(const std::vector<std::string>& keys) const;
   // Helper function to alerts waiting workers, used in setHandler, getHandler
@@ -234,27 +248,7 @@ void TCPStoreMasterDaemon::queryFds(std::vector<struct pollfd>& fds) {
       // we hit an exception here.
 
       // Remove all the tracking state of the close FD
-      for (auto it = waitingSockets_.begin(); it != waitingSockets_.end();) {
-        for (auto vecIt = it->second.begin(); vecIt != it->second.end();) {
-          if (*vecIt == fds[fdIdx].fd) {
-            vecIt = it->second.erase(vecIt);
-          } else {
-            ++vecIt;
-          }
-        }
-        if (it->second.size() == 0) {
-          it = waitingSockets_.erase(it);
-        } else {
-          ++it;
-        }
-      }
-      for (auto it = keysAwaited_.begin(); it != keysAwaited_.end();) {
-        if (it->first == fds[fdIdx].fd) {
-          it = keysAwaited_.erase(it);
-        } else {
-          ++it;
-        }
-      }
+      clearSocketWaitState(fds[fdIdx].fd);
       fds.erase(fds.begin() + fdIdx);
       sockets_.erase(sockets_.begin() + fdIdx - CONNECT_SOCKET_OFFSET);
       --fdIdx;
@@ -263,6 +257,30 @@ void TCPStoreMasterDaemon::queryFds(std::vector<struct pollfd>& fds) {
   }
 }
 
+void TCPStoreMasterDaemon::clearSocketWaitState(int socket) {
+  for (auto it = waitingSockets_.begin(); it != waitingSockets_.end();) {
+    for (auto vecIt = it->second.begin(); vecIt != it->second.end();) {
+      if (*vecIt == socket) {
+        vecIt = it->second.erase(vecIt);
+      } else {
+        ++vecIt;
+      }
+    }
+    if (it->second.size() == 0) {
+      it = waitingSockets_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  for (auto it = keysAwaited_.begin(); it != keysAwaited_.end();) {
+    if (it->first == socket) {
+      it = keysAwaited_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
 // query communicates with the worker. The format
 // of the query is as follows:
 // type of query | size of arg1 | arg1 | size of arg2 | arg2 | ...
@@ -298,6 +316,12 @@ void TCPStoreMasterDaemon::query(int socket) {
   } else if (qt == QueryType::WATCH_KEY) {
     watchHandler(socket);
 
+  } else if (qt == QueryType::MULTI_GET) {
+    multiGetHandler(socket);
+
+  } else if (qt == QueryType::MULTI_SET) {
+    multiSetHandler(socket);
+
   } else {
     TORCH_CHECK(false, "Unexpected query type");
   }
@@ -329,9 +353,9 @@ void TCPStoreMasterDaemon::sendKeyUpdatesToClients(
   }
 }
 
-void TCPStoreMasterDaemon::setHandler(int socket) {
-  std::string key = tcputil::recvString(socket);
-  std::vector<uint8_t> newData = tcputil::recvVector<uint8_t>(socket);
+void TCPStoreMasterDaemon::doSet(
+    const std::string& key,
+    const std::vector<uint8_t>& newData) {
   std::vector<uint8_t> oldData;
   bool newKey = true;
   auto it = tcpStore_.find(key);
@@ -343,10 +367,17 @@ void TCPStoreMasterDaemon::setHandler(int socket) {
   // On "set", wake up all clients that have been waiting
   wakeupWaitingClients(key);
   // Send key update to all watching clients
+  std::vector<uint8_t> newDataCopy = newData;
   newKey ? sendKeyUpdatesToClients(
-               key, WatchResponseType::KEY_CREATED, oldData, newData)
+               key, WatchResponseType::KEY_CREATED, oldData, newDataCopy)
          : sendKeyUpdatesToClients(
-               key, WatchResponseType::KEY_UPDATED, oldData, newData);
+               key, WatchResponseType::KEY_UPDATED, oldData, newDataCopy);
+}
+
+void TCPStoreMasterDaemon::setHandler(int socket) {
+  std::string key = tcputil::recvString(socket);
+  std::vector<uint8_t> newData = tcputil::recvVector<uint8_t>(socket);
+  doSet(key, newData);
 }
 
 void TCPStoreMasterDaemon::compareSetHandler(int socket) {
@@ -482,6 +513,29 @@ void TCPStoreMasterDaemon::watchHandler(int socket) {
       socket, WatchResponseType::KEY_CALLBACK_REGISTERED);
 }
 
+void TCPStoreMasterDaemon::multiGetHandler(int socket) const {
+  SizeType nargs;
+  tcputil::recvBytes<SizeType>(socket, &nargs, 1);
+  for (const auto i : c10::irange(nargs)) {
+    std::string key = tcputil::recvString(socket);
+    auto& data = tcpStore_.at(key);
+    // Flush only after the last value so the whole batch goes out in as
+    // few packets as possible.
+    tcputil::sendVector<uint8_t>(socket, data, i + 1 < nargs);
+  }
+}
+
+void TCPStoreMasterDaemon::multiSetHandler(int socket) {
+  SizeType nargs;
+  tcputil::recvBytes<SizeType>(socket, &nargs, 1);
+  for (const auto i : c10::irange(nargs)) {
+    (void)i;
+    std::string key = tcputil::recvString(socket);
+    std::vector<uint8_t> newData = tcputil::recvVector<uint8_t>(socket);
+    doSet(key, newData);
+  }
+}
+
 bool TCPStoreMasterDaemon::checkKeys(
     const std::vector<std::string>& keys) const {
   return std::all_of(keys.begin(), keys.end(), [this](const std::string& s) {
@@ -531,6 +585,75 @@ void TCPStoreMasterDaemon::run() {
     queryFds(fds);
   }
 }
+#elif defined(__linux__)
+void TCPStoreMasterDaemon::run() {
+  // With thousands of ranks connected, poll(2) makes the daemon rebuild
+  // and scan the whole fd array on every wakeup, so servicing each
+  // request costs O(connections). epoll keeps the interest list in the
+  // kernel and only hands back the fds that are actually ready.
+  int epollFd;
+  SYSCHECK_ERR_RETURN_NEG1(epollFd = ::epoll_create1(0));
+
+  auto addFd = [epollFd](int fd) {
+    struct epoll_event ev {};
+    ev.events = EPOLLIN;
+    ev.data.fd = fd;
+    SYSCHECK_ERR_RETURN_NEG1(::epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev));
+  };
+
+  addFd(storeListenSocket_.handle());
+  // See the note on the control pipe in the poll(2) implementation below;
+  // the same write-then-close protocol applies here.
+  addFd(controlPipeFd_[0]);
+
+  std::array<struct epoll_event, 64> events{};
+
+  // receive the queries
+  bool finished = false;
+  while (!finished) {
+    int numReady;
+    SYSCHECK_ERR_RETURN_NEG1(
+        numReady = ::epoll_wait(epollFd, events.data(), events.size(), -1));
+
+    for (const auto i : c10::irange(numReady)) {
+      const int fd = events[i].data.fd;
+
+      // TCPStore's listening socket has an event and it should now be
+      // able to accept new connections.
+      if (fd == storeListenSocket_.handle()) {
+        Socket socket = storeListenSocket_.accept();
+        int rawSocket = socket.handle();
+        sockets_.emplace_back(std::move(socket));
+        addFd(rawSocket);
+        continue;
+      }
+
+      // The pipe receives an event which tells us to shutdown the daemon
+      if (fd == controlPipeFd_[0]) {
+        finished = true;
+        break;
+      }
+
+      try {
+        query(fd);
+      } catch (...) {
+        // See the comment in queryFds: an exception here almost always
+        // means the other side closed its socket, so drop the connection
+        // and keep serving the remaining clients.
+        clearSocketWaitState(fd);
+        SYSCHECK_ERR_RETURN_NEG1(
+            ::epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr));
+        sockets_.erase(
+            std::find_if(
+                sockets_.begin(),
+                sockets_.end(),
+                [fd](const Socket& socket) { return socket.handle() == fd; }));
+      }
+    }
+  }
+
+  ::close(epollFd);
+}
 #else
 void TCPStoreMasterDaemon::run() {
   std::vector<struct pollfd> fds;
@@ -846,6 +969,10 @@ class TCPClient {
 
   void sendStrings(c10::ArrayRef<std::string> value);
 
+  void sendKeyValuePairs(
+      c10::ArrayRef<std::string> keys,
+      c10::ArrayRef<std::vector<std::uint8_t>> values);
+
   template <typename T>
   void sendValue(const T& value) {
     tcputil::sendValue<T>(socket_.handle(), value);
@@ -901,6 +1028,21 @@ void TCPClient::sendStrings(c10::ArrayRef<std::string> value) {
   }
 }
 
+void TCPClient::sendKeyValuePairs(
+    c10::ArrayRef<std::string> keys,
+    c10::ArrayRef<std::vector<std::uint8_t>> values) {
+  std::size_t size = keys.size();
+
+  tcputil::sendBytes<std::size_t>(socket_.handle(), &size, 1, size > 0);
+
+  for (std::size_t i = 0; i < size; ++i) {
+    tcputil::sendString(socket_.handle(), keys[i], true);
+    // Flush only after the last value so the whole batch goes out in as
+    // few packets as possible.
+    tcputil::sendVector<std::uint8_t>(socket_.handle(), values[i], i + 1 < size);
+  }
+}
+
 void TCPClient::setTimeout(std::chrono::milliseconds value) {
   if (value == std::chrono::milliseconds::zero()) {
     return;
@@ -1072,6 +1214,47 @@ std::vector<uint8_t> TCPStore::get(const std::string& key) {
   return doGet(keyPrefix_ + key);
 }
 
+std::vector<std::vector<uint8_t>> TCPStore::multiGet(
+    const std::vector<std::string>& keys) {
+  const std::lock_guard<std::mutex> lock(activeOpLock_);
+  std::vector<std::string> prefixedKeys{};
+  prefixedKeys.reserve(keys.size());
+  for (const std::string& key : keys) {
+    prefixedKeys.emplace_back(keyPrefix_ + key);
+  }
+  // Like get(), block until every key is available first; the batched
+  // fetch below then completes in a single round trip.
+  doWait(prefixedKeys, timeout_);
+
+  client_->sendCommand(detail::QueryType::MULTI_GET);
+  client_->sendStrings(prefixedKeys);
+
+  std::vector<std::vector<uint8_t>> result{};
+  result.reserve(keys.size());
+  for (const auto i : c10::irange(keys.size())) {
+    (void)i;
+    result.emplace_back(client_->receiveBits());
+  }
+  return result;
+}
+
+void TCPStore::multiSet(
+    const std::vector<std::string>& keys,
+    const std::vector<std::vector<uint8_t>>& values) {
+  TORCH_CHECK(
+      keys.size() == values.size(),
+      "multiSet requires the same number of keys and values");
+  const std::lock_guard<std::mutex> lock(activeOpLock_);
+  std::vector<std::string> prefixedKeys{};
+  prefixedKeys.reserve(keys.size());
+  for (const std::string& key : keys) {
+    prefixedKeys.emplace_back(keyPrefix_ + key);
+  }
+
+  client_->sendCommand(detail::QueryType::MULTI_SET);
+  client_->sendKeyValuePairs(prefixedKeys, values);
+}
+
 std::vector<uint8_t> TCPStore::doGet(const std::string& key) {
   doWait(key, timeout_);
   client_->sendCommandForKey(detail::QueryType::GET, key);
@@ -59,6 +59,16 @@ class TORCH_API TCPStore : public Store {
 
   std::vector<uint8_t> get(const std::string& key) override;
 
+  // Retrieves the values of several keys in a single round trip to the
+  // server. Like get(), blocks until every key is available.
+  std::vector<std::vector<uint8_t>> multiGet(
+      const std::vector<std::string>& keys);
+
+  // Stores several key/value pairs in a single round trip to the server.
+  void multiSet(
+      const std::vector<std::string>& keys,
+      const std::vector<std::vector<uint8_t>>& values);
+
   int64_t add(const std::string& key, int64_t value) override;
 
   bool deleteKey(const std::string& key) override;
@@ -8,6 +8,19 @@
 #include <torch/csrc/distributed/c10d/Ops.hpp>
 #include <torch/csrc/utils/tensor_flatten.h>
 
+#ifndef _WIN32
+#include <unistd.h>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include <ATen/MapAllocator.h>
+#endif
+
 namespace c10d {
 namespace {
 
@@ -51,6 +64,187 @@ class BroadcastWork {
   c10::intrusive_ptr<c10d::ProcessGroup::Work> work_;
 };
 
+#ifndef _WIN32
+
+// Note [Shared-memory broadcast]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// broadcast_coalesced is how DDP ships the initial model state from the
+// authoritative rank to everyone else. Pushing tens of GB through the
+// collective stack is wasteful when every rank of the group lives on the
+// same host: the bytes never need to touch NCCL/Gloo. When the group can
+// be proven single-host (the ranks exchange a host tag through the store
+// the group was bootstrapped with, see ProcessGroup::getStore()), the
+// authoritative rank instead copies each bucket into a POSIX
+// shared-memory segment -- the same RefcountedMapAllocator machinery
+// torch.multiprocessing uses to share CPU storages -- and publishes the
+// segment name through the store. The other ranks map the segment and
+// copy straight into their (possibly CUDA) tensors. The segment carries
+// an in-band refcount, so the last rank to unmap it also unlinks it; the
+// authoritative rank keeps its mapping open until every peer has copied
+// out so the refcount can never hit zero early.
+//
+// The fast path bounces through host memory, which is still a large win
+// over a multi-GB collective broadcast at startup, and an even larger
+// one for CPU tensors, which skip the network stack entirely. Set
+// TORCH_DDP_DISABLE_SHM_BROADCAST=1 to force the collective path.
+
+constexpr auto kShmBroadcastPollInterval = std::chrono::milliseconds(1);
+
+bool shmBroadcastDisabled() {
+  const auto* env = std::getenv("TORCH_DDP_DISABLE_SHM_BROADCAST");
+  return env != nullptr && std::string(env) != "0";
+}
+
+// Identifies the machine this rank runs on. Hostnames are not guaranteed
+// unique across machines, so mix in the boot id where available; equal
+// names on different hosts must not alias (the reverse direction merely
+// falls back to the collective path).
+std::string thisHostTag() {
+  std::array<char, 256> hostname{};
+  if (gethostname(hostname.data(), hostname.size() - 1) != 0) {
+    return "";
+  }
+  std::string tag(hostname.data());
+  std::ifstream boot_id_file("/proc/sys/kernel/random/boot_id");
+  if (boot_id_file) {
+    std::string boot_id;
+    std::getline(boot_id_file, boot_id);
+    tag += ":" + boot_id;
+  }
+  return tag;
+}
+
+struct ShmBroadcastState {
+  std::mutex mutex;
+  // Whether all ranks rendezvousing through a given store share this host.
+  std::unordered_map<Store*, bool> single_host;
+  // Per-store sequence number; broadcast_coalesced is a collective, so
+  // the ranks agree on it and it keeps store keys from colliding across
+  // calls.
+  std::unordered_map<Store*, uint64_t> next_seq;
+};
+
+ShmBroadcastState& shmBroadcastState() {
+  static auto* state = new ShmBroadcastState();
+  return *state;
+}
+
+std::string shmBroadcastKeyPrefix(const c10::intrusive_ptr<Store>& store) {
+  auto& state = shmBroadcastState();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  return "shm_bcast/" + std::to_string(state.next_seq[store.get()]++);
+}
+
+bool allRanksOnThisHost(
+    const c10::intrusive_ptr<Store>& store,
+    int rank,
+    int size) {
+  auto& state = shmBroadcastState();
+  {
+    std::lock_guard<std::mutex> lock(state.mutex);
+    auto it = state.single_host.find(store.get());
+    if (it != state.single_host.end()) {
+      return it->second;
+    }
+  }
+  bool result = false;
+  const auto tag = thisHostTag();
+  if (!tag.empty()) {
+    store->set(
+        "shm_bcast/host/" + std::to_string(rank),
+        std::vector<uint8_t>(tag.begin(), tag.end()));
+    result = true;
+    for (const auto peer : c10::irange(size)) {
+      if (peer == rank) {
+        continue;
+      }
+      auto peer_tag = store->get("shm_bcast/host/" + std::to_string(peer));
+      if (std::string(peer_tag.begin(), peer_tag.end()) != tag) {
+        result = false;
+        break;
+      }
+    }
+  }
+  std::lock_guard<std::mutex> lock(state.mutex);
+  state.single_host.emplace(store.get(), result);
+  return result;
+}
+
+// Maps a refcounted shared-memory segment and wraps it in a 1-D CPU
+// tensor of `numel` elements of the given options' dtype.
+at::Tensor tensorOverShmSegment(
+    const std::string& handle,
+    int flags,
+    int64_t numel,
+    const at::TensorOptions& options) {
+  const auto nbytes = static_cast<size_t>(numel) * options.dtype().itemsize();
+  auto data_ptr = at::RefcountedMapAllocator::makeDataPtr(
+      handle.c_str(), flags, nbytes, /*actual_size_out=*/nullptr);
+  auto storage = c10::Storage(c10::make_intrusive<c10::StorageImpl>(
+      c10::StorageImpl::use_byte_size_t(),
+      nbytes,
+      std::move(data_ptr),
+      /*allocator=*/nullptr,
+      /*resizable=*/false));
+  return at::empty({0}, options).set_(storage, 0, {numel}, {});
+}
+
+void shmBroadcastBucket(
+    const c10::intrusive_ptr<Store>& store,
+    const std::string& key_prefix,
+    std::vector<at::Tensor>& bucket_tensors,
+    bool is_authoritative,
+    int size) {
+  int64_t total_numel = 0;
+  for (const auto& tensor : bucket_tensors) {
+    total_numel += tensor.numel();
+  }
+  if (total_numel == 0) {
+    return;
+  }
+  // Buckets are uniform in dtype and device (see
+  // compute_bucket_assignment_by_size), so the segment can be typed after
+  // the first tensor.
+  const auto cpu_options = bucket_tensors.front().options().device(at::kCPU);
+  const auto data_key = key_prefix + "/data";
+  const auto done_key = key_prefix + "/done";
+  if (is_authoritative) {
+    auto handle = at::NewProcessWideShmHandle();
+    auto flat = tensorOverShmSegment(
+        handle,
+        at::ALLOCATOR_MAPPED_SHAREDMEM | at::ALLOCATOR_MAPPED_EXCLUSIVE,
+        total_numel,
+        cpu_options);
+    auto chunks = torch::utils::unflatten_dense_tensors(flat, bucket_tensors);
+    for (const auto i : c10::irange(bucket_tensors.size())) {
+      chunks[i].copy_(bucket_tensors[i]);
+    }
+    store->set(data_key, std::vector<uint8_t>(handle.begin(), handle.end()));
+    // Hold our mapping (and with it the segment refcount) until every
+    // peer has copied out, then clean up the rendezvous keys.
+    while (store->add(done_key, 0) < size - 1) {
+      std::this_thread::sleep_for(kShmBroadcastPollInterval);
+    }
+    store->deleteKey(data_key);
+    store->deleteKey(done_key);
+  } else {
+    auto value = store->get(data_key);
+    std::string handle(value.begin(), value.end());
+    auto flat = tensorOverShmSegment(
+        handle,
+        at::ALLOCATOR_MAPPED_SHAREDMEM | at::ALLOCATOR_MAPPED_NOCREATE,
+        total_numel,
+        cpu_options);
+    auto chunks = torch::utils::unflatten_dense_tensors(flat, bucket_tensors);
+    for (const auto i : c10::irange(bucket_tensors.size())) {
+      bucket_tensors[i].copy_(chunks[i]);
+    }
+    store->add(done_key, 1);
+  }
+}
+
+#endif // !_WIN32
+
 } // namespace
 
 // Broadcast many tensors to all processes in the process group.
@@ -69,6 +263,28 @@ void broadcast_coalesced(
   // Returns tensor at specified index in input tensor list.
   const auto lookup = [&tensors](size_t index) { return tensors[index]; };
 
+#ifndef _WIN32
+  // Same-host process groups can skip the collective stack entirely, see
+  // Note [Shared-memory broadcast].
+  auto store = process_group->getStore();
+  if (store && process_group->getSize() > 1 && !shmBroadcastDisabled() &&
+      allRanksOnThisHost(
+          store, process_group->getRank(), process_group->getSize())) {
+    const auto key_prefix = shmBroadcastKeyPrefix(store);
+    const bool is_authoritative = process_group->getRank() == rank;
+    for (const auto bucket_idx : c10::irange(buckets.size())) {
+      auto bucket_tensors = c10::fmap(buckets[bucket_idx], lookup);
+      shmBroadcastBucket(
+          store,
+          key_prefix + "/" + std::to_string(bucket_idx),
+          bucket_tensors,
+          is_authoritative,
+          process_group->getSize());
+    }
+    return;
+  }
+#endif
+
   // We maintain a maximum of 2 in flight broadcast operations to avoid
   // allocating too much memory (in case the specified tensors are very large).
   std::deque<BroadcastWork> in_flight;
@@ -1,12 +1,17 @@
 #include <c10/core/ScalarType.h>
 #include <c10/util/Exception.h>
+#include <c10/util/irange.h>
 #include <c10d/default_comm_hooks.hpp>
 
+#include <ATen/CPUGeneratorImpl.h>
+#include <ATen/core/jit_type.h>
 #include <c10d/ProcessGroup.hpp>
 #include <c10d/comm.hpp>
 #include <torch/csrc/distributed/c10d/Ops.hpp>
 #include <torch/torch.h>
 
+#include <cmath>
+
 namespace c10d {
 
 c10::intrusive_ptr<c10::ivalue::Future> AllReduceCommHook::runHook(
@@ -44,6 +49,253 @@ c10::intrusive_ptr<c10::ivalue::Future> FP16CompressCommHook::runHook(
   return allreduce_fut->then(decompress, allreduce_fut->elementType());
 }
 
+c10::intrusive_ptr<c10::ivalue::Future> BFloat16CompressCommHook::runHook(
+    GradBucket& bucket) {
+  auto compressed_tensor = bucket.getBufferRef().to(torch::kBFloat16);
+  compressed_tensor /= state_->getSize();
+  std::vector<at::Tensor> tensors = {compressed_tensor};
+
+  auto allreduce_fut = ops::allreduce(state_, tensors)->getFuture();
+  auto decompressed_tensor = bucket.getBufferRef();
+  auto decompress = [decompressed_tensor](c10::ivalue::Future& allreduce_fut) {
+    auto result = allreduce_fut.value();
+    TORCH_INTERNAL_ASSERT(
+        result.isTensorList(),
+        "ProcessGroup::allreduce should return TensorList");
+
+    auto reduce_tensor = result.toTensorVector()[0];
+    TORCH_INTERNAL_ASSERT_DEBUG_ONLY(
+        reduce_tensor.scalar_type() == at::ScalarType::BFloat16,
+        "Expected reduced tensor to be bf16 in BFloat16CompressHook, but got type ",
+        reduce_tensor.scalar_type());
+    decompressed_tensor.copy_(reduce_tensor);
+    return c10::IValue(decompressed_tensor);
+  };
+
+  return allreduce_fut->then(decompress, allreduce_fut->elementType());
+}
+
+namespace {
+
+// Applies Gram-Schmidt to orthogonalize the columns of a 2D matrix in
+// place. Same procedure as _orthogonalize_gram_schmidt in
+// torch/distributed/algorithms/ddp_comm_hooks/powerSGD_hook.py; the ranks
+// used here are small enough that QR would not pay off.
+void orthogonalize(at::Tensor& matrix) {
+  const auto num_cols = matrix.size(1);
+  for (const auto i : c10::irange(num_cols)) {
+    auto col = matrix.narrow(1, i, 1);
+    col.div_(col.norm());
+    if (i + 1 < num_cols) {
+      auto rest = matrix.narrow(1, i + 1, num_cols - (i + 1));
+      rest.sub_(col.matmul(col.t().matmul(rest)));
+    }
+  }
+}
+
+} // namespace
+
+c10::intrusive_ptr<c10::ivalue::Future> PowerSGDCommHook::runHook(
+    GradBucket& bucket) {
+  // Run vanilla allreduce in the first `start_powerSGD_iter_` iterations.
+  if (iter_ < start_powerSGD_iter_) {
+    if (bucket.isLast()) {
+      ++iter_;
+    }
+    std::vector<at::Tensor> tensors = {bucket.getBufferRef()};
+    tensors[0] /= state_->getSize();
+    return ops::allreduce(state_, tensors)->getFuture();
+  }
+
+  // The handle shares the bucket's storage, so the in-place updates below
+  // are visible to the reducer.
+  at::Tensor input = bucket.getBufferRef();
+  const int64_t total_length = input.numel();
+
+  // View the flattened bucket as a square matrix, padded with zeros.
+  const auto side = static_cast<int64_t>(
+      std::ceil(std::sqrt(static_cast<double>(total_length))));
+  const int64_t padded_total_length = side * side;
+  input.resize_({padded_total_length});
+  input.narrow(0, total_length, padded_total_length - total_length).zero_();
+
+  auto& bucket_state = bucket_states_[bucket.getIndex()];
+  if (!bucket_state.error.defined()) {
+    bucket_state.error = at::zeros({padded_total_length}, input.options());
+    bucket_state.p =
+        at::empty({side, matrix_approximation_rank_}, input.options());
+    // A seeded CPU generator makes the random initialization of Q identical
+    // across all replicas; the seed differs at every iteration.
+    auto gen = at::detail::createCPUGenerator(static_cast<uint64_t>(iter_));
+    bucket_state.q = at::randn(
+                         {side, matrix_approximation_rank_},
+                         gen,
+                         input.options().device(at::kCPU))
+                         .to(input.device());
+  }
+
+  // Incorporate the error feedback from the previous iteration, and keep a
+  // copy of the uncompressed input so the new local error can be computed
+  // after decompression.
+  input.add_(bucket_state.error);
+  at::Tensor input_cp = input.clone().detach();
+  at::Tensor matrix = input.view({side, side});
+
+  // M ~= P Q^T: compute P = M Q against the warm-started (orthogonalized) Q,
+  // allreduce P, then compute and allreduce Q = M^T P in the continuation.
+  orthogonalize(bucket_state.q);
+  at::matmul_out(bucket_state.p, matrix, bucket_state.q);
+
+  std::vector<at::Tensor> p_vec = {bucket_state.p};
+  auto allreduce_p_fut = ops::allreduce(state_, p_vec)->getFuture();
+
+  const bool is_last_bucket = bucket.isLast();
+  const auto world_size = state_->getSize();
+  auto compute_q_and_decompress = [this,
+                                   &bucket_state,
+                                   matrix,
+                                   input,
+                                   input_cp,
+                                   total_length,
+                                   world_size,
+                                   is_last_bucket](
+                                      c10::ivalue::Future& /* unused */) {
+    // The allreduce wrote its result into P in place.
+    orthogonalize(bucket_state.p);
+    at::matmul_out(bucket_state.q, matrix.t(), bucket_state.p);
+
+    std::vector<at::Tensor> q_vec = {bucket_state.q};
+    ops::allreduce(state_, q_vec)->wait();
+
+    // Decompress into the bucket buffer and memorize the local error.
+    bucket_state.q.div_(world_size);
+    at::matmul_out(matrix, bucket_state.p, bucket_state.q.t());
+    bucket_state.error = input_cp - input;
+
+    input.resize_({total_length});
+    if (is_last_bucket) {
+      ++iter_;
+    }
+    return c10::IValue(input);
+  };
+
+  return allreduce_p_fut->then(compute_q_and_decompress, c10::TensorType::get());
+}
+
+c10::intrusive_ptr<c10::ivalue::Future> SparseAllgatherCommHook::runHook(
+    GradBucket& bucket) {
+  const auto world_size = state_->getSize();
+  at::Tensor input = bucket.getBufferRef();
+
+  // Dense buckets run vanilla allreduce, same as AllReduceCommHook.
+  if (input.layout() != c10::kSparse) {
+    std::vector<at::Tensor> tensors = {input};
+    tensors[0] /= world_size;
+    return ops::allreduce(state_, tensors)->getFuture();
+  }
+
+  auto grad = input.coalesce();
+  const auto sparse_dim = grad.sparse_dim();
+  int64_t sparse_numel = 1;
+  for (const auto d : c10::irange(sparse_dim)) {
+    sparse_numel *= grad.size(d);
+  }
+  const double density = sparse_numel == 0
+      ? 1.0
+      : static_cast<double>(grad._nnz()) / static_cast<double>(sparse_numel);
+
+  // Near-dense gradients ship faster as one dense allreduce than as padded
+  // (indices, values) pairs.
+  if (density >= density_threshold_) {
+    auto dense = grad.to_dense().div_(world_size);
+    std::vector<at::Tensor> tensors = {dense};
+    auto allreduce_fut = ops::allreduce(state_, tensors)->getFuture();
+    auto to_sparse = [sparse_dim](c10::ivalue::Future& fut) {
+      auto result = fut.value();
+      TORCH_INTERNAL_ASSERT(
+          result.isTensorList(),
+          "ProcessGroup::allreduce should return TensorList");
+      return c10::IValue(result.toTensorVector()[0].to_sparse(sparse_dim));
+    };
+    return allreduce_fut->then(to_sparse, c10::TensorType::get());
+  }
+
+  // Negotiate the gather size: ranks have different nnz, and allgather
+  // needs equal shapes, so everyone pads to the largest nnz. The
+  // negotiation itself is a one-element allgather and is waited on
+  // inline, since the padded buffers cannot be allocated without it.
+  const auto nnz_options =
+      grad._indices().options().layout(c10::kStrided).dtype(at::kLong);
+  std::vector<std::vector<at::Tensor>> nnz_outputs(1);
+  for (C10_UNUSED const auto r : c10::irange(world_size)) {
+    nnz_outputs[0].push_back(at::empty({1}, nnz_options));
+  }
+  std::vector<at::Tensor> nnz_inputs = {
+      at::full({1}, grad._nnz(), nnz_options)};
+  ops::allgather(state_, nnz_outputs, nnz_inputs)->wait();
+  std::vector<int64_t> nnz_per_rank;
+  nnz_per_rank.reserve(world_size);
+  int64_t max_nnz = 0;
+  for (const auto r : c10::irange(world_size)) {
+    nnz_per_rank.push_back(nnz_outputs[0][r].item<int64_t>());
+    max_nnz = std::max(max_nnz, nnz_per_rank.back());
+  }
+
+  // Pad with zero values at index 0; the padding vanishes in the final
+  // coalesce, and the per-rank nnz is known anyway so padded tails are
+  // trimmed before concatenation.
+  auto indices = grad._indices();
+  auto values = grad._values();
+  auto padded_indices = at::zeros({sparse_dim, max_nnz}, indices.options());
+  padded_indices.narrow(1, 0, grad._nnz()).copy_(indices);
+  auto padded_value_sizes = values.sizes().vec();
+  padded_value_sizes[0] = max_nnz;
+  auto padded_values = at::zeros(padded_value_sizes, values.options());
+  padded_values.narrow(0, 0, grad._nnz()).copy_(values);
+
+  std::vector<std::vector<at::Tensor>> indices_outputs(1);
+  std::vector<std::vector<at::Tensor>> values_outputs(1);
+  for (C10_UNUSED const auto r : c10::irange(world_size)) {
+    indices_outputs[0].push_back(at::empty_like(padded_indices));
+    values_outputs[0].push_back(at::empty_like(padded_values));
+  }
+  std::vector<at::Tensor> indices_inputs = {padded_indices};
+  std::vector<at::Tensor> values_inputs = {padded_values};
+  auto indices_fut =
+      ops::allgather(state_, indices_outputs, indices_inputs)->getFuture();
+  auto values_fut =
+      ops::allgather(state_, values_outputs, values_inputs)->getFuture();
+
+  const auto sizes = grad.sizes().vec();
+  auto gathered_indices = indices_outputs[0];
+  auto gathered_values = values_outputs[0];
+  auto reduce = [gathered_indices,
+                 gathered_values,
+                 nnz_per_rank,
+                 sizes,
+                 world_size](c10::ivalue::Future& /* unused */) {
+    std::vector<at::Tensor> all_indices;
+    std::vector<at::Tensor> all_values;
+    for (const auto r : c10::irange(gathered_indices.size())) {
+      all_indices.push_back(gathered_indices[r].narrow(1, 0, nnz_per_rank[r]));
+      all_values.push_back(gathered_values[r].narrow(0, 0, nnz_per_rank[r]));
+    }
+    // coalesce() sums duplicate indices across ranks: this is the
+    // reduction.
+    auto summed = at::sparse_coo_tensor(
+                      at::cat(all_indices, 1), at::cat(all_values, 0), sizes)
+                      .coalesce()
+                      .div_(world_size);
+    return c10::IValue(summed);
+  };
+
+  c10::List<c10::intrusive_ptr<c10::ivalue::Future>> gathers(
+      c10::FutureType::create(c10::TensorType::get()));
+  gathers.push_back(indices_fut);
+  gathers.push_back(values_fut);
+  return c10::collectAll(gathers)->then(reduce, c10::TensorType::get());
+}
+
 c10::intrusive_ptr<c10::ivalue::Future> _AllReduceBySumCommHook::runHook(
     GradBucket& bucket) {
   std::vector<at::Tensor> tensors = {bucket.getBufferRef()};
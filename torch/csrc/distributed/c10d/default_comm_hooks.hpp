@@ -3,11 +3,16 @@
 #include <c10d/ProcessGroup.hpp>
 #include <c10d/comm.hpp>
 
+#include <unordered_map>
+
 namespace c10d {
 
 enum class BuiltinCommHookType {
   ALLREDUCE = 1,
   FP16_COMPRESS = 2,
+  BF16_COMPRESS = 3,
+  POWER_SGD = 4,
+  SPARSE_ALLGATHER = 5,
 };
 
 class AllReduceCommHook : public CppCommHookInterface<c10::intrusive_ptr<ProcessGroup>> {
@@ -30,6 +35,86 @@ class FP16CompressCommHook : public CppCommHookInterface<c10::intrusive_ptr<Proc
   c10::intrusive_ptr<c10::ivalue::Future> runHook(GradBucket& bucket) override;
 };
 
+// Same as FP16CompressCommHook, but communicates in bfloat16. BF16 keeps
+// FP32's exponent range, so unlike FP16 it does not need loss-scale style
+// precautions against overflow of large gradients.
+class BFloat16CompressCommHook : public CppCommHookInterface<c10::intrusive_ptr<ProcessGroup>> {
+ public:
+  explicit BFloat16CompressCommHook(const c10::intrusive_ptr<ProcessGroup>& state)
+      : CppCommHookInterface<c10::intrusive_ptr<ProcessGroup>>(state) {}
+
+  ~BFloat16CompressCommHook() override = default;
+
+  c10::intrusive_ptr<c10::ivalue::Future> runHook(GradBucket& bucket) override;
+};
+
+// C++ port of the batched PowerSGD hook in
+// torch/distributed/algorithms/ddp_comm_hooks/powerSGD_hook.py, which
+// compresses the flattened bucket buffer as one low-rank matrix
+// (https://arxiv.org/abs/1905.13727). Running the hook natively removes the
+// Python callback (and the GIL acquisition) from the allreduce critical
+// path. Per-bucket state (error feedback and the warm-started P/Q low-rank
+// factors) persists across iterations inside the hook itself.
+class TORCH_API PowerSGDCommHook : public CppCommHookInterface<c10::intrusive_ptr<ProcessGroup>> {
+ public:
+  explicit PowerSGDCommHook(
+      const c10::intrusive_ptr<ProcessGroup>& state,
+      int64_t matrix_approximation_rank = 1,
+      int64_t start_powerSGD_iter = 1000)
+      : CppCommHookInterface<c10::intrusive_ptr<ProcessGroup>>(state),
+        matrix_approximation_rank_(matrix_approximation_rank),
+        start_powerSGD_iter_(start_powerSGD_iter) {}
+
+  ~PowerSGDCommHook() override = default;
+
+  c10::intrusive_ptr<c10::ivalue::Future> runHook(GradBucket& bucket) override;
+
+ private:
+  struct BucketState {
+    // Local compression error, fed back into the next iteration's input.
+    at::Tensor error;
+    // Warm-started low-rank factors, M ~= P Q^T.
+    at::Tensor p;
+    at::Tensor q;
+  };
+
+  const int64_t matrix_approximation_rank_;
+  // Vanilla allreduce is used for the first `start_powerSGD_iter_`
+  // iterations, while gradients are still large and low-rank structure has
+  // not emerged yet.
+  const int64_t start_powerSGD_iter_;
+  int64_t iter_{0};
+  std::unordered_map<size_t, BucketState> bucket_states_;
+};
+
+// Sparse gradient transport for buckets that carry sparse gradients
+// (embedding backward). Allreducing a sparse gradient either densifies it
+// or requires backend sparse support, so a mostly-zero embedding gradient
+// is shipped at the full table size. This hook instead allgathers the
+// coalesced (indices, values) pairs — padded to the largest rank's nnz,
+// which is negotiated with a one-element allgather — and reduces them
+// locally with a coalesce, so traffic scales with nnz rather than with
+// the table. Gradients whose fraction of occupied sparse positions is at
+// or above `density_threshold` fall back to dense allreduce, where the
+// padding and duplicate-index overhead of the sparse path would exceed
+// the savings. Dense buckets run vanilla allreduce untouched.
+class TORCH_API SparseAllgatherCommHook
+    : public CppCommHookInterface<c10::intrusive_ptr<ProcessGroup>> {
+ public:
+  explicit SparseAllgatherCommHook(
+      const c10::intrusive_ptr<ProcessGroup>& state,
+      double density_threshold = 0.1)
+      : CppCommHookInterface<c10::intrusive_ptr<ProcessGroup>>(state),
+        density_threshold_(density_threshold) {}
+
+  ~SparseAllgatherCommHook() override = default;
+
+  c10::intrusive_ptr<c10::ivalue::Future> runHook(GradBucket& bucket) override;
+
+ private:
+  const double density_threshold_;
+};
+
 // Almost same as AllReduceCommHook, but without division inside the hook.
 // This enables the optimization of fusing copy and division and saves one scan
 // over all the input parameters, when no communication hook is provided by the user.
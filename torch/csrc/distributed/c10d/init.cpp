@@ -335,9 +335,13 @@ Replaces the tensor in the bucket with the input tensor buffer.
 )");
 
   py::enum_<::c10d::BuiltinCommHookType>(module, "BuiltinCommHookType", R"(
-An enum-like class for built-in communication hooks: ``ALLREDUCE`` and ``FP16_COMPRESS``.)")
+An enum-like class for built-in communication hooks: ``ALLREDUCE``, ``FP16_COMPRESS``, ``BF16_COMPRESS``, ``POWER_SGD`` and ``SPARSE_ALLGATHER``.)")
       .value("ALLREDUCE", ::c10d::BuiltinCommHookType::ALLREDUCE)
-      .value("FP16_COMPRESS", ::c10d::BuiltinCommHookType::FP16_COMPRESS);
+      .value("FP16_COMPRESS", ::c10d::BuiltinCommHookType::FP16_COMPRESS)
+      .value("BF16_COMPRESS", ::c10d::BuiltinCommHookType::BF16_COMPRESS)
+      .value("POWER_SGD", ::c10d::BuiltinCommHookType::POWER_SGD)
+      .value(
+          "SPARSE_ALLGATHER", ::c10d::BuiltinCommHookType::SPARSE_ALLGATHER);
 
   shared_ptr_class_<::c10d::Reducer>(module, "Reducer")
       .def(
@@ -406,6 +410,11 @@ An enum-like class for built-in communication hooks: ``ALLREDUCE`` and ``FP16_CO
           "_push_all_rebuilt_params",
           &::c10d::Reducer::push_rebuilt_params_for_all_indices,
           py::call_guard<py::gil_scoped_release>())
+      .def(
+          "_set_pinned_parameter_indices",
+          &::c10d::Reducer::set_pinned_parameter_indices,
+          py::arg("indices"),
+          py::call_guard<py::gil_scoped_release>())
       .def(
           "_set_forward_pass_work_handle",
           &::c10d::Reducer::set_forward_pass_work_handle,
@@ -962,7 +971,54 @@ Example::
       .def_property_readonly(
           "port",
           &::c10d::TCPStore::getPort,
-          R"(Gets the port number on which the store listens for requests.)");
+          R"(Gets the port number on which the store listens for requests.)")
+
+      // Convert from std::vector<uint8_t> to py::bytes.
+      // The returned values are not guaranteed to be valid UTF-8.
+      .def(
+          "multi_get",
+          [](::c10d::TCPStore& store, const std::vector<std::string>& keys) {
+            auto values = [&]() {
+              py::gil_scoped_release guard;
+              return store.multiGet(keys);
+            }();
+            std::vector<py::bytes> result;
+            result.reserve(values.size());
+            for (auto& value : values) {
+              result.emplace_back(
+                  reinterpret_cast<char*>(value.data()), value.size());
+            }
+            return result;
+          },
+          R"(
+Retrieves the values associated with all the given ``keys`` in a single round
+trip to the server. Like ``get``, waits until all the keys are set before
+returning.
+
+Arguments:
+    keys (List[str]): The keys whose values are returned, in order.
+)")
+      .def(
+          "multi_set",
+          [](::c10d::TCPStore& store,
+             const std::vector<std::string>& keys,
+             const std::vector<std::string>& values) {
+            std::vector<std::vector<uint8_t>> bytes;
+            bytes.reserve(values.size());
+            for (const std::string& value : values) {
+              bytes.emplace_back(value.begin(), value.end());
+            }
+            py::gil_scoped_release guard;
+            store.multiSet(keys, bytes);
+          },
+          R"(
+Inserts all the given key-value pairs into the store in a single round trip to
+the server.
+
+Arguments:
+    keys (List[str]): The keys to insert.
+    values (List[str]): The values to associate with the keys, in order.
+)");
 
   intrusive_ptr_class_<::c10d::PrefixStore>(
       module,
@@ -1353,6 +1409,10 @@ Arguments:
           .def(
               "_get_backend_name",
               &::c10d::ProcessGroup::getBackendName,
+              py::call_guard<py::gil_scoped_release>())
+          .def(
+              "flush",
+              &::c10d::ProcessGroup::flush,
               py::call_guard<py::gil_scoped_release>());
 
   // base ProcessGroup::Options binding
@@ -1396,7 +1456,10 @@ options :class:`~torch.distributed.ProcessGroupNCCL.Options`).
       processGroupGloo, "_Options", processGroupOptions)
       .def(py::init<>())
       .def_readwrite("_devices", &::c10d::ProcessGroupGloo::Options::devices)
-      .def_readwrite("_threads", &::c10d::ProcessGroupGloo::Options::threads);
+      .def_readwrite("_threads", &::c10d::ProcessGroupGloo::Options::threads)
+      .def_readwrite(
+          "_hierarchical_allreduce",
+          &::c10d::ProcessGroupGloo::Options::hierarchical_allreduce);
 
   processGroupGloo
       .def_static(
@@ -1450,6 +1513,14 @@ options :class:`~torch.distributed.ProcessGroupNCCL.Options`).
                   ::c10d::ProcessGroupGloo::createDefaultDevice());
             }
 
+            // Use hierarchical allreduce if "GLOO_HIERARCHICAL_ALLREDUCE"
+            // is set. See Note [Hierarchical allreduce] in
+            // ProcessGroupGloo.cpp.
+            char* hierEnv = getenv("GLOO_HIERARCHICAL_ALLREDUCE");
+            if (hierEnv && strlen(hierEnv) > 0 && strcmp(hierEnv, "0") != 0) {
+              options->hierarchical_allreduce = true;
+            }
+
             options->timeout = timeout;
             // NOLINTNEXTLINE(bugprone-narrowing-conversions,cppcoreguidelines-narrowing-conversions)
             options->threads = options->devices.size() * 2;
@@ -1513,7 +1584,26 @@ options :class:`~torch.distributed.ProcessGroupNCCL.Options`).
           .def_property_readonly(
               "options", &::c10d::ProcessGroupNCCL::getOptions)
           .def_property_readonly(
-              "is_ucc_available", &::c10d::ProcessGroupNCCL::isUCCAvailable);
+              "is_ucc_available", &::c10d::ProcessGroupNCCL::isUCCAvailable)
+          .def(
+              "_warmup_comms",
+              [](::c10d::ProcessGroupNCCL& self,
+                 const std::vector<std::vector<int64_t>>& deviceLists) {
+                std::vector<std::vector<at::Device>> lists;
+                lists.reserve(deviceLists.size());
+                for (const auto& ids : deviceLists) {
+                  std::vector<at::Device> devices;
+                  devices.reserve(ids.size());
+                  for (const auto id : ids) {
+                    devices.emplace_back(
+                        at::DeviceType::CUDA, static_cast<c10::DeviceIndex>(id));
+                  }
+                  lists.push_back(std::move(devices));
+                }
+                self.warmupComms(lists);
+              },
+              py::arg("device_lists"),
+              py::call_guard<py::gil_scoped_release>());
 
   intrusive_ptr_class_<::c10d::ProcessGroupNCCL::Options>(
       processGroupNCCL,
@@ -1538,7 +1628,13 @@ Example::
       .def(py::init<bool>(), py::arg("is_high_priority_stream") = false)
       .def_readwrite(
           "is_high_priority_stream",
-          &::c10d::ProcessGroupNCCL::Options::is_high_priority_stream);
+          &::c10d::ProcessGroupNCCL::Options::is_high_priority_stream)
+      .def_readwrite(
+          "warmup_device_ids",
+          &::c10d::ProcessGroupNCCL::Options::warmup_device_ids)
+      .def_readwrite(
+          "comm_pool_key",
+          &::c10d::ProcessGroupNCCL::Options::comm_pool_key);
   processGroupNCCL.def_static(
       "_group_start", []() { ::c10d::ProcessGroupNCCL::groupStart(); });
   processGroupNCCL.def_static(
@@ -122,10 +122,14 @@ Reducer::Reducer(
   TORCH_INTERNAL_ASSERT(
       params_.size() >= 1, "Expected at least one parameter.");
 
+  adaptive_bucketing_ =
+      (parse_env("DDP_ADAPTIVE_BUCKETING").compare("1") == 0);
+
   if (ddp_debug_level_ != c10d::DebugLevel::Off) {
     LOG(INFO) << "Reducer initialized with bucket_bytes_cap: "
               << bucket_bytes_cap_
-              << " first_bucket_bytes_cap: " << first_bucket_bytes_cap;
+              << " first_bucket_bytes_cap: " << first_bucket_bytes_cap
+              << " adaptive_bucketing: " << adaptive_bucketing_;
   }
   // Check whether the module is multi_device_module
   {
@@ -1463,6 +1467,11 @@ void Reducer::finalize_backward() {
   TORCH_INTERNAL_ASSERT(require_finalize_);
   require_finalize_ = false;
 
+  // All gradients have been computed at this point; any time spent below
+  // waiting on bucket futures is communication that was not overlapped with
+  // backward compute. See Note [DDP adaptive bucketing].
+  const int64_t backward_compute_end_time = current_time_in_nanos();
+
   // Wait for asynchronous reduction to complete, and unflatten the bucket's
   // flattened `gradients` tensor.
   for (auto& bucket : buckets_) {
@@ -1495,6 +1504,12 @@ void Reducer::finalize_backward() {
     }
   }
 
+  if (C10_UNLIKELY(adaptive_bucketing_)) {
+    record_adaptive_bucketing_stats(
+        current_time_in_nanos() - backward_compute_end_time,
+        backward_compute_end_time - backward_compute_start_time_);
+  }
+
   if (installed_futures_ != c10::nullopt) {
     c10::collectAll(*installed_futures_)->wait();
     installed_futures_ = c10::nullopt;
@@ -1629,6 +1644,171 @@ void Reducer::sync_bucket_indices(
   }
 }
 
+// Note [DDP adaptive bucketing]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Buckets are normally rebuilt once, in gradient-ready order, with fixed byte
+// caps. On models with heterogeneous layer costs the trailing bucket can
+// regularly finish its allreduce well after the last gradient is computed,
+// stalling the optimizer step. When DDP_ADAPTIVE_BUCKETING=1, after the
+// regular rebuild the reducer samples a few iterations, measuring how long
+// finalize_backward blocks on bucket futures (communication exposed past the
+// end of backward compute) relative to total backward time. If the exposed
+// tail is significant, buckets are re-split one more time in the latest
+// gradient-ready order with the small first_bucket_bytes_cap also applied to
+// the final bucket, so the last allreduce is both shorter and launched
+// earlier. The timings differ across ranks but the re-split ends in a
+// collective, so the decision itself is agreed on with an allreduce first.
+// Pinned parameters (set_pinned_parameter_indices) are moved to the front of
+// the ready order on every rebuild, landing them in the earliest buckets.
+
+namespace {
+// Iterations sampled after the regular rebuild before deciding whether the
+// trailing allreduce is worth re-splitting.
+constexpr int64_t kAdaptiveBucketingSampleIters = 10;
+// Re-split when more than 1/20th (5%) of backward wall time was spent
+// blocked on communication after the last gradient was computed.
+constexpr int64_t kAdaptiveBucketingExposedFraction = 20;
+} // namespace
+
+void Reducer::set_pinned_parameter_indices(std::vector<size_t> indices) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const auto index : indices) {
+    REDUCER_CHECK(
+        index < params_.size(),
+        logger_,
+        c10::str(
+            "Pinned parameter index ",
+            index,
+            " is out of range for ",
+            params_.size(),
+            " parameters."));
+  }
+  pinned_param_indices_ = std::move(indices);
+}
+
+void Reducer::apply_param_pinning(
+    std::vector<at::Tensor>& params,
+    std::vector<int64_t>& indices) {
+  if (pinned_param_indices_.empty()) {
+    return;
+  }
+  std::unordered_map<int64_t, size_t> position_of_index;
+  for (const auto pos : c10::irange(indices.size())) {
+    position_of_index.emplace(indices[pos], pos);
+  }
+  std::vector<at::Tensor> reordered_params;
+  std::vector<int64_t> reordered_indices;
+  reordered_params.reserve(params.size());
+  reordered_indices.reserve(indices.size());
+  std::unordered_set<int64_t> pinned;
+  for (const auto pinned_index : pinned_param_indices_) {
+    auto it = position_of_index.find(pinned_index);
+    if (it == position_of_index.end()) {
+      continue;
+    }
+    reordered_params.push_back(params[it->second]);
+    reordered_indices.push_back(indices[it->second]);
+    pinned.insert((int64_t)pinned_index);
+  }
+  for (const auto pos : c10::irange(indices.size())) {
+    if (pinned.count(indices[pos]) == 0) {
+      reordered_params.push_back(params[pos]);
+      reordered_indices.push_back(indices[pos]);
+    }
+  }
+  params = std::move(reordered_params);
+  indices = std::move(reordered_indices);
+}
+
+void Reducer::record_adaptive_bucketing_stats(
+    int64_t exposed_ns,
+    int64_t backward_ns) {
+  if (!has_rebuilt_bucket_ || adaptive_bucketing_done_ ||
+      buckets_.size() < 2) {
+    return;
+  }
+  // Only sample iterations where every gradient was produced, so the ready
+  // order snapshot below covers all parameters.
+  if (grad_ready_order_indices_.size() != params_.size()) {
+    return;
+  }
+  adaptive_exposed_time_total_ += exposed_ns;
+  adaptive_backward_time_total_ += backward_ns;
+  if (++adaptive_iterations_ < kAdaptiveBucketingSampleIters) {
+    return;
+  }
+  adaptive_bucketing_done_ = true;
+  const bool exposed_locally = adaptive_exposed_time_total_ *
+          kAdaptiveBucketingExposedFraction >
+      adaptive_backward_time_total_;
+  // The re-split ends in a collective (sync_bucket_indices), so all ranks
+  // must make the same decision even though their timings differ; any rank
+  // that measured an exposed tail wins. This runs exactly once, at the same
+  // iteration on every rank.
+  at::TensorOptions options;
+  options = options.dtype(at::kInt).device(params_[0].device());
+  auto decision_tensor =
+      at::full({1}, exposed_locally ? 1 : 0, options);
+  std::vector<at::Tensor> decision_vec = {decision_tensor};
+  ops::allreduce(process_group_, decision_vec)->wait();
+  if (decision_tensor.item<int>() == 0) {
+    return;
+  }
+  adaptive_rebuild_pending_ = true;
+  adaptive_ready_order_.assign(
+      grad_ready_order_indices_.begin(), grad_ready_order_indices_.end());
+  if (ddp_debug_level_ != c10d::DebugLevel::Off) {
+    LOG(INFO) << "Allreduce exposed past backward compute for "
+              << adaptive_exposed_time_total_ / kAdaptiveBucketingSampleIters
+              << " ns per iteration on average; buckets will be re-split.";
+  }
+}
+
+bool Reducer::adaptive_rebuild_buckets() {
+  adaptive_rebuild_pending_ = false;
+
+  std::vector<at::Tensor> ordered_params;
+  std::vector<int64_t> ordered_indices;
+  ordered_params.reserve(adaptive_ready_order_.size());
+  ordered_indices.reserve(adaptive_ready_order_.size());
+  for (const auto index : adaptive_ready_order_) {
+    ordered_params.push_back(params_[index]);
+    ordered_indices.push_back(index);
+  }
+  adaptive_ready_order_.clear();
+  apply_param_pinning(ordered_params, ordered_indices);
+
+  // Apply first_bucket_bytes_cap_ to the final bucket as well, by assigning
+  // buckets over the reversed order (see the DDP_SET_LAST_BUCKET_CAP comment
+  // in rebuild_buckets() for why the order has to be reversed rather than
+  // passing a longer list of size limits).
+  std::reverse(ordered_params.begin(), ordered_params.end());
+  std::reverse(ordered_indices.begin(), ordered_indices.end());
+  std::vector<size_t> bucket_size_limits = {
+      (size_t)first_bucket_bytes_cap_, (size_t)bucket_bytes_cap_};
+  std::vector<std::vector<size_t>> rebuilt_bucket_indices;
+  std::vector<size_t> per_bucket_size_limits;
+  std::tie(rebuilt_bucket_indices, per_bucket_size_limits) =
+      compute_bucket_assignment_by_size(
+          ordered_params,
+          bucket_size_limits,
+          expect_sparse_gradients_,
+          ordered_indices,
+          logger_);
+  std::reverse(rebuilt_bucket_indices.begin(), rebuilt_bucket_indices.end());
+  std::reverse(per_bucket_size_limits.begin(), per_bucket_size_limits.end());
+
+  if (ddp_debug_level_ != c10d::DebugLevel::Off) {
+    LOG(INFO) << rebuilt_bucket_indices.size()
+              << " buckets re-split adaptively with size limits: "
+              << c10::Join(", ", per_bucket_size_limits) << " bytes.";
+  }
+
+  sync_bucket_indices(rebuilt_bucket_indices);
+  initialize_buckets(std::move(rebuilt_bucket_indices));
+  return true;
+}
+
 bool Reducer::rebuild_buckets() {
   // Ensure reduction for previous backwards pass is finished. If user's model
   // has unused parameters for example, this will raise an error recommending to
@@ -1636,6 +1816,10 @@ bool Reducer::rebuild_buckets() {
   // exception below.
   std::lock_guard<std::mutex> lock(mutex_);
   ensure_prior_reduction_finished();
+  if (C10_UNLIKELY(adaptive_rebuild_pending_)) {
+    // See Note [DDP adaptive bucketing].
+    return adaptive_rebuild_buckets();
+  }
   if (!should_rebuild_buckets() || rebuilt_params_.empty()) {
     return false;
   }
@@ -1655,6 +1839,7 @@ bool Reducer::rebuild_buckets() {
           params_.size(),
           " versus rebuilt params size of: ",
           rebuilt_param_indices_.size()));
+  apply_param_pinning(rebuilt_params_, rebuilt_param_indices_);
   std::vector<std::vector<size_t>> rebuilt_bucket_indices;
   std::vector<size_t> bucket_size_limits;
   bucket_size_limits.push_back(first_bucket_bytes_cap_);
@@ -1736,6 +1921,21 @@ void Reducer::register_builtin_comm_hook(
       comm_hook_ = std::make_unique<c10d::FP16CompressCommHook>(process_group_);
       LOG(INFO) << "Built-in communication hook FP16_COMPRESS is registered.";
       break;
+    case c10d::BuiltinCommHookType::BF16_COMPRESS:
+      comm_hook_ =
+          std::make_unique<c10d::BFloat16CompressCommHook>(process_group_);
+      LOG(INFO) << "Built-in communication hook BF16_COMPRESS is registered.";
+      break;
+    case c10d::BuiltinCommHookType::POWER_SGD:
+      comm_hook_ = std::make_unique<c10d::PowerSGDCommHook>(process_group_);
+      LOG(INFO) << "Built-in communication hook POWER_SGD is registered.";
+      break;
+    case c10d::BuiltinCommHookType::SPARSE_ALLGATHER:
+      comm_hook_ =
+          std::make_unique<c10d::SparseAllgatherCommHook>(process_group_);
+      LOG(INFO)
+          << "Built-in communication hook SPARSE_ALLGATHER is registered.";
+      break;
     default:
       TORCH_WARN_ONCE(
           "Unknown built-in DDP comm hook type is provided. No comm hook will be used.");
@@ -164,6 +164,12 @@ class TORCH_API Reducer {
   // current iteration, which means unused params set has not changed.
   bool ddp_graph_static();
 
+  // Pins the given parameter indices to the front of the bucket order the
+  // next time buckets are rebuilt, ahead of the measured gradient-ready
+  // order, so their gradients are communicated as early as possible. Indices
+  // refer to positions in the `params` list passed to the constructor.
+  void set_pinned_parameter_indices(std::vector<size_t> indices);
+
  protected:
   // Forward declaration.
   struct Bucket;
@@ -494,6 +500,33 @@ class TORCH_API Reducer {
   std::vector<int> grad_ready_order_indices_;
   // Bytes capacity of first bucket, can be configured by user
   int64_t first_bucket_bytes_cap_;
+
+  // See Note [DDP adaptive bucketing]
+  void record_adaptive_bucketing_stats(int64_t exposed_ns, int64_t backward_ns);
+  bool adaptive_rebuild_buckets();
+  // Reorders (params, indices) in place so pinned parameters come first.
+  void apply_param_pinning(
+      std::vector<at::Tensor>& params,
+      std::vector<int64_t>& indices);
+
+  // Whether DDP_ADAPTIVE_BUCKETING=1; see Note [DDP adaptive bucketing].
+  bool adaptive_bucketing_ = false;
+  // Number of iterations sampled since the regular bucket rebuild.
+  int64_t adaptive_iterations_ = 0;
+  // Accumulated time (nanos) spent blocked on allreduce after the backward
+  // compute finished, and accumulated total backward time, over the sampled
+  // iterations.
+  int64_t adaptive_exposed_time_total_ = 0;
+  int64_t adaptive_backward_time_total_ = 0;
+  // Set once all ranks agreed to re-split; consumed by rebuild_buckets().
+  bool adaptive_rebuild_pending_ = false;
+  // Set once the adaptive decision has been made (either way) so we stop
+  // sampling and never re-split more than once.
+  bool adaptive_bucketing_done_ = false;
+  // Gradient ready order snapshotted at decision time.
+  std::vector<int64_t> adaptive_ready_order_;
+  // Parameter indices pinned to the earliest buckets, in user-given order.
+  std::vector<size_t> pinned_param_indices_;
   // Per iteration set of parameter indices that have been marked ready.
   std::unordered_set<size_t> perIterationReadyParams_;
   // Retrieves parameter names that have not been marked as ready as part of
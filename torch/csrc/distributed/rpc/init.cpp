@@ -5,6 +5,7 @@
 #include <torch/csrc/distributed/rpc/py_rref.h>
 #include <torch/csrc/distributed/rpc/python_functions.h>
 #include <torch/csrc/distributed/rpc/python_rpc_handler.h>
+#include <torch/csrc/distributed/rpc/remote_storage.h>
 #include <torch/csrc/distributed/rpc/request_callback_impl.h>
 #include <torch/csrc/distributed/rpc/rpc_agent.h>
 #include <torch/csrc/distributed/rpc/rref_context.h>
@@ -697,6 +698,49 @@ PyObject* rpc_init(PyObject* _unused, PyObject* noargs) {
     return RRefContext::getInstance().getDebugInfo();
   });
 
+  // Lazy remote tensor handles. See Note [Lazy remote tensors] in
+  // remote_storage.h. Handles cross the wire as (owner worker id, local id)
+  // pairs; payload bytes move only on the first _remote_storage_materialize
+  // call, which fetches all handles announced for the same owner in one
+  // round trip.
+  module.def(
+      "_remote_storage_register",
+      [](const torch::Tensor& tensor) {
+        auto storageId =
+            RemoteStorageContext::getInstance().registerOwnerTensor(tensor);
+        return std::make_pair(
+            static_cast<int64_t>(storageId.createdOn_), storageId.localId_);
+      },
+      py::call_guard<py::gil_scoped_release>());
+
+  module.def(
+      "_remote_storage_announce",
+      [](int64_t ownerId, int64_t localId) {
+        RemoteStorageContext::getInstance().announce(
+            StorageId(static_cast<worker_id_t>(ownerId), localId));
+      },
+      py::call_guard<py::gil_scoped_release>());
+
+  module.def(
+      "_remote_storage_materialize",
+      [](int64_t ownerId, int64_t localId) {
+        return RemoteStorageContext::getInstance().materialize(
+            StorageId(static_cast<worker_id_t>(ownerId), localId));
+      },
+      py::call_guard<py::gil_scoped_release>());
+
+  module.def(
+      "_remote_storage_delete",
+      [](int64_t ownerId, int64_t localId) {
+        RemoteStorageContext::getInstance().delOwnerTensor(
+            StorageId(static_cast<worker_id_t>(ownerId), localId));
+      },
+      py::call_guard<py::gil_scoped_release>());
+
+  module.def("_remote_storage_get_debug_info", []() {
+    return RemoteStorageContext::getInstance().getDebugInfo();
+  });
+
   module.def(
       "_cleanup_python_rpc_handler",
       []() { PythonRpcHandler::getInstance().cleanup(); },
@@ -84,6 +84,12 @@ enum MessageType {
   RREF_BACKWARD_REQ = 0x17 | MessageTypeFlags::REQUEST_TYPE,
   RREF_BACKWARD_RESP = 0x18 | MessageTypeFlags::RESPONSE_TYPE,
 
+  // Messages to support lazy remote tensors. A user fetches the payloads of
+  // a batch of storage handles from the owner on first data access. See
+  // Note [Lazy remote tensors] in remote_storage.h.
+  STORAGE_FETCH_CALL = 0x19 | MessageTypeFlags::REQUEST_TYPE,
+  STORAGE_FETCH_RET = 0x1a | MessageTypeFlags::RESPONSE_TYPE,
+
   // Other internal message types
   EXCEPTION = 0x37 | MessageTypeFlags::RESPONSE_TYPE,
   UNKNOWN = 0x3c
@@ -0,0 +1,214 @@
+#include <torch/csrc/distributed/rpc/remote_storage.h>
+#include <torch/csrc/distributed/rpc/rpc_agent.h>
+#include <torch/csrc/jit/serialization/pickle.h>
+
+#include <c10/util/irange.h>
+
+#include <algorithm>
+
+namespace torch {
+namespace distributed {
+namespace rpc {
+
+namespace {
+
+c10::ivalue::TupleElements toIValues(const Message& message, MessageType type) {
+  TORCH_INTERNAL_ASSERT(
+      type == message.type(),
+      "Expecting message of type ",
+      type,
+      ", but got ",
+      message.type());
+  auto payload = static_cast<const char*>(message.payload().data());
+  auto payload_size = message.payload().size();
+
+  auto value = jit::unpickle(
+      payload,
+      payload_size,
+      *RpcAgent::getCurrentRpcAgent()->getTypeResolver(),
+      message.tensors());
+  return std::move(*std::move(value).toTuple()).elements();
+}
+
+c10::intrusive_ptr<Message> fromIValues(
+    std::vector<IValue> ivalues,
+    MessageType type) {
+  std::vector<torch::Tensor> tensor_table;
+  auto payload = jit::pickle(
+      c10::ivalue::Tuple::create(std::move(ivalues)), &tensor_table);
+  return c10::make_intrusive<Message>(
+      std::move(payload), std::move(tensor_table), type);
+}
+
+} // namespace
+
+////////////////////////// Storage Fetch Protocol ////////////////////////////
+
+const std::vector<StorageId>& StorageFetchCall::storageIds() const {
+  return storageIds_;
+}
+
+c10::intrusive_ptr<Message> StorageFetchCall::toMessageImpl() && {
+  std::vector<at::IValue> ivalues;
+  ivalues.reserve(storageIds_.size());
+  for (const auto& storageId : storageIds_) {
+    ivalues.emplace_back(storageId.toIValue());
+  }
+  return fromIValues(std::move(ivalues), MessageType::STORAGE_FETCH_CALL);
+}
+
+std::unique_ptr<StorageFetchCall> StorageFetchCall::fromMessage(
+    const Message& message) {
+  auto values = toIValues(message, MessageType::STORAGE_FETCH_CALL);
+  std::vector<StorageId> storageIds;
+  storageIds.reserve(values.size());
+  for (auto& value : values) {
+    storageIds.emplace_back(StorageId::fromIValue(value));
+  }
+  return std::make_unique<StorageFetchCall>(std::move(storageIds));
+}
+
+const std::vector<at::Tensor>& StorageFetchRet::tensors() const {
+  return tensors_;
+}
+
+c10::intrusive_ptr<Message> StorageFetchRet::toMessageImpl() && {
+  std::vector<at::IValue> ivalues;
+  ivalues.reserve(tensors_.size());
+  for (auto& tensor : tensors_) {
+    ivalues.emplace_back(std::move(tensor));
+  }
+  return fromIValues(std::move(ivalues), MessageType::STORAGE_FETCH_RET);
+}
+
+std::unique_ptr<StorageFetchRet> StorageFetchRet::fromMessage(
+    const Message& message) {
+  auto values = toIValues(message, MessageType::STORAGE_FETCH_RET);
+  std::vector<at::Tensor> tensors;
+  tensors.reserve(values.size());
+  for (auto& value : values) {
+    tensors.emplace_back(std::move(value).toTensor());
+  }
+  return std::make_unique<StorageFetchRet>(std::move(tensors));
+}
+
+////////////////////////// RemoteStorageContext //////////////////////////////
+
+RemoteStorageContext& RemoteStorageContext::getInstance() {
+  // Leaky singleton to avoid module destructor race, as RRefContext does.
+  static RemoteStorageContext* context = new RemoteStorageContext();
+  return *context;
+}
+
+StorageId RemoteStorageContext::registerOwnerTensor(at::Tensor tensor) {
+  auto workerId = RpcAgent::getCurrentRpcAgent()->getWorkerInfo().id_;
+  StorageId storageId(workerId, nextLocalId_++);
+  std::lock_guard<std::mutex> lock(mutex_);
+  ownerTensors_.emplace(storageId, std::move(tensor));
+  return storageId;
+}
+
+std::vector<at::Tensor> RemoteStorageContext::ownerTensors(
+    const std::vector<StorageId>& ids) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<at::Tensor> tensors;
+  tensors.reserve(ids.size());
+  for (const auto& id : ids) {
+    auto iter = ownerTensors_.find(id);
+    TORCH_CHECK(
+        iter != ownerTensors_.end(),
+        "Could not find storage ",
+        id,
+        " on owner; it was never registered or has already been dropped.");
+    tensors.emplace_back(iter->second);
+  }
+  return tensors;
+}
+
+void RemoteStorageContext::delOwnerTensor(const StorageId& id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ownerTensors_.erase(id);
+}
+
+void RemoteStorageContext::announce(const StorageId& id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (fetched_.find(id) != fetched_.end()) {
+    return;
+  }
+  if (std::find(announced_.begin(), announced_.end(), id) ==
+      announced_.end()) {
+    announced_.emplace_back(id);
+  }
+}
+
+at::Tensor RemoteStorageContext::materialize(const StorageId& id) {
+  std::vector<StorageId> batch;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = fetched_.find(id);
+    if (iter != fetched_.end()) {
+      return iter->second;
+    }
+    // Fetch every handle announced for this owner in the same round trip.
+    // GloballyUniqueId is not assignable, so the announced list is rebuilt
+    // rather than compacted in place.
+    batch.reserve(announced_.size() + 1);
+    batch.emplace_back(id);
+    std::vector<StorageId> remaining;
+    remaining.reserve(announced_.size());
+    for (const auto& other : announced_) {
+      if (other.createdOn_ == id.createdOn_) {
+        if (other != id) {
+          batch.emplace_back(other);
+        }
+      } else {
+        remaining.emplace_back(other);
+      }
+    }
+    announced_ = std::move(remaining);
+  }
+
+  auto agent = RpcAgent::getCurrentRpcAgent();
+  auto jitFuture = agent->send(
+      agent->getWorkerInfo(id.createdOn_),
+      StorageFetchCall(batch).toMessage());
+  jitFuture->waitAndThrow();
+
+  auto msgPtr = jitFuture->constValue().toCustomClass<Message>();
+  MessageType msgType = msgPtr->type();
+  TORCH_INTERNAL_ASSERT(
+      msgType == MessageType::STORAGE_FETCH_RET,
+      "Expecting response of type ",
+      MessageType::STORAGE_FETCH_RET,
+      ", but got ",
+      msgType);
+  auto ret = StorageFetchRet::fromMessage(*msgPtr);
+  const auto& tensors = ret->tensors();
+  TORCH_INTERNAL_ASSERT(
+      tensors.size() == batch.size(),
+      "Storage fetch returned ",
+      tensors.size(),
+      " tensors for ",
+      batch.size(),
+      " requested handles.");
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const auto i : c10::irange(batch.size())) {
+    fetched_.emplace(batch[i], tensors[i]);
+  }
+  return fetched_.find(id)->second;
+}
+
+std::unordered_map<std::string, std::string> RemoteStorageContext::
+    getDebugInfo() {
+  std::unordered_map<std::string, std::string> info;
+  std::lock_guard<std::mutex> lock(mutex_);
+  info["num_owner_tensors"] = c10::to_string(ownerTensors_.size());
+  info["num_announced_handles"] = c10::to_string(announced_.size());
+  info["num_fetched_tensors"] = c10::to_string(fetched_.size());
+  return info;
+}
+
+} // namespace rpc
+} // namespace distributed
+} // namespace torch
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <torch/csrc/distributed/rpc/message.h>
+#include <torch/csrc/distributed/rpc/rpc_command_base.h>
+#include <torch/csrc/distributed/rpc/types.h>
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace torch {
+namespace distributed {
+namespace rpc {
+
+// Note [Lazy remote tensors]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+// RPC serialization ships full tensor payloads with every message, even when
+// the callee only inspects metadata or forwards the tensor to a third worker.
+// For parameter-server style traffic this moves the same bytes many times.
+//
+// The remote storage protocol lets an application pass a small handle
+// instead: the owner pins a tensor in RemoteStorageContext under a
+// GloballyUniqueId (owner worker id + local id, the same id scheme RRefs
+// use) and ships only the id. The payload moves when a user first asks for
+// the data, and is cached on the user so it moves at most once per worker.
+// Handles that were announced to a user before that first access are fetched
+// together in a single STORAGE_FETCH_CALL, so N pending parameters cost one
+// round trip instead of N.
+//
+// The handles themselves are plain ids and carry no lifetime information;
+// unlike RRefs, the owner keeps a tensor pinned until delOwnerTensor() is
+// called. This matches the parameter-server use case, where the owner knows
+// when a version of the parameters is retired.
+
+using StorageId = GloballyUniqueId;
+
+// A user asks the owner for the payloads of a batch of pinned tensors.
+class TORCH_API StorageFetchCall final : public RpcCommandBase {
+ public:
+  explicit StorageFetchCall(std::vector<StorageId> storageIds)
+      : storageIds_(std::move(storageIds)) {}
+
+  const std::vector<StorageId>& storageIds() const;
+
+  c10::intrusive_ptr<Message> toMessageImpl() && override;
+  static std::unique_ptr<StorageFetchCall> fromMessage(const Message& message);
+
+ private:
+  std::vector<StorageId> storageIds_;
+};
+
+// The owner returns the payloads in the order the ids were requested.
+class TORCH_API StorageFetchRet final : public RpcCommandBase {
+ public:
+  explicit StorageFetchRet(std::vector<at::Tensor> tensors)
+      : tensors_(std::move(tensors)) {}
+
+  const std::vector<at::Tensor>& tensors() const;
+
+  c10::intrusive_ptr<Message> toMessageImpl() && override;
+  static std::unique_ptr<StorageFetchRet> fromMessage(const Message& message);
+
+ private:
+  std::vector<at::Tensor> tensors_;
+};
+
+// Singleton bookkeeping for both ends of the protocol. The owner side pins
+// tensors until they are explicitly dropped; the user side records announced
+// handles and caches fetched payloads. See Note [Lazy remote tensors].
+class TORCH_API RemoteStorageContext {
+ public:
+  static RemoteStorageContext& getInstance();
+
+  RemoteStorageContext(const RemoteStorageContext&) = delete;
+  RemoteStorageContext(RemoteStorageContext&& other) = delete;
+  RemoteStorageContext& operator=(const RemoteStorageContext& other) = delete;
+  RemoteStorageContext& operator=(RemoteStorageContext&& other) = delete;
+
+  // Owner side: pin ``tensor`` and mint the id users fetch it by.
+  StorageId registerOwnerTensor(at::Tensor tensor);
+  // Owner side: look up a fetch batch. Throws on unknown ids, e.g. when a
+  // user materializes a handle the owner has already dropped.
+  std::vector<at::Tensor> ownerTensors(const std::vector<StorageId>& ids) const;
+  // Owner side: unpin. Payloads already cached on users are unaffected.
+  void delOwnerTensor(const StorageId& id);
+
+  // User side: record a handle received in some RPC without fetching it.
+  void announce(const StorageId& id);
+  // User side: return the payload for ``id``, transferring it on first
+  // access. Every other handle announced for the same owner rides along in
+  // the same fetch. Blocks on the network and throws on RPC errors.
+  at::Tensor materialize(const StorageId& id);
+
+  std::unordered_map<std::string, std::string> getDebugInfo();
+
+ private:
+  RemoteStorageContext() = default;
+
+  mutable std::mutex mutex_;
+  std::atomic<local_id_t> nextLocalId_{0};
+  std::unordered_map<StorageId, at::Tensor, StorageId::Hash> ownerTensors_;
+  // Announced-but-not-yet-fetched handles, in announcement order.
+  std::vector<StorageId> announced_;
+  std::unordered_map<StorageId, at::Tensor, StorageId::Hash> fetched_;
+};
+
+} // namespace rpc
+} // namespace distributed
+} // namespace torch
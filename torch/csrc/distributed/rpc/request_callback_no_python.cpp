@@ -10,6 +10,7 @@
 #include <torch/csrc/distributed/autograd/rpc_messages/rpc_with_autograd.h>
 #include <torch/csrc/distributed/autograd/utils.h>
 #include <torch/csrc/distributed/rpc/profiler/server_process_global_profiler.h>
+#include <torch/csrc/distributed/rpc/remote_storage.h>
 #include <torch/csrc/distributed/rpc/rpc_agent.h>
 #include <torch/csrc/distributed/rpc/rref_context.h>
 #include <torch/csrc/distributed/rpc/rref_proto.h>
@@ -252,6 +253,14 @@ c10::intrusive_ptr<JitFuture> RequestCallbackNoPython::
   C10_THROW_ERROR(Error, "Python call not supported!");
 }
 
+c10::intrusive_ptr<JitFuture> RequestCallbackNoPython::processStorageFetchCall(
+    RpcCommandBase& rpc) const {
+  auto& sfc = static_cast<StorageFetchCall&>(rpc);
+  auto tensors =
+      RemoteStorageContext::getInstance().ownerTensors(sfc.storageIds());
+  return asFuture(StorageFetchRet(std::move(tensors)).toMessage());
+}
+
 c10::intrusive_ptr<JitFuture> RequestCallbackNoPython::processRRefUserDelete(
     RpcCommandBase& rpc) const {
   auto& rud = static_cast<RRefUserDelete&>(rpc);
@@ -545,6 +554,9 @@ c10::intrusive_ptr<JitFuture> RequestCallbackNoPython::processRpc(
     case MessageType::RREF_BACKWARD_REQ: {
       return processRRefBackward(rpc);
     }
+    case MessageType::STORAGE_FETCH_CALL: {
+      return processStorageFetchCall(rpc);
+    }
     default: {
       TORCH_INTERNAL_ASSERT(
           false, "Request type ", messageType, " not supported.");
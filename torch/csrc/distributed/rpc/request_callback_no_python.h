@@ -52,6 +52,9 @@ class TORCH_API RequestCallbackNoPython : public RequestCallback {
   virtual c10::intrusive_ptr<JitFuture> processPythonRRefFetchCall(
       RpcCommandBase& rpc) const;
 
+  c10::intrusive_ptr<JitFuture> processStorageFetchCall(
+      RpcCommandBase& rpc) const;
+
   c10::intrusive_ptr<JitFuture> processRRefUserDelete(
       RpcCommandBase& rpc) const;
 
@@ -240,12 +240,17 @@ std::pair<tensorpipe::Allocation, TensorpipeReadBuffers> tensorpipeAllocate(
   buffers.id = std::make_unique<int64_t>();
   tpAllocation.payloads[kTpMessageIdIdx].data = buffers.id.get();
 
-  // FIXME The two resizes below zero out the vectors, which is not needed.
+  // FIXME The resize below zeroes out the vector, which is not needed. The
+  // payload must remain a std::vector<char> because the Message constructor
+  // takes ownership of it as one.
   buffers.payload.resize(tpDescriptor.payloads[kTpMessagePayloadIdx].length);
   tpAllocation.payloads[kTpMessagePayloadIdx].data = buffers.payload.data();
 
-  buffers.pickle.resize(tpDescriptor.payloads[kTpMessagePickleIdx].length);
-  tpAllocation.payloads[kTpMessagePickleIdx].data = buffers.pickle.data();
+  // The pickle, on the other hand, is only read in place by the unpickler,
+  // so it's received into an uninitialized allocation.
+  buffers.pickle = at::getCPUAllocator()->allocate(
+      tpDescriptor.payloads[kTpMessagePickleIdx].length);
+  tpAllocation.payloads[kTpMessagePickleIdx].data = buffers.pickle.get();
 
   size_t numTensors = tpDescriptor.tensors.size();
   tpAllocation.tensors.reserve(numTensors);
@@ -279,8 +284,8 @@ c10::intrusive_ptr<Message> tensorpipeDeserialize(
     TensorpipeReadBuffers&& buffers) {
   // Tensors
   std::vector<at::Tensor> tensors;
-  const char* pickleData = buffers.pickle.data();
-  size_t pickleLen = buffers.pickle.size();
+  const char* pickleData = static_cast<const char*>(buffers.pickle.get());
+  size_t pickleLen = tpDescriptor.payloads[kTpMessagePickleIdx].length;
   size_t picklePos = 0;
   auto pickleReadFunc = [&](char* buf, size_t n) -> size_t {
     if (picklePos >= pickleLen || n == 0) {
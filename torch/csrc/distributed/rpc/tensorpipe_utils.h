@@ -88,7 +88,10 @@ struct TensorpipeReadBuffers {
   std::unique_ptr<MessageType> type;
   std::unique_ptr<int64_t> id;
   std::vector<char> payload;
-  std::vector<char> pickle;
+  // The pickle is only ever consumed in place by the unpickler, so it is
+  // received into a raw (uninitialized) allocation rather than a vector,
+  // avoiding a zero-fill pass over bytes the channel overwrites anyway.
+  c10::DataPtr pickle;
   std::vector<c10::DataPtr> tensors;
 };
 
@@ -16,6 +16,7 @@
 #include <torch/csrc/distributed/rpc/python_call.h>
 #include <torch/csrc/distributed/rpc/python_remote_call.h>
 #include <torch/csrc/distributed/rpc/python_resp.h>
+#include <torch/csrc/distributed/rpc/remote_storage.h>
 #include <torch/csrc/distributed/rpc/rref_proto.h>
 #include <torch/csrc/distributed/rpc/script_call.h>
 #include <torch/csrc/distributed/rpc/script_remote_call.h>
@@ -140,6 +141,9 @@ std::unique_ptr<RpcCommandBase> deserializeRequest(const Message& request) {
     case MessageType::RREF_BACKWARD_REQ: {
       return autograd::RRefBackwardReq::fromMessage(request);
     }
+    case MessageType::STORAGE_FETCH_CALL: {
+      return StorageFetchCall::fromMessage(request);
+    }
     default: {
       TORCH_INTERNAL_ASSERT(
           false, "Request type ", request.type(), " not supported.");
@@ -215,6 +219,9 @@ std::unique_ptr<RpcCommandBase> deserializeResponse(
     case MessageType::RREF_BACKWARD_RESP: {
       return autograd::RRefBackwardResp::fromMessage(response);
     }
+    case MessageType::STORAGE_FETCH_RET: {
+      return StorageFetchRet::fromMessage(response);
+    }
     default: {
       TORCH_INTERNAL_ASSERT(
           false, "Response type ", response.type(), " not supported.");
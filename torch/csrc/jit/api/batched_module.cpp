@@ -0,0 +1,216 @@
+#include <torch/csrc/jit/api/batched_module.h>
+
+#include <ATen/ATen.h>
+#include <c10/util/irange.h>
+
+#include <utility>
+
+namespace torch {
+namespace jit {
+
+// Note [Micro-batching executor]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Serving stacks commonly batch concurrent inference requests to amortize
+// per-call overhead and improve hardware utilization. Doing that in Python
+// means every enqueue and every scatter takes the GIL; BatchedModule moves
+// the whole loop into C++. forward() pushes a request onto a queue and
+// returns a Future; a worker thread sleeps on the queue and launches a
+// batch as soon as it either covers max_batch_size examples or the oldest
+// request has waited max_latency. Per argument position, the requests'
+// tensors are concatenated with at::cat along batch_dim when their
+// remaining dimensions agree; ragged inputs (batch_dim 0 only) are merged
+// into a nested tensor instead, which kernels with nested support consume
+// directly. The single batched result is then split back per request:
+// dense tensors by narrow() along batch_dim, nested tensors by unbind()
+// and regrouping, recursing through tuples and tensor lists. An exception
+// anywhere in the batched call is forwarded to every participating future.
+
+BatchedModule::BatchedModule(Module module, BatchedModuleOptions options)
+    : module_(std::move(module)), options_(options) {
+  TORCH_CHECK(
+      options_.max_batch_size > 0,
+      "BatchedModule: max_batch_size must be positive, got ",
+      options_.max_batch_size);
+  TORCH_CHECK(
+      options_.batch_dim >= 0,
+      "BatchedModule: batch_dim must be non-negative, got ",
+      options_.batch_dim);
+  const auto& returns =
+      module_.get_method("forward").function().getSchema().returns();
+  result_type_ =
+      returns.size() == 1 ? returns[0].type() : c10::AnyType::get();
+  worker_ = std::thread([this] { workerLoop(); });
+}
+
+BatchedModule::~BatchedModule() {
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    stopping_ = true;
+  }
+  cv_.notify_all();
+  worker_.join();
+}
+
+c10::intrusive_ptr<c10::ivalue::Future> BatchedModule::forward(
+    std::vector<at::Tensor> inputs) {
+  TORCH_CHECK(!inputs.empty(), "BatchedModule: expected at least one input");
+  for (const auto i : c10::irange(inputs.size())) {
+    TORCH_CHECK(
+        inputs[i].dim() > options_.batch_dim,
+        "BatchedModule: input ",
+        i,
+        " has ",
+        inputs[i].dim(),
+        " dimensions, which does not cover batch_dim ",
+        options_.batch_dim);
+    TORCH_CHECK(
+        inputs[i].size(options_.batch_dim) ==
+            inputs[0].size(options_.batch_dim),
+        "BatchedModule: inputs disagree on the batch dimension: ",
+        inputs[i].size(options_.batch_dim),
+        " vs ",
+        inputs[0].size(options_.batch_dim));
+  }
+  Request request;
+  request.num_examples = inputs[0].size(options_.batch_dim);
+  request.inputs = std::move(inputs);
+  request.enqueue_time = std::chrono::steady_clock::now();
+  request.future = c10::make_intrusive<c10::ivalue::Future>(result_type_);
+  auto future = request.future;
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    queued_examples_ += request.num_examples;
+    queue_.push_back(std::move(request));
+  }
+  cv_.notify_one();
+  return future;
+}
+
+void BatchedModule::workerLoop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    cv_.wait(lock, [&] { return stopping_ || !queue_.empty(); });
+    if (queue_.empty()) {
+      // stopping_ with a drained queue; all futures have been fulfilled.
+      return;
+    }
+    // Give the batch a chance to fill up, but never past the latency
+    // budget of its oldest request. Stopping flushes immediately.
+    const auto deadline = queue_.front().enqueue_time + options_.max_latency;
+    while (!stopping_ && queued_examples_ < options_.max_batch_size &&
+           std::chrono::steady_clock::now() < deadline) {
+      cv_.wait_until(lock, deadline);
+    }
+    // Take whole requests up to max_batch_size examples; a single request
+    // larger than the cutoff still runs (alone).
+    std::vector<Request> batch;
+    int64_t num_examples = 0;
+    while (!queue_.empty() &&
+           (batch.empty() ||
+            num_examples + queue_.front().num_examples <=
+                options_.max_batch_size)) {
+      num_examples += queue_.front().num_examples;
+      queued_examples_ -= queue_.front().num_examples;
+      batch.push_back(std::move(queue_.front()));
+      queue_.pop_front();
+    }
+    lock.unlock();
+    runBatch(std::move(batch));
+    lock.lock();
+  }
+}
+
+void BatchedModule::runBatch(std::vector<Request> batch) {
+  try {
+    const auto num_inputs = batch[0].inputs.size();
+    std::vector<IValue> inputs;
+    inputs.reserve(num_inputs);
+    for (const auto i : c10::irange(num_inputs)) {
+      std::vector<at::Tensor> pieces;
+      pieces.reserve(batch.size());
+      bool ragged = false;
+      for (const auto& request : batch) {
+        TORCH_CHECK(
+            request.inputs.size() == num_inputs,
+            "BatchedModule: requests in one batch disagree on the number of "
+            "inputs: ",
+            request.inputs.size(),
+            " vs ",
+            num_inputs);
+        ragged = ragged ||
+            request.inputs[i].sizes() != batch[0].inputs[i].sizes();
+        pieces.push_back(request.inputs[i]);
+      }
+      if (!ragged) {
+        inputs.emplace_back(at::cat(pieces, options_.batch_dim));
+      } else {
+        TORCH_CHECK(
+            options_.batch_dim == 0,
+            "BatchedModule: inputs with mismatched shapes can only be "
+            "batched as nested tensors along batch_dim 0");
+        std::vector<at::Tensor> examples;
+        for (const auto& piece : pieces) {
+          for (const auto& example : piece.unbind(0)) {
+            examples.push_back(example);
+          }
+        }
+        inputs.emplace_back(at::nested_tensor(examples));
+      }
+    }
+    auto result = module_.forward(std::move(inputs));
+    int64_t offset = 0;
+    for (auto& request : batch) {
+      request.future->markCompleted(
+          sliceResult(result, offset, request.num_examples));
+      offset += request.num_examples;
+    }
+  } catch (...) {
+    auto error = std::current_exception();
+    for (auto& request : batch) {
+      if (!request.future->completed()) {
+        request.future->setError(error);
+      }
+    }
+  }
+}
+
+IValue BatchedModule::sliceResult(
+    const IValue& result,
+    int64_t offset,
+    int64_t length) {
+  if (result.isTensor()) {
+    const auto& tensor = result.toTensor();
+    if (tensor.is_nested()) {
+      auto examples = tensor.unbind(0);
+      std::vector<at::Tensor> mine(
+          examples.begin() + offset, examples.begin() + offset + length);
+      return at::nested_tensor(mine);
+    }
+    return tensor.narrow(options_.batch_dim, offset, length);
+  }
+  if (result.isTuple()) {
+    const auto& elements = result.toTupleRef().elements();
+    std::vector<IValue> sliced;
+    sliced.reserve(elements.size());
+    for (const auto& element : elements) {
+      sliced.push_back(sliceResult(element, offset, length));
+    }
+    return c10::ivalue::Tuple::create(std::move(sliced));
+  }
+  if (result.isTensorList()) {
+    c10::List<at::Tensor> sliced;
+    sliced.reserve(result.toTensorList().size());
+    for (const at::Tensor& element : result.toTensorVector()) {
+      sliced.push_back(sliceResult(element, offset, length).toTensor());
+    }
+    return sliced;
+  }
+  TORCH_CHECK(
+      false,
+      "BatchedModule: cannot scatter a batched result of type ",
+      result.type()->repr_str(),
+      "; only tensors, tuples and tensor lists are supported");
+}
+
+} // namespace jit
+} // namespace torch
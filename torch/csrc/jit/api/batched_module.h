@@ -0,0 +1,78 @@
+#pragma once
+
+#include <torch/csrc/jit/api/module.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace torch {
+namespace jit {
+
+struct TORCH_API BatchedModuleOptions {
+  // Dimension along which per-request inputs are concatenated and along
+  // which the batched output is split back up.
+  int64_t batch_dim = 0;
+  // A batch is launched once it covers this many examples, ...
+  int64_t max_batch_size = 8;
+  // ... or once its oldest request has waited this long.
+  std::chrono::microseconds max_latency = std::chrono::microseconds(1000);
+};
+
+// A micro-batching executor for a scripted module. Individual requests are
+// queued from any thread via forward(), merged into one batched call on a
+// dedicated worker thread once either cutoff in BatchedModuleOptions is
+// reached, and the batched result is scattered back to a per-request Future.
+// See Note [Micro-batching executor] in batched_module.cpp.
+struct TORCH_API BatchedModule {
+  explicit BatchedModule(Module module, BatchedModuleOptions options = {});
+  ~BatchedModule();
+
+  BatchedModule(const BatchedModule&) = delete;
+  BatchedModule& operator=(const BatchedModule&) = delete;
+
+  // Enqueues one request's positional tensor inputs, each carrying
+  // options().batch_dim. Inputs whose remaining dimensions differ between
+  // requests are merged as nested tensors (batch_dim must be 0 for those).
+  // The returned future is fulfilled with this request's slice of the
+  // batched output, or with the error the batched call raised.
+  c10::intrusive_ptr<c10::ivalue::Future> forward(
+      std::vector<at::Tensor> inputs);
+
+  const Module& module() const {
+    return module_;
+  }
+
+  const BatchedModuleOptions& options() const {
+    return options_;
+  }
+
+ private:
+  struct Request {
+    std::vector<at::Tensor> inputs;
+    int64_t num_examples;
+    std::chrono::steady_clock::time_point enqueue_time;
+    c10::intrusive_ptr<c10::ivalue::Future> future;
+  };
+
+  void workerLoop();
+  void runBatch(std::vector<Request> batch);
+  IValue sliceResult(const IValue& result, int64_t offset, int64_t length);
+
+  Module module_;
+  BatchedModuleOptions options_;
+  c10::TypePtr result_type_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<Request> queue_;
+  int64_t queued_examples_ = 0;
+  bool stopping_ = false;
+  std::thread worker_;
+};
+
+} // namespace jit
+} // namespace torch
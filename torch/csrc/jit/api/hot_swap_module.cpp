@@ -0,0 +1,132 @@
+#include <torch/csrc/jit/api/hot_swap_module.h>
+
+#include <c10/util/irange.h>
+
+#include <atomic>
+#include <utility>
+
+namespace torch {
+namespace jit {
+
+// Note [Hot-swappable weights]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Refreshing the weights of a live module is racy: setattr() mutates the
+// object slots that concurrently running graph executors read, so a
+// request can observe some tensors from the old checkpoint and some from
+// the new one. The usual workaround is to quiesce traffic and swap the
+// whole module, which costs downtime at every refresh.
+//
+// HotSwapModule instead keeps weights in immutable generations. A
+// generation is a shallow structural copy of the module: every
+// ivalue::Object in the tree is copied (so slot writes on one generation
+// are invisible to the others) while tensors, the ClassType, the
+// CompilationUnit and therefore the compiled and specialized code are
+// shared. update() builds the next generation on the caller's thread,
+// replaces the requested tensors on it, and publishes it with a single
+// atomic pointer store; no request-side lock is taken. Requests pin the
+// generation they started on by holding its shared_ptr, so an update
+// mid-request is simply not seen by that request. When the last pin on an
+// old generation drops, its storages go back to the allocator and — at a
+// steady refresh cadence — the next update's allocations are served from
+// the blocks the previous generation just released.
+
+namespace {
+
+// Copies every object in the module tree so that setattr on the copy
+// cannot be observed through the original, while sharing all slot values
+// (tensors included) and all code.
+Module structuralCopy(const Module& module) {
+  auto obj = module._ivalue()->copy();
+  const auto& type = obj->type();
+  for (const auto i : c10::irange(type->numAttributes())) {
+    if (type->getAttribute(i)->is_module()) {
+      obj->setSlot(
+          i, structuralCopy(Module(obj->getSlot(i).toObject()))._ivalue());
+    }
+  }
+  return Module(std::move(obj));
+}
+
+void setNamedTensor(
+    Module& root,
+    const std::string& name,
+    const at::Tensor& value) {
+  Module m = root;
+  size_t begin = 0;
+  size_t dot = 0;
+  while ((dot = name.find('.', begin)) != std::string::npos) {
+    const std::string fragment = name.substr(begin, dot - begin);
+    TORCH_CHECK(
+        m.hasattr(fragment) && m.attr(fragment).isModule(),
+        "HotSwapModule: '",
+        name,
+        "' does not name a submodule path in ",
+        root.type()->repr_str());
+    m = m.attr(fragment).toModule();
+    begin = dot + 1;
+  }
+  const std::string leaf = name.substr(begin);
+  TORCH_CHECK(
+      m.hasattr(leaf) && m.attr(leaf).isTensor(),
+      "HotSwapModule: module has no tensor attribute '",
+      name,
+      "'");
+  const auto old = m.attr(leaf).toTensor();
+  TORCH_CHECK(
+      value.sizes().equals(old.sizes()) &&
+          value.scalar_type() == old.scalar_type() &&
+          value.device() == old.device(),
+      "HotSwapModule: replacement for '",
+      name,
+      "' must match the existing tensor, expected ",
+      old.sizes(),
+      " ",
+      old.scalar_type(),
+      " on ",
+      old.device(),
+      " but got ",
+      value.sizes(),
+      " ",
+      value.scalar_type(),
+      " on ",
+      value.device());
+  m.setattr(leaf, value);
+}
+
+} // namespace
+
+HotSwapModule::HotSwapModule(Module module)
+    : current_(std::make_shared<WeightSet>(
+          WeightSet{std::move(module), /*version=*/0})) {}
+
+std::shared_ptr<const WeightSet> HotSwapModule::weights() const {
+  return std::atomic_load(&current_);
+}
+
+uint64_t HotSwapModule::version() const {
+  return std::atomic_load(&current_)->version;
+}
+
+uint64_t HotSwapModule::update(const std::vector<NameTensor>& new_weights) {
+  std::lock_guard<std::mutex> guard(update_mutex_);
+  const auto cur = std::atomic_load(&current_);
+  Module shadow = structuralCopy(cur->module);
+  for (const auto& w : new_weights) {
+    setNamedTensor(shadow, w.name, w.value);
+  }
+  const uint64_t next_version = cur->version + 1;
+  std::atomic_store(
+      &current_,
+      std::shared_ptr<const WeightSet>(std::make_shared<WeightSet>(
+          WeightSet{std::move(shadow), next_version})));
+  return next_version;
+}
+
+IValue HotSwapModule::forward(std::vector<IValue> inputs, const Kwargs& kwargs) {
+  const auto pinned = weights();
+  Module module = pinned->module;
+  return module.forward(std::move(inputs), kwargs);
+}
+
+} // namespace jit
+} // namespace torch
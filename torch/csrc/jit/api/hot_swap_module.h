@@ -0,0 +1,57 @@
+#pragma once
+
+#include <torch/csrc/jit/api/module.h>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace torch {
+namespace jit {
+
+// One immutable generation of a module's weights. The contained module
+// shares its ClassType, CompilationUnit and compiled code with every
+// other generation; only the object tree and the replaced tensors are per
+// generation. Holding the shared_ptr pins the generation: its storages
+// stay alive until the last holder releases it.
+struct TORCH_API WeightSet {
+  Module module;
+  uint64_t version;
+};
+
+// Atomic weight versioning for a scripted module. Requests pin the
+// current WeightSet and run against it; update() builds a shadow
+// generation off the request path and swaps one atomic pointer, so
+// weights can be refreshed while requests execute, with no
+// stop-the-world. See Note [Hot-swappable weights] in hot_swap_module.cpp.
+struct TORCH_API HotSwapModule {
+  explicit HotSwapModule(Module module);
+
+  // Pins and returns the current weight set. Calls on the returned
+  // module run entirely on that generation, even if update() swaps in a
+  // newer one mid-request.
+  std::shared_ptr<const WeightSet> weights() const;
+
+  uint64_t version() const;
+
+  // Builds a shadow generation with the given parameters/buffers replaced
+  // (names are dotted paths, as produced by named_parameters()) and swaps
+  // it in as the new current one. Safe to call while forward() runs on
+  // other threads; concurrent updates are serialized. The replacement
+  // tensors must match the sizes, dtype and device of the tensors they
+  // replace. Returns the new version number.
+  uint64_t update(const std::vector<NameTensor>& new_weights);
+
+  // Convenience wrapper that pins the current generation for the duration
+  // of one call.
+  IValue forward(std::vector<IValue> inputs, const Kwargs& kwargs = Kwargs());
+
+ private:
+  // Readers pin via std::atomic_load; update() is the only writer.
+  std::shared_ptr<const WeightSet> current_;
+  std::mutex update_mutex_;
+};
+
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,511 @@
+#include <torch/csrc/jit/api/shared_weight_region.h>
+
+#include <ATen/ATen.h>
+#include <ATen/MapAllocator.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <utility>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace torch {
+namespace jit {
+
+// Note [Shared weight regions]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// A CPU serving fleet forks N worker processes per host, and a naive
+// deployment gives each worker its own copy of the weights: 31 of 32
+// copies are pure waste. Sharing the bytes is easy (mmap a file, or the
+// refcounted shared-memory allocator below), but raw sharing has no
+// integrity or versioning story: a worker that maps a half-written or
+// corrupted region serves garbage silently, and nothing tells workers
+// that the creator rolled a new checkpoint.
+//
+// A SharedWeightRegion is a single RefcountedMapAllocator shared-memory
+// object with that layer added. The creator lays it out as
+//
+//   [ header | manifest | chunk hashes | payload ]
+//
+// where the header carries a magic/format pair, the region totals, and a
+// generation counter; the manifest records every tensor's dotted name,
+// dtype, shape and payload offset; and the payload is covered by 64-bit
+// FNV-1a hashes of fixed-size chunks. Workers attach by name, check the
+// manifest against the tensors their own copy of the model declares, and
+// bind each weight as a view into the payload. Hashes are checked lazily,
+// the first time a chunk backs a tensor being bound, so attaching to a
+// multi-GB region stays cheap and a worker that never touches a tensor
+// never pays for hashing it. Where the platform allows it the payload
+// pages are remapped PROT_READ, so a stray write in one worker faults in
+// that worker instead of corrupting the weights under all of them.
+//
+// Updates reuse the generation counter as a seqlock: the creator bumps it
+// to an odd value, rewrites payload and hashes in place, and bumps it to
+// the next even value. Workers poll stale() between requests; on a bump
+// they refresh(), which forgets which chunks were verified so the new
+// bytes are re-checked against the new hashes. Because an update rewrites
+// in place, already-bound tensors observe the new weights without
+// rebinding — a worker that needs a torn-update-free forward should pin
+// via HotSwapModule-style generations on top, or quiesce around update().
+
+namespace {
+
+constexpr uint64_t kRegionMagic = 0x3130474552575450ULL; // "PTWREG01"
+constexpr uint64_t kFormatVersion = 1;
+constexpr uint64_t kChunkBytes = uint64_t(1) << 20;
+constexpr uint64_t kTensorAlignBytes = 64;
+
+// Overlaid on the start of the mapping; the mapping is zero-filled and
+// 64-byte aligned, and the creator publishes `generation` last, so a
+// worker that maps mid-publish sees generation == 0 and keeps waiting.
+// Putting a std::atomic in shared memory follows RefcountedMapAllocator's
+// MapInfo.
+struct RegionHeader {
+  uint64_t magic;
+  uint64_t format;
+  std::atomic<uint64_t> generation;
+  uint64_t total_nbytes;
+  uint64_t manifest_offset;
+  uint64_t manifest_nbytes;
+  uint64_t hashes_offset;
+  uint64_t num_chunks;
+  uint64_t payload_offset;
+  uint64_t payload_nbytes;
+};
+
+struct Entry {
+  std::string name;
+  at::ScalarType dtype;
+  std::vector<int64_t> sizes;
+  uint64_t offset; // from the start of the mapping
+  uint64_t nbytes;
+};
+
+uint64_t alignUp(uint64_t value, uint64_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+uint64_t fnv1a(const char* data, uint64_t nbytes) {
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (uint64_t i = 0; i < nbytes; i++) {
+    hash ^= static_cast<uint8_t>(data[i]);
+    hash *= 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+template <typename T>
+void appendScalar(std::string& out, T value) {
+  out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+T readScalar(const char*& cursor, const char* end) {
+  TORCH_CHECK(
+      cursor + sizeof(T) <= end,
+      "SharedWeightRegion: truncated manifest");
+  T value;
+  std::memcpy(&value, cursor, sizeof(T));
+  cursor += sizeof(T);
+  return value;
+}
+
+std::string serializeManifest(const std::vector<Entry>& entries) {
+  std::string out;
+  appendScalar<uint64_t>(out, entries.size());
+  for (const auto& e : entries) {
+    appendScalar<uint64_t>(out, e.name.size());
+    out.append(e.name);
+    appendScalar<int32_t>(out, static_cast<int32_t>(e.dtype));
+    appendScalar<uint64_t>(out, e.sizes.size());
+    for (auto s : e.sizes) {
+      appendScalar<int64_t>(out, s);
+    }
+    appendScalar<uint64_t>(out, e.offset);
+    appendScalar<uint64_t>(out, e.nbytes);
+  }
+  return out;
+}
+
+std::vector<Entry> deserializeManifest(const char* data, uint64_t nbytes) {
+  const char* cursor = data;
+  const char* end = data + nbytes;
+  std::vector<Entry> entries(readScalar<uint64_t>(cursor, end));
+  for (auto& e : entries) {
+    const auto name_len = readScalar<uint64_t>(cursor, end);
+    TORCH_CHECK(
+        cursor + name_len <= end, "SharedWeightRegion: truncated manifest");
+    e.name.assign(cursor, name_len);
+    cursor += name_len;
+    e.dtype = static_cast<at::ScalarType>(readScalar<int32_t>(cursor, end));
+    e.sizes.resize(readScalar<uint64_t>(cursor, end));
+    for (auto& s : e.sizes) {
+      s = readScalar<int64_t>(cursor, end);
+    }
+    e.offset = readScalar<uint64_t>(cursor, end);
+    e.nbytes = readScalar<uint64_t>(cursor, end);
+  }
+  return entries;
+}
+
+// The creator's view of the weights: dotted name plus a contiguous CPU
+// tensor, in deterministic (manifest) order.
+std::vector<NameTensor> collectWeights(const Module& module) {
+  std::vector<NameTensor> result;
+  for (const auto& p : module.named_parameters(/*recurse=*/true)) {
+    result.push_back({p.name, p.value.contiguous()});
+  }
+  for (const auto& b : module.named_buffers(/*recurse=*/true)) {
+    result.push_back({b.name, b.value.contiguous()});
+  }
+  for (const auto& w : result) {
+    TORCH_CHECK(
+        w.value.device().is_cpu() && w.value.layout() == at::kStrided,
+        "SharedWeightRegion: '",
+        w.name,
+        "' must be a strided CPU tensor, got ",
+        w.value.layout(),
+        " on ",
+        w.value.device());
+  }
+  return result;
+}
+
+// Walks a dotted path to the tensor attribute it names, checking that the
+// module declares it with the shape and dtype the manifest promises.
+Module ownerOfNamedTensor(Module& root, const Entry& entry) {
+  Module m = root;
+  const std::string& name = entry.name;
+  size_t begin = 0;
+  size_t dot = 0;
+  while ((dot = name.find('.', begin)) != std::string::npos) {
+    const std::string fragment = name.substr(begin, dot - begin);
+    TORCH_CHECK(
+        m.hasattr(fragment) && m.attr(fragment).isModule(),
+        "SharedWeightRegion: '",
+        name,
+        "' does not name a submodule path in ",
+        root.type()->repr_str());
+    m = m.attr(fragment).toModule();
+    begin = dot + 1;
+  }
+  const std::string leaf = name.substr(begin);
+  TORCH_CHECK(
+      m.hasattr(leaf) && m.attr(leaf).isTensor(),
+      "SharedWeightRegion: module has no tensor attribute '",
+      name,
+      "'");
+  const auto existing = m.attr(leaf).toTensor();
+  TORCH_CHECK(
+      existing.sizes().equals(entry.sizes) &&
+          existing.scalar_type() == entry.dtype,
+      "SharedWeightRegion: manifest entry '",
+      name,
+      "' is ",
+      entry.sizes,
+      " ",
+      entry.dtype,
+      " but the module declares ",
+      existing.sizes(),
+      " ",
+      existing.scalar_type());
+  return m;
+}
+
+} // namespace
+
+struct SharedWeightRegion::Impl {
+  at::DataPtr map;
+  std::string name;
+  bool creator;
+  std::vector<Entry> entries;
+  uint64_t bound_generation;
+  std::mutex verify_mutex;
+  // One flag per payload chunk; cleared by refresh().
+  std::vector<bool> verified;
+
+  char* data() const {
+    return static_cast<char*>(map.get());
+  }
+  RegionHeader* header() const {
+    return reinterpret_cast<RegionHeader*>(data());
+  }
+
+  // Verifies (once) every chunk overlapping [offset, offset + nbytes) of
+  // the payload, offsets relative to the start of the mapping.
+  void verifyRange(uint64_t offset, uint64_t nbytes) {
+    if (nbytes == 0) {
+      return;
+    }
+    auto* h = header();
+    const auto* hashes =
+        reinterpret_cast<const uint64_t*>(data() + h->hashes_offset);
+    const char* payload = data() + h->payload_offset;
+    const uint64_t first = (offset - h->payload_offset) / kChunkBytes;
+    const uint64_t last = (offset - h->payload_offset + nbytes - 1) / kChunkBytes;
+    std::lock_guard<std::mutex> guard(verify_mutex);
+    for (uint64_t c = first; c <= last; c++) {
+      if (verified[c]) {
+        continue;
+      }
+      const uint64_t chunk_nbytes =
+          std::min(kChunkBytes, h->payload_nbytes - c * kChunkBytes);
+      const uint64_t actual = fnv1a(payload + c * kChunkBytes, chunk_nbytes);
+      TORCH_CHECK(
+          actual == hashes[c],
+          "SharedWeightRegion '",
+          name,
+          "': hash mismatch in chunk ",
+          c,
+          " of the payload; the region is corrupt, or was updated "
+          "concurrently (check stale() and refresh())");
+      verified[c] = true;
+    }
+  }
+};
+
+SharedWeightRegion::SharedWeightRegion(std::shared_ptr<Impl> impl)
+    : impl_(std::move(impl)) {}
+
+SharedWeightRegion SharedWeightRegion::publish(
+    const std::string& name,
+    const Module& module) {
+  const auto weights = collectWeights(module);
+
+  std::vector<Entry> entries(weights.size());
+  uint64_t payload_nbytes = 0;
+  for (size_t i = 0; i < weights.size(); i++) {
+    const auto& t = weights[i].value;
+    entries[i].name = weights[i].name;
+    entries[i].dtype = t.scalar_type();
+    entries[i].sizes = t.sizes().vec();
+    entries[i].nbytes = t.nbytes();
+    payload_nbytes = alignUp(payload_nbytes, kTensorAlignBytes);
+    entries[i].offset = payload_nbytes; // payload-relative for now
+    payload_nbytes += entries[i].nbytes;
+  }
+
+  const uint64_t manifest_offset = alignUp(sizeof(RegionHeader), alignof(uint64_t));
+  // Serialized size does not depend on the offsets, so the layout can be
+  // fixed before the final serialization below.
+  const uint64_t manifest_nbytes = serializeManifest(entries).size();
+  const uint64_t hashes_offset =
+      alignUp(manifest_offset + manifest_nbytes, alignof(uint64_t));
+  const uint64_t num_chunks = (payload_nbytes + kChunkBytes - 1) / kChunkBytes;
+  const uint64_t payload_offset = alignUp(
+      hashes_offset + num_chunks * sizeof(uint64_t), kTensorAlignBytes);
+  const uint64_t total_nbytes = payload_offset + payload_nbytes;
+  for (auto& e : entries) {
+    e.offset += payload_offset;
+  }
+
+  auto impl = std::make_shared<Impl>();
+  impl->map = at::RefcountedMapAllocator::makeDataPtr(
+      name.c_str(),
+      at::ALLOCATOR_MAPPED_SHAREDMEM | at::ALLOCATOR_MAPPED_EXCLUSIVE,
+      total_nbytes,
+      nullptr);
+  impl->name = name;
+  impl->creator = true;
+  impl->entries = entries;
+  impl->verified.assign(num_chunks, false);
+
+  char* base = impl->data();
+  const auto manifest = serializeManifest(entries);
+  std::memcpy(base + manifest_offset, manifest.data(), manifest.size());
+  for (size_t i = 0; i < weights.size(); i++) {
+    std::memcpy(
+        base + entries[i].offset,
+        weights[i].value.data_ptr(),
+        entries[i].nbytes);
+  }
+  auto* hashes = reinterpret_cast<uint64_t*>(base + hashes_offset);
+  for (uint64_t c = 0; c < num_chunks; c++) {
+    hashes[c] = fnv1a(
+        base + payload_offset + c * kChunkBytes,
+        std::min(kChunkBytes, payload_nbytes - c * kChunkBytes));
+  }
+
+  auto* header = impl->header();
+  header->magic = kRegionMagic;
+  header->format = kFormatVersion;
+  header->total_nbytes = total_nbytes;
+  header->manifest_offset = manifest_offset;
+  header->manifest_nbytes = manifest_nbytes;
+  header->hashes_offset = hashes_offset;
+  header->num_chunks = num_chunks;
+  header->payload_offset = payload_offset;
+  header->payload_nbytes = payload_nbytes;
+  // Published last: a worker mapping mid-publish sees generation == 0.
+  header->generation.store(2, std::memory_order_release);
+  impl->bound_generation = 2;
+
+  return SharedWeightRegion(std::move(impl));
+}
+
+SharedWeightRegion SharedWeightRegion::attach(const std::string& name) {
+  // The region size is only known from its own header, so map one page to
+  // read the totals, then map the whole region. The probe is released
+  // after the full mapping exists so the refcount never touches zero.
+  auto probe = at::RefcountedMapAllocator::makeDataPtr(
+      name.c_str(),
+      at::ALLOCATOR_MAPPED_SHAREDMEM | at::ALLOCATOR_MAPPED_NOCREATE,
+      sizeof(RegionHeader),
+      nullptr);
+  const auto* probe_header = static_cast<const RegionHeader*>(probe.get());
+  TORCH_CHECK(
+      probe_header->magic == kRegionMagic &&
+          probe_header->format == kFormatVersion &&
+          probe_header->generation.load(std::memory_order_acquire) != 0,
+      "SharedWeightRegion: '",
+      name,
+      "' is not a fully published weight region");
+  const uint64_t total_nbytes = probe_header->total_nbytes;
+
+  auto impl = std::make_shared<Impl>();
+  impl->map = at::RefcountedMapAllocator::makeDataPtr(
+      name.c_str(),
+      at::ALLOCATOR_MAPPED_SHAREDMEM | at::ALLOCATOR_MAPPED_NOCREATE,
+      total_nbytes,
+      nullptr);
+  probe.clear();
+  impl->name = name;
+  impl->creator = false;
+
+  auto* header = impl->header();
+  impl->entries = deserializeManifest(
+      impl->data() + header->manifest_offset, header->manifest_nbytes);
+  impl->bound_generation = header->generation.load(std::memory_order_acquire);
+  impl->verified.assign(header->num_chunks, false);
+
+#ifndef _WIN32
+  // Remap the interior payload pages read-only so a stray write in this
+  // worker faults here instead of corrupting the weights under every
+  // process. mprotect needs page granularity and the payload is only
+  // 64-byte aligned within the mapping, so up to a page at either edge
+  // stays writable; integrity of those bytes is still covered by the
+  // chunk hashes.
+  const auto page = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+  const uint64_t begin = alignUp(
+      reinterpret_cast<uintptr_t>(impl->data() + header->payload_offset),
+      page);
+  const uint64_t end = reinterpret_cast<uintptr_t>(
+                           impl->data() + header->payload_offset +
+                           header->payload_nbytes) /
+      page * page;
+  if (begin < end) {
+    mprotect(reinterpret_cast<void*>(begin), end - begin, PROT_READ);
+  }
+#endif
+
+  return SharedWeightRegion(std::move(impl));
+}
+
+uint64_t SharedWeightRegion::generation() const {
+  return impl_->header()->generation.load(std::memory_order_acquire);
+}
+
+bool SharedWeightRegion::stale() const {
+  const auto gen = generation();
+  return gen != impl_->bound_generation || (gen & 1) != 0;
+}
+
+void SharedWeightRegion::refresh() {
+  const auto gen = generation();
+  TORCH_CHECK(
+      (gen & 1) == 0,
+      "SharedWeightRegion '",
+      impl_->name,
+      "': an update is in progress");
+  std::lock_guard<std::mutex> guard(impl_->verify_mutex);
+  impl_->verified.assign(impl_->verified.size(), false);
+  impl_->bound_generation = gen;
+}
+
+void SharedWeightRegion::bind(Module& module) {
+  auto impl = impl_;
+  for (const auto& entry : impl->entries) {
+    Module owner = ownerOfNamedTensor(module, entry);
+    impl->verifyRange(entry.offset, entry.nbytes);
+    // The view keeps the mapping alive through its deleter, so a bound
+    // module may outlive every SharedWeightRegion handle.
+    auto view = at::from_blob(
+        impl->data() + entry.offset,
+        entry.sizes,
+        [impl](void*) {},
+        at::TensorOptions().dtype(entry.dtype));
+    const auto leaf_pos = entry.name.rfind('.');
+    owner.setattr(
+        leaf_pos == std::string::npos ? entry.name
+                                      : entry.name.substr(leaf_pos + 1),
+        std::move(view));
+  }
+}
+
+void SharedWeightRegion::update(const Module& module) {
+  TORCH_CHECK(
+      impl_->creator,
+      "SharedWeightRegion '",
+      impl_->name,
+      "': only the creator may update the region");
+  const auto weights = collectWeights(module);
+  TORCH_CHECK(
+      weights.size() == impl_->entries.size(),
+      "SharedWeightRegion '",
+      impl_->name,
+      "': update has ",
+      weights.size(),
+      " weights but the manifest has ",
+      impl_->entries.size());
+  for (size_t i = 0; i < weights.size(); i++) {
+    const auto& entry = impl_->entries[i];
+    const auto& t = weights[i].value;
+    TORCH_CHECK(
+        weights[i].name == entry.name && t.sizes().equals(entry.sizes) &&
+            t.scalar_type() == entry.dtype,
+        "SharedWeightRegion '",
+        impl_->name,
+        "': update weight '",
+        weights[i].name,
+        "' does not match manifest entry '",
+        entry.name,
+        "'");
+  }
+
+  auto* header = impl_->header();
+  char* base = impl_->data();
+  const auto gen = header->generation.load(std::memory_order_relaxed);
+  // Seqlock: odd while the payload is being rewritten.
+  header->generation.store(gen + 1, std::memory_order_release);
+  for (size_t i = 0; i < weights.size(); i++) {
+    std::memcpy(
+        base + impl_->entries[i].offset,
+        weights[i].value.data_ptr(),
+        impl_->entries[i].nbytes);
+  }
+  auto* hashes = reinterpret_cast<uint64_t*>(base + header->hashes_offset);
+  for (uint64_t c = 0; c < header->num_chunks; c++) {
+    hashes[c] = fnv1a(
+        base + header->payload_offset + c * kChunkBytes,
+        std::min(kChunkBytes, header->payload_nbytes - c * kChunkBytes));
+  }
+  header->generation.store(gen + 2, std::memory_order_release);
+  {
+    std::lock_guard<std::mutex> guard(impl_->verify_mutex);
+    impl_->verified.assign(impl_->verified.size(), false);
+  }
+  impl_->bound_generation = gen + 2;
+}
+
+void SharedWeightRegion::verifyAll() {
+  auto* header = impl_->header();
+  impl_->verifyRange(header->payload_offset, header->payload_nbytes);
+}
+
+} // namespace jit
+} // namespace torch
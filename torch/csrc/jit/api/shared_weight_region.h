@@ -0,0 +1,71 @@
+#pragma once
+
+#include <torch/csrc/jit/api/module.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace torch {
+namespace jit {
+
+// A named shared-memory region holding one copy of a module's weights for
+// a fleet of worker processes on the same host. The creator publishes the
+// parameters and buffers of a module together with a manifest (names,
+// shapes, dtypes, offsets and per-chunk content hashes); workers attach,
+// verify the manifest against what their own copy of the model expects,
+// and rebind their module's weights to read-only views of the region, so
+// N serving processes cost one copy of weights instead of N. See
+// Note [Shared weight regions] in shared_weight_region.cpp.
+class TORCH_API SharedWeightRegion {
+ public:
+  // Creator side: copies the parameters and buffers of `module` (which
+  // must all live on CPU) into a fresh shared-memory object named `name`
+  // and publishes the manifest. Fails if the name is already in use.
+  static SharedWeightRegion publish(const std::string& name, const Module& module);
+
+  // Worker side: maps an existing region. The payload pages are remapped
+  // read-only where the platform supports it, so a stray write in a
+  // worker faults instead of corrupting every process.
+  static SharedWeightRegion attach(const std::string& name);
+
+  // The generation published into the region header. Bumped by update();
+  // workers compare it against the generation they bound to decide when
+  // to refresh().
+  uint64_t generation() const;
+
+  // True once the creator has published a newer generation than the one
+  // this handle last bound (or is mid-update).
+  bool stale() const;
+
+  // Rebinds every parameter/buffer of `module` that appears in the
+  // manifest to a view of the region. Each tensor's backing chunks are
+  // hash-verified the first time they are bound; a mismatch throws
+  // instead of serving corrupt weights. The module must declare every
+  // manifest tensor with matching shape and dtype.
+  void bind(Module& module);
+
+  // Re-reads the header after the creator published a new generation and
+  // forgets which chunks were verified, so the next bind() re-verifies
+  // against the new hashes. Tensors bound earlier keep pointing into the
+  // region and observe the new weights without rebinding.
+  void refresh();
+
+  // Creator side: overwrites the payload in place with the current
+  // weights of `module` (which must match the published manifest) and
+  // bumps the generation. Workers see the bump via stale().
+  void update(const Module& module);
+
+  // Eagerly verifies every chunk of the payload against the manifest
+  // hashes. Normally verification happens lazily in bind().
+  void verifyAll();
+
+ private:
+  struct Impl;
+  explicit SharedWeightRegion(std::shared_ptr<Impl> impl);
+  std::shared_ptr<Impl> impl_;
+};
+
+} // namespace jit
+} // namespace torch
@@ -1204,6 +1204,8 @@ bool Node::hasSideEffects() const {
     case cuda::_set_device:
     case cuda::_current_device:
     case cuda::synchronize:
+    case cuda::_side_stream_begin:
+    case cuda::_side_stream_end:
 #endif
     case prim::Enter:
     case prim::Exit:
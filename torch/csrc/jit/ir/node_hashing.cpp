@@ -55,8 +55,6 @@ bool attributesEqual(const at::Tensor& a1, const at::Tensor& a2) {
   return tensorEqual(a1, a2);
 }
 
-bool ivaluesEqual(const IValue& a1, const IValue& a2);
-
 bool attributesEqual(
     const std::vector<at::Tensor>& lhs,
     const std::vector<at::Tensor>& rhs) {
@@ -81,6 +79,8 @@ bool attributesEqual(const IValue& a1, const IValue& a2) {
   return ivaluesEqual(a1, a2);
 }
 
+} // namespace
+
 // this is not a general-purpose comparison of IValues, it only covers the
 // ivalues that are allowed as attributes, and it does not check type
 // equivalence of containers.
@@ -146,6 +146,8 @@ bool ivaluesEqual(const IValue& a1, const IValue& a2) {
   TORCH_INTERNAL_ASSERT(false);
 }
 
+namespace {
+
 // Check whether two nodes have the same attributes in CSE.
 // This function may be too conservative for general use.
 // Do NOT support g/gs attributes.
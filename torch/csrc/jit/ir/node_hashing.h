@@ -13,5 +13,10 @@ struct TORCH_API EqualNode {
   bool operator()(const Node* lhs, const Node* rhs) const;
 };
 
+// Deep comparison of the IValues that are allowed as node attributes
+// (tensors are compared by value, objects by identity). Used by CSE and by
+// the constant-folding cache in constant_propagation.cpp.
+TORCH_API bool ivaluesEqual(const IValue& a1, const IValue& a2);
+
 } // namespace jit
 } // namespace torch
@@ -126,6 +126,33 @@ bool is_enabled(const char* cfname, JitLoggingLevels level) {
   return level <= static_cast<JitLoggingLevels>(it->second);
 }
 
+bool jit_pass_timing_enabled() {
+  static const bool enabled =
+      std::getenv("PYTORCH_JIT_TIME_PASSES") != nullptr;
+  return enabled;
+}
+
+JitPassTimer::JitPassTimer(const char* pass_name)
+    : pass_name_(jit_pass_timing_enabled() ? pass_name : nullptr) {
+  if (pass_name_) {
+    start_ = std::chrono::steady_clock::now();
+  }
+}
+
+JitPassTimer::~JitPassTimer() {
+  if (!pass_name_) {
+    return;
+  }
+  const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+                           std::chrono::steady_clock::now() - start_)
+                           .count();
+  std::ostringstream ss;
+  ss << "[pass-time] " << pass_name_ << ": " << std::fixed
+     << std::setprecision(3) << static_cast<double>(elapsed) / 1000.0
+     << "ms\n";
+  JitLoggingConfig::getInstance().getOutputStream() << ss.str();
+}
+
 // Unfortunately, in `GraphExecutor` where `log_function` is invoked
 // we won't have access to an original function, so we have to construct
 // a dummy function to give to PythonPrint
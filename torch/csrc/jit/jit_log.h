@@ -1,5 +1,7 @@
 #pragma once
+#include <c10/macros/Macros.h>
 #include <torch/csrc/Export.h>
+#include <chrono>
 #include <memory>
 #include <ostream>
 #include <string>
@@ -83,6 +85,22 @@ TORCH_API std::ostream& operator<<(
     std::ostream& out,
     ::torch::jit::JitLoggingLevels level);
 
+// Per-pass wall-clock timing, for finding where deploy-time optimization of
+// large scripted models goes. Enabled with PYTORCH_JIT_TIME_PASSES=1
+// (independently of PYTORCH_JIT_LOG_LEVEL); each pass wrapped in
+// JIT_PASS_TIMED reports one greppable "[pass-time]" line per invocation on
+// the jit logging output stream when its scope exits.
+TORCH_API bool jit_pass_timing_enabled();
+
+struct TORCH_API JitPassTimer {
+  explicit JitPassTimer(const char* pass_name);
+  ~JitPassTimer();
+
+ private:
+  const char* pass_name_;
+  std::chrono::time_point<std::chrono::steady_clock> start_;
+};
+
 #define JIT_LOG(level, ...)                                         \
   if (is_enabled(__FILE__, level)) {                                \
     ::torch::jit::get_jit_logging_output_stream()                   \
@@ -109,6 +127,10 @@ TORCH_API std::ostream& operator<<(
 // pass
 #define GRAPH_DEBUG(...) \
   JIT_LOG(::torch::jit::JitLoggingLevels::GRAPH_DEBUG, __VA_ARGS__);
+// use JIT_PASS_TIMED at the top of a scope that runs exactly one pass to
+// report its wall-clock time; see jit_pass_timing_enabled above
+#define JIT_PASS_TIMED(PASS_NAME) \
+  ::torch::jit::JitPassTimer C10_ANONYMOUS_VARIABLE(jit_pass_timer)(PASS_NAME)
 // use GRAPH_EXPORT to export a graph so that the IR can be loaded by a script
 #define GRAPH_EXPORT(MSG, G)                       \
   JIT_LOG(                                         \
@@ -15,9 +15,184 @@
 #include <torch/csrc/jit/runtime/vararg_functions.h>
 #include <torch/csrc/utils/memory.h>
 
+#include <c10/util/hash.h>
+
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
+
 namespace torch {
 namespace jit {
 
+namespace {
+
+// Note [Constant folding cache]
+// Serving deployments commonly optimize many clones of the same module (one
+// per interpreter instance), and each clone re-folds identical constant
+// subexpressions from scratch. Fold results are memoized process-wide, keyed
+// on the operator schema and the constant input values, so an expensive fold
+// (e.g. a weight transformation) runs once and all clones share the resulting
+// tensors. Sharing is safe because the JIT never mutates constants - the same
+// invariant CSE relies on when it merges constants within a graph.
+//
+// Only value-comparable inputs/outputs are cached (see foldCacheable), and
+// ops with alias annotations are skipped so a cached output can never alias
+// graph state. Lookups use ivaluesEqual from node_hashing.cpp for deep
+// comparison; the hash is a cheap summary (tensors hashed by metadata only)
+// with equality as the final arbiter.
+
+bool foldCacheable(const IValue& v) {
+  if (v.isInt() || v.isBool() || v.isDouble() || v.isNone() || v.isString()) {
+    return true;
+  }
+  if (v.isTensor()) {
+    const at::Tensor& t = v.toTensor();
+    return t.defined() && !t.is_mkldnn() && !t.is_nested() &&
+        !t.requires_grad();
+  }
+  if (v.isList()) {
+    for (const IValue& elem : v.toListRef()) {
+      if (!foldCacheable(elem)) {
+        return false;
+      }
+    }
+    return true;
+  }
+  if (v.isTuple()) {
+    for (const IValue& elem : v.toTupleRef().elements()) {
+      if (!foldCacheable(elem)) {
+        return false;
+      }
+    }
+    return true;
+  }
+  return false;
+}
+
+size_t foldCacheHash(const IValue& v) {
+  if (v.isInt()) {
+    return c10::get_hash(v.toInt());
+  }
+  if (v.isBool()) {
+    return c10::get_hash(v.toBool());
+  }
+  if (v.isDouble()) {
+    return c10::get_hash(v.toDouble());
+  }
+  if (v.isNone()) {
+    return 0;
+  }
+  if (v.isString()) {
+    return c10::get_hash(v.toStringRef());
+  }
+  if (v.isTensor()) {
+    // Metadata only - hashing tensor contents would defeat the purpose of
+    // the cache. Collisions are resolved by ivaluesEqual.
+    const at::Tensor& t = v.toTensor();
+    size_t hash = c10::get_hash(static_cast<int64_t>(t.scalar_type()));
+    for (int64_t size : t.sizes()) {
+      hash = c10::hash_combine(hash, c10::get_hash(size));
+    }
+    return hash;
+  }
+  size_t hash = 0;
+  if (v.isList()) {
+    for (const IValue& elem : v.toListRef()) {
+      hash = c10::hash_combine(hash, foldCacheHash(elem));
+    }
+    return hash;
+  }
+  if (v.isTuple()) {
+    for (const IValue& elem : v.toTupleRef().elements()) {
+      hash = c10::hash_combine(hash, foldCacheHash(elem));
+    }
+    return hash;
+  }
+  TORCH_INTERNAL_ASSERT(false);
+}
+
+class FoldCache {
+ public:
+  static FoldCache& get() {
+    static FoldCache cache;
+    return cache;
+  }
+
+  c10::optional<std::vector<IValue>> find(
+      const std::string& schema,
+      const std::vector<IValue>& inputs) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto range = entries_.equal_range(keyHash(schema, inputs));
+    for (auto it = range.first; it != range.second; ++it) {
+      const Entry& entry = it->second;
+      if (entry.schema == schema && inputsEqual(entry.inputs, inputs)) {
+        // IValue copies share tensor storage, which is the point: every
+        // caller gets the same folded tensors.
+        return entry.outputs;
+      }
+    }
+    return c10::nullopt;
+  }
+
+  void insert(
+      const std::string& schema,
+      std::vector<IValue> inputs,
+      const std::vector<IValue>& outputs) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (entries_.size() >= kMaxEntries) {
+      return;
+    }
+    size_t hash = keyHash(schema, inputs);
+    auto range = entries_.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (it->second.schema == schema &&
+          inputsEqual(it->second.inputs, inputs)) {
+        return;
+      }
+    }
+    entries_.emplace(hash, Entry{schema, std::move(inputs), outputs});
+  }
+
+ private:
+  struct Entry {
+    std::string schema;
+    std::vector<IValue> inputs;
+    std::vector<IValue> outputs;
+  };
+
+  // Bound the footprint; once full, new folds simply run uncached.
+  static constexpr size_t kMaxEntries = 4096;
+
+  static size_t keyHash(
+      const std::string& schema,
+      const std::vector<IValue>& inputs) {
+    size_t hash = c10::get_hash(schema);
+    for (const IValue& input : inputs) {
+      hash = c10::hash_combine(hash, foldCacheHash(input));
+    }
+    return hash;
+  }
+
+  static bool inputsEqual(
+      const std::vector<IValue>& lhs,
+      const std::vector<IValue>& rhs) {
+    if (lhs.size() != rhs.size()) {
+      return false;
+    }
+    for (const auto i : c10::irange(lhs.size())) {
+      if (!ivaluesEqual(lhs[i], rhs[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  std::mutex mutex_;
+  std::unordered_multimap<size_t, Entry> entries_;
+};
+
+} // namespace
+
 c10::optional<std::vector<IValue>> runNodeIfInputsAreConstant(
     const Node* n,
     bool ignore_custom_classes,
@@ -80,12 +255,34 @@ c10::optional<std::vector<IValue>> runNodeIfInputsAreConstant(
         return c10::nullopt;
       }
 
+      // See Note [Constant folding cache]. Aliasing ops are excluded so a
+      // cached output can never alias a caller's value, and nondeterministic
+      // ops so a cached result cannot pin down one sample.
+      std::string schema_str;
+      std::vector<IValue> cache_inputs;
+      const bool cacheable = maybe_schema && !maybe_schema->hasAnyAliasInfo() &&
+          !n->isNondeterministic() &&
+          std::all_of(stack.begin(), stack.end(), foldCacheable);
+      if (cacheable) {
+        schema_str = toString(*maybe_schema);
+        if (auto cached = FoldCache::get().find(schema_str, stack)) {
+          stack = std::move(*cached);
+          break;
+        }
+        cache_inputs = stack;
+      }
+
       try {
         auto op = n->getOperation();
         op(stack);
       } catch (...) {
         return c10::nullopt;
       }
+
+      if (cacheable &&
+          std::all_of(stack.begin(), stack.end(), foldCacheable)) {
+        FoldCache::get().insert(schema_str, std::move(cache_inputs), stack);
+      }
     } break;
   }
 
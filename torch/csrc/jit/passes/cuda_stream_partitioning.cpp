@@ -0,0 +1,290 @@
+#include <torch/csrc/jit/passes/cuda_stream_partitioning.h>
+
+#include <c10/util/irange.h>
+#include <torch/csrc/jit/ir/alias_analysis.h>
+#include <torch/csrc/jit/jit_log.h>
+
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+// Chains shorter than this are not worth the two stream switches and the
+// two event round trips the instrumentation costs.
+constexpr size_t kMinChainLength = 3;
+
+// Sentinel chain id for values produced by nodes that stay on the main
+// stream (control flow, side-effecting ops, ops without an operator).
+constexpr int kMainStream = -1;
+
+// A maximal sequence of nodes connected by single-use values; the unit
+// of stream assignment.  preds holds the ids of the chains (or
+// kMainStream) whose values the chain consumes.
+struct StreamChain {
+  std::vector<Node*> nodes;
+  std::set<int> preds;
+};
+
+bool isPartitionableNode(Node* n) {
+  if (!n->blocks().empty()) {
+    return false;
+  }
+  if (n->kind() == prim::Constant) {
+    return false;
+  }
+  // Nodes without a registered operator (GetAttr, Param, ...) are
+  // interpreter bookkeeping, not device work; leave them alone.  Also
+  // checking this before hasSideEffects(), which asserts an operator
+  // exists for non-prim kinds.
+  if (!n->maybeOperator()) {
+    return false;
+  }
+  return !n->hasSideEffects();
+}
+
+bool typeContainsTensor(const TypePtr& type) {
+  if (type->isSubtypeOf(*TensorType::get())) {
+    return true;
+  }
+  for (const auto& contained : type->containedTypes()) {
+    if (typeContainsTensor(contained)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Decomposes the top-level block into chains.  A node extends the chain
+// of its producers when all of its in-block, non-constant producers live
+// in one chain and each of those values has no other use; any
+// divergence (a multi-use value) or convergence (producers from several
+// chains) starts a fresh chain, so sibling branches hanging off a shared
+// trunk end up in distinct chains.
+std::vector<StreamChain> buildChains(
+    Block* block,
+    std::unordered_map<Node*, int>& chain_of) {
+  std::vector<StreamChain> chains;
+  for (Node* n : block->nodes()) {
+    if (!isPartitionableNode(n)) {
+      continue;
+    }
+    std::set<int> producer_chains;
+    bool producers_single_use = true;
+    bool has_main_stream_producer = false;
+    for (Value* input : n->inputs()) {
+      Node* producer = input->node();
+      if (producer->owningBlock() != block ||
+          producer->kind() == prim::Constant) {
+        continue;
+      }
+      auto it = chain_of.find(producer);
+      if (it == chain_of.end()) {
+        has_main_stream_producer = true;
+        continue;
+      }
+      producer_chains.insert(it->second);
+      if (input->uses().size() != 1) {
+        producers_single_use = false;
+      }
+    }
+    int chain_id = 0;
+    if (producer_chains.size() == 1 && producers_single_use) {
+      chain_id = *producer_chains.begin();
+    } else {
+      chain_id = static_cast<int>(chains.size());
+      chains.emplace_back();
+      for (int pred : producer_chains) {
+        chains[chain_id].preds.insert(pred);
+      }
+    }
+    if (has_main_stream_producer) {
+      chains[chain_id].preds.insert(kMainStream);
+    }
+    chains[chain_id].nodes.push_back(n);
+    chain_of[n] = chain_id;
+  }
+  return chains;
+}
+
+// Collects the tensors crossing the chain boundary: inputs read by the
+// chain but produced elsewhere, and outputs consumed outside the chain.
+// Both sets are handed to cuda::_side_stream_end so the caching
+// allocator knows about the cross-stream uses.  Returns false if a
+// non-tensor boundary value contains tensors (e.g. a TensorList) whose
+// cross-stream lifetime we could not track.  Constants are skipped:
+// they outlive the invocation, so their blocks cannot be reused while
+// the side stream still reads them.
+bool collectBoundaryTensors(
+    const StreamChain& chain,
+    int chain_id,
+    const std::unordered_map<Node*, int>& chain_of,
+    std::vector<Value*>& inputs,
+    std::vector<Value*>& outputs) {
+  std::set<Value*> seen;
+  auto in_chain = [&](Node* n) {
+    auto it = chain_of.find(n);
+    return it != chain_of.end() && it->second == chain_id;
+  };
+  for (Node* n : chain.nodes) {
+    for (Value* input : n->inputs()) {
+      Node* producer = input->node();
+      if (in_chain(producer) || producer->kind() == prim::Constant) {
+        continue;
+      }
+      if (input->type()->isSubtypeOf(*TensorType::get())) {
+        if (seen.insert(input).second) {
+          inputs.push_back(input);
+        }
+      } else if (typeContainsTensor(input->type())) {
+        return false;
+      }
+    }
+    for (Value* output : n->outputs()) {
+      bool escapes = false;
+      for (const Use& use : output->uses()) {
+        if (!in_chain(use.user)) {
+          escapes = true;
+          break;
+        }
+      }
+      if (!escapes) {
+        continue;
+      }
+      if (output->type()->isSubtypeOf(*TensorType::get())) {
+        if (seen.insert(output).second) {
+          outputs.push_back(output);
+        }
+      } else if (typeContainsTensor(output->type())) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Packs the chain's nodes into consecutive positions (anchored at its
+// first node) so that nothing else executes between the begin and end
+// ops, i.e. on the side stream.  Bails out if some interleaved node
+// cannot be moved out of the way.
+bool makeChainContiguous(StreamChain& chain, AliasDb& alias_db) {
+  Node* prev = chain.nodes.front();
+  for (size_t i = 1; i < chain.nodes.size(); ++i) {
+    if (!alias_db.moveAfterTopologicallyValid(chain.nodes[i], prev)) {
+      return false;
+    }
+    prev = chain.nodes[i];
+  }
+  return true;
+}
+
+void instrumentChain(
+    Graph* graph,
+    const StreamChain& chain,
+    const std::vector<Value*>& inputs,
+    const std::vector<Value*>& outputs) {
+  Node* first = chain.nodes.front();
+  Node* last = chain.nodes.back();
+
+  Node* begin = graph->create(cuda::_side_stream_begin, /*num_outputs=*/1);
+  begin->output()->setType(IntType::get());
+  begin->insertBefore(first);
+
+  Node* output_list = graph->createList(TensorType::get(), outputs);
+  output_list->insertAfter(last);
+  Node* input_list = graph->createList(TensorType::get(), inputs);
+  input_list->insertAfter(output_list);
+
+  Node* end = graph->create(cuda::_side_stream_end, /*num_outputs=*/0);
+  end->addInput(output_list->output());
+  end->addInput(input_list->output());
+  end->addInput(begin->output());
+  end->insertAfter(input_list);
+}
+
+} // namespace
+
+bool CudaStreamPartitioning(
+    std::shared_ptr<Graph>& graph,
+    size_t max_side_streams) {
+  Block* block = graph->block();
+  std::unordered_map<Node*, int> chain_of;
+  std::vector<StreamChain> chains = buildChains(block, chain_of);
+
+  // Chains with the same predecessor set cannot depend on one another
+  // (an edge between two chains would show up in the consumer's preds),
+  // so each such group is a set of sibling branches that may overlap.
+  std::map<std::set<int>, std::vector<int>> groups;
+  for (const auto i : c10::irange(chains.size())) {
+    if (chains[i].nodes.size() >= kMinChainLength) {
+      groups[chains[i].preds].push_back(static_cast<int>(i));
+    }
+  }
+
+  // The first chain of every group keeps the current stream; the rest
+  // are candidates for side streams, up to max_side_streams per group.
+  std::vector<int> candidates;
+  for (const auto& group : groups) {
+    const auto& members = group.second;
+    if (members.size() < 2) {
+      continue;
+    }
+    size_t num_side = std::min(members.size() - 1, max_side_streams);
+    for (const auto i : c10::irange(num_side)) {
+      candidates.push_back(members[i + 1]);
+    }
+  }
+  if (candidates.empty()) {
+    return false;
+  }
+
+  struct Instrumentation {
+    int chain_id;
+    std::vector<Value*> inputs;
+    std::vector<Value*> outputs;
+  };
+  std::vector<Instrumentation> to_instrument;
+  AliasDb alias_db(graph);
+  for (int chain_id : candidates) {
+    Instrumentation inst;
+    inst.chain_id = chain_id;
+    if (!collectBoundaryTensors(
+            chains[chain_id], chain_id, chain_of, inst.inputs, inst.outputs)) {
+      GRAPH_DEBUG(
+          "Chain starting at ",
+          getHeader(chains[chain_id].nodes.front()),
+          " has an untrackable boundary value; leaving it on the main stream");
+      continue;
+    }
+    if (!makeChainContiguous(chains[chain_id], alias_db)) {
+      GRAPH_DEBUG(
+          "Could not make the chain starting at ",
+          getHeader(chains[chain_id].nodes.front()),
+          " contiguous; leaving it on the main stream");
+      continue;
+    }
+    to_instrument.push_back(std::move(inst));
+  }
+
+  // All moves are done; it is now safe to insert nodes the AliasDb does
+  // not know about.
+  for (const auto& inst : to_instrument) {
+    GRAPH_UPDATE(
+        "Assigning ",
+        chains[inst.chain_id].nodes.size(),
+        " nodes starting at ",
+        getHeader(chains[inst.chain_id].nodes.front()),
+        " to a side CUDA stream");
+    instrumentChain(
+        graph.get(), chains[inst.chain_id], inst.inputs, inst.outputs);
+  }
+  GRAPH_DUMP("After CudaStreamPartitioning: ", graph);
+  return !to_instrument.empty();
+}
+
+} // namespace jit
+} // namespace torch
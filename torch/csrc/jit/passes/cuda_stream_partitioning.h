@@ -0,0 +1,31 @@
+#pragma once
+
+#include <torch/csrc/jit/ir/ir.h>
+
+namespace torch {
+namespace jit {
+
+// Partitions independent chains of nodes in the top-level block of the
+// graph onto side CUDA streams so that their kernels can overlap on the
+// device.  Chains that share no data dependency (e.g. the heads of a
+// multi-branch detection model) are each wrapped in a pair of
+// cuda::_side_stream_begin / cuda::_side_stream_end operators; the begin
+// op switches the interpreter thread to a pool stream ordered after the
+// work already queued on the current stream, and the end op joins back
+// with an event, so no explicit synchronization is needed in the model.
+//
+// The pass is an explicit, per-module opt-in: call it on the forward
+// graph of a scripted module running on CUDA (typically after freezing),
+// e.g. torch._C._jit_pass_cuda_stream_partitioning(module.graph).  It is
+// not part of the default optimization pipeline, and the operators it
+// emits are only registered in CUDA builds.
+//
+// max_side_streams bounds how many chains of any one parallel group are
+// moved off the current stream; remaining chains stay where they are.
+// Returns true if the graph was modified.
+TORCH_API bool CudaStreamPartitioning(
+    std::shared_ptr<Graph>& graph,
+    size_t max_side_streams = 3);
+
+} // namespace jit
+} // namespace torch
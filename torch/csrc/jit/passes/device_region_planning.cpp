@@ -0,0 +1,196 @@
+#include <torch/csrc/jit/passes/device_region_planning.h>
+
+#include <c10/util/irange.h>
+#include <torch/csrc/jit/ir/alias_analysis.h>
+#include <torch/csrc/jit/jit_log.h>
+
+#include <unordered_map>
+#include <vector>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+// Packs of fewer transfers gain nothing from a stream switch and the
+// two event round trips it costs.
+constexpr size_t kMinSideStreamPack = 2;
+
+c10::optional<c10::Device> valueDevice(Value* v) {
+  if (auto tensor_type = v->type()->cast<TensorType>()) {
+    return tensor_type->device();
+  }
+  return c10::nullopt;
+}
+
+// The device a node computes on, read off its tensor outputs (falling
+// back to tensor inputs for ops that only consume tensors).  Nodes
+// without any device-typed tensors - constants, string and list
+// bookkeeping, ops the profiler has not seen - report nullopt and are
+// transparent to region building.
+c10::optional<c10::Device> nodeDevice(Node* n) {
+  for (Value* output : n->outputs()) {
+    if (auto device = valueDevice(output)) {
+      return device;
+    }
+  }
+  for (Value* input : n->inputs()) {
+    if (auto device = valueDevice(input)) {
+      return device;
+    }
+  }
+  return c10::nullopt;
+}
+
+// A transfer node moves one tensor across devices: aten::to with a
+// profiled device change, or the aten::cpu / aten::cuda sugar.
+bool isCrossDeviceTransfer(Node* n) {
+  if (n->kind() != aten::to && n->kind() != aten::cpu &&
+      n->kind() != aten::cuda) {
+    return false;
+  }
+  if (n->inputs().empty() || n->outputs().size() != 1) {
+    return false;
+  }
+  auto src = valueDevice(n->input(0));
+  auto dst = valueDevice(n->output());
+  return src.has_value() && dst.has_value() && *src != *dst;
+}
+
+// A maximal run of nodes on one device; transfers count as the first
+// nodes of their destination region.
+struct DeviceRegion {
+  c10::Device device = c10::Device(c10::DeviceType::CPU);
+  std::vector<Node*> transfers;
+};
+
+std::vector<DeviceRegion> buildRegions(Block* block) {
+  std::vector<DeviceRegion> regions;
+  for (Node* n : block->nodes()) {
+    c10::optional<c10::Device> device;
+    if (isCrossDeviceTransfer(n)) {
+      device = valueDevice(n->output());
+    } else {
+      device = nodeDevice(n);
+    }
+    if (!device.has_value()) {
+      continue;
+    }
+    if (regions.empty() || regions.back().device != *device) {
+      regions.emplace_back();
+      regions.back().device = *device;
+    }
+    if (isCrossDeviceTransfer(n)) {
+      regions.back().transfers.push_back(n);
+    }
+  }
+  return regions;
+}
+
+// Packs the region's incoming transfers adjacent at the earliest of
+// them, so the copies are issued back-to-back.  Transfers that cannot
+// be moved (e.g. their producer sits between two earlier transfers)
+// stay where they are and drop out of the pack.
+std::vector<Node*> packTransfers(DeviceRegion& region, AliasDb& alias_db) {
+  std::vector<Node*> pack;
+  pack.push_back(region.transfers.front());
+  for (const auto i : c10::irange(1u, region.transfers.size())) {
+    Node* transfer = region.transfers[i];
+    if (alias_db.moveAfterTopologicallyValid(transfer, pack.back())) {
+      pack.push_back(transfer);
+    }
+  }
+  return pack;
+}
+
+void wrapPackInSideStream(Graph* graph, const std::vector<Node*>& pack) {
+  Node* first = pack.front();
+  Node* last = pack.back();
+
+  std::vector<Value*> inputs;
+  std::vector<Value*> outputs;
+  for (Node* transfer : pack) {
+    inputs.push_back(transfer->input(0));
+    outputs.push_back(transfer->output());
+  }
+
+  Node* begin = graph->create(cuda::_side_stream_begin, /*num_outputs=*/1);
+  begin->output()->setType(IntType::get());
+  begin->insertBefore(first);
+
+  Node* output_list = graph->createList(TensorType::get(), outputs);
+  output_list->insertAfter(last);
+  Node* input_list = graph->createList(TensorType::get(), inputs);
+  input_list->insertAfter(output_list);
+
+  Node* end = graph->create(cuda::_side_stream_end, /*num_outputs=*/0);
+  end->addInput(output_list->output());
+  end->addInput(input_list->output());
+  end->addInput(begin->output());
+  end->insertAfter(input_list);
+}
+
+bool packInvolvesCuda(const DeviceRegion& region, const std::vector<Node*>& pack) {
+  if (region.device.is_cuda()) {
+    return true;
+  }
+  for (Node* transfer : pack) {
+    auto src = valueDevice(transfer->input(0));
+    if (src.has_value() && src->is_cuda()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+} // namespace
+
+bool DeviceRegionPlanning(std::shared_ptr<Graph>& graph, bool use_side_streams) {
+  std::vector<DeviceRegion> regions = buildRegions(graph->block());
+
+  bool modified = false;
+  AliasDb alias_db(graph);
+  std::vector<std::pair<const DeviceRegion*, std::vector<Node*>>> to_wrap;
+  for (auto& region : regions) {
+    if (region.transfers.size() < 2) {
+      continue;
+    }
+    std::vector<Node*> pack = packTransfers(region, alias_db);
+    if (pack.size() > 1) {
+      modified = true;
+      GRAPH_UPDATE(
+          "Coalesced ",
+          pack.size(),
+          " of ",
+          region.transfers.size(),
+          " transfers into the ",
+          region.device.str(),
+          " region entered at ",
+          getHeader(pack.front()));
+    }
+    if (use_side_streams && pack.size() >= kMinSideStreamPack &&
+        packInvolvesCuda(region, pack)) {
+      to_wrap.emplace_back(&region, std::move(pack));
+    }
+  }
+
+  // All moves are done; it is now safe to insert nodes the AliasDb does
+  // not know about.
+  for (const auto& entry : to_wrap) {
+    GRAPH_UPDATE(
+        "Moving the ",
+        entry.second.size(),
+        "-transfer pack of the ",
+        entry.first->device.str(),
+        " region onto a side CUDA stream");
+    wrapPackInSideStream(graph.get(), entry.second);
+    modified = true;
+  }
+  if (modified) {
+    GRAPH_DUMP("After DeviceRegionPlanning: ", graph);
+  }
+  return modified;
+}
+
+} // namespace jit
+} // namespace torch
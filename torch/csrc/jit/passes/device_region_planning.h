@@ -0,0 +1,42 @@
+#pragma once
+
+#include <torch/csrc/jit/ir/ir.h>
+
+namespace torch {
+namespace jit {
+
+// Plans the device boundaries of a mixed CPU/GPU graph.  Graphs that
+// interleave host ops (string features, list bookkeeping) with device
+// math cross the PCIe bus through aten::to / aten::cpu / aten::cuda
+// calls scattered wherever the model author wrote them, so execution
+// serializes into a ping-pong of tiny transfers and short compute
+// stretches.
+//
+// The pass splits the top-level block into device regions - maximal runs
+// of nodes whose tensors live on one device, read off the profiled
+// TensorType device info (run DeviceTypePropagation first if the graph
+// has none) - and rewrites each region crossing into a single coalesced
+// transfer point: all cross-device transfers feeding a region are packed
+// adjacent at the earliest of them, so the copies are issued
+// back-to-back instead of one at a time between ops.  Packs of two or
+// more transfers with a CUDA side are additionally wrapped in the
+// cuda::_side_stream_begin / cuda::_side_stream_end operators emitted by
+// the CudaStreamPartitioning pass, which moves the copy pack onto a pool
+// stream so the compute stream runs ahead; pass use_side_streams=false
+// to keep everything on the current stream (e.g. in CPU-only builds,
+// where the cuda:: operators are not registered).  Transfers still
+// overlap best when the model uses non_blocking=True with pinned hosts;
+// the pass does not change the blocking mode of a copy.
+//
+// Like CudaStreamPartitioning this is an explicit, per-module opt-in:
+// torch._C._jit_pass_device_region_planning(module.graph).  Node
+// placement itself is not changed - TorchScript states placement
+// explicitly and relocating compute would need shape-aware cost
+// estimates the JIT does not have - only where and how the boundary
+// transfers execute.  Returns true if the graph was modified.
+TORCH_API bool DeviceRegionPlanning(
+    std::shared_ptr<Graph>& graph,
+    bool use_side_streams = true);
+
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,139 @@
+#include <torch/csrc/jit/passes/fuse_pointwise_chains.h>
+
+#include <torch/csrc/jit/ir/ir.h>
+#include <torch/csrc/jit/ir/subgraph_matcher.h>
+#include <torch/csrc/jit/passes/subgraph_rewrite.h>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+// True when the pattern variable `name` matched a Tensor-typed value.
+// aten::mul/aten::div/aten::add have Scalar overloads with the same
+// arity, and the matcher matches by name and arity only, so the tensor
+// patterns below must check this explicitly.
+bool matchedValueIsTensor(
+    const Match& match,
+    const std::unordered_map<std::string, Value*>& vmap,
+    const char* name) {
+  const auto& match_vmap = match.values_map;
+  return match_vmap.at(vmap.at(name))
+      ->type()
+      ->isSubtypeOf(*TensorType::get());
+}
+
+// True when the intermediate matched by `name` feeds only the chain
+// being rewritten. If it has other consumers we must keep the unfused
+// op around, so fusing would not remove a dispatch and may duplicate
+// work.
+bool matchedValueHasSingleUse(
+    const Match& match,
+    const std::unordered_map<std::string, Value*>& vmap,
+    const char* name) {
+  const auto& match_vmap = match.values_map;
+  return match_vmap.at(vmap.at(name))->uses().size() == 1;
+}
+
+void fuseSelfGatedActivations(std::shared_ptr<Graph>& graph) {
+  SubgraphRewriter rewriter;
+
+  // x * sigmoid(x) -> silu(x)
+  std::string sigmoid_mul_0 = R"(
+    graph(%x):
+        %s = aten::sigmoid(%x)
+        %res = aten::mul(%x, %s)
+        return (%res))";
+  std::string sigmoid_mul_1 = R"(
+    graph(%x):
+        %s = aten::sigmoid(%x)
+        %res = aten::mul(%s, %x)
+        return (%res))";
+  std::string silu_fused = R"(
+    graph(%x):
+        %res = aten::silu(%x)
+        return (%res))";
+  rewriter.RegisterRewritePattern(sigmoid_mul_0, silu_fused);
+  rewriter.RegisterRewritePattern(sigmoid_mul_1, silu_fused);
+
+  // x * hardsigmoid(x) -> hardswish(x)
+  std::string hardsigmoid_mul_0 = R"(
+    graph(%x):
+        %s = aten::hardsigmoid(%x)
+        %res = aten::mul(%x, %s)
+        return (%res))";
+  std::string hardsigmoid_mul_1 = R"(
+    graph(%x):
+        %s = aten::hardsigmoid(%x)
+        %res = aten::mul(%s, %x)
+        return (%res))";
+  std::string hardswish_fused = R"(
+    graph(%x):
+        %res = aten::hardswish(%x)
+        return (%res))";
+  rewriter.RegisterRewritePattern(hardsigmoid_mul_0, hardswish_fused);
+  rewriter.RegisterRewritePattern(hardsigmoid_mul_1, hardswish_fused);
+
+  auto gate_is_private = [](const Match& match,
+                            const std::unordered_map<std::string, Value*>&
+                                vmap) {
+    return matchedValueHasSingleUse(match, vmap, "s");
+  };
+  rewriter.runOnGraph(graph, gate_is_private);
+}
+
+void fuseMulDivAddChains(std::shared_ptr<Graph>& graph) {
+  SubgraphRewriter rewriter;
+
+  // a + alpha * (b * c) -> addcmul(a, b, c, alpha)
+  std::string mul_add = R"(
+    graph(%a, %b, %c, %alpha):
+        %t = aten::mul(%b, %c)
+        %res = aten::add(%a, %t, %alpha)
+        return (%res))";
+  std::string addcmul_fused = R"(
+    graph(%a, %b, %c, %alpha):
+        %res = aten::addcmul(%a, %b, %c, %alpha)
+        return (%res))";
+  rewriter.RegisterRewritePattern(mul_add, addcmul_fused);
+
+  // a + alpha * (b / c) -> addcdiv(a, b, c, alpha)
+  std::string div_add = R"(
+    graph(%a, %b, %c, %alpha):
+        %t = aten::div(%b, %c)
+        %res = aten::add(%a, %t, %alpha)
+        return (%res))";
+  std::string addcdiv_fused = R"(
+    graph(%a, %b, %c, %alpha):
+        %res = aten::addcdiv(%a, %b, %c, %alpha)
+        return (%res))";
+  rewriter.RegisterRewritePattern(div_add, addcdiv_fused);
+
+  auto all_tensor_private_intermediate =
+      [](const Match& match,
+         const std::unordered_map<std::string, Value*>& vmap) {
+        return matchedValueIsTensor(match, vmap, "a") &&
+            matchedValueIsTensor(match, vmap, "b") &&
+            matchedValueIsTensor(match, vmap, "c") &&
+            matchedValueHasSingleUse(match, vmap, "t");
+      };
+  rewriter.runOnGraph(graph, all_tensor_private_intermediate);
+}
+
+void fusePointwiseChainsImpl(std::shared_ptr<Graph>& graph) {
+  fuseSelfGatedActivations(graph);
+  fuseMulDivAddChains(graph);
+}
+
+} // namespace
+
+void FusePointwiseChains(script::Module& module) {
+  auto graph = module.get_method("forward").graph();
+  fusePointwiseChainsImpl(graph);
+}
+
+void FusePointwiseChains(std::shared_ptr<Graph>& graph) {
+  fusePointwiseChainsImpl(graph);
+}
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <torch/csrc/jit/api/module.h>
+#include <torch/csrc/jit/ir/ir.h>
+
+namespace torch {
+namespace jit {
+// Collapses recognized chains of pointwise ops into the single fused
+// kernels ATen already ships (silu, hardswish, addcmul, addcdiv), so
+// interpreters that pay a full dispatcher call per op — most notably the
+// mobile bytecode interpreter — execute one call per chain. Intended to
+// run at export time as part of optimizeForMobile.
+TORCH_API void FusePointwiseChains(script::Module& module);
+TORCH_API void FusePointwiseChains(std::shared_ptr<Graph>& graph);
+} // namespace jit
+} // namespace torch
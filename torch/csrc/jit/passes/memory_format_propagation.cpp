@@ -0,0 +1,113 @@
+#include <torch/csrc/jit/passes/memory_format_propagation.h>
+
+#include <c10/core/MemoryFormat.h>
+#include <torch/csrc/jit/ir/ir.h>
+
+#include <atomic>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+std::atomic<uint64_t> conversions_eliminated{0};
+
+// Ops whose output is contiguous in the same memory format as their
+// first input whenever that input is format-contiguous: in-place ops
+// return their input, and out-of-place unary pointwise ops take their
+// layout from the (sole) tensor input via TensorIterator. Binary ops are
+// deliberately absent — broadcasting resolves the output layout from
+// both operands.
+bool preservesMemoryFormat(const Node* node) {
+  static const std::unordered_set<Symbol> format_preserving = {
+      aten::relu,        aten::relu_,      aten::relu6,
+      aten::sigmoid,     aten::sigmoid_,   aten::tanh,
+      aten::tanh_,       aten::hardsigmoid, aten::hardsigmoid_,
+      aten::hardswish,   aten::hardswish_, aten::hardtanh,
+      aten::hardtanh_,   aten::silu,       aten::silu_,
+      aten::gelu,        aten::leaky_relu, aten::leaky_relu_,
+      aten::neg,         aten::abs,        aten::exp,
+      aten::log,         aten::sqrt,       aten::rsqrt,
+      aten::clamp,       aten::clamp_,     aten::dropout,
+  };
+  return format_preserving.count(node->kind()) != 0 &&
+      node->outputs().size() == 1;
+}
+
+// Extracts a constant, non-None memory format from `v`, if there is one.
+c10::optional<c10::MemoryFormat> constantMemoryFormat(Value* v) {
+  auto ival = toIValue(v);
+  if (!ival || !ival->isInt()) {
+    return c10::nullopt;
+  }
+  return static_cast<c10::MemoryFormat>(ival->toInt());
+}
+
+size_t processBlock(
+    Block* block,
+    std::unordered_map<Value*, c10::MemoryFormat>& known) {
+  size_t removed = 0;
+  for (auto it = block->nodes().begin(); it != block->nodes().end(); ++it) {
+    Node* node = *it;
+    for (Block* sub : node->blocks()) {
+      // SSA dominance makes the outer facts valid inside the block; facts
+      // established inside stay keyed to values that are invisible
+      // outside, so sharing one map is sound.
+      removed += processBlock(sub, known);
+    }
+
+    if (node->kind() == aten::contiguous && node->inputs().size() == 2) {
+      auto format = constantMemoryFormat(node->input(1));
+      if (!format) {
+        continue;
+      }
+      auto input_it = known.find(node->input(0));
+      if (input_it != known.end() && input_it->second == *format) {
+        // Already contiguous in the requested format: at runtime
+        // contiguous() would return its input unchanged, so the call is
+        // pure overhead (a dispatch plus an is_contiguous walk).
+        node->output()->replaceAllUsesWith(node->input(0));
+        it.destroyCurrent();
+        removed++;
+        continue;
+      }
+      known[node->output()] = *format;
+      continue;
+    }
+
+    if (node->kind() == aten::clone && node->inputs().size() == 2) {
+      auto format = constantMemoryFormat(node->input(1));
+      if (format && *format != c10::MemoryFormat::Preserve) {
+        known[node->output()] = *format;
+      }
+      continue;
+    }
+
+    if (preservesMemoryFormat(node)) {
+      auto input_it = known.find(node->input(0));
+      if (input_it != known.end()) {
+        known[node->output()] = input_it->second;
+      }
+      continue;
+    }
+  }
+  return removed;
+}
+
+} // namespace
+
+size_t PropagateMemoryFormat(const std::shared_ptr<Graph>& graph) {
+  std::unordered_map<Value*, c10::MemoryFormat> known;
+  const size_t removed = processBlock(graph->block(), known);
+  conversions_eliminated.fetch_add(removed, std::memory_order_relaxed);
+  return removed;
+}
+
+uint64_t numMemoryFormatConversionsEliminated() {
+  return conversions_eliminated.load(std::memory_order_relaxed);
+}
+
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <torch/csrc/jit/ir/ir.h>
+
+namespace torch {
+namespace jit {
+
+// Propagates statically known memory formats through the graph and
+// removes aten::contiguous calls whose input is already guaranteed to be
+// contiguous in the requested format. Formats are seeded by explicit
+// conversions (contiguous/clone/to with an explicit memory_format) and
+// flow through format-preserving pointwise ops; anything else resets to
+// unknown, so the pass never removes a conversion that could copy at
+// runtime. Returns the number of conversions removed from this graph.
+TORCH_API size_t PropagateMemoryFormat(const std::shared_ptr<Graph>& graph);
+
+// Process-wide count of conversions removed by PropagateMemoryFormat,
+// for regression tracking in serving metrics.
+TORCH_API uint64_t numMemoryFormatConversionsEliminated();
+
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,173 @@
+#include <torch/csrc/jit/passes/reinplace.h>
+
+#include <ATen/core/jit_type.h>
+#include <ATen/core/symbol.h>
+#include <torch/csrc/jit/ir/alias_analysis.h>
+#include <torch/csrc/jit/passes/remove_mutation.h>
+#include <torch/csrc/jit/runtime/operator.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+class Reinplacer {
+ public:
+  explicit Reinplacer(std::shared_ptr<Graph> graph)
+      : graph_(std::move(graph)) {}
+
+  bool run() {
+    return processBlock(graph_->block());
+  }
+
+ private:
+  AliasDb* getOrCreateAliasDb() {
+    if (!aliasDb_) {
+      aliasDb_ = std::make_unique<AliasDb>(graph_);
+    }
+    return aliasDb_.get();
+  }
+
+  // Returns true if an operator named `inplace_sym` is registered that
+  // writes its first argument and takes the same argument types as `node`.
+  bool hasInplaceVariant(Node* node, Symbol inplace_sym) {
+    const FunctionSchema& schema = node->schema();
+    for (const auto& op : getAllOperatorsFor(inplace_sym)) {
+      const FunctionSchema& inplace_schema = op->schema();
+      if (inplace_schema.arguments().size() != schema.arguments().size() ||
+          inplace_schema.returns().size() != 1) {
+        continue;
+      }
+      const AliasInfo* self_alias = inplace_schema.arguments()[0].alias_info();
+      bool match = self_alias != nullptr && self_alias->isWrite();
+      for (size_t i = 0; match && i < schema.arguments().size(); ++i) {
+        match = *inplace_schema.arguments()[i].type() ==
+            *schema.arguments()[i].type();
+      }
+      if (match) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool canReinplace(Node* node) {
+    if (!node->kind().is_aten() || node->maybeSchema() == nullptr) {
+      return false;
+    }
+    const FunctionSchema& schema = node->schema();
+    if (schema.is_mutable() || node->outputs().size() != 1 ||
+        node->inputs().empty()) {
+      return false;
+    }
+    Value* input = node->inputs().at(0);
+    Value* output = node->output();
+    auto input_type = input->type()->cast<TensorType>();
+    auto output_type = output->type()->cast<TensorType>();
+    if (!input_type || !output_type) {
+      return false;
+    }
+
+    // The in-place variant writes the result into the input's buffer, so
+    // the output must match it exactly: same dtype (no type promotion),
+    // same sizes (no broadcasting against a larger operand), same device.
+    if (!input_type->scalarType() || !output_type->scalarType() ||
+        *input_type->scalarType() != *output_type->scalarType()) {
+      return false;
+    }
+    auto input_sizes = input_type->sizes().concrete_sizes();
+    auto output_sizes = output_type->sizes().concrete_sizes();
+    if (!input_sizes || !output_sizes || *input_sizes != *output_sizes) {
+      return false;
+    }
+    if (input_type->device() != output_type->device()) {
+      return false;
+    }
+
+    // A value captured from an enclosing block may be read again on a later
+    // loop iteration (or after an if), so writing into it is observable
+    // outside this block even when this node is its only use.
+    if (input->node()->owningBlock() != node->owningBlock()) {
+      return false;
+    }
+
+    // The input must be uniquely owned by its producer; this rejects graph
+    // inputs, constants and values that alias their def node's inputs.
+    if (MutationRemover::hasSideEffectOrAlias(input, getOrCreateAliasDb())) {
+      return false;
+    }
+
+    // The input buffer must be dead after this node: every other use must
+    // happen before it, in the same block, and must not hand out an alias
+    // that could observe the write.
+    for (const Use& use : input->uses()) {
+      Node* user = use.user;
+      if (user == node) {
+        continue;
+      }
+      if (user->owningBlock() != node->owningBlock() ||
+          !user->isBefore(node)) {
+        return false;
+      }
+      for (Value* user_output : user->outputs()) {
+        if (getOrCreateAliasDb()->mayContainAlias(input, user_output)) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  bool processBlock(Block* block) {
+    bool changed = false;
+    for (auto it = block->nodes().begin(); it != block->nodes().end();) {
+      Node* node = *it;
+      it++;
+
+      for (Block* sub_block : node->blocks()) {
+        changed |= processBlock(sub_block);
+      }
+
+      if (!canReinplace(node)) {
+        continue;
+      }
+      Symbol inplace_sym =
+          Symbol::fromQualString(node->schema().name() + "_");
+      if (!hasInplaceVariant(node, inplace_sym)) {
+        continue;
+      }
+
+      changed = true;
+      Node* inplace_node = node->replaceWithNewSymbol(inplace_sym);
+      inplace_node->output()->replaceAllUsesWith(node->inputs().at(0));
+      getOrCreateAliasDb()->replaceWithNewValue(
+          node->output(), inplace_node->output());
+
+      node->destroy();
+    }
+    return changed;
+  }
+
+  std::unique_ptr<AliasDb> aliasDb_ = nullptr;
+  std::shared_ptr<Graph> graph_;
+};
+
+} // namespace
+
+bool ReinplaceOps(const std::shared_ptr<Graph>& graph) {
+  Reinplacer reinplacer(graph);
+  return reinplacer.run();
+}
+
+bool FunctionalizeThenReinplace(const std::shared_ptr<Graph>& graph) {
+  bool changed = RemoveTensorMutation(graph);
+  changed |= ReinplaceOps(graph);
+  return changed;
+}
+
+} // namespace jit
+} // namespace torch
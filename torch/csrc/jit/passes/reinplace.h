@@ -0,0 +1,25 @@
+#pragma once
+
+#include <torch/csrc/Export.h>
+#include <torch/csrc/jit/ir/ir.h>
+
+namespace torch {
+namespace jit {
+
+// Converts out-of-place aten ops to their registered in-place variants when
+// liveness and aliasing prove it safe: the first input must be uniquely
+// owned by its producer, dead after the node, and match the output's dtype,
+// sizes and device, so the result can reuse the input's storage. This is
+// the general form of FunctionalToInplaceActivation (restore_mutation.h)
+// and relies on profiled or traced type information; nodes without concrete
+// shapes are left alone. Returns true if the graph was changed.
+TORCH_API bool ReinplaceOps(const std::shared_ptr<Graph>& graph);
+
+// The usual inference bundle: first rewrites existing mutation out of the
+// graph (RemoveTensorMutation), normalizing it for other optimization
+// passes, then runs ReinplaceOps so the served graph reuses dead buffers
+// instead of allocating fresh ones. Returns true if the graph was changed.
+TORCH_API bool FunctionalizeThenReinplace(const std::shared_ptr<Graph>& graph);
+
+} // namespace jit
+} // namespace torch
@@ -10,6 +10,7 @@
 #include <torch/csrc/jit/ir/alias_analysis.h>
 #include <torch/csrc/jit/jit_log.h>
 #include <torch/csrc/jit/jit_opt_limit.h>
+#include <torch/csrc/jit/passes/canonicalize.h>
 #include <torch/csrc/jit/passes/common_subexpression_elimination.h>
 #include <torch/csrc/jit/passes/constant_pooling.h>
 #include <torch/csrc/jit/passes/dead_code_elimination.h>
@@ -25,6 +26,11 @@
 #include <torch/csrc/jit/tensorexpr/kernel.h>
 #include <torch/csrc/utils/memory.h>
 
+#include <list>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+
 // NOLINTNEXTLINE
 C10_DEFINE_bool(
     torch_jit_disable_cat,
@@ -1316,12 +1322,161 @@ void FuseTensorExprs(
   GRAPH_DUMP("After TExprFuser: ", graph);
 }
 
+namespace {
+
+// Note [TE kernel cache]
+// ~~~~~~~~~~~~~~~~~~~~~~
+// Compiled kernels used to be cached only on the fusion-group node that
+// created them: the Operation closure returned below holds the kernel, and
+// when a graph is re-specialized for a new shape bucket or a module is
+// cloned, the node is rebuilt and the kernel recompiled from scratch.  A
+// dynamic-shape service thus recompiles the same per-bucket kernels over
+// and over.
+//
+// This cache is global and bounded (LRU).  The key is everything
+// createTensorExprOp feeds the kernel constructor: the canonicalized
+// subgraph printed with its specialized tensor types - which carry the
+// shape bucket, dtype and device - plus the dynamic-fusion node attributes
+// (symbolic shape indices and striding descriptors).  Identical
+// specializations across graph instances and re-specializations therefore
+// share one compiled kernel.  Kernels are stateless after compilation, so
+// sharing is safe; node-local caching already shares one kernel object
+// across concurrent interpreter invocations of its node.
+constexpr size_t kDefaultKernelCacheMaxSize = 1024;
+
+class TensorExprKernelCache {
+ public:
+  static TensorExprKernelCache& instance() {
+    static TensorExprKernelCache cache;
+    return cache;
+  }
+
+  std::shared_ptr<tensorexpr::TensorExprKernel> lookup(
+      const std::string& key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+      ++misses_;
+      return nullptr;
+    }
+    ++hits_;
+    // Move to the front of the LRU list.
+    lru_.splice(lru_.begin(), lru_, it->second.second);
+    return it->second.first;
+  }
+
+  void insert(
+      const std::string& key,
+      const std::shared_ptr<tensorexpr::TensorExprKernel>& kernel) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (max_size_ == 0 || entries_.count(key)) {
+      return;
+    }
+    lru_.push_front(key);
+    entries_.emplace(key, std::make_pair(kernel, lru_.begin()));
+    evictLocked();
+  }
+
+  void setMaxSize(size_t max_size) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    max_size_ = max_size;
+    evictLocked();
+  }
+
+  TensorExprKernelCacheStats stats() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    TensorExprKernelCacheStats result;
+    result.hits = hits_;
+    result.misses = misses_;
+    result.size = entries_.size();
+    return result;
+  }
+
+ private:
+  TensorExprKernelCache() = default;
+
+  void evictLocked() {
+    while (entries_.size() > max_size_) {
+      entries_.erase(lru_.back());
+      lru_.pop_back();
+    }
+  }
+
+  std::mutex mutex_;
+  size_t max_size_ = kDefaultKernelCacheMaxSize;
+  size_t hits_ = 0;
+  size_t misses_ = 0;
+  // Most recently used keys first.
+  std::list<std::string> lru_;
+  std::unordered_map<
+      std::string,
+      std::pair<
+          std::shared_ptr<tensorexpr::TensorExprKernel>,
+          std::list<std::string>::iterator>>
+      entries_;
+};
+
+std::string kernelCacheKey(const Node* node) {
+  std::stringstream key;
+  key << Canonicalize(node->g(attr::Subgraph), /*keep_unique_names=*/false)
+             ->toString(/*print_source_locations=*/false);
+  if (node->hasAttribute(attr::symbolic_shape_inputs)) {
+    key << "symbolic_shape_inputs=";
+    for (int64_t sym_shape : node->is(attr::symbolic_shape_inputs)) {
+      key << sym_shape << ",";
+    }
+    key << "\n";
+  }
+  if (node->hasAttribute(attr::striding_inputs_desc)) {
+    key << "striding_inputs_desc=";
+    for (const auto& descs : node->ival(attr::striding_inputs_desc)
+                                 .to<std::vector<std::vector<std::string>>>()) {
+      for (const std::string& desc : descs) {
+        key << desc << ",";
+      }
+      key << ";";
+    }
+    key << "\n";
+  }
+  if (node->hasAttribute(attr::striding_outputs_desc)) {
+    key << "striding_outputs_desc=";
+    for (const std::string& desc : node->ival(attr::striding_outputs_desc)
+                                       .to<std::vector<std::string>>()) {
+      key << desc << ",";
+    }
+    key << "\n";
+  }
+  if (node->hasAttribute(attr::allow_stack_outputs)) {
+    key << "allow_stack_outputs=" << node->i(attr::allow_stack_outputs)
+        << "\n";
+  }
+  return key.str();
+}
+
+} // namespace
+
+TensorExprKernelCacheStats getTensorExprKernelCacheStats() {
+  return TensorExprKernelCache::instance().stats();
+}
+
+void setTensorExprKernelCacheMaxSize(size_t max_size) {
+  TensorExprKernelCache::instance().setMaxSize(max_size);
+}
+
 Operation createTensorExprOp(const Node* node) {
+  // See Note [TE kernel cache].
+  const std::string cache_key = kernelCacheKey(node);
+  std::shared_ptr<tensorexpr::TensorExprKernel> kernel =
+      TensorExprKernelCache::instance().lookup(cache_key);
+
   bool dynamic_shape_fusion_node =
       node->hasAttribute(attr::striding_inputs_desc);
   if (!dynamic_shape_fusion_node) {
-    auto kernel =
-        std::make_shared<tensorexpr::TensorExprKernel>(node->g(attr::Subgraph));
+    if (!kernel) {
+      kernel = std::make_shared<tensorexpr::TensorExprKernel>(
+          node->g(attr::Subgraph));
+      TensorExprKernelCache::instance().insert(cache_key, kernel);
+    }
     return [kernel](Stack& stack) {
       RECORD_FUNCTION(kernel->getKernelName(), std::vector<c10::IValue>());
       kernel->run(stack);
@@ -1330,58 +1485,61 @@ Operation createTensorExprOp(const Node* node) {
   }
 
   // Handle the case when dynamic shape fusion is enabled.
-  VLOG(1) << "Compiling a new kernel for " << *node;
-  std::vector<int64_t> sym_shapes;
-  if (node->hasAttribute(attr::symbolic_shape_inputs)) {
-    sym_shapes = node->is(attr::symbolic_shape_inputs);
-  }
   bool allow_stack_outputs = false;
   if (node->hasAttribute(attr::allow_stack_outputs)) {
     allow_stack_outputs = node->i(attr::allow_stack_outputs) == 1;
   }
-
-  std::unordered_map<c10::Symbol, tensorexpr::NNCLoweringFunction>
-      custom_lowerings;
   auto subgraph = node->g(attr::Subgraph);
-  IValue sym_strides = node->ival(attr::striding_inputs_desc);
-
-  // Striding Descriptor is serialized on the node as a vector of vector of
-  // strings, translate back to StrideInput enum
-  std::vector<std::vector<std::string>> sym_strides_strs =
-      sym_strides.to<std::vector<std::vector<std::string>>>();
-  std::vector<std::vector<StrideInput>> striding_inputs;
-  for (const auto& vec : sym_strides_strs) {
-    std::vector<StrideInput> input_desc;
-    input_desc.reserve(vec.size());
-    for (const std::string& str : vec) {
-      input_desc.push_back(strideInputFromString(str));
-    }
-    striding_inputs.push_back(input_desc);
-  }
-  std::unordered_map<const Value*, std::vector<StrideInput>> stride_map;
-  size_t index = 0;
-  for (Value* v : subgraph->inputs()) {
-    if (!v->type()->cast<TensorType>()) {
-      continue;
+
+  if (!kernel) {
+    VLOG(1) << "Compiling a new kernel for " << *node;
+    std::vector<int64_t> sym_shapes;
+    if (node->hasAttribute(attr::symbolic_shape_inputs)) {
+      sym_shapes = node->is(attr::symbolic_shape_inputs);
+    }
+
+    std::unordered_map<c10::Symbol, tensorexpr::NNCLoweringFunction>
+        custom_lowerings;
+    IValue sym_strides = node->ival(attr::striding_inputs_desc);
+
+    // Striding Descriptor is serialized on the node as a vector of vector of
+    // strings, translate back to StrideInput enum
+    std::vector<std::vector<std::string>> sym_strides_strs =
+        sym_strides.to<std::vector<std::vector<std::string>>>();
+    std::vector<std::vector<StrideInput>> striding_inputs;
+    for (const auto& vec : sym_strides_strs) {
+      std::vector<StrideInput> input_desc;
+      input_desc.reserve(vec.size());
+      for (const std::string& str : vec) {
+        input_desc.push_back(strideInputFromString(str));
+      }
+      striding_inputs.push_back(input_desc);
     }
-    stride_map[v] = striding_inputs[index];
-    index++;
-  }
-  std::vector<std::string> output_desc =
-      node->ival(attr::striding_outputs_desc).to<std::vector<std::string>>();
-  for (size_t i = 0; i < subgraph->outputs().size(); ++i) {
-    stride_map[subgraph->outputs().at(i)] = {
-        strideInputFromString(output_desc.at(i))};
+    std::unordered_map<const Value*, std::vector<StrideInput>> stride_map;
+    size_t index = 0;
+    for (Value* v : subgraph->inputs()) {
+      if (!v->type()->cast<TensorType>()) {
+        continue;
+      }
+      stride_map[v] = striding_inputs[index];
+      index++;
+    }
+    std::vector<std::string> output_desc =
+        node->ival(attr::striding_outputs_desc).to<std::vector<std::string>>();
+    for (size_t i = 0; i < subgraph->outputs().size(); ++i) {
+      stride_map[subgraph->outputs().at(i)] = {
+          strideInputFromString(output_desc.at(i))};
+    }
+
+    kernel = std::make_shared<tensorexpr::TensorExprKernel>(
+        subgraph,
+        custom_lowerings,
+        sym_shapes,
+        /*pre_alloc*/ false,
+        stride_map);
+    TensorExprKernelCache::instance().insert(cache_key, kernel);
   }
 
-  std::shared_ptr<tensorexpr::TensorExprKernel> kernel =
-      std::make_shared<tensorexpr::TensorExprKernel>(
-          subgraph,
-          custom_lowerings,
-          sym_shapes,
-          /*pre_alloc*/ false,
-          stride_map);
-
   auto num_subgraph_inputs = subgraph->inputs().size();
   return [kernel, num_subgraph_inputs, allow_stack_outputs](Stack& stack) {
     RECORD_FUNCTION(kernel->getKernelName(), std::vector<c10::IValue>());
@@ -26,6 +26,17 @@ TORCH_API bool tensorExprDynamicShapeFusionEnabled();
 TORCH_API bool setTexprReductionsEnabled(bool value);
 TORCH_API bool texprReductionsEnabled();
 
+// The global bounded LRU cache of compiled TE kernels, shared across all
+// graph instances and shape specializations.  See Note [TE kernel cache]
+// in tensorexpr_fuser.cpp.  A max size of 0 disables caching.
+struct TORCH_API TensorExprKernelCacheStats {
+  size_t hits = 0;
+  size_t misses = 0;
+  size_t size = 0;
+};
+TORCH_API TensorExprKernelCacheStats getTensorExprKernelCacheStats();
+TORCH_API void setTensorExprKernelCacheMaxSize(size_t max_size);
+
 TORCH_API void RemoveProfileNodesAndSpecializeTypes(
     std::shared_ptr<Graph>& graph);
 TORCH_API bool hasTensorTypeSpecialization(Value* v);
@@ -8,6 +8,7 @@
 #include <torch/csrc/jit/passes/fold_conv_bn.h>
 #include <torch/csrc/jit/passes/freeze_module.h>
 #include <torch/csrc/jit/passes/fuse_linear.h>
+#include <torch/csrc/jit/passes/fuse_pointwise_chains.h>
 #include <torch/csrc/jit/passes/fuse_relu.h>
 #include <torch/csrc/jit/passes/graph_rewrite_helper.h>
 #include <torch/csrc/jit/passes/hoist_conv_packed_params.h>
@@ -476,6 +477,14 @@ script::Module optimizeForMobile(
       FuseAddRelu(graph);
     }
   }
+
+  if (!optimization_blocklist.count(
+          MobileOptimizerType::FUSE_POINTWISE_CHAINS)) {
+    for (const auto& method : cloned_module.get_methods()) {
+      auto graph = method.graph();
+      FusePointwiseChains(graph);
+    }
+  }
   cloned_module.register_attribute("mobile_optimized", BoolType::get(), true);
   return cloned_module;
 }
@@ -13,6 +13,7 @@ enum class MobileOptimizerType : int8_t {
   FUSE_ADD_RELU,
   HOIST_CONV_PACKED_PARAMS,
   CONV_1D_TO_2D,
+  FUSE_POINTWISE_CHAINS,
 };
 
 TORCH_API void transformConv1dToConv2d(std::shared_ptr<Graph>& graph);
@@ -28,6 +28,8 @@
 #include <torch/csrc/jit/passes/create_autodiff_subgraphs.h>
 #include <torch/csrc/jit/passes/create_functional_graphs.h>
 #include <torch/csrc/jit/passes/cuda_graph_fuser.h>
+#include <torch/csrc/jit/passes/cuda_stream_partitioning.h>
+#include <torch/csrc/jit/passes/device_region_planning.h>
 #include <torch/csrc/jit/passes/dbr_quantization/remove_redundant_aliases.h>
 #include <torch/csrc/jit/passes/dead_code_elimination.h>
 #include <torch/csrc/jit/passes/decompose_ops.h>
@@ -51,6 +53,7 @@
 #include <torch/csrc/jit/passes/loop_unrolling.h>
 #include <torch/csrc/jit/passes/lower_graph.h>
 #include <torch/csrc/jit/passes/lower_tuples.h>
+#include <torch/csrc/jit/passes/memory_format_propagation.h>
 #include <torch/csrc/jit/passes/metal_rewrite.h>
 #include <torch/csrc/jit/passes/normalize_ops.h>
 #include <torch/csrc/jit/passes/peephole.h>
@@ -63,6 +66,7 @@
 #include <torch/csrc/jit/passes/quantization/quantization_type.h>
 #include <torch/csrc/jit/passes/refine_tuple_types.h>
 #include <torch/csrc/jit/passes/remove_dropout.h>
+#include <torch/csrc/jit/passes/reinplace.h>
 #include <torch/csrc/jit/passes/remove_expands.h>
 #include <torch/csrc/jit/passes/remove_inplace_ops.h>
 #include <torch/csrc/jit/passes/remove_mutation.h>
@@ -94,6 +98,7 @@
 #include <torch/csrc/jit/runtime/static/init.h>
 #include <torch/csrc/jit/runtime/symbolic_shape_registry.h>
 #include <torch/csrc/jit/serialization/export.h>
+#include <torch/csrc/jit/serialization/storage_dedup.h>
 #include <torch/csrc/jit/serialization/import.h>
 #include <torch/csrc/jit/tensorexpr/kernel.h>
 #include <torch/csrc/jit/tensorexpr/tensorexpr_init.h>
@@ -469,6 +474,14 @@ void initJITBindings(PyObject* module) {
       .def(
           "_jit_pass_fuse_add_relu",
           [](std::shared_ptr<Graph>& graph) { FuseAddRelu(graph); })
+      .def(
+          "_jit_pass_propagate_memory_format",
+          [](std::shared_ptr<Graph>& graph) {
+            return PropagateMemoryFormat(graph);
+          })
+      .def(
+          "_jit_memory_format_conversions_eliminated",
+          &numMemoryFormatConversionsEliminated)
       .def("_jit_pass_dedup_module_uses", &DedupModuleUses)
       .def("_jit_pass_replicate_dequantize", &ReplicateDeQuant)
       .def(
@@ -543,6 +556,14 @@ void initJITBindings(PyObject* module) {
           [](std::shared_ptr<Graph>& g) {
             return InplaceToFunctionalActivation(g);
           })
+      .def(
+          "_jit_pass_reinplace_ops",
+          [](std::shared_ptr<Graph>& g) { return ReinplaceOps(g); })
+      .def(
+          "_jit_pass_functionalize_then_reinplace",
+          [](std::shared_ptr<Graph>& g) {
+            return FunctionalizeThenReinplace(g);
+          })
       .def(
           "_jit_pass_inline_functional_graphs",
           [](std::shared_ptr<Graph>& g) { return InlineFunctionalGraphs(g); })
@@ -981,6 +1002,18 @@ void initJITBindings(PyObject* module) {
           })
       .def("_jit_set_texpr_fuser_enabled", &setTensorExprFuserEnabled)
       .def("_jit_texpr_fuser_enabled", &tensorExprFuserEnabled)
+      .def("_jit_set_storage_dedup_enabled", &setStorageDedupEnabled)
+      .def("_jit_storage_dedup_enabled", &getStorageDedupEnabled)
+      .def(
+          "_jit_storage_dedup_stats",
+          []() {
+            auto stats = getStorageDedupStats();
+            py::dict result;
+            result["lookups"] = stats.lookups;
+            result["hits"] = stats.hits;
+            result["bytes_saved"] = stats.bytes_saved;
+            return result;
+          })
       .def("_jit_texpr_fallback_allowed", &tensorexpr::fallbackAllowed)
       .def("_jit_texpr_set_fallback_allowed", &tensorexpr::setFallbackAllowed)
       .def("_jit_set_texpr_reductions_enabled", &setTexprReductionsEnabled)
@@ -991,6 +1024,19 @@ void initJITBindings(PyObject* module) {
           "_jit_texpr_dynamic_shape_enabled",
           &tensorExprDynamicShapeFusionEnabled)
       .def("_jit_texpr_reductions_enabled", &texprReductionsEnabled)
+      .def(
+          "_jit_texpr_kernel_cache_stats",
+          []() {
+            auto stats = getTensorExprKernelCacheStats();
+            py::dict result;
+            result["hits"] = stats.hits;
+            result["misses"] = stats.misses;
+            result["size"] = stats.size;
+            return result;
+          })
+      .def(
+          "_jit_set_texpr_kernel_cache_max_size",
+          &setTensorExprKernelCacheMaxSize)
       .def(
           "_jit_set_te_generate_block_code",
           [](bool gen_block_code) {
@@ -1162,6 +1208,20 @@ void initJITBindings(PyObject* module) {
             return retval;
           })
       .def("_jit_pass_batch_mm", BatchMM)
+      .def(
+          "_jit_pass_cuda_stream_partitioning",
+          [](std::shared_ptr<Graph>& graph, size_t max_side_streams) {
+            return CudaStreamPartitioning(graph, max_side_streams);
+          },
+          py::arg("graph"),
+          py::arg("max_side_streams") = 3)
+      .def(
+          "_jit_pass_device_region_planning",
+          [](std::shared_ptr<Graph>& graph, bool use_side_streams) {
+            return DeviceRegionPlanning(graph, use_side_streams);
+          },
+          py::arg("graph"),
+          py::arg("use_side_streams") = true)
       .def("_jit_decay_packed_param_input_types", [](Graph& g) {
         for (Value* i : g.inputs()) {
           if (i->type() ==
@@ -1409,6 +1469,9 @@ void initJITBindings(PyObject* module) {
       .value(
           "HOIST_CONV_PACKED_PARAMS",
           MobileOptimizerType::HOIST_CONV_PACKED_PARAMS)
+      .value(
+          "FUSE_POINTWISE_CHAINS",
+          MobileOptimizerType::FUSE_POINTWISE_CHAINS)
       .export_values();
 
   // This allows PyTorchStreamReader to read from a Python buffer. It requires
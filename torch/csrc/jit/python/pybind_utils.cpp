@@ -415,5 +415,178 @@ IValue toIValue(py::handle obj, const TypePtr& type, c10::optional<int32_t> N) {
       "toIValue() cannot handle converting to type: ", type->repr_str()));
 }
 
+ToPyObjectPlan::ToPyObjectPlan(const c10::TypePtr& type)
+    : kind_(Kind::Generic), type_(type) {
+  switch (type->kind()) {
+    case TypeKind::NoneType:
+      kind_ = Kind::None;
+      break;
+    case TypeKind::TensorType:
+      kind_ = Kind::Tensor;
+      break;
+    case TypeKind::IntType:
+      kind_ = Kind::Int;
+      break;
+    case TypeKind::FloatType:
+      kind_ = Kind::Float;
+      break;
+    case TypeKind::BoolType:
+      kind_ = Kind::Bool;
+      break;
+    case TypeKind::StringType:
+      kind_ = Kind::String;
+      break;
+    case TypeKind::TupleType: {
+      auto tuple_type = type->expect<TupleType>();
+      if (tuple_type->schema()) {
+        // NamedTuples go through _create_named_tuple; stay Generic.
+        break;
+      }
+      kind_ = Kind::Tuple;
+      for (const auto& element : tuple_type->elements()) {
+        children_.emplace_back(ToPyObjectPlan(element));
+      }
+      break;
+    }
+    case TypeKind::ListType:
+      kind_ = Kind::List;
+      children_.emplace_back(
+          ToPyObjectPlan(type->expectRef<ListType>().getElementType()));
+      break;
+    case TypeKind::DictType: {
+      auto dict_type = type->expect<DictType>();
+      kind_ = Kind::Dict;
+      intern_keys_ = dict_type->getKeyType()->kind() == TypeKind::StringType;
+      children_.emplace_back(ToPyObjectPlan(dict_type->getKeyType()));
+      children_.emplace_back(ToPyObjectPlan(dict_type->getValueType()));
+      break;
+    }
+    case TypeKind::OptionalType:
+      kind_ = Kind::Optional;
+      children_.emplace_back(
+          ToPyObjectPlan(type->expectRef<OptionalType>().getElementType()));
+      break;
+    default:
+      // Classes, futures, enums, Any, ...: per-value toPyObject.
+      break;
+  }
+}
+
+const ToPyObjectPlan& ToPyObjectPlan::forType(const c10::TypePtr& type) {
+  // Guarded by the GIL. Leaked so the interned py::objects inside the
+  // plans are never destroyed after interpreter shutdown.
+  static auto* cache =
+      new std::unordered_map<c10::Type*, std::unique_ptr<ToPyObjectPlan>>();
+  auto it = cache->find(type.get());
+  if (it == cache->end()) {
+    it = cache
+             ->emplace(
+                 type.get(),
+                 std::unique_ptr<ToPyObjectPlan>(new ToPyObjectPlan(type)))
+             .first;
+  }
+  return *it->second;
+}
+
+py::object ToPyObjectPlan::run(IValue ivalue) const {
+  // Each case verifies the runtime tag and falls through to toPyObject on
+  // a mismatch (e.g. values reached through Any), so a plan can never
+  // produce a different object than the unplanned conversion.
+  switch (kind_) {
+    case Kind::None:
+      if (ivalue.isNone()) {
+        return py::none();
+      }
+      break;
+    case Kind::Tensor:
+      if (ivalue.isTensor()) {
+        auto tensor = std::move(ivalue).toTensor();
+        if (tensor.unsafeGetTensorImpl()->is_wrapped_number()) {
+          return toPyObject(IValue(std::move(tensor)));
+        }
+        guardAgainstNamedTensor<at::Tensor>(tensor);
+        return py::cast(autograd::Variable(std::move(tensor)));
+      }
+      break;
+    case Kind::Int:
+      if (ivalue.isInt()) {
+        return py::cast(std::move(ivalue).toInt());
+      }
+      break;
+    case Kind::Float:
+      if (ivalue.isDouble()) {
+        return py::cast(std::move(ivalue).toDouble());
+      }
+      break;
+    case Kind::Bool:
+      if (ivalue.isBool()) {
+        return py::cast(std::move(ivalue).toBool());
+      }
+      break;
+    case Kind::String:
+      if (ivalue.isString()) {
+        return py::cast(std::move(ivalue).toStringRef());
+      }
+      break;
+    case Kind::Tuple:
+      if (ivalue.isTuple()) {
+        auto tuple = std::move(ivalue).toTuple();
+        const auto& elements = tuple->elements();
+        // A runtime NamedTuple behind a plain static tuple type still has
+        // to build its Python class; only plain tuples take the fast path.
+        const bool is_named = tuple->type() && tuple->type()->schema() &&
+            tuple->type()->schema()->name() != "";
+        if (!is_named && elements.size() == children_.size()) {
+          py::tuple t{elements.size()};
+          for (const auto i : c10::irange(elements.size())) {
+            t[i] = children_[i].run(IValue{elements.at(i)});
+          }
+          return std::move(t);
+        }
+        return toPyObject(IValue(std::move(tuple)));
+      }
+      break;
+    case Kind::List:
+      if (ivalue.isList()) {
+        auto list = std::move(ivalue).toList();
+        py::list t{list.size()};
+        for (const auto i : c10::irange(list.size())) {
+          t[i] = children_[0].run(IValue{list.get(i)});
+        }
+        return std::move(t);
+      }
+      break;
+    case Kind::Dict:
+      if (ivalue.isGenericDict()) {
+        auto dict = std::move(ivalue).toGenericDict();
+        py::dict py_dict;
+        for (auto& pair : dict) {
+          py::object key;
+          if (intern_keys_ && pair.key().isString()) {
+            const auto& key_str = pair.key().toStringRef();
+            auto it = key_cache_.find(key_str);
+            if (it == key_cache_.end()) {
+              it = key_cache_.emplace(key_str, py::cast(key_str)).first;
+            }
+            key = it->second;
+          } else {
+            key = children_[0].run(IValue{pair.key()});
+          }
+          py_dict[std::move(key)] = children_[1].run(IValue{pair.value()});
+        }
+        return std::move(py_dict);
+      }
+      break;
+    case Kind::Optional:
+      if (ivalue.isNone()) {
+        return py::none();
+      }
+      return children_[0].run(std::move(ivalue));
+    case Kind::Generic:
+      break;
+  }
+  return toPyObject(std::move(ivalue));
+}
+
 } // namespace jit
 } // namespace torch
@@ -862,6 +862,49 @@ inline py::object toPyObject(IValue ivalue) {
   }
 }
 
+// Precompiled conversion plan for a statically known type. toPyObject
+// re-walks the IValue tag chain for every element of every call; for a
+// scripted callable the return type is fixed, so the container layout can
+// be compiled once and each call only wraps the leaf values. String dict
+// keys are additionally interned per plan, so repeated calls returning the
+// same keys (the common serving shape) reuse the existing Python strings.
+//
+// All methods must be called with the GIL held; the GIL also guards the
+// plan cache and the interned keys.
+class ToPyObjectPlan {
+ public:
+  // Returns the cached plan for `type`, compiling it on first use. The
+  // plan (and the type it keeps alive) lives for the process.
+  static const ToPyObjectPlan& forType(const c10::TypePtr& type);
+
+  py::object run(IValue ivalue) const;
+
+ private:
+  enum class Kind {
+    Generic, // anything unplanned: defer to toPyObject per value
+    None,
+    Tensor,
+    Int,
+    Float,
+    Bool,
+    String,
+    Tuple,
+    List,
+    Dict,
+    Optional,
+  };
+
+  explicit ToPyObjectPlan(const c10::TypePtr& type);
+
+  Kind kind_;
+  // Keeps the Type (the cache key) alive.
+  c10::TypePtr type_;
+  // Tuple element plans, the list element plan, or {key, value} for dicts.
+  std::vector<ToPyObjectPlan> children_;
+  bool intern_keys_ = false;
+  mutable std::unordered_map<std::string, py::object> key_cache_;
+};
+
 struct VISIBILITY_HIDDEN tuple_slice {
   /*implicit*/ tuple_slice(py::tuple tup_)
       : tup(std::move(tup_)), b(0), e(tup.size()) {}
@@ -1060,6 +1103,13 @@ inline py::object runAndInsertCall(
   TORCH_CHECK(
       stack.size() > 0,
       "Expected values in the stack after execution but found none");
+  // The callee's return type is static, so convert through its precompiled
+  // plan; per-call work is then just wrapping the leaf values.
+  const auto& returns = callee.getSchema().returns();
+  if (returns.size() == 1) {
+    return ToPyObjectPlan::forType(returns[0].type())
+        .run(std::move(stack.back()));
+  }
   return toPyObject(std::move(stack.back()));
 }
 
@@ -341,6 +341,51 @@ struct CompleteArgumentSpec {
   std::vector<int64_t> data;
 };
 
+// Classifies a tensor's stride layout into a small set of memory-format
+// classes. The profiling executor keys per-format plan slots on this
+// (rather than on the exact strides a CompleteArgumentSpec captures, which
+// would split plans per shape), so e.g. NCHW and NHWC inputs each keep
+// their own stable optimized plan; see
+// ProfilingGraphExecutorImpl::getPlanFor.
+enum class MemoryFormatClass : uint8_t {
+  Contiguous = 0,
+  ChannelsLast,
+  ChannelsLast3d,
+  Other,
+};
+
+inline MemoryFormatClass memoryFormatClassOf(const at::Tensor& t) {
+  // The contiguity bits are cached on TensorImpl, so classification is a
+  // few flag reads - cheap enough for the executor's hot path.
+  if (t.layout() != at::kStrided || t.is_contiguous()) {
+    return MemoryFormatClass::Contiguous;
+  }
+  if (t.is_contiguous(at::MemoryFormat::ChannelsLast)) {
+    return MemoryFormatClass::ChannelsLast;
+  }
+  if (t.is_contiguous(at::MemoryFormat::ChannelsLast3d)) {
+    return MemoryFormatClass::ChannelsLast3d;
+  }
+  return MemoryFormatClass::Other;
+}
+
+// Hash over the memory-format classes of the tensor inputs, used to key
+// per-format execution plan slots.
+inline size_t memoryFormatClassKey(at::ArrayRef<IValue> inputs) {
+  size_t key = c10::hash_combine(0, inputs.size());
+  for (const IValue& input : inputs) {
+    if (!input.isTensor()) {
+      continue;
+    }
+    // See [argspec refcounting]
+    const at::Tensor* t = reinterpret_cast<const at::Tensor*>(&input);
+    const auto format_class = t->defined() ? memoryFormatClassOf(*t)
+                                           : MemoryFormatClass::Contiguous;
+    key = c10::hash_combine(key, static_cast<size_t>(format_class));
+  }
+  return key;
+}
+
 // public view of compressed CompleteArgumentInfo
 struct CompleteArgumentInfo {
   CompleteArgumentInfo(const CompleteArgumentSpec& spec, const int i)
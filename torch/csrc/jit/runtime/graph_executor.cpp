@@ -856,6 +856,22 @@ bool GraphExecutor::isOptimized() const {
   return pImpl && pImpl->isOptimized();
 }
 
+c10::optional<IValue> GraphExecutor::getProfilingSnapshot() {
+  if (auto ppImpl =
+          std::dynamic_pointer_cast<ProfilingGraphExecutorImpl>(pImpl)) {
+    return ppImpl->getProfilingSnapshot();
+  }
+  return c10::nullopt;
+}
+
+bool GraphExecutor::restoreProfilingSnapshot(const IValue& snapshot) {
+  if (auto ppImpl =
+          std::dynamic_pointer_cast<ProfilingGraphExecutorImpl>(pImpl)) {
+    return ppImpl->restoreProfilingSnapshot(snapshot);
+  }
+  return false;
+}
+
 TORCH_API bool IsNewExecutorEnabled() {
   static const auto disable_new_executor =
       std::getenv("TORCH_JIT_DISABLE_NEW_EXECUTOR");
@@ -925,39 +941,57 @@ void runNondiffOptimization(
       "Before customPrePassses (beginning of runNondiffOptimization)\n",
       *graph);
   // Run custom passes that different backends can register.
-  for (const auto& passPair : getCustomPrePasses()) {
-    passPair.first(graph);
+  {
+    JIT_PASS_TIMED("customPrePasses");
+    for (const auto& passPair : getCustomPrePasses()) {
+      passPair.first(graph);
+    }
   }
   GRAPH_DEBUG("After customPrePassses\n", *graph);
 
   // decomposition pass, decompose certain ops that will be used in the
   // following passes (like batchmm and jit fusion)
-  DecomposeOps(graph);
+  {
+    JIT_PASS_TIMED("DecomposeOps");
+    DecomposeOps(graph);
+  }
   GRAPH_DEBUG("After DecomposeOps\n", *graph);
 
   // TupleConstruct / TupleUnpack pairs can still be present at this point
   // and must be removed for fusion.
-  LowerSimpleTuples(graph);
+  {
+    JIT_PASS_TIMED("LowerSimpleTuples");
+    LowerSimpleTuples(graph);
+  }
   GRAPH_DEBUG("After LowerSimpleTuples, before BatchMM\n", *graph);
 
   // Rewrite subgraphs with many MMs into expressions that batch them.
-  BatchMM(graph);
+  {
+    JIT_PASS_TIMED("BatchMM");
+    BatchMM(graph);
+  }
 
   GRAPH_DEBUG("After BatchMM, before Fusion\n", *graph);
-  if (getExecutorMode()) {
-    if (tensorExprFuserEnabled()) {
-      auto min_size = getFusionGroupInlining() ? 2 : 1;
-      auto dyn_shapes = tensorExprDynamicShapeFusionEnabled();
-      FuseTensorExprs(graph, min_size, /*composed_op*/ false, dyn_shapes);
+  {
+    JIT_PASS_TIMED("Fusion");
+    if (getExecutorMode()) {
+      if (tensorExprFuserEnabled()) {
+        auto min_size = getFusionGroupInlining() ? 2 : 1;
+        auto dyn_shapes = tensorExprDynamicShapeFusionEnabled();
+        FuseTensorExprs(graph, min_size, /*composed_op*/ false, dyn_shapes);
+      }
+    } else {
+      FuseGraph(graph, strict_fuser_check);
     }
-  } else {
-    FuseGraph(graph, strict_fuser_check);
   }
   GRAPH_DEBUG("After Fusion\n", *graph);
 
   // Run custom post-fusion passes
-  for (const auto& passPair : getCustomPostPasses()) {
-    passPair.first(graph);
+  {
+    JIT_PASS_TIMED("customPostPasses");
+    for (const auto& passPair : getCustomPostPasses()) {
+      passPair.first(graph);
+    }
   }
   GRAPH_DEBUG(
       "After customPostPassses (end of runNondiffOptimization)\n", *graph);
@@ -970,33 +1004,50 @@ void runOptimization(
   // Basic graph preprocessing to eliminate noise.
   GRAPH_DEBUG(
       "Before EliminateDeadCode (beginning of runOptimization)\n", *graph);
-  EliminateDeadCode(graph);
+  {
+    JIT_PASS_TIMED("EliminateDeadCode");
+    EliminateDeadCode(graph);
+  }
   GRAPH_DEBUG(
       "After EliminateDeadCode, before EliminateCommonSubexpression\n", *graph);
-  EliminateCommonSubexpression(graph);
+  {
+    JIT_PASS_TIMED("EliminateCommonSubexpression");
+    EliminateCommonSubexpression(graph);
+  }
   GRAPH_DEBUG(
       "After EliminateCommonSubexpression , before PeepholeOptimize\n", *graph);
 
-  PeepholeOptimize(graph);
+  {
+    JIT_PASS_TIMED("PeepholeOptimize");
+    PeepholeOptimize(graph);
+  }
   GRAPH_DEBUG("After PeepholeOptimize, before ConstantPropagation\n", *graph);
 
-  if (const_prop_user_classes) {
-    ConstantPropagation(graph);
-  } else {
-    ConstantPropagation(graph, true);
+  {
+    JIT_PASS_TIMED("ConstantPropagation");
+    if (const_prop_user_classes) {
+      ConstantPropagation(graph);
+    } else {
+      ConstantPropagation(graph, true);
+    }
   }
   GRAPH_DEBUG("After ConstantPropagation, before ConstantPooling\n", *graph);
 
-  ConstantPooling(graph);
+  {
+    JIT_PASS_TIMED("ConstantPooling");
+    ConstantPooling(graph);
+  }
   GRAPH_DEBUG("After ConstantPooling\n", *graph);
 
   // Unroll small loops, and eliminate expressions that are the same at every
   // iteration.
   bool unroll_success = false;
   if (unroll_non_constant_loops) {
+    JIT_PASS_TIMED("UnrollLoops");
     unroll_success = UnrollLoops(graph);
     GRAPH_DEBUG("After UnrollLoops, before RemoveListMutation\n", *graph);
   } else {
+    JIT_PASS_TIMED("UnrollConstantLoops");
     unroll_success = UnrollConstantLoops(graph);
     GRAPH_DEBUG(
         "After UnrollConstantLoops, before RemoveListMutation\n", *graph);
@@ -1004,18 +1055,33 @@ void runOptimization(
 
   if (unroll_success) {
     // run again with unrolled loops
-    RemoveListMutation(graph);
+    {
+      JIT_PASS_TIMED("RemoveListMutation");
+      RemoveListMutation(graph);
+    }
     GRAPH_DEBUG("After RemoveListMutation, before PeepholeOptimize\n", *graph);
-    PeepholeOptimize(graph);
+    {
+      JIT_PASS_TIMED("PeepholeOptimize");
+      PeepholeOptimize(graph);
+    }
     GRAPH_DEBUG("After PeepholeOptimize, before ConstantPropagation\n", *graph);
-    ConstantPropagation(graph);
+    {
+      JIT_PASS_TIMED("ConstantPropagation");
+      ConstantPropagation(graph);
+    }
     GRAPH_DEBUG("After ConstantPropagation\n", *graph);
   }
 
-  EliminateCommonSubexpression(graph);
+  {
+    JIT_PASS_TIMED("EliminateCommonSubexpression");
+    EliminateCommonSubexpression(graph);
+  }
   GRAPH_DEBUG(
       "After EliminateCommonSubexpression, before CheckInplace\n", *graph);
-  CheckInplace(graph);
+  {
+    JIT_PASS_TIMED("CheckInplace");
+    CheckInplace(graph);
+  }
   GRAPH_DEBUG("After CheckInplace (end of runOptimization)\n", *graph);
 }
 
@@ -89,6 +89,12 @@ struct TORCH_API GraphExecutor {
 
   bool isOptimized() const;
 
+  // Snapshot/restore of warmup profiling state, see
+  // Note [Profiled plan serialization] in profiling_graph_executor_impl.h.
+  // Both are no-ops (nullopt/false) on non-profiling executors.
+  c10::optional<IValue> getProfilingSnapshot();
+  bool restoreProfilingSnapshot(const IValue& snapshot);
+
  private:
   std::shared_ptr<GraphExecutorImplBase> pImpl;
 };
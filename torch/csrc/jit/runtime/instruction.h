@@ -18,6 +18,12 @@ namespace jit {
 // T - index into the type table, used for guard instructions
 // S - index into object slots
 // C - index into code table
+//
+// The trailing opcodes (LOAD2 through OP_STORE) are superinstructions:
+// they are never emitted directly but synthesized from adjacent pairs by
+// the peephole pass in interpreter/code_impl.h, see
+// Note [Interpreter superinstructions]. They exist only in the server
+// interpreter's in-memory code and are not valid in mobile bytecode.
 
 #define FORALL_OPCODES(_)                                                      \
   _(OP, "O") /* invoke operator X */                                           \
@@ -73,7 +79,13 @@ namespace jit {
   _(FORK, "CN") /* launch a thread to run code entry x with N inputs  */       \
   _(WARN, "I") /* emit a warning with line information */                      \
   _(ENTER, "EN") /* enter scope of a contextmanager */                         \
-  _(EXIT, "EX") /* exit the last entered contextmanager */
+  _(EXIT, "EX") /* exit the last entered contextmanager */                     \
+  _(LOAD2, "RR") /* push registers X and N */                                  \
+  _(LOAD_MOVE, "RR") /* push register X, then move register N */               \
+  _(MOVE_LOAD, "RR") /* move register X, then push register N */               \
+  _(MOVE2, "RR") /* move registers X and N */                                  \
+  _(LOADC_OP, "CO") /* push constant X, then invoke operator N */              \
+  _(OP_STORE, "OR") /* invoke operator X, then store 1 value to register N */
 
 enum OpCode : uint8_t {
 #define DEFINE_OP(op, _) op,
@@ -6,6 +6,7 @@
 #include <c10/core/thread_pool.h>
 #include <c10/util/Exception.h>
 #include <c10/util/irange.h>
+#include <c10/util/numa.h>
 #include <torch/csrc/autograd/edge.h>
 #include <torch/csrc/autograd/grad_mode.h>
 #include <torch/csrc/autograd/profiler.h>
@@ -50,6 +51,12 @@ C10_DEFINE_bool(
     false,
     "enable rethrowing caught exception");
 
+C10_DEFINE_bool(
+    torch_jit_enable_superinstructions,
+    true,
+    "fuse adjacent interpreter instructions into superinstructions, "
+    "see Note [Interpreter superinstructions]");
+
 namespace torch {
 namespace jit {
 
@@ -93,6 +100,77 @@ inline int64_t getDistAutogradContextId() {
   return 0;
 #endif
 }
+
+// Picks the NUMA node hint for a forked task: the node of the largest CPU
+// input storage, on the theory that the biggest operand dominates
+// remote-memory traffic. Returns -1 when no input pins the task anywhere.
+int numaNodeOfInputs(const Stack& stack) {
+  int node = -1;
+  size_t best_nbytes = 0;
+  for (const auto& iv : stack) {
+    if (!iv.isTensor()) {
+      continue;
+    }
+    const auto& t = iv.toTensor();
+    if (!t.defined() || !t.is_cpu() || !t.has_storage()) {
+      continue;
+    }
+    size_t nbytes = t.storage().nbytes();
+    if (nbytes <= best_nbytes) {
+      continue;
+    }
+    int input_node = c10::GetNUMANode(t.storage().data());
+    if (input_node >= 0) {
+      node = input_node;
+      best_nbytes = nbytes;
+    }
+  }
+  return node;
+}
+
+// Note [Interpreter frame buffer pool]
+// Every InterpreterState run allocates a register file that grows as
+// frames are entered, and the operand stack reallocates as it grows; in
+// inference serving these mallocs recur on every single call. The pool
+// below recycles the backing IValue vectors per thread: a vector is
+// handed out empty but with the capacity it reached last time, so after
+// a few runs the dispatch loop performs no heap allocation at all.
+// Buffers are acquired in the InterpreterStateImpl constructor (sized by
+// CodeImpl::frame_size() as a warm-start hint) and returned in its
+// destructor. Returning to a different thread's pool than the one a
+// buffer came from is fine - the pool recycles capacity, it does not
+// own it.
+class FrameBufferPool {
+ public:
+  static FrameBufferPool& threadLocal() {
+    thread_local FrameBufferPool pool;
+    return pool;
+  }
+
+  std::vector<IValue> acquire(size_t reserve_hint) {
+    std::vector<IValue> buf;
+    if (!buffers_.empty()) {
+      buf = std::move(buffers_.back());
+      buffers_.pop_back();
+    }
+    if (buf.capacity() < reserve_hint) {
+      buf.reserve(reserve_hint);
+    }
+    return buf;
+  }
+
+  void release(std::vector<IValue>&& buf) {
+    if (buffers_.size() < kMaxPooledBuffers) {
+      // clear() runs the IValue destructors but keeps the capacity.
+      buf.clear();
+      buffers_.emplace_back(std::move(buf));
+    }
+  }
+
+ private:
+  static constexpr size_t kMaxPooledBuffers = 8;
+  std::vector<std::vector<IValue>> buffers_;
+};
 } // namespace
 
 thread_local InterpreterStateImpl* tls_int_state_ptr_ = nullptr;
@@ -114,9 +192,15 @@ struct TLSCurrentInterpreterGuard {
 struct InterpreterStateImpl : c10::intrusive_ptr_target {
   InterpreterStateImpl(const Code& code, TaskLauncher taskLauncher)
       : taskLauncher_(std::move(taskLauncher)) {
+    // See Note [Interpreter frame buffer pool].
+    registers = FrameBufferPool::threadLocal().acquire(code.pImpl->frame_size());
     enterFrame(code, 0);
   }
 
+  ~InterpreterStateImpl() override {
+    FrameBufferPool::threadLocal().release(std::move(registers));
+  }
+
  private:
   using Frame = torch::jit::interpreter::Frame;
   struct WarnedNodes {
@@ -246,6 +330,11 @@ struct InterpreterStateImpl : c10::intrusive_ptr_target {
       stack_start_ = 0;
     }
 
+    // Warm-start the operand stack so growth inside the dispatch loop
+    // does not reallocate in the common case.
+    // See Note [Interpreter frame buffer pool].
+    stack.reserve(stack_start_ + frames.back().function->frame_size());
+
     TLSCurrentInterpreterGuard g(this);
     if (frames.back().pc == 0 && stack_start_ == 0) {
       checkAndStartRecordFunction(frames.back(), stack);
@@ -344,6 +433,57 @@ struct InterpreterStateImpl : c10::intrusive_ptr_target {
             stack.emplace_back(frame.function->constant_table_[inst.X]);
           }
             INST_NEXT;
+          // Composite instructions synthesized by the peephole pass,
+          // see Note [Interpreter superinstructions] in code_impl.h. Each
+          // is exactly the two original instruction bodies back to back.
+          case INST(LOAD2): {
+            INST_GUARD;
+            stack.emplace_back(reg(inst.X));
+            stack.emplace_back(reg(inst.N));
+          }
+            INST_NEXT;
+          case INST(LOAD_MOVE): {
+            INST_GUARD;
+            stack.emplace_back(reg(inst.X));
+            stack.emplace_back(std::move(reg(inst.N)));
+          }
+            INST_NEXT;
+          case INST(MOVE_LOAD): {
+            INST_GUARD;
+            stack.emplace_back(std::move(reg(inst.X)));
+            stack.emplace_back(reg(inst.N));
+          }
+            INST_NEXT;
+          case INST(MOVE2): {
+            INST_GUARD;
+            stack.emplace_back(std::move(reg(inst.X)));
+            stack.emplace_back(std::move(reg(inst.N)));
+          }
+            INST_NEXT;
+          case INST(LOADC_OP): {
+            INST_GUARD;
+            stack.emplace_back(frame.function->constant_table_[inst.X]);
+#ifndef NDEBUG
+            size_t init_size = stack.size();
+#endif
+            frame.function->operator_table_[inst.N](stack);
+#ifndef NDEBUG
+            frame.function->assert_stack_size(inst.N, init_size, stack.size());
+#endif
+          }
+            INST_NEXT;
+          case INST(OP_STORE): {
+            INST_GUARD;
+#ifndef NDEBUG
+            size_t init_size = stack.size();
+#endif
+            frame.function->operator_table_[inst.X](stack);
+#ifndef NDEBUG
+            frame.function->assert_stack_size(inst.X, init_size, stack.size());
+#endif
+            reg(inst.N) = pop(stack);
+          }
+            INST_NEXT;
           case INST(GET_ATTR): {
             INST_GUARD;
             const auto& userObj = stack.back().toObjectRef();
@@ -718,13 +858,24 @@ struct InterpreterStateImpl : c10::intrusive_ptr_target {
                 toGraphFunction(*frame.function->function_table_[inst.X]);
             InterpreterState forked_interpreter(
                 forked_fn.get_executor().getPlanFor(stack).code, taskLauncher_);
+            Stack forked_stack(stack.end() - inst.N, stack.end());
+            // When NUMA-affine inter-op scheduling is enabled, run the
+            // forked subgraph on the socket that holds its inputs rather
+            // than wherever the shared pool happens to pick a thread.
+            int numa_node = at::numa_interop_enabled()
+                ? numaNodeOfInputs(forked_stack)
+                : -1;
             InterpreterContinuation continuation(
                 forked_interpreter,
-                Stack(stack.end() - inst.N, stack.end()),
+                std::move(forked_stack),
                 getDistAutogradContextId());
             drop(stack, inst.N);
             push(stack, forked_interpreter.getFuture());
-            taskLauncher_(std::move(continuation));
+            if (numa_node >= 0) {
+              at::launch_with_numa_hint(numa_node, std::move(continuation));
+            } else {
+              taskLauncher_(std::move(continuation));
+            }
           }
             INST_NEXT;
           case INST(WARN): {
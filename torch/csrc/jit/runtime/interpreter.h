@@ -16,6 +16,7 @@ C10_CLANG_DIAGNOSTIC_IGNORE("-Wdeprecated-copy-dtor")
 
 C10_DECLARE_bool(torch_jit_disable_warning_prints);
 C10_DECLARE_bool(torch_jit_enable_rethrow_caught_exception);
+C10_DECLARE_bool(torch_jit_enable_superinstructions);
 
 namespace at {
 class Tensor;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <limits>
 #include <memory>
 #include <unordered_map>
 #include <vector>
@@ -174,6 +175,7 @@ struct CodeImpl {
     // we deferred the emission of bailout blocks so they appear at the end
     // emit them now and patch up the jumps
     insertBailoutBlocks();
+    fuseSuperInstructions();
   }
 
   const std::vector<c10::IValue>& constant_table() const {
@@ -203,6 +205,21 @@ struct CodeImpl {
     return instructions_;
   }
 
+  // Hint for how many IValue slots a frame of this function needs at
+  // once (registers plus working operand stack). The interpreter uses it
+  // to size the pooled buffers it hands to a fresh InterpreterState; see
+  // Note [Interpreter frame buffer pool] in interpreter.cpp. This is
+  // only a warm-start hint: buffers recycled through the pool keep their
+  // high-water capacity, so steady state does not depend on its
+  // accuracy.
+  size_t frame_size() const {
+    // Slack for the operand stack between registers; ops peak at their
+    // argument count, which this comfortably covers in practice.
+    constexpr size_t kFrameSlack = 32;
+    return static_cast<size_t>(register_size_) + n_inputs + n_outputs +
+        kFrameSlack;
+  }
+
   const std::unordered_map<std::string, size_t>& op_to_num_specified_args()
       const {
     return op_to_num_specified_args_;
@@ -552,6 +569,130 @@ struct CodeImpl {
           instructions_source_[block.jf_instruction_index]);
     }
   }
+
+  // Note [Interpreter superinstructions]
+  // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+  // Pointwise-heavy graphs spend a sizable fraction of interpreter time in
+  // instruction fetch/dispatch rather than in the operators themselves.
+  // After emission we run a peephole over the finished instruction list and
+  // collapse the most frequent adjacent pairs into single composite
+  // instructions: back-to-back register pushes (LOAD2, LOAD_MOVE,
+  // MOVE_LOAD, MOVE2), a constant push feeding an operator (LOADC_OP), and
+  // an operator whose single output is stored right away (OP_STORE). The
+  // canonical "load inputs, run op, store output" shape a binary op emits
+  // thus runs in two dispatches instead of four.
+  //
+  // A pair is only fused when (a) neither opcode is a branch, (b) the
+  // second instruction is not a jump target (the first may be - the fused
+  // instruction starts with its semantics), (c) both instructions come from
+  // the same graph node, so per-pc attribution (profiling spans, callstack
+  // reporting) is unchanged, and (d) the second operand fits the 16-bit N
+  // field. Relative jump offsets are restated against the new positions
+  // afterwards. The pass runs for the server interpreter only:
+  // MobileCodeImpl::run() skips it because the composite opcodes are not
+  // part of mobile bytecode. request_bailout's GUARD bookkeeping is
+  // unaffected since guards and jumps never fuse.
+  static c10::optional<OpCode> superInstruction(OpCode first, OpCode second) {
+    switch (first) {
+      case LOAD:
+        if (second == LOAD) {
+          return LOAD2;
+        }
+        if (second == MOVE) {
+          return LOAD_MOVE;
+        }
+        break;
+      case MOVE:
+        if (second == LOAD) {
+          return MOVE_LOAD;
+        }
+        if (second == MOVE) {
+          return MOVE2;
+        }
+        break;
+      case LOADC:
+        if (second == OP) {
+          return LOADC_OP;
+        }
+        break;
+      case OP:
+        if (second == STORE) {
+          return OP_STORE;
+        }
+        break;
+      default:
+        break;
+    }
+    return c10::nullopt;
+  }
+
+  void fuseSuperInstructions() {
+    if (!FLAGS_torch_jit_enable_superinstructions) {
+      return;
+    }
+    size_t size = instructions_.size();
+    // Instructions a jump can land on must survive as dispatch points.
+    // (size + 1 because a forward jump may target one past the last
+    // instruction of a block that was patched before later code existed.)
+    std::vector<bool> is_jump_target(size + 1, false);
+    for (const auto i : c10::irange(size)) {
+      OpCode op = instructions_[i].op;
+      if (op == JF || op == JMP || op == LOOP) {
+        int64_t target = static_cast<int64_t>(i) + instructions_[i].X;
+        TORCH_INTERNAL_ASSERT(
+            target >= 0 && target <= static_cast<int64_t>(size));
+        is_jump_target[target] = true;
+      }
+    }
+
+    std::vector<Instruction> fused;
+    std::vector<Node*> fused_source;
+    std::vector<size_t> fused_old_index; // old index each new instr began at
+    std::vector<size_t> new_index(size + 1);
+    fused.reserve(size);
+    fused_source.reserve(size);
+    fused_old_index.reserve(size);
+    size_t i = 0;
+    while (i < size) {
+      new_index[i] = fused.size();
+      const Instruction& cur = instructions_[i];
+      if (i + 1 < size && !is_jump_target[i + 1] &&
+          instructions_source_[i] == instructions_source_[i + 1]) {
+        const Instruction& next = instructions_[i + 1];
+        auto combined = superInstruction(cur.op, next.op);
+        if (combined && next.X >= 0 &&
+            next.X <= std::numeric_limits<uint16_t>::max()) {
+          fused.emplace_back(
+              *combined, cur.X, static_cast<uint16_t>(next.X));
+          fused_source.emplace_back(instructions_source_[i]);
+          fused_old_index.emplace_back(i);
+          new_index[i + 1] = fused.size() - 1;
+          i += 2;
+          continue;
+        }
+      }
+      fused.emplace_back(cur);
+      fused_source.emplace_back(instructions_source_[i]);
+      fused_old_index.emplace_back(i);
+      ++i;
+    }
+    new_index[size] = fused.size();
+
+    // Fusion shifted everything behind it; restate relative jump offsets
+    // against the new positions.
+    for (const auto k : c10::irange(fused.size())) {
+      OpCode op = fused[k].op;
+      if (op == JF || op == JMP || op == LOOP) {
+        size_t old_target = fused_old_index[k] + fused[k].X;
+        fused[k].X = static_cast<int32_t>(new_index[old_target]) -
+            static_cast<int32_t>(k);
+      }
+    }
+
+    instructions_ = std::move(fused);
+    instructions_source_ = std::move(fused_source);
+  }
+
   void emitInterfaceCall(
       std::string method_name_str,
       c10::ArrayRef<Value*> inputs) {
@@ -796,7 +937,8 @@ struct CodeImpl {
   void dump(std::ostream& out, size_t i) const {
     out << i << " " << instructions_[i];
     if (instructions_[i].op == OP || instructions_[i].op == CALL ||
-        instructions_[i].op == OPN) {
+        instructions_[i].op == OPN || instructions_[i].op == LOADC_OP ||
+        instructions_[i].op == OP_STORE) {
       out << " # " << *instructions_source_[i];
     } else {
       out << "\n";
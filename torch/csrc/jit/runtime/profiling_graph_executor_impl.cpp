@@ -2,6 +2,7 @@
 
 #include <c10/util/Optional.h>
 #include <c10/util/irange.h>
+#include <torch/csrc/jit/api/function_impl.h>
 #include <torch/csrc/jit/jit_log.h>
 #include <torch/csrc/jit/passes/add_if_then_else.h>
 #include <torch/csrc/jit/passes/bailout_graph.h>
@@ -36,7 +37,10 @@
 #include <torch/csrc/jit/passes/tensorexpr_fuser.h>
 #include <torch/csrc/jit/passes/update_differentiable_graph_requires_grad.h>
 #include <torch/csrc/jit/passes/utils/subgraph_utils.h>
+#include <torch/csrc/jit/serialization/pickle.h>
 #include <mutex>
+#include <unordered_map>
+#include <unordered_set>
 
 C10_DEFINE_bool(
     torch_jit_enable_new_executor,
@@ -58,6 +62,12 @@ C10_DEFINE_bool(
     false,
     "fuse on 12 dynamic compilations");
 
+C10_DEFINE_bool(
+    torch_jit_separate_memory_format_plans,
+    false,
+    "keep a separate optimized plan per input memory-format class "
+    "(e.g. channels-last vs. contiguous) in the profiling executor");
+
 constexpr size_t kDefaultNumProfiledRuns = 1;
 constexpr size_t kDefaultBailoutDepth = 20;
 
@@ -585,6 +595,58 @@ ProfilingGraphExecutorImpl::ProfilingGraphExecutorImpl(
   fusion_strategy_ = getFusionStrategy();
 }
 
+void ProfilingGraphExecutorImpl::instrumentGraphForProfiling() {
+  instrumentGraphForProfiling(pr_, profiling_plan_);
+}
+
+void ProfilingGraphExecutorImpl::instrumentGraphForProfiling(
+    std::unique_ptr<ProfilingRecord>& pr,
+    c10::optional<ExecutionPlan>& profiling_plan) {
+  auto copy = graph->copy();
+  runProfilingInsensitiveOptimizations(copy);
+  pr = ProfilingRecord::instrumentGraph(copy);
+  // `InsertProfileNodesForSpecializeAutogradZero` profiles a definition vs a
+  // use and it doesn't expect any profile nodes between a graph input and its
+  // consumer, `aten::_grad_sum_to_size`. This means we need to run it first,
+  // before any other pass that could insert `prim::iprofile_value` node on
+  // `aten::_grad_sum_to_size` input.
+  InsertProfileNodesForSpecializeAutogradZero(pr.get());
+  // `InsertProfileNodesForCUDAFuser` inserts profile node for non-tensor
+  // value
+#ifndef C10_MOBILE
+  if (torch::jit::fuser::cuda::isEnabled()) {
+    torch::jit::fuser::cuda::InsertProfileNodesForCUDAFuser(pr.get());
+  }
+#endif
+  GRAPH_DUMP("Profiled Graph: ", pr->graph());
+  profiling_plan = ExecutionPlan(pr->graph(), function_name_);
+}
+
+c10::optional<IValue> ProfilingGraphExecutorImpl::getProfilingSnapshot() {
+  std::lock_guard<std::mutex> lock(compile_mutex);
+  if (!pr_ || !pr_->ready()) {
+    return c10::nullopt;
+  }
+  return pr_->takeTypeSnapshot();
+}
+
+bool ProfilingGraphExecutorImpl::restoreProfilingSnapshot(
+    const IValue& snapshot) {
+  std::lock_guard<std::mutex> lock(compile_mutex);
+  // only a fresh executor can be seeded; once profiling or optimization has
+  // started the local observations win
+  if (pr_ || optimized_plan_ || fallback_plan_) {
+    return false;
+  }
+  instrumentGraphForProfiling();
+  if (!pr_->restoreTypeSnapshot(snapshot)) {
+    pr_.reset();
+    profiling_plan_.reset();
+    return false;
+  }
+  return true;
+}
+
 size_t ProfilingGraphExecutorImpl::getInstantiatedBailoutDepth() {
   // Initialize bailout_depth from command-line flag.
   size_t depth = 0;
@@ -639,24 +701,7 @@ const ExecutionPlan& ProfilingGraphExecutorImpl::getOptimizedPlanFor(
 
   // if a profiling graph hasn't been created yet
   if (!pr_) {
-    auto copy = graph->copy();
-    runProfilingInsensitiveOptimizations(copy);
-    pr_ = ProfilingRecord::instrumentGraph(copy);
-    // `InsertProfileNodesForSpecializeAutogradZero` profiles a definition vs a
-    // use and it doesn't expect any profile nodes between a graph input and its
-    // consumer, `aten::_grad_sum_to_size`. This means we need to run it first,
-    // before any other pass that could insert `prim::iprofile_value` node on
-    // `aten::_grad_sum_to_size` input.
-    InsertProfileNodesForSpecializeAutogradZero(pr_.get());
-    // `InsertProfileNodesForCUDAFuser` inserts profile node for non-tensor
-    // value
-#ifndef C10_MOBILE
-    if (torch::jit::fuser::cuda::isEnabled()) {
-      torch::jit::fuser::cuda::InsertProfileNodesForCUDAFuser(pr_.get());
-    }
-#endif
-    GRAPH_DUMP("Profiled Graph: ", pr_->graph());
-    profiling_plan_ = ExecutionPlan(pr_->graph(), function_name_);
+    instrumentGraphForProfiling();
     // fall-through
   }
 
@@ -678,6 +723,28 @@ const ExecutionPlan& ProfilingGraphExecutorImpl::getOptimizedPlanFor(
   return *optimized_plan_;
 }
 
+const ExecutionPlan& ProfilingGraphExecutorImpl::getPlanForMemoryFormatSlot(
+    MemoryFormatPlanSlot& slot) {
+  // A fresh profiling pipeline per format class: the slot profiles its own
+  // runs, so the recorded strides match the layout the plan is optimized
+  // for instead of merging with the primary plan's observations.
+  if (!slot.pr) {
+    instrumentGraphForProfiling(slot.pr, slot.profiling_plan);
+  }
+  if (!slot.pr->ready()) {
+    return *slot.profiling_plan;
+  }
+  auto copy = slot.pr->graph()->copy();
+  ProfilingRecord::removeProfileCounter(copy->block());
+  runProfilingOptimizations(copy, *remaining_bailout_depth_);
+  replaceFallbackGraphWithFallbackFunction(copy->block());
+  runFinalOptimizations(copy);
+  CheckStrictFusion(copy);
+  GRAPH_DUMP("Optimized Graph (memory-format plan slot): ", copy);
+  slot.optimized_plan = ExecutionPlan(copy, function_name_);
+  return *slot.optimized_plan;
+}
+
 const ExecutionPlan& ProfilingGraphExecutorImpl::getPlanFor(
     Stack& stack,
     c10::optional<size_t> remaining_bailout_depth) {
@@ -686,10 +753,31 @@ const ExecutionPlan& ProfilingGraphExecutorImpl::getPlanFor(
   // IMPORTANT: This is a hot path of calling a torchscript function. Try not to
   // add any code above this.
   if (optimized_plan_) {
-    return *optimized_plan_;
+    if (!FLAGS_torch_jit_separate_memory_format_plans ||
+        remaining_bailout_depth_.value_or(0) == 0) {
+      return *optimized_plan_;
+    }
+    // Key plans on the inputs' memory-format class so e.g. channels-last
+    // and contiguous calls each hit a plan optimized (and guarded) for
+    // their own layout instead of repeatedly bailing out of a shared one.
+    const size_t format_key = memoryFormatClassKey(stack);
+    if (!primary_format_key_ || format_key == *primary_format_key_) {
+      return *optimized_plan_;
+    }
+    auto& slot = format_plan_slots_[format_key];
+    if (slot.optimized_plan) {
+      return *slot.optimized_plan;
+    }
+    return getPlanForMemoryFormatSlot(slot);
   }
   // if depth is not set, use
-  return getOptimizedPlanFor(stack, remaining_bailout_depth);
+  const ExecutionPlan& plan =
+      getOptimizedPlanFor(stack, remaining_bailout_depth);
+  if (FLAGS_torch_jit_separate_memory_format_plans && optimized_plan_ &&
+      !primary_format_key_) {
+    primary_format_key_ = memoryFormatClassKey(stack);
+  }
+  return plan;
 }
 
 GraphExecutorState ProfilingGraphExecutorImpl::getDebugState() {
@@ -776,5 +864,77 @@ void ProfilingGraphExecutorImpl::runFinalOptimizations(
   AddIfThenElseOp(graph);
 }
 
+namespace {
+constexpr int64_t kProfiledPlansFormatVersion = 1;
+} // namespace
+
+std::string serializeProfiledPlans(const Module& module) {
+  std::vector<IValue> entries;
+  std::unordered_set<std::string> seen;
+  for (const Module& m : module.modules()) {
+    for (const Method& method : m.get_methods()) {
+      auto* graph_function = tryToGraphFunction(method.function());
+      if (!graph_function) {
+        continue;
+      }
+      const std::string name = method.function().qualname().qualifiedName();
+      if (!seen.insert(name).second) {
+        continue;
+      }
+      auto snapshot = graph_function->get_executor().getProfilingSnapshot();
+      if (snapshot) {
+        entries.emplace_back(
+            c10::ivalue::Tuple::create({name, std::move(*snapshot)}));
+      }
+    }
+  }
+  if (entries.empty()) {
+    return std::string();
+  }
+  auto payload = c10::ivalue::Tuple::create(
+      {kProfiledPlansFormatVersion,
+       c10::ivalue::Tuple::create(std::move(entries))});
+  auto data = pickle(payload);
+  return std::string(data.begin(), data.end());
+}
+
+void deserializeProfiledPlans(Module& module, const std::string& payload) {
+  std::unordered_map<std::string, IValue> snapshots;
+  try {
+    IValue parsed = unpickle(payload.data(), payload.size());
+    const auto& top = parsed.toTupleRef().elements();
+    if (top.size() != 2 || top[0].toInt() != kProfiledPlansFormatVersion) {
+      GRAPH_DEBUG("Ignoring profiled plans with unknown format version");
+      return;
+    }
+    for (const IValue& entry : top[1].toTupleRef().elements()) {
+      const auto& kv = entry.toTupleRef().elements();
+      snapshots.emplace(kv[0].toStringRef(), kv[1]);
+    }
+  } catch (const std::exception&) {
+    GRAPH_DEBUG("Ignoring malformed profiled plans archive entry");
+    return;
+  }
+  for (const Module& m : module.modules()) {
+    for (const Method& method : m.get_methods()) {
+      auto* graph_function = tryToGraphFunction(method.function());
+      if (!graph_function) {
+        continue;
+      }
+      auto it =
+          snapshots.find(method.function().qualname().qualifiedName());
+      if (it == snapshots.end()) {
+        continue;
+      }
+      if (!graph_function->get_executor().restoreProfilingSnapshot(
+              it->second)) {
+        GRAPH_DEBUG(
+            "Could not restore profiled plan for ",
+            method.function().qualname().qualifiedName());
+      }
+    }
+  }
+}
+
 } // namespace jit
 } // namespace torch
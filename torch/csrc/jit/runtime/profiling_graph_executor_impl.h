@@ -7,6 +7,8 @@ C10_DECLARE_bool(torch_jit_static_then_dynamic);
 
 C10_DECLARE_bool(torch_jit_always_dynamic);
 
+C10_DECLARE_bool(torch_jit_separate_memory_format_plans);
+
 namespace torch {
 namespace jit {
 
@@ -29,6 +31,8 @@ struct TORCH_API ProfilingGraphExecutorImpl : public GraphExecutorImplBase {
     fallback_plan_.reset();
     profiling_plan_.reset();
     optimized_plan_.reset();
+    primary_format_key_.reset();
+    format_plan_slots_.clear();
     // prevent memory leaks
     fallback_functions_.clear();
     remaining_bailout_depth_.reset();
@@ -40,7 +44,28 @@ struct TORCH_API ProfilingGraphExecutorImpl : public GraphExecutorImplBase {
     return optimized_plan_.has_value();
   }
 
+  // See Note [Profiled plan serialization].
+  c10::optional<IValue> getProfilingSnapshot();
+  bool restoreProfilingSnapshot(const IValue& snapshot);
+
  private:
+  // One profiling pipeline and plan per memory-format class of the inputs,
+  // used when FLAGS_torch_jit_separate_memory_format_plans is set so that
+  // e.g. channels-last and contiguous calls each keep a stable plan
+  // optimized against their own profiled strides instead of sharing (and
+  // repeatedly bailing out of) one. The first-seen format uses the primary
+  // pr_/profiling_plan_/optimized_plan_ fields.
+  struct MemoryFormatPlanSlot {
+    std::unique_ptr<ProfilingRecord> pr;
+    c10::optional<ExecutionPlan> profiling_plan;
+    c10::optional<ExecutionPlan> optimized_plan;
+  };
+
+  void instrumentGraphForProfiling();
+  void instrumentGraphForProfiling(
+      std::unique_ptr<ProfilingRecord>& pr,
+      c10::optional<ExecutionPlan>& profiling_plan);
+  const ExecutionPlan& getPlanForMemoryFormatSlot(MemoryFormatPlanSlot& slot);
   const ExecutionPlan& getOptimizedPlanFor(
       Stack& stack,
       c10::optional<size_t> remaining_bailout_depth);
@@ -73,7 +98,44 @@ struct TORCH_API ProfilingGraphExecutorImpl : public GraphExecutorImplBase {
   // of the GraphExecutor and only shared with InterpreterState
   std::vector<std::unique_ptr<Function>> fallback_functions_;
   c10::optional<size_t> remaining_bailout_depth_;
+  // The memory-format class key (see memoryFormatClassKey) of the inputs
+  // optimized_plan_ was built for, and the plan slots for every other
+  // format class seen since.
+  c10::optional<size_t> primary_format_key_;
+  std::unordered_map<size_t, MemoryFormatPlanSlot> format_plan_slots_;
 };
 
+// Note [Profiled plan serialization]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The profiling executor needs getNumProfiledRuns() warmup executions before
+// it can specialize and fuse, so every fresh process serves unoptimized
+// traffic until warmup finishes. To ship a warmed plan inside the model
+// archive we serialize the state profiling collects - the profiled tensor
+// types and profile_ivalue attributes attached to the profile nodes of the
+// instrumented graph - rather than the optimized graph itself, which holds
+// fusion groups and fallback functions that cannot round-trip through the
+// archive. On load the instrumented graph is rebuilt deterministically from
+// the module's code, the recorded state is reattached and the record marked
+// ready, so the very first call runs the full profiling optimization
+// pipeline and executes the specialized graph. If the rebuilt graph doesn't
+// match the snapshot (different build, fuser settings or module code),
+// restoration fails silently and the executor warms up as usual.
+
+// The record name under which serializeProfiledPlans output is stored in
+// the module archive.
+constexpr const char* kProfiledPlansRecordName = "extra/profiled_plans.pkl";
+
+// Collects profiling snapshots from every warmed method executor of
+// `module` (including submodules) into a pickled payload, or returns an
+// empty string if no method has finished profiling.
+TORCH_API std::string serializeProfiledPlans(const Module& module);
+
+// Seeds the method executors of a freshly loaded `module` from a payload
+// produced by serializeProfiledPlans. Mismatched or malformed entries are
+// ignored and the affected methods profile normally.
+TORCH_API void deserializeProfiledPlans(
+    Module& module,
+    const std::string& payload);
+
 } // namespace jit
 } // namespace torch
@@ -327,6 +327,303 @@ bool ProfilingRecord::ready() const {
   return profiling_count_ == 0;
 }
 
+namespace {
+
+// Helpers for (de)serializing profiled state, see
+// Note [Profiled plan serialization] in profiling_graph_executor_impl.h.
+// The encoding only uses tuples and scalars so it round-trips through
+// pickle without a type resolver.
+
+// Profile nodes in insertion order; the profiling counter node is a
+// prim::profile without attr::profiled_type and carries no state.
+void collectProfiledNodes(Block* b, std::vector<Node*>& out) {
+  for (Node* n : b->nodes()) {
+    if ((n->kind() == prim::profile &&
+         n->hasAttribute(attr::profiled_type)) ||
+        n->kind() == prim::profile_ivalue) {
+      out.push_back(n);
+    }
+    for (Block* ib : n->blocks()) {
+      collectProfiledNodes(ib, out);
+    }
+  }
+}
+
+IValue encodeProfiledTensorType(const TensorType& t) {
+  IValue scalar_type;
+  if (t.scalarType()) {
+    scalar_type = static_cast<int64_t>(*t.scalarType());
+  }
+  IValue device;
+  if (t.device()) {
+    device = t.device()->str();
+  }
+  IValue requires_grad;
+  if (t.requiresGrad()) {
+    requires_grad = *t.requiresGrad();
+  }
+  IValue undefined;
+  if (t.undefined()) {
+    undefined = *t.undefined();
+  }
+  IValue sizes;
+  if (const auto& dims = t.symbolic_sizes().sizes()) {
+    std::vector<IValue> raw;
+    raw.reserve(dims->size());
+    for (const c10::ShapeSymbol& s : *dims) {
+      // static sizes are non-negative, symbolic ids negative; symbolic ids
+      // are remapped to fresh symbols on decode
+      raw.emplace_back(s.value());
+    }
+    sizes = c10::ivalue::Tuple::create(std::move(raw));
+  }
+  IValue strides;
+  if (const auto& dims = t.stride_properties().sizes()) {
+    std::vector<IValue> raw;
+    raw.reserve(dims->size());
+    for (const c10::optional<c10::Stride>& s : *dims) {
+      if (!s) {
+        raw.emplace_back();
+        continue;
+      }
+      IValue index, contiguous, stride;
+      if (s->stride_index_) {
+        index = static_cast<int64_t>(*s->stride_index_);
+      }
+      if (s->contiguous_) {
+        contiguous = *s->contiguous_;
+      }
+      if (s->stride_) {
+        stride = static_cast<int64_t>(*s->stride_);
+      }
+      raw.emplace_back(c10::ivalue::Tuple::create(
+          {std::move(index), std::move(contiguous), std::move(stride)}));
+    }
+    strides = c10::ivalue::Tuple::create(std::move(raw));
+  }
+  return c10::ivalue::Tuple::create(
+      {std::move(scalar_type),
+       std::move(device),
+       std::move(requires_grad),
+       std::move(undefined),
+       std::move(sizes),
+       std::move(strides)});
+}
+
+// `symbol_map` preserves symbol equality classes across all types in one
+// snapshot: two dimensions that shared a symbol when profiled share a (fresh)
+// symbol after decoding.
+TensorTypePtr decodeProfiledTensorType(
+    const IValue& iv,
+    std::map<int64_t, c10::ShapeSymbol>& symbol_map) {
+  const auto& elems = iv.toTupleRef().elements();
+  TORCH_INTERNAL_ASSERT(elems.size() == 6);
+  c10::optional<at::ScalarType> scalar_type;
+  if (!elems[0].isNone()) {
+    scalar_type = static_cast<at::ScalarType>(elems[0].toInt());
+  }
+  c10::optional<c10::Device> device;
+  if (!elems[1].isNone()) {
+    device = c10::Device(elems[1].toStringRef());
+  }
+  c10::optional<bool> requires_grad;
+  if (!elems[2].isNone()) {
+    requires_grad = elems[2].toBool();
+  }
+  c10::optional<bool> undefined;
+  if (!elems[3].isNone()) {
+    undefined = elems[3].toBool();
+  }
+  c10::SymbolicShape sizes;
+  if (!elems[4].isNone()) {
+    std::vector<c10::ShapeSymbol> dims;
+    for (const IValue& d : elems[4].toTupleRef().elements()) {
+      int64_t value = d.toInt();
+      if (value >= 0) {
+        dims.push_back(c10::ShapeSymbol::fromStaticSize(value));
+      } else {
+        auto it = symbol_map.find(value);
+        if (it == symbol_map.end()) {
+          it = symbol_map.emplace(value, c10::ShapeSymbol::newSymbol()).first;
+        }
+        dims.push_back(it->second);
+      }
+    }
+    sizes = c10::SymbolicShape(std::move(dims));
+  }
+  c10::VaryingShape<c10::Stride> strides;
+  if (!elems[5].isNone()) {
+    std::vector<c10::optional<c10::Stride>> dims;
+    for (const IValue& s : elems[5].toTupleRef().elements()) {
+      if (s.isNone()) {
+        dims.emplace_back(c10::nullopt);
+        continue;
+      }
+      const auto& se = s.toTupleRef().elements();
+      TORCH_INTERNAL_ASSERT(se.size() == 3);
+      c10::optional<size_t> index, stride;
+      c10::optional<bool> contiguous;
+      if (!se[0].isNone()) {
+        index = static_cast<size_t>(se[0].toInt());
+      }
+      if (!se[1].isNone()) {
+        contiguous = se[1].toBool();
+      }
+      if (!se[2].isNone()) {
+        stride = static_cast<size_t>(se[2].toInt());
+      }
+      dims.emplace_back(c10::Stride(index, contiguous, stride));
+    }
+    strides = c10::VaryingShape<c10::Stride>(std::move(dims));
+  }
+  return TensorType::create(
+      scalar_type, device, sizes, strides, requires_grad, undefined);
+}
+
+c10::optional<IValue> encodeProfiledAttributes(const Node* n) {
+  std::vector<IValue> attrs;
+  for (Symbol name : n->attributeNames()) {
+    IValue value;
+    switch (n->kindOf(name)) {
+      case AttributeKind::i:
+        value = n->i(name);
+        break;
+      case AttributeKind::f:
+        value = n->f(name);
+        break;
+      case AttributeKind::s:
+        value = n->s(name);
+        break;
+      case AttributeKind::ival:
+        value = n->ival(name);
+        break;
+      default:
+        // an attribute kind we don't know how to round-trip
+        return c10::nullopt;
+    }
+    attrs.emplace_back(c10::ivalue::Tuple::create(
+        {std::string(name.toUnqualString()),
+         static_cast<int64_t>(n->kindOf(name)),
+         std::move(value)}));
+  }
+  return c10::ivalue::Tuple::create(std::move(attrs));
+}
+
+bool decodeProfiledAttributes(Node* n, const IValue& encoded) {
+  for (const IValue& attr : encoded.toTupleRef().elements()) {
+    const auto& fields = attr.toTupleRef().elements();
+    TORCH_INTERNAL_ASSERT(fields.size() == 3);
+    Symbol name = Symbol::attr(fields[0].toStringRef());
+    switch (static_cast<AttributeKind>(fields[1].toInt())) {
+      case AttributeKind::i:
+        n->i_(name, fields[2].toInt());
+        break;
+      case AttributeKind::f:
+        n->f_(name, fields[2].toDouble());
+        break;
+      case AttributeKind::s:
+        n->s_(name, fields[2].toStringRef());
+        break;
+      case AttributeKind::ival: {
+        IValue incoming = fields[2];
+        // dicts come back from the unpickler with generic element types;
+        // rebuild them with the element types of the initial attribute the
+        // profiling pass installed, so downstream typed accesses hold up
+        if (incoming.isGenericDict() && n->hasAttribute(name) &&
+            n->ival(name).isGenericDict()) {
+          auto typed = n->ival(name).toGenericDict().copy();
+          typed.clear();
+          for (const auto& entry : incoming.toGenericDict()) {
+            typed.insert(entry.key(), entry.value());
+          }
+          n->ival_(name, IValue(typed));
+        } else {
+          n->ival_(name, std::move(incoming));
+        }
+      } break;
+      default:
+        return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+c10::optional<IValue> ProfilingRecord::takeTypeSnapshot() const {
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  if (profiling_count_ != 0) {
+    return c10::nullopt;
+  }
+  std::vector<Node*> nodes;
+  collectProfiledNodes(profiled_graph_->block(), nodes);
+  std::vector<IValue> entries;
+  entries.reserve(nodes.size());
+  for (Node* n : nodes) {
+    if (n->kind() == prim::profile) {
+      auto* pn = static_cast<ProfileOp*>(n);
+      entries.emplace_back(c10::ivalue::Tuple::create(
+          {false,
+           c10::ivalue::Tuple::create(
+               {n->i(attr::seen_none),
+                pn->hasSeenTensor(),
+                encodeProfiledTensorType(
+                    n->ty(attr::profiled_type)->expectRef<TensorType>())})}));
+    } else {
+      auto attrs = encodeProfiledAttributes(n);
+      if (!attrs) {
+        return c10::nullopt;
+      }
+      entries.emplace_back(
+          c10::ivalue::Tuple::create({true, std::move(*attrs)}));
+    }
+  }
+  return c10::ivalue::Tuple::create(std::move(entries));
+}
+
+bool ProfilingRecord::restoreTypeSnapshot(const IValue& snapshot) {
+  if (!snapshot.isTuple()) {
+    return false;
+  }
+  std::vector<Node*> nodes;
+  collectProfiledNodes(profiled_graph_->block(), nodes);
+  const auto& entries = snapshot.toTupleRef().elements();
+  if (entries.size() != nodes.size()) {
+    return false;
+  }
+  std::map<int64_t, c10::ShapeSymbol> symbol_map;
+  try {
+    for (const auto i : c10::irange(nodes.size())) {
+      Node* n = nodes[i];
+      const auto& entry = entries[i].toTupleRef().elements();
+      TORCH_INTERNAL_ASSERT(entry.size() == 2);
+      bool is_ivalue = entry[0].toBool();
+      if (is_ivalue != (n->kind() == prim::profile_ivalue)) {
+        return false;
+      }
+      if (is_ivalue) {
+        if (!decodeProfiledAttributes(n, entry[1])) {
+          return false;
+        }
+      } else {
+        const auto& fields = entry[1].toTupleRef().elements();
+        TORCH_INTERNAL_ASSERT(fields.size() == 3);
+        auto* pn = static_cast<ProfileOp*>(n);
+        n->i_(attr::seen_none, fields[0].toInt());
+        pn->setHasSeenTensor(fields[1].toBool());
+        n->ty_(
+            attr::profiled_type,
+            decodeProfiledTensorType(fields[2], symbol_map));
+      }
+    }
+  } catch (const std::exception&) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  profiling_count_ = 0;
+  return true;
+}
+
 std::unique_ptr<ProfilingRecord> ProfilingRecord::instrumentGraph(
     const std::shared_ptr<Graph>& graph) {
   auto new_g = graph->copy();
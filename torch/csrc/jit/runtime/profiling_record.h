@@ -187,6 +187,19 @@ struct ProfilingRecord {
 
   bool ready() const;
 
+  // Encodes the state collected during profiling (profiled tensor types and
+  // profile_ivalue attributes, in node order) into a pickleable IValue, or
+  // nullopt if profiling hasn't finished or some state can't be encoded.
+  // See Note [Profiled plan serialization] in
+  // profiling_graph_executor_impl.h.
+  TORCH_API c10::optional<IValue> takeTypeSnapshot() const;
+
+  // Reattaches a snapshot taken by takeTypeSnapshot to the profile nodes of
+  // a freshly instrumented graph and marks the record ready, so the next run
+  // can specialize without warmup. Returns false (leaving the record in an
+  // unspecified profiling state) if the snapshot doesn't match this graph.
+  TORCH_API bool restoreTypeSnapshot(const IValue& snapshot);
+
   std::shared_ptr<Graph> graph() const {
     return profiled_graph_;
   }
@@ -1,6 +1,7 @@
 // This file registers special JIT operators used to implement the PyTorch CUDA
 // API in TorchScript.
 #if !defined(USE_ROCM)
+#include <c10/cuda/CUDACachingAllocator.h>
 #include <torch/csrc/api/include/torch/utils.h>
 #include <torch/csrc/jit/cuda/cuda.h>
 #include <torch/csrc/jit/ir/ir.h>
@@ -163,6 +164,61 @@ RegisterOperators const reg({
           _device_synchronize(device_index);
         },
         aliasAnalysisFromSchema()),
+    // The two operators below are emitted by the CudaStreamPartitioning
+    // pass (torch/csrc/jit/passes/cuda_stream_partitioning.cpp) and are
+    // not meant to be called from user TorchScript directly.
+    // _side_stream_begin switches the current thread to a pool stream
+    // that is ordered after all work queued on the current stream, and
+    // returns the previous stream packed to an int (the same pack/unpack
+    // scheme cuda::set_stream uses above).
+    Operator(
+        "cuda::_side_stream_begin() -> int",
+        [](Stack& stack) {
+          auto device_index = c10::cuda::current_device();
+          auto prev = c10::cuda::getCurrentCUDAStream(device_index);
+          auto side = c10::cuda::getStreamFromPool(
+              /*isHighPriority=*/false, device_index);
+          at::cuda::CUDAEvent forked;
+          forked.record(prev);
+          forked.block(side);
+          c10::cuda::setCurrentCUDAStream(side);
+          push(stack, static_cast<int64_t>(prev.pack()));
+        },
+        aliasAnalysisFromSchema()),
+    // _side_stream_end restores the previous stream and makes it wait on
+    // an event recorded on the side stream.  The boundary tensors are
+    // registered with the caching allocator so that blocks touched on
+    // both streams are not reused until the cross-stream work is done:
+    // outputs live on the side stream but are consumed on the previous
+    // stream, inputs live on the previous stream but were read on the
+    // side stream.
+    Operator(
+        "cuda::_side_stream_end(Tensor[] outputs, Tensor[] inputs, int packed_prev) -> ()",
+        [](Stack& stack) {
+          auto packed = pop(stack).toInt();
+          auto inputs = pop(stack).toTensorVector();
+          auto outputs = pop(stack).toTensorVector();
+          auto prev =
+              c10::cuda::CUDAStream::unpack(static_cast<uint64_t>(packed));
+          auto side = c10::cuda::getCurrentCUDAStream(prev.device_index());
+          at::cuda::CUDAEvent joined;
+          joined.record(side);
+          joined.block(prev);
+          for (const auto& t : outputs) {
+            if (t.defined() && t.is_cuda()) {
+              c10::cuda::CUDACachingAllocator::recordStream(
+                  t.storage().data_ptr(), prev);
+            }
+          }
+          for (const auto& t : inputs) {
+            if (t.defined() && t.is_cuda()) {
+              c10::cuda::CUDACachingAllocator::recordStream(
+                  t.storage().data_ptr(), side);
+            }
+          }
+          c10::cuda::setCurrentCUDAStream(prev);
+        },
+        aliasAnalysisFromSchema()),
 });
 } // namespace
 } // namespace jit
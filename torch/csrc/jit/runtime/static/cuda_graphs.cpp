@@ -0,0 +1,75 @@
+#include <torch/csrc/jit/runtime/static/impl.h>
+
+#include <ATen/cuda/CUDAGraph.h>
+#include <c10/cuda/CUDAFunctions.h>
+#include <c10/cuda/CUDAStream.h>
+#include <c10/util/Logging.h>
+
+namespace torch {
+namespace jit {
+namespace {
+
+// CUDA-side implementation of the Static Runtime graph capture interface;
+// see [Note: Static Runtime CUDA graphs] in impl.h. One instance owns one
+// at::cuda::CUDAGraph, and therefore one private memory pool: everything
+// the captured kernels allocate stays alive for replay.
+class StaticRuntimeCudaGraphImpl : public StaticRuntimeCudaGraph {
+ public:
+  ~StaticRuntimeCudaGraphImpl() override {
+    if (C10_UNLIKELY(capturing_)) {
+      // The runner bailed out mid-capture (an op threw). capture_end()
+      // clears the allocator's capture state before cudaStreamEndCapture
+      // reports the invalidated capture, so calling it here leaves the
+      // stream and allocator usable again; swallow the error it rethrows.
+      try {
+        graph_.capture_end();
+      } catch (const std::exception& e) {
+        LOG(WARNING) << "error while aborting CUDA graph capture: "
+                     << e.what();
+      }
+      at::cuda::setCurrentCUDAStream(prev_stream_);
+    }
+  }
+
+  void captureBegin() override {
+    // Mirrors the torch.cuda.graph context manager: quiesce the device,
+    // then capture on a side stream (capture is not allowed on the
+    // default stream).
+    prev_stream_ = at::cuda::getCurrentCUDAStream();
+    c10::cuda::device_synchronize();
+    at::cuda::setCurrentCUDAStream(at::cuda::getStreamFromPool());
+    capturing_ = true;
+    graph_.capture_begin();
+  }
+
+  void captureEnd() override {
+    graph_.capture_end();
+    capturing_ = false;
+    at::cuda::setCurrentCUDAStream(prev_stream_);
+  }
+
+  void replay() override {
+    graph_.replay();
+  }
+
+ private:
+  at::cuda::CUDAGraph graph_;
+  at::cuda::CUDAStream prev_stream_ = at::cuda::getCurrentCUDAStream();
+  bool capturing_ = false;
+};
+
+std::unique_ptr<StaticRuntimeCudaGraph> createCudaGraph() {
+  return std::make_unique<StaticRuntimeCudaGraphImpl>();
+}
+
+struct CudaGraphFactoryRegistration {
+  CudaGraphFactoryRegistration() {
+    setStaticRuntimeCudaGraphFactory(&createCudaGraph);
+  }
+};
+
+CudaGraphFactoryRegistration registration;
+
+} // namespace
+} // namespace jit
+} // namespace torch
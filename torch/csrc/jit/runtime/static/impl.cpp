@@ -1,12 +1,14 @@
 #include <torch/csrc/jit/runtime/static/impl.h>
 
 #include <ATen/MemoryOverlap.h>
+#include <ATen/Parallel.h>
 #include <ATen/core/symbol.h>
 #include <ATen/record_function.h>
 #include <c10/core/CPUAllocator.h>
 #include <c10/core/InferenceMode.h>
 #include <c10/macros/Macros.h>
 #include <c10/util/MaybeOwned.h>
+#include <c10/util/hash.h>
 #include <c10/util/irange.h>
 #include <caffe2/core/scope_guard.h>
 #include <caffe2/core/timer.h>
@@ -34,6 +36,8 @@
 #include <ATen/ops/clone_native.h>
 #endif
 
+#include <atomic>
+#include <cstring>
 #include <iterator>
 #include <limits>
 #include <sstream>
@@ -63,8 +67,21 @@ bool allArgsAreTensors(Node* node) {
   });
 }
 
+StaticRuntimeCudaGraphFactory& cudaGraphFactory() {
+  static StaticRuntimeCudaGraphFactory factory = nullptr;
+  return factory;
+}
+
 } // namespace
 
+void setStaticRuntimeCudaGraphFactory(StaticRuntimeCudaGraphFactory factory) {
+  cudaGraphFactory() = factory;
+}
+
+StaticRuntimeCudaGraphFactory getStaticRuntimeCudaGraphFactory() {
+  return cudaGraphFactory();
+}
+
 // A manually curated set of ops that are disallowed in static runtime.
 // These are rarely-used ops. Disallowing them typically eliminates
 // corner cases in graph optimizations, allowing for more aggressive
@@ -278,7 +295,8 @@ std::pair<std::shared_ptr<Graph>, c10::optional<Module>> PrepareForStaticModule(
             << opts.manage_output_tensors << ", use_copy_variants "
             << opts.use_copy_variants << ", use_maybe_copy_variants "
             << opts.use_maybe_copy_variants << ", enable_tensorexpr_fusion "
-            << opts.enable_tensorexpr_fusion;
+            << opts.enable_tensorexpr_fusion << ", enable_cuda_graphs "
+            << opts.enable_cuda_graphs;
 
   Module module = m.copy();
   if (!is_frozen) {
@@ -507,6 +525,101 @@ std::vector<const Value*> ManagedTensorRanges::
   return mutable_values;
 }
 
+namespace {
+
+// [Note: Static Runtime parallel levels]
+// When StaticModuleOptions::enable_parallel_levels is set, the root
+// block's nodes are partitioned into dependency levels at load time:
+// level(n) = 1 + max(level of the producers of n's inputs), with
+// constants and block inputs at level 0. Nodes within one level have no
+// data dependencies on each other, so BlockRunner executes each level's
+// nodes concurrently on the inter-op pool and joins on a future before
+// starting the next level (see run_nodes_parallel).
+//
+// The graph's nodes are also reordered stably by level here, before
+// value indices and tensor lifetimes are assigned. This matters for
+// correctness: the memory planner reuses a storage for two values whose
+// node-index lifetimes do not overlap, and with a level-sorted order a
+// value produced in level L is only consumed at higher levels, so no
+// storage reuse can fall inside a level that runs concurrently.
+//
+// Eligibility is conservative: any sub-block (prim::If/prim::Loop),
+// side-effecting node or value with writers (mutation survives the
+// RemoveMutation passes occasionally) keeps the block sequential, as
+// does a partition whose levels all have a single node (nothing to
+// overlap). Returns the node count of each level in order, counting
+// only the nodes that become ProcessedNodes (i.e. not constants), or an
+// empty vector when ineligible.
+std::vector<uint32_t> levelizeGraph(const std::shared_ptr<Graph>& graph) {
+  Block* block = graph->block();
+  for (Node* node : block->nodes()) {
+    if (!node->blocks().empty() || node->hasSideEffects()) {
+      return {};
+    }
+  }
+  AliasDb alias_db(graph, /*isFrozen=*/false);
+  for (Value* input : block->inputs()) {
+    if (alias_db.hasWriters(input)) {
+      return {};
+    }
+  }
+  for (Node* node : block->nodes()) {
+    for (Value* output : node->outputs()) {
+      if (alias_db.hasWriters(output)) {
+        return {};
+      }
+    }
+  }
+
+  const std::vector<Node*> original_order(
+      block->nodes().begin(), block->nodes().end());
+  FastMap<const Node*, uint32_t> node_level;
+  uint32_t max_level = 0;
+  for (Node* node : original_order) {
+    if (node->kind() == prim::Constant) {
+      node_level.emplace(node, 0);
+      continue;
+    }
+    uint32_t level = 1;
+    for (Value* input : node->inputs()) {
+      const auto it = node_level.find(input->node());
+      if (it != node_level.end()) {
+        level = std::max(level, it->second + 1);
+      }
+    }
+    node_level.emplace(node, level);
+    max_level = std::max(max_level, level);
+  }
+
+  std::vector<uint32_t> level_sizes(max_level, 0);
+  for (Node* node : original_order) {
+    if (node->kind() != prim::Constant) {
+      level_sizes[node_level.at(node) - 1]++;
+    }
+  }
+  const bool any_parallelism = std::any_of(
+      level_sizes.begin(), level_sizes.end(), [](uint32_t size) {
+        return size > 1;
+      });
+  if (!any_parallelism) {
+    return {};
+  }
+
+  // Stable sort by level: append the nodes level by level, keeping the
+  // original order within a level. Level order is a topological order,
+  // so every move is valid.
+  for (uint32_t level = 0; level <= max_level; ++level) {
+    for (Node* node : original_order) {
+      if (node_level.at(node) == level) {
+        node->moveBefore(block->return_node());
+      }
+    }
+  }
+  return level_sizes;
+}
+
+} // namespace
+
 StaticModule::StaticModule(
     std::shared_ptr<torch::jit::Graph> g,
     const StaticModuleOptions& opts,
@@ -547,6 +660,18 @@ StaticModule::StaticModule(
         opts_.enable_out_variant,
         "When optimize_memory is true, enable_out_variant must be set to true");
   }
+  if (opts_.memory_planner_batch_bucket_size > 0) {
+    TORCH_CHECK(
+        !opts_.manage_output_tensors,
+        "memory_planner_batch_bucket_size is not supported together with "
+        "manage_output_tensors");
+  }
+  if (opts_.enable_cuda_graphs) {
+    TORCH_CHECK(
+        !opts_.manage_output_tensors,
+        "enable_cuda_graphs is not supported together with "
+        "manage_output_tensors");
+  }
 
   // handle schema
   if (module_.has_value()) {
@@ -570,6 +695,13 @@ StaticModule::StaticModule(
     functions_.reserve(nodes_size);
   }
 
+  // Must run before value indices and lifetimes are assigned: it may
+  // reorder the graph's nodes. See [Note: Static Runtime parallel levels].
+  std::vector<uint32_t> node_level_sizes;
+  if (opts_.enable_parallel_levels) {
+    node_level_sizes = levelizeGraph(graph_);
+  }
+
   // Create ProcessedFunction instances first to freeze their addresses to pass
   // to ProcessedNode.
   AliasDb alias_db(graph_, /*isFrozen=*/false);
@@ -589,6 +721,11 @@ StaticModule::StaticModule(
 
   prepareStaticNodeInfos(graph_->block(), value_to_index, alias_db);
 
+  if (!node_level_sizes.empty()) {
+    block_infos_.at(graph_->block())
+        .set_node_level_sizes(std::move(node_level_sizes));
+  }
+
   for (auto& block_and_info : block_infos_) {
     auto& block_info = block_and_info.second;
     block_info.prepare_for_memory_planner(alias_db, opts);
@@ -887,6 +1024,22 @@ BlockRunner::BlockRunner(
     }
     pnode.set_metadata(std::move(block_runners));
   }
+
+  if (C10_UNLIKELY(sm.opts().enable_cuda_graphs) && is_root_block_) {
+    // Graph capture bakes in control flow, so runners whose graphs have
+    // sub-blocks (prim::If/prim::Loop) stay on the eager path.
+    // See [Note: Static Runtime CUDA graphs].
+    cuda_graphs_enabled_ = std::none_of(
+        nodes_.begin(), nodes_.end(), [](const ProcessedNode& pnode) {
+          return !pnode.node()->blocks().empty();
+        });
+  }
+
+  // Only the root block gets a level partition (levelizeGraph leaves
+  // ineligible graphs without one). See [Note: Static Runtime parallel
+  // levels].
+  parallel_levels_enabled_ =
+      is_root_block_ && !block_info_.node_level_sizes().empty();
 }
 
 // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init)
@@ -988,8 +1141,132 @@ void BlockRunner::create_memory_planner() {
   }
 }
 
+void BlockRunner::select_memory_planner(
+    const c10::IValue* args,
+    size_t nargs) {
+  const auto bucket_size =
+      static_module_.opts().memory_planner_batch_bucket_size;
+  if (bucket_size == 0) {
+    return;
+  }
+  // Bucket on the leading dimension of the first tensor input; inputs with
+  // no batched tensor all share bucket 0.
+  int64_t bucket = 0;
+  for (const auto i : c10::irange(nargs)) {
+    if (args[i].isTensor()) {
+      const auto& tensor = args[i].toTensor();
+      if (tensor.dim() > 0) {
+        bucket = (tensor.size(0) + static_cast<int64_t>(bucket_size) - 1) /
+            static_cast<int64_t>(bucket_size);
+      }
+      break;
+    }
+  }
+  if (bucket == active_planner_bucket_) {
+    return;
+  }
+  // Park the current plan and activate (or lazily create via
+  // create_memory_planner on this run's cleanup) the one for this bucket.
+  // Inactive plans hold no buffer; deallocate() ran at the end of their
+  // last iteration.
+  planner_buckets_[active_planner_bucket_] = std::move(planner_);
+  planner_ = std::move(planner_buckets_[bucket]);
+  active_planner_bucket_ = bucket;
+}
+
 namespace {
 
+// Number of eager runs per input-shape signature before a CUDA graph is
+// captured. See [Note: Static Runtime CUDA graphs].
+constexpr uint32_t kCudaGraphEagerRunsBeforeCapture = 2;
+
+// Tags for scalar args in a packed shape signature; tensor header words
+// always have a nonzero dim/device field, so the tags cannot collide with
+// them.
+constexpr uint64_t kShapeSignatureIntTag = 1;
+constexpr uint64_t kShapeSignatureDoubleTag = 2;
+constexpr uint64_t kShapeSignatureBoolTag = 3;
+constexpr uint64_t kShapeSignatureNoneTag = 4;
+
+// Packs the shape signature a captured CUDA graph bakes in into a flat
+// word buffer: per tensor arg a (dim | device | dtype) header word
+// followed by its sizes and strides, per scalar arg a tag word plus the
+// value bits (the captured kernels treat scalars as constants). Returns
+// false for arg types the signature cannot cover. The caller reuses the
+// buffer across runs, so steady state does not allocate.
+bool packCudaGraphShapeSignature(
+    const std::vector<c10::IValue>& args,
+    std::vector<uint64_t>& packed,
+    bool& has_cuda_input) {
+  packed.clear();
+  packed.push_back(args.size());
+  for (const auto& arg : args) {
+    if (arg.isTensor()) {
+      const auto& tensor = arg.toTensor();
+      const auto device = tensor.device();
+      packed.push_back(
+          (static_cast<uint64_t>(tensor.dim() + 1) << 32) |
+          (static_cast<uint64_t>(static_cast<uint8_t>(device.type())) << 16) |
+          (static_cast<uint64_t>(static_cast<uint8_t>(device.index() + 1))
+           << 8) |
+          static_cast<uint8_t>(tensor.scalar_type()));
+      for (const auto size : tensor.sizes()) {
+        packed.push_back(static_cast<uint64_t>(size));
+      }
+      for (const auto stride : tensor.strides()) {
+        packed.push_back(static_cast<uint64_t>(stride));
+      }
+      has_cuda_input |= device.is_cuda();
+    } else if (arg.isInt()) {
+      packed.push_back(kShapeSignatureIntTag);
+      packed.push_back(static_cast<uint64_t>(arg.toInt()));
+    } else if (arg.isDouble()) {
+      packed.push_back(kShapeSignatureDoubleTag);
+      uint64_t bits = 0;
+      const double value = arg.toDouble();
+      std::memcpy(&bits, &value, sizeof(bits));
+      packed.push_back(bits);
+    } else if (arg.isBool()) {
+      packed.push_back(kShapeSignatureBoolTag);
+      packed.push_back(static_cast<uint64_t>(arg.toBool()));
+    } else if (arg.isNone()) {
+      packed.push_back(kShapeSignatureNoneTag);
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Mixes a packed signature into one 64-bit fingerprint. Four independent
+// multiply-xor lanes keep the multiplies off each other's critical path
+// and let the compiler vectorize the loop, so a 200-input signature is
+// one linear pass over a contiguous buffer instead of a hash_combine
+// chain with per-dimension accessor calls.
+uint64_t fingerprintShapeSignature(const std::vector<uint64_t>& packed) {
+  constexpr uint64_t kMul = 0x9e3779b97f4a7c15ULL;
+  uint64_t lanes[4] = {
+      0x243f6a8885a308d3ULL,
+      0x13198a2e03707344ULL,
+      0xa4093822299f31d0ULL,
+      0x082efa98ec4e6c89ULL};
+  const size_t n = packed.size();
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    for (const auto j : c10::irange(4)) {
+      lanes[j] = (lanes[j] ^ packed[i + j]) * kMul;
+    }
+  }
+  for (; i < n; ++i) {
+    lanes[i % 4] = (lanes[i % 4] ^ packed[i]) * kMul;
+  }
+  uint64_t hash = static_cast<uint64_t>(n);
+  for (const auto j : c10::irange(4)) {
+    hash = (hash ^ lanes[j] ^ (lanes[j] >> 32)) * kMul;
+  }
+  return hash ^ (hash >> 32);
+}
+
 void destroyNodeOutputs(ProcessedNode& p_node) {
   const auto borrows_outputs = borrowsOutputs(p_node.node()->kind());
   for (const auto i : c10::irange(p_node.num_outputs())) {
@@ -1194,6 +1471,202 @@ void BlockRunner::Deallocator::cleanupImpl() {
   }
 }
 
+c10::optional<c10::IValue> BlockRunner::try_replay_cuda_graph(
+    const std::vector<c10::IValue>& args,
+    const KeywordArgs& kwargs) {
+  cuda_graph_capture_state_ = nullptr;
+  if (!kwargs.empty()) {
+    // kwargs are not part of the shape signature; keep such calls eager.
+    return c10::nullopt;
+  }
+  bool has_cuda_input = false;
+  if (!packCudaGraphShapeSignature(
+          args, shape_signature_buffer_, has_cuda_input) ||
+      !has_cuda_input) {
+    return c10::nullopt;
+  }
+  const auto fingerprint = fingerprintShapeSignature(shape_signature_buffer_);
+  auto& state = cuda_graphs_[fingerprint];
+  if (C10_UNLIKELY(state.signature.empty())) {
+    // First sighting of this fingerprint; remember the full signature so
+    // later fingerprint switches can detect collisions.
+    state.signature = shape_signature_buffer_;
+    last_shape_fingerprint_ = fingerprint;
+  } else if (fingerprint != last_shape_fingerprint_) {
+    // Signature switch: walk the full metadata once to rule out a 64-bit
+    // collision. Back-to-back runs with the same signature compare just
+    // the fingerprint word above.
+    if (C10_UNLIKELY(state.signature != shape_signature_buffer_)) {
+      LOG(WARNING) << "Static Runtime CUDA graph shape fingerprint "
+                      "collision; running the colliding signature eagerly";
+      return c10::nullopt;
+    }
+    last_shape_fingerprint_ = fingerprint;
+  }
+  if (C10_UNLIKELY(state.disabled)) {
+    return c10::nullopt;
+  }
+  if (!state.graph) {
+    // Capture on the third run for this signature: the first run profiles
+    // the memory plan and the second runs on the stabilized plan, so by
+    // the third the op sequence and allocation pattern are steady.
+    if (++state.eager_runs > kCudaGraphEagerRunsBeforeCapture) {
+      auto factory = getStaticRuntimeCudaGraphFactory();
+      if (factory == nullptr) {
+        LOG(WARNING) << "enable_cuda_graphs is set, but no CUDA graph "
+                        "backend is registered (CPU-only build?); "
+                        "running eagerly";
+        state.disabled = true;
+        return c10::nullopt;
+      }
+      state.graph = factory();
+      cuda_graph_capture_state_ = &state;
+    }
+    return c10::nullopt;
+  }
+  // Replay path. Stage the fresh inputs into the storages the captured
+  // kernels read, then launch the baked sequence on the current stream.
+  set_inputs(args, kwargs);
+  for (const auto i : c10::irange(block_info_.num_inputs())) {
+    auto& staged = state.input_tensors[i];
+    if (staged.defined()) {
+      staged.copy_(Input(i).toTensor(), /*non_blocking*/ true);
+    }
+  }
+  clean_up_input_ivalues();
+  state.graph->replay();
+  // Deep-copy the outputs: the next replay overwrites their storages.
+  if (state.outputs.size() > 1) {
+    std::vector<c10::IValue> outputs;
+    outputs.reserve(state.outputs.size());
+    for (const auto& output : state.outputs) {
+      outputs.emplace_back(output.deepcopy());
+    }
+    return c10::IValue(c10::ivalue::Tuple::create(std::move(outputs)));
+  }
+  return state.outputs[0].deepcopy();
+}
+
+void BlockRunner::run_nodes_with_cuda_graph_capture() {
+  auto& state = *cuda_graph_capture_state_;
+  cuda_graph_capture_state_ = nullptr;
+  // The captured kernels read the exact storages of this run's inputs;
+  // keep them alive so replays can refill them.
+  state.input_tensors.resize(block_info_.num_inputs());
+  for (const auto i : c10::irange(block_info_.num_inputs())) {
+    const auto& ival = Input(i);
+    if (ival.isTensor()) {
+      state.input_tensors[i] = ival.toTensor();
+    }
+  }
+  try {
+    state.graph->captureBegin();
+    for (auto& n : nodes_) {
+      n.run();
+      verify_and_correct_memory_overlap(n);
+    }
+    state.graph->captureEnd();
+  } catch (const std::exception& e) {
+    LOG(WARNING) << "CUDA graph capture failed (" << e.what()
+                 << "); falling back to eager execution for this input "
+                    "shape signature";
+    state.graph.reset();
+    state.input_tensors.clear();
+    state.disabled = true;
+    // Work recorded during the failed capture never executed; rerun the
+    // whole sequence eagerly so this iteration still produces outputs.
+    for (auto& n : nodes_) {
+      n.run();
+      verify_and_correct_memory_overlap(n);
+    }
+    return;
+  }
+  // Capture records kernels without executing them; replay once to
+  // compute this iteration's outputs for real.
+  state.graph->replay();
+  state.outputs.clear();
+  state.outputs.reserve(block_info_.num_outputs());
+  for (const auto i : c10::irange(block_info_.num_outputs())) {
+    state.outputs.emplace_back(*outputs_[i]);
+  }
+  // This run's outputs alias the static storages that the next replay
+  // overwrites; hand the caller copies instead.
+  for (const auto i : c10::irange(block_info_.num_outputs())) {
+    *outputs_[i] = state.outputs[i].deepcopy();
+  }
+}
+
+void BlockRunner::run_nodes_parallel() {
+  // See [Note: Static Runtime parallel levels]. Join state shared with
+  // the launched tasks; the future doubles as the level's join latch.
+  struct LevelJoin {
+    explicit LevelJoin(size_t n)
+        : remaining(n),
+          future(c10::make_intrusive<c10::ivalue::Future>(c10::NoneType::get())) {}
+    std::atomic<size_t> remaining;
+    std::mutex error_mutex;
+    std::exception_ptr error;
+    c10::intrusive_ptr<c10::ivalue::Future> future;
+
+    void record_error() {
+      std::lock_guard<std::mutex> guard(error_mutex);
+      if (!error) {
+        error = std::current_exception();
+      }
+    }
+
+    void count_down() {
+      if (remaining.fetch_sub(1) == 1) {
+        future->markCompleted();
+      }
+    }
+  };
+
+  const auto& level_sizes = block_info_.node_level_sizes();
+  size_t begin = 0;
+  for (const auto size : level_sizes) {
+    const size_t end = begin + size;
+    if (size == 1) {
+      auto& n = nodes_[begin];
+      n.run();
+      verify_and_correct_memory_overlap(n);
+      begin = end;
+      continue;
+    }
+    auto join = std::make_shared<LevelJoin>(size - 1);
+    for (size_t i = begin + 1; i < end; ++i) {
+      at::launch([this, i, join] {
+        // run_impl's InferenceMode guard is thread local; re-establish
+        // it so intermediates stay inference tensors on the pool too.
+        c10::InferenceMode mode;
+        try {
+          auto& n = nodes_[i];
+          n.run();
+          verify_and_correct_memory_overlap(n);
+        } catch (...) {
+          join->record_error();
+        }
+        join->count_down();
+      });
+    }
+    // The caller thread takes the level's first node instead of idling.
+    try {
+      auto& n = nodes_[begin];
+      n.run();
+      verify_and_correct_memory_overlap(n);
+    } catch (...) {
+      join->record_error();
+    }
+    // Always join before surfacing errors: the other tasks may still be
+    // writing into this runner's values.
+    join->future->wait();
+    if (C10_UNLIKELY(join->error != nullptr)) {
+      std::rethrow_exception(join->error);
+    }
+    begin = end;
+  }
+}
+
 template <typename IValueList>
 c10::IValue BlockRunner::run_impl(
     IValueList&& args,
@@ -1204,9 +1677,17 @@ c10::IValue BlockRunner::run_impl(
   // functions, such as resize_ and resize_as_.
   c10::InferenceMode mode;
 
+  if (C10_UNLIKELY(cuda_graphs_enabled_)) {
+    auto replayed = try_replay_cuda_graph(args, kwargs);
+    if (replayed.has_value()) {
+      return std::move(*replayed);
+    }
+  }
+
   {
     auto on_exit = Deallocator(*this);
 
+    select_memory_planner(args.data(), args.size());
     if (planner_) {
       DCHECK(!manage_output_tensors_enabled_ || checkOutputTensorMemoryLeaks());
       planner_->allocate();
@@ -1214,11 +1695,17 @@ c10::IValue BlockRunner::run_impl(
 
     set_inputs(std::forward<IValueList>(args), kwargs);
 
-    for (auto& n : nodes_) {
-      // LOG(INFO) << "Running node: " << PrintNode(n.node());
-      n.run();
-      // Check for incorrect schema alias info.
-      verify_and_correct_memory_overlap(n);
+    if (C10_UNLIKELY(cuda_graph_capture_state_ != nullptr)) {
+      run_nodes_with_cuda_graph_capture();
+    } else if (parallel_levels_enabled_) {
+      run_nodes_parallel();
+    } else {
+      for (auto& n : nodes_) {
+        // LOG(INFO) << "Running node: " << PrintNode(n.node());
+        n.run();
+        // Check for incorrect schema alias info.
+        verify_and_correct_memory_overlap(n);
+      }
     }
     on_exit.setFinished();
   }
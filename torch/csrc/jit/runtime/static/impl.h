@@ -186,6 +186,28 @@ struct TORCH_API StaticModuleOptions {
   bool use_maybe_copy_variants{true};
   // enable TensorExpr fusion of ops at model loading time
   bool enable_tensorexpr_fusion{false};
+  // If nonzero, keep a separate memory plan per batch-size bucket instead of
+  // letting a single plan regrow whenever the leading dimension of the first
+  // tensor input changes. Batch sizes are bucketed by rounding up to the
+  // next multiple of this value, so a service alternating between batch
+  // sizes only pays the profiling/replanning cost once per bucket.
+  // Incompatible with manage_output_tensors.
+  size_t memory_planner_batch_bucket_size{0};
+  // Capture the op sequence into a CUDA graph once per distinct
+  // input-shape signature and replay it on later runs, eliminating
+  // per-kernel launch overhead. Requires a CUDA build (runs eagerly
+  // otherwise) and only applies to graphs without sub-blocks whose ops
+  // all execute on CUDA. Incompatible with manage_output_tensors.
+  // See [Note: Static Runtime CUDA graphs].
+  bool enable_cuda_graphs{false};
+  // Partition the node list into dependency levels at load time and run
+  // the nodes of each level concurrently on the inter-op thread pool,
+  // joining between levels. Helps wide models (e.g. two-tower
+  // architectures) whose branches are independent. Only applies to
+  // graphs without sub-blocks, side effects or mutation; ineligible
+  // graphs silently stay sequential. See [Note: Static Runtime parallel
+  // levels].
+  bool enable_parallel_levels{false};
 };
 
 /*
@@ -208,6 +230,47 @@ class TORCH_API StaticRuntimeMetadata : public torch::CustomClassHolder {
   StaticModuleOptions opts_;
 };
 
+// [Note: Static Runtime CUDA graphs]
+// When StaticModuleOptions::enable_cuda_graphs is set, the root
+// BlockRunner captures its op sequence into a CUDA graph once per
+// distinct input-shape signature (after two eager warmup runs, so the
+// memory plan and allocation pattern have stabilized) and replays the
+// baked kernel sequence on later runs with matching shapes. Tensors
+// allocated while capturing come from the graph's private
+// CUDACachingAllocator pool (the pool-id mechanism of
+// CUDAGraph::capture_begin), so the storages the captured kernels touch
+// stay alive across replays. The runner additionally keeps references to
+// the input tensors it captured with and copies fresh inputs into their
+// storages before every replay; callers receive deep copies of the
+// outputs because replay rewrites the static output storages in place.
+// Each signature gets its own private pool: signatures replay in
+// arbitrary order, which is unsafe for a shared pool.
+//
+// BlockRunner is built into the CPU library and cannot depend on the
+// CUDA runtime directly, so the CUDA build registers a factory for this
+// interface at load time (see cuda_graphs.cpp). When no factory is
+// registered, the option is ignored and execution stays eager.
+class TORCH_API StaticRuntimeCudaGraph {
+ public:
+  virtual ~StaticRuntimeCudaGraph() = default;
+  // Switches to a capture-safe side stream and begins capture; every op
+  // run until captureEnd() is recorded instead of executed.
+  virtual void captureBegin() = 0;
+  // Ends capture, instantiates the executable graph and restores the
+  // previous stream. On failure the graph is unusable and the caller
+  // should fall back to eager execution.
+  virtual void captureEnd() = 0;
+  // Launches the captured kernel sequence on the current stream.
+  virtual void replay() = 0;
+};
+
+using StaticRuntimeCudaGraphFactory =
+    std::unique_ptr<StaticRuntimeCudaGraph> (*)();
+
+TORCH_API void setStaticRuntimeCudaGraphFactory(
+    StaticRuntimeCudaGraphFactory factory);
+TORCH_API StaticRuntimeCudaGraphFactory getStaticRuntimeCudaGraphFactory();
+
 /// The static runime supports two execution modes.
 ///
 /// Mode 1: single-threaded with no parallelism except for intra-op parallelism
@@ -303,6 +366,17 @@ class BlockInfo {
     output_indices_ = std::move(indices);
   }
 
+  // Number of nodes in each dependency level, in node order; empty
+  // unless enable_parallel_levels is on and the block is eligible.
+  // See [Note: Static Runtime parallel levels].
+  void set_node_level_sizes(std::vector<uint32_t> level_sizes) {
+    node_level_sizes_ = std::move(level_sizes);
+  }
+
+  const std::vector<uint32_t>& node_level_sizes() const {
+    return node_level_sizes_;
+  }
+
   const std::vector<uint16_t>& block_output_indices() const {
     return output_indices_;
   }
@@ -354,6 +428,7 @@ class BlockInfo {
 
  private:
   std::vector<StaticNodeInfo> nodes_;
+  std::vector<uint32_t> node_level_sizes_;
 
   ValueGroup value_group_;
 
@@ -745,6 +820,30 @@ class TORCH_API BlockRunner {
 
   void create_memory_planner();
 
+  // Swap in the memory plan for the batch-size bucket of this run's inputs.
+  // No-op unless memory_planner_batch_bucket_size is set.
+  void select_memory_planner(const c10::IValue* args, size_t nargs);
+
+  // Replays the CUDA graph captured for this run's input-shape signature,
+  // or returns nullopt when the run must execute eagerly (warmup, capture
+  // disabled, or no registered CUDA graph backend). May arm
+  // cuda_graph_capture_state_ to request capture on the eager path.
+  // See [Note: Static Runtime CUDA graphs].
+  c10::optional<c10::IValue> try_replay_cuda_graph(
+      const std::vector<c10::IValue>& args,
+      const KeywordArgs& kwargs);
+
+  // Runs the node sequence under CUDA graph capture, then replays once to
+  // produce this iteration's outputs. Falls back to a plain eager run if
+  // capture fails. See [Note: Static Runtime CUDA graphs].
+  void run_nodes_with_cuda_graph_capture();
+
+  // Runs the node sequence level by level, executing the nodes of each
+  // level concurrently on the inter-op pool and joining on a future
+  // before the next level starts. See [Note: Static Runtime parallel
+  // levels].
+  void run_nodes_parallel();
+
   float benchmark_model(
       const std::vector<std::vector<c10::IValue>>& args_list,
       const std::vector<KeywordArgs>& kwargs_list,
@@ -766,6 +865,49 @@ class TORCH_API BlockRunner {
 
   bool manage_output_tensors_enabled_ = false;
   std::unique_ptr<MemoryPlanner> planner_;
+  // Parked memory plans for inactive batch-size buckets; the plan for the
+  // current bucket always lives in planner_. Only populated when
+  // memory_planner_batch_bucket_size is set. See select_memory_planner().
+  std::unordered_map<int64_t, std::unique_ptr<MemoryPlanner>>
+      planner_buckets_;
+  int64_t active_planner_bucket_ = -1;
+  // Per input-shape-signature CUDA graph state; see
+  // [Note: Static Runtime CUDA graphs].
+  struct CudaGraphState {
+    std::unique_ptr<StaticRuntimeCudaGraph> graph;
+    // The packed metadata words this state's fingerprint was computed
+    // from; compared in full only when the fingerprint changes between
+    // runs, to rule out 64-bit collisions.
+    std::vector<uint64_t> signature;
+    // Tensors whose storages the captured kernels read; fresh inputs are
+    // copied into them before every replay. Indexed like Input(i);
+    // undefined for non-tensor inputs.
+    std::vector<at::Tensor> input_tensors;
+    // The outputs written at capture time; replay rewrites their storages
+    // in place, so callers always receive deep copies.
+    std::vector<c10::IValue> outputs;
+    // Eager runs observed for this signature before capturing.
+    uint32_t eager_runs = 0;
+    // Set when capture failed or is unavailable; the signature stays
+    // eager.
+    bool disabled = false;
+  };
+  // Set in the constructor; false unless enable_cuda_graphs is on and
+  // this is a root block without sub-blocks.
+  bool cuda_graphs_enabled_ = false;
+  // Set in the constructor; true when this block has a dependency-level
+  // partition to run on. See [Note: Static Runtime parallel levels].
+  bool parallel_levels_enabled_ = false;
+  // Armed by try_replay_cuda_graph when the current run should capture;
+  // consumed by run_nodes_with_cuda_graph_capture.
+  CudaGraphState* cuda_graph_capture_state_ = nullptr;
+  FastMap<uint64_t, CudaGraphState> cuda_graphs_;
+  // Reused packed (dtype, dims, sizes, strides, scalars) buffer for the
+  // shape guard and the fingerprint of the previous run's signature;
+  // back-to-back runs with stable shapes compare one word instead of
+  // walking every input's metadata.
+  std::vector<uint64_t> shape_signature_buffer_;
+  uint64_t last_shape_fingerprint_ = 0;
   // [Shared values array]
   // ProcessedNodes reference their inputs and outputs with
   // offsets into this array, which saves memory.
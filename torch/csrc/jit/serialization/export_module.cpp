@@ -14,6 +14,7 @@
 #include <torch/csrc/jit/mobile/module.h>
 #include <torch/csrc/jit/passes/inliner.h>
 #include <torch/csrc/jit/runtime/instruction.h>
+#include <torch/csrc/jit/runtime/profiling_graph_executor_impl.h>
 #include <torch/csrc/jit/serialization/callstack_debug_info_serialization.h>
 #include <torch/csrc/jit/serialization/export_bytecode.h>
 #include <torch/csrc/jit/serialization/import_export_constants.h>
@@ -449,6 +450,15 @@ void ScriptModuleSerializer::serialize(
     bool save_mobile_debug_info) {
   C10_LOG_API_USAGE_ONCE("torch.script.save");
   writeExtraFiles(module, extra_files);
+  // If any method executor has finished warmup profiling, ship its profiled
+  // state with the model so a fresh process can specialize on the first run.
+  // See Note [Profiled plan serialization] in
+  // profiling_graph_executor_impl.h.
+  std::string profiled_plans = serializeProfiledPlans(module);
+  if (!profiled_plans.empty()) {
+    writer_.writeRecord(
+        kProfiledPlansRecordName, profiled_plans.data(), profiled_plans.size());
+  }
   // Serialize the model object
   writeArchive(
       module._ivalue(),
@@ -26,6 +26,7 @@
 #include <torch/csrc/jit/mobile/file_format.h>
 #include <torch/csrc/jit/operator_upgraders/upgraders_entry.h>
 #include <torch/csrc/jit/passes/subgraph_rewrite.h>
+#include <torch/csrc/jit/runtime/profiling_graph_executor_impl.h>
 #include <torch/csrc/jit/serialization/import_read.h>
 #include <torch/csrc/jit/serialization/import_source.h>
 #include <torch/csrc/jit/serialization/pickle.h>
@@ -33,6 +34,8 @@
 #include <torch/csrc/jit/serialization/unpickler.h>
 
 #include <ATen/ATen.h>
+#include <ATen/MapAllocator.h>
+#include <ATen/detail/CUDAHooksInterface.h>
 #include <fmt/format.h>
 
 #include <fstream>
@@ -124,6 +127,16 @@ class ScriptModuleDeserializer final {
       c10::optional<at::Device> device,
       ExtraFilesMap& extra_files);
 
+  // Overrides how tensor payloads are produced (e.g. served out of an mmap
+  // of the archive rather than copied via getRecord(), or staged for the
+  // device the tensor is restored to, see
+  // Note [Device-aware checkpoint restore]).
+  void setRecordReader(
+      std::function<at::DataPtr(const std::string&, const at::Device&)>
+          record_reader) {
+    record_reader_ = std::move(record_reader);
+  }
+
  private:
   IValue readArchive(const std::string& archive_name);
 
@@ -135,6 +148,8 @@ class ScriptModuleDeserializer final {
   std::string code_prefix_;
   std::string pickle_dir_prefix_;
   std::string tensor_dir_prefix_;
+  std::function<at::DataPtr(const std::string&, const at::Device&)>
+      record_reader_;
   SourceImporter source_importer_;
 };
 
@@ -187,7 +202,8 @@ IValue ScriptModuleDeserializer::readArchive(const std::string& archive_name) {
       device_,
       *reader_.get(),
       nullptr,
-      storage_context_);
+      storage_context_,
+      record_reader_);
 }
 
 void rewriteQuantizedConvForBC(const Module& module) {
@@ -249,6 +265,98 @@ graph(%x, %packed_params, %stride, %padding, %dilation, %groups, %r_scale, %r_ze
   }
 }
 
+
+// Serves tensor payloads directly out of a shared read-only mapping of the
+// archive file. Records written by PyTorchStreamWriter are stored
+// uncompressed and 64-byte aligned, so storages can point straight into the
+// mapping; anything else falls back to a copying getRecord(). Each returned
+// DataPtr keeps the whole-file mapping alive through its deleter, so the
+// mapping is released once the last storage using it goes away.
+std::function<at::DataPtr(const std::string&, const at::Device&)>
+make_mmap_record_reader(
+    const std::string& filename,
+    std::shared_ptr<PyTorchStreamReader> reader) {
+  size_t file_size = 0;
+  {
+    std::ifstream file(filename, std::ifstream::binary | std::ifstream::ate);
+    TORCH_CHECK(
+        file, "could not open file ", filename, " for memory mapping");
+    file_size = static_cast<size_t>(file.tellg());
+  }
+  size_t actual_size = 0;
+  auto mapping = std::make_shared<at::DataPtr>(at::MapAllocator::makeDataPtr(
+      filename, /*flags=*/0, file_size, &actual_size));
+  return [mapping = std::move(mapping),
+          reader = std::move(reader),
+          file_size](
+             const std::string& name,
+             const at::Device& /* device */) -> at::DataPtr {
+    if (!reader->isRecordStored(name)) {
+      return std::get<0>(reader->getRecord(name));
+    }
+    size_t offset = reader->getRecordOffset(name);
+    size_t size = reader->getRecordSize(name);
+    TORCH_CHECK(
+        offset + size <= file_size,
+        "record ",
+        name,
+        " extends past the end of the archive");
+    void* data = static_cast<char*>(mapping->get()) + offset;
+    auto* keep_alive = new std::shared_ptr<at::DataPtr>(mapping);
+    return at::DataPtr(
+        data,
+        keep_alive,
+        [](void* ctx) {
+          delete static_cast<std::shared_ptr<at::DataPtr>*>(ctx);
+        },
+        at::DeviceType::CPU);
+  };
+}
+
+// Note [Device-aware checkpoint restore]
+// Restoring a CUDA-destined storage used to bounce through pageable host
+// memory twice: getRecord() copies the payload out of the zip into a
+// malloc'd buffer, and tensor.to(device) then pays a pageable H2D copy.
+// The record reader hook is device-aware (it is told which device the
+// tensor will be restored to), so for GPU-destined stored (uncompressed)
+// records we read the payload at its known archive offset straight into
+// pinned memory instead; the subsequent upload in the unpickler then runs
+// as DMA at link speed and the pageable staging copy disappears. The
+// pinned buffers come from the caching host allocator, so they are
+// recycled across records of a large checkpoint rather than
+// cudaHostAlloc'd per tensor. Compressed records and CPU-destined
+// storages fall back to the plain getRecord() path. A reader that
+// produces the payload directly in device memory (e.g. via GPUDirect
+// Storage) can slot into the same hook; the unpickler already builds the
+// tensor on the storage's device in that case.
+std::function<at::DataPtr(const std::string&, const at::Device&)>
+make_pinned_record_reader(
+    const std::string& filename,
+    std::shared_ptr<PyTorchStreamReader> reader) {
+  auto file =
+      std::make_shared<std::ifstream>(filename, std::ifstream::binary);
+  TORCH_CHECK(
+      *file, "could not reopen file ", filename, " for direct record reads");
+  return [file = std::move(file), reader = std::move(reader)](
+             const std::string& name,
+             const at::Device& device) -> at::DataPtr {
+    if (!device.is_cuda() || !at::globalContext().hasCUDA() ||
+        !reader->hasRecord(name) || !reader->isRecordStored(name)) {
+      return std::get<0>(reader->getRecord(name));
+    }
+    size_t offset = reader->getRecordOffset(name);
+    size_t size = reader->getRecordSize(name);
+    at::DataPtr buf =
+        at::detail::getCUDAHooks().getPinnedMemoryAllocator()->allocate(size);
+    file->clear();
+    file->seekg(static_cast<std::streamoff>(offset));
+    file->read(static_cast<char*>(buf.get()), static_cast<std::streamsize>(size));
+    TORCH_CHECK(
+        *file, "failed to read record ", name, " from file ", filename);
+    return buf;
+  };
+}
+
 Module ScriptModuleDeserializer::deserialize(
     c10::optional<at::Device> device,
     ExtraFilesMap& extra_files) {
@@ -283,6 +391,17 @@ Module ScriptModuleDeserializer::deserialize(
   }
   auto m = Module(readArchive("data").toObject());
   rewriteQuantizedConvForBC(m);
+  // Rehydrate warmed-up profiling state shipped with the model, if any.
+  // See Note [Profiled plan serialization] in
+  // profiling_graph_executor_impl.h.
+  if (reader_->hasRecord(kProfiledPlansRecordName)) {
+    at::DataPtr plans_ptr;
+    size_t plans_size = 0;
+    std::tie(plans_ptr, plans_size) =
+        reader_->getRecord(kProfiledPlansRecordName);
+    deserializeProfiledPlans(
+        m, std::string(static_cast<const char*>(plans_ptr.get()), plans_size));
+  }
   return m;
 }
 } // namespace
@@ -356,12 +475,24 @@ Module import_ir_module(
     std::shared_ptr<CompilationUnit> cu,
     const std::string& filename,
     c10::optional<at::Device> device,
-    ExtraFilesMap& extra_files) {
+    ExtraFilesMap& extra_files,
+    bool mmap_storages) {
   // NOTE: Zipformat can be large files. So using stream version directly
   // instead of reading the file all at once.
   if (getFileFormat(filename) != FileFormat::FlatbufferFileFormat) {
-    auto reader = torch::make_unique<PyTorchStreamReader>(filename);
-    ScriptModuleDeserializer deserializer(std::move(cu), std::move(reader));
+    auto reader = std::make_shared<PyTorchStreamReader>(filename);
+    ScriptModuleDeserializer deserializer(std::move(cu), reader);
+    if (mmap_storages) {
+      deserializer.setRecordReader(
+          make_mmap_record_reader(filename, std::move(reader)));
+    } else if (
+        at::globalContext().hasCUDA() && (!device || device->is_cuda())) {
+      // GPU-destined storages are staged through pinned memory, see
+      // Note [Device-aware checkpoint restore]. CPU-destined records take
+      // the regular getRecord() path inside the reader.
+      deserializer.setRecordReader(
+          make_pinned_record_reader(filename, std::move(reader)));
+    }
     return deserializer.deserialize(device, extra_files);
   }
   std::shared_ptr<char> data;
@@ -410,17 +541,24 @@ Module load(
   return import_ir_module(std::move(cu), in, device, extra_files);
 }
 
-Module load(const std::string& filename, c10::optional<at::Device> device) {
+Module load(
+    const std::string& filename,
+    c10::optional<at::Device> device,
+    bool mmap_storages) {
   auto cu = std::make_shared<CompilationUnit>();
-  return import_ir_module(std::move(cu), filename, device);
+  ExtraFilesMap extra_files;
+  return import_ir_module(
+      std::move(cu), filename, device, extra_files, mmap_storages);
 }
 
 Module load(
     const std::string& filename,
     c10::optional<at::Device> device,
-    ExtraFilesMap& extra_files) {
+    ExtraFilesMap& extra_files,
+    bool mmap_storages) {
   auto cu = std::make_shared<CompilationUnit>();
-  return import_ir_module(std::move(cu), filename, device, extra_files);
+  return import_ir_module(
+      std::move(cu), filename, device, extra_files, mmap_storages);
 }
 
 Module load(
@@ -36,7 +36,12 @@ TORCH_API Module import_ir_module(
     std::shared_ptr<CompilationUnit> cu,
     const std::string& filename,
     c10::optional<c10::Device> device,
-    ExtraFilesMap& extra_files);
+    ExtraFilesMap& extra_files,
+    // When true, uncompressed tensor records are memory-mapped from the
+    // archive instead of copied into freshly allocated CPU memory. Loading
+    // becomes page-fault-lazy and the mapped pages are shared between
+    // processes loading the same file.
+    bool mmap_storages = false);
 
 // For reading unified serialization format from torch.Package
 TORCH_API Module import_ir_module(
@@ -83,12 +88,14 @@ TORCH_API Module load(
 /// Python or `torch::jit::ExportModule` in C++.
 TORCH_API Module load(
     const std::string& filename,
-    c10::optional<c10::Device> device = c10::nullopt);
+    c10::optional<c10::Device> device = c10::nullopt,
+    bool mmap_storages = false);
 
 TORCH_API Module load(
     const std::string& filename,
     c10::optional<c10::Device> device,
-    ExtraFilesMap& extra_files);
+    ExtraFilesMap& extra_files,
+    bool mmap_storages = false);
 
 /// Loads a serialized `Module` from the given shared_ptr `rai`.
 ///
@@ -13,7 +13,9 @@ IValue readArchiveAndTensors(
     c10::optional<at::Device> device,
     caffe2::serialize::PyTorchStreamReader& stream_reader,
     c10::TypePtr (*type_parser)(const std::string&),
-    std::shared_ptr<DeserializationStorageContext> storage_context) {
+    std::shared_ptr<DeserializationStorageContext> storage_context,
+    std::function<at::DataPtr(const std::string&, const at::Device&)>
+        record_reader) {
   std::string picklename = pickle_prefix + archive_name + ".pkl";
   at::DataPtr pickle_ptr;
   size_t pickle_size = 0;
@@ -38,6 +40,9 @@ IValue readArchiveAndTensors(
 
   auto read_record = [&](const std::string& name) {
     std::string ss = tensor_dir_path + name;
+    if (record_reader) {
+      return record_reader(ss, at::Device(at::kCPU));
+    }
     return std::get<0>(stream_reader.getRecord(ss));
   };
 
@@ -50,6 +55,13 @@ IValue readArchiveAndTensors(
       false,
       type_parser,
       storage_context);
+  if (record_reader) {
+    unpickler.set_device_record_reader(
+        [&record_reader, tensor_dir_path](
+            const std::string& name, const at::Device& device) {
+          return record_reader(tensor_dir_path + name, device);
+        });
+  }
   unpickler.set_version(stream_reader.version());
   return unpickler.parse_ivalue();
 }
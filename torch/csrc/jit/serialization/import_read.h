@@ -22,7 +22,14 @@ TORCH_API IValue readArchiveAndTensors(
     caffe2::serialize::PyTorchStreamReader& stream_reader,
     c10::TypePtr (*type_parser)(const std::string&) =
         Unpickler::defaultTypeParser,
-    std::shared_ptr<DeserializationStorageContext> storage_context = nullptr);
+    std::shared_ptr<DeserializationStorageContext> storage_context = nullptr,
+    // When set, used instead of stream_reader.getRecord() to produce tensor
+    // payloads (e.g. to serve them out of an mmap of the archive, or staged
+    // for a particular destination device). Receives the full record name
+    // including the tensor dir prefix and the device the tensor will be
+    // restored to, see Note [Device-aware checkpoint restore] in import.cpp.
+    std::function<at::DataPtr(const std::string&, const at::Device&)>
+        record_reader = nullptr);
 
 bool check_zip_file(
     std::shared_ptr<caffe2::serialize::ReadAdapterInterface> rai);
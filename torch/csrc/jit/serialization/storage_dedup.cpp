@@ -0,0 +1,100 @@
+#include <torch/csrc/jit/serialization/storage_dedup.h>
+
+#include <c10/util/intrusive_ptr.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+bool env_dedup_enabled() {
+  const char* value = std::getenv("TORCH_DEDUP_LOADED_STORAGES");
+  return value != nullptr && std::atoi(value) != 0;
+}
+
+std::atomic<bool>& dedup_enabled_flag() {
+  static std::atomic<bool> enabled{env_dedup_enabled()};
+  return enabled;
+}
+
+// FNV-1a over the storage bytes. Collisions are fine: candidates with the
+// same hash are confirmed with memcmp before being shared.
+uint64_t hash_bytes(const void* data, size_t nbytes) {
+  constexpr uint64_t kPrime = 0x100000001b3;
+  uint64_t hash = 0xcbf29ce484222325;
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  for (size_t i = 0; i < nbytes; i++) {
+    hash = (hash ^ bytes[i]) * kPrime;
+  }
+  return hash;
+}
+
+struct DedupCache {
+  std::mutex mutex;
+  // Weak references so the cache never extends a storage's lifetime;
+  // expired entries are pruned when their bucket is next probed.
+  std::unordered_multimap<uint64_t, c10::weak_intrusive_ptr<c10::StorageImpl>>
+      by_hash;
+  StorageDedupStats stats;
+};
+
+DedupCache& dedup_cache() {
+  // Leaked to avoid destruction-order issues with storages freed at exit.
+  static DedupCache* cache = new DedupCache();
+  return *cache;
+}
+
+} // namespace
+
+bool getStorageDedupEnabled() {
+  return dedup_enabled_flag().load();
+}
+
+void setStorageDedupEnabled(bool enabled) {
+  dedup_enabled_flag().store(enabled);
+}
+
+c10::Storage dedupLoadedStorage(c10::Storage storage) {
+  if (!getStorageDedupEnabled() || !storage || storage.nbytes() == 0 ||
+      !storage.device().is_cpu() || storage.resizable()) {
+    return storage;
+  }
+  const size_t nbytes = storage.nbytes();
+  const uint64_t hash = hash_bytes(storage.data(), nbytes);
+
+  auto& cache = dedup_cache();
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  cache.stats.lookups++;
+  auto range = cache.by_hash.equal_range(hash);
+  for (auto it = range.first; it != range.second;) {
+    auto candidate = it->second.lock();
+    if (!candidate) {
+      it = cache.by_hash.erase(it);
+      continue;
+    }
+    if (candidate->nbytes() == nbytes &&
+        std::memcmp(candidate->data(), storage.data(), nbytes) == 0) {
+      cache.stats.hits++;
+      cache.stats.bytes_saved += nbytes;
+      return c10::Storage(std::move(candidate));
+    }
+    ++it;
+  }
+  cache.by_hash.emplace(hash, storage.getWeakStorageImpl());
+  return storage;
+}
+
+StorageDedupStats getStorageDedupStats() {
+  auto& cache = dedup_cache();
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  return cache.stats;
+}
+
+} // namespace jit
+} // namespace torch
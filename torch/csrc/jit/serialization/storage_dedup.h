@@ -0,0 +1,45 @@
+#pragma once
+
+#include <c10/core/Storage.h>
+#include <c10/macros/Export.h>
+
+#include <cstdint>
+
+namespace torch {
+namespace jit {
+
+// Content-addressed deduplication of storages created during
+// deserialization. When enabled, loading a storage whose bytes are
+// identical to one from an earlier load returns a reference to the
+// existing StorageImpl instead of keeping a second copy, so ensembles of
+// fine-tuned variants that share most weights byte-identically fit in
+// memory.
+//
+// Shared storages alias: an in-place write to a deduplicated parameter is
+// visible in every module that shares it. This tree has no copy-on-write
+// StorageImpl to materialize a private copy on write, so deduplication is
+// opt-in and intended for frozen inference weights. It is off by default;
+// enable it with setStorageDedupEnabled(true) or by setting the
+// TORCH_DEDUP_LOADED_STORAGES environment variable to a nonzero value.
+
+TORCH_API bool getStorageDedupEnabled();
+TORCH_API void setStorageDedupEnabled(bool enabled);
+
+// Returns a storage with the same contents as `storage`, shared with a
+// previously loaded storage when one with identical bytes is still alive.
+// Only CPU storages are deduplicated; others are returned unchanged.
+TORCH_API c10::Storage dedupLoadedStorage(c10::Storage storage);
+
+struct StorageDedupStats {
+  // Storages offered to the cache while deduplication was enabled.
+  uint64_t lookups = 0;
+  // Storages that matched an existing one and were shared.
+  uint64_t hits = 0;
+  // Total size of the dropped duplicate copies.
+  uint64_t bytes_saved = 0;
+};
+
+TORCH_API StorageDedupStats getStorageDedupStats();
+
+} // namespace jit
+} // namespace torch
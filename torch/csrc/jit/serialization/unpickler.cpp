@@ -7,6 +7,7 @@
 #include <torch/csrc/jit/mobile/type_parser.h>
 #include <torch/csrc/jit/serialization/pickler.h>
 #include <torch/csrc/jit/serialization/storage_context.h>
+#include <torch/csrc/jit/serialization/storage_dedup.h>
 #include <torch/csrc/jit/serialization/unpickler.h>
 #include <string>
 
@@ -476,7 +477,9 @@ PickleOpCode Unpickler::readInstruction() {
           // If there are no elements in the tensor, there's no point in
           // reading a zero (0) byte file from the input stream and paying
           // that cost.
-          storage_ptr = read_record_(key);
+          storage_ptr = device_record_reader_
+              ? device_record_reader_(key, device)
+              : read_record_(key);
         }
 
         storage = at::Storage(
@@ -486,13 +489,19 @@ PickleOpCode Unpickler::readInstruction() {
             /*allocator=*/nullptr,
             /*resizable=*/false); // NB: we didn't set any allocator for the
                                   // tensor
+        // Opt-in: share this storage with a byte-identical one from an
+        // earlier load (see storage_dedup.h). No-op when disabled.
+        storage = dedupLoadedStorage(std::move(storage));
         if (storage_context_ != nullptr) {
           storage_context_->addStorage(key, storage);
         }
       }
 
       auto options = at::CPU(type).options();
-      if (use_storage_device_) {
+      // A device-aware record reader may have produced the payload directly
+      // on the destination device; build the tensor there instead of
+      // bouncing it through host memory.
+      if (use_storage_device_ || !storage.device().is_cpu()) {
         options = options.device(storage.device());
         device = storage.device();
       }
@@ -90,6 +90,15 @@ class TORCH_API Unpickler {
     version_ = version_number;
   }
 
+  // Overrides how tensor payloads destined for a particular device are
+  // produced; read_record_ is used when unset. See
+  // Note [Device-aware checkpoint restore] in import.cpp.
+  void set_device_record_reader(
+      std::function<at::DataPtr(const std::string&, const at::Device&)>
+          device_record_reader) {
+    device_record_reader_ = std::move(device_record_reader);
+  }
+
   static c10::TypePtr defaultTypeParser(const std::string& str) {
     ScriptTypeParser parser;
     return parser.parseType(str);
@@ -162,6 +171,12 @@ class TORCH_API Unpickler {
   IValue empty_tuple_;
 
   std::function<at::DataPtr(const std::string&)> read_record_;
+  // Device-aware variant of read_record_, preferred when set. It may
+  // return the payload in pinned host memory or directly on the
+  // destination device, see Note [Device-aware checkpoint restore] in
+  // import.cpp.
+  std::function<at::DataPtr(const std::string&, const at::Device&)>
+      device_record_reader_;
   c10::optional<at::Device> device_;
   // When set to true, Unpickler will ignore the pickled device and use the
   // device of the DataPtr returned by the read_record_ function. The default
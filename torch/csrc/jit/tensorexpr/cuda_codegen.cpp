@@ -1069,6 +1069,31 @@ void CudaCodeGen::Initialize() {
 #endif
   }
 
+  // Chains of small fused ops are launch-latency-bound, and most pointwise
+  // fusions have fully constant launch geometry. Evaluate it once here so
+  // call_raw() can skip the extent evaluators (and the lock guarding them)
+  // on the hot path.
+  has_constant_launch_extents_ =
+      block_extents.size() <= 3 && thread_extents.size() <= 3;
+  for (const auto& be : block_extents) {
+    has_constant_launch_extents_ =
+        has_constant_launch_extents_ && be->isConstant();
+  }
+  for (const auto& te : thread_extents) {
+    has_constant_launch_extents_ =
+        has_constant_launch_extents_ && te->isConstant();
+  }
+  if (has_constant_launch_extents_) {
+    const_block_extents_v_.assign(3, 1);
+    const_thread_extents_v_.assign(3, 1);
+    for (size_t i = 0; i < block_extents.size(); i++) {
+      const_block_extents_v_[i] = immediateAs<int64_t>(block_extents[i]);
+    }
+    for (size_t i = 0; i < thread_extents.size(); i++) {
+      const_thread_extents_v_[i] = immediateAs<int64_t>(thread_extents[i]);
+    }
+  }
+
   GRAPH_DEBUG(
       "Fused TE CUDA kernel:\n",
       oss_.str(),
@@ -1154,39 +1179,45 @@ void CudaCodeGen::call_raw(const std::vector<void*>& raw_args) {
   // NOLINTNEXTLINE(cppcoreguidelines-init-variables)
   std::vector<int> gpu_thread_extents_v(3, 1);
 
-  // evaluate all the block/thread extents into values
-  // TODO: eventually, codegen these calculations and make them part of the
-  // module.
-  std::vector<void*> extent_args;
-  size_t raw_args_size = raw_args.size();
-  extent_args.reserve(raw_args_size);
-  for (size_t i = 0; i < raw_args_size; ++i) {
-    if (arg_pos_in_extents_[i]) {
-      extent_args.push_back(raw_args[i]);
-    }
-  }
-  for (size_t i = 0; i < gpu_block_extents.size(); i++) {
-    if (gpu_block_extents[i]->isConstant()) {
-      gpu_block_extents_v[i] = immediateAs<int64_t>(gpu_block_extents[i]);
-      continue;
-    }
-    {
-      // invocation of block_extents_eval_ isn't thread safe and this function
-      // may be invoked by multiple threads
-      std::lock_guard<std::mutex> guard(eval_lock_);
-      gpu_block_extents_v[i] =
-          block_extents_eval_[i].value<int64_t>(extent_args);
+  if (has_constant_launch_extents_) {
+    // Geometry was evaluated once at compile time; see Initialize().
+    gpu_block_extents_v = const_block_extents_v_;
+    gpu_thread_extents_v = const_thread_extents_v_;
+  } else {
+    // evaluate all the block/thread extents into values
+    // TODO: eventually, codegen these calculations and make them part of the
+    // module.
+    std::vector<void*> extent_args;
+    size_t raw_args_size = raw_args.size();
+    extent_args.reserve(raw_args_size);
+    for (size_t i = 0; i < raw_args_size; ++i) {
+      if (arg_pos_in_extents_[i]) {
+        extent_args.push_back(raw_args[i]);
+      }
     }
-  }
-  for (size_t i = 0; i < gpu_thread_extents.size(); i++) {
-    if (gpu_thread_extents[i]->isConstant()) {
-      gpu_thread_extents_v[i] = immediateAs<int64_t>(gpu_thread_extents[i]);
-      continue;
+    for (size_t i = 0; i < gpu_block_extents.size(); i++) {
+      if (gpu_block_extents[i]->isConstant()) {
+        gpu_block_extents_v[i] = immediateAs<int64_t>(gpu_block_extents[i]);
+        continue;
+      }
+      {
+        // invocation of block_extents_eval_ isn't thread safe and this
+        // function may be invoked by multiple threads
+        std::lock_guard<std::mutex> guard(eval_lock_);
+        gpu_block_extents_v[i] =
+            block_extents_eval_[i].value<int64_t>(extent_args);
+      }
     }
-    {
-      std::lock_guard<std::mutex> guard(eval_lock_);
-      gpu_thread_extents_v[i] =
-          thread_extents_eval_[i].value<int64_t>(extent_args);
+    for (size_t i = 0; i < gpu_thread_extents.size(); i++) {
+      if (gpu_thread_extents[i]->isConstant()) {
+        gpu_thread_extents_v[i] = immediateAs<int64_t>(gpu_thread_extents[i]);
+        continue;
+      }
+      {
+        std::lock_guard<std::mutex> guard(eval_lock_);
+        gpu_thread_extents_v[i] =
+            thread_extents_eval_[i].value<int64_t>(extent_args);
+      }
     }
   }
 
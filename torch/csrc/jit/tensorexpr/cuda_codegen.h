@@ -278,6 +278,12 @@ class TORCH_CUDA_CU_API CudaCodeGen : public CodeGen {
   bool has_random_ = false;
   int thread_block_size_ = -1;
 
+  // When the launch geometry is fully constant it is evaluated once at
+  // compile time; call_raw() then skips the extent evaluators entirely.
+  bool has_constant_launch_extents_ = false;
+  std::vector<int> const_block_extents_v_;
+  std::vector<int> const_thread_extents_v_;
+
   std::vector<bool> arg_pos_in_extents_;
 #ifdef TORCH_ENABLE_LLVM
   std::vector<ExprEval<LLVMCodeGen>> block_extents_eval_;
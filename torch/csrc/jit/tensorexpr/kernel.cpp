@@ -557,53 +557,61 @@ Tensor TensorExprKernel::computeValue(const torch::jit::Value* v) {
   throw malformed_input(msg);
 }
 
-// True if all the loops in this vector have equal bounds.
-bool loopBoundsAllEqual(const std::vector<ForPtr>& loops) {
-  if (loops.size() <= 1) {
-    return true;
+// Recursively fuse all the loops with matching bounds in `st`.  Sibling
+// loops are grouped into maximal runs of adjacent loops (non-loop statements
+// end a run), and each run is fused greedily: a loop that cannot legally
+// join the current fused loop — mismatched bounds, or a fusion that would
+// create a loop-carried dependence, such as a loop consuming a reduction the
+// current fused loop is still accumulating — starts a new fused loop instead
+// of blocking fusion of the rest of the run.  This keeps independent
+// reductions over the same buffer, and the pointwise loops around them, in a
+// single traversal of memory.  The restriction on matching bounds exists to
+// avoid inserting conditionals on the loop indices where none would be
+// needed, which would significantly complicate vectorization.
+void fuseAllLoops(StmtPtr st) {
+  auto block = to<tensorexpr::Block>(st);
+  if (block == nullptr) {
+    return;
   }
-  const auto& start = loops.front()->start();
-  const auto& stop = loops.front()->stop();
-  for (size_t i = 1; i < loops.size(); ++i) {
-    const auto& curr_start = loops[i]->start();
-    const auto& curr_stop = loops[i]->stop();
-    if (!exprEquals(start, curr_start) || !exprEquals(stop, curr_stop)) {
-      return false;
+
+  std::vector<std::vector<ForPtr>> all_outer_loops;
+  std::vector<ForPtr> outer_loops;
+  for (auto stmt : *block) {
+    auto loop = to<For>(stmt);
+    if (!loop) {
+      if (!outer_loops.empty()) {
+        all_outer_loops.push_back(outer_loops);
+        outer_loops.clear();
+      }
+      continue;
     }
+    outer_loops.push_back(loop);
+  }
+  if (!outer_loops.empty()) {
+    all_outer_loops.push_back(outer_loops);
   }
-  return true;
-}
 
-// Recursively fuse all the loops with matching bounds in `st`.  Stops fusing
-// at any level containing non-loops or non-matching bounds.  The restriction
-// on matching bounds exists to avoid inserting conditionals on the loop
-// indices where none would be needed, which would significantly complicate
-// vectorization.
-void fuseAllLoops(StmtPtr st) {
-  if (auto block = to<tensorexpr::Block>(st)) {
-    std::vector<ForPtr> loopsToFuse;
-    for (auto stmt : *block) {
-      auto loop = to<For>(stmt);
-      if (!loop) {
-        // Block contains something that's not a loop.  Quit.
-        return;
+  for (const auto& loops : all_outer_loops) {
+    std::vector<ForPtr> fused_loops;
+    ForPtr current = loops.front();
+    for (size_t i = 1; i < loops.size(); ++i) {
+      // NOLINTNEXTLINE(cppcoreguidelines-init-variables)
+      ForPtr fused;
+      // fuseLoops checks both bounds equality and legality (no loop-carried
+      // dependence in the fused loop) and leaves the loops untouched when it
+      // declines, so a failed attempt just seals the current group.
+      if (LoopNest::fuseLoops({current, loops[i]}, &fused)) {
+        current = fused;
+      } else {
+        fused_loops.push_back(current);
+        current = loops[i];
       }
-      loopsToFuse.push_back(loop);
     }
-    if (loopsToFuse.empty()) {
-      return;
-    }
-    // TODO: Support fusing some of the loops in a block.
-    // Currently, we only fuse all the loops in a block, which is restrictive.
-    if (!loopBoundsAllEqual(loopsToFuse)) {
-      return;
-    }
-    // NOLINTNEXTLINE(cppcoreguidelines-init-variables)
-    ForPtr fusedLoop;
-    if (!LoopNest::fuseLoops(loopsToFuse, &fusedLoop)) {
-      return;
+    fused_loops.push_back(current);
+
+    for (const auto& fused : fused_loops) {
+      fuseAllLoops(fused->body());
     }
-    fuseAllLoops(fusedLoop->body());
   }
 }
 
@@ -49,6 +49,8 @@
 
 #include <torch/csrc/jit/jit_log.h>
 
+#include <atomic>
+#include <cstdlib>
 #include <memory>
 
 using namespace torch::jit::tensorexpr;
@@ -178,24 +180,34 @@ class LLVMCodeGenCallee {
  public:
   LLVMCodeGenCallee(
       std::unique_ptr<llvm::orc::PytorchLLVMJIT> jit,
-      void* kernelAddress)
-      : jit_(std::move(jit)), kernelAddress_(kernelAddress) {}
+      void* kernelAddress,
+      std::string kernelFuncName)
+      : jit_(std::move(jit)),
+        kernelAddress_(kernelAddress),
+        kernelFuncName_(std::move(kernelFuncName)) {}
 
   llvm::orc::PytorchLLVMJIT* getJIT() {
     return jit_.get();
   }
 
   void* getKernelAddress() {
-    return kernelAddress_;
+    return kernelAddress_.load(std::memory_order_acquire);
   }
 
   void setKernelAddress(void* kernelAddress) {
-    kernelAddress_ = kernelAddress;
+    kernelAddress_.store(kernelAddress, std::memory_order_release);
+  }
+
+  const std::string& getKernelFuncName() const {
+    return kernelFuncName_;
   }
 
  private:
   std::unique_ptr<llvm::orc::PytorchLLVMJIT> jit_;
-  void* kernelAddress_;
+  // Null until the kernel is materialized; see
+  // LLVMCodeGen::getKernelAddress.
+  std::atomic<void*> kernelAddress_;
+  std::string kernelFuncName_;
 };
 
 class LLVMCodeGenImpl : public IRVisitor {
@@ -361,7 +373,9 @@ LLVMCodeGen::LLVMCodeGen(
       cpu,
       attrs);
   callee_ = std::make_unique<LLVMCodeGenCallee>(
-      impl_->releaseJIT(), (void*)impl_->getKernelAddress());
+      impl_->releaseJIT(),
+      (void*)impl_->getKernelAddress(),
+      this->kernel_func_name());
 }
 
 void LLVMCodeGen::cleanup_memory() {
@@ -405,7 +419,16 @@ at::Tensor LLVMCodeGen::empty_strided(
 }
 
 void* LLVMCodeGen::getKernelAddress(LLVMCodeGenCallee* callee) {
-  return (void*)callee->getKernelAddress();
+  void* addr = callee->getKernelAddress();
+  if (C10_UNLIKELY(!addr)) {
+    // First call into this kernel: block until ORC has materialized it
+    // (either compiling it now or waiting on a background compile kicked
+    // off by warmup; see [Note: shared NNC LLJIT] in llvm_jit.cpp).
+    auto sym = callee->getJIT()->findSymbol(callee->getKernelFuncName());
+    addr = (void*)assertSuccess(sym.getAddress());
+    callee->setKernelAddress(addr);
+  }
+  return addr;
 }
 
 std::string LLVMCodeGen::getCodeText(const std::string& attr /*=""*/) {
@@ -511,9 +534,16 @@ LLVMCodeGenImpl::LLVMCodeGenImpl(
   emitKernel(stmt, params);
 
   jit_->addModule(std::move(module_), std::move(context_));
+  kernelAddress_ = 0;
   if (!LLVMAOTWorkflow()) {
-    auto sym = jit_->findSymbol(kernel_func_name_);
-    kernelAddress_ = assertSuccess(sym.getAddress());
+    if (std::getenv("PYTORCH_TENSOREXPR_EAGER_COMPILE")) {
+      // Old behavior: pay for native codegen here rather than on the first
+      // call into the kernel.
+      auto sym = jit_->findSymbol(kernel_func_name_);
+      kernelAddress_ = assertSuccess(sym.getAddress());
+    } else {
+      jit_->warmup(kernel_func_name_);
+    }
   }
 }
 
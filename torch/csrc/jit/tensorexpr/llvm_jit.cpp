@@ -4,8 +4,10 @@
 #include <torch/csrc/jit/tensorexpr/intrinsic_symbols.h>
 #include <torch/csrc/jit/tensorexpr/llvm_jit.h>
 
+#include <llvm/ADT/SmallString.h>
 #include <llvm/ExecutionEngine/ExecutionEngine.h>
 #include <llvm/ExecutionEngine/JITSymbol.h>
+#include <llvm/ExecutionEngine/ObjectCache.h>
 #include <llvm/ExecutionEngine/Orc/CompileUtils.h>
 #include <llvm/ExecutionEngine/Orc/ExecutionUtils.h>
 #include <llvm/ExecutionEngine/Orc/IRCompileLayer.h>
@@ -23,17 +25,25 @@
 #include <llvm/IR/Mangler.h>
 #include <llvm/Support/CFGUpdate.h>
 #include <llvm/Support/DynamicLibrary.h>
+#include <llvm/Support/FileSystem.h>
 #include <llvm/Support/Host.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/Path.h>
 #include <llvm/Support/raw_ostream.h>
 #include <llvm/Target/TargetMachine.h>
 
 #include <torch/csrc/jit/tensorexpr/external_functions_registry.h>
 
 #include <c10/util/Half.h>
+#include <c10/util/hash.h>
 
 #include <algorithm>
+#include <atomic>
+#include <cstdlib>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -132,15 +142,288 @@ static void registerIntrinsics(
 namespace llvm {
 namespace orc {
 
+#if LLVM_VERSION_MAJOR >= 11
+// [Note: NNC kernel object cache]
+// When PYTORCH_TENSOREXPR_KERNEL_CACHE_DIR names an existing directory,
+// compiled kernel objects are persisted there and reloaded in later
+// processes, so a warmed cache directory skips LLVM optimization and
+// codegen entirely.  The cache key is a SHA1 over the kernel's LLVM IR
+// together with the target triple, CPU and feature string, so any change
+// to lowering, to the toolchain, or to the machine the cache is shared
+// with produces a miss rather than a stale hit.  Entries are written to a
+// unique temporary file and renamed into place, so concurrent processes
+// sharing a directory at worst duplicate a compile.  Failures to read or
+// write the cache are silently treated as misses; the JIT path is always
+// available as a fallback.
+class PytorchObjectCache : public llvm::ObjectCache {
+ public:
+  PytorchObjectCache(std::string dir, std::string targetDesc)
+      : dir_(std::move(dir)), targetDesc_(std::move(targetDesc)) {}
+
+  void notifyObjectCompiled(const Module* M, MemoryBufferRef Obj) override {
+    std::string path = cachePath(M);
+    int fd = -1;
+    SmallString<128> tmpPath;
+    if (llvm::sys::fs::createUniqueFile(path + ".tmp.%%%%%%", fd, tmpPath)) {
+      return;
+    }
+    {
+      raw_fd_ostream os(fd, /*shouldClose=*/true);
+      os << Obj.getBuffer();
+    }
+    if (llvm::sys::fs::rename(tmpPath, path)) {
+      llvm::sys::fs::remove(tmpPath);
+    }
+  }
+
+  std::unique_ptr<MemoryBuffer> getObject(const Module* M) override {
+    auto buf = MemoryBuffer::getFile(cachePath(M));
+    if (!buf) {
+      return nullptr;
+    }
+    return std::move(*buf);
+  }
+
+ private:
+  std::string cachePath(const Module* M) const {
+    std::string key;
+    raw_string_ostream keyStream(key);
+    M->print(keyStream, nullptr);
+    keyStream << targetDesc_;
+    c10::sha1 keyHash{keyStream.str()};
+    SmallString<128> path(dir_);
+    llvm::sys::path::append(path, "nnc_" + keyHash.str() + ".o");
+    return std::string(path.str());
+  }
+
+  std::string dir_;
+  std::string targetDesc_;
+};
+
+static std::unique_ptr<PytorchObjectCache> makeKernelObjectCache(
+    const TargetMachine& TM) {
+  const char* dir = std::getenv("PYTORCH_TENSOREXPR_KERNEL_CACHE_DIR");
+  if (!dir || !llvm::sys::fs::is_directory(dir)) {
+    return nullptr;
+  }
+  std::string targetDesc = TM.getTargetTriple().str() + ";" +
+      TM.getTargetCPU().str() + ";" + TM.getTargetFeatureString().str();
+  return std::make_unique<PytorchObjectCache>(dir, std::move(targetDesc));
+}
+#endif // LLVM_VERSION_MAJOR >= 11
+
 // Lightly modified implementation from LLVM's Kaleidoscope JIT tutorial:
 // https://llvm.org/docs/tutorial/BuildingAJIT1.html
-#if LLVM_VERSION_MAJOR >= 9
+#if LLVM_VERSION_MAJOR >= 11
+
+static Expected<std::unique_ptr<LLJIT>> makeLLJIT(
+    const c10::optional<std::string>& triple,
+    const c10::optional<std::string>& cpu,
+    const c10::optional<std::string>& attrs,
+    llvm::ObjectCache* objectCache,
+    unsigned compileThreads) {
+  LLJITBuilder builder;
+  builder.setJITTargetMachineBuilder(
+      makeTargetMachineBuilder(triple, cpu, attrs));
+  builder.setNumCompileThreads(compileThreads);
+  if (objectCache) {
+    // See [Note: NNC kernel object cache].  ConcurrentIRCompiler consults
+    // the cache before compiling and hands it every freshly built object.
+    builder.setCompileFunctionCreator(
+        [objectCache](JITTargetMachineBuilder JTMB)
+            -> Expected<std::unique_ptr<IRCompileLayer::IRCompiler>> {
+          return std::make_unique<ConcurrentIRCompiler>(
+              std::move(JTMB), objectCache);
+        });
+  }
+  return builder.create();
+}
+
+// Number of dedicated compilation threads for the shared LLJIT, taken from
+// PYTORCH_TENSOREXPR_COMPILE_THREADS.  Zero (the default) compiles on the
+// thread that first asks for the kernel.
+static unsigned numCompileThreads() {
+  static unsigned n = []() -> unsigned {
+    const char* v = std::getenv("PYTORCH_TENSOREXPR_COMPILE_THREADS");
+    if (!v) {
+      return 0;
+    }
+    int parsed = std::atoi(v);
+    return parsed > 0 ? static_cast<unsigned>(parsed) : 0;
+  }();
+  return n;
+}
+
+// [Note: shared NNC LLJIT]
+// Every fusion group used to build a private LLJIT: its own execution
+// session, linking layer and copy of the intrinsic symbol table.  Deploys
+// that compile a few hundred fusion groups before first traffic paid that
+// setup cost a few hundred times over.  Kernels targeting the same
+// (triple, cpu, attrs) now share a single LLJIT.  Each kernel is added to
+// its own JITDylib -- so kernel symbol names can never collide -- and that
+// dylib links against the shared main dylib, which holds the vector math
+// intrinsics, the registered NNC external functions and the process symbol
+// generator exactly once.
+//
+// The shared instance can also be given a compile-thread pool via
+// PYTORCH_TENSOREXPR_COMPILE_THREADS.  Together with the deferred symbol
+// resolution in LLVMCodeGen (kernels are materialized on first call, and
+// warmup() only queues a materialization request) this moves native
+// codegen off the deploy path: modules are handed to ORC up front and
+// compiled in the background while the process keeps loading.
+struct SharedLLJIT {
+  std::unique_ptr<PytorchObjectCache> objectCache;
+  std::unique_ptr<LLJIT> LLJ;
+  std::unordered_set<std::string> intrinsics;
+  std::atomic<uint64_t> nextDylibId{0};
+};
+
+static SharedLLJIT& getSharedLLJIT(
+    const c10::optional<std::string>& triple,
+    const c10::optional<std::string>& cpu,
+    const c10::optional<std::string>& attrs) {
+  // Leaked: the JIT (and the code it owns) must outlive any kernel still
+  // resident at shutdown.
+  static auto* instances =
+      new std::unordered_map<std::string, std::unique_ptr<SharedLLJIT>>();
+  static std::mutex mutex;
+
+  std::string key = triple.value_or("") + '\0' + cpu.value_or("") + '\0' +
+      attrs.value_or("");
+  std::lock_guard<std::mutex> lock(mutex);
+  auto it = instances->find(key);
+  if (it != instances->end()) {
+    return *it->second;
+  }
+
+  auto shared = std::make_unique<SharedLLJIT>();
+  {
+    // The object cache key needs the resolved target description, which is
+    // only available from a TargetMachine.
+    auto TM = assertSuccess(
+        makeTargetMachineBuilder(triple, cpu, attrs).createTargetMachine());
+    shared->objectCache = makeKernelObjectCache(*TM);
+  }
+  shared->LLJ = assertSuccess(makeLLJIT(
+      triple, cpu, attrs, shared->objectCache.get(), numCompileThreads()));
+
+  auto& JD = shared->LLJ->getMainJITDylib();
+  JD.addGenerator(
+      assertSuccess(DynamicLibrarySearchGenerator::GetForCurrentProcess(
+          shared->LLJ->getDataLayout().getGlobalPrefix())));
+  MangleAndInterner Mangle(
+      shared->LLJ->getExecutionSession(), shared->LLJ->getDataLayout());
+  registerIntrinsics(JD, Mangle, shared->intrinsics);
+
+  it = instances->emplace(std::move(key), std::move(shared)).first;
+  return *it->second;
+}
+
+class TORCH_API PytorchLLVMJITImpl {
+ private:
+  std::unique_ptr<TargetMachine> TM;
+  SharedLLJIT& shared_;
+  JITDylib* JD_;
+
+ public:
+  PytorchLLVMJITImpl(
+      c10::optional<std::string> triple,
+      c10::optional<std::string> cpu,
+      c10::optional<std::string> attrs)
+      : TM(assertSuccess(makeTargetMachineBuilder(triple, cpu, attrs)
+                             .createTargetMachine())),
+        shared_(getSharedLLJIT(triple, cpu, attrs)) {
+    std::string name =
+        "nnc_kernel_" + std::to_string(shared_.nextDylibId++);
+    JD_ = &assertSuccess(shared_.LLJ->createJITDylib(std::move(name)));
+    // Intrinsics and external functions are defined with
+    // JITSymbolFlags::None, so the link order entry must match
+    // non-exported symbols too.
+    JD_->addToLinkOrder(
+        shared_.LLJ->getMainJITDylib(),
+        JITDylibLookupFlags::MatchAllSymbols);
+  }
+
+  ~PytorchLLVMJITImpl() {
+#if LLVM_VERSION_MAJOR >= 13
+    // Release this kernel's code.  Earlier LLVMs have no dylib removal;
+    // there the (small) kernel object stays resident in the shared JIT.
+    consumeError(
+        shared_.LLJ->getExecutionSession().removeJITDylib(*JD_));
+#endif
+  }
+
+  void addModule(std::unique_ptr<Module> M, std::unique_ptr<LLVMContext> C) {
+    assertSuccess(
+        shared_.LLJ->addIRModule(
+            *JD_, ThreadSafeModule(std::move(M), std::move(C))),
+        "Failed to add module to compile layer");
+  }
+
+  void warmup(const std::string& Name) {
+    // Without compile threads a background materialization request would
+    // just move the stall to another lookup; let the first call compile.
+    if (numCompileThreads() == 0) {
+      return;
+    }
+    auto& ES = shared_.LLJ->getExecutionSession();
+    MangleAndInterner Mangle(ES, shared_.LLJ->getDataLayout());
+    ES.lookup(
+        LookupKind::Static,
+        makeJITDylibSearchOrder(
+            {JD_}, JITDylibLookupFlags::MatchAllSymbols),
+        SymbolLookupSet(Mangle(Name)),
+        SymbolState::Ready,
+        [](Expected<SymbolMap> R) {
+          // Failures resurface on the blocking lookup at first call.
+          consumeError(R.takeError());
+        },
+        NoDependenciesToRegister);
+  }
+
+  JITSymbol findSymbol(const std::string Name) {
+#if LLVM_VERSION_MAJOR >= 15
+    // Starting with llvm-15, LLJIT::lookup returns an address rather than a
+    // symbol. Even though an address is what we ultimately we want, we also
+    // want to avoid churning our internal APIs, so we wrap the returned address
+    // in a fake JITSymbol.
+    auto result = assertSuccess(shared_.LLJ->lookup(*JD_, Name));
+    return JITSymbol(result.getValue(), JITSymbolFlags());
+#else
+    return assertSuccess(shared_.LLJ->lookup(*JD_, Name));
+#endif
+  }
+
+  bool hasSymbol(const std::string& Name) {
+    return shared_.intrinsics.find(Name) != shared_.intrinsics.end();
+  }
+
+  TargetMachine& getTargetMachine() {
+    return *TM;
+  }
+
+  const DataLayout& getDataLayout() {
+    return shared_.LLJ->getDataLayout();
+  }
+};
+
+#elif LLVM_VERSION_MAJOR >= 9
 class TORCH_API PytorchLLVMJITImpl {
  private:
   std::unique_ptr<TargetMachine> TM;
   std::unique_ptr<LLJIT> LLJ;
   std::unordered_set<std::string> intrinsics;
 
+  static Expected<std::unique_ptr<LLJIT>> makeLLJIT(
+      const c10::optional<std::string>& triple,
+      const c10::optional<std::string>& cpu,
+      const c10::optional<std::string>& attrs) {
+    LLJITBuilder builder;
+    builder.setJITTargetMachineBuilder(
+        makeTargetMachineBuilder(triple, cpu, attrs));
+    return builder.create();
+  }
+
  public:
   PytorchLLVMJITImpl(
       c10::optional<std::string> triple,
@@ -148,10 +431,7 @@ class TORCH_API PytorchLLVMJITImpl {
       c10::optional<std::string> attrs)
       : TM(assertSuccess(makeTargetMachineBuilder(triple, cpu, attrs)
                              .createTargetMachine())),
-        LLJ(assertSuccess(LLJITBuilder()
-                              .setJITTargetMachineBuilder(
-                                  makeTargetMachineBuilder(triple, cpu, attrs))
-                              .create())) {
+        LLJ(assertSuccess(makeLLJIT(triple, cpu, attrs))) {
     auto ProcSymbolsGenerator =
         assertSuccess(DynamicLibrarySearchGenerator::GetForCurrentProcess(
             LLJ->getDataLayout().getGlobalPrefix()));
@@ -175,17 +455,14 @@ class TORCH_API PytorchLLVMJITImpl {
         "Failed to add module to compile layer");
   }
 
+  void warmup(const std::string& Name) {
+    // No shared compile threads on this LLVM version; the first call
+    // materializes the kernel.
+    (void)Name;
+  }
+
   JITSymbol findSymbol(const std::string Name) {
-#if LLVM_VERSION_MAJOR >= 15
-    // Starting with llvm-15, LLJIT::lookup returns an address rather than a
-    // symbol. Even though an address is what we ultimately we want, we also
-    // want to avoid churning our internal APIs, so we wrap the returned address
-    // in a fake JITSymbol.
-    auto result = assertSuccess(LLJ->lookup(Name));
-    return JITSymbol(result.getValue(), JITSymbolFlags());
-#else
     return assertSuccess(LLJ->lookup(Name));
-#endif
   }
 
   bool hasSymbol(const std::string& Name) {
@@ -276,6 +553,11 @@ class TORCH_API PytorchLLVMJITImpl {
     return intrinsics.find(Name) != intrinsics.end();
   }
 
+  void warmup(const std::string& Name) {
+    // Legacy ORC layers compile at addModule time; nothing to defer.
+    (void)Name;
+  }
+
   JITTargetAddress getSymbolAddress(const std::string Name) {
     return assertSuccess(findSymbol(Name).getAddress());
   }
@@ -311,6 +593,10 @@ JITSymbol PytorchLLVMJIT::findSymbol(const std::string Name) {
   return impl_->findSymbol(std::move(Name));
 }
 
+void PytorchLLVMJIT::warmup(const std::string& Name) {
+  impl_->warmup(Name);
+}
+
 bool PytorchLLVMJIT::hasSymbol(const std::string& Name) {
   return impl_->hasSymbol(Name);
 }
@@ -54,6 +54,11 @@ class TORCH_API PytorchLLVMJIT {
 
   void addModule(std::unique_ptr<Module> M, std::unique_ptr<LLVMContext> C);
 
+  // Ask the JIT to materialize Name in the background.  A no-op unless the
+  // shared LLJIT was built with compile threads; see [Note: shared NNC
+  // LLJIT] in llvm_jit.cpp.
+  void warmup(const std::string& Name);
+
   JITSymbol findSymbol(const std::string Name);
 
   bool hasSymbol(const std::string& Name);
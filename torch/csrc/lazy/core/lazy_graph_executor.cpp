@@ -715,7 +715,8 @@ std::vector<BackendDataPtr> LazyGraphExecutor::FetchTensorData(
 
 LazyGraphExecutor::PostOrderData LazyGraphExecutor::RunPostOrder(
     const std::vector<LazyTensorPtr>& tensors,
-    SyncTensorCollection* coll) {
+    SyncTensorCollection* coll,
+    size_t expected_nodes) {
   std::vector<Node*> roots;
   roots.reserve(coll->indices.size());
   for (auto index : coll->indices) {
@@ -723,6 +724,12 @@ LazyGraphExecutor::PostOrderData LazyGraphExecutor::RunPostOrder(
     roots.push_back(ir_value.node.get());
   }
   PostOrderData po_data;
+  if (expected_nodes > 0) {
+    // A trace shortcut remembered how many nodes this trace emitted the
+    // last time around, so the DFS structures can be sized up front. See
+    // Note [Trace shortcut].
+    po_data.emission_map.reserve(expected_nodes);
+  }
   po_data.post_order = Util::ComputePostOrder(roots, &po_data.emission_map);
   std::unordered_map<BackendData::Handle, size_t> data_handles;
   for (auto node : po_data.post_order) {
@@ -856,6 +863,42 @@ LazyGraphExecutor::ComputationCache::TypePtr LazyGraphExecutor::
   return cached_computation;
 }
 
+// Note [Trace shortcut]
+//
+// A steady-state training loop re-traces an identical graph every step.
+// The pre-parameter hash computed by CollectSyncTensors (device, config
+// and per-root IR hashes) therefore repeats, and the compiled computation
+// is already in the computation cache. The parameter *handles* are not
+// reusable across steps though: each step uploads fresh device data
+// behind structurally identical DeviceData nodes, and those handles only
+// fall out of the post-order walk. So the walk still runs every step;
+// what repeats is everything derived from the trace structure alone.
+//
+// The shortcut memoizes, per trace hash, the final (post-parameter-
+// sequence) hash and the graph sizes observed the last time that trace
+// was synced. A repeated step can then size the DFS structures up front,
+// skip the debug graph dump and the parameter sequence re-hash, and go
+// straight to the cached computation with the freshly collected handles.
+// If the computation cache has since evicted the entry, we restore the
+// trace hash and take the full path, which re-records the shortcut.
+
+c10::optional<LazyGraphExecutor::TraceShortcut> LazyGraphExecutor::
+    LookupTraceShortcut(const hash_t& trace_hash) {
+  std::lock_guard<std::mutex> lock(trace_shortcuts_mutex_);
+  auto it = trace_shortcuts_.find(trace_hash);
+  if (it == trace_shortcuts_.end()) {
+    return c10::nullopt;
+  }
+  return it->second;
+}
+
+void LazyGraphExecutor::AddTraceShortcut(
+    const hash_t& trace_hash,
+    TraceShortcut shortcut) {
+  std::lock_guard<std::mutex> lock(trace_shortcuts_mutex_);
+  trace_shortcuts_[trace_hash] = shortcut;
+}
+
 #if defined(_MSC_VER)
 #include <BaseTsd.h>
 typedef SSIZE_T ssize_t;
@@ -907,13 +950,35 @@ std::shared_ptr<LazyGraphExecutor::Async> LazyGraphExecutor::
     TensorCollectionBarrier(&coll);
     return nullptr;
   }
-  PostOrderData po_data = RunPostOrder(*tensors, &coll);
+  const hash_t trace_hash = coll.hash;
+  c10::optional<TraceShortcut> shortcut = LookupTraceShortcut(trace_hash);
+  PostOrderData po_data = RunPostOrder(
+      *tensors, &coll, shortcut ? shortcut->post_order_size : 0);
+  const size_t post_order_size = po_data.post_order.size();
+  const size_t parameters_size = po_data.parameters_data.size();
+  if (shortcut && shortcut->post_order_size == post_order_size &&
+      shortcut->parameters_size == parameters_size) {
+    // See Note [Trace shortcut]. The remembered final hash stands in for
+    // the parameter sequence re-hash; the freshly walked parameters_data
+    // carries this step's handles.
+    coll.hash = shortcut->final_hash;
+    std::shared_ptr<Async> async = TryRunCachedSync(tensors, &coll, &po_data);
+    if (async != nullptr) {
+      TORCH_LAZY_COUNTER("TraceShortcutHit", 1);
+      return async;
+    }
+    // The computation cache evicted this trace; fall through to the full
+    // path, which will re-record the shortcut.
+    coll.hash = trace_hash;
+  }
   DebugUtil::SaveTensorsGraphInfo(
       "ScheduleSyncTensorsGraph", *tensors, &coll.indices);
   coll.hash = HashCombine(coll.hash, Hash(po_data.parameter_sequence));
   VLOG(4) << "Parameter sequence graph hash " << HashToString(coll.hash);
   std::shared_ptr<Async> async = TryRunCachedSync(tensors, &coll, &po_data);
   if (async != nullptr) {
+    AddTraceShortcut(
+        trace_hash, TraceShortcut{coll.hash, post_order_size, parameters_size});
     return async;
   }
 
@@ -931,6 +996,8 @@ std::shared_ptr<LazyGraphExecutor::Async> LazyGraphExecutor::
   auto cached_computation = std::make_shared<CachedComputation>(
       std::move(compile_result.computation));
   GetComputationCache()->Add(coll.hash, cached_computation);
+  AddTraceShortcut(
+      trace_hash, TraceShortcut{coll.hash, post_order_size, parameters_size});
 
   return ScheduleSyncTensorsGraph(
       tensors,
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <c10/util/ArrayRef.h>
+#include <c10/util/Optional.h>
 #include <torch/csrc/lazy/backend/lowering_context.h>
 #include <torch/csrc/lazy/core/cache.h>
 #include <torch/csrc/lazy/core/ir_util.h>
@@ -8,6 +9,9 @@
 #include <torch/csrc/lazy/core/tensor.h>
 #include <torch/csrc/lazy/core/util.h>
 
+#include <mutex>
+#include <unordered_map>
+
 namespace torch {
 namespace lazy {
 
@@ -154,6 +158,16 @@ class TORCH_API LazyGraphExecutor {
     std::vector<size_t> parameter_sequence;
   };
 
+  // Remembers, per pre-parameter trace hash, the final computation hash
+  // and graph sizes observed when that trace was last synced, so
+  // steady-state steps can skip re-deriving them. See
+  // Note [Trace shortcut] in lazy_graph_executor.cpp.
+  struct TraceShortcut {
+    hash_t final_hash = hash_t(0);
+    size_t post_order_size = 0;
+    size_t parameters_size = 0;
+  };
+
   struct CompilationResult {
     BackendDevice device;
     size_t emitted_nodes = 0;
@@ -197,7 +211,8 @@ class TORCH_API LazyGraphExecutor {
 
   PostOrderData RunPostOrder(
       const std::vector<LazyTensorPtr>& tensors,
-      SyncTensorCollection* coll);
+      SyncTensorCollection* coll,
+      size_t expected_nodes = 0);
   std::shared_ptr<Async> TryRunCachedSync(
       std::vector<LazyTensorPtr>* tensors,
       SyncTensorCollection* coll,
@@ -211,6 +226,9 @@ class TORCH_API LazyGraphExecutor {
 
   ComputationCache::TypePtr LookupCachedCompile(const hash_t& hash);
 
+  c10::optional<TraceShortcut> LookupTraceShortcut(const hash_t& trace_hash);
+  void AddTraceShortcut(const hash_t& trace_hash, TraceShortcut shortcut);
+
   void BuildInputOutputAliases(
       const std::vector<LazyTensorPtr>& tensors,
       c10::ArrayRef<size_t> indices,
@@ -251,6 +269,10 @@ class TORCH_API LazyGraphExecutor {
       c10::ArrayRef<BackendDataPtr> tensors_data);
 
   bool noop_execution_mode_ = false;
+
+  // Guards trace_shortcuts_; syncs can be issued from multiple threads.
+  std::mutex trace_shortcuts_mutex_;
+  std::unordered_map<hash_t, TraceShortcut, HashReducer> trace_shortcuts_;
 };
 
 } // namespace lazy
@@ -41,12 +41,19 @@ enum class C10_API_ENUM ActiveProfilerType {
 struct TORCH_API ExperimentalConfig {
   explicit ExperimentalConfig(
       std::vector<std::string> profiler_metrics = {},
-      bool profiler_measure_per_kernel = false)
+      bool profiler_measure_per_kernel = false,
+      std::vector<std::string> performance_events = {})
       : profiler_metrics(std::move(profiler_metrics)),
-        profiler_measure_per_kernel(profiler_measure_per_kernel) {}
+        profiler_measure_per_kernel(profiler_measure_per_kernel),
+        performance_events(std::move(performance_events)) {}
   ~ExperimentalConfig() = default;
   std::vector<std::string> profiler_metrics;
   bool profiler_measure_per_kernel = false;
+  /*
+   * Hardware counters (e.g. cycles, instructions, cache-misses) measured per
+   * op via Linux perf_event and attached to the corresponding trace events.
+   */
+  std::vector<std::string> performance_events;
 
   bool hasOptions() const {
     return profiler_metrics.size() > 0;
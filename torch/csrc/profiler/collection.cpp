@@ -310,6 +310,10 @@ ThreadLocalSubqueue::ThreadLocalSubqueue(
     const ProfilerConfig& config)
     : tid_{tid}, config_{config}, kineto_info_{kineto::kineto_ids()} {
   torch::profiler::impl::kineto::recordThreadInfo();
+  if (!config_.experimental_config.performance_events.empty()) {
+    perf_profiler_ = std::make_unique<linux_perf::PerfProfiler>();
+    perf_profiler_->Configure(config_.experimental_config.performance_events);
+  }
 }
 
 std::unique_ptr<KinetoObserverContext> ThreadLocalSubqueue::begin_op(
@@ -362,6 +366,11 @@ std::unique_ptr<KinetoObserverContext> ThreadLocalSubqueue::begin_op(
 
   event->start_time_ = torch::profiler::impl::getApproximateTime();
   event->allow_tf32_cublas_ = at::globalContext().allowTF32CuBLAS();
+  if (perf_profiler_) {
+    event->counters_ = std::make_unique<perf_counters_t>(
+        config_.experimental_config.performance_events.size(), 0);
+    perf_profiler_->Enable();
+  }
   return out;
 }
 
@@ -617,7 +626,8 @@ std::vector<std::shared_ptr<Result>> RecordQueue::getRecords(
               steal_or_default(jit_module_it),
               steal_or_default(extra_args_it),
               steal_or_default(gpu_fallback_it),
-              i.allow_tf32_cublas_)));
+              i.allow_tf32_cublas_,
+              std::move(i.counters_))));
     }
     queue.op_events_.clear();
     queue.inputs_outputs_.clear();
@@ -0,0 +1,186 @@
+#include <torch/csrc/profiler/perf.h>
+
+#include <c10/util/Exception.h>
+#include <c10/util/irange.h>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+namespace torch {
+namespace profiler {
+namespace impl {
+namespace linux_perf {
+
+#if defined(__linux__)
+
+namespace {
+
+struct PerfEventSpec {
+  const char* name;
+  uint32_t type;
+  uint64_t config;
+};
+
+// The portable PERF_TYPE_HARDWARE subset; enough to tell memory-bound ops
+// (high cache-miss rate) from compute-bound ones (high IPC).
+constexpr PerfEventSpec kSupportedEvents[] = {
+    {"cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {"instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {"cache-references", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_REFERENCES},
+    {"cache-misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {"branch-misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+};
+
+} // namespace
+
+void PerfEvent::Init() {
+  const PerfEventSpec* spec = nullptr;
+  for (const auto& candidate : kSupportedEvents) {
+    if (name_ == candidate.name) {
+      spec = &candidate;
+      break;
+    }
+  }
+  TORCH_CHECK(spec != nullptr, "Unsupported performance event: ", name_);
+
+  perf_event_attr attr;
+  std::memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(perf_event_attr);
+  attr.type = spec->type;
+  attr.config = spec->config;
+  attr.disabled = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+
+  fd_ = static_cast<int>(syscall(
+      __NR_perf_event_open,
+      &attr,
+      /*pid=*/0, // calling thread only
+      /*cpu=*/-1, // on any CPU
+      /*group_fd=*/-1,
+      /*flags=*/0));
+  TORCH_CHECK(
+      fd_ >= 0,
+      "perf_event_open failed for '",
+      name_,
+      "': ",
+      std::strerror(errno),
+      " (check /proc/sys/kernel/perf_event_paranoid)");
+}
+
+uint64_t PerfEvent::ReadCounter() const {
+  uint64_t value = 0;
+  auto n = read(fd_, &value, sizeof(value));
+  TORCH_CHECK(
+      n == static_cast<ssize_t>(sizeof(value)),
+      "Failed to read performance counter '",
+      name_,
+      "'");
+  return value;
+}
+
+void PerfEvent::Enable() {
+  ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+}
+
+void PerfEvent::Disable() {
+  ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+}
+
+void PerfEvent::Reset() {
+  ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+}
+
+PerfEvent::~PerfEvent() {
+  if (fd_ >= 0) {
+    close(fd_);
+    fd_ = -1;
+  }
+}
+
+#else // !defined(__linux__)
+
+void PerfEvent::Init() {
+  TORCH_CHECK(false, "Performance events are only supported on Linux");
+}
+
+uint64_t PerfEvent::ReadCounter() const {
+  return 0;
+}
+
+void PerfEvent::Enable() {}
+
+void PerfEvent::Disable() {}
+
+void PerfEvent::Reset() {}
+
+PerfEvent::~PerfEvent() {}
+
+#endif // defined(__linux__)
+
+void PerfProfiler::Configure(const std::vector<std::string>& event_names) {
+  TORCH_CHECK(
+      event_names.size() <= kMaxEvents,
+      "At most ",
+      kMaxEvents,
+      " performance events can be counted at once");
+  TORCH_CHECK(events_.empty(), "PerfProfiler is already configured");
+  for (const auto& name : event_names) {
+    events_.emplace_back(name);
+    events_.back().Init();
+  }
+}
+
+void PerfProfiler::StartCounting() {
+  for (auto& event : events_) {
+    event.Reset();
+    event.Enable();
+  }
+}
+
+void PerfProfiler::StopCounting() {
+  for (auto& event : events_) {
+    event.Disable();
+  }
+}
+
+void PerfProfiler::Enable() {
+  // Counters run continuously across nested scopes; each scope only records
+  // its starting values so that Disable() can report a delta.
+  if (start_values_.empty()) {
+    StartCounting();
+  }
+  start_values_.emplace(events_.size(), 0);
+  auto& snapshot = start_values_.top();
+  for (const auto i : c10::irange(events_.size())) {
+    snapshot[i] = events_[i].ReadCounter();
+  }
+}
+
+void PerfProfiler::Disable(perf_counters_t& counters) {
+  TORCH_INTERNAL_ASSERT(
+      !start_values_.empty(),
+      "PerfProfiler::Disable called without a matching Enable");
+  TORCH_INTERNAL_ASSERT(
+      counters.size() == events_.size(),
+      "Size of counter buffer does not match the number of events");
+  const auto& start = start_values_.top();
+  for (const auto i : c10::irange(events_.size())) {
+    counters[i] = events_[i].ReadCounter() - start[i];
+  }
+  start_values_.pop();
+  if (start_values_.empty()) {
+    StopCounting();
+  }
+}
+
+} // namespace linux_perf
+} // namespace impl
+} // namespace profiler
+} // namespace torch
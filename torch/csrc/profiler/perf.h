@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include <stack>
+#include <string>
+#include <vector>
+
+#include <c10/macros/Macros.h>
+
+namespace torch {
+namespace profiler {
+namespace impl {
+
+// Raw counter deltas for one op scope, in the order the event names were
+// passed to PerfProfiler::Configure().
+using perf_counters_t = std::vector<uint64_t>;
+
+namespace linux_perf {
+
+// Keeping the groups small avoids counter multiplexing on common hardware,
+// which would make per-op deltas an estimate rather than a count.
+constexpr size_t kMaxEvents = 4;
+
+/*
+ * A single hardware counter, read through a perf_event file descriptor
+ * opened for the calling thread.  On non-Linux platforms this is a stub
+ * whose Init() always throws.
+ */
+class PerfEvent {
+ public:
+  explicit PerfEvent(std::string name) : name_(std::move(name)) {}
+  PerfEvent(const PerfEvent&) = delete;
+  PerfEvent& operator=(const PerfEvent&) = delete;
+  PerfEvent(PerfEvent&& other) noexcept
+      : name_(std::move(other.name_)), fd_(other.fd_) {
+    other.fd_ = -1;
+  }
+  PerfEvent& operator=(PerfEvent&& other) noexcept {
+    if (this != &other) {
+      name_ = std::move(other.name_);
+      fd_ = other.fd_;
+      other.fd_ = -1;
+    }
+    return *this;
+  }
+  ~PerfEvent();
+
+  // Resolves the event name and opens the counter for the calling thread.
+  // Throws if the name is not supported or the kernel refuses the event.
+  void Init();
+
+  // Current value of the counter.
+  uint64_t ReadCounter() const;
+
+  void Enable();
+  void Disable();
+  void Reset();
+
+ private:
+  std::string name_;
+  int fd_ = -1;
+};
+
+/*
+ * Drives a small group of PerfEvents with nestable Enable()/Disable()
+ * scopes: Enable() snapshots the current counter values, Disable() writes
+ * out the deltas since the matching Enable().  Nested scopes therefore
+ * include the counts of their children, mirroring how op durations nest.
+ */
+class PerfProfiler {
+ public:
+  // Opens one counter per event name for this thread.
+  void Configure(const std::vector<std::string>& event_names);
+
+  void Enable();
+  void Disable(perf_counters_t& counters);
+
+ private:
+  void StartCounting();
+  void StopCounting();
+
+  std::vector<PerfEvent> events_;
+  std::stack<perf_counters_t> start_values_;
+};
+
+} // namespace linux_perf
+} // namespace impl
+} // namespace profiler
+} // namespace torch
@@ -0,0 +1,260 @@
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+
+#include <processthreadsapi.h>
+#else
+#include <unistd.h>
+#endif // _WIN32
+
+#include <fmt/format.h>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <vector>
+
+#include <ATen/record_function.h>
+#include <c10/util/Exception.h>
+#include <c10/util/Logging.h>
+#include <torch/csrc/profiler/sampling_observer.h>
+#include <torch/csrc/profiler/util.h>
+
+using namespace at;
+
+namespace torch {
+namespace profiler {
+namespace impl {
+namespace {
+
+inline int32_t processId() {
+#ifndef _WIN32
+  return static_cast<int32_t>(getpid());
+#else
+  return static_cast<int32_t>(GetCurrentProcessId());
+#endif
+}
+
+static CallbackHandle handle_{INVALID_CALLBACK_HANDLE};
+
+// Op names are copied into a fixed-size field so that recording a span never
+// allocates and never keeps a pointer into memory the op owns.
+constexpr size_t kEventNameLength = 64;
+
+struct RingEvent {
+  char name[kEventNameLength];
+  int64_t start_time_ns;
+  int64_t end_time_ns;
+  uint64_t tid;
+};
+
+// SamplingObserver holds the flight-recorder state. The ring is allocated
+// once in `addSamplingObserver` and slots are claimed with an atomic
+// increment, so the op callbacks are lock-free; the mutex only serializes
+// request transitions and trace export. A writer that straddles a request
+// boundary (or a slot recycled by wraparound before its op finished) can
+// leave a torn span in an exported trace; for a flight recorder that is an
+// acceptable trade for not locking on the op hot path.
+struct SamplingObserver {
+  SamplingObserverConfig config;
+  int32_t pid{0};
+
+  // Preallocated span ring, reset at the start of each sampled request so an
+  // export contains exactly the slow request's (most recent) spans.
+  std::vector<RingEvent> ring;
+  std::atomic<size_t> cursor{0};
+
+  // Whether the current request is being captured. This is the only state
+  // the op callbacks read for unsampled requests.
+  std::atomic<bool> active{false};
+
+  std::atomic<uint64_t> request_count{0};
+  uint64_t request_index{0};
+  int64_t request_start_ns{0};
+
+  std::mutex mutex;
+};
+
+SamplingObserver& observer() {
+  static SamplingObserver ob;
+  return ob;
+}
+
+struct SamplingObserverContext : public ObserverContext {
+  RingEvent* event{nullptr};
+};
+
+std::unique_ptr<ObserverContext> onFunctionEnter(const RecordFunction& fn) {
+  auto& ob = observer();
+  if (!ob.active.load(std::memory_order_relaxed)) {
+    return nullptr;
+  }
+
+  const size_t slot =
+      ob.cursor.fetch_add(1, std::memory_order_relaxed) % ob.ring.size();
+  RingEvent& event = ob.ring[slot];
+  const char* name = fn.name();
+  const size_t len = std::min(std::strlen(name), kEventNameLength - 1);
+  std::memcpy(event.name, name, len);
+  event.name[len] = '\0';
+  event.start_time_ns = getTime();
+  event.end_time_ns = 0;
+  event.tid = fn.threadId();
+
+  auto ctx_ptr = std::make_unique<SamplingObserverContext>();
+  ctx_ptr->event = &event;
+  return ctx_ptr;
+}
+
+void onFunctionExit(const RecordFunction& fn, ObserverContext* ctx_ptr) {
+  auto ctx = dynamic_cast<SamplingObserverContext*>(ctx_ptr);
+  if (ctx == nullptr || ctx->event == nullptr) {
+    return;
+  }
+  // If the ring wrapped and recycled this slot in the meantime this stamps a
+  // foreign span; the export below discards spans with inconsistent times.
+  ctx->event->end_time_ns = getTime();
+}
+
+// Writes the captured spans as a Chrome trace so the files drop straight
+// into chrome://tracing or Perfetto. Called under `ob.mutex`.
+void exportRing(SamplingObserver& ob, int64_t latency_us) {
+  const auto file_name = fmt::format(
+      "{}/pytorch_sampled_trace_{}_{}.json",
+      ob.config.trace_dir,
+      ob.pid,
+      ob.request_index);
+  std::ofstream out(file_name, std::ofstream::out | std::ofstream::trunc);
+  if (!out) {
+    LOG(WARNING) << "Failed to open '" << file_name
+                 << "' for sampled trace export.";
+    return;
+  }
+
+  out << fmt::format(
+      "{{\n  \"requestIndex\": {},\n  \"requestLatencyUs\": {},\n"
+      "  \"traceEvents\": [",
+      ob.request_index,
+      latency_us);
+
+  // Replay the ring oldest-first. If it wrapped, the slots ahead of the
+  // cursor hold the oldest surviving spans.
+  const size_t total = ob.cursor.load(std::memory_order_relaxed);
+  const size_t count = std::min(total, ob.ring.size());
+  bool first = true;
+  for (size_t i = 0; i < count; ++i) {
+    const RingEvent& event = ob.ring[(total - count + i) % ob.ring.size()];
+    if (event.end_time_ns <= event.start_time_ns) {
+      // Unfinished at export time, or torn by wraparound.
+      continue;
+    }
+    out << fmt::format(
+        "{}\n    {{\"name\": \"{}\", \"ph\": \"X\", \"ts\": {:.3f}, "
+        "\"dur\": {:.3f}, \"pid\": {}, \"tid\": {}}}",
+        first ? "" : ",",
+        event.name,
+        event.start_time_ns / 1000.0,
+        (event.end_time_ns - event.start_time_ns) / 1000.0,
+        ob.pid,
+        event.tid);
+    first = false;
+  }
+  out << "\n  ]\n}\n";
+
+  VLOG(1) << "Exported sampled trace for request " << ob.request_index
+          << " (" << latency_us << "us) to " << file_name;
+}
+
+} // namespace
+
+bool addSamplingObserver(const SamplingObserverConfig& config) {
+  TORCH_CHECK(
+      config.sampling_period > 0,
+      "Sampling observer requires a positive sampling period, got ",
+      config.sampling_period);
+  TORCH_CHECK(
+      config.ring_size > 0,
+      "Sampling observer requires a non-empty event ring.");
+  if (handle_ != INVALID_CALLBACK_HANDLE) {
+    LOG(WARNING) << "Sampling observer is already registered.";
+    return false;
+  }
+
+  auto& ob = observer();
+  ob.config = config;
+  ob.pid = processId();
+  ob.ring.resize(config.ring_size);
+  ob.cursor = 0;
+  ob.active = false;
+  ob.request_count = 0;
+
+  handle_ = addGlobalCallback(
+      RecordFunctionCallback(&onFunctionEnter, &onFunctionExit)
+          .scopes(
+              {RecordScope::FUNCTION,
+               RecordScope::BACKWARD_FUNCTION,
+               RecordScope::USER_SCOPE}));
+
+  VLOG(1) << "Added PyTorch sampling observer, period="
+          << config.sampling_period << " ring_size=" << config.ring_size;
+  return true;
+}
+
+void removeSamplingObserver() {
+  if (handle_ == INVALID_CALLBACK_HANDLE) {
+    LOG(WARNING) << "Sampling observer was not registered.";
+    return;
+  }
+
+  auto& ob = observer();
+  {
+    const std::lock_guard<std::mutex> lock(ob.mutex);
+    ob.active.store(false, std::memory_order_release);
+  }
+  removeCallback(handle_);
+  handle_ = INVALID_CALLBACK_HANDLE;
+  // Release the ring; the observer can be re-added with a new config.
+  std::vector<RingEvent>().swap(ob.ring);
+  VLOG(1) << "Removed PyTorch sampling observer";
+}
+
+void samplingObserverRequestBegin() {
+  if (handle_ == INVALID_CALLBACK_HANDLE) {
+    return;
+  }
+  auto& ob = observer();
+  const auto count =
+      ob.request_count.fetch_add(1, std::memory_order_relaxed);
+  if (count % static_cast<uint64_t>(ob.config.sampling_period) != 0) {
+    return;
+  }
+
+  const std::lock_guard<std::mutex> lock(ob.mutex);
+  ob.request_index = count;
+  ob.request_start_ns = getTime();
+  ob.cursor.store(0, std::memory_order_relaxed);
+  ob.active.store(true, std::memory_order_release);
+}
+
+void samplingObserverRequestEnd() {
+  auto& ob = observer();
+  if (!ob.active.load(std::memory_order_acquire)) {
+    return;
+  }
+
+  const std::lock_guard<std::mutex> lock(ob.mutex);
+  if (!ob.active.exchange(false, std::memory_order_acq_rel)) {
+    return;
+  }
+  const int64_t latency_us = (getTime() - ob.request_start_ns) / 1000;
+  if (latency_us >= ob.config.latency_threshold_us) {
+    exportRing(ob, latency_us);
+  }
+}
+
+} // namespace impl
+} // namespace profiler
+} // namespace torch
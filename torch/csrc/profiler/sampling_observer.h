@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <torch/csrc/Export.h>
+
+namespace torch {
+namespace profiler {
+namespace impl {
+
+// Configuration for the always-on sampling observer. Unlike the Kineto
+// profiler, which assumes short sessions, this observer is designed to stay
+// registered for the lifetime of a serving process: it captures the op spans
+// of one out of every `sampling_period` requests into a preallocated ring
+// and only pays for an atomic load per op for the requests in between.
+struct TORCH_API SamplingObserverConfig {
+  // Capture one out of every `sampling_period` requests.
+  int64_t sampling_period = 100;
+  // Capacity of the preallocated event ring, in op spans. Once full, the
+  // ring wraps and the oldest spans of the current request are overwritten.
+  size_t ring_size = 8192;
+  // Sampled requests slower than this are exported as a trace file; a value
+  // of zero exports every sampled request.
+  int64_t latency_threshold_us = 0;
+  // Directory the triggered trace files are written to.
+  std::string trace_dir = ".";
+};
+
+// Adds the sampling observer as a global callback function and preallocates
+// the event ring. Returns false if an observer is already registered.
+TORCH_API bool addSamplingObserver(const SamplingObserverConfig& config);
+
+// Removes the sampling observer from the global callback functions.
+TORCH_API void removeSamplingObserver();
+
+// Request delimiters, called by the serving loop around each unit of work.
+// `samplingObserverRequestBegin` decides whether the request is sampled;
+// `samplingObserverRequestEnd` measures its latency and, if the request was
+// sampled and slower than the configured threshold, exports the captured
+// spans as a Chrome trace file.
+TORCH_API void samplingObserverRequestBegin();
+TORCH_API void samplingObserverRequestEnd();
+
+} // namespace impl
+} // namespace profiler
+} // namespace torch
@@ -415,6 +415,28 @@ def memory_snapshot():
     return torch._C._cuda_memorySnapshot()
 
 
+def _set_alloc_trace_enabled(enabled: bool) -> None:
+    r"""Enables or disables native allocation tracing in the CUDA caching
+    allocator. While enabled, every allocation and free records a compact C++
+    call stack into a bounded ring buffer. See
+    :func:`~torch.cuda.memory._export_alloc_trace`.
+    """
+    torch._C._cuda_setAllocTraceEnabled(enabled)
+
+
+def _set_alloc_trace_max_entries(max_entries: int) -> None:
+    r"""Sets the capacity of the allocation trace ring buffer and clears any
+    recorded events."""
+    torch._C._cuda_setAllocTraceMaxEntries(max_entries)
+
+
+def _export_alloc_trace() -> str:
+    r"""Returns the still-live traced allocations aggregated by C++ call
+    stack, in the collapsed stack format understood by flamegraph tooling
+    (one ``outer;...;inner <bytes>`` line per distinct stack)."""
+    return torch._C._cuda_exportAllocTrace()
+
+
 def memory_summary(device: Union[Device, int] = None, abbreviated: bool = False) -> str:
     r"""Returns a human-readable printout of the current memory allocator
     statistics for a given device.
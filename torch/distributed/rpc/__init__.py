@@ -39,6 +39,11 @@ if is_available():
         _set_profiler_node_id,
         _is_current_rpc_agent_set,
         _rref_context_get_debug_info,
+        _remote_storage_register,
+        _remote_storage_announce,
+        _remote_storage_materialize,
+        _remote_storage_delete,
+        _remote_storage_get_debug_info,
         _cleanup_python_rpc_handler,
         _invoke_rpc_builtin,
         _invoke_rpc_python_udf,
@@ -19,7 +19,9 @@ from .reductions import init_reductions
 import multiprocessing
 
 __all__ = ['set_sharing_strategy', 'get_sharing_strategy',
-           'get_all_sharing_strategies']
+           'get_all_sharing_strategies',
+           'set_shareable_allocation_threshold',
+           'get_shareable_allocation_threshold']
 
 
 from multiprocessing import *  # noqa: F403
@@ -69,4 +71,32 @@ def get_all_sharing_strategies():
     return _all_sharing_strategies
 
 
+def set_shareable_allocation_threshold(nbytes):
+    """Makes CPU tensors of at least ``nbytes`` bytes born shareable.
+
+    Ordinarily a tensor must be moved into shared memory with an explicit
+    copy (see :func:`~torch.Tensor.share_memory_`) before it can be sent to
+    another process. With a nonzero threshold, CPU storages of at least
+    ``nbytes`` bytes are allocated in shared memory to begin with, so sending
+    them to another process passes a file descriptor without copying the
+    data. Passing ``0`` restores the default allocation behavior.
+
+    Only effective with the ``file_descriptor`` sharing strategy; not
+    supported on Windows.
+
+    Args:
+        nbytes (int): Minimum storage size in bytes to allocate in shared
+            memory, or ``0`` to disable.
+    """
+    torch._C._set_shareable_allocation_threshold(nbytes)
+
+
+def get_shareable_allocation_threshold():
+    """Returns the current born-shareable allocation threshold in bytes.
+
+    See :func:`set_shareable_allocation_threshold`; ``0`` means disabled.
+    """
+    return torch._C._get_shareable_allocation_threshold()
+
+
 init_reductions()
@@ -1145,6 +1145,18 @@ class DistributedDataParallel(Module, Joinable):
         for work in comm_work:
             work.wait()
 
+    def _set_pinned_parameter_indices(self, indices):
+        r"""
+        Pins the parameters at the given indices (positions in the reducer's
+        parameter list, see :meth:`_build_params_for_reducer`) to the front of
+        the bucket order the next time gradient buckets are rebuilt, so their
+        gradients are communicated as early as possible. Must be called before
+        the rebuild, i.e. within the first training iteration.
+
+        This is an experimental API subject to change.
+        """
+        self.reducer._set_pinned_parameter_indices(indices)
+
     # Allreduces the used parameter mapping across ranks.
     def _match_unused_params_allreduce(self):
         locally_used_param_map = self.reducer._get_local_used_map()
@@ -7,6 +7,7 @@ import sys
 import torch
 import tarfile
 import tempfile
+import threading
 import warnings
 from contextlib import closing, contextmanager
 from ._utils import _import_dotted_name
@@ -392,6 +393,149 @@ def save(obj, f: Union[str, os.PathLike, BinaryIO, IO[bytes]],
             _legacy_save(obj, opened_file, pickle_module, pickle_protocol)
 
 
+class _AsyncSaveHandle(object):
+    """Completion handle returned by :func:`_async_save`.
+
+    ``wait`` blocks until the checkpoint has been handed to the filesystem
+    (and re-raises any error hit by the writer thread); ``done`` polls.
+    """
+
+    def __init__(self):
+        self._finished = threading.Event()
+        self._exception = None
+
+    def wait(self) -> None:
+        self._finished.wait()
+        if self._exception is not None:
+            raise self._exception
+
+    def done(self) -> bool:
+        return self._finished.is_set()
+
+
+class _AsyncCheckpointWriter(object):
+    """Overlaps checkpoint writes with training.
+
+    Snapshotting an object stages every CUDA tensor into a pinned host
+    buffer with a stream-ordered D2H copy on a side stream; the compute
+    stream is then ordered after the copies with an event wait, so training
+    may only race ahead once its parameters have been captured, without any
+    host synchronization. A background thread serializes the staged copy
+    with torch.save while training proceeds.
+
+    Staging buffers are kept in rotation (double-buffered by default) and
+    reused across checkpoints as long as shapes and dtypes are stable, so
+    steady-state checkpointing does no host allocation.
+    """
+
+    def __init__(self, num_buffers: int = 2):
+        import queue
+
+        self._slots = [{"buffers": {}, "handle": None} for _ in range(num_buffers)]
+        self._turn = 0
+        self._queue: Any = queue.Queue()
+        self._worker = threading.Thread(
+            target=self._worker_loop, name="AsyncCheckpointWriter", daemon=True)
+        self._worker.start()
+
+    def _worker_loop(self):
+        while True:
+            work = self._queue.get()
+            if work is None:
+                return
+            staged_obj, copy_events, f, pickle_module, pickle_protocol, handle = work
+            try:
+                for event in copy_events:
+                    event.synchronize()
+                save(staged_obj, f, pickle_module, pickle_protocol)
+            except Exception as e:  # noqa: B902
+                handle._exception = e
+            finally:
+                handle._finished.set()
+
+    def _stage(self, tensor, slot, index, side_streams):
+        if not tensor.is_cuda:
+            # CPU tensors still need a snapshot so that later in-place
+            # updates are not observed by the writer thread.
+            return tensor.detach().clone()
+        device = tensor.device
+        if device not in side_streams:
+            stream = torch.cuda.Stream(device=device)
+            stream.wait_stream(torch.cuda.current_stream(device))
+            side_streams[device] = stream
+        staged = slot["buffers"].get(index)
+        if (staged is None or staged.shape != tensor.shape
+                or staged.dtype != tensor.dtype):
+            staged = torch.empty_like(tensor, device="cpu", pin_memory=True)
+            slot["buffers"][index] = staged
+        with torch.cuda.stream(side_streams[device]):
+            staged.copy_(tensor.detach(), non_blocking=True)
+        return staged
+
+    def save(self, obj, f, pickle_module=pickle,
+             pickle_protocol=DEFAULT_PROTOCOL) -> _AsyncSaveHandle:
+        import copy
+
+        from torch.utils import _pytree as pytree
+
+        slot = self._slots[self._turn]
+        self._turn = (self._turn + 1) % len(self._slots)
+        # The slot's buffers may still be in flight from an earlier
+        # checkpoint; wait for that write before overwriting them.
+        if slot["handle"] is not None:
+            slot["handle"].wait()
+
+        leaves, spec = pytree.tree_flatten(obj)
+        side_streams: Dict[torch.device, Any] = {}
+        copy_events = []
+        staged_leaves = []
+        for index, leaf in enumerate(leaves):
+            if isinstance(leaf, torch.Tensor):
+                staged_leaves.append(
+                    self._stage(leaf, slot, index, side_streams))
+            else:
+                staged_leaves.append(copy.deepcopy(leaf))
+        for device, stream in side_streams.items():
+            event = torch.cuda.Event()
+            event.record(stream)
+            copy_events.append(event)
+            # Order subsequent compute after the staging copies: training
+            # may not mutate a parameter before it has been captured. This
+            # is a GPU-side dependency only; the host does not block.
+            torch.cuda.current_stream(device).wait_event(event)
+        staged_obj = pytree.tree_unflatten(staged_leaves, spec)
+
+        handle = _AsyncSaveHandle()
+        slot["handle"] = handle
+        self._queue.put(
+            (staged_obj, copy_events, f, pickle_module, pickle_protocol, handle))
+        return handle
+
+
+_async_checkpoint_writer: Optional[_AsyncCheckpointWriter] = None
+
+
+def _async_save(obj, f: Union[str, os.PathLike, BinaryIO, IO[bytes]],
+                pickle_module=pickle,
+                pickle_protocol=DEFAULT_PROTOCOL) -> _AsyncSaveHandle:
+    """Saves an object like :func:`torch.save`, without blocking training.
+
+    CUDA tensors are staged to pinned host memory with stream-ordered D2H
+    copies and the file is written by a background thread. Returns an
+    :class:`_AsyncSaveHandle`; call ``wait`` on it before relying on the
+    checkpoint being durable (e.g. before deleting a previous one).
+
+    .. warning::
+        This is a private, experimental API. Storage sharing between
+        tensors is not preserved: each staged tensor is serialized with
+        its own storage.
+    """
+    global _async_checkpoint_writer
+    if _async_checkpoint_writer is None:
+        _async_checkpoint_writer = _AsyncCheckpointWriter()
+    return _async_checkpoint_writer.save(obj, f, pickle_module, pickle_protocol)
+
+
 def _legacy_save(obj, f, pickle_module, pickle_protocol) -> None:
     import torch.nn as nn
     serialized_container_types = {}
@@ -248,6 +248,16 @@ def my_function(a, b, c):
 def my_tensor_function(a, b):
     return a + b
 
+def fetch_remote_storage_handles(handles):
+    # Announce all handles first; the first materialize call should then pull
+    # every announced payload from the owner in a single batched fetch.
+    for owner_id, local_id in handles:
+        rpc._remote_storage_announce(owner_id, local_id)
+    before = int(rpc._remote_storage_get_debug_info()["num_fetched_tensors"])
+    fetched = [rpc._remote_storage_materialize(owner_id, local_id) for owner_id, local_id in handles]
+    after = int(rpc._remote_storage_get_debug_info()["num_fetched_tensors"])
+    return fetched, after - before
+
 def my_container_sum(a):
     result = a[0]
     for tensor in a[1:]:
@@ -1143,6 +1153,31 @@ class RpcTest(RpcAgentTestFixture, RpcTestCommon):
         self.assertEqual(fut.wait(), torch.ones(2, 2) + 1)
         self.assertEqual(ret, torch.ones(2, 2) + 1)
 
+    @dist_init
+    def test_remote_storage_lazy_fetch(self):
+        # See Note [Lazy remote tensors] in remote_storage.h. The handles are
+        # small (owner id, local id) pairs; the payloads only move when the
+        # callee first touches the data, and announced handles ride along in
+        # one batched fetch.
+        dst_rank = (self.rank + 1) % self.world_size
+        tensors = [torch.randn(4, 4), torch.arange(16).view(4, 4)]
+        handles = [rpc._remote_storage_register(t) for t in tensors]
+        for owner_id, _ in handles:
+            self.assertEqual(owner_id, rpc.get_worker_info().id)
+
+        fetched, num_transferred = rpc.rpc_sync(
+            worker_name(dst_rank),
+            fetch_remote_storage_handles,
+            args=(handles,),
+        )
+        self.assertEqual(fetched, tensors)
+        # Both payloads moved in the single fetch triggered by the first
+        # materialize call.
+        self.assertEqual(num_transferred, len(tensors))
+
+        for owner_id, local_id in handles:
+            rpc._remote_storage_delete(owner_id, local_id)
+
     @dist_init
     def test_send_to_rank(self):
         dst_rank = (self.rank + 1) % self.world_size
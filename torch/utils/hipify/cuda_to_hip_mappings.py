@@ -8197,6 +8197,11 @@ C10_MAPPINGS = collections.OrderedDict(
         ("c10/cuda/CUDAStream.h", ("c10/hip/HIPStream.h", API_C10)),
         ("c10/cuda/CUDAGraphsC10Utils.h", ("c10/hip/HIPGraphsC10Utils.h", API_C10)),
         ("c10/cuda/CUDACachingAllocator.h", ("c10/hip/HIPCachingAllocator.h", API_C10)),
+        ("c10/cuda/CUDAEventPool.h", ("c10/hip/HIPEventPool.h", API_C10)),
+        (
+            "c10/cuda/CUDAUtilizationGauge.h",
+            ("c10/hip/HIPUtilizationGauge.h", API_C10),
+        ),
         ("c10/cuda/impl/CUDATest.h", ("c10/hip/impl/HIPTest.h", API_C10)),
         ("c10/cuda/impl/CUDAGuardImpl.h", ("c10/hip/impl/HIPGuardImpl.h", API_C10)),
         (
@@ -8208,6 +8213,8 @@ C10_MAPPINGS = collections.OrderedDict(
         ("c10::cuda", ("c10::hip", API_C10)),
         ("cuda::CUDAStream", ("hip::HIPStream", API_C10)),
         ("CUDAStream", ("HIPStream", API_C10)),
+        ("CUDAEventPool", ("HIPEventPool", API_C10)),
+        ("CUDAUtilizationGauge", ("HIPUtilizationGauge", API_C10)),
         # This substitution is not permissible, because there's another copy of this
         # function in torch/cuda.h
         # ("cuda::device_count", ("hip::device_count", API_C10)),
@@ -201,6 +201,15 @@ class MkldnnPrelu(torch.jit.ScriptModule):
         y = y_mkldnn if x.is_mkldnn else y_mkldnn.to_dense()
         return y
 
+def pin_prepacked_weights(module, pin=True):
+    r"""Pins (or unpins) the prepacked-weight cache entries of all parameters of
+    ``module`` so they are never evicted from the MKLDNN prepacked weight cache.
+    Only meaningful when the cache is enabled, e.g. via
+    ``torch._C._mkldnn_set_prepack_cache_limit``."""
+    for param in module.parameters():
+        torch._C._mkldnn_set_prepacked_weight_pinned(param.data, pin)
+
+
 def to_mkldnn(module, dtype=torch.float):
     assert dtype in [torch.float, torch.bfloat16], \
         "MKLDNN only support float or bfloat16 path now"